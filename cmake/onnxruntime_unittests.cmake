@@ -548,7 +548,11 @@ install(TARGETS onnx_test_runner
         RUNTIME  DESTINATION ${CMAKE_INSTALL_BINDIR})
 
 if(onnxruntime_BUILD_BENCHMARKS)
-  add_executable(onnxruntime_benchmark ${TEST_SRC_DIR}/onnx/microbenchmark/main.cc ${TEST_SRC_DIR}/onnx/microbenchmark/modeltest.cc)
+  add_executable(onnxruntime_benchmark
+    ${TEST_SRC_DIR}/onnx/microbenchmark/main.cc
+    ${TEST_SRC_DIR}/onnx/microbenchmark/modeltest.cc
+    ${TEST_SRC_DIR}/onnx/microbenchmark/cpu_kernels.cc
+    ${TEST_SRC_DIR}/onnx/microbenchmark/mlas.cc)
   target_include_directories(onnxruntime_benchmark PRIVATE ${ONNXRUNTIME_ROOT} ${onnxruntime_graph_header} benchmark)
   if(WIN32)
     target_compile_options(onnxruntime_benchmark PRIVATE "$<$<COMPILE_LANGUAGE:CUDA>:-Xcompiler /wd4141>"
@@ -64,6 +64,14 @@ class KernelDef {
     return alias_map_;
   }
 
+  const std::vector<int>& MayStridedInput() const {
+    return strided_input_list_;
+  }
+
+  const std::vector<std::pair<int, int>>& MayStridedOutput() const {
+    return strided_output_map_;
+  }
+
   OrtMemType InputMemoryType(size_t input_index) const {
     auto it = input_memory_type_args_.find(input_index);
     if (it == input_memory_type_args_.end())
@@ -118,6 +126,13 @@ class KernelDef {
   // An element <i, j> means that output j is an alias of input i.
   std::vector<std::pair<int, int>> alias_map_;
 
+  // An element i means that input i may be a strided view.
+  std::vector<int> strided_input_list_;
+
+  // An element <i, j> means that output j may be produced as a strided view of input i.
+  // j is -1 if every output may be.
+  std::vector<std::pair<int, int>> strided_output_map_;
+
   // The memory types of inputs/outputs of this kernel
   MemTypeMap input_memory_type_args_;
   MemTypeMap output_memory_type_args_;
@@ -201,6 +216,21 @@ class KernelDefBuilder {
   KernelDefBuilder& Alias(const std::vector<std::pair<int, int>>& aliases);
   KernelDefBuilder& Alias(int input_index, int output_index);
 
+  /**
+     The kernel can read the input as a strided view (see Tensor::SetStridedView)
+     of another tensor's buffer instead of a dense tensor.
+  */
+  KernelDefBuilder& MayStridedInput(int input_index);
+
+  /**
+     The kernel can produce the output as a strided view of the input's buffer
+     instead of copying the data. The planner only does so when every consumer
+     of the output declares MayStridedInput for it; the kernel checks
+     OpKernelContext::IsStridedViewOutput to know which one to produce.
+     An output_index of -1 applies to every output (e.g. Split).
+  */
+  KernelDefBuilder& MayStridedOutput(int input_index, int output_index);
+
   /**
      Specify that this kernel requires an input arg
      in certain memory type (instead of the default, device memory).
@@ -32,6 +32,13 @@ struct OrtValue {
     type_ = type;
   }
 
+  // Makes this value a view of pData, which must be owned by the data of 'owner'. The view keeps the data of
+  // 'owner' alive, so it can outlive 'owner' itself.
+  void InitAsView(void* pData, onnxruntime::MLDataType type, const OrtValue& owner) {
+    data_ = std::shared_ptr<void>(owner.data_, pData);
+    type_ = type;
+  }
+
   bool IsAllocated() const {
     return data_ && type_;
   }
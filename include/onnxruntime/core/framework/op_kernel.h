@@ -162,6 +162,13 @@ class OpKernelContext {
   */
   Fence_t OutputFence(int index) const;
 
+  /**
+  Return true if the output identified by index is planned as a strided view of one of the
+  kernel's inputs (see KernelDefBuilder::MayStridedOutput). The kernel must then call
+  Tensor::SetStridedView on the output tensor instead of writing its data.
+  */
+  bool IsStridedViewOutput(int index) const;
+
   /**
   Returns the opset domain of the underlying kernel
   **/
@@ -178,16 +178,51 @@ class Tensor final {
     return p_data_;
   }
 
+  /**
+     Returns the offset, in bytes, of the first element from the start of the buffer.
+     DataRaw() and MutableDataRaw() return the start of the buffer; Data<T>() and
+     MutableData<T>() include the offset.
+  */
+  ptrdiff_t ByteOffset() const noexcept { return byte_offset_; }
+
+  /**
+     Returns the distance, in elements, between consecutive indices of each dimension.
+     A tensor is dense and row-major unless it is a strided view (see SetStridedView).
+  */
+  std::vector<int64_t> Strides() const;
+
+  /**
+     Returns true if the elements are laid out densely in row-major order from Data<T>().
+  */
+  bool IsContiguous() const noexcept { return is_contiguous_; }
+
+  /**
+     Returns true if the tensor allocated its buffer and releases it when destroyed. A tensor that wraps memory
+     owned by someone else, such as an initializer or a user provided feed, returns false.
+  */
+  bool OwnsBuffer() const noexcept { return buffer_deleter_ != nullptr; }
+
+  /**
+     Turns the tensor into a strided view of its buffer: element i0,...,in-1 is read from
+     byte_offset + sum(ik * strides[k]) * element size. Strides may be zero (broadcast) or
+     negative. Only kernels that declare KernelDefBuilder::MayStridedInput for an input can
+     receive a view there; they must read it with Data<T>() and the strides.
+     @warning this function is NOT thread-safe.
+  */
+  void SetStridedView(gsl::span<const int64_t> strides, ptrdiff_t byte_offset);
+
   /**
    * Resizes the tensor without touching underlying storage.
    * This requires the total size of the tensor to remains constant.
    * @warning this function is NOT thread-safe.
    */
   inline void Reshape(const TensorShape& new_shape) {
+    ORT_ENFORCE(is_contiguous_, "A strided view cannot be reshaped.");
     ORT_ENFORCE(shape_.Size() == new_shape.Size(),
                 "Tensor size (" + std::to_string(shape_.Size()) +
                     ") != new size (" + std::to_string(new_shape.Size()) + ")");
     shape_ = new_shape;
+    strides_.clear();
   }
 
   /**
@@ -217,6 +252,10 @@ class Tensor final {
   const PrimitiveDataTypeBase* dtype_;
   OrtMemoryInfo alloc_info_;
   ptrdiff_t byte_offset_;
+
+  // strides of each dimension; empty unless the tensor is a strided view
+  std::vector<int64_t> strides_;
+  bool is_contiguous_{true};
 };
 #ifdef __GNUC__
 #pragma GCC diagnostic pop
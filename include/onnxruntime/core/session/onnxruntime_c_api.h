@@ -188,6 +188,17 @@ typedef enum ExecutionMode {
   ORT_PARALLEL = 1,
 } ExecutionMode;
 
+/**
+ * Data container read with GetOpaqueValue from the sequences of maps produced by ZipMap when the session option
+ * EnableColumnarZipMapOutput is set. Their opaque types are, in the "com.microsoft" domain,
+ * "ColumnarMapSequenceStringToFloat" and "ColumnarMapSequenceInt64ToFloat".
+ * Both values are views that keep the sequence alive. The caller must release them with ReleaseValue.
+ */
+typedef struct OrtColumnarMapSequence {
+  OrtValue* keys;    // 1-D tensor of the keys shared by every map, in map order
+  OrtValue* values;  // [N, C] float tensor. Row n holds the values of map n in key order
+} OrtColumnarMapSequence;
+
 struct OrtKernelInfo;
 typedef struct OrtKernelInfo OrtKernelInfo;
 struct OrtKernelContext;
@@ -578,12 +589,14 @@ struct OrtApi {
    * separately. Use index=0 to retrieve keys and index=1 to retrieve values.
    * If input OrtValue represents a sequence, use index to retrieve the index'th element
    * of the sequence.
+   * A columnar map sequence (see OrtColumnarMapSequence) returns a lazy view of its index'th map. The view is read
+   * like a map, and the keys and values it returns are views of the sequence rather than copies.
    */
   OrtStatus*(ORT_API_CALL* GetValue)(_In_ const OrtValue* value, int index, _Inout_ OrtAllocator* allocator, _Outptr_ OrtValue** out)NO_EXCEPTION;
 
   /**
    * Returns 2 for type map and N for sequence where N is the number of elements
-   * in the sequence.
+   * in the sequence. A columnar map sequence counts as a sequence of N maps, and a view of one of its maps as a map.
    */
   OrtStatus*(ORT_API_CALL* GetValueCount)(_In_ const OrtValue* value, _Out_ size_t* out)NO_EXCEPTION;
 
@@ -747,6 +760,45 @@ struct OrtApi {
   OrtStatus*(ORT_API_CALL* ModelMetadataGetVersion)(_In_ const OrtModelMetadata* model_metadata, _Out_ int64_t* value)NO_EXCEPTION;
 
   ORT_CLASS_RELEASE(ModelMetadata);
+
+  /**
+   * Enable aggregated per node execution statistics. Unlike EnableProfiling this keeps fixed size counters
+   * (count, total/max time, latency percentiles, output bytes) instead of an event per node run.
+   * \param trace_sample_rate also keep every Nth run of each node in a bounded trace. 0 disables the trace.
+   */
+  OrtStatus*(ORT_API_CALL* EnableOpStatistics)(_Inout_ OrtSessionOptions* options, int trace_sample_rate)NO_EXCEPTION;
+  OrtStatus*(ORT_API_CALL* DisableOpStatistics)(_Inout_ OrtSessionOptions* options)NO_EXCEPTION;
+
+  /**
+   * \param out is set to a null terminated JSON string allocated using 'allocator'. The caller is responsible for freeing it.
+   * \param reset if non-zero, the statistics are cleared after they are read.
+   * Fails if op statistics were not enabled on the SessionOptions instance used to create the session.
+   */
+  OrtStatus*(ORT_API_CALL* SessionGetOpStatistics)(_In_ OrtSession* sess, int reset, _Inout_ OrtAllocator* allocator,
+                                                   _Outptr_ char** out)NO_EXCEPTION;
+
+  /**
+   * Attribute the memory allocated during runs to the nodes that requested it, and record the live memory
+   * timeline and the allocations live at the peak. This is a diagnostic mode that slows down allocations.
+   */
+  OrtStatus*(ORT_API_CALL* EnableMemoryStatistics)(_Inout_ OrtSessionOptions* options)NO_EXCEPTION;
+  OrtStatus*(ORT_API_CALL* DisableMemoryStatistics)(_Inout_ OrtSessionOptions* options)NO_EXCEPTION;
+
+  /**
+   * \param out is set to a null terminated JSON string allocated using 'allocator'. The caller is responsible for freeing it.
+   * \param reset if non-zero, the per node totals, timeline and peak are cleared after they are read.
+   * Fails if memory statistics were not enabled on the SessionOptions instance used to create the session.
+   */
+  OrtStatus*(ORT_API_CALL* SessionGetMemoryStatistics)(_In_ OrtSession* sess, int reset, _Inout_ OrtAllocator* allocator,
+                                                       _Outptr_ char** out)NO_EXCEPTION;
+
+  /**
+   * Return the sequences of maps built by ZipMap for the graph outputs as columnar map sequences: one shared array
+   * of keys and a dense [N, C] float array of values, read through OrtColumnarMapSequence or one map at a time with
+   * GetValue. The model outputs then have an opaque type instead of seq(map(K, float)). Disabled by default.
+   */
+  OrtStatus*(ORT_API_CALL* EnableColumnarZipMapOutput)(_Inout_ OrtSessionOptions* options)NO_EXCEPTION;
+  OrtStatus*(ORT_API_CALL* DisableColumnarZipMapOutput)(_Inout_ OrtSessionOptions* options)NO_EXCEPTION;
 };
 
 /*
@@ -177,6 +177,15 @@ struct SessionOptions : Base<OrtSessionOptions> {
   SessionOptions& EnableProfiling(const ORTCHAR_T* profile_file_prefix);
   SessionOptions& DisableProfiling();
 
+  SessionOptions& EnableOpStatistics(int trace_sample_rate = 0);
+  SessionOptions& DisableOpStatistics();
+
+  SessionOptions& EnableMemoryStatistics();
+  SessionOptions& DisableMemoryStatistics();
+
+  SessionOptions& EnableColumnarZipMapOutput();
+  SessionOptions& DisableColumnarZipMapOutput();
+
   SessionOptions& EnableMemPattern();
   SessionOptions& DisableMemPattern();
 
@@ -219,6 +228,8 @@ struct Session : Base<OrtSession> {
   char* GetOutputName(size_t index, OrtAllocator* allocator) const;
   char* GetOverridableInitializerName(size_t index, OrtAllocator* allocator) const;
   char* EndProfiling(OrtAllocator* allocator) const;
+  char* GetOpStatistics(OrtAllocator* allocator, bool reset = false) const;
+  char* GetMemoryStatistics(OrtAllocator* allocator, bool reset = false) const;
   ModelMetadata GetModelMetadata() const;
 
   TypeInfo GetInputTypeInfo(size_t index) const;
@@ -183,6 +183,36 @@ inline SessionOptions& SessionOptions::DisableProfiling() {
   return *this;
 }
 
+inline SessionOptions& SessionOptions::EnableOpStatistics(int trace_sample_rate) {
+  ThrowOnError(Global<void>::api_.EnableOpStatistics(p_, trace_sample_rate));
+  return *this;
+}
+
+inline SessionOptions& SessionOptions::DisableOpStatistics() {
+  ThrowOnError(Global<void>::api_.DisableOpStatistics(p_));
+  return *this;
+}
+
+inline SessionOptions& SessionOptions::EnableMemoryStatistics() {
+  ThrowOnError(Global<void>::api_.EnableMemoryStatistics(p_));
+  return *this;
+}
+
+inline SessionOptions& SessionOptions::DisableMemoryStatistics() {
+  ThrowOnError(Global<void>::api_.DisableMemoryStatistics(p_));
+  return *this;
+}
+
+inline SessionOptions& SessionOptions::EnableColumnarZipMapOutput() {
+  ThrowOnError(Global<void>::api_.EnableColumnarZipMapOutput(p_));
+  return *this;
+}
+
+inline SessionOptions& SessionOptions::DisableColumnarZipMapOutput() {
+  ThrowOnError(Global<void>::api_.DisableColumnarZipMapOutput(p_));
+  return *this;
+}
+
 inline SessionOptions& SessionOptions::EnableMemPattern() {
   ThrowOnError(Global<void>::api_.EnableMemPattern(p_));
   return *this;
@@ -284,6 +314,18 @@ inline char* Session::EndProfiling(OrtAllocator* allocator) const {
   return out;
 }
 
+inline char* Session::GetOpStatistics(OrtAllocator* allocator, bool reset) const {
+  char* out;
+  ThrowOnError(Global<void>::api_.SessionGetOpStatistics(p_, reset ? 1 : 0, allocator, &out));
+  return out;
+}
+
+inline char* Session::GetMemoryStatistics(OrtAllocator* allocator, bool reset) const {
+  char* out;
+  ThrowOnError(Global<void>::api_.SessionGetMemoryStatistics(p_, reset ? 1 : 0, allocator, &out));
+  return out;
+}
+
 inline ModelMetadata Session::GetModelMetadata() const {
   OrtModelMetadata* out;
   ThrowOnError(Global<void>::api_.SessionGetModelMetadata(p_, &out));
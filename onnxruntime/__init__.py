@@ -9,7 +9,8 @@ For more information on ONNX Runtime, please see `aka.ms/onnxruntime <https://ak
 __version__ = "1.1.0"
 __author__ = "Microsoft"
 
-from onnxruntime.capi._pybind_state import get_all_providers, get_available_providers, get_device, RunOptions, SessionOptions, set_default_logger_severity, NodeArg, ModelMetadata, GraphOptimizationLevel, ExecutionMode
+from onnxruntime.capi._pybind_state import get_all_providers, get_available_providers, get_device, RunOptions, SessionOptions, set_default_logger_severity, NodeArg, ModelMetadata, GraphOptimizationLevel, ExecutionMode, \
+    ColumnarMapSequenceStringToFloat, ColumnarMapSequenceInt64ToFloat
 from onnxruntime.capi.session import InferenceSession
 from onnxruntime.capi import onnxruntime_validation
 onnxruntime_validation.check_distro_info()
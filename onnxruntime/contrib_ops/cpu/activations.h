@@ -52,23 +52,15 @@ class Gelu : public OpKernel {
                                      task_count](int32_t i) {
           int64_t elem_inx_start = i * elem_count / task_count;
           int64_t elem_inx_end = (i + 1) * elem_count / task_count;
-          for (int64_t elem_inx = elem_inx_start; elem_inx < elem_inx_end; elem_inx++) {
-            output[elem_inx] = input[elem_inx] * static_cast<float>(M_SQRT1_2);
-          }
-          MlasComputeErf(output + elem_inx_start, output + elem_inx_start, elem_inx_end - elem_inx_start);
-          for (int64_t elem_inx = elem_inx_start; elem_inx < elem_inx_end; elem_inx++) {
-            output[elem_inx] = 0.5f * input[elem_inx] * (output[elem_inx] + 1.0f);
-          }
+          MlasComputeBiasGelu(MlasGeluErf, input + elem_inx_start, nullptr, output + elem_inx_start,
+                              static_cast<size_t>(elem_inx_end - elem_inx_start));
         });
         return Status::OK();
       }
     }
 
-    EIGEN_X_VAR(xm);
-    EIGEN_Y_VAR(ym);
-    ym = xm * static_cast<float>(M_SQRT1_2);
-    MlasComputeErf(Y->template MutableData<T>(), Y->template MutableData<T>(), X->Shape().Size());
-    ym = xm * 0.5f * (ym + 1.0f);
+    MlasComputeBiasGelu(MlasGeluErf, X->template Data<T>(), nullptr, Y->template MutableData<T>(),
+                        static_cast<size_t>(X->Shape().Size()));
     return Status::OK();
   }
 };
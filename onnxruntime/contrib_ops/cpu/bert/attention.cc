@@ -7,6 +7,7 @@
 #include "core/util/eigen_common_wrapper.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/providers/cpu/math/gemm_helper.h"
 #include "core/providers/cpu/math/softmax.h"
 #include "core/providers/cpu/tensor/transpose.h"
@@ -135,6 +136,12 @@ Status Attention<T>::Compute(OpKernelContext* context) const {
     const auto weights_data = weights->template Data<T>();
     const auto bias_data = bias->template Data<T>();
 
+    //                   original           transposed            iteration
+    // A: input          (BxSxNxH)          (B.)S x NH            S x NH
+    // B: weights        (NxHx3xNxH)        NH  x (3.N.)H         NH x H
+    // C: QKV[qkv_index] (3xBxNxSxH)        (3.B.N.)S x H         S x H
+    std::vector<MLAS_SGEMM_DATA_PARAMS> gemm_params(loop_len);
+
     concurrency::ThreadPool::TryParallelFor(context->GetOperatorThreadPool(), loop_len, [&](int32_t i) {
       const int batch_index = (i / 3) / num_heads_;
       const int head_index = (i / 3) % num_heads_;
@@ -142,7 +149,6 @@ Status Attention<T>::Compute(OpKernelContext* context) const {
 
       int input_offset = batch_index * sequence_length * hidden_size;
       int weights_offset = qkv_index * hidden_size + head_index * head_size;
-      T* qkv_dest = QKV[qkv_index];
       int qkv_offset = (batch_index * num_heads_ + head_index) * (sequence_length * head_size);
 
       // broadcast 3NH -> (3.B.N.S.H)
@@ -153,27 +159,18 @@ Status Attention<T>::Compute(OpKernelContext* context) const {
         broadcast_data_dest += head_size;
       }
 
-      //                   original           transposed            iteration
-      // A: input          (BxSxNxH)          (B.)S x NH            S x NH
-      // B: weights        (NxHx3xNxH)        NH  x (3.N.)H         NH x H
-      // C: QKV[qkv_index] (3xBxNxSxH)        (3.B.N.)S x H         S x H
-
-      math::GemmEx<float, concurrency::ThreadPool>(CblasNoTrans,                   // TransA = no
-                                                   CblasNoTrans,                   // TransB = no
-                                                   sequence_length,                // M      = S
-                                                   head_size,                      // N      = H
-                                                   hidden_size,                    // K      = NH
-                                                   1.0f,                           // alpha
-                                                   input_data + input_offset,      // A
-                                                   hidden_size,                    // lda    = NH
-                                                   weights_data + weights_offset,  // B
-                                                   3 * hidden_size,                // ldb    = 3NH
-                                                   1.0f,                           // beta
-                                                   qkv_dest + qkv_offset,          // C
-                                                   head_size,                      // ldc
-                                                   nullptr                         // use single-thread
-      );
+      MLAS_SGEMM_DATA_PARAMS& params = gemm_params[i];
+      params.A = input_data + input_offset;
+      params.lda = hidden_size;
+      params.B = weights_data + weights_offset;
+      params.ldb = 3 * hidden_size;
+      params.C = QKV[qkv_index] + qkv_offset;
+      params.ldc = head_size;
     });
+
+    // the (q/k/v, batch, head) gemms are scheduled as one batch so small heads still use every thread
+    MlasGemmBatch(CblasNoTrans, CblasNoTrans, sequence_length, head_size, hidden_size, 1.0f,
+                  gemm_params.data(), gemm_params.size(), 1.0f, context->GetOperatorThreadPool());
   }
 
   // STEP.2: scratch(B, N, S, S) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, S, H -> B, N, H, S) + 1 x mask_index(B -> B, 1, 1, 1)
@@ -206,27 +203,18 @@ Status Attention<T>::Compute(OpKernelContext* context) const {
         memcpy(broadcast_data_dest, broadcast_data_src, sequence_length * sizeof(T));
         broadcast_data_dest += sequence_length;
       }
-
-      // gemm
-
-      //                   original           transposed            iteration
-      // A: Q              (BxNxSxH)          (B.N.)S x H            S x H
-      // B: K'             (BxNxSxH)          (B.N.)H x S            H x S
-      // C: scratch_data   (BxNxSxS)          (B.N.)S x S            S x S
-
-      math::Gemm<T, concurrency::ThreadPool>(
-          CblasNoTrans,
-          CblasTrans,
-          sequence_length,
-          sequence_length,
-          head_size,
-          alpha,
-          Q + sequence_length * head_size * i,
-          K + sequence_length * head_size * i,
-          1.0,
-          reinterpret_cast<T*>(scratch_data) + sequence_length * sequence_length * i,
-          nullptr);
     });
+
+    //                   original           transposed            iteration
+    // A: Q              (BxNxSxH)          (B.N.)S x H            S x H
+    // B: K'             (BxNxSxH)          (B.N.)H x S            H x S
+    // C: scratch_data   (BxNxSxS)          (B.N.)S x S            S x S
+    MlasGemmBatch(CblasNoTrans, CblasTrans, sequence_length, sequence_length, head_size, alpha,
+                  Q, head_size, sequence_length * head_size,
+                  K, head_size, sequence_length * head_size,
+                  1.0f,
+                  reinterpret_cast<T*>(scratch_data), sequence_length, sequence_length * sequence_length,
+                  loop_len, context->GetOperatorThreadPool());
   }
 
   // STEP.3: P(B, N, S, S) = Softmax(scratch)
@@ -268,32 +256,27 @@ Status Attention<T>::Compute(OpKernelContext* context) const {
     });
   }
 
-  // STEP.4: out_tmp(B, N, S, H) = P(B, N, S, S) x V(B, N, S, H)
-  auto out_tmp_data = allocator->Alloc(batch_size * num_heads_ * sequence_length * head_size * element_size);
-  BufferUniquePtr out_tmp_buffer(out_tmp_data, BufferDeleter(allocator));
-
-  concurrency::ThreadPool::TryParallelFor(context->GetOperatorThreadPool(), batch_size * num_heads_, [&](int i) {
-    T* current_tmp_data = reinterpret_cast<T*>(out_tmp_data) + sequence_length * head_size * i;
-    math::MatMul<T>(
-        sequence_length,
-        head_size,
-        sequence_length,
-        reinterpret_cast<T*>(scratch_data) + sequence_length * sequence_length * i,
-        V + sequence_length * head_size * i,
-        current_tmp_data,
-        nullptr);
-
-    // transpose: out(B, S, N, H) = transpose out_tmp(B, N, S, H)
-    const int batch_index = i / num_heads_;
-    const int head_index = i % num_heads_;
-    T* src = current_tmp_data;
-    T* dest = output->template MutableData<T>() + (batch_index * sequence_length * num_heads_ + head_index) * head_size;
-    for (int j = 0; j < sequence_length; j++) {
-      memcpy(dest, src, head_size * sizeof(T));
-      src += head_size;
-      dest += hidden_size;
+  // STEP.4: out(B, S, N, H) = transpose P(B, N, S, S) x V(B, N, S, H)
+  // Each head writes its S x H result directly into its columns of the output, which does the transpose.
+  {
+    const int loop_len = batch_size * num_heads_;
+    std::vector<MLAS_SGEMM_DATA_PARAMS> gemm_params(loop_len);
+    for (int i = 0; i < loop_len; i++) {
+      const int batch_index = i / num_heads_;
+      const int head_index = i % num_heads_;
+      MLAS_SGEMM_DATA_PARAMS& params = gemm_params[i];
+      params.A = reinterpret_cast<T*>(scratch_data) + sequence_length * sequence_length * i;
+      params.lda = sequence_length;
+      params.B = V + sequence_length * head_size * i;
+      params.ldb = head_size;
+      params.C = output->template MutableData<T>() +
+                 (batch_index * sequence_length * num_heads_ + head_index) * head_size;
+      params.ldc = hidden_size;
     }
-  });
+
+    MlasGemmBatch(CblasNoTrans, CblasNoTrans, sequence_length, head_size, sequence_length, 1.0f,
+                  gemm_params.data(), gemm_params.size(), 0.0f, context->GetOperatorThreadPool());
+  }
 
   return Status::OK();
 }
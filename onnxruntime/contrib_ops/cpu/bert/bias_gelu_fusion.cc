@@ -39,12 +39,6 @@ Status BiasGelu<T>::Compute(OpKernelContext* ctx) const {
 
   Tensor* Y = ctx->Output(0, X->Shape());
 
-  AllocatorPtr alloc;
-  ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&alloc));
-
-  BufferUniquePtr temp_data_buf_ptr = BufferUniquePtr(alloc->Alloc(sizeof(T) * X->Shape().Size()), BufferDeleter(alloc));
-  T* tmp_data = static_cast<T*>(temp_data_buf_ptr.get());
-
   const T* X_data = X->template Data<T>();
   const T* B_data = B->template Data<T>();
   T* Y_data = Y->template MutableData<T>();
@@ -53,21 +47,11 @@ Status BiasGelu<T>::Compute(OpKernelContext* ctx) const {
   concurrency::ThreadPool::TryBatchParallelFor(ctx->GetOperatorThreadPool(),
                                                static_cast<int32_t>(task_count),
                                                [&](int32_t task_idx) {
-                                                 const T* p_input = X_data + task_idx * bias_len;
-                                                 T* p_output = Y_data + task_idx * bias_len;
-                                                 T* p_output_tmp = tmp_data + task_idx * bias_len;
-
-                                                 for (int64_t h = 0; h < bias_len; h++) {
-                                                   T value = p_input[h] + B_data[h];
-                                                   p_output[h] = value * static_cast<T>(M_SQRT1_2);
-                                                   p_output_tmp[h] = value * 0.5f;
-                                                 }
-
-                                                 MlasComputeErf(p_output, p_output, bias_len);
-
-                                                 for (int64_t h = 0; h < bias_len; h++) {
-                                                   p_output[h] = p_output_tmp[h] * (p_output[h] + 1.0f);
-                                                 }
+                                                 MlasComputeBiasGelu(MlasGeluErf,
+                                                                     X_data + task_idx * bias_len,
+                                                                     B_data,
+                                                                     Y_data + task_idx * bias_len,
+                                                                     static_cast<size_t>(bias_len));
                                                });
 
   return Status::OK();
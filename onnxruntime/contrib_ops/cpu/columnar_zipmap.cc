@@ -0,0 +1,103 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/columnar_zipmap.h"
+#include "core/framework/columnar_map_sequence.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/cpu/ml/zipmap.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_KERNEL_EX(
+    ColumnarZipMap,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", {DataTypeImpl::GetType<ColumnarMapSequenceStringToFloat>(),
+                                            DataTypeImpl::GetType<ColumnarMapSequenceInt64ToFloat>()}),
+    ColumnarZipMap);
+
+template <typename TKey>
+static std::shared_ptr<const Tensor> SortedKeys(const std::vector<TKey>& labels, const std::vector<size_t>& columns,
+                                                const AllocatorPtr& allocator) {
+  auto keys = std::make_shared<Tensor>(DataTypeImpl::GetType<TKey>(),
+                                       TensorShape({static_cast<int64_t>(columns.size())}), allocator);
+  TKey* data = keys->template MutableData<TKey>();
+  for (size_t i = 0; i < columns.size(); ++i) {
+    data[i] = labels[columns[i]];
+  }
+  return keys;
+}
+
+ColumnarZipMap::ColumnarZipMap(const OpKernelInfo& info) : OpKernel(info) {
+  auto classlabels_int64s = info.GetAttrsOrDefault<int64_t>("classlabels_int64s");
+  auto classlabels_strings = info.GetAttrsOrDefault<std::string>("classlabels_strings");
+  ORT_ENFORCE(classlabels_strings.empty() ^ classlabels_int64s.empty(),
+              "Must provide classlabels_strings or classlabels_int64s but not both.");
+  using_strings_ = !classlabels_strings.empty();
+  AllocatorPtr allocator = info.GetAllocator(0, OrtMemTypeDefault);
+  if (using_strings_) {
+    num_labels_ = classlabels_strings.size();
+    sorted_columns_ = ml::ZipMapSortedColumns(classlabels_strings);
+    keys_ = SortedKeys(classlabels_strings, sorted_columns_, allocator);
+  } else {
+    num_labels_ = classlabels_int64s.size();
+    sorted_columns_ = ml::ZipMapSortedColumns(classlabels_int64s);
+    keys_ = SortedKeys(classlabels_int64s, sorted_columns_, allocator);
+  }
+
+  identity_columns_ = sorted_columns_.size() == num_labels_;
+  for (size_t i = 0; identity_columns_ && i < sorted_columns_.size(); ++i) {
+    identity_columns_ = sorted_columns_[i] == i;
+  }
+}
+
+template <typename TKey>
+Status ColumnarZipMap::ComputeImpl(OpKernelContext* context) const {
+  const Tensor& X = *context->Input<Tensor>(0);
+  const auto& x_dims = X.Shape().GetDims();
+  if (x_dims.empty() || x_dims.size() > 2) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "ColumnarZipMap only supports 1D or 2D input tensors");
+  }
+
+  const int64_t batch_size = x_dims.size() > 1 ? x_dims[0] : 1;
+  const int64_t features_per_batch = x_dims.back();
+  if (features_per_batch != static_cast<int64_t>(num_labels_)) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input features_per_batch[", features_per_batch,
+                           "] != number of classlabels[", num_labels_, "]");
+  }
+
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+  const auto num_keys = static_cast<int64_t>(sorted_columns_.size());
+  auto values = onnxruntime::make_unique<Tensor>(DataTypeImpl::GetType<float>(),
+                                                 TensorShape({batch_size, num_keys}), allocator);
+
+  const float* x_data = X.template Data<float>();
+  float* y_data = values->template MutableData<float>();
+  if (identity_columns_) {
+    std::copy(x_data, x_data + batch_size * num_keys, y_data);
+  } else {
+    concurrency::ThreadPool::TryBatchParallelFor(
+        context->GetOperatorThreadPool(), static_cast<int32_t>(batch_size), [&](int32_t n) {
+          const float* x_row = x_data + n * features_per_batch;
+          float* y_row = y_data + n * num_keys;
+          for (size_t column : sorted_columns_) {
+            *y_row++ = x_row[column];
+          }
+        });
+  }
+
+  auto* Y = context->Output<ColumnarMapSequence<TKey>>(0);
+  ORT_RETURN_IF_NOT(Y != nullptr, "output count mismatch");
+  Y->Init(keys_, std::move(values));
+  return Status::OK();
+}
+
+Status ColumnarZipMap::Compute(OpKernelContext* context) const {
+  return using_strings_ ? ComputeImpl<std::string>(context) : ComputeImpl<int64_t>(context);
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
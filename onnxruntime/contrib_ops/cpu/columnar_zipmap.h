@@ -0,0 +1,34 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// ZipMap producing a ColumnarMapSequence instead of seq(map(K, float)). The session replaces ZipMap with this
+// kernel for the graph outputs when the option use_columnar_zipmap_output is set.
+class ColumnarZipMap final : public OpKernel {
+ public:
+  explicit ColumnarZipMap(const OpKernelInfo& info);
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  template <typename TKey>
+  Status ComputeImpl(OpKernelContext* context) const;
+
+  bool using_strings_;
+  size_t num_labels_;
+  // input column of each distinct key, in map order.
+  std::vector<size_t> sorted_columns_;
+  // true when the input columns are already the distinct keys in map order, so rows are copied as they are.
+  bool identity_columns_;
+  // distinct keys in map order, shared by every output.
+  std::shared_ptr<const Tensor> keys_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
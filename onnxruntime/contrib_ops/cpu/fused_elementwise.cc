@@ -0,0 +1,350 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/fused_elementwise.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/cpu/tensor/copy.h"
+#include "core/util/math_cpuonly.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_KERNEL_EX(
+    FusedElementwise,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    FusedElementwise);
+
+namespace {
+
+// Number of elements in a tile. The scratch buffers of a tile are small enough to stay in the L1 cache while the
+// tape runs over them.
+constexpr int64_t kTileSize = 1024;
+
+struct OpInfo {
+  const char* name;
+  FusedElementwise::OpCode op;
+  int arity;
+};
+
+const OpInfo kOps[] = {
+    {"Add", FusedElementwise::OpCode::Add, 2},
+    {"Sub", FusedElementwise::OpCode::Sub, 2},
+    {"Mul", FusedElementwise::OpCode::Mul, 2},
+    {"Div", FusedElementwise::OpCode::Div, 2},
+    {"Relu", FusedElementwise::OpCode::Relu, 1},
+    {"Sigmoid", FusedElementwise::OpCode::Sigmoid, 1},
+    {"Tanh", FusedElementwise::OpCode::Tanh, 1},
+    {"Abs", FusedElementwise::OpCode::Abs, 1},
+    {"Neg", FusedElementwise::OpCode::Neg, 1},
+    {"Floor", FusedElementwise::OpCode::Floor, 1},
+    {"Ceil", FusedElementwise::OpCode::Ceil, 1},
+    {"Reciprocal", FusedElementwise::OpCode::Reciprocal, 1},
+    {"Sqrt", FusedElementwise::OpCode::Sqrt, 1},
+    {"Exp", FusedElementwise::OpCode::Exp, 1},
+    {"Log", FusedElementwise::OpCode::Log, 1},
+    {"Erf", FusedElementwise::OpCode::Erf, 1},
+};
+
+// Writes op(a, b) for count elements to y. The expressions match the standalone CPU kernels of the operators so
+// the fused node produces the same values as the subgraph it replaces.
+void RunOp(FusedElementwise::OpCode op, const float* a, const float* b, float* y, int64_t count) {
+  using OpCode = FusedElementwise::OpCode;
+  ConstEigenVectorMap<float> xa(a, count);
+  EigenVectorMap<float> ym(y, count);
+  switch (op) {
+    case OpCode::Add:
+      ym = xa + ConstEigenVectorMap<float>(b, count);
+      break;
+    case OpCode::Sub:
+      ym = xa - ConstEigenVectorMap<float>(b, count);
+      break;
+    case OpCode::Mul:
+      ym = xa.cwiseProduct(ConstEigenVectorMap<float>(b, count));
+      break;
+    case OpCode::Div:
+      ym = xa.cwiseQuotient(ConstEigenVectorMap<float>(b, count));
+      break;
+    case OpCode::Relu:
+      ym = xa.cwiseMax(0.f);
+      break;
+    case OpCode::Sigmoid:
+      MlasComputeLogistic(a, y, static_cast<size_t>(count));
+      break;
+    case OpCode::Tanh:
+      MlasComputeTanh(a, y, static_cast<size_t>(count));
+      break;
+    case OpCode::Abs:
+      ym = xa.cwiseAbs();
+      break;
+    case OpCode::Neg:
+      ym = -xa;
+      break;
+    case OpCode::Floor:
+      ym = xa.array().floor();
+      break;
+    case OpCode::Ceil:
+      ym = xa.array().ceil();
+      break;
+    case OpCode::Reciprocal:
+      ym = xa.cwiseInverse();
+      break;
+    case OpCode::Sqrt:
+      ym = xa.cwiseSqrt();
+      break;
+    case OpCode::Exp:
+      ym = xa.array().exp();
+      break;
+    case OpCode::Log:
+      ym = xa.array().log();
+      break;
+    case OpCode::Erf:
+      MlasComputeErf(a, y, static_cast<size_t>(count));
+      break;
+  }
+}
+
+// Addressing of an input that is broadcast to the output shape. Dimensions that are broadcast in the same way
+// are merged, so a per channel bias of an NCHW tensor becomes three dimensions with the strides {0, 1, 0}.
+struct BroadcastInput {
+  const float* data;
+  std::vector<int64_t> dims;
+  std::vector<int64_t> strides;
+
+  BroadcastInput(const float* input, const std::vector<int64_t>& input_dims, const std::vector<int64_t>& output_dims)
+      : data(input) {
+    const size_t rank = output_dims.size();
+    const size_t offset = rank - input_dims.size();
+    std::vector<int64_t> input_strides(rank, 0);
+    int64_t stride = 1;
+    for (size_t i = rank; i-- > offset;) {
+      const int64_t dim = input_dims[i - offset];
+      if (dim != 1) {
+        input_strides[i] = stride;
+      }
+      stride *= dim;
+    }
+
+    for (size_t i = 0; i < rank; ++i) {
+      if (output_dims[i] == 1) {
+        continue;
+      }
+      // merge with the previous dimension when both are broadcast or both are contiguous with each other
+      if (!dims.empty() && ((strides.back() == 0 && input_strides[i] == 0) ||
+                            (input_strides[i] != 0 && strides.back() == input_strides[i] * output_dims[i]))) {
+        dims.back() *= output_dims[i];
+        strides.back() = input_strides[i];
+        continue;
+      }
+      dims.push_back(output_dims[i]);
+      strides.push_back(input_strides[i]);
+    }
+    if (dims.empty()) {
+      dims.push_back(1);
+      strides.push_back(0);
+    }
+  }
+
+  // Expands the elements [first, first + count) of the broadcast input into dst. The elements are copied in runs
+  // along the inner dimension, which either repeat one value or are contiguous in the input.
+  void Gather(int64_t first, int64_t count, float* dst) const {
+    const size_t rank = dims.size();
+    const int64_t inner_dim = dims[rank - 1];
+    const int64_t inner_stride = strides[rank - 1];
+    while (count > 0) {
+      int64_t remainder = first / inner_dim;
+      const int64_t inner_index = first % inner_dim;
+      int64_t offset = inner_index * inner_stride;
+      for (size_t i = rank - 1; i-- > 0;) {
+        offset += (remainder % dims[i]) * strides[i];
+        remainder /= dims[i];
+      }
+
+      const int64_t run = std::min(count, inner_dim - inner_index);
+      if (inner_stride == 0) {
+        std::fill_n(dst, run, data[offset]);
+      } else {
+        memcpy(dst, data + offset, static_cast<size_t>(run) * sizeof(float));
+      }
+      first += run;
+      dst += run;
+      count -= run;
+    }
+  }
+};
+
+}  // namespace
+
+FusedElementwise::FusedElementwise(const OpKernelInfo& info) : OpKernel(info) {
+  std::vector<std::string> ops;
+  std::vector<int64_t> operands;
+  ORT_ENFORCE(info.GetAttrs<std::string>("ops", ops).IsOK());
+  ORT_ENFORCE(info.GetAttrs<int64_t>("operands", operands).IsOK());
+  ORT_ENFORCE(info.GetAttrs<int64_t>("output_slots", output_slots_).IsOK());
+
+  num_inputs_ = static_cast<int64_t>(info.GetInputCount());
+  ORT_ENFORCE(output_slots_.size() == info.GetOutputCount(), "output_slots must have one entry per output.");
+
+  size_t next_operand = 0;
+  for (const auto& name : ops) {
+    const auto* info_it = std::find_if(std::begin(kOps), std::end(kOps),
+                                       [&name](const OpInfo& op_info) { return name == op_info.name; });
+    ORT_ENFORCE(info_it != std::end(kOps), "Unsupported operator in the fused element-wise node: ", name);
+    ORT_ENFORCE(next_operand + info_it->arity <= operands.size(), "Too few operands for the operator ", name);
+
+    Step step;
+    step.op = info_it->op;
+    step.operands[1] = -1;
+    const int64_t slot_count = num_inputs_ + static_cast<int64_t>(steps_.size());
+    for (int i = 0; i < info_it->arity; ++i) {
+      const int64_t slot = operands[next_operand++];
+      ORT_ENFORCE(slot >= 0 && slot < slot_count, "Operand ", slot, " of the operator ", name,
+                  " does not refer to an input or an earlier result.");
+      step.operands[i] = slot;
+    }
+    step.output = -1;
+    step.buffer = -1;
+    steps_.push_back(step);
+  }
+  ORT_ENFORCE(next_operand == operands.size(), "There are more operands than the operators read.");
+
+  for (size_t i = 0; i < output_slots_.size(); ++i) {
+    const int64_t slot = output_slots_[i];
+    ORT_ENFORCE(slot >= num_inputs_ && slot < num_inputs_ + static_cast<int64_t>(steps_.size()),
+                "Output ", i, " must take the result of an operator.");
+    Step& step = steps_[slot - num_inputs_];
+    ORT_ENFORCE(step.output == -1, "Two outputs take the result of the same operator.");
+    step.output = static_cast<int64_t>(i);
+  }
+
+  // Give the results that are not outputs a scratch buffer, reusing the buffers of results that no later step reads.
+  // A buffer is released after the step that reads it for the last time has its own buffer, so a step never writes
+  // over one of its operands.
+  std::vector<int64_t> last_use(steps_.size(), -1);
+  for (size_t k = 0; k < steps_.size(); ++k) {
+    for (int64_t slot : steps_[k].operands) {
+      if (slot >= num_inputs_) {
+        last_use[slot - num_inputs_] = static_cast<int64_t>(k);
+      }
+    }
+  }
+  std::vector<int64_t> free_buffers;
+  for (size_t k = 0; k < steps_.size(); ++k) {
+    Step& step = steps_[k];
+    if (step.output == -1) {
+      if (free_buffers.empty()) {
+        step.buffer = num_buffers_++;
+      } else {
+        step.buffer = free_buffers.back();
+        free_buffers.pop_back();
+      }
+      if (last_use[k] == -1) {
+        free_buffers.push_back(step.buffer);
+      }
+    }
+    for (int i = 0; i < 2; ++i) {
+      const int64_t slot = step.operands[i];
+      if (slot < num_inputs_ || (i == 1 && slot == step.operands[0])) {
+        continue;
+      }
+      const Step& operand = steps_[slot - num_inputs_];
+      if (operand.buffer != -1 && last_use[slot - num_inputs_] == static_cast<int64_t>(k)) {
+        free_buffers.push_back(operand.buffer);
+      }
+    }
+  }
+}
+
+Status FusedElementwise::Compute(OpKernelContext* context) const {
+  // the output shape is the multidirectional broadcast of the input shapes
+  std::vector<int64_t> output_dims;
+  for (int64_t i = 0; i < num_inputs_; ++i) {
+    const auto& input_dims = context->Input<Tensor>(static_cast<int>(i))->Shape().GetDims();
+    if (input_dims.size() > output_dims.size()) {
+      output_dims.insert(output_dims.begin(), input_dims.size() - output_dims.size(), 1);
+    }
+    const size_t offset = output_dims.size() - input_dims.size();
+    for (size_t d = 0; d < input_dims.size(); ++d) {
+      int64_t& output_dim = output_dims[offset + d];
+      if (input_dims[d] == output_dim || input_dims[d] == 1) {
+        continue;
+      }
+      if (output_dim != 1) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input ", i, " with shape ",
+                               context->Input<Tensor>(static_cast<int>(i))->Shape(),
+                               " can not be broadcast to the other inputs.");
+      }
+      output_dim = input_dims[d];
+    }
+  }
+
+  const TensorShape output_shape(output_dims);
+  const int64_t size = output_shape.Size();
+  std::vector<float*> outputs(output_slots_.size());
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    outputs[i] = context->Output(static_cast<int>(i), output_shape)->MutableData<float>();
+  }
+  if (size == 0) {
+    return Status::OK();
+  }
+
+  // inputs with the output shape are read in place, the others are expanded tile by tile
+  std::vector<const float*> full_inputs(static_cast<size_t>(num_inputs_), nullptr);
+  std::vector<BroadcastInput> broadcast_inputs;
+  std::vector<int64_t> broadcast_index(static_cast<size_t>(num_inputs_), -1);
+  for (int64_t i = 0; i < num_inputs_; ++i) {
+    const auto* input = context->Input<Tensor>(static_cast<int>(i));
+    if (input->Shape().Size() == size) {
+      full_inputs[i] = input->Data<float>();
+    } else {
+      broadcast_index[i] = static_cast<int64_t>(broadcast_inputs.size());
+      broadcast_inputs.emplace_back(input->Data<float>(), input->Shape().GetDims(), output_dims);
+    }
+  }
+
+  const size_t slot_count = static_cast<size_t>(num_inputs_) + steps_.size();
+  const size_t buffer_count = static_cast<size_t>(num_buffers_) + broadcast_inputs.size();
+
+  ParallelForBlocks(context->GetOperatorThreadPool(), (size + kTileSize - 1) / kTileSize,
+                    kTileSize * sizeof(float) * (steps_.size() + 1),
+                    [&](int64_t first_tile, int64_t last_tile) {
+                      std::vector<float> scratch(buffer_count * kTileSize);
+                      std::vector<const float*> slots(slot_count);
+                      for (int64_t tile = first_tile; tile < last_tile; ++tile) {
+                        const int64_t start = tile * kTileSize;
+                        const int64_t count = std::min(kTileSize, size - start);
+
+                        for (int64_t i = 0; i < num_inputs_; ++i) {
+                          if (full_inputs[i] != nullptr) {
+                            slots[i] = full_inputs[i] + start;
+                          } else {
+                            float* dst = scratch.data() + (num_buffers_ + broadcast_index[i]) * kTileSize;
+                            broadcast_inputs[broadcast_index[i]].Gather(start, count, dst);
+                            slots[i] = dst;
+                          }
+                        }
+
+                        for (size_t k = 0; k < steps_.size(); ++k) {
+                          const Step& step = steps_[k];
+                          float* y = step.output != -1 ? outputs[step.output] + start
+                                                       : scratch.data() + step.buffer * kTileSize;
+                          const float* b = step.operands[1] != -1 ? slots[step.operands[1]] : nullptr;
+                          RunOp(step.op, slots[step.operands[0]], b, y, count);
+                          slots[num_inputs_ + k] = y;
+                        }
+                      }
+                    });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
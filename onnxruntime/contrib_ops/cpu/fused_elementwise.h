@@ -0,0 +1,59 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Runs a chain of element-wise operators that the ElementwiseFusion transformer collapsed into one node. The
+// operators are kept as a small tape that is interpreted over tiles of the output, so the intermediate results
+// stay in cache-sized buffers instead of being written out as whole tensors between the operators.
+class FusedElementwise final : public OpKernel {
+ public:
+  explicit FusedElementwise(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+  enum class OpCode {
+    Add,
+    Sub,
+    Mul,
+    Div,
+    Relu,
+    Sigmoid,
+    Tanh,
+    Abs,
+    Neg,
+    Floor,
+    Ceil,
+    Reciprocal,
+    Sqrt,
+    Exp,
+    Log,
+    Erf,
+  };
+
+ private:
+  // One operator of the tape. Slots [0, num_inputs) are the inputs of the node and slot num_inputs + k is the
+  // result of step k.
+  struct Step {
+    OpCode op;
+    int64_t operands[2];  // the second operand is -1 for unary operators
+    int64_t output;       // index of the node output taking the result, or -1
+    int64_t buffer;       // index of the scratch buffer holding the result when it is not an output, or -1
+  };
+
+  int64_t num_inputs_;
+  std::vector<Step> steps_;
+  std::vector<int64_t> output_slots_;
+  int64_t num_buffers_ = 0;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -4,8 +4,10 @@
 #include "layer_norm.h"
 
 #include "core/framework/tensor.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/platform/threadpool.h"
 #include "core/providers/common.h"
+#include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 
 namespace onnxruntime {
@@ -24,6 +26,42 @@ namespace contrib {
 
 REGISTER_KERNEL_TYPED(float)
 REGISTER_KERNEL_TYPED(double)
+REGISTER_KERNEL_TYPED(MLFloat16)
+REGISTER_KERNEL_TYPED(BFloat16)
+
+namespace {
+
+// Normalizes one row, scales and shifts it and returns the row mean and inverse standard deviation.
+template <typename T>
+void ComputeRow(const T* p_input, const T* scale_data, const T* bias_data, T* p_output, int64_t norm_size,
+                float epsilon, T* p_mean, T* p_inv_std_var) {
+  T mean = 0;
+  T mean_square = 0;
+
+  for (int64_t h = 0; h < norm_size; h++) {
+    mean += p_input[h];
+    mean_square += p_input[h] * p_input[h];
+  }
+
+  mean = mean / norm_size;
+  T inv_std_var = 1 / sqrt(mean_square / norm_size - mean * mean + epsilon);
+
+  for (int64_t h = 0; h < norm_size; h++) {
+    p_output[h] = (p_input[h] - mean) * inv_std_var * scale_data[h] + bias_data[h];
+  }
+
+  *p_mean = mean;
+  *p_inv_std_var = inv_std_var;
+}
+
+template <>
+void ComputeRow<float>(const float* p_input, const float* scale_data, const float* bias_data, float* p_output,
+                       int64_t norm_size, float epsilon, float* p_mean, float* p_inv_std_var) {
+  MlasComputeLayerNorm(p_input, nullptr, nullptr, scale_data, bias_data, p_output, static_cast<size_t>(norm_size),
+                       epsilon, p_mean, p_inv_std_var);
+}
+
+}  // namespace
 
 template <typename T>
 LayerNorm<T>::LayerNorm(const OpKernelInfo& op_kernel_info)
@@ -90,30 +128,92 @@ Status LayerNorm<T>::Compute(OpKernelContext* p_ctx) const {
   concurrency::ThreadPool::TryBatchParallelFor(p_ctx->GetOperatorThreadPool(),
                                                static_cast<int32_t>(norm_count),
                                                [&](int32_t task_idx) {
-                                                 const T* p_input = X_data + task_idx * norm_size;
-                                                 T* p_output = Y_data + task_idx * norm_size;
+                                                 ComputeRow<T>(X_data + task_idx * norm_size, scale_data, bias_data,
+                                                               Y_data + task_idx * norm_size, norm_size, epsilon_,
+                                                               mean_data + task_idx, inv_std_var_data + task_idx);
+                                               });
 
-                                                 T mean = 0;
-                                                 T mean_square = 0;
+  return Status::OK();
+}
 
-                                                 for (int64_t h = 0; h < norm_size; h++) {
-                                                   mean += p_input[h];
-                                                   mean_square += p_input[h] * p_input[h];
-                                                 }
+namespace {
 
-                                                 mean = mean / norm_size;
-                                                 mean_square = sqrt(mean_square / norm_size - mean * mean + epsilon_);
+// Half precision LayerNorm keeps X, Y, scale and bias in their 16-bit storage type and computes each row in float.
+// The statistics are computed in float as well and the saved mean and inv_std_var outputs are float tensors.
+template <typename T>
+Status ComputeHalf(OpKernelContext* p_ctx, int64_t axis_attr, float epsilon) {
+  const Tensor* X = p_ctx->Input<Tensor>(0);
+  const Tensor* scale = p_ctx->Input<Tensor>(1);
+  const Tensor* bias = p_ctx->Input<Tensor>(2);
 
-                                                 for (int64_t h = 0; h < norm_size; h++) {
-                                                   p_output[h] = (p_input[h] - mean) / mean_square * scale_data[h] + bias_data[h];
-                                                 }
+  const TensorShape& x_shape = X->Shape();
+  const int64_t axis = HandleNegativeAxis(axis_attr, x_shape.NumDimensions());
+  auto norm_count = x_shape.SizeToDimension(axis);
+  auto norm_size = x_shape.SizeFromDimension(axis);
+
+  Tensor* Y = p_ctx->Output(0, x_shape);
 
-                                                 mean_data[task_idx] = mean;
-                                                 inv_std_var_data[task_idx] = mean_square;
+  std::vector<int64_t> mean_inv_std_var_dim;
+  mean_inv_std_var_dim.reserve(x_shape.NumDimensions());
+  for (int i = 0; i < static_cast<int>(x_shape.NumDimensions()); ++i) {
+    mean_inv_std_var_dim.emplace_back(i < axis ? x_shape.GetDims()[i] : 1);
+  }
+  Tensor* mean = p_ctx->Output(1, TensorShape(mean_inv_std_var_dim));
+  Tensor* inv_std_var = p_ctx->Output(2, TensorShape(mean_inv_std_var_dim));
+  float* mean_data = mean != nullptr ? mean->template MutableData<float>() : nullptr;
+  float* inv_std_var_data = inv_std_var != nullptr ? inv_std_var->template MutableData<float>() : nullptr;
+
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(p_ctx->GetTempSpaceAllocator(&alloc));
+
+  // One float buffer holds the converted scale and bias followed by a row of scratch per row of X.
+  auto buffer = IAllocator::MakeUniquePtr<float>(alloc, static_cast<size_t>((norm_count + 2) * norm_size));
+  float* scale_data = buffer.get();
+  float* bias_data = scale_data + norm_size;
+  float* rows_data = bias_data + norm_size;
+  math::ConvertToFloat<T>(scale->template Data<T>(), scale_data, static_cast<size_t>(norm_size));
+  math::ConvertToFloat<T>(bias->template Data<T>(), bias_data, static_cast<size_t>(norm_size));
+
+  const T* X_data = X->template Data<T>();
+  T* Y_data = Y->template MutableData<T>();
+
+  concurrency::ThreadPool::TryBatchParallelFor(p_ctx->GetOperatorThreadPool(),
+                                               static_cast<int32_t>(norm_count),
+                                               [&](int32_t task_idx) {
+                                                 float* p_row = rows_data + task_idx * norm_size;
+                                                 math::ConvertToFloat<T>(X_data + task_idx * norm_size, p_row,
+                                                                         static_cast<size_t>(norm_size));
+
+                                                 float row_mean;
+                                                 float row_inv_std_var;
+                                                 ComputeRow<float>(p_row, scale_data, bias_data, p_row, norm_size,
+                                                                   epsilon, &row_mean, &row_inv_std_var);
+
+                                                 math::ConvertFromFloat<T>(p_row, Y_data + task_idx * norm_size,
+                                                                           static_cast<size_t>(norm_size));
+
+                                                 if (mean_data != nullptr) {
+                                                   mean_data[task_idx] = row_mean;
+                                                 }
+                                                 if (inv_std_var_data != nullptr) {
+                                                   inv_std_var_data[task_idx] = row_inv_std_var;
+                                                 }
                                                });
 
   return Status::OK();
 }
 
+}  // namespace
+
+template <>
+Status LayerNorm<MLFloat16>::Compute(OpKernelContext* p_ctx) const {
+  return ComputeHalf<MLFloat16>(p_ctx, axis_, epsilon_);
+}
+
+template <>
+Status LayerNorm<BFloat16>::Compute(OpKernelContext* p_ctx) const {
+  return ComputeHalf<BFloat16>(p_ctx, axis_, epsilon_);
+}
+
 }  // namespace contrib
 }  // namespace onnxruntime
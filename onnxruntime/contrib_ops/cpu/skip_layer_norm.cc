@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/framework/tensor.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/util/math_cpuonly.h"
 #include "core/providers/common.h"
 #include "core/platform/threadpool.h"
@@ -24,6 +25,42 @@ namespace contrib {
 REGISTER_KERNEL_TYPED(float)
 REGISTER_KERNEL_TYPED(double)
 
+namespace {
+
+// Forms one row from the input, skip and optional bias and then normalizes, scales and shifts it.
+template <typename T>
+void ComputeRow(const T* p_input, const T* p_skip, const T* bias_data, const T* gamma_data, const T* beta_data,
+                T* p_output, int64_t hidden_size) {
+  T mean = 0;
+  T mean_square = 0;
+
+  for (int64_t h = 0; h < hidden_size; h++) {
+    T value = p_input[h] + p_skip[h];
+    if (nullptr != bias_data) {
+      value += bias_data[h];
+    }
+    p_output[h] = value;
+    mean += value;
+    mean_square += value * value;
+  }
+
+  mean = mean / hidden_size;
+  mean_square = sqrt(mean_square / hidden_size - mean * mean + float(1e-12));
+
+  for (int64_t h = 0; h < hidden_size; h++) {
+    p_output[h] = (p_output[h] - mean) / mean_square * gamma_data[h] + beta_data[h];
+  }
+}
+
+template <>
+void ComputeRow<float>(const float* p_input, const float* p_skip, const float* bias_data, const float* gamma_data,
+                       const float* beta_data, float* p_output, int64_t hidden_size) {
+  MlasComputeLayerNorm(p_input, p_skip, bias_data, gamma_data, beta_data, p_output, static_cast<size_t>(hidden_size),
+                       1e-12f, nullptr, nullptr);
+}
+
+}  // namespace
+
 template <typename T>
 SkipLayerNorm<T>::SkipLayerNorm(const OpKernelInfo& op_kernel_info)
     : OpKernel(op_kernel_info) {
@@ -97,29 +134,10 @@ Status SkipLayerNorm<T>::Compute(OpKernelContext* p_ctx) const {
   concurrency::ThreadPool::TryBatchParallelFor(p_ctx->GetOperatorThreadPool(),
                                                static_cast<int32_t>(task_count),
                                                [&](int32_t task_idx) {
-                                                 const T* p_input = input_data + task_idx * hidden_size;
-                                                 const T* p_skip = skip_data + task_idx * hidden_size;
-                                                 T* p_output = output_data + task_idx * hidden_size;
-
-                                                 T mean = 0;
-                                                 T mean_square = 0;
-
-                                                 for (int64_t h = 0; h < hidden_size; h++) {
-                                                   T value = p_input[h] + p_skip[h];
-                                                   if (nullptr != bias_data) {
-                                                     value += bias_data[h];
-                                                   }
-                                                   p_output[h] = value;
-                                                   mean += value;
-                                                   mean_square += value * value;
-                                                 }
-
-                                                 mean = mean / hidden_size;
-                                                 mean_square = sqrt(mean_square / hidden_size - mean * mean + float(1e-12));
-
-                                                 for (int64_t h = 0; h < hidden_size; h++) {
-                                                   p_output[h] = (p_output[h] - mean) / mean_square * gamma_data[h] + beta_data[h];
-                                                 }
+                                                 ComputeRow<T>(input_data + task_idx * hidden_size,
+                                                               skip_data + task_idx * hidden_size, bias_data,
+                                                               gamma_data, beta_data,
+                                                               output_data + task_idx * hidden_size, hidden_size);
                                                });
 
   return Status::OK();
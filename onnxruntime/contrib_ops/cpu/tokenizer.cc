@@ -4,6 +4,7 @@
 #include "core/common/common.h"
 #include "core/framework/tensor.h"
 #include "core/framework/op_kernel.h"
+#include "core/platform/threadpool.h"
 #include "core/graph/onnx_protobuf.h"
 #include "onnx/defs/schema.h"
 
@@ -13,6 +14,22 @@
 namespace onnxruntime {
 namespace contrib {
 
+namespace tokenizer_details {
+// A token as a range of bytes in its input string
+struct Token {
+  size_t offset;
+  size_t length;
+};
+
+// Tokens of a contiguous range of input strings
+struct TokenBlock {
+  std::vector<Token> tokens;
+  // end of each row in tokens
+  std::vector<size_t> row_ends;
+  Status status;
+};
+}  // namespace tokenizer_details
+
 class Tokenizer final : public OpKernel {
  public:
   explicit Tokenizer(const OpKernelInfo& info);
@@ -23,21 +40,29 @@ class Tokenizer final : public OpKernel {
   Status Compute(OpKernelContext* context) const override;
 
  private:
-  Status CharTokenize(OpKernelContext* context, size_t N, size_t C,
-                      const std::vector<int64_t>& input_dims) const;
+  using Token = tokenizer_details::Token;
+
+  Status Tokenize(OpKernelContext* context, size_t N, size_t C,
+                  const std::vector<int64_t>& input_dims) const;
 
-  Status SeparatorExpressionTokenizer(OpKernelContext* context, size_t N, size_t C,
-                                      const std::vector<int64_t>& input_dims) const;
+  Status TokenizeRow(const std::string& s, std::vector<Token>& tokens,
+                     std::vector<Token>& scratch) const;
 
-  Status TokenExpression(OpKernelContext* ctx,
-                         size_t N, size_t C,
-                         const std::vector<int64_t>& input_dims) const;
+  void CharTokenize(const std::string& s, std::vector<Token>& tokens) const;
+
+  Status SeparatorExpressionTokenizer(const re2::RE2& separator, const std::string& s,
+                                      const Token& text, std::vector<Token>& tokens) const;
+
+  Status TokenExpression(const std::string& s, std::vector<Token>& tokens) const;
 
   bool mark_{false};
   std::string pad_value_;
   int64_t mincharnum_{0};
   bool char_tokenezation_{false};
   std::vector<std::unique_ptr<re2::RE2>> separators_;
+  // All separators in one expression, set when that splits the same way as
+  // applying separators_ one after another
+  std::unique_ptr<re2::RE2> combined_separators_;
   std::unique_ptr<re2::RE2> regex_;
 };
 
@@ -54,6 +79,28 @@ ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
 namespace tokenizer_details {
 const char start_text = 0x2;
 const char end_text = 0x3;
+
+// Returns true if the separator has no regular expression syntax,
+// so it only matches its own text
+bool IsLiteral(const std::string& separator) {
+  return separator.find_first_of("\\^$.|?*+()[]{}") == std::string::npos;
+}
+
+// Returns true if an occurrence of one literal can share bytes
+// with an occurrence of the other
+bool CanOverlap(const std::string& a, const std::string& b) {
+  if (a.find(b) != std::string::npos || b.find(a) != std::string::npos) {
+    return true;
+  }
+  const size_t max_len = std::min(a.size(), b.size());
+  for (size_t len = 1; len < max_len; ++len) {
+    if (a.compare(a.size() - len, len, b, 0, len) == 0 ||
+        b.compare(b.size() - len, len, a, 0, len) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
 }  // namespace tokenizer_details
 
 using namespace tokenizer_details;
@@ -102,6 +149,30 @@ Tokenizer::Tokenizer(const OpKernelInfo& info) : OpKernel(info) {
         }
         separators_.push_back(std::move(regex));
       }
+      // Applying the separators one after another rescans every token once per separator.
+      // When the separators are literals that can not overlap, the earlier ones never hide
+      // a match of the later ones, so a single scan for any of them splits the same way.
+      bool combine = separators.size() > 1;
+      for (size_t i = 0; combine && i < separators.size(); ++i) {
+        combine = IsLiteral(separators[i]);
+        for (size_t j = 0; combine && j < i; ++j) {
+          combine = !CanOverlap(separators[i], separators[j]);
+        }
+      }
+      if (combine) {
+        std::string combined;
+        for (const auto& sep : separators) {
+          if (!combined.empty()) {
+            combined.push_back('|');
+          }
+          combined.append(re2::RE2::QuoteMeta(sep));
+        }
+        std::unique_ptr<re2::RE2> regex(new re2::RE2(combined, options));
+        if (!regex->ok()) {
+          ORT_THROW("Can not digest separators: ", combined, " ", regex->error());
+        }
+        combined_separators_.swap(regex);
+      }
     } else {
       // Use tokenexp
       assert(!tokenexp.empty());
@@ -116,291 +187,193 @@ Tokenizer::Tokenizer(const OpKernelInfo& info) : OpKernel(info) {
   }
 }
 
-Status Tokenizer::CharTokenize(OpKernelContext* ctx, size_t N, size_t C,
-                               const std::vector<int64_t>& input_dims) const {
+void Tokenizer::CharTokenize(const std::string& s, std::vector<Token>& tokens) const {
   // With char tokenzation we get as many tokens as the number of
-  // utf8 characters in the string. So for every string we calculate its character(utf8) length
-  // add padding and add start/end test separators if necessary
-  size_t max_tokens = 0;
-  auto X = ctx->Input<Tensor>(0);
-  auto const input_data = X->template Data<std::string>();
-  auto curr_input = input_data;
-  auto const last = input_data + N * C;
-  while (curr_input != last) {
-    const auto& s = *curr_input;
-    size_t tokens = 0;  // length in utf8 chars
-    if (!utf8_validate(reinterpret_cast<const unsigned char*>(s.data()), s.size(),
-                       tokens)) {
-      return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                    "Input string contains invalid utf8 chars: " + s);
-    }
-    max_tokens = std::max(max_tokens, tokens);
-    ++curr_input;
-  }
-
-  std::vector<int64_t> output_dims(input_dims);
-  // Check if we have no output due to apparently empty strings input.
-  if (max_tokens == 0) {
-    output_dims.push_back(0);
-    TensorShape output_shape(output_dims);
-    ctx->Output(0, output_shape);
-    return Status::OK();
+  // utf8 characters in the string.
+  const size_t str_len = s.size();
+  for (size_t token_idx = 0; token_idx < str_len;) {
+    size_t tlen = 0;
+    bool result = utf8_bytes(static_cast<unsigned char>(s[token_idx]), tlen);
+    assert(result);
+    (void)result;
+    assert(token_idx + tlen <= str_len);
+    tokens.push_back(Token{token_idx, tlen});
+    token_idx += tlen;
   }
+}
 
-  if (mark_) {
-    max_tokens += 2;  // Start/end markers as separate tokens
-  }
+Status Tokenizer::SeparatorExpressionTokenizer(const re2::RE2& separator, const std::string& s,
+                                               const Token& text_token,
+                                               std::vector<Token>& tokens) const {
+  using namespace re2;
+  // We do not constraint the search to match
+  // on the beginning or end of the string
+  const RE2::Anchor anchor = RE2::UNANCHORED;
 
-  output_dims.push_back(max_tokens);
-  TensorShape output_shape(output_dims);
-  auto output_tensor = ctx->Output(0, output_shape);
-  auto const output_data = output_tensor->template MutableData<std::string>();
-  size_t output_index = 0;
-  curr_input = input_data;
-  while (curr_input != last) {
-    const auto& s = *curr_input;
-    if (mark_) {
-      (output_data + output_index)->assign(&start_text, 1);
-      ++output_index;
-    }
-    size_t tokens = 0;
-    const size_t str_len = s.size();
-    for (size_t token_idx = 0; token_idx < str_len;) {
-      size_t tlen = 0;
-      bool result = utf8_bytes(static_cast<unsigned char>(s[token_idx]), tlen);
-      assert(result);
-      (void)result;
-      assert(token_idx + tlen <= str_len);
-      *(output_data + output_index) = s.substr(token_idx, tlen);
-      ++output_index;
-      token_idx += tlen;
-      ++tokens;
-    }
-    if (mark_) {
-      (output_data + output_index)->assign(&end_text, 1);
-      ++output_index;
-    }
-    // Padding strings
-    assert(tokens + (mark_ * 2) <= max_tokens);
-    const size_t pads = max_tokens - (mark_ * 2) - tokens;
-    for (size_t p = 0; p < pads; ++p) {
-      *(output_data + output_index) = pad_value_;
-      ++output_index;
+  const StringPiece text(s.data() + text_token.offset, text_token.length);
+  const auto end_pos = text.length();
+  size_t start_pos = 0;
+  StringPiece submatch;
+
+  bool match = true;
+  do {
+    match = start_pos <= end_pos &&
+            separator.Match(text, start_pos, end_pos, anchor, &submatch, 1);
+    if (match) {
+      // Record  pos/len
+      assert(submatch.data() != nullptr);
+      size_t match_pos = submatch.data() - text.data();
+      assert(match_pos >= start_pos);
+      auto token_len = match_pos - start_pos;
+      size_t utf8_chars = 0;
+      bool valid = utf8_len(reinterpret_cast<const unsigned char*>(text.data() + start_pos),
+                            token_len, utf8_chars);
+      if (!valid) {
+        return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                      "Match contains invalid utf8 chars: " + submatch.as_string());
+      }
+      if (utf8_chars >= size_t(mincharnum_)) {
+        tokens.push_back(Token{text_token.offset + start_pos, token_len});
+      }
+      // Update starting position
+      // Guard against empty string match
+      auto match_len = submatch.length();
+      if (match_len > 0) {
+        start_pos = match_pos + match_len;
+      } else {
+        size_t bytes = 0;
+        utf8_bytes(*submatch.data(), bytes);
+        start_pos = match_pos + bytes;
+      }
+    } else if (start_pos < end_pos) {
+      // record trailing token
+      auto trailing_len = end_pos - start_pos;
+      size_t utf8_chars = 0;
+      utf8_len(reinterpret_cast<const unsigned char*>(text.data() + start_pos),
+               trailing_len, utf8_chars);
+      if (utf8_chars >= size_t(mincharnum_)) {
+        tokens.push_back(Token{text_token.offset + start_pos, trailing_len});
+      }
     }
-    ++curr_input;
-  }
+  } while (match);
   return Status::OK();
 }
 
-Status Tokenizer::SeparatorExpressionTokenizer(OpKernelContext* ctx,
-                                               size_t N, size_t C,
-                                               const std::vector<int64_t>& input_dims) const {
+Status Tokenizer::TokenExpression(const std::string& s, std::vector<Token>& tokens) const {
   using namespace re2;
-  std::vector<std::vector<StringPiece>> rows;
-  rows.reserve(N * C);
-
   // We do not constraint the search to match
   // on the beginning or end of the string
   const RE2::Anchor anchor = RE2::UNANCHORED;
 
-  // Scan all strings and attempt to find separators in them
-  // collect all the output tokens here
-  size_t max_tokens = 0;
-  auto X = ctx->Input<Tensor>(0);
-  auto const input_data = X->template Data<std::string>();
-  auto curr_input = input_data;
-  auto const last = input_data + N * C;
-  while (curr_input != last) {
-    const auto& s = *curr_input;
-    size_t utf8_chars = 0;  // length in utf8 chars
-    if (!utf8_validate(reinterpret_cast<const unsigned char*>(s.data()), s.size(),
-                       utf8_chars)) {
-      return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                    "Input string contains invalid utf8 chars: " + s);
+  StringPiece text(s);
+  const auto end_pos = s.length();
+  size_t start_pos = 0;
+  StringPiece submatch;
+
+  bool match = true;
+  do {
+    match = regex_->Match(text, start_pos, end_pos, anchor, &submatch, 1);
+    if (match) {
+      // Record  pos/len
+      assert(submatch.data() != nullptr);
+      size_t match_pos = submatch.data() - s.data();
+      assert(match_pos >= start_pos);
+      // Guard against empty match and make
+      // sure we make progress either way
+      auto token_len = submatch.length();
+      size_t utf8_chars = 0;
+      if (!utf8_len(reinterpret_cast<const unsigned char*>(submatch.data()), token_len, utf8_chars)) {
+        return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                      "Match contains invalid utf8 chars: " + submatch.as_string());
+      }
+      if (utf8_chars >= size_t(mincharnum_)) {
+        tokens.push_back(Token{match_pos, token_len});
+        start_pos = match_pos + token_len;
+      } else {
+        size_t bytes = 0;
+        utf8_bytes(*submatch.data(), bytes);
+        start_pos = match_pos + bytes;
+      }
     }
+  } while (match && start_pos <= end_pos);
+  return Status::OK();
+}
 
-    std::vector<StringPiece> row{s};
-
-    for (const auto& sep : separators_) {
-      std::vector<StringPiece> tokens;
-      for (const auto& text : row) {
-        const auto end_pos = text.length();
-        size_t start_pos = 0;
-        StringPiece submatch;
-
-        bool match = true;
-        do {
-          match = sep->Match(text, start_pos, end_pos, anchor, &submatch, 1);
-          if (match) {
-            // Record  pos/len
-            assert(submatch.data() != nullptr);
-            size_t match_pos = submatch.data() - text.data();
-            assert(match_pos >= start_pos);
-            auto token_len = match_pos - start_pos;
-            utf8_chars = 0;
-            bool valid = utf8_len(reinterpret_cast<const unsigned char*>(text.data() + start_pos),
-                                  token_len, utf8_chars);
-            if (!valid) {
-              return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                            "Match contains invalid utf8 chars: " + submatch.as_string());
-            }
-            if (utf8_chars >= size_t(mincharnum_)) {
-              tokens.emplace_back(text.data() + start_pos, token_len);
-            }
-            // Update starting position
-            // Guard against empty string match
-            auto match_len = submatch.length();
-            if (match_len > 0) {
-              start_pos = match_pos + match_len;
-            } else {
-              size_t bytes = 0;
-              utf8_bytes(*submatch.data(), bytes);
-              start_pos = match_pos + bytes;
-            }
-          } else {
-            // record trailing token
-            auto trailing_len = end_pos - start_pos;
-            utf8_chars = 0;
-            utf8_len(reinterpret_cast<const unsigned char*>(text.data() + start_pos),
-                     trailing_len, utf8_chars);
-            if (utf8_chars >= size_t(mincharnum_)) {
-              tokens.emplace_back(text.data() + start_pos, trailing_len);
-            }
-          }
-        } while (match);
-      }  // row
-      // Replace the row with the results of this tokenezation
-      row.swap(tokens);
-    }  // separators_
-    max_tokens = std::max(max_tokens, row.size());
-    rows.push_back(std::move(row));
-    ++curr_input;
+Status Tokenizer::TokenizeRow(const std::string& s, std::vector<Token>& tokens,
+                              std::vector<Token>& scratch) const {
+  size_t utf8_chars = 0;  // length in utf8 chars
+  if (!utf8_validate(reinterpret_cast<const unsigned char*>(s.data()), s.size(),
+                     utf8_chars)) {
+    return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                  "Input string contains invalid utf8 chars: " + s);
   }
 
-  std::vector<int64_t> output_dims(input_dims);
-  // Check if we have no output due to either empty input
-  // everything is a separator
-  if (max_tokens == 0) {
-    output_dims.push_back(0);
-    TensorShape output_shape(output_dims);
-    ctx->Output(0, output_shape);
+  if (char_tokenezation_) {
+    CharTokenize(s, tokens);
     return Status::OK();
   }
 
-  if (mark_) {
-    max_tokens += 2;  // Start/end markers as separate tokens
+  if (regex_ != nullptr) {
+    return TokenExpression(s, tokens);
   }
 
-  output_dims.push_back(max_tokens);
-  TensorShape output_shape(output_dims);
-
-  auto output_tensor = ctx->Output(0, output_shape);
-  auto const output_data = output_tensor->template MutableData<std::string>();
+  const Token text{0, s.size()};
+  if (combined_separators_ != nullptr) {
+    return SeparatorExpressionTokenizer(*combined_separators_, s, text, tokens);
+  }
 
-#ifdef _DEBUG
-  const size_t max_output_index = N * C * max_tokens;
-#endif
-  size_t output_index = 0;
-  curr_input = input_data;
-  for (auto& row : rows) {
-#ifdef _DEBUG
-    size_t c_idx = output_index;
-#endif
-    if (mark_) {
-      (output_data + output_index)->assign(&start_text, 1);
-      ++output_index;
-    }
-    // Output tokens for this row
-    for (const auto& token : row) {
-      (output_data + output_index)->assign(token.data(), token.size());
-      ++output_index;
-    }
-    if (mark_) {
-      (output_data + output_index)->assign(&end_text, 1);
-      ++output_index;
-    }
-    const size_t pads = max_tokens - (mark_ * 2) - row.size();
-    for (size_t p = 0; p < pads; ++p) {
-      *(output_data + output_index) = pad_value_;
-      ++output_index;
+  // Each separator splits the tokens left by the previous ones
+  const size_t row_begin = tokens.size();
+  tokens.push_back(text);
+  for (const auto& sep : separators_) {
+    scratch.assign(tokens.begin() + row_begin, tokens.end());
+    tokens.resize(row_begin);
+    for (const auto& token : scratch) {
+      ORT_RETURN_IF_ERROR(SeparatorExpressionTokenizer(*sep, s, token, tokens));
     }
-#ifdef _DEBUG
-    assert(output_index <= max_output_index);
-    assert((output_index - c_idx) <= max_tokens);
-#endif
-    ++curr_input;
   }
   return Status::OK();
 }
 
-Status Tokenizer::TokenExpression(OpKernelContext* ctx,
-                                  size_t N, size_t C,
-                                  const std::vector<int64_t>& input_dims) const {
-  using namespace re2;
-  // Represents a token that will be output after
-  // first is the index, second is the size;
-  std::vector<std::vector<StringPiece>> tokens;
-  tokens.reserve(N * C);
-
-  size_t max_tokens = 0;
+Status Tokenizer::Tokenize(OpKernelContext* ctx, size_t N, size_t C,
+                           const std::vector<int64_t>& input_dims) const {
   auto X = ctx->Input<Tensor>(0);
   auto const input_data = X->template Data<std::string>();
-  auto curr_input = input_data;
-  auto const last = input_data + N * C;
-
-  // We do not constraint the search to match
-  // on the beginning or end of the string
-  const RE2::Anchor anchor = RE2::UNANCHORED;
-
-  while (curr_input != last) {
-    const auto& s = *curr_input;
-
-    size_t utf8_chars = 0;
-    if (!utf8_validate(reinterpret_cast<const unsigned char*>(s.data()), s.size(),
-                       utf8_chars)) {
-      return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                    "Input string contains invalid utf8 chars: " + s);
+  const size_t rows = N * C;
+
+  // The strings are tokenized in contiguous blocks on the thread pool.
+  // Tokens are kept as offsets into the input so every output string is written once
+  // after the number of tokens in the longest row is known.
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+  const size_t num_blocks = std::min(rows, tp != nullptr ? static_cast<size_t>(tp->NumThreads() + 1) : size_t{1});
+  std::vector<tokenizer_details::TokenBlock> blocks(num_blocks);
+  auto block_begin = [rows, num_blocks](size_t block) { return block * rows / num_blocks; };
+
+  concurrency::ThreadPool::TryParallelFor(tp, static_cast<int32_t>(num_blocks), [&](int32_t b) {
+    auto& block = blocks[b];
+    std::vector<Token> scratch;
+    const size_t end = block_begin(b + 1);
+    block.row_ends.reserve(end - block_begin(b));
+    for (size_t row = block_begin(b); row < end; ++row) {
+      block.status = TokenizeRow(input_data[row], block.tokens, scratch);
+      if (!block.status.IsOK()) {
+        break;
+      }
+      block.row_ends.push_back(block.tokens.size());
     }
+  });
 
-    tokens.emplace_back();
-    auto& row = tokens.back();
-
-    StringPiece text(s);
-    const auto end_pos = s.length();
-    size_t start_pos = 0;
-    StringPiece submatch;
-
-    bool match = true;
-    do {
-      match = regex_->Match(text, start_pos, end_pos, anchor, &submatch, 1);
-      if (match) {
-        // Record  pos/len
-        assert(submatch.data() != nullptr);
-        size_t match_pos = submatch.data() - s.data();
-        assert(match_pos >= start_pos);
-        // Guard against empty match and make
-        // sure we make progress either way
-        auto token_len = submatch.length();
-        utf8_chars = 0;
-        if (!utf8_len(reinterpret_cast<const unsigned char*>(submatch.data()), token_len, utf8_chars)) {
-          return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                        "Match contains invalid utf8 chars: " + submatch.as_string());
-        }
-        if (utf8_chars >= size_t(mincharnum_)) {
-          row.push_back(submatch);
-          start_pos = match_pos + token_len;
-        } else {
-          size_t bytes = 0;
-          utf8_bytes(*submatch.data(), bytes);
-          start_pos = match_pos + bytes;
-        }
-      }
-    } while (match);
-    max_tokens = std::max(max_tokens, row.size());
-    ++curr_input;
+  size_t max_tokens = 0;
+  for (const auto& block : blocks) {
+    // Blocks are in input order so this reports the first invalid string
+    ORT_RETURN_IF_ERROR(block.status);
+    size_t row_begin = 0;
+    for (auto row_end : block.row_ends) {
+      max_tokens = std::max(max_tokens, row_end - row_begin);
+      row_begin = row_end;
+    }
   }
 
-  // Check for empty output
   std::vector<int64_t> output_dims(input_dims);
   // Check if we have no output due to either empty input
   // everything is a separator
@@ -421,40 +394,37 @@ Status Tokenizer::TokenExpression(OpKernelContext* ctx,
   auto output_tensor = ctx->Output(0, output_shape);
   auto const output_data = output_tensor->template MutableData<std::string>();
 
-#ifdef _DEBUG
-  const size_t max_output_index = N * C * max_tokens;
-#endif
-  curr_input = input_data;
-  size_t output_index = 0;
-  for (const auto& row : tokens) {
-    assert(curr_input != last);
-#ifdef _DEBUG
-    size_t c_idx = output_index;
-#endif
-    if (mark_) {
-      (output_data + output_index)->assign(&start_text, 1);
-      ++output_index;
-    }
-    // Output tokens for this row
-    for (const auto& token : row) {
-      (output_data + output_index)->assign(token.data(), token.length());
-      ++output_index;
-    }
-    if (mark_) {
-      (output_data + output_index)->assign(&end_text, 1);
-      ++output_index;
-    }
-    const size_t pads = max_tokens - (mark_ * 2) - row.size();
-    for (size_t p = 0; p < pads; ++p) {
-      *(output_data + output_index) = pad_value_;
-      ++output_index;
+  concurrency::ThreadPool::TryParallelFor(tp, static_cast<int32_t>(num_blocks), [&](int32_t b) {
+    const auto& block = blocks[b];
+    size_t row = block_begin(b);
+    size_t token_idx = 0;
+    for (auto row_end : block.row_ends) {
+      const auto& s = input_data[row];
+      auto output = output_data + row * max_tokens;
+      auto const output_end = output + max_tokens;
+      if (mark_) {
+        output->assign(&start_text, 1);
+        ++output;
+      }
+      // Output tokens for this row
+      for (; token_idx < row_end; ++token_idx) {
+        const auto& token = block.tokens[token_idx];
+        output->assign(s.data() + token.offset, token.length);
+        ++output;
+      }
+      if (mark_) {
+        output->assign(&end_text, 1);
+        ++output;
+      }
+      assert(output <= output_end);
+      // Padding strings
+      while (output != output_end) {
+        *output = pad_value_;
+        ++output;
+      }
+      ++row;
     }
-#ifdef _DEBUG
-    assert(output_index <= max_output_index);
-    assert((output_index - c_idx) <= max_tokens);
-#endif
-    ++curr_input;
-  }
+  });
 
   return Status::OK();
 }
@@ -497,16 +467,8 @@ Status Tokenizer::Compute(OpKernelContext* ctx) const {
     return s;
   }
 
-  if (char_tokenezation_) {
-    s = CharTokenize(ctx, N, C, input_dims);
-  } else {
-    if (!separators_.empty()) {
-      s = SeparatorExpressionTokenizer(ctx, N, C, input_dims);
-    } else {
-      assert(regex_ != nullptr);
-      s = TokenExpression(ctx, N, C, input_dims);
-    }
-  }
+  assert(char_tokenezation_ || !separators_.empty() || regex_ != nullptr);
+  s = Tokenize(ctx, N, C, input_dims);
   return s;
 }
 }  // namespace contrib
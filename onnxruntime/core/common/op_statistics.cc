@@ -0,0 +1,361 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/op_statistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <map>
+#include <sstream>
+
+#include "core/common/logging/logging.h"
+
+namespace onnxruntime {
+namespace profiling {
+
+namespace {
+
+// Durations are bucketed log-linearly: each power of two range of nanoseconds is split into kSubBuckets
+// linear buckets, so a percentile is reported within 1 / (2 * kSubBuckets) of the recorded value.
+// Durations of 2^kMaxExponent ns (about 18 minutes) and longer share the last bucket.
+constexpr int kSubBucketBits = 2;
+constexpr uint64_t kSubBuckets = uint64_t{1} << kSubBucketBits;
+constexpr int kMaxExponent = 40;
+constexpr size_t kBucketCount = (kMaxExponent - kSubBucketBits + 1) * kSubBuckets;
+
+int Log2Floor(uint64_t value) {
+  int result = 0;
+  for (int shift = 32; shift > 0; shift /= 2) {
+    if ((value >> shift) != 0) {
+      value >>= shift;
+      result += shift;
+    }
+  }
+  return result;
+}
+
+size_t BucketIndex(uint64_t value) {
+  if (value < kSubBuckets) {
+    return static_cast<size_t>(value);
+  }
+  const int exponent = Log2Floor(value);
+  if (exponent >= kMaxExponent) {
+    return kBucketCount - 1;
+  }
+  return static_cast<size_t>((exponent - kSubBucketBits + 1) * kSubBuckets +
+                             ((value >> (exponent - kSubBucketBits)) & (kSubBuckets - 1)));
+}
+
+// Returns the midpoint of the durations that map to the bucket.
+uint64_t BucketValue(size_t index) {
+  if (index < kSubBuckets) {
+    return index;
+  }
+  const int shift = static_cast<int>(index / kSubBuckets) - 1;
+  const uint64_t lower = (kSubBuckets + index % kSubBuckets) << shift;
+  return lower + ((uint64_t{1} << shift) >> 1);
+}
+
+}  // namespace
+
+void WriteJsonString(std::ostream& os, const std::string& value) {
+  os << '"';
+  for (char c : value) {
+    switch (c) {
+      case '"':
+        os << "\\\"";
+        break;
+      case '\\':
+        os << "\\\\";
+        break;
+      case '\n':
+        os << "\\n";
+        break;
+      case '\t':
+        os << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec
+             << std::setfill(' ');
+        } else {
+          os << c;
+        }
+        break;
+    }
+  }
+  os << '"';
+}
+
+struct OpStatistics::NodeCounters {
+  std::atomic<uint64_t> count;
+  std::atomic<uint64_t> total_ns;
+  std::atomic<uint64_t> max_ns;
+  std::atomic<uint64_t> output_bytes;
+  std::atomic<uint32_t> histogram[kBucketCount];
+};
+
+struct OpStatistics::Shard {
+  // value-initialization zeroes the counters
+  explicit Shard(size_t node_count) : nodes(new NodeCounters[node_count]()) {}
+  std::unique_ptr<NodeCounters[]> nodes;
+};
+
+// The sequence number is the cursor position plus one once the record is complete, and zero while it is
+// being written, so readers can discard records that are torn by a concurrent writer.
+struct OpStatistics::TraceRecord {
+  std::atomic<uint64_t> sequence;
+  std::atomic<uint64_t> slot;
+  std::atomic<uint64_t> thread_id;
+  std::atomic<int64_t> start_ns;
+  std::atomic<int64_t> duration_ns;
+};
+
+struct OpStatistics::Summary {
+  uint64_t count = 0;
+  uint64_t total_ns = 0;
+  uint64_t max_ns = 0;
+  uint64_t output_bytes = 0;
+  std::vector<uint64_t> histogram = std::vector<uint64_t>(kBucketCount);
+
+  double PercentileMicroseconds(double percentile) const {
+    const auto target = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(percentile / 100.0 * count)));
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < kBucketCount; i++) {
+      cumulative += histogram[i];
+      if (cumulative >= target) {
+        return std::min(BucketValue(i), max_ns) / 1000.0;
+      }
+    }
+    return max_ns / 1000.0;
+  }
+
+  void Write(std::ostream& os) const {
+    os << "\"count\":" << count
+       << ",\"total_us\":" << total_ns / 1000.0
+       << ",\"mean_us\":" << (count == 0 ? 0.0 : total_ns / 1000.0 / count)
+       << ",\"p50_us\":" << PercentileMicroseconds(50)
+       << ",\"p90_us\":" << PercentileMicroseconds(90)
+       << ",\"p99_us\":" << PercentileMicroseconds(99)
+       << ",\"max_us\":" << max_ns / 1000.0
+       << ",\"output_bytes\":" << output_bytes;
+  }
+};
+
+constexpr size_t OpStatistics::kTraceCapacity;
+constexpr size_t OpStatistics::kShardCount;
+
+OpStatistics::OpStatistics(int trace_sample_rate)
+    : trace_sample_rate_(std::max(trace_sample_rate, 0)), start_time_(Clock::now()) {
+  for (auto& shard : shards_) {
+    shard.store(nullptr, std::memory_order_relaxed);
+  }
+  if (trace_sample_rate_ > 0) {
+    trace_.reset(new TraceRecord[kTraceCapacity]());
+  }
+}
+
+OpStatistics::~OpStatistics() {
+  for (auto& shard : shards_) {
+    delete shard.load(std::memory_order_relaxed);
+  }
+}
+
+size_t OpStatistics::RegisterNodes(const std::vector<std::string>& names, const std::vector<std::string>& op_types) {
+  ORT_ENFORCE(names.size() == op_types.size());
+  for (const auto& shard : shards_) {
+    ORT_ENFORCE(shard.load(std::memory_order_relaxed) == nullptr,
+                "Nodes must be registered before any are recorded.");
+  }
+  const size_t base = names_.size();
+  names_.insert(names_.end(), names.begin(), names.end());
+  op_types_.insert(op_types_.end(), op_types.begin(), op_types.end());
+  if (trace_sample_rate_ > 0) {
+    // nothing has been recorded yet, so the counts can start again from zero
+    trace_counts_.reset(new std::atomic<uint64_t>[names_.size()]());
+  }
+  return base;
+}
+
+OpStatistics::Shard& OpStatistics::GetShard() {
+  // Threads are assigned shards round robin the first time they record, so up to kShardCount threads
+  // never share counters.
+  static std::atomic<size_t> next_shard_index{0};
+  static thread_local const size_t shard_index =
+      next_shard_index.fetch_add(1, std::memory_order_relaxed) % kShardCount;
+
+  auto& entry = shards_[shard_index];
+  Shard* shard = entry.load(std::memory_order_acquire);
+  if (shard == nullptr) {
+    auto new_shard = onnxruntime::make_unique<Shard>(names_.size());
+    if (entry.compare_exchange_strong(shard, new_shard.get(), std::memory_order_acq_rel)) {
+      shard = new_shard.release();
+    }
+  }
+  return *shard;
+}
+
+void OpStatistics::Record(size_t slot, const Clock::time_point& start_time, size_t output_bytes) {
+  if (slot >= names_.size()) {
+    return;
+  }
+
+  const auto end_time = Clock::now();
+  const int64_t duration_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count();
+  const auto duration = static_cast<uint64_t>(std::max<int64_t>(duration_ns, 0));
+
+  NodeCounters& counters = GetShard().nodes[slot];
+  counters.count.fetch_add(1, std::memory_order_relaxed);
+  counters.total_ns.fetch_add(duration, std::memory_order_relaxed);
+  counters.output_bytes.fetch_add(output_bytes, std::memory_order_relaxed);
+  counters.histogram[BucketIndex(duration)].fetch_add(1, std::memory_order_relaxed);
+  uint64_t max_ns = counters.max_ns.load(std::memory_order_relaxed);
+  while (duration > max_ns &&
+         !counters.max_ns.compare_exchange_weak(max_ns, duration, std::memory_order_relaxed)) {
+  }
+
+  if (trace_sample_rate_ > 0 &&
+      trace_counts_[slot].fetch_add(1, std::memory_order_relaxed) % static_cast<uint64_t>(trace_sample_rate_) == 0) {
+    const uint64_t position = trace_cursor_.fetch_add(1, std::memory_order_relaxed);
+    TraceRecord& record = trace_[position % kTraceCapacity];
+    record.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    record.slot.store(slot, std::memory_order_relaxed);
+    record.thread_id.store(logging::GetThreadId(), std::memory_order_relaxed);
+    record.start_ns.store(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(start_time - start_time_).count(),
+        std::memory_order_relaxed);
+    record.duration_ns.store(duration_ns, std::memory_order_relaxed);
+    record.sequence.store(position + 1, std::memory_order_release);
+  }
+}
+
+void OpStatistics::Reset() {
+  for (auto& entry : shards_) {
+    Shard* shard = entry.load(std::memory_order_acquire);
+    if (shard == nullptr) {
+      continue;
+    }
+    for (size_t slot = 0; slot < names_.size(); slot++) {
+      NodeCounters& counters = shard->nodes[slot];
+      counters.count.store(0, std::memory_order_relaxed);
+      counters.total_ns.store(0, std::memory_order_relaxed);
+      counters.max_ns.store(0, std::memory_order_relaxed);
+      counters.output_bytes.store(0, std::memory_order_relaxed);
+      for (auto& bucket : counters.histogram) {
+        bucket.store(0, std::memory_order_relaxed);
+      }
+    }
+  }
+  if (trace_ != nullptr) {
+    for (size_t slot = 0; slot < names_.size(); slot++) {
+      trace_counts_[slot].store(0, std::memory_order_relaxed);
+    }
+    for (size_t i = 0; i < kTraceCapacity; i++) {
+      trace_[i].sequence.store(0, std::memory_order_relaxed);
+    }
+    trace_cursor_.store(0, std::memory_order_release);
+  }
+}
+
+void OpStatistics::Summarize(const std::vector<size_t>& slots, Summary& summary) const {
+  for (const auto& entry : shards_) {
+    const Shard* shard = entry.load(std::memory_order_acquire);
+    if (shard == nullptr) {
+      continue;
+    }
+    for (size_t slot : slots) {
+      const NodeCounters& counters = shard->nodes[slot];
+      summary.count += counters.count.load(std::memory_order_relaxed);
+      summary.total_ns += counters.total_ns.load(std::memory_order_relaxed);
+      summary.max_ns = std::max(summary.max_ns, counters.max_ns.load(std::memory_order_relaxed));
+      summary.output_bytes += counters.output_bytes.load(std::memory_order_relaxed);
+      for (size_t i = 0; i < kBucketCount; i++) {
+        summary.histogram[i] += counters.histogram[i].load(std::memory_order_relaxed);
+      }
+    }
+  }
+}
+
+std::string OpStatistics::ToJson() const {
+  std::ostringstream os;
+
+  os << "{\"nodes\":[";
+  std::map<std::string, std::vector<size_t>> op_type_slots;
+  bool first = true;
+  for (size_t slot = 0; slot < names_.size(); slot++) {
+    if (op_types_[slot].empty()) {
+      continue;
+    }
+    Summary summary;
+    Summarize({slot}, summary);
+    if (summary.count == 0) {
+      continue;
+    }
+    op_type_slots[op_types_[slot]].push_back(slot);
+    os << (first ? "" : ",") << "{\"name\":";
+    WriteJsonString(os, names_[slot]);
+    os << ",\"op_type\":";
+    WriteJsonString(os, op_types_[slot]);
+    os << ",";
+    summary.Write(os);
+    os << "}";
+    first = false;
+  }
+
+  std::vector<std::pair<std::string, Summary>> op_type_summaries;
+  for (const auto& entry : op_type_slots) {
+    op_type_summaries.emplace_back(entry.first, Summary());
+    Summarize(entry.second, op_type_summaries.back().second);
+  }
+  std::stable_sort(op_type_summaries.begin(), op_type_summaries.end(),
+                   [](const std::pair<std::string, Summary>& a, const std::pair<std::string, Summary>& b) {
+                     return a.second.total_ns > b.second.total_ns;
+                   });
+
+  os << "],\"op_types\":[";
+  first = true;
+  for (const auto& entry : op_type_summaries) {
+    os << (first ? "" : ",") << "{\"op_type\":";
+    WriteJsonString(os, entry.first);
+    os << ",\"node_count\":" << op_type_slots[entry.first].size() << ",";
+    entry.second.Write(os);
+    os << "}";
+    first = false;
+  }
+
+  os << "],\"trace\":[";
+  if (trace_ != nullptr) {
+    const uint64_t cursor = trace_cursor_.load(std::memory_order_acquire);
+    first = true;
+    for (uint64_t position = cursor > kTraceCapacity ? cursor - kTraceCapacity : 0; position < cursor; position++) {
+      const TraceRecord& record = trace_[position % kTraceCapacity];
+      const uint64_t sequence = record.sequence.load(std::memory_order_acquire);
+      if (sequence != position + 1) {
+        continue;
+      }
+      const auto slot = record.slot.load(std::memory_order_relaxed);
+      const auto thread_id = record.thread_id.load(std::memory_order_relaxed);
+      const auto start_ns = record.start_ns.load(std::memory_order_relaxed);
+      const auto duration_ns = record.duration_ns.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (record.sequence.load(std::memory_order_relaxed) != sequence || slot >= names_.size()) {
+        continue;
+      }
+      os << (first ? "" : ",") << "{\"name\":";
+      WriteJsonString(os, names_[slot]);
+      os << ",\"op_type\":";
+      WriteJsonString(os, op_types_[slot]);
+      os << ",\"tid\":" << thread_id << ",\"ts_us\":" << start_ns / 1000.0 << ",\"dur_us\":" << duration_ns / 1000.0
+         << "}";
+      first = false;
+    }
+  }
+  os << "]}";
+
+  return os.str();
+}
+
+}  // namespace profiling
+}  // namespace onnxruntime
@@ -0,0 +1,101 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+
+namespace profiling {
+
+// Writes value to os as a quoted JSON string.
+void WriteJsonString(std::ostream& os, const std::string& value);
+
+/**
+ * Aggregated execution statistics for the nodes of a session, cheap enough to leave enabled in production.
+ *
+ * Every node execution is folded into fixed size counters: the number of runs, the total and maximum
+ * duration, a log-linear duration histogram for percentiles, and the bytes of the outputs it produced.
+ * The counters are sharded by thread and updated with relaxed atomics, so recording never takes a lock
+ * and threads that run nodes concurrently rarely touch the same cache lines. Per op type figures are
+ * derived from the per node counters when the statistics are queried.
+ *
+ * Optionally, every Nth execution of a node is also written to a fixed size ring buffer so a recent
+ * sample of the timeline can be inspected without the cost of tracing every event.
+ */
+class OpStatistics {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  /*
+  trace_sample_rate: record every Nth execution of each node in the trace ring buffer. 0 disables the trace.
+  The executions are counted per node across all threads, so a node is traced at the same rate however many
+  threads run it. That count is shared by the threads, which is the one cost of enabling the trace.
+  */
+  explicit OpStatistics(int trace_sample_rate = 0);
+  ~OpStatistics();
+
+  /*
+  Registers the nodes of a graph and returns the slot of the node with index 0. The slot of any other node
+  is that value plus its node index. All graphs must be registered before the first call to Record.
+  names and op_types are indexed by node index; removed nodes have empty entries.
+  */
+  size_t RegisterNodes(const std::vector<std::string>& names, const std::vector<std::string>& op_types);
+
+  /*
+  Records one execution of the node in the given slot that started at start_time and finished now.
+  */
+  void Record(size_t slot, const Clock::time_point& start_time, size_t output_bytes);
+
+  /*
+  Clears all counters and the trace. Executions recorded concurrently with the reset may be partially kept.
+  */
+  void Reset();
+
+  /*
+  Returns the statistics as JSON:
+    {"nodes": [{"name", "op_type", "count", "total_us", "mean_us", "p50_us", "p90_us", "p99_us", "max_us",
+                "output_bytes"}, ...],
+     "op_types": [{"op_type", "node_count", "count", ...same as nodes...}, ...],
+     "trace": [{"name", "op_type", "tid", "ts_us", "dur_us"}, ...]}
+  Nodes that never ran are omitted. op_types is sorted by descending total time.
+  */
+  std::string ToJson() const;
+
+  static constexpr size_t kTraceCapacity = 16384;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(OpStatistics);
+
+  struct NodeCounters;
+  struct Shard;
+  struct TraceRecord;
+  struct Summary;
+
+  Shard& GetShard();
+  void Summarize(const std::vector<size_t>& slots, Summary& summary) const;
+
+  std::vector<std::string> names_;
+  std::vector<std::string> op_types_;
+  const int trace_sample_rate_;
+  const Clock::time_point start_time_;
+
+  static constexpr size_t kShardCount = 16;
+  std::atomic<Shard*> shards_[kShardCount];
+
+  std::unique_ptr<TraceRecord[]> trace_;
+  std::atomic<uint64_t> trace_cursor_{0};
+  // executions of each node across all shards, only kept when the trace is enabled
+  std::unique_ptr<std::atomic<uint64_t>[]> trace_counts_;
+};
+
+}  // namespace profiling
+}  // namespace onnxruntime
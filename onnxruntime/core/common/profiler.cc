@@ -83,6 +83,10 @@ void Profiler::EndTimeAndRecordEvent(EventCategory category,
   }
 }
 
+void Profiler::StartOpStatistics(int trace_sample_rate) {
+  op_statistics_ = onnxruntime::make_unique<OpStatistics>(trace_sample_rate);
+}
+
 std::string Profiler::EndProfiling() {
   if (!enabled_) {
     return std::string();
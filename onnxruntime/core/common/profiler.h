@@ -8,6 +8,7 @@
 #include <initializer_list>
 #include "core/platform/ort_mutex.h"
 #include "core/common/logging/logging.h"
+#include "core/common/op_statistics.h"
 
 namespace onnxruntime {
 
@@ -67,6 +68,19 @@ class Profiler {
                              const std::initializer_list<std::pair<std::string, std::string>>& event_args = {},
                              bool sync_gpu = false);
 
+  /*
+  Start collecting aggregated per node statistics. Unlike the event trace, the statistics can stay enabled in
+  production and be queried at any time. See OpStatistics.
+  */
+  void StartOpStatistics(int trace_sample_rate);
+
+  /*
+  The per node statistics, or nullptr if they were not started.
+  */
+  OpStatistics* GetOpStatistics() const {
+    return op_statistics_.get();
+  }
+
   /*
   Write profile data to the given stream in chrome format defined below.
   https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU/preview#
@@ -97,6 +111,7 @@ class Profiler {
   bool max_events_reached{false};
   static constexpr size_t max_num_events_ = 1000000;
   bool profile_with_logger_{false};
+  std::unique_ptr<OpStatistics> op_statistics_;
 
 #ifdef ENABLE_STATIC_PROFILER_INSTANCE
   static Profiler* instance_;
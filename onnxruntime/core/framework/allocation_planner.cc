@@ -63,6 +63,7 @@ std::ostream& operator<<(std::ostream& out, std::pair<const SequentialExecutionP
       auto& elt_plan = plan.allocation_plan[index];
       out << elt_plan.alloc_kind;
       if (elt_plan.alloc_kind == AllocKind::kReuse) out << " " << elt_plan.reused_buffer;
+      if (elt_plan.is_strided_view) out << " (strided view)";
 
       auto& loc = elt_plan.location;
       out << ", " << loc.ToString();
@@ -235,7 +236,8 @@ class PlannerImpl {
           if (p_input_arg->Exists()) {
             auto input_arg_index = Index(p_input_arg->Name());
             auto original = Buffer(input_arg_index);
-            if (1 == UseCount(original)) {
+            // a strided view does not start at the beginning of the buffer or cover it densely
+            if (1 == UseCount(original) && !AllocPlan(input_arg_index).is_strided_view) {
               if (SameSize(*p_input_arg, *p_output_arg)) {
                 // we can reuse this input since it is its last use and permitted for in-place update
                 *reusable_input = input_arg_index;  // or original; both should be okay
@@ -249,6 +251,61 @@ class PlannerImpl {
     return false;
   }
 
+  // Find if output_arg can be produced as a strided view of one of the node's input buffers. The kernel must be
+  // able to produce the view and every consumer of the output must be able to read it.
+  bool FindStridedViewInput(const onnxruntime::Node& node, int output_arg_num, OrtValueIndex* view_input) {
+    const KernelCreateInfo* ci;
+    Status st = kernel_registry_.SearchKernelRegistry(node, &ci);
+    if (!st.IsOK() || ci == nullptr || ci->kernel_def == nullptr) {
+      return false;
+    }
+
+    auto input_args = node.InputDefs();
+    for (auto pair : ci->kernel_def->MayStridedOutput()) {
+      if (pair.second == output_arg_num || pair.second == -1) {
+        if ((0 <= pair.first) && (static_cast<size_t>(pair.first) < input_args.size())) {
+          auto p_input_arg = input_args[pair.first];
+          if (p_input_arg->Exists() && AllConsumersAcceptStridedInput(*node.OutputDefs()[output_arg_num])) {
+            *view_input = Index(p_input_arg->Name());
+            return true;
+          }
+        }
+      }
+    }
+    return false;
+  }
+
+  bool AllConsumersAcceptStridedInput(const onnxruntime::NodeArg& arg) {
+    bool has_consumer = false;
+    for (const auto& step : plan_.execution_plan) {
+      auto pnode = graph_viewer_.GetNode(step.node_index);
+      // values passed to a subgraph are read by kernels that are not known here
+      for (auto node_input : pnode->ImplicitInputDefs()) {
+        if (node_input == &arg) {
+          return false;
+        }
+      }
+      auto input_args = pnode->InputDefs();
+      for (size_t input_arg_num = 0; input_arg_num < input_args.size(); ++input_arg_num) {
+        if (input_args[input_arg_num] != &arg) {
+          continue;
+        }
+        const KernelCreateInfo* ci;
+        Status st = kernel_registry_.SearchKernelRegistry(*pnode, &ci);
+        if (!st.IsOK() || ci == nullptr || ci->kernel_def == nullptr) {
+          return false;
+        }
+        const std::vector<int>& strided_inputs = ci->kernel_def->MayStridedInput();
+        if (std::find(strided_inputs.begin(), strided_inputs.end(), static_cast<int>(input_arg_num)) ==
+            strided_inputs.end()) {
+          return false;
+        }
+        has_consumer = true;
+      }
+    }
+    return has_consumer;
+  }
+
   static bool SameShape(const TensorShapeProto& shape1, const TensorShapeProto& shape2) {
     // TODO: This should probably be defined to be the equality operator on TensorShapeProto.
     namespace on = ONNX_NAMESPACE;
@@ -579,6 +636,10 @@ class PlannerImpl {
         } else if (IsNonTensor(*node_output)) {
           // we do not try sharing-optimization for non-tensors
           AllocPlan(current).alloc_kind = AllocKind::kAllocate;
+        } else if (FindStridedViewInput(*pnode, output_arg_num, &reused)) {
+          // Produce the output as a strided view of one of this node's input buffers, so no data is copied
+          Reuse(reused, current, AllocKind::kReuse);
+          AllocPlan(current).is_strided_view = true;
         } else if (FindReusableInput(*pnode, output_arg_num, &reused)) {
           // Reuse one of this node's input buffers as the output buffer (for in-place update)
           Reuse(reused, current, AllocKind::kReuse);
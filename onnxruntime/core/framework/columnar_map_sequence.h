@@ -0,0 +1,133 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include "core/framework/data_types.h"
+#include "core/framework/ml_value.h"
+#include "core/framework/tensor.h"
+#include "core/session/onnxruntime_c_api.h"
+
+namespace onnxruntime {
+
+// Opaque type names, in the com.microsoft domain, of the columnar map sequences and of their row views.
+extern const char kColumnarMapDomain[];
+extern const char kColumnarMapSequenceStringToFloat[];
+extern const char kColumnarMapSequenceInt64ToFloat[];
+extern const char kColumnarMapRowStringToFloat[];
+extern const char kColumnarMapRowInt64ToFloat[];
+
+/**
+ * A sequence of maps from TKey to float that all have the same keys, stored by column.
+ * The distinct keys are kept once, in map order, in a 1-D tensor that is shared by every row and by every
+ * output of the kernel that created it. The values are a dense [N, C] float tensor whose row n holds the
+ * values of map n in key order.
+ * This is the output of ColumnarZipMap, which replaces ZipMap when the session option
+ * use_columnar_zipmap_output is set.
+ */
+template <typename TKey>
+class ColumnarMapSequence {
+ public:
+  using key_type = TKey;
+
+  ColumnarMapSequence() = default;
+
+  void Init(std::shared_ptr<const Tensor> keys, std::unique_ptr<Tensor> values) {
+    ORT_ENFORCE(keys->Shape().NumDimensions() == 1 && values->Shape().NumDimensions() == 2 &&
+                    values->Shape()[1] == keys->Shape()[0],
+                "Expecting 1-D keys and [N, C] values with one column per key");
+    keys_ = std::move(keys);
+    values_ = std::move(values);
+  }
+
+  // Number of maps.
+  size_t Size() const noexcept { return values_ ? static_cast<size_t>(values_->Shape()[0]) : 0; }
+
+  // Number of keys of each map.
+  size_t NumKeys() const noexcept { return keys_ ? static_cast<size_t>(keys_->Shape()[0]) : 0; }
+
+  const Tensor& Keys() const { return *keys_; }
+  const Tensor& Values() const { return *values_; }
+
+  const TKey* KeyData() const { return keys_->template Data<TKey>(); }
+  const float* Row(size_t n) const { return values_->template Data<float>() + n * NumKeys(); }
+
+  // Returns the column of 'key', or -1 when the maps do not have it.
+  int64_t FindColumn(const TKey& key) const {
+    const TKey* begin = KeyData();
+    const TKey* end = begin + NumKeys();
+    const TKey* it = std::lower_bound(begin, end, key);
+    return it != end && *it == key ? static_cast<int64_t>(it - begin) : -1;
+  }
+
+ private:
+  std::shared_ptr<const Tensor> keys_;
+  std::unique_ptr<Tensor> values_;
+};
+
+/**
+ * A lazy view of one map of a ColumnarMapSequence. The keys and the row of values are read in place, and the
+ * view keeps the sequence alive.
+ */
+template <typename TKey>
+class ColumnarMapRow {
+ public:
+  using key_type = TKey;
+
+  ColumnarMapRow() = default;
+
+  ColumnarMapRow(const OrtValue& sequence, size_t row) : sequence_(sequence) {
+    const auto& seq = sequence_.Get<ColumnarMapSequence<TKey>>();
+    ORT_ENFORCE(row < seq.Size(), "Row ", row, " is out of range. The sequence has ", seq.Size(), " maps.");
+    values_ = Tensor(DataTypeImpl::GetType<float>(), TensorShape({static_cast<int64_t>(seq.NumKeys())}),
+                     const_cast<float*>(seq.Row(row)), seq.Values().Location());
+  }
+
+  const ColumnarMapSequence<TKey>& Sequence() const { return sequence_.Get<ColumnarMapSequence<TKey>>(); }
+
+  // The value holding the sequence, which owns the keys and the values.
+  const OrtValue& SequenceValue() const { return sequence_; }
+
+  // The keys shared by every map of the sequence.
+  const Tensor& Keys() const { return Sequence().Keys(); }
+
+  // The values of this map in key order. The tensor does not own its buffer.
+  const Tensor& Values() const { return values_; }
+
+ private:
+  OrtValue sequence_;
+  Tensor values_;
+};
+
+using ColumnarMapSequenceStringToFloat = ColumnarMapSequence<std::string>;
+using ColumnarMapSequenceInt64ToFloat = ColumnarMapSequence<int64_t>;
+using ColumnarMapRowStringToFloat = ColumnarMapRow<std::string>;
+using ColumnarMapRowInt64ToFloat = ColumnarMapRow<int64_t>;
+
+// GetOpaqueValue on a columnar map sequence fills an OrtColumnarMapSequence with views of the shared keys and
+// of the [N, C] values. The views keep the sequence alive and must be released by the caller.
+template <typename TKey>
+struct NonTensorTypeConverter<ColumnarMapSequence<TKey>> {
+  static void FromContainer(MLDataType /*dtype*/, const void* /*data*/, size_t /*data_size*/, OrtValue& /*output*/) {
+    ORT_THROW("Columnar map sequences are created by ColumnarZipMap and can not be used as inputs");
+  }
+
+  static void ToContainer(const OrtValue& input, size_t data_size, void* data) {
+    ORT_ENFORCE(data_size == sizeof(OrtColumnarMapSequence), "Expecting an instance of OrtColumnarMapSequence");
+    auto* container = reinterpret_cast<OrtColumnarMapSequence*>(data);
+    const auto& seq = input.Get<ColumnarMapSequence<TKey>>();
+    const auto* tensor_type = DataTypeImpl::GetType<Tensor>();
+
+    std::unique_ptr<OrtValue> keys(new OrtValue);
+    keys->InitAsView(const_cast<Tensor*>(&seq.Keys()), tensor_type, input);
+    std::unique_ptr<OrtValue> values(new OrtValue);
+    values->InitAsView(const_cast<Tensor*>(&seq.Values()), tensor_type, input);
+    container->keys = keys.release();
+    container->values = values.release();
+  }
+};
+
+}  // namespace onnxruntime
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/framework/data_types.h"
+#include "core/framework/columnar_map_sequence.h"
 #include "core/framework/tensor.h"
 #include "core/framework/TensorSeq.h"
 #include "core/framework/sparse_tensor.h"
@@ -559,6 +560,17 @@ ORT_REGISTER_SEQ_TENSOR_TYPE(BFloat16);
 ORT_REGISTER_SEQ(VectorMapStringToFloat);
 ORT_REGISTER_SEQ(VectorMapInt64ToFloat);
 
+const char kColumnarMapDomain[] = "com.microsoft";
+const char kColumnarMapSequenceStringToFloat[] = "ColumnarMapSequenceStringToFloat";
+const char kColumnarMapSequenceInt64ToFloat[] = "ColumnarMapSequenceInt64ToFloat";
+const char kColumnarMapRowStringToFloat[] = "ColumnarMapRowStringToFloat";
+const char kColumnarMapRowInt64ToFloat[] = "ColumnarMapRowInt64ToFloat";
+
+ORT_REGISTER_OPAQUE_TYPE(ColumnarMapSequenceStringToFloat, kColumnarMapDomain, kColumnarMapSequenceStringToFloat);
+ORT_REGISTER_OPAQUE_TYPE(ColumnarMapSequenceInt64ToFloat, kColumnarMapDomain, kColumnarMapSequenceInt64ToFloat);
+ORT_REGISTER_OPAQUE_TYPE(ColumnarMapRowStringToFloat, kColumnarMapDomain, kColumnarMapRowStringToFloat);
+ORT_REGISTER_OPAQUE_TYPE(ColumnarMapRowInt64ToFloat, kColumnarMapDomain, kColumnarMapRowInt64ToFloat);
+
 // Used for Tensor Proto registrations
 #define REGISTER_TENSOR_PROTO(TYPE, reg_fn)                  \
   {                                                          \
@@ -643,6 +655,11 @@ void RegisterAllProtos(const std::function<void(MLDataType)>& reg_fn) {
 
   REGISTER_ONNX_PROTO(VectorMapStringToFloat, reg_fn);
   REGISTER_ONNX_PROTO(VectorMapInt64ToFloat, reg_fn);
+
+  REGISTER_ONNX_PROTO(ColumnarMapSequenceStringToFloat, reg_fn);
+  REGISTER_ONNX_PROTO(ColumnarMapSequenceInt64ToFloat, reg_fn);
+  REGISTER_ONNX_PROTO(ColumnarMapRowStringToFloat, reg_fn);
+  REGISTER_ONNX_PROTO(ColumnarMapRowInt64ToFloat, reg_fn);
 }
 }  // namespace data_types_internal
 
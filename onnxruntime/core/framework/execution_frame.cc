@@ -6,6 +6,7 @@
 #include <sstream>
 
 #include "core/framework/mem_pattern_planner.h"
+#include "core/framework/memory_statistics.h"
 #include "core/framework/execution_plan_base.h"
 #include "core/framework/sequential_execution_plan.h"
 #include "core/framework/ort_value_pattern_planner.h"
@@ -78,6 +79,11 @@ Status IExecutionFrame::GetOrCreateNodeOutputMLValue(int index, const TensorShap
   return status;
 }
 
+bool IExecutionFrame::IsStridedViewOutput(int index) const {
+  int ort_value_idx = GetNodeIdxToMLValueIdx(index);
+  return ort_value_idx != NodeIndexInfo::kInvalidEntry && IsStridedViewImpl(ort_value_idx);
+}
+
 AllocatorPtr IExecutionFrame::GetAllocator(const OrtMemoryInfo& info) const {
   return GetAllocatorImpl(info);
 }
@@ -221,6 +227,10 @@ ExecutionFrame::ExecutionFrame(const std::vector<int>& feed_mlvalue_idxs, const
                              ? alloc->Alloc(mem_patterns_->patterns[i].PeakSize())
                              : nullptr;
           buffers_[mem_patterns_->locations[i]] = BufferUniquePtr(buffer, alloc);
+          if (buffer != nullptr && session_state.GetMemoryStatistics() != nullptr) {
+            session_state.GetMemoryStatistics()->NameAllocation(
+                buffer, std::string("memory_pattern:") + mem_patterns_->locations[i].name);
+          }
         }
       }
     }
@@ -321,15 +331,17 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
 
 Status ExecutionFrame::AllocateMLValueTensorPreAllocateBuffer(OrtValue& ort_value, int ort_value_index_reuse,
                                                               MLDataType element_type, const OrtMemoryInfo& location,
-                                                              const TensorShape& shape, bool create_fence) {
+                                                              const TensorShape& shape, bool create_fence,
+                                                              bool is_strided_view) {
   OrtValue& ort_value_reuse = GetMutableMLValue(ort_value_index_reuse);
 
   auto* reuse_tensor = ort_value_reuse.GetMutable<Tensor>();
   auto buffer_num_elements = reuse_tensor->Shape().Size();
   auto required_num_elements = shape.Size();
 
-  // check number of elements matches. shape may not be an exact match (e.g. Reshape op)
-  if (buffer_num_elements != required_num_elements) {
+  // check number of elements matches. shape may not be an exact match (e.g. Reshape op).
+  // a strided view may address fewer (e.g. Slice) or more (e.g. Expand) elements than the buffer holds.
+  if (!is_strided_view && buffer_num_elements != required_num_elements) {
     // could be an allocation planner bug (less likely) or the model incorrectly uses something like 'None'
     // as a dim_param, or -1 in dim_value in multiple places making the planner think those shapes are equal.
     auto message = onnxruntime::MakeString(
@@ -449,7 +461,8 @@ Status ExecutionFrame::AllocateAsPerAllocationPlan(OrtValue& ort_value, int ort_
       case AllocKind::kReuse: {
         int reuse_mlvalue_index = per_alloc_plan.reused_buffer;
         ORT_RETURN_IF_ERROR(AllocateMLValueTensorPreAllocateBuffer(
-            ort_value, reuse_mlvalue_index, ml_data_type, alloc_info, *shape, per_alloc_plan.create_fence_if_async));
+            ort_value, reuse_mlvalue_index, ml_data_type, alloc_info, *shape, per_alloc_plan.create_fence_if_async,
+            per_alloc_plan.is_strided_view));
         break;
       }
       case AllocKind::kShare: {
@@ -477,6 +490,10 @@ Status ExecutionFrame::AllocateAsPerAllocationPlan(OrtValue& ort_value, int ort_
 }
 
 AllocatorPtr ExecutionFrame::GetAllocatorImpl(const OrtMemoryInfo& info) const {
+  MemoryStatistics* memory_statistics = session_state_.GetMemoryStatistics();
+  if (memory_statistics != nullptr) {
+    return memory_statistics->TrackAllocator(utils::GetAllocator(session_state_, info));
+  }
   return utils::GetAllocator(session_state_, info);
 }
 
@@ -486,6 +503,12 @@ Status ExecutionFrame::CreateNodeOutputMLValueImpl(OrtValue& ort_value, int ort_
   return AllocateAsPerAllocationPlan(ort_value, ort_value_idx, shape, nnz);
 }
 
+bool ExecutionFrame::IsStridedViewImpl(int ort_value_idx) const {
+  const auto& alloc_plan = session_state_.GetExecutionPlan()->allocation_plan;
+  ORT_ENFORCE(ort_value_idx >= 0 && static_cast<size_t>(ort_value_idx) < alloc_plan.size());
+  return alloc_plan[ort_value_idx].is_strided_view;
+}
+
 Status ExecutionFrame::ReleaseMLValueImpl(int ort_value_idx) {
   ORT_RETURN_IF_ERROR(IExecutionFrame::ReleaseMLValueImpl(ort_value_idx));
   TraceFree(ort_value_idx);
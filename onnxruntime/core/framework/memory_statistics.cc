@@ -0,0 +1,255 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/memory_statistics.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "core/common/op_statistics.h"
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/graph/graph.h"
+
+namespace onnxruntime {
+
+class MemoryStatistics::TrackingAllocator : public IAllocator {
+ public:
+  TrackingAllocator(std::shared_ptr<MemoryStatistics> statistics, AllocatorPtr allocator)
+      : statistics_(std::move(statistics)), allocator_(std::move(allocator)) {}
+
+  void* Alloc(size_t size) override {
+    void* p = allocator_->Alloc(size);
+    if (p != nullptr) {
+      statistics_->OnAlloc(p, size);
+    }
+    return p;
+  }
+
+  void Free(void* p) override {
+    if (p != nullptr) {
+      statistics_->OnFree(p);
+    }
+    allocator_->Free(p);
+  }
+
+  const OrtMemoryInfo& Info() const override { return allocator_->Info(); }
+
+  FencePtr CreateFence(const SessionState* session_state) override { return allocator_->CreateFence(session_state); }
+
+ private:
+  std::shared_ptr<MemoryStatistics> statistics_;
+  AllocatorPtr allocator_;
+};
+
+AllocatorPtr MemoryStatistics::TrackAllocator(const AllocatorPtr& allocator) {
+  if (allocator == nullptr) {
+    return allocator;
+  }
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto& entry = tracking_allocators_[allocator.get()];
+  AllocatorPtr tracking_allocator = entry.lock();
+  if (tracking_allocator == nullptr) {
+    tracking_allocator = std::make_shared<TrackingAllocator>(shared_from_this(), allocator);
+    entry = tracking_allocator;
+  }
+  return tracking_allocator;
+}
+
+std::vector<MemoryStatistics::ActiveNode>& MemoryStatistics::ActiveNodes() {
+  static thread_local std::vector<ActiveNode> active_nodes;
+  return active_nodes;
+}
+
+// requires mutex_
+MemoryStatistics::ActiveNode* MemoryStatistics::CurrentNode() {
+  auto& active_nodes = ActiveNodes();
+  if (active_nodes.empty() || active_nodes.back().owner != this) {
+    return nullptr;
+  }
+  return &active_nodes.back();
+}
+
+void MemoryStatistics::OnAlloc(const void* p, size_t bytes) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  ActiveNode* current = CurrentNode();
+  live_[p] = Allocation{p, bytes, current != nullptr ? current->node : nullptr, std::string()};
+  live_bytes_ += bytes;
+
+  // a node's peak includes the nodes it runs itself, e.g. the subgraph of an If or Loop
+  for (auto& active : ActiveNodes()) {
+    if (active.owner == this) {
+      active.peak = std::max(active.peak, live_bytes_);
+    }
+  }
+  if (current != nullptr) {
+    current->allocated_bytes += bytes;
+  }
+
+  if (live_bytes_ > peak_bytes_) {
+    peak_bytes_ = live_bytes_;
+    peak_node_ = current != nullptr ? current->node : nullptr;
+    peak_allocations_.clear();
+    peak_allocations_.reserve(live_.size());
+    for (const auto& entry : live_) {
+      peak_allocations_.push_back(entry.second);
+    }
+  }
+}
+
+void MemoryStatistics::OnFree(const void* p) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto entry = live_.find(p);
+  if (entry != live_.end()) {
+    live_bytes_ -= entry->second.bytes;
+    live_.erase(entry);
+  }
+}
+
+void MemoryStatistics::StartRun() {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  timeline_.clear();
+}
+
+void MemoryStatistics::StartNode(const Node& node) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  ActiveNodes().push_back(ActiveNode{this, &node, live_bytes_, live_bytes_, 0});
+}
+
+MemoryStatistics::NodeMemory MemoryStatistics::EndNode(const Node& node, OpKernelContextInternal& context) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  NodeMemory result;
+  ActiveNode* current = CurrentNode();
+  if (current == nullptr || current->node != &node) {
+    return result;
+  }
+
+  // Name the outputs the node allocated itself. Outputs placed in a memory pattern block or in a reused
+  // buffer still count towards output_bytes, but their memory is attributed to whoever allocated it.
+  size_t allocated_output_bytes = 0;
+  const auto& output_defs = node.OutputDefs();
+  for (int i = 0; i < context.OutputCount(); i++) {
+    const OrtValue* value = context.GetOutputMLValue(i);
+    if (value == nullptr || !value->IsAllocated() || !value->IsTensor()) {
+      continue;
+    }
+    const auto& tensor = value->Get<Tensor>();
+    result.output_bytes += tensor.SizeInBytes();
+    auto entry = live_.find(tensor.DataRaw());
+    if (entry != live_.end() && entry->second.node == &node && entry->second.name.empty()) {
+      SetName(entry->second, output_defs[i]->Name());
+      allocated_output_bytes += entry->second.bytes;
+    }
+  }
+  result.scratch_bytes = current->allocated_bytes - std::min(current->allocated_bytes, allocated_output_bytes);
+  result.live_bytes = live_bytes_;
+
+  auto totals = node_totals_.find(&node);
+  if (totals == node_totals_.end()) {
+    totals = node_totals_.emplace(&node, NodeTotals()).first;
+    node_order_.push_back(&node);
+  }
+  totals->second.count++;
+  totals->second.output_bytes += result.output_bytes;
+  totals->second.scratch_bytes += result.scratch_bytes;
+  totals->second.peak_live_bytes = std::max(totals->second.peak_live_bytes, current->peak);
+
+  timeline_.push_back(TimelineEntry{&node, current->live_before, current->peak, live_bytes_});
+
+  ActiveNodes().pop_back();
+  return result;
+}
+
+// requires mutex_
+void MemoryStatistics::SetName(Allocation& allocation, const std::string& name) {
+  allocation.name = name;
+  // the allocation may have been live when the peak was recorded, which only happens when it was the last
+  // allocation made by the node or outside of any node
+  if (peak_node_ == allocation.node) {
+    for (auto& peak_allocation : peak_allocations_) {
+      if (peak_allocation.buffer == allocation.buffer && peak_allocation.name.empty()) {
+        peak_allocation.name = name;
+      }
+    }
+  }
+}
+
+void MemoryStatistics::NameAllocation(const void* buffer, const std::string& name) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto entry = live_.find(buffer);
+  if (entry != live_.end()) {
+    SetName(entry->second, name);
+  }
+}
+
+void MemoryStatistics::Reset() {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  node_totals_.clear();
+  node_order_.clear();
+  timeline_.clear();
+  peak_bytes_ = live_bytes_;
+  peak_node_ = nullptr;
+  peak_allocations_.clear();
+  for (const auto& entry : live_) {
+    peak_allocations_.push_back(entry.second);
+  }
+}
+
+static void WriteNodeName(std::ostream& os, const Node* node) {
+  profiling::WriteJsonString(os, node != nullptr ? node->Name() : std::string());
+}
+
+std::string MemoryStatistics::ToJson() const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  std::ostringstream os;
+
+  os << "{\"live_bytes\":" << live_bytes_ << ",\"peak_bytes\":" << peak_bytes_ << ",\"peak_node\":";
+  WriteNodeName(os, peak_node_);
+
+  std::vector<const Allocation*> peak_allocations;
+  for (const auto& allocation : peak_allocations_) {
+    peak_allocations.push_back(&allocation);
+  }
+  std::stable_sort(peak_allocations.begin(), peak_allocations.end(),
+                   [](const Allocation* a, const Allocation* b) { return a->bytes > b->bytes; });
+  os << ",\"peak_allocations\":[";
+  bool first = true;
+  for (const auto* allocation : peak_allocations) {
+    os << (first ? "" : ",") << "{\"name\":";
+    profiling::WriteJsonString(os, allocation->name);
+    os << ",\"node\":";
+    WriteNodeName(os, allocation->node);
+    os << ",\"bytes\":" << allocation->bytes << "}";
+    first = false;
+  }
+
+  os << "],\"nodes\":[";
+  first = true;
+  for (const Node* node : node_order_) {
+    const NodeTotals& totals = node_totals_.at(node);
+    os << (first ? "" : ",") << "{\"name\":";
+    profiling::WriteJsonString(os, node->Name());
+    os << ",\"op_type\":";
+    profiling::WriteJsonString(os, node->OpType());
+    os << ",\"count\":" << totals.count << ",\"output_bytes\":" << totals.output_bytes
+       << ",\"scratch_bytes\":" << totals.scratch_bytes << ",\"peak_live_bytes\":" << totals.peak_live_bytes << "}";
+    first = false;
+  }
+
+  os << "],\"timeline\":[";
+  first = true;
+  for (const auto& entry : timeline_) {
+    os << (first ? "" : ",") << "{\"name\":";
+    profiling::WriteJsonString(os, entry.node->Name());
+    os << ",\"op_type\":";
+    profiling::WriteJsonString(os, entry.node->OpType());
+    os << ",\"live_before\":" << entry.live_before << ",\"peak\":" << entry.peak
+       << ",\"live_after\":" << entry.live_after << "}";
+    first = false;
+  }
+  os << "]}";
+
+  return os.str();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,140 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/allocator.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+class Node;
+class OpKernelContextInternal;
+
+/**
+ * Attributes the memory allocated while running a session to the nodes that requested it.
+ *
+ * The execution frame routes its allocators through TrackAllocator when the statistics are enabled, so every
+ * output, scratch buffer and memory pattern block allocated during a run is recorded together with the node
+ * that was running on the calling thread. For each node this keeps the bytes of its outputs and of the scratch
+ * memory it allocated, and for the most recent run the live memory before and after each node in execution
+ * plan order. The highest live memory seen is kept with a snapshot of the allocations live at that moment.
+ *
+ * This is a diagnostic mode: every tracked allocation takes a lock, and a new peak copies the live set.
+ */
+class MemoryStatistics : public std::enable_shared_from_this<MemoryStatistics> {
+ public:
+  struct NodeMemory {
+    size_t output_bytes = 0;
+    size_t scratch_bytes = 0;
+    size_t live_bytes = 0;
+  };
+
+  MemoryStatistics() = default;
+
+  /*
+  Returns an allocator that forwards to allocator and records its allocations. The wrapper keeps the
+  statistics alive, so tensors that outlive the session can still be freed through it.
+  */
+  AllocatorPtr TrackAllocator(const AllocatorPtr& allocator);
+
+  /*
+  Starts the timeline of a new run. Memory still held from previous runs stays live.
+  */
+  void StartRun();
+
+  /*
+  Attributes allocations made on the calling thread to node until the matching EndNode. Calls may nest,
+  e.g. for the nodes of a subgraph run by a control flow node.
+  */
+  void StartNode(const Node& node);
+
+  /*
+  Ends the node started last on the calling thread. The outputs of the node found in context are named
+  after their node args; every other allocation made by the node counts as scratch memory.
+  */
+  NodeMemory EndNode(const Node& node, OpKernelContextInternal& context);
+
+  /*
+  Names a tracked allocation, e.g. a memory pattern block, so it can be identified at the peak.
+  */
+  void NameAllocation(const void* buffer, const std::string& name);
+
+  /*
+  Clears the per node totals, the timeline and the peak. Live allocations stay tracked.
+  */
+  void Reset();
+
+  /*
+  Returns the statistics as JSON:
+    {"live_bytes", "peak_bytes", "peak_node",
+     "peak_allocations": [{"name", "node", "bytes"}, ...],
+     "nodes": [{"name", "op_type", "count", "output_bytes", "scratch_bytes", "peak_live_bytes"}, ...],
+     "timeline": [{"name", "op_type", "live_before", "peak", "live_after"}, ...]}
+  peak_allocations is sorted by descending size. Allocations made outside of any node have an empty node.
+  */
+  std::string ToJson() const;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(MemoryStatistics);
+
+  class TrackingAllocator;
+
+  struct Allocation {
+    const void* buffer;
+    size_t bytes;
+    const Node* node;
+    std::string name;
+  };
+
+  struct NodeTotals {
+    uint64_t count = 0;
+    uint64_t output_bytes = 0;
+    uint64_t scratch_bytes = 0;
+    size_t peak_live_bytes = 0;
+  };
+
+  struct TimelineEntry {
+    const Node* node;
+    size_t live_before;
+    size_t peak;
+    size_t live_after;
+  };
+
+  // state of a node running on the current thread
+  struct ActiveNode {
+    const MemoryStatistics* owner;
+    const Node* node;
+    size_t live_before;
+    size_t peak;
+    size_t allocated_bytes;
+  };
+
+  void OnAlloc(const void* p, size_t bytes);
+  void OnFree(const void* p);
+  void SetName(Allocation& allocation, const std::string& name);
+  static std::vector<ActiveNode>& ActiveNodes();
+  ActiveNode* CurrentNode();
+
+  mutable OrtMutex mutex_;
+  // weak, as the wrappers hold a reference to this instance
+  std::unordered_map<const IAllocator*, std::weak_ptr<IAllocator>> tracking_allocators_;
+  std::unordered_map<const void*, Allocation> live_;
+  size_t live_bytes_ = 0;
+
+  size_t peak_bytes_ = 0;
+  const Node* peak_node_ = nullptr;
+  std::vector<Allocation> peak_allocations_;
+
+  std::unordered_map<const Node*, NodeTotals> node_totals_;
+  std::vector<const Node*> node_order_;
+  std::vector<TimelineEntry> timeline_;
+};
+
+}  // namespace onnxruntime
@@ -104,6 +104,13 @@ Fence_t OpKernelContext::OutputFence(int index) const {
   return p_ml_value ? p_ml_value->Fence() : nullptr;
 }
 
+bool OpKernelContext::IsStridedViewOutput(int index) const {
+  if (index < 0 || index >= OutputCount())
+    return false;
+
+  return execution_frame_->IsStridedViewOutput(GetOutputArgIndex(index));
+}
+
 OrtValue* OpKernelContext::GetOrCreateOutputMLValue(int index) {
   auto output_arg_index = GetOutputArgIndex(index);
   OrtValue* value = nullptr;
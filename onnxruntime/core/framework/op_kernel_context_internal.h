@@ -60,6 +60,18 @@ class OpKernelContextInternal : public OpKernelContext {
 
   const bool& GetTerminateFlag() const noexcept { return terminate_flag_; }
 
+  // Total size of the tensors that the kernel produced.
+  size_t OutputSizeInBytes() {
+    size_t total = 0;
+    for (int i = 0; i < OutputCount(); ++i) {
+      const OrtValue* value = GetOutputMLValue(i);
+      if (value != nullptr && value->IsAllocated() && value->IsTensor()) {
+        total += value->Get<Tensor>().SizeInBytes();
+      }
+    }
+    return total;
+  }
+
  private:
   const SessionState& session_state_;
   const bool& terminate_flag_;
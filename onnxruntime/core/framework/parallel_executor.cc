@@ -11,6 +11,7 @@
 #include "core/common/logging/logging.h"
 #include "core/framework/allocation_planner.h"
 #include "core/framework/execution_frame.h"
+#include "core/framework/memory_statistics.h"
 #include "core/framework/session_state.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/utils.h"
@@ -120,6 +121,10 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
   TimePoint sync_time_begin;
   TimePoint kernel_begin_time;
   const bool f_profiler_enabled = session_state.Profiler().IsEnabled();
+  profiling::OpStatistics* op_statistics = session_state.Profiler().GetOpStatistics();
+  profiling::OpStatistics::Clock::time_point op_statistics_begin_time;
+  MemoryStatistics* memory_statistics = session_state.GetMemoryStatistics();
+  MemoryStatistics::NodeMemory node_memory;
   const SequentialExecutionPlan& exec_plan = *session_state.GetExecutionPlan();
 
   // Avoid context switching if possible.
@@ -189,6 +194,14 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
     // call compute on the kernel
     VLOGS(logger, 1) << "Computing kernel: " << node.Name();
 
+    if (op_statistics != nullptr) {
+      op_statistics_begin_time = profiling::OpStatistics::Clock::now();
+    }
+
+    if (memory_statistics != nullptr) {
+      memory_statistics->StartNode(node);
+    }
+
     // Execute the kernel.
     try {
       status = p_op_kernel->Compute(&op_kernel_context);
@@ -196,6 +209,10 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
       status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
     }
 
+    if (memory_statistics != nullptr) {
+      node_memory = memory_statistics->EndNode(node, op_kernel_context);
+    }
+
     if (!status.IsOK()) {
       std::ostringstream ss;
       ss << "Non-zero status code returned while running " << node.OpType() << " node. Name:'" << node.Name()
@@ -206,12 +223,28 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
       break;
     }
 
-    if (f_profiler_enabled) {
+    if (op_statistics != nullptr) {
+      op_statistics->Record(session_state.GetOpStatisticsSlot(node_index), op_statistics_begin_time,
+                            op_kernel_context.OutputSizeInBytes());
+    }
+
+    if (f_profiler_enabled && memory_statistics != nullptr) {
+      session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
+                                                     node.Name() + "_kernel_time",
+                                                     kernel_begin_time,
+                                                     {{"op_name", p_op_kernel->KernelDef().OpName()},
+                                                      {"provider", p_op_kernel->KernelDef().Provider()},
+                                                      {"output_size", std::to_string(node_memory.output_bytes)},
+                                                      {"scratch_size", std::to_string(node_memory.scratch_bytes)},
+                                                      {"live_size", std::to_string(node_memory.live_bytes)}});
+    } else if (f_profiler_enabled) {
       session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
                                                      node.Name() + "_kernel_time",
                                                      kernel_begin_time,
                                                      {{"op_name", p_op_kernel->KernelDef().OpName()}, {"provider", p_op_kernel->KernelDef().Provider()}});
+    }
 
+    if (f_profiler_enabled) {
       sync_time_begin = session_state.Profiler().StartTime();
     }
     // sync after compute for outputs
@@ -31,6 +31,9 @@ struct AllocPlanPerValue {
   // if the value is used in async kernel, a fence object would be created
   // note the fence object would be shared between MLValues reusing the same buffer
   bool create_fence_if_async{false};
+  // is_strided_view is valid only if alloc_kind == kReuse. It indicates that the
+  // OrtValue is a strided view into reused_buffer rather than a dense tensor at its start.
+  bool is_strided_view{false};
 
  public:
   AllocPlanPerValue() : location(CPU, Invalid) {}
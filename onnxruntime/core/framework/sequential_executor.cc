@@ -11,6 +11,7 @@
 #include "core/common/logging/logging.h"
 #include "core/framework/allocation_planner.h"
 #include "core/framework/execution_frame.h"
+#include "core/framework/memory_statistics.h"
 #include "core/framework/session_state.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/utils.h"
@@ -54,9 +55,13 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
                                    const std::unordered_map<size_t, CustomAllocator>& fetch_allocators,
                                    const logging::Logger& logger) {
   const bool is_profiler_enabled = session_state.Profiler().IsEnabled();
+  profiling::OpStatistics* op_statistics = session_state.Profiler().GetOpStatistics();
   TimePoint tp;
   TimePoint sync_time_begin;
   TimePoint kernel_begin_time;
+  profiling::OpStatistics::Clock::time_point op_statistics_begin_time;
+  MemoryStatistics* memory_statistics = session_state.GetMemoryStatistics();
+  MemoryStatistics::NodeMemory node_memory;
 
   if (is_profiler_enabled) {
     tp = session_state.Profiler().StartTime();
@@ -163,6 +168,14 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
       kernel_begin_time = session_state.Profiler().StartTime();
     }
 
+    if (op_statistics != nullptr) {
+      op_statistics_begin_time = profiling::OpStatistics::Clock::now();
+    }
+
+    if (memory_statistics != nullptr) {
+      memory_statistics->StartNode(node);
+    }
+
 #ifdef CONCURRENCY_VISUALIZER
     {
       diagnostic::span span(series, "%s.%d", node.OpType().c_str(), node.Index());
@@ -175,6 +188,10 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
         compute_status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
       }
 
+      if (memory_statistics != nullptr) {
+        node_memory = memory_statistics->EndNode(node, op_kernel_context);
+      }
+
       if (!compute_status.IsOK()) {
         std::ostringstream ss;
         ss << "Non-zero status code returned while running " << node.OpType() << " node. Name:'" << node.Name()
@@ -188,12 +205,28 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
     }
 #endif
 
-    if (is_profiler_enabled) {
+    if (op_statistics != nullptr) {
+      op_statistics->Record(session_state.GetOpStatisticsSlot(node_index), op_statistics_begin_time,
+                            op_kernel_context.OutputSizeInBytes());
+    }
+
+    if (is_profiler_enabled && memory_statistics != nullptr) {
+      session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
+                                                     p_op_kernel->Node().Name() + "_kernel_time",
+                                                     kernel_begin_time,
+                                                     {{"op_name", p_op_kernel->KernelDef().OpName()},
+                                                      {"provider", p_op_kernel->KernelDef().Provider()},
+                                                      {"output_size", std::to_string(node_memory.output_bytes)},
+                                                      {"scratch_size", std::to_string(node_memory.scratch_bytes)},
+                                                      {"live_size", std::to_string(node_memory.live_bytes)}});
+    } else if (is_profiler_enabled) {
       session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
                                                      p_op_kernel->Node().Name() + "_kernel_time",
                                                      kernel_begin_time,
                                                      {{"op_name", p_op_kernel->KernelDef().OpName()}, {"provider", p_op_kernel->KernelDef().Provider()}});
+    }
 
+    if (is_profiler_enabled) {
       sync_time_begin = session_state.Profiler().StartTime();
     }
 
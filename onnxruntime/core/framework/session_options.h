@@ -23,6 +23,24 @@ struct SessionOptions {
   // enable profiling for this session.
   bool enable_profiling = false;
 
+  // enable aggregated per node execution statistics for this session.
+  // Unlike enable_profiling this keeps fixed size counters instead of an event per node run,
+  // so it is cheap enough to leave on in production. See InferenceSession::GetOpStatistics.
+  bool enable_op_statistics = false;
+
+  // when op statistics are enabled, also keep every Nth run of each node in a bounded trace. 0 disables the trace.
+  int op_statistics_trace_sample_rate = 0;
+
+  // attribute the memory allocated during runs to the nodes that requested it, and record the live memory
+  // timeline and the allocations live at the peak. This is a diagnostic mode that slows down allocations.
+  // See InferenceSession::GetMemoryStatistics.
+  bool enable_memory_statistics = false;
+
+  // return the sequences of maps built by ZipMap for the graph outputs as columnar map sequences, which share one
+  // array of keys and store the values in a dense [N, C] buffer, instead of seq(map(K, float)).
+  // See ColumnarMapSequence.
+  bool use_columnar_zipmap_output = false;
+
   // non empty filepath enables serialization of the transformed optimized model to the specified filepath.
   std::basic_string<ORTCHAR_T> optimized_model_filepath;
 
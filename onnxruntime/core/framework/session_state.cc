@@ -148,6 +148,26 @@ void SessionState::SetProfiler(profiling::Profiler& profiler) { profiler_ = &pro
 
 ::onnxruntime::profiling::Profiler& SessionState::Profiler() const { return *profiler_; }
 
+void SessionState::RegisterOpStatistics(profiling::OpStatistics& op_statistics) {
+  const GraphViewer* graph_viewer = GetGraphViewer();
+  if (graph_viewer != nullptr) {
+    const auto node_count = static_cast<size_t>(graph_viewer->MaxNodeIndex());
+    std::vector<std::string> names(node_count);
+    std::vector<std::string> op_types(node_count);
+    for (const auto& node : graph_viewer->Nodes()) {
+      names[node.Index()] = node.Name();
+      op_types[node.Index()] = node.OpType();
+    }
+    op_statistics_base_ = op_statistics.RegisterNodes(names, op_types);
+  }
+
+  for (auto& node_entry : subgraph_session_states_) {
+    for (auto& attribute_entry : node_entry.second) {
+      attribute_entry.second->RegisterOpStatistics(op_statistics);
+    }
+  }
+}
+
 static int64_t CalculateMemoryPatternsKey(const std::vector<std::reference_wrapper<const TensorShape>>& shapes) {
   int64_t key = 0;
   for (auto shape : shapes) {
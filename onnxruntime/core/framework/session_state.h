@@ -35,6 +35,7 @@ class OpKernel;
 class NodeIndexInfo;
 struct SequentialExecutionPlan;
 struct MemoryPatternGroup;
+class MemoryStatistics;
 
 /**
  * SessionState should be modified by the inference session class only.
@@ -141,6 +142,26 @@ class SessionState {
   */
   profiling::Profiler& Profiler() const;
 
+  /**
+  Set the memory statistics for this session, or nullptr if they are disabled.
+  */
+  void SetMemoryStatistics(MemoryStatistics* memory_statistics) { memory_statistics_ = memory_statistics; }
+
+  /**
+  Get the memory statistics for this session. nullptr unless enabled via the InferenceSession.
+  */
+  MemoryStatistics* GetMemoryStatistics() const { return memory_statistics_; }
+
+  /**
+  Register the nodes of this graph and of all subgraphs with the per node statistics of the profiler.
+  */
+  void RegisterOpStatistics(profiling::OpStatistics& op_statistics);
+
+  /**
+  Get the slot used by the per node statistics for the given node of this graph.
+  */
+  size_t GetOpStatisticsSlot(NodeIndex node_index) const { return op_statistics_base_ + node_index; }
+
   /**
   Get cached memory pattern based on input shapes
   */
@@ -241,6 +262,8 @@ class SessionState {
 
   const logging::Logger* logger_ = nullptr;
   profiling::Profiler* profiler_ = nullptr;
+  size_t op_statistics_base_ = 0;
+  MemoryStatistics* memory_statistics_ = nullptr;
 
   // switch for enable memory pattern optimization or not.
   const bool enable_mem_pattern_;
@@ -67,6 +67,42 @@ void Tensor::Init(MLDataType p_type, const TensorShape& shape, void* p_raw_data,
     }
   }
   byte_offset_ = offset;
+  strides_.clear();
+  is_contiguous_ = true;
+}
+
+std::vector<int64_t> Tensor::Strides() const {
+  if (!strides_.empty()) {
+    return strides_;
+  }
+
+  const auto& dims = shape_.GetDims();
+  std::vector<int64_t> strides(dims.size());
+  int64_t stride = 1;
+  for (size_t i = dims.size(); i-- > 0;) {
+    strides[i] = stride;
+    stride *= dims[i];
+  }
+  return strides;
+}
+
+void Tensor::SetStridedView(gsl::span<const int64_t> strides, ptrdiff_t byte_offset) {
+  const auto& dims = shape_.GetDims();
+  ORT_ENFORCE(strides.size() == dims.size(), "Expected ", dims.size(), " strides but got ", strides.size());
+
+  // the view is contiguous if every dimension with more than one element has its dense stride
+  bool is_contiguous = true;
+  int64_t dense_stride = 1;
+  for (size_t i = dims.size(); i-- > 0;) {
+    if (dims[i] != 1 && strides[i] != dense_stride) {
+      is_contiguous = false;
+    }
+    dense_stride *= dims[i];
+  }
+
+  strides_.assign(strides.begin(), strides.end());
+  byte_offset_ = byte_offset;
+  is_contiguous_ = is_contiguous;
 }
 
 Tensor::Tensor(Tensor&& other) noexcept
@@ -75,12 +111,16 @@ Tensor::Tensor(Tensor&& other) noexcept
       shape_(other.shape_),
       dtype_(other.dtype_),
       alloc_info_(other.alloc_info_),
-      byte_offset_(other.byte_offset_) {
+      byte_offset_(other.byte_offset_),
+      strides_(std::move(other.strides_)),
+      is_contiguous_(other.is_contiguous_) {
   other.dtype_ = DataTypeImpl::GetType<float>()->AsPrimitiveDataType();
   other.shape_ = TensorShape(std::vector<int64_t>(1, 0));
   other.p_data_ = nullptr;
   other.buffer_deleter_ = nullptr;
   other.byte_offset_ = 0;
+  other.strides_.clear();
+  other.is_contiguous_ = true;
 }
 
 Tensor& Tensor::operator=(Tensor&& other) noexcept {
@@ -91,6 +131,8 @@ Tensor& Tensor::operator=(Tensor&& other) noexcept {
     shape_ = other.shape_;
     alloc_info_ = other.alloc_info_;
     byte_offset_ = other.byte_offset_;
+    strides_ = std::move(other.strides_);
+    is_contiguous_ = other.is_contiguous_;
     p_data_ = other.p_data_;
     buffer_deleter_ = other.buffer_deleter_;
 
@@ -98,6 +140,8 @@ Tensor& Tensor::operator=(Tensor&& other) noexcept {
     other.shape_ = TensorShape(std::vector<int64_t>(1, 0));
     other.p_data_ = nullptr;
     other.byte_offset_ = 0;
+    other.strides_.clear();
+    other.is_contiguous_ = true;
     other.buffer_deleter_ = nullptr;
   }
   return *this;
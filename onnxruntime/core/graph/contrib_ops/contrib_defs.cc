@@ -2404,7 +2404,7 @@ Example 4:
       .Output(2, "inv_std_var", "Saved inverse standard variance used during training to speed up gradient computation.", "U", OpSchema::Optional)
       .TypeConstraint(
           "T",
-          {"tensor(float16)", "tensor(float)", "tensor(double)"},
+          {"tensor(float16)", "tensor(float)", "tensor(double)", "tensor(bfloat16)"},
           "Constrain input and output types (except mean and inv_std_var) to float tensors.")
       .TypeConstraint(
           "U",
@@ -2482,6 +2482,70 @@ It's an extension of Gelu. It takes the sum of input A and bias input B as the i
           "Constrain input and output types to float tensors.")
       .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput);
 
+  static const char* FusedElementwise_ver1_doc = R"DOC(
+A chain of element-wise operators fused into one node by the graph optimizer. The operators run in the order of
+'ops'. Operator k reads one or two slots from 'operands' and writes slot N + k, where N is the number of inputs
+and slots 0 to N - 1 hold the inputs. Output i is the value of slot 'output_slots'[i]. Every output has the
+multidirectional broadcast shape of the inputs.)DOC";
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(FusedElementwise)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetSupportLevel(OpSchema::SupportType::EXPERIMENTAL)
+      .SetDoc(FusedElementwise_ver1_doc)
+      .Attr("ops", "Element-wise ONNX operators to run, in order.", AttributeProto::STRINGS)
+      .Attr("operands", "Slots read by the operators, one per input of each operator.", AttributeProto::INTS)
+      .Attr("output_slots", "Slot that each output takes.", AttributeProto::INTS)
+      .Input(0, "inputs", "Tensors read by the operators.", "T", OpSchema::Variadic)
+      .Output(0, "outputs", "Results of the operators that are read outside of the node.", "T", OpSchema::Variadic)
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        const size_t num_outputs = ctx.getNumOutputs();
+        for (size_t i = 0; i < num_outputs; ++i) {
+          propagateElemTypeFromInputToOutput(ctx, 0, i);
+        }
+
+        std::vector<const ONNX_NAMESPACE::TensorShapeProto*> shapes;
+        for (size_t i = 0; i < ctx.getNumInputs(); ++i) {
+          if (!hasInputShape(ctx, i)) {
+            return;
+          }
+          shapes.push_back(&getInputShape(ctx, i));
+        }
+        for (size_t i = 0; i < num_outputs; ++i) {
+          multidirectionalBroadcastShapeInference(shapes, *getOutputShape(ctx, i));
+        }
+      });
+
+  static const char* ColumnarZipMap_ver1_doc = R"DOC(
+ZipMap with a columnar output. The maps share one array of the distinct keys in map order, and their values are
+stored in a dense [N, C] float buffer whose row n holds the values of map n in key order. When a key is repeated in
+the attributes, the last column wins, as in ZipMap. The session replaces ZipMap with this operator for the graph
+outputs when the option use_columnar_zipmap_output is set.)DOC";
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(ColumnarZipMap)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetSupportLevel(OpSchema::SupportType::EXPERIMENTAL)
+      .SetDoc(ColumnarZipMap_ver1_doc)
+      .Attr("classlabels_strings", "The keys when using string keys.", AttributeProto::STRINGS, OPTIONAL)
+      .Attr("classlabels_int64s", "The keys when using int keys.", AttributeProto::INTS, OPTIONAL)
+      .Input(0, "X", "The input values", "tensor(float)")
+      .Output(0, "Z", "The output maps", "T")
+      .TypeConstraint(
+          "T",
+          {"opaque(com.microsoft,ColumnarMapSequenceStringToFloat)",
+           "opaque(com.microsoft,ColumnarMapSequenceInt64ToFloat)"},
+          "The columnar map sequence with string or int64 keys.")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        std::vector<std::string> classlabels_strings;
+        bool using_strings = getRepeatedAttribute(ctx, "classlabels_strings", classlabels_strings) &&
+                             !classlabels_strings.empty();
+        auto* opaque_type = ctx.getOutputType(0)->mutable_opaque_type();
+        opaque_type->set_domain(kMSDomain);
+        opaque_type->set_name(using_strings ? "ColumnarMapSequenceStringToFloat" : "ColumnarMapSequenceInt64ToFloat");
+      });
+
   RegisterBertSchemas();
 
 #ifdef MICROSOFT_INTERNAL
@@ -147,6 +147,59 @@ MlasGemm(
     MLAS_THREADPOOL* ThreadPool
     );
 
+//
+// Batched single precision matrix/matrix multiply routines. All matrices in
+// the batch share the same shape and the work is partitioned across the batch
+// and across tiles of the output matrices together.
+//
+
+struct MLAS_SGEMM_DATA_PARAMS {
+    const float* A;
+    size_t lda;
+    const float* B;
+    size_t ldb;
+    float* C;
+    size_t ldc;
+};
+
+void
+MLASCALL
+MlasGemmBatch(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const MLAS_SGEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    float beta,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+void
+MLASCALL
+MlasGemmBatch(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    size_t StrideA,
+    const float* B,
+    size_t ldb,
+    size_t StrideB,
+    float beta,
+    float* C,
+    size_t ldc,
+    size_t StrideC,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 void
 MLASCALL
 MlasGemm(
@@ -306,6 +359,92 @@ MlasComputeErf(
     size_t N
     );
 
+void
+MLASCALL
+MlasComputeExp(
+    const float* Input,
+    float* Output,
+    size_t N
+    );
+
+enum MLAS_GELU_ALGORITHM {
+    MlasGeluErf,
+    MlasGeluTanh,
+};
+
+void
+MLASCALL
+MlasComputeBiasGelu(
+    MLAS_GELU_ALGORITHM Algorithm,
+    const float* Input,
+    const float* Bias,
+    float* Output,
+    size_t N
+    );
+
+void
+MLASCALL
+MlasComputeLayerNorm(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Gamma,
+    const float* Beta,
+    float* Output,
+    size_t N,
+    float Epsilon,
+    float* Mean,
+    float* InvStdDev
+    );
+
+//
+// Transpose routines.
+//
+
+void
+MLASCALL
+MlasTranspose(
+    const uint8_t* Input,
+    uint8_t* Output,
+    size_t M,
+    size_t N,
+    size_t ldInput,
+    size_t ldOutput
+    );
+
+void
+MLASCALL
+MlasTranspose(
+    const uint16_t* Input,
+    uint16_t* Output,
+    size_t M,
+    size_t N,
+    size_t ldInput,
+    size_t ldOutput
+    );
+
+void
+MLASCALL
+MlasTranspose(
+    const uint32_t* Input,
+    uint32_t* Output,
+    size_t M,
+    size_t N,
+    size_t ldInput,
+    size_t ldOutput
+    );
+
+void
+MLASCALL
+MlasTranspose(
+    const uint64_t* Input,
+    uint64_t* Output,
+    size_t M,
+    size_t N,
+    size_t ldInput,
+    size_t ldOutput
+    );
+
 //
 // Half-precision floating-point routines.
 //
@@ -319,6 +458,60 @@ MlasConvertHalfToFloatBuffer(
     size_t Count
     );
 
+//
+// Half precision values are stored either in the IEEE half precision format
+// or in the bfloat16 format (the upper 16 bits of a single precision float).
+//
+
+enum MLAS_HALF_TYPE {
+    MlasHalfFloat16,
+    MlasHalfBFloat16,
+};
+
+void
+MLASCALL
+MlasConvertHalfToFloat(
+    MLAS_HALF_TYPE Type,
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    );
+
+void
+MLASCALL
+MlasConvertFloatToHalf(
+    MLAS_HALF_TYPE Type,
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    );
+
+//
+// Half precision matrix/matrix multiply routine. The A and B matrices are
+// converted to single precision as their panels are packed, so the products
+// are accumulated and the C matrix is produced in single precision.
+//
+
+void
+MLASCALL
+MlasHalfGemm(
+    MLAS_HALF_TYPE Type,
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const unsigned short* A,
+    size_t lda,
+    const unsigned short* B,
+    size_t ldb,
+    float beta,
+    float* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 //
 // Buffer reordering routines.
 //
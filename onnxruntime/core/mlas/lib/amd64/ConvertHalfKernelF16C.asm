@@ -0,0 +1,141 @@
+;++
+;
+; Copyright (c) Microsoft Corporation. All rights reserved.
+;
+; Licensed under the MIT License.
+;
+; Module Name:
+;
+;   ConvertHalfKernelF16C.asm
+;
+; Abstract:
+;
+;   This module implements kernels to convert between half precision and
+;   single precision floating point buffers.
+;
+;   This implementation uses F16C instructions.
+;
+;--
+
+        .xlist
+INCLUDE mlasi.inc
+        .list
+
+;++
+;
+; Routine Description:
+;
+;   This routine converts the source buffer of half precision floats to the
+;   destination buffer of single precision floats.
+;
+; Arguments:
+;
+;   Source (rcx) - Supplies the address of the source buffer of half precision
+;       floats.
+;
+;   Destination (rdx) - Supplies the address of the destination buffer of
+;       single precision floats.
+;
+;   Count (r8) - Supplies the number of elements to convert.
+;
+; Return Value:
+;
+;   None.
+;
+;--
+
+        LEAF_ENTRY MlasConvertHalfToFloatKernelF16C, _TEXT
+
+        sub     r8,16
+        jb      HalfToFloatProcessRemainingCount
+
+HalfToFloatConvertBy16Loop:
+        vcvtph2ps ymm0,XMMWORD PTR [rcx]
+        vcvtph2ps ymm1,XMMWORD PTR [rcx+8*2]
+        add     rcx,16*2                        ; advance source by 16 elements
+        vmovups YMMWORD PTR [rdx],ymm0
+        vmovups YMMWORD PTR [rdx+8*4],ymm1
+        add     rdx,16*4                        ; advance destination by 16 elements
+        sub     r8,16
+        jae     HalfToFloatConvertBy16Loop
+
+HalfToFloatProcessRemainingCount:
+        add     r8,16                           ; correct for over-subtract above
+        jz      HalfToFloatExitKernel
+
+HalfToFloatConvertBy1Loop:
+        movzx   eax,WORD PTR [rcx]
+        vmovd   xmm0,eax
+        vcvtph2ps xmm0,xmm0
+        add     rcx,2
+        vmovss  DWORD PTR [rdx],xmm0
+        add     rdx,4
+        dec     r8
+        jnz     HalfToFloatConvertBy1Loop
+
+HalfToFloatExitKernel:
+        vzeroupper
+        ret
+
+        LEAF_END MlasConvertHalfToFloatKernelF16C, _TEXT
+
+;++
+;
+; Routine Description:
+;
+;   This routine converts the source buffer of single precision floats to the
+;   destination buffer of half precision floats. Values are rounded to the
+;   nearest even representable value.
+;
+; Arguments:
+;
+;   Source (rcx) - Supplies the address of the source buffer of single
+;       precision floats.
+;
+;   Destination (rdx) - Supplies the address of the destination buffer of half
+;       precision floats.
+;
+;   Count (r8) - Supplies the number of elements to convert.
+;
+; Return Value:
+;
+;   None.
+;
+;--
+
+        LEAF_ENTRY MlasConvertFloatToHalfKernelF16C, _TEXT
+
+        sub     r8,16
+        jb      FloatToHalfProcessRemainingCount
+
+FloatToHalfConvertBy16Loop:
+        vmovups ymm0,YMMWORD PTR [rcx]
+        vmovups ymm1,YMMWORD PTR [rcx+8*4]
+        add     rcx,16*4                        ; advance source by 16 elements
+        vcvtps2ph XMMWORD PTR [rdx],ymm0,0      ; round to nearest even
+        vcvtps2ph XMMWORD PTR [rdx+8*2],ymm1,0
+        add     rdx,16*2                        ; advance destination by 16 elements
+        sub     r8,16
+        jae     FloatToHalfConvertBy16Loop
+
+FloatToHalfProcessRemainingCount:
+        add     r8,16                           ; correct for over-subtract above
+        jz      FloatToHalfExitKernel
+
+FloatToHalfConvertBy1Loop:
+        vmovss  xmm0,DWORD PTR [rcx]
+        add     rcx,4
+        vcvtps2ph xmm0,xmm0,0
+        vmovd   eax,xmm0
+        mov     WORD PTR [rdx],ax
+        add     rdx,2
+        dec     r8
+        jnz     FloatToHalfConvertBy1Loop
+
+FloatToHalfExitKernel:
+        vzeroupper
+        ret
+
+        LEAF_END MlasConvertFloatToHalfKernelF16C, _TEXT
+
+        END
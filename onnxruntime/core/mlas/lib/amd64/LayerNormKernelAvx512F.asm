@@ -0,0 +1,245 @@
+;++
+;
+; Copyright (c) Microsoft Corporation. All rights reserved.
+;
+; Licensed under the MIT License.
+;
+; Module Name:
+;
+;   LayerNormKernelAvx512F.asm
+;
+; Abstract:
+;
+;   This module implements kernels for computing layer normalization of a row
+;   of elements.
+;
+;   This implementation uses AVX512F instructions.
+;
+;--
+
+        .xlist
+INCLUDE mlasi.inc
+        .list
+
+;++
+;
+; Macro Description:
+;
+;   This macro generates code to compute the sum and the sum of squares of the
+;   row. The row is formed from the input buffer and optionally the skip and
+;   bias buffers.
+;
+; Arguments:
+;
+;   Mode - Supplies the buffers that form the row: 0 for the input buffer, 1
+;       for the input and skip buffers, 2 for the input, skip and bias buffers.
+;       If Mode is not zero, the row is stored to the output buffer.
+;
+; Implicit Arguments:
+;
+;   rcx - Supplies the address of the input buffer.
+;
+;   rdx - Supplies the address of the skip buffer.
+;
+;   r8 - Supplies the address of the bias buffer.
+;
+;   r9 - Supplies the address of the output buffer.
+;
+;   rax - Supplies the number of elements to process.
+;
+;   zmm0 - Supplies the sum accumulator.
+;
+;   zmm1 - Supplies the sum of squares accumulator.
+;
+;--
+
+ComputeStatistics MACRO Mode
+
+        sub     rax,16
+        jb      ComputeStatistics&Mode&ProcessRemainingCount
+
+ComputeStatistics&Mode&By16Loop:
+        vmovups zmm2,ZMMWORD PTR [rcx]
+        add     rcx,16*4                        ; advance input by 16 elements
+IF Mode GE 1
+        vaddps  zmm2,zmm2,ZMMWORD PTR [rdx]
+        add     rdx,16*4                        ; advance skip by 16 elements
+ENDIF
+IF Mode EQ 2
+        vaddps  zmm2,zmm2,ZMMWORD PTR [r8]
+        add     r8,16*4                         ; advance bias by 16 elements
+ENDIF
+IF Mode GE 1
+        vmovups ZMMWORD PTR [r9],zmm2
+        add     r9,16*4                         ; advance output by 16 elements
+ENDIF
+        vaddps  zmm0,zmm0,zmm2
+        vfmadd231ps zmm1,zmm2,zmm2
+        sub     rax,16
+        jae     ComputeStatistics&Mode&By16Loop
+
+ComputeStatistics&Mode&ProcessRemainingCount:
+        add     rax,16                          ; correct for over-subtract above
+        jz      ReduceStatistics
+        xor     r11d,r11d
+        bts     r11d,eax
+        dec     r11d
+        kmovw   k1,r11d                         ; compute mask for remaining elements
+        vmovups zmm2{k1}{z},ZMMWORD PTR [rcx]
+IF Mode GE 1
+        vaddps  zmm2{k1}{z},zmm2,ZMMWORD PTR [rdx]
+ENDIF
+IF Mode EQ 2
+        vaddps  zmm2{k1}{z},zmm2,ZMMWORD PTR [r8]
+ENDIF
+IF Mode GE 1
+        vmovups ZMMWORD PTR [r9]{k1},zmm2
+ENDIF
+        vaddps  zmm0,zmm0,zmm2
+        vfmadd231ps zmm1,zmm2,zmm2
+        jmp     ReduceStatistics
+
+        ENDM
+
+;++
+;
+; Routine Description:
+;
+;   This routine computes the sum and the sum of squares of a row of elements.
+;
+; Arguments:
+;
+;   Input (rcx) - Supplies the input buffer.
+;
+;   Skip (rdx) - Optionally supplies a buffer that is added to the input buffer.
+;       If this is not NULL, the sum of the buffers is stored to the output
+;       buffer.
+;
+;   Bias (r8) - Optionally supplies a buffer that is added to the input buffer.
+;       This is only used if Skip is not NULL.
+;
+;   Output (r9) - Supplies the output buffer.
+;
+;   N - Supplies the number of elements to process.
+;
+;   Statistics - Supplies a two element buffer that receives the sum and the
+;       sum of squares of the elements.
+;
+; Return Value:
+;
+;   None.
+;
+;--
+
+        LEAF_ENTRY MlasLayerNormStatisticsKernelAvx512F, _TEXT
+
+        mov     rax,QWORD PTR [rsp+28h]         ; load N
+        mov     r10,QWORD PTR [rsp+30h]         ; load Statistics
+        vxorps  xmm0,xmm0,xmm0                  ; clear sum accumulator
+        vxorps  xmm1,xmm1,xmm1                  ; clear sum of squares accumulator
+        test    rdx,rdx
+        jz      ComputeStatisticsInput
+        test    r8,r8
+        jz      ComputeStatisticsInputSkip
+        ComputeStatistics 2
+
+ComputeStatisticsInputSkip:
+        ComputeStatistics 1
+
+ComputeStatisticsInput:
+        ComputeStatistics 0
+
+;
+; Reduce the accumulators to the sum and the sum of squares.
+;
+
+ReduceStatistics:
+        vextractf64x4 ymm2,zmm0,1
+        vextractf64x4 ymm3,zmm1,1
+        vaddps  ymm0,ymm0,ymm2
+        vaddps  ymm1,ymm1,ymm3
+        vextractf128 xmm2,ymm0,1
+        vextractf128 xmm3,ymm1,1
+        vaddps  xmm0,xmm0,xmm2
+        vaddps  xmm1,xmm1,xmm3
+        vhaddps xmm0,xmm0,xmm1                  ; s0+s1, s2+s3, q0+q1, q2+q3
+        vhaddps xmm0,xmm0,xmm0                  ; sum, sum of squares
+        vmovlps QWORD PTR [r10],xmm0
+        vzeroupper
+        ret
+
+        LEAF_END MlasLayerNormStatisticsKernelAvx512F, _TEXT
+
+;++
+;
+; Routine Description:
+;
+;   This routine normalizes, scales and shifts a row of elements.
+;
+; Arguments:
+;
+;   Input (rcx) - Supplies the input buffer.
+;
+;   Output (rdx) - Supplies the output buffer. This may be the same as the input
+;       buffer.
+;
+;   N (r8) - Supplies the number of elements to process.
+;
+;   Gamma (r9) - Supplies the per element scale buffer.
+;
+;   Beta - Supplies the per element shift buffer.
+;
+;   Statistics - Supplies a two element buffer with the mean and the
+;       inverse standard deviation of the row.
+;
+; Return Value:
+;
+;   None.
+;
+;--
+
+        LEAF_ENTRY MlasLayerNormScaleKernelAvx512F, _TEXT
+
+        mov     rax,QWORD PTR [rsp+28h]         ; load Beta
+        mov     r10,QWORD PTR [rsp+30h]         ; load Statistics
+        vbroadcastss zmm0,DWORD PTR [r10]               ; mean
+        vbroadcastss zmm1,DWORD PTR [r10+4]             ; inverse standard deviation
+        sub     r8,16
+        jb      ScaleProcessRemainingCount
+
+ScaleBy16Loop:
+        vmovups zmm2,ZMMWORD PTR [rcx]
+        vmovups zmm3,ZMMWORD PTR [r9]
+        add     rcx,16*4                        ; advance input by 16 elements
+        vsubps  zmm2,zmm2,zmm0                          ; normalize
+        vmulps  zmm2,zmm2,zmm1
+        vfmadd213ps zmm2,zmm3,ZMMWORD PTR [rax] ; scale and shift
+        add     r9,16*4                         ; advance gamma by 16 elements
+        add     rax,16*4                        ; advance beta by 16 elements
+        vmovups ZMMWORD PTR [rdx],zmm2
+        add     rdx,16*4                        ; advance output by 16 elements
+        sub     r8,16
+        jae     ScaleBy16Loop
+
+ScaleProcessRemainingCount:
+        add     r8,16                           ; correct for over-subtract above
+        jz      ScaleExitKernel
+        xor     r11d,r11d
+        bts     r11d,r8d
+        dec     r11d
+        kmovw   k1,r11d                         ; compute mask for remaining elements
+        vmovups zmm2{k1}{z},ZMMWORD PTR [rcx]
+        vmovups zmm3{k1}{z},ZMMWORD PTR [r9]
+        vmovups zmm4{k1}{z},ZMMWORD PTR [rax]
+        vsubps  zmm2,zmm2,zmm0                          ; normalize
+        vmulps  zmm2,zmm2,zmm1
+        vfmadd213ps zmm2,zmm3,zmm4              ; scale and shift
+        vmovups ZMMWORD PTR [rdx]{k1},zmm2
+
+ScaleExitKernel:
+        vzeroupper
+        ret
+
+        LEAF_END MlasLayerNormScaleKernelAvx512F, _TEXT
+
+        END
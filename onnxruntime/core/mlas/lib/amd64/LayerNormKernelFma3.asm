@@ -0,0 +1,243 @@
+;++
+;
+; Copyright (c) Microsoft Corporation. All rights reserved.
+;
+; Licensed under the MIT License.
+;
+; Module Name:
+;
+;   LayerNormKernelFma3.asm
+;
+; Abstract:
+;
+;   This module implements kernels for computing layer normalization of a row
+;   of elements.
+;
+;   This implementation uses AVX fused multiply/add instructions.
+;
+;--
+
+        .xlist
+INCLUDE mlasi.inc
+        .list
+
+        EXTERN  MlasMaskMoveAvx:NEAR
+
+;++
+;
+; Macro Description:
+;
+;   This macro generates code to compute the sum and the sum of squares of the
+;   row. The row is formed from the input buffer and optionally the skip and
+;   bias buffers.
+;
+; Arguments:
+;
+;   Mode - Supplies the buffers that form the row: 0 for the input buffer, 1
+;       for the input and skip buffers, 2 for the input, skip and bias buffers.
+;       If Mode is not zero, the row is stored to the output buffer.
+;
+; Implicit Arguments:
+;
+;   rcx - Supplies the address of the input buffer.
+;
+;   rdx - Supplies the address of the skip buffer.
+;
+;   r8 - Supplies the address of the bias buffer.
+;
+;   r9 - Supplies the address of the output buffer.
+;
+;   rax - Supplies the number of elements to process.
+;
+;   ymm0 - Supplies the sum accumulator.
+;
+;   ymm1 - Supplies the sum of squares accumulator.
+;
+;--
+
+ComputeStatistics MACRO Mode
+
+        sub     rax,8
+        jb      ComputeStatistics&Mode&ProcessRemainingCount
+
+ComputeStatistics&Mode&By8Loop:
+        vmovups ymm2,YMMWORD PTR [rcx]
+        add     rcx,8*4                         ; advance input by 8 elements
+IF Mode GE 1
+        vaddps  ymm2,ymm2,YMMWORD PTR [rdx]
+        add     rdx,8*4                         ; advance skip by 8 elements
+ENDIF
+IF Mode EQ 2
+        vaddps  ymm2,ymm2,YMMWORD PTR [r8]
+        add     r8,8*4                          ; advance bias by 8 elements
+ENDIF
+IF Mode GE 1
+        vmovups YMMWORD PTR [r9],ymm2
+        add     r9,8*4                          ; advance output by 8 elements
+ENDIF
+        vaddps  ymm0,ymm0,ymm2
+        vfmadd231ps ymm1,ymm2,ymm2
+        sub     rax,8
+        jae     ComputeStatistics&Mode&By8Loop
+
+ComputeStatistics&Mode&ProcessRemainingCount:
+        add     rax,8                           ; correct for over-subtract above
+        jz      ReduceStatistics
+        vmovd   xmm5,eax
+        vpbroadcastd ymm5,xmm5
+        vpcmpgtd ymm5,ymm5,YMMWORD PTR [MlasMaskMoveAvx]
+        vmaskmovps ymm2,ymm5,YMMWORD PTR [rcx]
+IF Mode GE 1
+        vmaskmovps ymm3,ymm5,YMMWORD PTR [rdx]
+        vaddps  ymm2,ymm2,ymm3
+ENDIF
+IF Mode EQ 2
+        vmaskmovps ymm3,ymm5,YMMWORD PTR [r8]
+        vaddps  ymm2,ymm2,ymm3
+ENDIF
+IF Mode GE 1
+        vmaskmovps YMMWORD PTR [r9],ymm5,ymm2
+ENDIF
+        vaddps  ymm0,ymm0,ymm2
+        vfmadd231ps ymm1,ymm2,ymm2
+        jmp     ReduceStatistics
+
+        ENDM
+
+;++
+;
+; Routine Description:
+;
+;   This routine computes the sum and the sum of squares of a row of elements.
+;
+; Arguments:
+;
+;   Input (rcx) - Supplies the input buffer.
+;
+;   Skip (rdx) - Optionally supplies a buffer that is added to the input buffer.
+;       If this is not NULL, the sum of the buffers is stored to the output
+;       buffer.
+;
+;   Bias (r8) - Optionally supplies a buffer that is added to the input buffer.
+;       This is only used if Skip is not NULL.
+;
+;   Output (r9) - Supplies the output buffer.
+;
+;   N - Supplies the number of elements to process.
+;
+;   Statistics - Supplies a two element buffer that receives the sum and the
+;       sum of squares of the elements.
+;
+; Return Value:
+;
+;   None.
+;
+;--
+
+        LEAF_ENTRY MlasLayerNormStatisticsKernelFma3, _TEXT
+
+        mov     rax,QWORD PTR [rsp+28h]         ; load N
+        mov     r10,QWORD PTR [rsp+30h]         ; load Statistics
+        vxorps  xmm0,xmm0,xmm0                  ; clear sum accumulator
+        vxorps  xmm1,xmm1,xmm1                  ; clear sum of squares accumulator
+        test    rdx,rdx
+        jz      ComputeStatisticsInput
+        test    r8,r8
+        jz      ComputeStatisticsInputSkip
+        ComputeStatistics 2
+
+ComputeStatisticsInputSkip:
+        ComputeStatistics 1
+
+ComputeStatisticsInput:
+        ComputeStatistics 0
+
+;
+; Reduce the accumulators to the sum and the sum of squares.
+;
+
+ReduceStatistics:
+        vextractf128 xmm2,ymm0,1
+        vextractf128 xmm3,ymm1,1
+        vaddps  xmm0,xmm0,xmm2
+        vaddps  xmm1,xmm1,xmm3
+        vhaddps xmm0,xmm0,xmm1                  ; s0+s1, s2+s3, q0+q1, q2+q3
+        vhaddps xmm0,xmm0,xmm0                  ; sum, sum of squares
+        vmovlps QWORD PTR [r10],xmm0
+        vzeroupper
+        ret
+
+        LEAF_END MlasLayerNormStatisticsKernelFma3, _TEXT
+
+;++
+;
+; Routine Description:
+;
+;   This routine normalizes, scales and shifts a row of elements.
+;
+; Arguments:
+;
+;   Input (rcx) - Supplies the input buffer.
+;
+;   Output (rdx) - Supplies the output buffer. This may be the same as the input
+;       buffer.
+;
+;   N (r8) - Supplies the number of elements to process.
+;
+;   Gamma (r9) - Supplies the per element scale buffer.
+;
+;   Beta - Supplies the per element shift buffer.
+;
+;   Statistics - Supplies a two element buffer with the mean and the
+;       inverse standard deviation of the row.
+;
+; Return Value:
+;
+;   None.
+;
+;--
+
+        LEAF_ENTRY MlasLayerNormScaleKernelFma3, _TEXT
+
+        mov     rax,QWORD PTR [rsp+28h]         ; load Beta
+        mov     r10,QWORD PTR [rsp+30h]         ; load Statistics
+        vbroadcastss ymm0,DWORD PTR [r10]               ; mean
+        vbroadcastss ymm1,DWORD PTR [r10+4]             ; inverse standard deviation
+        sub     r8,8
+        jb      ScaleProcessRemainingCount
+
+ScaleBy8Loop:
+        vmovups ymm2,YMMWORD PTR [rcx]
+        vmovups ymm3,YMMWORD PTR [r9]
+        add     rcx,8*4                         ; advance input by 8 elements
+        vsubps  ymm2,ymm2,ymm0                          ; normalize
+        vmulps  ymm2,ymm2,ymm1
+        vfmadd213ps ymm2,ymm3,YMMWORD PTR [rax] ; scale and shift
+        add     r9,8*4                          ; advance gamma by 8 elements
+        add     rax,8*4                         ; advance beta by 8 elements
+        vmovups YMMWORD PTR [rdx],ymm2
+        add     rdx,8*4                         ; advance output by 8 elements
+        sub     r8,8
+        jae     ScaleBy8Loop
+
+ScaleProcessRemainingCount:
+        add     r8,8                            ; correct for over-subtract above
+        jz      ScaleExitKernel
+        vmovd   xmm5,r8d
+        vpbroadcastd ymm5,xmm5
+        vpcmpgtd ymm5,ymm5,YMMWORD PTR [MlasMaskMoveAvx]
+        vmaskmovps ymm2,ymm5,YMMWORD PTR [rcx]
+        vmaskmovps ymm3,ymm5,YMMWORD PTR [r9]
+        vmaskmovps ymm4,ymm5,YMMWORD PTR [rax]
+        vsubps  ymm2,ymm2,ymm0                          ; normalize
+        vmulps  ymm2,ymm2,ymm1
+        vfmadd213ps ymm2,ymm3,ymm4              ; scale and shift
+        vmaskmovps YMMWORD PTR [rdx],ymm5,ymm2
+
+ScaleExitKernel:
+        vzeroupper
+        ret
+
+        LEAF_END MlasLayerNormScaleKernelFma3, _TEXT
+
+        END
@@ -0,0 +1,362 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    cvtfp16.cpp
+
+Abstract:
+
+    This module implements routines to convert between the half precision
+    formats (IEEE half precision and bfloat16) and single precision floats.
+
+    The implementation below targets the base instruction set while assembly
+    implementations target newer instruction sets (such as F16C).
+
+--*/
+
+#include "mlasi.h"
+
+MLAS_FORCEINLINE
+float
+MlasBitsToFloat(
+    uint32_t Bits
+    )
+{
+    float Value;
+    memcpy(&Value, &Bits, sizeof(Value));
+    return Value;
+}
+
+MLAS_FORCEINLINE
+uint32_t
+MlasFloatToBits(
+    float Value
+    )
+{
+    uint32_t Bits;
+    memcpy(&Bits, &Value, sizeof(Bits));
+    return Bits;
+}
+
+void
+MLASCALL
+MlasConvertHalfToFloatKernel(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts the source buffer of half precision floats to the
+    destination buffer of single precision floats.
+
+Arguments:
+
+    Source - Supplies the address of the source buffer of half precision
+        floats.
+
+    Destination - Supplies the address of the destination buffer of single
+        precision floats.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (Count > 0) {
+
+        uint32_t Half = *Source++;
+        uint32_t Sign = (Half & 0x8000) << 16;
+        uint32_t Bits = (Half & 0x7FFF) << 13;
+        uint32_t Exponent = Bits & 0x0F800000;
+
+        //
+        // Rebias the exponent. Infinities and NaNs need the exponent adjusted
+        // again to reach the maximum exponent. Denormals are renormalized by
+        // subtracting the magic value that was implicitly added.
+        //
+
+        Bits += 0x38000000;
+
+        if (Exponent == 0x0F800000) {
+            Bits += 0x38000000;
+        } else if (Exponent == 0) {
+            Bits = MlasFloatToBits(MlasBitsToFloat(Bits + 0x00800000) - MlasBitsToFloat(0x38800000));
+        }
+
+        *Destination++ = MlasBitsToFloat(Bits | Sign);
+
+        Count--;
+    }
+}
+
+void
+MLASCALL
+MlasConvertFloatToHalfKernel(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts the source buffer of single precision floats to the
+    destination buffer of half precision floats. Values are rounded to the
+    nearest even representable value.
+
+Arguments:
+
+    Source - Supplies the address of the source buffer of single precision
+        floats.
+
+    Destination - Supplies the address of the destination buffer of half
+        precision floats.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (Count > 0) {
+
+        uint32_t Bits = MlasFloatToBits(*Source++);
+        uint32_t Sign = Bits & 0x80000000;
+        uint32_t Half;
+
+        Bits ^= Sign;
+
+        if (Bits >= 0x47800000) {
+
+            //
+            // Values that overflow become infinity and NaNs stay quiet NaNs.
+            //
+
+            Half = (Bits > 0x7F800000) ? 0x7E00 : 0x7C00;
+
+        } else if (Bits < 0x38800000) {
+
+            //
+            // Values that become denormals are rounded by adding a magic value
+            // that shifts the mantissa into place.
+            //
+
+            Half = MlasFloatToBits(MlasBitsToFloat(Bits) + MlasBitsToFloat(0x3F000000)) - 0x3F000000;
+
+        } else {
+
+            //
+            // Rebias the exponent and round the mantissa to nearest even.
+            //
+
+            uint32_t MantissaOdd = (Bits >> 13) & 1;
+
+            Bits += 0xC8000FFF + MantissaOdd;
+            Half = Bits >> 13;
+        }
+
+        *Destination++ = (unsigned short)(Half | (Sign >> 16));
+
+        Count--;
+    }
+}
+
+void
+MlasConvertBFloat16ToFloatKernel(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts the source buffer of bfloat16 values to the
+    destination buffer of single precision floats.
+
+Arguments:
+
+    Source - Supplies the address of the source buffer of bfloat16 values.
+
+    Destination - Supplies the address of the destination buffer of single
+        precision floats.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    //
+    // A bfloat16 value is the upper half of a single precision float, so the
+    // loop below is a widen and shift that the compiler vectorizes.
+    //
+
+    for (size_t i = 0; i < Count; i++) {
+        Destination[i] = MlasBitsToFloat(uint32_t(Source[i]) << 16);
+    }
+}
+
+void
+MlasConvertFloatToBFloat16Kernel(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts the source buffer of single precision floats to the
+    destination buffer of bfloat16 values. Values are rounded to the nearest
+    even representable value.
+
+Arguments:
+
+    Source - Supplies the address of the source buffer of single precision
+        floats.
+
+    Destination - Supplies the address of the destination buffer of bfloat16
+        values.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t i = 0; i < Count; i++) {
+
+        uint32_t Bits = MlasFloatToBits(Source[i]);
+
+        if ((Bits & 0x7FFFFFFF) > 0x7F800000) {
+            Bits |= 0x00400000;
+        } else {
+            Bits += 0x7FFF + ((Bits >> 16) & 1);
+        }
+
+        Destination[i] = (unsigned short)(Bits >> 16);
+    }
+}
+
+void
+MLASCALL
+MlasConvertHalfToFloat(
+    MLAS_HALF_TYPE Type,
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts the source buffer of half precision values to the
+    destination buffer of single precision floats.
+
+Arguments:
+
+    Type - Supplies the format of the half precision values.
+
+    Source - Supplies the address of the source buffer.
+
+    Destination - Supplies the address of the destination buffer.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (Type == MlasHalfBFloat16) {
+        MlasConvertBFloat16ToFloatKernel(Source, Destination, Count);
+        return;
+    }
+
+#if defined(MLAS_TARGET_AMD64)
+    MlasPlatform.ConvertHalfToFloatKernelRoutine(Source, Destination, Count);
+#else
+    MlasConvertHalfToFloatKernel(Source, Destination, Count);
+#endif
+}
+
+void
+MLASCALL
+MlasConvertFloatToHalf(
+    MLAS_HALF_TYPE Type,
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts the source buffer of single precision floats to the
+    destination buffer of half precision values. Values are rounded to the
+    nearest even representable value.
+
+Arguments:
+
+    Type - Supplies the format of the half precision values.
+
+    Source - Supplies the address of the source buffer.
+
+    Destination - Supplies the address of the destination buffer.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (Type == MlasHalfBFloat16) {
+        MlasConvertFloatToBFloat16Kernel(Source, Destination, Count);
+        return;
+    }
+
+#if defined(MLAS_TARGET_AMD64)
+    MlasPlatform.ConvertFloatToHalfKernelRoutine(Source, Destination, Count);
+#else
+    MlasConvertFloatToHalfKernel(Source, Destination, Count);
+#endif
+}
+
+#if !(defined(_WIN32) && defined(MLAS_TARGET_AMD64))
+
+//
+// Windows AMD64 builds implement this routine in assembly (cvtfp16a.asm).
+//
+
+void
+MLASCALL
+MlasConvertHalfToFloatBuffer(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+{
+    MlasConvertHalfToFloat(MlasHalfFloat16, Source, Destination, Count);
+}
+
+#endif
@@ -0,0 +1,156 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    exp.cpp
+
+Abstract:
+
+    This module implements routines to compute the exponential function.
+
+    This implementation uses the same range reduction and polynomial
+    coefficients as the exponential used by the error function kernel: the
+    input is split into n * ln(2) + r with |r| <= ln(2) / 2, exp(r) is
+    approximated by a polynomial and the result is scaled by 2^n.
+
+--*/
+
+#include "mlasi.h"
+
+#include <cmath>
+
+MLAS_INTERNAL_DATA const struct {
+    float LowerRange;
+    float UpperRange;
+    float Log2Reciprocal;
+    float log2_hi;
+    float log2_lo;
+    float P0;
+    float P1;
+    float P2;
+    float P3;
+    float P4;
+    float P5;
+    float P6;
+    float RoundingBias;
+} MlasExpConstants = {
+    -87.3365478515625f,
+    88.3762626647950f,
+    1.44269504088896341f,
+    -6.93145752e-1f,
+    -1.42860677e-6f,
+    1.38319808e-3f,
+    8.37550033e-3f,
+    4.16689515e-2f,
+    1.66664466e-1f,
+    4.99999851e-1f,
+    1.00000000e+0f,
+    1.00000000e+0f,
+    1.25829120e+7f,
+};
+
+void
+MLASCALL
+MlasComputeExp(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the exponential function.
+
+    Inputs are clamped to the range of single precision results. Results that
+    would be below the smallest normal single precision value are flushed to
+    zero.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer. This may be the same as the input
+        buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_FLOAT32X4 RoundingBias = MlasBroadcastFloat32x4(MlasExpConstants.RoundingBias);
+    const MLAS_FLOAT32X4 One = MlasBroadcastFloat32x4(1.0f);
+
+    while (N >= 4) {
+
+        MLAS_FLOAT32X4 Value = MlasLoadFloat32x4(Input);
+
+        Value = MlasMaximumFloat32x4(MlasBroadcastFloat32x4(MlasExpConstants.LowerRange), Value);
+        Value = MlasMinimumFloat32x4(MlasBroadcastFloat32x4(MlasExpConstants.UpperRange), Value);
+
+        //
+        // Round Value / ln(2) to the nearest integer and reduce the input to
+        // the remainder.
+        //
+
+        MLAS_FLOAT32X4 r = MlasMultiplyAddFloat32x4(MlasBroadcastFloat32x4(MlasExpConstants.Log2Reciprocal), Value, RoundingBias);
+        r = MlasSubtractFloat32x4(r, RoundingBias);
+
+        MLAS_FLOAT32X4 fx = MlasMultiplyAddFloat32x4(r, MlasBroadcastFloat32x4(MlasExpConstants.log2_hi), Value);
+        fx = MlasMultiplyAddFloat32x4(r, MlasBroadcastFloat32x4(MlasExpConstants.log2_lo), fx);
+
+        MLAS_FLOAT32X4 y = MlasBroadcastFloat32x4(MlasExpConstants.P0);
+        y = MlasMultiplyAddFloat32x4(y, fx, MlasBroadcastFloat32x4(MlasExpConstants.P1));
+        y = MlasMultiplyAddFloat32x4(y, fx, MlasBroadcastFloat32x4(MlasExpConstants.P2));
+        y = MlasMultiplyAddFloat32x4(y, fx, MlasBroadcastFloat32x4(MlasExpConstants.P3));
+        y = MlasMultiplyAddFloat32x4(y, fx, MlasBroadcastFloat32x4(MlasExpConstants.P4));
+        y = MlasMultiplyAddFloat32x4(y, fx, MlasBroadcastFloat32x4(MlasExpConstants.P5));
+        y = MlasMultiplyAddFloat32x4(y, fx, MlasBroadcastFloat32x4(MlasExpConstants.P6));
+
+        //
+        // Scale by 2^(n-1) and then by 2 so that n = 128 at the upper end of
+        // the range stays representable.
+        //
+
+        y = MlasMultiplyFloat32x4(y, MlasPowerOf2Float32x4(MlasSubtractFloat32x4(r, One)));
+        y = MlasAddFloat32x4(y, y);
+
+        MlasStoreFloat32x4(Output, y);
+
+        Input += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        float Value = *Input++;
+
+        Value = (std::min)(MlasExpConstants.UpperRange, (std::max)(MlasExpConstants.LowerRange, Value));
+
+        float r = MlasExpConstants.Log2Reciprocal * Value + MlasExpConstants.RoundingBias;
+        r -= MlasExpConstants.RoundingBias;
+
+        float fx = r * MlasExpConstants.log2_hi + Value;
+        fx = r * MlasExpConstants.log2_lo + fx;
+
+        float y = MlasExpConstants.P0;
+        y = y * fx + MlasExpConstants.P1;
+        y = y * fx + MlasExpConstants.P2;
+        y = y * fx + MlasExpConstants.P3;
+        y = y * fx + MlasExpConstants.P4;
+        y = y * fx + MlasExpConstants.P5;
+        y = y * fx + MlasExpConstants.P6;
+
+        *Output++ = (r > -126.0f) ? ldexpf(y, (int)r) : 0.0f;
+
+        N -= 1;
+    }
+}
@@ -0,0 +1,179 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    gelu.cpp
+
+Abstract:
+
+    This module implements routines to compute the Gaussian error linear unit
+    (GELU) of a buffer with an optional bias.
+
+    The buffer is processed in blocks that stay resident in the L1 cache: the
+    bias is added and the argument of the error function (or hyperbolic
+    tangent) is formed, the vectorized transcendental kernel is applied, and
+    the results are combined, so each element is read from and written to
+    memory once.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Number of elements processed per block.
+//
+
+#define MLAS_GELU_BLOCK_SIZE 256
+
+MLAS_INTERNAL_DATA const struct {
+    float SqrtHalf;
+    float SqrtTwoOverPi;
+    float Cubic;
+    float Half;
+    float One;
+} MlasGeluConstants = {
+    0.707106781186547524f,
+    0.797884560802865355f,
+    0.044715f,
+    0.5f,
+    1.0f,
+};
+
+void
+MLASCALL
+MlasComputeBiasGelu(
+    MLAS_GELU_ALGORITHM Algorithm,
+    const float* Input,
+    const float* Bias,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the Gaussian error linear unit of the sum of the
+    input and bias buffers.
+
+    MlasGeluErf computes 0.5 * x * (1 + erf(x / sqrt(2))).
+
+    MlasGeluTanh computes the approximation
+    0.5 * x * (1 + tanh(sqrt(2 / pi) * (x + 0.044715 * x^3))).
+
+Arguments:
+
+    Algorithm - Supplies the formula used to compute the function.
+
+    Input - Supplies the input buffer.
+
+    Bias - Optionally supplies a buffer that is added to the input buffer.
+
+    Output - Supplies the output buffer. This may be the same as the input
+        buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_DECLSPEC_ALIGN(float Buffer[MLAS_GELU_BLOCK_SIZE], 16 * sizeof(float));
+
+    const MLAS_FLOAT32X4 SqrtHalfVector = MlasBroadcastFloat32x4(MlasGeluConstants.SqrtHalf);
+    const MLAS_FLOAT32X4 SqrtTwoOverPiVector = MlasBroadcastFloat32x4(MlasGeluConstants.SqrtTwoOverPi);
+    const MLAS_FLOAT32X4 CubicVector = MlasBroadcastFloat32x4(MlasGeluConstants.Cubic);
+    const MLAS_FLOAT32X4 HalfVector = MlasBroadcastFloat32x4(MlasGeluConstants.Half);
+    const MLAS_FLOAT32X4 OneVector = MlasBroadcastFloat32x4(MlasGeluConstants.One);
+
+    while (N > 0) {
+
+        const size_t CountN = (std::min)(N, size_t(MLAS_GELU_BLOCK_SIZE));
+
+        //
+        // Add the bias and store the result to the output buffer. Form the
+        // argument of the transcendental function in the block buffer.
+        //
+
+        size_t n = 0;
+
+        for (; n + 4 <= CountN; n += 4) {
+
+            MLAS_FLOAT32X4 Value = MlasLoadFloat32x4(Input + n);
+
+            if (Bias != nullptr) {
+                Value = MlasAddFloat32x4(Value, MlasLoadFloat32x4(Bias + n));
+            }
+
+            MlasStoreFloat32x4(Output + n, Value);
+
+            if (Algorithm == MlasGeluErf) {
+                Value = MlasMultiplyFloat32x4(Value, SqrtHalfVector);
+            } else {
+                MLAS_FLOAT32X4 ValueCubed = MlasMultiplyFloat32x4(MlasMultiplyFloat32x4(Value, Value), Value);
+                Value = MlasMultiplyAddFloat32x4(ValueCubed, CubicVector, Value);
+                Value = MlasMultiplyFloat32x4(Value, SqrtTwoOverPiVector);
+            }
+
+            MlasStoreFloat32x4(Buffer + n, Value);
+        }
+
+        for (; n < CountN; n++) {
+
+            float Value = Input[n];
+
+            if (Bias != nullptr) {
+                Value += Bias[n];
+            }
+
+            Output[n] = Value;
+
+            if (Algorithm == MlasGeluErf) {
+                Buffer[n] = Value * MlasGeluConstants.SqrtHalf;
+            } else {
+                Buffer[n] = (Value + MlasGeluConstants.Cubic * Value * Value * Value) *
+                    MlasGeluConstants.SqrtTwoOverPi;
+            }
+        }
+
+        if (Algorithm == MlasGeluErf) {
+            MlasComputeErf(Buffer, Buffer, CountN);
+        } else {
+            MlasComputeTanh(Buffer, Buffer, CountN);
+        }
+
+        //
+        // Combine the biased input with the transcendental function.
+        //
+
+        n = 0;
+
+        for (; n + 4 <= CountN; n += 4) {
+
+            MLAS_FLOAT32X4 Value = MlasLoadFloat32x4(Output + n);
+            MLAS_FLOAT32X4 Function = MlasAddFloat32x4(MlasLoadFloat32x4(Buffer + n), OneVector);
+
+            Value = MlasMultiplyFloat32x4(MlasMultiplyFloat32x4(Value, HalfVector), Function);
+
+            MlasStoreFloat32x4(Output + n, Value);
+        }
+
+        for (; n < CountN; n++) {
+            Output[n] = MlasGeluConstants.Half * Output[n] * (Buffer[n] + MlasGeluConstants.One);
+        }
+
+        Input += CountN;
+        Output += CountN;
+
+        if (Bias != nullptr) {
+            Bias += CountN;
+        }
+
+        N -= CountN;
+    }
+}
@@ -0,0 +1,566 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    halfgemm.cpp
+
+Abstract:
+
+    This module implements the half precision matrix/matrix multiply
+    operation. The input matrices are stored as half precision values and are
+    converted to single precision as panels are packed for the single
+    precision kernels, so the operation streams half the bytes of a SGEMM over
+    the same matrices while accumulating in single precision.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the number of rows from matrix A to convert to a local buffer.
+//
+// N.B. This matches the number of rows transposed by the SGEMM operation,
+// which is the maximum number of rows processed by any of the kernels.
+//
+
+#define MLAS_HALFGEMM_PACKA_ROWS            12
+
+//
+// Define the number of columns from matrix B to convert to a local buffer
+// before packing. This matches the width of a packed panel column.
+//
+
+#define MLAS_HALFGEMM_PACKB_COLUMNS         16
+
+//
+// Define the parameters to execute segments of a half precision matrix/matrix
+// multiply operation on worker threads.
+//
+
+struct MLAS_HALFGEMM_WORK_BLOCK {
+    MLAS_HALF_TYPE Type;
+    CBLAS_TRANSPOSE TransA;
+    CBLAS_TRANSPOSE TransB;
+    size_t M;
+    size_t N;
+    size_t K;
+    float alpha;
+    const unsigned short* A;
+    size_t lda;
+    const unsigned short* B;
+    size_t ldb;
+    float beta;
+    float* C;
+    size_t ldc;
+    size_t StrideM;
+    size_t StrideN;
+};
+
+void
+MlasHalfGemmPackA(
+    MLAS_HALF_TYPE Type,
+    CBLAS_TRANSPOSE TransA,
+    float* D,
+    const unsigned short* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK
+    )
+/*++
+
+Routine Description:
+
+    This routine converts rows of matrix A to a local buffer of single
+    precision floats with CountK elements per row.
+
+Arguments:
+
+    Type - Supplies the format of the half precision values.
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    D - Supplies the address of the destination buffer.
+
+    A - Supplies the address of the first element to convert.
+
+    lda - Supplies the first dimension of matrix A.
+
+    CountM - Supplies the number of rows to convert.
+
+    CountK - Supplies the number of columns to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (TransA == CblasNoTrans) {
+
+        for (size_t m = 0; m < CountM; m++) {
+            MlasConvertHalfToFloat(Type, A + m * lda, D + m * CountK, CountK);
+        }
+
+    } else {
+
+        //
+        // Convert the columns of the transposed matrix and then transpose the
+        // converted block into place.
+        //
+
+        float Columns[MLAS_HALFGEMM_PACKA_ROWS * MLAS_SGEMM_STRIDEK];
+
+        for (size_t k = 0; k < CountK; k++) {
+            MlasConvertHalfToFloat(Type, A + k * lda, Columns + k * CountM, CountM);
+        }
+
+        MlasSgemmTransposeA(D, Columns, CountM, CountM, CountK);
+    }
+}
+
+void
+MlasHalfGemmPackB(
+    MLAS_HALF_TYPE Type,
+    CBLAS_TRANSPOSE TransB,
+    float* D,
+    const unsigned short* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a panel of matrix B to the packed buffer layout used
+    by the single precision kernels.
+
+    Slices of 16 columns are converted to a local buffer and then packed with
+    the SGEMM packing routines, so the packed layout is identical to the layout
+    produced for a single precision matrix.
+
+Arguments:
+
+    Type - Supplies the format of the half precision values.
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    D - Supplies the address of the destination packed buffer.
+
+    B - Supplies the address of the first element of the panel.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    CountN - Supplies the number of columns of the panel.
+
+    CountK - Supplies the number of rows of the panel.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    float Slice[MLAS_HALFGEMM_PACKB_COLUMNS * MLAS_SGEMM_STRIDEK];
+
+    for (size_t n = 0; n < CountN; n += MLAS_HALFGEMM_PACKB_COLUMNS) {
+
+        size_t CountX = CountN - n;
+
+        if (CountX > MLAS_HALFGEMM_PACKB_COLUMNS) {
+            CountX = MLAS_HALFGEMM_PACKB_COLUMNS;
+        }
+
+        if (TransB == CblasNoTrans) {
+
+            for (size_t k = 0; k < CountK; k++) {
+                MlasConvertHalfToFloat(Type, B + n + k * ldb,
+                    Slice + k * MLAS_HALFGEMM_PACKB_COLUMNS, CountX);
+            }
+
+            MlasSgemmCopyPackB(D, Slice, MLAS_HALFGEMM_PACKB_COLUMNS, CountX, CountK);
+
+        } else {
+
+            for (size_t x = 0; x < CountX; x++) {
+                MlasConvertHalfToFloat(Type, B + (n + x) * ldb, Slice + x * CountK, CountK);
+            }
+
+            MlasSgemmTransposePackB(D, Slice, CountK, CountX, CountK);
+        }
+
+        D += MLAS_HALFGEMM_PACKB_COLUMNS * CountK;
+    }
+}
+
+MLAS_FORCEINLINE
+size_t
+MlasHalfGemmKernel(
+    const float* A,
+    const float* B,
+    float* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    float alpha,
+    bool ZeroMode
+    )
+{
+#if defined(MLAS_TARGET_AMD64_IX86)
+    return MlasPlatform.GemmFloatKernel(A, B, C, CountK, CountM, CountN, lda, ldc, alpha, ZeroMode);
+#else
+    if (ZeroMode) {
+        return MlasSgemmKernelZero(A, B, C, CountK, CountM, CountN, lda, ldc, alpha);
+    } else {
+        return MlasSgemmKernelAdd(A, B, C, CountK, CountM, CountN, lda, ldc, alpha);
+    }
+#endif
+}
+
+void
+MlasHalfGemmOperation(
+    MLAS_HALF_TYPE Type,
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const unsigned short* A,
+    size_t lda,
+    const unsigned short* B,
+    size_t ldb,
+    float beta,
+    float* C,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the half precision matrix/matrix multiply
+    operation on a single thread.
+
+Arguments:
+
+    See MlasHalfGemm.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    float PanelA[MLAS_HALFGEMM_PACKA_ROWS * MLAS_SGEMM_STRIDEK];
+    MLAS_DECLSPEC_ALIGN(float PanelB[MLAS_SGEMM_STRIDEN * MLAS_SGEMM_STRIDEK], 16 * sizeof(float));
+
+    //
+    // Compute the strides to step through slices of the input matrices.
+    //
+    // Expand the N stride if K is small for better utilization of the B
+    // panel. Unlike the SGEMM operation, the K stride is never expanded
+    // because every row of matrix A is converted through the A panel.
+    //
+
+    uint32_t StrideN = MLAS_SGEMM_STRIDEN;
+    uint32_t StrideK = MLAS_SGEMM_STRIDEK;
+
+    while (StrideK / 2 >= K) {
+        StrideN *= 2;
+        StrideK /= 2;
+    }
+
+    //
+    // Step through each slice of matrix B along the N dimension.
+    //
+
+    size_t CountN;
+    size_t CountK;
+
+    for (size_t n = 0; n < N; n += CountN) {
+
+        CountN = StrideN;
+
+        if (CountN > (N - n)) {
+            CountN = N - n;
+        }
+
+        //
+        // Multiply the output matrix by beta as needed.
+        //
+
+        if (beta != 0.0f && beta != 1.0f) {
+            MlasSgemmMultiplyBeta(C + n, M, CountN, ldc, beta);
+        }
+
+        //
+        // Step through each slice of matrix B along the K dimension.
+        //
+
+        for (size_t k = 0; k < K; k += CountK) {
+
+            bool ZeroMode = (k == 0 && beta == 0.0f);
+
+            CountK = StrideK;
+
+            if (CountK > (K - k)) {
+                CountK = K - k;
+            }
+
+            const unsigned short* b = (TransB == CblasNoTrans) ? B + n + k * ldb : B + k + n * ldb;
+
+            MlasHalfGemmPackB(Type, TransB, PanelB, b, ldb, CountN, CountK);
+
+            //
+            // Step through each slice of matrix A along the M dimension.
+            //
+
+            float* c = C + n;
+
+            for (size_t m = 0; m < M; ) {
+
+                size_t RowsConverted = M - m;
+
+                if (RowsConverted > MLAS_HALFGEMM_PACKA_ROWS) {
+                    RowsConverted = MLAS_HALFGEMM_PACKA_ROWS;
+                }
+
+                const unsigned short* a = (TransA == CblasNoTrans) ? A + k + m * lda : A + m + k * lda;
+
+                MlasHalfGemmPackA(Type, TransA, PanelA, a, lda, RowsConverted, CountK);
+
+                m += RowsConverted;
+
+                //
+                // Step through the rows of the local buffer.
+                //
+
+                const float* pa = PanelA;
+
+                do {
+
+                    size_t RowsHandled = MlasHalfGemmKernel(pa, PanelB, c, CountK,
+                        RowsConverted, CountN, CountK, ldc, alpha, ZeroMode);
+
+                    c += ldc * RowsHandled;
+                    pa += CountK * RowsHandled;
+
+                    RowsConverted -= RowsHandled;
+
+                } while (RowsConverted > 0);
+            }
+        }
+    }
+}
+
+void
+MlasHalfGemmOperationThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    half precision matrix/matrix multiply operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (MLAS_HALFGEMM_WORK_BLOCK*)Context;
+
+    size_t TilesN = (WorkBlock->N + WorkBlock->StrideN - 1) / WorkBlock->StrideN;
+
+    size_t m = (size_t(Index) / TilesN) * WorkBlock->StrideM;
+    size_t n = (size_t(Index) % TilesN) * WorkBlock->StrideN;
+
+    size_t CountM = (std::min)(WorkBlock->StrideM, WorkBlock->M - m);
+    size_t CountN = (std::min)(WorkBlock->StrideN, WorkBlock->N - n);
+
+    size_t plda = (WorkBlock->TransA == CblasNoTrans) ? WorkBlock->lda : 1;
+    size_t pldb = (WorkBlock->TransB == CblasNoTrans) ? 1 : WorkBlock->ldb;
+
+    MlasHalfGemmOperation(WorkBlock->Type, WorkBlock->TransA, WorkBlock->TransB,
+        CountM, CountN, WorkBlock->K, WorkBlock->alpha, WorkBlock->A + m * plda,
+        WorkBlock->lda, WorkBlock->B + n * pldb, WorkBlock->ldb, WorkBlock->beta,
+        WorkBlock->C + m * WorkBlock->ldc + n, WorkBlock->ldc);
+}
+
+void
+MLASCALL
+MlasHalfGemm(
+    MLAS_HALF_TYPE Type,
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const unsigned short* A,
+    size_t lda,
+    const unsigned short* B,
+    size_t ldb,
+    float beta,
+    float* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the half precision matrix/matrix multiply
+    operation. The A and B matrices hold half precision values while the C
+    matrix holds single precision values.
+
+Arguments:
+
+    Type - Supplies the format of the half precision values.
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    alpha - Supplies the scalar alpha multiplier (see SGEMM definition).
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    beta - Supplies the scalar beta multiplier (see SGEMM definition).
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (M == 0 || N == 0) {
+        return;
+    }
+
+    //
+    // Handle the degenerate case of an empty inner dimension, where the
+    // product is zero and the output is only scaled by beta.
+    //
+
+    if (K == 0) {
+
+        if (beta == 0.0f) {
+            for (size_t m = 0; m < M; m++) {
+                std::fill_n(C + m * ldc, N, 0.0f);
+            }
+        } else if (beta != 1.0f) {
+            MlasSgemmMultiplyBeta(C, M, N, ldc, beta);
+        }
+
+        return;
+    }
+
+    //
+    // Compute the number of target threads given the complexity of the
+    // operation. Small requests should run using the single threaded path.
+    //
+
+    double Complexity = double(M) * double(N) * double(K);
+
+    int32_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+        TargetThreadCount = int32_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    int32_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    if (TargetThreadCount == 1) {
+        MlasHalfGemmOperation(Type, TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
+        return;
+    }
+
+    //
+    // Segment the operation along the larger of the M and N dimensions.
+    //
+
+    MLAS_HALFGEMM_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Type = Type;
+    WorkBlock.TransA = TransA;
+    WorkBlock.TransB = TransB;
+    WorkBlock.M = M;
+    WorkBlock.N = N;
+    WorkBlock.K = K;
+    WorkBlock.alpha = alpha;
+    WorkBlock.A = A;
+    WorkBlock.lda = lda;
+    WorkBlock.B = B;
+    WorkBlock.ldb = ldb;
+    WorkBlock.beta = beta;
+    WorkBlock.C = C;
+    WorkBlock.ldc = ldc;
+
+    size_t ThreadCount;
+
+    if (N > M) {
+
+        size_t StrideN = (N + TargetThreadCount - 1) / TargetThreadCount;
+
+        StrideN =
+            (StrideN + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+        WorkBlock.StrideM = M;
+        WorkBlock.StrideN = StrideN;
+
+        ThreadCount = (N + StrideN - 1) / StrideN;
+
+    } else {
+
+        size_t StrideM = (M + TargetThreadCount - 1) / TargetThreadCount;
+
+        WorkBlock.StrideM = StrideM;
+        WorkBlock.StrideN = N;
+
+        ThreadCount = (M + StrideM - 1) / StrideM;
+    }
+
+    MlasExecuteThreaded(MlasHalfGemmOperationThreaded, &WorkBlock, int32_t(ThreadCount), ThreadPool);
+}
@@ -0,0 +1,298 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm.cpp
+
+Abstract:
+
+    This module implements routines to compute layer normalization.
+
+    The row statistics are computed in a single pass that also forms the row
+    from the input, skip and bias buffers, and a second pass normalizes, scales
+    and shifts the row. The implementation below targets the base instruction
+    set while assembly implementations target newer instruction sets (such as
+    FMA3 and AVX512F).
+
+--*/
+
+#include "mlasi.h"
+
+#include <cmath>
+
+void
+MLASCALL
+MlasLayerNormStatisticsKernel(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    float* Output,
+    size_t N,
+    float* Statistics
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel to compute the sum and the sum
+    of squares of a row of elements.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Skip - Optionally supplies a buffer that is added to the input buffer. If
+        this is not NULL, the sum of the buffers is stored to the output
+        buffer.
+
+    Bias - Optionally supplies a buffer that is added to the input buffer. This
+        is only used if Skip is not NULL.
+
+    Output - Supplies the output buffer that receives the sum of the input,
+        skip and bias buffers if Skip is not NULL.
+
+    N - Supplies the number of elements to process.
+
+    Statistics - Supplies a two element buffer that receives the sum and the
+        sum of squares of the elements.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_FLOAT32X4 SumVector = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 SumSquaresVector = MlasZeroFloat32x4();
+
+    while (N >= 4) {
+
+        MLAS_FLOAT32X4 Vector = MlasLoadFloat32x4(Input);
+
+        if (Skip != nullptr) {
+
+            Vector = MlasAddFloat32x4(Vector, MlasLoadFloat32x4(Skip));
+
+            if (Bias != nullptr) {
+                Vector = MlasAddFloat32x4(Vector, MlasLoadFloat32x4(Bias));
+                Bias += 4;
+            }
+
+            MlasStoreFloat32x4(Output, Vector);
+
+            Skip += 4;
+            Output += 4;
+        }
+
+        SumVector = MlasAddFloat32x4(SumVector, Vector);
+        SumSquaresVector = MlasMultiplyAddFloat32x4(Vector, Vector, SumSquaresVector);
+
+        Input += 4;
+        N -= 4;
+    }
+
+    float SumBuffer[4];
+    float SumSquaresBuffer[4];
+
+    MlasStoreFloat32x4(SumBuffer, SumVector);
+    MlasStoreFloat32x4(SumSquaresBuffer, SumSquaresVector);
+
+    float Sum = (SumBuffer[0] + SumBuffer[1]) + (SumBuffer[2] + SumBuffer[3]);
+    float SumSquares = (SumSquaresBuffer[0] + SumSquaresBuffer[1]) +
+        (SumSquaresBuffer[2] + SumSquaresBuffer[3]);
+
+    while (N > 0) {
+
+        float Value = *Input++;
+
+        if (Skip != nullptr) {
+
+            Value += *Skip++;
+
+            if (Bias != nullptr) {
+                Value += *Bias++;
+            }
+
+            *Output++ = Value;
+        }
+
+        Sum += Value;
+        SumSquares += Value * Value;
+
+        N -= 1;
+    }
+
+    Statistics[0] = Sum;
+    Statistics[1] = SumSquares;
+}
+
+void
+MLASCALL
+MlasLayerNormScaleKernel(
+    const float* Input,
+    float* Output,
+    size_t N,
+    const float* Gamma,
+    const float* Beta,
+    const float* Statistics
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel to normalize, scale and shift a
+    row of elements.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer. This may be the same as the input
+        buffer.
+
+    N - Supplies the number of elements to process.
+
+    Gamma - Supplies the per element scale buffer.
+
+    Beta - Supplies the per element shift buffer.
+
+    Statistics - Supplies a two element buffer with the mean and the inverse
+        standard deviation of the row.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const float Mean = Statistics[0];
+    const float InvStdDev = Statistics[1];
+
+    MLAS_FLOAT32X4 MeanVector = MlasBroadcastFloat32x4(Mean);
+    MLAS_FLOAT32X4 InvStdDevVector = MlasBroadcastFloat32x4(InvStdDev);
+
+    while (N >= 4) {
+
+        MLAS_FLOAT32X4 Vector = MlasLoadFloat32x4(Input);
+
+        Vector = MlasMultiplyFloat32x4(MlasSubtractFloat32x4(Vector, MeanVector), InvStdDevVector);
+        Vector = MlasMultiplyAddFloat32x4(Vector, MlasLoadFloat32x4(Gamma), MlasLoadFloat32x4(Beta));
+
+        MlasStoreFloat32x4(Output, Vector);
+
+        Input += 4;
+        Output += 4;
+        Gamma += 4;
+        Beta += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        *Output++ = (*Input++ - Mean) * InvStdDev * *Gamma++ + *Beta++;
+
+        N -= 1;
+    }
+}
+
+void
+MLASCALL
+MlasComputeLayerNorm(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Gamma,
+    const float* Beta,
+    float* Output,
+    size_t N,
+    float Epsilon,
+    float* Mean,
+    float* InvStdDev
+    )
+/*++
+
+Routine Description:
+
+    This routine computes layer normalization of a row of elements.
+
+    If Skip is not NULL, the row is formed as the sum of the input, skip and
+    optional bias buffers (as for skip layer normalization). The row is then
+    normalized to zero mean and unit variance, multiplied by Gamma and shifted
+    by Beta.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Skip - Optionally supplies a buffer that is added to the input buffer.
+
+    Bias - Optionally supplies a buffer that is added to the input buffer. This
+        is only used if Skip is not NULL.
+
+    Gamma - Supplies the per element scale buffer.
+
+    Beta - Supplies the per element shift buffer.
+
+    Output - Supplies the output buffer. This may be the same as the input
+        buffer.
+
+    N - Supplies the number of elements to process.
+
+    Epsilon - Supplies the value added to the variance to avoid division by
+        zero.
+
+    Mean - Optionally supplies the address that receives the mean of the row.
+
+    InvStdDev - Optionally supplies the address that receives the inverse
+        standard deviation of the row.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    float Statistics[2];
+
+    //
+    // Compute the sum and the sum of squares of the row. If a skip buffer is
+    // supplied, the row is formed in the output buffer.
+    //
+
+#if defined(MLAS_TARGET_AMD64)
+    MlasPlatform.LayerNormStatisticsKernelRoutine(Input, Skip, Bias, Output, N, Statistics);
+#else
+    MlasLayerNormStatisticsKernel(Input, Skip, Bias, Output, N, Statistics);
+#endif
+
+    float RowMean = Statistics[0] / float(N);
+    float Variance = Statistics[1] / float(N) - RowMean * RowMean;
+    float RowInvStdDev = 1.0f / std::sqrt((std::max)(Variance, 0.0f) + Epsilon);
+
+    if (Mean != nullptr) {
+        *Mean = RowMean;
+    }
+
+    if (InvStdDev != nullptr) {
+        *InvStdDev = RowInvStdDev;
+    }
+
+    //
+    // Normalize, scale and shift the row.
+    //
+
+    Statistics[0] = RowMean;
+    Statistics[1] = RowInvStdDev;
+
+    const float* Row = (Skip != nullptr) ? Output : Input;
+
+#if defined(MLAS_TARGET_AMD64)
+    MlasPlatform.LayerNormScaleKernelRoutine(Row, Output, N, Gamma, Beta, Statistics);
+#else
+    MlasLayerNormScaleKernel(Row, Output, N, Gamma, Beta, Statistics);
+#endif
+}
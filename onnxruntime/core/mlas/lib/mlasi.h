@@ -451,6 +451,52 @@ void
 
 typedef MLAS_ELEMENTWISE_KERNEL_ROUTINE* PMLAS_ELEMENTWISE_KERNEL_ROUTINE;
 
+typedef
+void
+(MLASCALL MLAS_CONVERT_HALF_TO_FLOAT_KERNEL)(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    );
+
+typedef MLAS_CONVERT_HALF_TO_FLOAT_KERNEL* PMLAS_CONVERT_HALF_TO_FLOAT_KERNEL;
+
+typedef
+void
+(MLASCALL MLAS_CONVERT_FLOAT_TO_HALF_KERNEL)(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    );
+
+typedef MLAS_CONVERT_FLOAT_TO_HALF_KERNEL* PMLAS_CONVERT_FLOAT_TO_HALF_KERNEL;
+
+typedef
+void
+(MLASCALL MLAS_LAYERNORM_STATISTICS_KERNEL)(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    float* Output,
+    size_t N,
+    float* Statistics
+    );
+
+typedef MLAS_LAYERNORM_STATISTICS_KERNEL* PMLAS_LAYERNORM_STATISTICS_KERNEL;
+
+typedef
+void
+(MLASCALL MLAS_LAYERNORM_SCALE_KERNEL)(
+    const float* Input,
+    float* Output,
+    size_t N,
+    const float* Gamma,
+    const float* Beta,
+    const float* Statistics
+    );
+
+typedef MLAS_LAYERNORM_SCALE_KERNEL* PMLAS_LAYERNORM_SCALE_KERNEL;
+
 extern "C" {
 
 #if defined(MLAS_TARGET_AMD64_IX86)
@@ -550,6 +596,22 @@ extern "C" {
     MLAS_ELEMENTWISE_KERNEL_ROUTINE MlasErfKernelFma3;
 #endif
 
+    MLAS_LAYERNORM_STATISTICS_KERNEL MlasLayerNormStatisticsKernel;
+    MLAS_LAYERNORM_SCALE_KERNEL MlasLayerNormScaleKernel;
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_LAYERNORM_STATISTICS_KERNEL MlasLayerNormStatisticsKernelFma3;
+    MLAS_LAYERNORM_SCALE_KERNEL MlasLayerNormScaleKernelFma3;
+    MLAS_LAYERNORM_STATISTICS_KERNEL MlasLayerNormStatisticsKernelAvx512F;
+    MLAS_LAYERNORM_SCALE_KERNEL MlasLayerNormScaleKernelAvx512F;
+#endif
+
+    MLAS_CONVERT_HALF_TO_FLOAT_KERNEL MlasConvertHalfToFloatKernel;
+    MLAS_CONVERT_FLOAT_TO_HALF_KERNEL MlasConvertFloatToHalfKernel;
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_CONVERT_HALF_TO_FLOAT_KERNEL MlasConvertHalfToFloatKernelF16C;
+    MLAS_CONVERT_FLOAT_TO_HALF_KERNEL MlasConvertFloatToHalfKernelF16C;
+#endif
+
 }
 
 //
@@ -599,6 +661,47 @@ MlasSgemmOperation(
     size_t ldc
     );
 
+//
+// Single precision matrix/matrix multiply helpers shared with the half
+// precision matrix/matrix multiply operation.
+//
+
+void
+MlasSgemmMultiplyBeta(
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    float beta
+    );
+
+void
+MlasSgemmTransposeA(
+    float* D,
+    const float* A,
+    size_t lda,
+    size_t CountY,
+    size_t CountX
+    );
+
+void
+MlasSgemmCopyPackB(
+    float* D,
+    const float* B,
+    size_t ldb,
+    size_t CountX,
+    size_t CountY
+    );
+
+void
+MlasSgemmTransposePackB(
+    float* D,
+    const float* B,
+    size_t ldb,
+    size_t CountY,
+    size_t CountX
+    );
+
 //
 // Environment information class.
 //
@@ -631,6 +734,10 @@ struct MLAS_PLATFORM {
     PMLAS_ELEMENTWISE_KERNEL_ROUTINE LogisticKernelRoutine;
     PMLAS_ELEMENTWISE_KERNEL_ROUTINE TanhKernelRoutine;
     PMLAS_ELEMENTWISE_KERNEL_ROUTINE ErfKernelRoutine;
+    PMLAS_LAYERNORM_STATISTICS_KERNEL LayerNormStatisticsKernelRoutine;
+    PMLAS_LAYERNORM_SCALE_KERNEL LayerNormScaleKernelRoutine;
+    PMLAS_CONVERT_HALF_TO_FLOAT_KERNEL ConvertHalfToFloatKernelRoutine;
+    PMLAS_CONVERT_FLOAT_TO_HALF_KERNEL ConvertFloatToHalfKernelRoutine;
     uint32_t NchwcBlockSize;
     uint32_t PreferredBufferAlignment;
 #endif
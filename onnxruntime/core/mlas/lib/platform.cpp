@@ -16,6 +16,8 @@ Abstract:
 --*/
 
 #include "mlasi.h"
+#include <ctype.h>
+#include <string.h>
 
 //
 // Stores the platform information.
@@ -68,6 +70,87 @@ MlasReadExtendedControlRegister(
 #endif
 }
 
+//
+// Defines the instruction set levels that the MLAS_MAXIMUM_ISA environment
+// variable can use to cap the kernels selected below. This allows the slower
+// code paths to be benchmarked and tested on processors that support newer
+// instruction sets.
+//
+
+enum MLAS_ISA_LEVEL {
+    MlasIsaLevelSse2,
+    MlasIsaLevelAvx,
+    MlasIsaLevelAvx2,
+    MlasIsaLevelAvx512F,
+    MlasIsaLevelAvx512BW,
+    MlasIsaLevelAvx512Vnni,
+};
+
+MLAS_ISA_LEVEL
+MlasReadMaximumIsaLevel(
+    void
+    )
+/*++
+
+Routine Description:
+
+    This routine reads the MLAS_MAXIMUM_ISA environment variable to determine
+    the highest instruction set level that the platform may select.
+
+Arguments:
+
+    None.
+
+Return Value:
+
+    Returns the maximum instruction set level. If the environment variable is
+    not set or is not recognized, then no limit is applied.
+
+--*/
+{
+    static const struct {
+        const char* Name;
+        MLAS_ISA_LEVEL Level;
+    } IsaNames[] = {
+        { "sse2", MlasIsaLevelSse2 },
+        { "avx", MlasIsaLevelAvx },
+        { "avx2", MlasIsaLevelAvx2 },
+        { "avx512f", MlasIsaLevelAvx512F },
+        { "avx512bw", MlasIsaLevelAvx512BW },
+        { "avx512vnni", MlasIsaLevelAvx512Vnni },
+    };
+
+    char Value[32];
+
+#if defined(_WIN32)
+    DWORD Length = GetEnvironmentVariableA("MLAS_MAXIMUM_ISA", Value, sizeof(Value));
+
+    if (Length == 0 || Length >= sizeof(Value)) {
+        return MlasIsaLevelAvx512Vnni;
+    }
+#else
+    const char* EnvironmentValue = getenv("MLAS_MAXIMUM_ISA");
+
+    if (EnvironmentValue == nullptr || strlen(EnvironmentValue) >= sizeof(Value)) {
+        return MlasIsaLevelAvx512Vnni;
+    }
+
+    strcpy(Value, EnvironmentValue);
+#endif
+
+    for (char* p = Value; *p != '\0'; p++) {
+        *p = char(tolower(static_cast<unsigned char>(*p)));
+    }
+
+    for (const auto& IsaName : IsaNames) {
+        if (strcmp(Value, IsaName.Name) == 0) {
+            return IsaName.Level;
+        }
+    }
+
+    return MlasIsaLevelAvx512Vnni;
+}
+
 #endif
 
 MLAS_PLATFORM::MLAS_PLATFORM(
@@ -118,6 +201,10 @@ Return Value:
     this->LogisticKernelRoutine = MlasLogisticKernel;
     this->TanhKernelRoutine = MlasTanhKernel;
     this->ErfKernelRoutine = MlasErfKernel;
+    this->LayerNormStatisticsKernelRoutine = MlasLayerNormStatisticsKernel;
+    this->LayerNormScaleKernelRoutine = MlasLayerNormScaleKernel;
+    this->ConvertHalfToFloatKernelRoutine = MlasConvertHalfToFloatKernel;
+    this->ConvertFloatToHalfKernelRoutine = MlasConvertFloatToHalfKernel;
     this->NchwcBlockSize = 8;
     this->PreferredBufferAlignment = MLAS_DEFAULT_PREFERRED_BUFFER_ALIGNMENT;
 
@@ -134,7 +221,13 @@ Return Value:
     __cpuid(1, Cpuid1[0], Cpuid1[1], Cpuid1[2], Cpuid1[3]);
 #endif
 
-    if ((Cpuid1[2] & 0x18000000) == 0x18000000) {
+    //
+    // Read the optional limit on the instruction set level used below.
+    //
+
+    const MLAS_ISA_LEVEL MaximumIsaLevel = MlasReadMaximumIsaLevel();
+
+    if ((Cpuid1[2] & 0x18000000) == 0x18000000 && MaximumIsaLevel >= MlasIsaLevelAvx) {
 
         //
         // Check if the operating system supports saving SSE and AVX states.
@@ -160,6 +253,16 @@ Return Value:
             this->PoolFloatKernel[MlasAveragePoolingExcludePad] = MlasPoolAverageExcludePadFloatKernelAvx;
             this->PoolFloatKernel[MlasAveragePoolingIncludePad] = MlasPoolAverageIncludePadFloatKernelAvx;
 
+            //
+            // Check if the processor supports the F16C feature.
+            //
+
+            if ((Cpuid1[2] & 0x20000000) != 0) {
+
+                this->ConvertHalfToFloatKernelRoutine = MlasConvertHalfToFloatKernelF16C;
+                this->ConvertFloatToHalfKernelRoutine = MlasConvertFloatToHalfKernelF16C;
+            }
+
             //
             // Check if the processor supports AVX2/FMA3 features.
             //
@@ -171,7 +274,8 @@ Return Value:
             __cpuid_count(7, 0, Cpuid7[0], Cpuid7[1], Cpuid7[2], Cpuid7[3]);
 #endif
 
-            if (((Cpuid1[2] & 0x1000) != 0) && ((Cpuid7[1] & 0x20) != 0)) {
+            if (((Cpuid1[2] & 0x1000) != 0) && ((Cpuid7[1] & 0x20) != 0) &&
+                MaximumIsaLevel >= MlasIsaLevelAvx2) {
 
                 this->GemmU8S8CopyPackARoutine = MlasGemmU8S8CopyPackAAvx2;
                 this->GemmU8S8CopyPackBRoutine = MlasGemmU8S8CopyPackBAvx2;
@@ -190,6 +294,8 @@ Return Value:
                 this->LogisticKernelRoutine = MlasLogisticKernelFma3;
                 this->TanhKernelRoutine = MlasTanhKernelFma3;
                 this->ErfKernelRoutine = MlasErfKernelFma3;
+                this->LayerNormStatisticsKernelRoutine = MlasLayerNormStatisticsKernelFma3;
+                this->LayerNormScaleKernelRoutine = MlasLayerNormScaleKernelFma3;
 
 #if !defined(MLAS_AVX512F_UNSUPPORTED)
 
@@ -198,7 +304,8 @@ Return Value:
                 // operating system supports saving AVX512F state.
                 //
 
-                if (((Cpuid7[1] & 0x10000) != 0) && ((xcr0 & 0xE0) == 0xE0)) {
+                if (((Cpuid7[1] & 0x10000) != 0) && ((xcr0 & 0xE0) == 0xE0) &&
+                    MaximumIsaLevel >= MlasIsaLevelAvx512F) {
 
                     this->GemmFloatKernel = MlasGemmFloatKernelAvx512F;
                     this->GemmDoubleKernel = MlasGemmDoubleKernelAvx512F;
@@ -209,6 +316,8 @@ Return Value:
                     this->PoolFloatKernel[MlasMaximumPooling] = MlasPoolMaximumFloatKernelAvx512F;
                     this->PoolFloatKernel[MlasAveragePoolingExcludePad] = MlasPoolAverageExcludePadFloatKernelAvx512F;
                     this->PoolFloatKernel[MlasAveragePoolingIncludePad] = MlasPoolAverageIncludePadFloatKernelAvx512F;
+                    this->LayerNormStatisticsKernelRoutine = MlasLayerNormStatisticsKernelAvx512F;
+                    this->LayerNormScaleKernelRoutine = MlasLayerNormScaleKernelAvx512F;
                     this->NchwcBlockSize = 16;
                     this->PreferredBufferAlignment = 64;
                     //
@@ -216,7 +325,7 @@ Return Value:
                     //
 #if !defined(MLAS_AVX512BW_UNSUPPORTED)
 
-                    if ((Cpuid7[1] & 0x40000000) != 0) {
+                    if ((Cpuid7[1] & 0x40000000) != 0 && MaximumIsaLevel >= MlasIsaLevelAvx512BW) {
 
                         this->GemmU8S8Kernel = MlasGemmU8S8KernelAvx512BW;
                         this->GemvU8S8Kernel = MlasGemvU8S8KernelAvx512BW;
@@ -226,7 +335,7 @@ Return Value:
                         // Check if the processor supports AVX512VNNI.
                         //
 
-                        if ((Cpuid7[2] & 0x800) != 0) {
+                        if ((Cpuid7[2] & 0x800) != 0 && MaximumIsaLevel >= MlasIsaLevelAvx512Vnni) {
 
                             this->GemmU8S8Kernel = MlasGemmU8S8KernelAvx512Vnni;
                             this->GemvU8S8Kernel = MlasGemvU8S8KernelAvx512Vnni;
@@ -49,6 +49,35 @@ struct MLAS_SGEMM_WORK_BLOCK {
     } Segments[MLAS_MAXIMUM_THREAD_COUNT];
 };
 
+//
+// Define the parameters to execute a batched SGEMM operation on worker
+// threads. The batch entries are supplied either as an array of data
+// parameters or as base pointers with a fixed stride between entries. Each
+// batch entry is split into TilesM by TilesN output tiles and the resulting
+// work items are distributed evenly over the threads.
+//
+
+struct MLAS_SGEMM_BATCH_WORK_BLOCK {
+    int32_t ThreadCount;
+    CBLAS_TRANSPOSE TransA;
+    CBLAS_TRANSPOSE TransB;
+    size_t M;
+    size_t N;
+    size_t K;
+    float alpha;
+    float beta;
+    const MLAS_SGEMM_DATA_PARAMS* Data;
+    MLAS_SGEMM_DATA_PARAMS Strided;
+    size_t StrideA;
+    size_t StrideB;
+    size_t StrideC;
+    size_t BatchSize;
+    size_t StrideM;
+    size_t StrideN;
+    size_t TilesM;
+    size_t TilesN;
+};
+
 void
 MlasSgemmMultiplyBeta(
     float* C,
@@ -1318,3 +1347,353 @@ Return Value:
         MlasSgemmOperation(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
     }
 }
+
+void
+MlasSgemmBatchOperationThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    batched SGEMM operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_SGEMM_BATCH_WORK_BLOCK* WorkBlock = (MLAS_SGEMM_BATCH_WORK_BLOCK*)Context;
+
+    const size_t TilesPerBatch = WorkBlock->TilesM * WorkBlock->TilesN;
+
+    size_t WorkIndex;
+    size_t WorkRemaining;
+
+    MlasPartitionWork(Index, WorkBlock->ThreadCount, WorkBlock->BatchSize * TilesPerBatch,
+        &WorkIndex, &WorkRemaining);
+
+    while (WorkRemaining > 0) {
+
+        const size_t BatchIndex = WorkIndex / TilesPerBatch;
+        const size_t TileIndex = WorkIndex % TilesPerBatch;
+
+        MLAS_SGEMM_DATA_PARAMS Params;
+
+        if (WorkBlock->Data != nullptr) {
+            Params = WorkBlock->Data[BatchIndex];
+        } else {
+            Params = WorkBlock->Strided;
+            Params.A += BatchIndex * WorkBlock->StrideA;
+            Params.B += BatchIndex * WorkBlock->StrideB;
+            Params.C += BatchIndex * WorkBlock->StrideC;
+        }
+
+        //
+        // Compute the output tile of this batch entry.
+        //
+
+        const size_t m = (TileIndex / WorkBlock->TilesN) * WorkBlock->StrideM;
+        const size_t n = (TileIndex % WorkBlock->TilesN) * WorkBlock->StrideN;
+
+        size_t CountM = WorkBlock->M - m;
+
+        if (CountM > WorkBlock->StrideM) {
+            CountM = WorkBlock->StrideM;
+        }
+
+        size_t CountN = WorkBlock->N - n;
+
+        if (CountN > WorkBlock->StrideN) {
+            CountN = WorkBlock->StrideN;
+        }
+
+        const size_t plda = (WorkBlock->TransA == CblasNoTrans) ? Params.lda : 1;
+        const size_t pldb = (WorkBlock->TransB == CblasNoTrans) ? 1 : Params.ldb;
+
+        MlasSgemmOperation(WorkBlock->TransA, WorkBlock->TransB, CountM, CountN,
+            WorkBlock->K, WorkBlock->alpha, Params.A + m * plda, Params.lda,
+            Params.B + n * pldb, Params.ldb, WorkBlock->beta,
+            Params.C + m * Params.ldc + n, Params.ldc);
+
+        WorkIndex++;
+        WorkRemaining--;
+    }
+}
+
+void
+MlasSgemmBatchSchedule(
+    MLAS_SGEMM_BATCH_WORK_BLOCK* WorkBlock,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine partitions a batched SGEMM operation into work items and
+    executes them across the available threads.
+
+    The thread count is derived from the complexity of the whole batch. When
+    the batch has fewer entries than threads, each batch entry is additionally
+    split into tiles along the larger of the M and N dimensions so that all
+    threads have work. Otherwise each thread handles a contiguous range of
+    whole batch entries.
+
+Arguments:
+
+    WorkBlock - Supplies the work block with the common fields initialized.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t M = WorkBlock->M;
+    const size_t N = WorkBlock->N;
+    const size_t BatchSize = WorkBlock->BatchSize;
+
+    //
+    // Compute the number of target threads given the complexity of the whole
+    // batch. Small requests should run using the single threaded path.
+    //
+
+    double Complexity = double(M) * double(N) * double(WorkBlock->K) * double(BatchSize);
+
+    int32_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+    int32_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY) * double(MaximumThreadCount)) {
+        TargetThreadCount = int32_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    WorkBlock->StrideM = M;
+    WorkBlock->StrideN = N;
+    WorkBlock->TilesM = 1;
+    WorkBlock->TilesN = 1;
+
+    if (size_t(TargetThreadCount) > BatchSize) {
+
+        size_t TilesPerBatch = (size_t(TargetThreadCount) + BatchSize - 1) / BatchSize;
+
+        if (N > M) {
+
+            size_t StrideN = (N + TilesPerBatch - 1) / TilesPerBatch;
+
+            StrideN =
+                (StrideN + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+            WorkBlock->StrideN = StrideN;
+            WorkBlock->TilesN = (N + StrideN - 1) / StrideN;
+
+        } else {
+
+            size_t StrideM = (M + TilesPerBatch - 1) / TilesPerBatch;
+
+            WorkBlock->StrideM = StrideM;
+            WorkBlock->TilesM = (M + StrideM - 1) / StrideM;
+        }
+    }
+
+    size_t TotalWork = BatchSize * WorkBlock->TilesM * WorkBlock->TilesN;
+
+    if (size_t(TargetThreadCount) > TotalWork) {
+        TargetThreadCount = int32_t(TotalWork);
+    }
+
+    WorkBlock->ThreadCount = TargetThreadCount;
+
+    MlasExecuteThreaded(MlasSgemmBatchOperationThreaded, WorkBlock, TargetThreadCount, ThreadPool);
+}
+
+void
+MLASCALL
+MlasGemmBatch(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const MLAS_SGEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    float beta,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements a batch of single precision matrix/matrix multiply
+    operations (SGEMM) that share the same dimensions. The batch entries and
+    tiles of the output matrices are scheduled across the threads together.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for each matrix A.
+
+    TransB - Supplies the transpose operation for each matrix B.
+
+    M - Supplies the number of rows of each matrix A and matrix C.
+
+    N - Supplies the number of columns of each matrix B and matrix C.
+
+    K - Supplies the number of columns of each matrix A and the number of
+        rows of each matrix B.
+
+    alpha - Supplies the scalar alpha multiplier (see SGEMM definition).
+
+    Data - Supplies an array of BatchSize structures that describe the
+        matrices of each batch entry.
+
+    BatchSize - Supplies the number of batch entries.
+
+    beta - Supplies the scalar beta multiplier (see SGEMM definition).
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (BatchSize == 0 || M == 0 || N == 0) {
+        return;
+    }
+
+    MLAS_SGEMM_BATCH_WORK_BLOCK WorkBlock;
+
+    WorkBlock.TransA = TransA;
+    WorkBlock.TransB = TransB;
+    WorkBlock.M = M;
+    WorkBlock.N = N;
+    WorkBlock.K = K;
+    WorkBlock.alpha = alpha;
+    WorkBlock.beta = beta;
+    WorkBlock.Data = Data;
+    WorkBlock.BatchSize = BatchSize;
+
+    MlasSgemmBatchSchedule(&WorkBlock, ThreadPool);
+}
+
+void
+MLASCALL
+MlasGemmBatch(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    size_t StrideA,
+    const float* B,
+    size_t ldb,
+    size_t StrideB,
+    float beta,
+    float* C,
+    size_t ldc,
+    size_t StrideC,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements a batch of single precision matrix/matrix multiply
+    operations (SGEMM) where the matrices of consecutive batch entries are
+    separated by a fixed number of elements.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for each matrix A.
+
+    TransB - Supplies the transpose operation for each matrix B.
+
+    M - Supplies the number of rows of each matrix A and matrix C.
+
+    N - Supplies the number of columns of each matrix B and matrix C.
+
+    K - Supplies the number of columns of each matrix A and the number of
+        rows of each matrix B.
+
+    alpha - Supplies the scalar alpha multiplier (see SGEMM definition).
+
+    A - Supplies the address of the first matrix A.
+
+    lda - Supplies the first dimension of each matrix A.
+
+    StrideA - Supplies the number of elements between consecutive matrices A.
+        A stride of zero broadcasts the same matrix to every batch entry.
+
+    B - Supplies the address of the first matrix B.
+
+    ldb - Supplies the first dimension of each matrix B.
+
+    StrideB - Supplies the number of elements between consecutive matrices B.
+        A stride of zero broadcasts the same matrix to every batch entry.
+
+    beta - Supplies the scalar beta multiplier (see SGEMM definition).
+
+    C - Supplies the address of the first matrix C.
+
+    ldc - Supplies the first dimension of each matrix C.
+
+    StrideC - Supplies the number of elements between consecutive matrices C.
+
+    BatchSize - Supplies the number of batch entries.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (BatchSize == 0 || M == 0 || N == 0) {
+        return;
+    }
+
+    MLAS_SGEMM_BATCH_WORK_BLOCK WorkBlock;
+
+    WorkBlock.TransA = TransA;
+    WorkBlock.TransB = TransB;
+    WorkBlock.M = M;
+    WorkBlock.N = N;
+    WorkBlock.K = K;
+    WorkBlock.alpha = alpha;
+    WorkBlock.beta = beta;
+    WorkBlock.Data = nullptr;
+    WorkBlock.Strided.A = A;
+    WorkBlock.Strided.lda = lda;
+    WorkBlock.Strided.B = B;
+    WorkBlock.Strided.ldb = ldb;
+    WorkBlock.Strided.C = C;
+    WorkBlock.Strided.ldc = ldc;
+    WorkBlock.StrideA = StrideA;
+    WorkBlock.StrideB = StrideB;
+    WorkBlock.StrideC = StrideC;
+    WorkBlock.BatchSize = BatchSize;
+
+    MlasSgemmBatchSchedule(&WorkBlock, ThreadPool);
+}
@@ -0,0 +1,381 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    transpose.cpp
+
+Abstract:
+
+    This module implements routines to transpose a matrix of 8-bit, 16-bit,
+    32-bit or 64-bit elements.
+
+    The matrix is processed as square blocks that are transposed in vector
+    registers. Elements outside of the blocks are transposed one at a time.
+    Callers are expected to tile large matrices so that a tile of the source
+    and destination stays resident in the L1 cache.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the kernels that transpose a square block of elements in vector
+// registers. The generic kernel transposes single elements.
+//
+
+template<typename ElementType>
+struct MLAS_TRANSPOSE_KERNEL
+{
+    static constexpr size_t BlockSize = 1;
+
+    static
+    MLAS_FORCEINLINE
+    void
+    TransposeBlock(
+        const ElementType* Input,
+        size_t ldInput,
+        ElementType* Output,
+        size_t ldOutput
+        )
+    {
+        MLAS_UNREFERENCED_PARAMETER(ldInput);
+        MLAS_UNREFERENCED_PARAMETER(ldOutput);
+
+        *Output = *Input;
+    }
+};
+
+#if defined(MLAS_SSE2_INTRINSICS)
+
+template<>
+struct MLAS_TRANSPOSE_KERNEL<uint8_t>
+{
+    static constexpr size_t BlockSize = 8;
+
+    static
+    MLAS_FORCEINLINE
+    void
+    TransposeBlock(
+        const uint8_t* Input,
+        size_t ldInput,
+        uint8_t* Output,
+        size_t ldOutput
+        )
+    {
+        __m128i a0 = _mm_loadl_epi64((const __m128i*)&Input[ldInput * 0]);
+        __m128i a1 = _mm_loadl_epi64((const __m128i*)&Input[ldInput * 1]);
+        __m128i a2 = _mm_loadl_epi64((const __m128i*)&Input[ldInput * 2]);
+        __m128i a3 = _mm_loadl_epi64((const __m128i*)&Input[ldInput * 3]);
+        __m128i a4 = _mm_loadl_epi64((const __m128i*)&Input[ldInput * 4]);
+        __m128i a5 = _mm_loadl_epi64((const __m128i*)&Input[ldInput * 5]);
+        __m128i a6 = _mm_loadl_epi64((const __m128i*)&Input[ldInput * 6]);
+        __m128i a7 = _mm_loadl_epi64((const __m128i*)&Input[ldInput * 7]);
+
+        __m128i b0 = _mm_unpacklo_epi8(a0, a1);
+        __m128i b1 = _mm_unpacklo_epi8(a2, a3);
+        __m128i b2 = _mm_unpacklo_epi8(a4, a5);
+        __m128i b3 = _mm_unpacklo_epi8(a6, a7);
+
+        __m128i c0 = _mm_unpacklo_epi16(b0, b1);
+        __m128i c1 = _mm_unpackhi_epi16(b0, b1);
+        __m128i c2 = _mm_unpacklo_epi16(b2, b3);
+        __m128i c3 = _mm_unpackhi_epi16(b2, b3);
+
+        __m128i d0 = _mm_unpacklo_epi32(c0, c2);
+        __m128i d1 = _mm_unpackhi_epi32(c0, c2);
+        __m128i d2 = _mm_unpacklo_epi32(c1, c3);
+        __m128i d3 = _mm_unpackhi_epi32(c1, c3);
+
+        _mm_storel_epi64((__m128i*)&Output[ldOutput * 0], d0);
+        _mm_storel_epi64((__m128i*)&Output[ldOutput * 1], _mm_srli_si128(d0, 8));
+        _mm_storel_epi64((__m128i*)&Output[ldOutput * 2], d1);
+        _mm_storel_epi64((__m128i*)&Output[ldOutput * 3], _mm_srli_si128(d1, 8));
+        _mm_storel_epi64((__m128i*)&Output[ldOutput * 4], d2);
+        _mm_storel_epi64((__m128i*)&Output[ldOutput * 5], _mm_srli_si128(d2, 8));
+        _mm_storel_epi64((__m128i*)&Output[ldOutput * 6], d3);
+        _mm_storel_epi64((__m128i*)&Output[ldOutput * 7], _mm_srli_si128(d3, 8));
+    }
+};
+
+template<>
+struct MLAS_TRANSPOSE_KERNEL<uint16_t>
+{
+    static constexpr size_t BlockSize = 8;
+
+    static
+    MLAS_FORCEINLINE
+    void
+    TransposeBlock(
+        const uint16_t* Input,
+        size_t ldInput,
+        uint16_t* Output,
+        size_t ldOutput
+        )
+    {
+        __m128i a0 = _mm_loadu_si128((const __m128i*)&Input[ldInput * 0]);
+        __m128i a1 = _mm_loadu_si128((const __m128i*)&Input[ldInput * 1]);
+        __m128i a2 = _mm_loadu_si128((const __m128i*)&Input[ldInput * 2]);
+        __m128i a3 = _mm_loadu_si128((const __m128i*)&Input[ldInput * 3]);
+        __m128i a4 = _mm_loadu_si128((const __m128i*)&Input[ldInput * 4]);
+        __m128i a5 = _mm_loadu_si128((const __m128i*)&Input[ldInput * 5]);
+        __m128i a6 = _mm_loadu_si128((const __m128i*)&Input[ldInput * 6]);
+        __m128i a7 = _mm_loadu_si128((const __m128i*)&Input[ldInput * 7]);
+
+        __m128i b0 = _mm_unpacklo_epi16(a0, a1);
+        __m128i b1 = _mm_unpacklo_epi16(a2, a3);
+        __m128i b2 = _mm_unpacklo_epi16(a4, a5);
+        __m128i b3 = _mm_unpacklo_epi16(a6, a7);
+        __m128i b4 = _mm_unpackhi_epi16(a0, a1);
+        __m128i b5 = _mm_unpackhi_epi16(a2, a3);
+        __m128i b6 = _mm_unpackhi_epi16(a4, a5);
+        __m128i b7 = _mm_unpackhi_epi16(a6, a7);
+
+        __m128i c0 = _mm_unpacklo_epi32(b0, b1);
+        __m128i c1 = _mm_unpackhi_epi32(b0, b1);
+        __m128i c2 = _mm_unpacklo_epi32(b2, b3);
+        __m128i c3 = _mm_unpackhi_epi32(b2, b3);
+        __m128i c4 = _mm_unpacklo_epi32(b4, b5);
+        __m128i c5 = _mm_unpackhi_epi32(b4, b5);
+        __m128i c6 = _mm_unpacklo_epi32(b6, b7);
+        __m128i c7 = _mm_unpackhi_epi32(b6, b7);
+
+        _mm_storeu_si128((__m128i*)&Output[ldOutput * 0], _mm_unpacklo_epi64(c0, c2));
+        _mm_storeu_si128((__m128i*)&Output[ldOutput * 1], _mm_unpackhi_epi64(c0, c2));
+        _mm_storeu_si128((__m128i*)&Output[ldOutput * 2], _mm_unpacklo_epi64(c1, c3));
+        _mm_storeu_si128((__m128i*)&Output[ldOutput * 3], _mm_unpackhi_epi64(c1, c3));
+        _mm_storeu_si128((__m128i*)&Output[ldOutput * 4], _mm_unpacklo_epi64(c4, c6));
+        _mm_storeu_si128((__m128i*)&Output[ldOutput * 5], _mm_unpackhi_epi64(c4, c6));
+        _mm_storeu_si128((__m128i*)&Output[ldOutput * 6], _mm_unpacklo_epi64(c5, c7));
+        _mm_storeu_si128((__m128i*)&Output[ldOutput * 7], _mm_unpackhi_epi64(c5, c7));
+    }
+};
+
+template<>
+struct MLAS_TRANSPOSE_KERNEL<uint32_t>
+{
+    static constexpr size_t BlockSize = 4;
+
+    static
+    MLAS_FORCEINLINE
+    void
+    TransposeBlock(
+        const uint32_t* Input,
+        size_t ldInput,
+        uint32_t* Output,
+        size_t ldOutput
+        )
+    {
+        __m128i a0 = _mm_loadu_si128((const __m128i*)&Input[ldInput * 0]);
+        __m128i a1 = _mm_loadu_si128((const __m128i*)&Input[ldInput * 1]);
+        __m128i a2 = _mm_loadu_si128((const __m128i*)&Input[ldInput * 2]);
+        __m128i a3 = _mm_loadu_si128((const __m128i*)&Input[ldInput * 3]);
+
+        __m128i b0 = _mm_unpacklo_epi32(a0, a1);
+        __m128i b1 = _mm_unpackhi_epi32(a0, a1);
+        __m128i b2 = _mm_unpacklo_epi32(a2, a3);
+        __m128i b3 = _mm_unpackhi_epi32(a2, a3);
+
+        _mm_storeu_si128((__m128i*)&Output[ldOutput * 0], _mm_unpacklo_epi64(b0, b2));
+        _mm_storeu_si128((__m128i*)&Output[ldOutput * 1], _mm_unpackhi_epi64(b0, b2));
+        _mm_storeu_si128((__m128i*)&Output[ldOutput * 2], _mm_unpacklo_epi64(b1, b3));
+        _mm_storeu_si128((__m128i*)&Output[ldOutput * 3], _mm_unpackhi_epi64(b1, b3));
+    }
+};
+
+template<>
+struct MLAS_TRANSPOSE_KERNEL<uint64_t>
+{
+    static constexpr size_t BlockSize = 2;
+
+    static
+    MLAS_FORCEINLINE
+    void
+    TransposeBlock(
+        const uint64_t* Input,
+        size_t ldInput,
+        uint64_t* Output,
+        size_t ldOutput
+        )
+    {
+        __m128i a0 = _mm_loadu_si128((const __m128i*)&Input[ldInput * 0]);
+        __m128i a1 = _mm_loadu_si128((const __m128i*)&Input[ldInput * 1]);
+
+        _mm_storeu_si128((__m128i*)&Output[ldOutput * 0], _mm_unpacklo_epi64(a0, a1));
+        _mm_storeu_si128((__m128i*)&Output[ldOutput * 1], _mm_unpackhi_epi64(a0, a1));
+    }
+};
+
+#elif defined(MLAS_NEON_INTRINSICS)
+
+template<>
+struct MLAS_TRANSPOSE_KERNEL<uint32_t>
+{
+    static constexpr size_t BlockSize = 4;
+
+    static
+    MLAS_FORCEINLINE
+    void
+    TransposeBlock(
+        const uint32_t* Input,
+        size_t ldInput,
+        uint32_t* Output,
+        size_t ldOutput
+        )
+    {
+        uint32x4_t a0 = vld1q_u32(&Input[ldInput * 0]);
+        uint32x4_t a1 = vld1q_u32(&Input[ldInput * 1]);
+        uint32x4_t a2 = vld1q_u32(&Input[ldInput * 2]);
+        uint32x4_t a3 = vld1q_u32(&Input[ldInput * 3]);
+
+        uint32x4x2_t z0 = vzipq_u32(a0, a2);
+        uint32x4x2_t z1 = vzipq_u32(a1, a3);
+        uint32x4x2_t o0 = vzipq_u32(z0.val[0], z1.val[0]);
+        uint32x4x2_t o1 = vzipq_u32(z0.val[1], z1.val[1]);
+
+        vst1q_u32(&Output[ldOutput * 0], o0.val[0]);
+        vst1q_u32(&Output[ldOutput * 1], o0.val[1]);
+        vst1q_u32(&Output[ldOutput * 2], o1.val[0]);
+        vst1q_u32(&Output[ldOutput * 3], o1.val[1]);
+    }
+};
+
+#endif
+
+template<typename ElementType>
+void
+MlasTransposeImpl(
+    const ElementType* Input,
+    ElementType* Output,
+    size_t M,
+    size_t N,
+    size_t ldInput,
+    size_t ldOutput
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes the source matrix to the destination matrix.
+
+Arguments:
+
+    Input - Supplies the address of the source matrix of M rows and N columns.
+
+    Output - Supplies the address of the destination matrix of N rows and M
+        columns.
+
+    M - Supplies the number of rows of the source matrix.
+
+    N - Supplies the number of columns of the source matrix.
+
+    ldInput - Supplies the number of elements per row of the source matrix.
+
+    ldOutput - Supplies the number of elements per row of the destination
+        matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t BlockSize = MLAS_TRANSPOSE_KERNEL<ElementType>::BlockSize;
+
+    size_t m = 0;
+
+    //
+    // Transpose the rows of the source matrix in groups of the block size.
+    //
+
+    for (; m + BlockSize <= M; m += BlockSize) {
+
+        const ElementType* s = Input + m * ldInput;
+        ElementType* d = Output + m;
+
+        size_t n = 0;
+
+        for (; n + BlockSize <= N; n += BlockSize) {
+            MLAS_TRANSPOSE_KERNEL<ElementType>::TransposeBlock(s + n, ldInput, d + n * ldOutput, ldOutput);
+        }
+
+        for (; n < N; n++) {
+            for (size_t i = 0; i < BlockSize; i++) {
+                d[n * ldOutput + i] = s[i * ldInput + n];
+            }
+        }
+    }
+
+    //
+    // Transpose the remaining rows of the source matrix.
+    //
+
+    for (; m < M; m++) {
+
+        const ElementType* s = Input + m * ldInput;
+        ElementType* d = Output + m;
+
+        for (size_t n = 0; n < N; n++) {
+            d[n * ldOutput] = s[n];
+        }
+    }
+}
+
+void
+MLASCALL
+MlasTranspose(
+    const uint8_t* Input,
+    uint8_t* Output,
+    size_t M,
+    size_t N,
+    size_t ldInput,
+    size_t ldOutput
+    )
+{
+    MlasTransposeImpl(Input, Output, M, N, ldInput, ldOutput);
+}
+
+void
+MLASCALL
+MlasTranspose(
+    const uint16_t* Input,
+    uint16_t* Output,
+    size_t M,
+    size_t N,
+    size_t ldInput,
+    size_t ldOutput
+    )
+{
+    MlasTransposeImpl(Input, Output, M, N, ldInput, ldOutput);
+}
+
+void
+MLASCALL
+MlasTranspose(
+    const uint32_t* Input,
+    uint32_t* Output,
+    size_t M,
+    size_t N,
+    size_t ldInput,
+    size_t ldOutput
+    )
+{
+    MlasTransposeImpl(Input, Output, M, N, ldInput, ldOutput);
+}
+
+void
+MLASCALL
+MlasTranspose(
+    const uint64_t* Input,
+    uint64_t* Output,
+    size_t M,
+    size_t N,
+    size_t ldInput,
+    size_t ldOutput
+    )
+{
+    MlasTransposeImpl(Input, Output, M, N, ldInput, ldOutput);
+}
@@ -90,6 +90,13 @@ Status ConvActivationFusion::ApplyImpl(Graph& graph, bool& modified, int graph_l
       continue;
     }
 
+    // FusedConv is only implemented for float.
+    const auto* output_type = node->OutputDefs()[0]->TypeAsProto();
+    if (output_type == nullptr ||
+        output_type->tensor_type().elem_type() != ONNX_NAMESPACE::TensorProto_DataType_FLOAT) {
+      continue;
+    }
+
     const auto& next_node = *(node->OutputNodesBegin());
 
     if (next_node.GetExecutionProviderType() != node->GetExecutionProviderType()) {
@@ -0,0 +1,284 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/elementwise_fusion.h"
+#include "core/graph/graph_utils.h"
+#include "core/framework/tensorprotoutils.h"
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+// Operators that the FusedElementwise kernel can run, with their supported opset versions.
+bool IsElementwiseOp(const Node& node) {
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "Add", {7}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sub", {7}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Mul", {7}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Div", {7}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Relu", {6}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sigmoid", {6}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Tanh", {6}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Abs", {6}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Neg", {6}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Floor", {6}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Ceil", {6}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Reciprocal", {6}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sqrt", {6}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Exp", {6}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Log", {6}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Erf", {9});
+}
+
+bool IsConv(const Node& node) {
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "Conv", {1, 11}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "FusedConv", {1}, kMSDomain);
+}
+
+// The NCHWc transformer folds an Add or Sum of a Conv output and a following Relu into the Conv, which beats
+// fusing them here, so nodes reading a Conv output directly or through such an Add are left alone.
+bool FollowsConv(const Node& node) {
+  for (auto it = node.InputNodesBegin(); it != node.InputNodesEnd(); ++it) {
+    const Node& input_node = *it;
+    if (IsConv(input_node)) {
+      return true;
+    }
+    if (graph_utils::IsSupportedOptypeVersionAndDomain(input_node, "Add", {7}) ||
+        graph_utils::IsSupportedOptypeVersionAndDomain(input_node, "Sum", {6, 8})) {
+      for (auto add_it = input_node.InputNodesBegin(); add_it != input_node.InputNodesEnd(); ++add_it) {
+        if (IsConv(*add_it)) {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
+bool IsFloatTensor(const NodeArg& arg) {
+  const auto* type = arg.TypeAsProto();
+  return type != nullptr && type->has_tensor_type() &&
+         type->tensor_type().elem_type() == TensorProto_DataType_FLOAT;
+}
+
+// Returns the shape of the output when every dimension is either known or named, so that it can be compared with
+// the shapes of the other outputs of a region.
+const TensorShapeProto* GetComparableShape(const NodeArg& arg) {
+  const auto* shape = arg.Shape();
+  if (shape == nullptr) {
+    return nullptr;
+  }
+  for (const auto& dim : shape->dim()) {
+    if (!utils::HasDimValue(dim) && !(utils::HasDimParam(dim) && !dim.dim_param().empty())) {
+      return nullptr;
+    }
+  }
+  return shape;
+}
+
+bool SameShape(const TensorShapeProto& a, const TensorShapeProto& b) {
+  if (a.dim_size() != b.dim_size()) {
+    return false;
+  }
+  for (int i = 0; i < a.dim_size(); ++i) {
+    const auto& dim_a = a.dim(i);
+    const auto& dim_b = b.dim(i);
+    if (utils::HasDimValue(dim_a) != utils::HasDimValue(dim_b)) {
+      return false;
+    }
+    if (utils::HasDimValue(dim_a) ? dim_a.dim_value() != dim_b.dim_value()
+                                  : dim_a.dim_param() != dim_b.dim_param()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool IsFusible(const Node& node, const std::unordered_set<std::string>& compatible_providers) {
+  if (!IsElementwiseOp(node) ||
+      !graph_utils::IsSupportedProvider(node, compatible_providers) ||
+      node.OutputDefs().size() != 1 ||
+      GetComparableShape(*node.OutputDefs()[0]) == nullptr) {
+    return false;
+  }
+  for (const auto* arg : node.InputDefs()) {
+    if (!arg->Exists() || !IsFloatTensor(*arg)) {
+      return false;
+    }
+  }
+  return IsFloatTensor(*node.OutputDefs()[0]) && !FollowsConv(node);
+}
+
+// Replaces the nodes of a region, which are sorted in topological order, with a FusedElementwise node.
+Node& FuseRegion(Graph& graph, const std::vector<Node*>& region) {
+  std::unordered_set<const Node*> members(region.begin(), region.end());
+
+  // the inputs of the fused node are the tensors that the region reads but does not produce
+  std::vector<NodeArg*> inputs;
+  std::unordered_map<const NodeArg*, int64_t> input_index;
+  std::unordered_map<const NodeArg*, int64_t> result_index;
+  for (size_t k = 0; k < region.size(); ++k) {
+    for (auto* arg : region[k]->MutableInputDefs()) {
+      if (result_index.count(arg) == 0 && input_index.count(arg) == 0) {
+        input_index[arg] = static_cast<int64_t>(inputs.size());
+        inputs.push_back(arg);
+      }
+    }
+    result_index[region[k]->OutputDefs()[0]] = static_cast<int64_t>(k);
+  }
+
+  const int64_t num_inputs = static_cast<int64_t>(inputs.size());
+  std::vector<std::string> ops;
+  std::vector<int64_t> operands;
+  std::vector<NodeArg*> outputs;
+  std::vector<int64_t> output_slots;
+  std::vector<Node*> output_nodes;
+  for (size_t k = 0; k < region.size(); ++k) {
+    Node& node = *region[k];
+    ops.push_back(node.OpType());
+    for (const auto* arg : node.InputDefs()) {
+      auto result = result_index.find(arg);
+      operands.push_back(result != result_index.end() ? num_inputs + result->second : input_index[arg]);
+    }
+
+    // the result is an output of the fused node when it is read outside of the region
+    bool used_outside = !graph.GetNodeOutputsInGraphOutputs(node).empty();
+    for (auto it = node.OutputEdgesBegin(); !used_outside && it != node.OutputEdgesEnd(); ++it) {
+      used_outside = members.count(&it->GetNode()) == 0;
+    }
+    if (used_outside) {
+      outputs.push_back(node.MutableOutputDefs()[0]);
+      output_slots.push_back(num_inputs + static_cast<int64_t>(k));
+      output_nodes.push_back(&node);
+    }
+  }
+
+  // keep the last result as the output of a region whose results are all unused, as the node needs one
+  if (outputs.empty()) {
+    outputs.push_back(region.back()->MutableOutputDefs()[0]);
+    output_slots.push_back(num_inputs + static_cast<int64_t>(region.size()) - 1);
+    output_nodes.push_back(region.back());
+  }
+
+  Node& fused_node = graph.AddNode(graph.GenerateNodeName("FusedElementwise"),
+                                   "FusedElementwise",
+                                   "fused element-wise operators",
+                                   inputs,
+                                   outputs,
+                                   nullptr,
+                                   kMSDomain);
+  fused_node.AddAttribute("ops", ops);
+  fused_node.AddAttribute("operands", operands);
+  fused_node.AddAttribute("output_slots", output_slots);
+
+  // Assign provider to this new node. Provider should be same as the provider for old nodes.
+  fused_node.SetExecutionProviderType(region[0]->GetExecutionProviderType());
+
+  // connect the producers of the inputs and the consumers of the outputs to the fused node
+  for (const Node* node : region) {
+    for (auto it = node->InputEdgesBegin(); it != node->InputEdgesEnd(); ++it) {
+      if (members.count(&it->GetNode()) == 0) {
+        const NodeArg* arg = node->InputDefs()[it->GetDstArgIndex()];
+        graph.AddEdge(it->GetNode().Index(), fused_node.Index(), it->GetSrcArgIndex(),
+                      static_cast<int>(input_index[arg]));
+      }
+    }
+  }
+  for (size_t i = 0; i < output_nodes.size(); ++i) {
+    graph_utils::ReplaceDownstreamNodeInput(graph, *output_nodes[i], 0, fused_node, static_cast<int>(i));
+  }
+
+  for (Node* node : region) {
+    graph_utils::RemoveNodeOutputEdges(graph, *node);
+    graph.RemoveNode(node->Index());
+  }
+
+  return fused_node;
+}
+
+}  // namespace
+
+Status ElementwiseFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  std::unordered_map<NodeIndex, size_t> position;
+  for (size_t i = 0; i < node_topology_list.size(); ++i) {
+    position[node_topology_list[i]] = i;
+  }
+
+  for (size_t seed_position = 0; seed_position < node_topology_list.size(); ++seed_position) {
+    auto* node_ptr = graph.GetNode(node_topology_list[seed_position]);
+    if (nullptr == node_ptr)
+      continue;  // node was removed
+
+    auto& node = *node_ptr;
+
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!IsFusible(node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    // Grow the region from this node through the consumers of its nodes, visiting the candidates in topological
+    // order. A candidate joins when its output has the shape of the region and each of its inputs is produced
+    // either in the region or before the first node of the region, so the fused node can not create a cycle.
+    const TensorShapeProto& shape = *node.OutputDefs()[0]->Shape();
+    std::vector<Node*> region{&node};
+    std::unordered_set<const Node*> members{&node};
+    std::unordered_set<NodeIndex> queued;
+    std::priority_queue<std::pair<size_t, NodeIndex>, std::vector<std::pair<size_t, NodeIndex>>,
+                        std::greater<std::pair<size_t, NodeIndex>>>
+        candidates;
+    auto add_consumers = [&](const Node& member) {
+      for (auto it = member.OutputNodesBegin(); it != member.OutputNodesEnd(); ++it) {
+        auto entry = position.find(it->Index());
+        if (entry != position.end() && queued.insert(it->Index()).second) {
+          candidates.emplace(entry->second, it->Index());
+        }
+      }
+    };
+    add_consumers(node);
+
+    while (!candidates.empty()) {
+      Node& candidate = *graph.GetNode(candidates.top().second);
+      candidates.pop();
+
+      if (!IsFusible(candidate, GetCompatibleExecutionProviders()) ||
+          candidate.GetExecutionProviderType() != node.GetExecutionProviderType() ||
+          !SameShape(*candidate.OutputDefs()[0]->Shape(), shape)) {
+        continue;
+      }
+
+      bool inputs_ready = true;
+      for (auto it = candidate.InputNodesBegin(); inputs_ready && it != candidate.InputNodesEnd(); ++it) {
+        auto entry = position.find(it->Index());
+        inputs_ready = members.count(&*it) != 0 || (entry != position.end() && entry->second < seed_position);
+      }
+      if (!inputs_ready) {
+        continue;
+      }
+
+      region.push_back(&candidate);
+      members.insert(&candidate);
+      add_consumers(candidate);
+    }
+
+    if (region.size() < 2) {
+      continue;
+    }
+
+    Node& fused_node = FuseRegion(graph, region);
+
+    // the fused node only reads tensors produced before the region, so it takes the place of its first node
+    position[fused_node.Index()] = seed_position;
+    modified = true;
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
@@ -38,6 +38,13 @@ Status GemmActivationFusion::ApplyImpl(Graph& graph, bool& modified, int graph_l
       continue;
     }
 
+    // FusedGemm is only implemented for float.
+    const auto* output_type = node.OutputDefs()[0]->TypeAsProto();
+    if (output_type == nullptr ||
+        output_type->tensor_type().elem_type() != ONNX_NAMESPACE::TensorProto_DataType_FLOAT) {
+      continue;
+    }
+
     const Node& next_node = *(node.OutputNodesBegin());
     if (!IsFusableActivation(next_node) ||
         next_node.GetExecutionProviderType() != node.GetExecutionProviderType()) {
@@ -37,6 +37,10 @@ struct DeviceHelpers {
   // (e.g. it is a pointer to a handle rather than the actual data)
   CreateConstSlicer create_const_slicer_func = OrtValueTensorSlicer<const OrtValue>::Create;
   CreateMutableSlicer create_mutable_slicer_func = OrtValueTensorSlicer<OrtValue>::Create;
+
+  // Independent batch entries (Scan 8) or iterations (Scan 9 when no loop state variable is read by the subgraph)
+  // may be executed concurrently using the inter-op thread pool. Only enabled by the CPU kernels.
+  bool allow_parallel_execution = false;
 };
 }  // namespace detail
 }  // namespace scan
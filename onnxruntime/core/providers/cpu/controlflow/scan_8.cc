@@ -113,6 +113,11 @@ class Scan8Impl {
   Status AllocateOutputTensors();
   Status CreateLoopStateVariables(std::vector<std::vector<LoopStateVariable>>& loop_state_variables);
 
+  // iterate the sequence for a single batch entry, writing the scan outputs using output_iterators
+  Status ExecuteBatchEntry(int64_t b, std::vector<LoopStateVariable>& loop_state_variables,
+                           std::vector<std::unique_ptr<OutputIterator>>& output_iterators,
+                           const FeedsFetchesManager& ffm);
+
   using ConstTensorSlicerIterators = std::vector<OrtValueTensorSlicer<const OrtValue>::Iterator>;
   using MutableTensorSlicerIterators = std::vector<OrtValueTensorSlicer<OrtValue>::Iterator>;
 
@@ -156,6 +161,8 @@ Scan<8>::Scan(const OpKernelInfo& info) : OpKernel(info) {
     memset(data, 0, size_in_bytes);
     return Status::OK();
   };
+
+  device_helpers_.allow_parallel_execution = true;
 }
 
 template <>
@@ -393,6 +400,50 @@ Status Scan8Impl::CreateLoopStateVariables(std::vector<std::vector<LoopStateVari
   return status;
 }
 
+Status Scan8Impl::ExecuteBatchEntry(int64_t b, std::vector<LoopStateVariable>& loop_state_variables,
+                                    std::vector<std::unique_ptr<OutputIterator>>& output_iterators,
+                                    const FeedsFetchesManager& ffm) {
+  auto sequence_len = sequence_lens_[b];
+
+  // Setup input OrtValue streams
+  std::vector<OrtValueTensorSlicer<const OrtValue>::Iterator> scan_input_stream_iterators;
+  scan_input_stream_iterators.reserve(info_.num_variadic_inputs - info_.num_loop_state_variables);
+
+  for (int i = info_.num_loop_state_variables, end = info_.num_variadic_inputs; i < end; ++i) {
+    const auto& ort_value = GetSubgraphInputMLValue(context_, i);
+
+    // forward
+    if (directions_[i - info_.num_loop_state_variables] == static_cast<int64_t>(ScanDirection::kForward)) {
+      // the iterator is self contained, so we don't need to keep the OrtValueTensorSlicer instance around
+      scan_input_stream_iterators.push_back(device_helpers_.create_const_slicer_func(ort_value, 1, b).begin());
+    } else {  // reverse
+      scan_input_stream_iterators.push_back(device_helpers_.create_const_slicer_func(ort_value, 1, b).rbegin());
+      // need to skip past the empty entries at the end of the input if sequence length is short
+      auto offset = max_sequence_len_ - sequence_len;
+      if (offset > 0) {
+        // reverse iterator so += moves backwards through the input
+        scan_input_stream_iterators.back() += offset;
+      }
+    }
+  }
+
+  // Call the subgraph for each item in the sequence
+  auto status = IterateSequence(context_, session_state_, loop_state_variables, scan_input_stream_iterators,
+                                sequence_len, info_.num_loop_state_variables, info_.num_variadic_inputs,
+                                info_.num_outputs, implicit_inputs_, output_iterators, ffm);
+
+  // zero out any remaining values in the sequence
+  for (int64_t i = sequence_len; i < max_sequence_len_; ++i) {
+    for (int output = info_.num_loop_state_variables; output < info_.num_outputs; ++output) {
+      auto& iterator = *output_iterators[output];
+      iterator.ZeroOutCurrent();
+      ++iterator;
+    }
+  }
+
+  return status;
+}
+
 Status Scan8Impl::Execute(const FeedsFetchesManager& ffm) {
   Status status = Status::OK();
 
@@ -401,49 +452,51 @@ Status Scan8Impl::Execute(const FeedsFetchesManager& ffm) {
   status = CreateLoopStateVariables(batch_loop_state_variables);
   ORT_RETURN_IF_ERROR(status);
 
-  for (int64_t b = 0; b < batch_size_; ++b) {
-    auto sequence_len = sequence_lens_[b];
-
-    // Setup input OrtValue streams
-    std::vector<OrtValueTensorSlicer<const OrtValue>::Iterator> scan_input_stream_iterators;
-    scan_input_stream_iterators.reserve(info_.num_variadic_inputs - info_.num_loop_state_variables);
-
-    for (int i = info_.num_loop_state_variables, end = info_.num_variadic_inputs; i < end; ++i) {
-      const auto& ort_value = GetSubgraphInputMLValue(context_, i);
-
-      // forward
-      if (directions_[i - info_.num_loop_state_variables] == static_cast<int64_t>(ScanDirection::kForward)) {
-        // the iterator is self contained, so we don't need to keep the OrtValueTensorSlicer instance around
-        scan_input_stream_iterators.push_back(device_helpers_.create_const_slicer_func(ort_value, 1, b).begin());
-      } else {  // reverse
-        scan_input_stream_iterators.push_back(device_helpers_.create_const_slicer_func(ort_value, 1, b).rbegin());
-        // need to skip past the empty entries at the end of the input if sequence length is short
-        auto offset = max_sequence_len_ - sequence_len;
-        if (offset > 0) {
-          // reverse iterator so += moves backwards through the input
-          scan_input_stream_iterators.back() += offset;
-        }
-      }
-    }
+  if (batch_size_ <= 0) {
+    return status;
+  }
 
-    // Call the subgraph for each item in the sequence
-    status = IterateSequence(context_, session_state_, batch_loop_state_variables[b], scan_input_stream_iterators,
-                             sequence_len, info_.num_loop_state_variables, info_.num_variadic_inputs, info_.num_outputs,
-                             implicit_inputs_, output_iterators_, ffm);
-
-    // zero out any remaining values in the sequence
-    for (int64_t i = sequence_len; i < max_sequence_len_; ++i) {
-      for (int output = info_.num_loop_state_variables; output < info_.num_outputs; ++output) {
-        auto& iterator = *output_iterators_[output];
-        iterator.ZeroOutCurrent();
-        ++iterator;
-      }
+  // always run the first batch entry using the shared output iterators. if a scan output has a symbolic dimension
+  // this will discover the shape and allocate the final output.
+  status = ExecuteBatchEntry(0, batch_loop_state_variables[0], output_iterators_, ffm);
+  ORT_RETURN_IF_ERROR(status);
+
+  auto* thread_pool = device_helpers_.allow_parallel_execution ? session_state_.GetInterOpThreadPool() : nullptr;
+  bool can_run_in_parallel = thread_pool != nullptr && batch_size_ > 2 &&
+                             std::all_of(output_iterators_.cbegin() + info_.num_loop_state_variables,
+                                         output_iterators_.cend(),
+                                         [](const std::unique_ptr<OutputIterator>& iterator) {
+                                           return iterator->FinalOutputAllocated();
+                                         });
+
+  if (!can_run_in_parallel) {
+    for (int64_t b = 1; b < batch_size_; ++b) {
+      status = ExecuteBatchEntry(b, batch_loop_state_variables[b], output_iterators_, ffm);
+      ORT_RETURN_IF_ERROR(status);
     }
 
-    ORT_RETURN_IF_ERROR(status);
+    return status;
   }
 
-  return status;
+  // the batch entries are independent, so each one gets its own output iterators and executes the subgraph
+  // using its own execution frame.
+  return controlflow::detail::ParallelExecute(
+      thread_pool, batch_size_ - 1,
+      [this, &batch_loop_state_variables, &ffm](int64_t i) {
+        const int64_t b = i + 1;
+
+        // loop state variable outputs are handled by the LoopStateVariable instances for the batch entry
+        std::vector<std::unique_ptr<OutputIterator>> output_iterators(info_.num_loop_state_variables);
+        output_iterators.reserve(info_.num_outputs);
+
+        for (int output = info_.num_loop_state_variables; output < info_.num_outputs; ++output) {
+          std::unique_ptr<OutputIterator> output_iter;
+          ORT_RETURN_IF_ERROR(OutputIterator::CreateForBatchEntry(*output_iterators_[output], b, output_iter));
+          output_iterators.push_back(std::move(output_iter));
+        }
+
+        return ExecuteBatchEntry(b, batch_loop_state_variables[b], output_iterators, ffm);
+      });
 }
 
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(Scan,
@@ -16,6 +16,7 @@
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/session_state.h"
 #include "core/framework/tensorprotoutils.h"
+#include "core/framework/utils.h"
 
 #include "core/providers/common.h"
 #include "core/providers/cpu/tensor/utils.h"
@@ -135,6 +136,9 @@ class ScanImpl {
   Status CreateLoopStateVariables(std::vector<LoopStateVariable>& loop_state_variables);
   Status TransposeOutput();
 
+  // execute the iterations concurrently. only valid if the subgraph does not read any loop state variables.
+  Status ExecuteIterationsInParallel(concurrency::ThreadPool* thread_pool, const FeedsFetchesManager& ffm);
+
   using ConstTensorSlicerIterators = std::vector<OrtValueTensorSlicer<const OrtValue>::Iterator>;
   using MutableTensorSlicerIterators = std::vector<OrtValueTensorSlicer<OrtValue>::Iterator>;
 
@@ -196,6 +200,8 @@ Scan<9>::Scan(const OpKernelInfo& info) : OpKernel(info) {
     memset(data, 0, size_in_bytes);
     return Status::OK();
   };
+
+  device_helpers_.allow_parallel_execution = true;
 }
 
 // we need this to be in the .cc so 'unique_ptr<Info> info_' can be handled
@@ -432,6 +438,21 @@ Status ScanImpl::CreateLoopStateVariables(std::vector<LoopStateVariable>& loop_s
 Status ScanImpl::Execute(const FeedsFetchesManager& ffm) {
   Status status = Status::OK();
 
+  auto* thread_pool = device_helpers_.allow_parallel_execution ? session_state_.GetInterOpThreadPool() : nullptr;
+  bool can_run_in_parallel = thread_pool != nullptr && sequence_len_ > 1 && !info_.has_loop_state_dependency &&
+                             std::all_of(output_iterators_.cbegin() + info_.num_loop_state_variables,
+                                         output_iterators_.cend(),
+                                         [](const std::unique_ptr<OutputIterator>& iterator) {
+                                           return iterator->FinalOutputAllocated();
+                                         });
+
+  if (can_run_in_parallel) {
+    status = ExecuteIterationsInParallel(thread_pool, ffm);
+    ORT_RETURN_IF_ERROR(status);
+
+    return TransposeOutput();
+  }
+
   std::vector<LoopStateVariable> loop_state_variables;
   status = CreateLoopStateVariables(loop_state_variables);
   ORT_RETURN_IF_ERROR(status);
@@ -464,6 +485,51 @@ Status ScanImpl::Execute(const FeedsFetchesManager& ffm) {
   return status;
 }
 
+Status ScanImpl::ExecuteIterationsInParallel(concurrency::ThreadPool* thread_pool, const FeedsFetchesManager& ffm) {
+  static const std::unordered_map<size_t, IExecutor::CustomAllocator> no_fetch_allocators;
+  const int64_t last_iteration = sequence_len_ - 1;
+
+  return controlflow::detail::ParallelExecute(
+      thread_pool, sequence_len_,
+      [this, &ffm, last_iteration](int64_t iteration) {
+        std::vector<OrtValue> feeds;
+        feeds.reserve(info_.num_inputs + info_.num_implicit_inputs);
+
+        // the subgraph doesn't read the loop state variables so we can provide the initial values for every iteration
+        for (int i = 0; i < info_.num_loop_state_variables; ++i) {
+          feeds.push_back(*context_.GetInputMLValue(i));
+        }
+
+        for (int i = 0; i < info_.num_scan_inputs; ++i) {
+          auto slicer = device_helpers_.create_const_slicer_func(inputs_[i], 0, 0);
+          auto iter = input_directions_[i] == static_cast<int64_t>(ScanDirection::kForward) ? slicer.begin()
+                                                                                             : slicer.rbegin();
+          iter += iteration;
+          feeds.push_back(*iter);
+        }
+
+        for (const auto* implicit_input : implicit_inputs_) {
+          feeds.push_back(*implicit_input);
+        }
+
+        std::vector<OrtValue> fetches;
+        fetches.reserve(info_.num_outputs);
+
+        // only the last iteration produces the final value of a loop state variable.
+        // for other iterations an empty OrtValue lets the execution frame allocate a temporary one.
+        for (int i = 0; i < info_.num_loop_state_variables; ++i) {
+          fetches.push_back(iteration == last_iteration ? **output_iterators_[i] : OrtValue());
+        }
+
+        for (int i = info_.num_loop_state_variables; i < info_.num_outputs; ++i) {
+          fetches.push_back(output_iterators_[i]->GetOutputForIteration(iteration));
+        }
+
+        return utils::ExecuteSubgraph(session_state_, ffm, feeds, fetches, no_fetch_allocators,
+                                      ExecutionMode::ORT_SEQUENTIAL, context_.GetTerminateFlag(), context_.Logger());
+      });
+}
+
 Status ScanImpl::TransposeOutput() {
   auto status = Status::OK();
 
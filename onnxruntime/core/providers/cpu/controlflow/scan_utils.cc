@@ -11,6 +11,8 @@
 
 #include "core/providers/cpu/controlflow/scan_utils.h"
 
+#include <unordered_set>
+
 #include "gsl/gsl"
 
 #include "core/framework/mldata_type_utils.h"
@@ -58,6 +60,30 @@ Info::Info(const Node& node, const GraphViewer& subgraph_in, int num_scan_inputs
   for (const auto& output : subgraph.GetOutputs()) {
     subgraph_output_names.push_back(output->Name());
   }
+
+  // the iterations are independent if no node reads a loop state variable (explicitly or as an implicit input to a
+  // nested subgraph), and no loop state variable is passed directly through to an output.
+  std::unordered_set<std::string> loop_state_names(subgraph_input_names.cbegin(),
+                                                   subgraph_input_names.cbegin() + num_loop_state_variables);
+  auto reads_loop_state = [&loop_state_names](const NodeArg* arg) {
+    return arg->Exists() && loop_state_names.count(arg->Name()) != 0;
+  };
+
+  has_loop_state_dependency = std::any_of(subgraph_output_names.cbegin(), subgraph_output_names.cend(),
+                                          [&loop_state_names](const std::string& name) {
+                                            return loop_state_names.count(name) != 0;
+                                          });
+
+  for (const auto& subgraph_node : subgraph.Nodes()) {
+    if (has_loop_state_dependency) {
+      break;
+    }
+
+    has_loop_state_dependency =
+        std::any_of(subgraph_node.InputDefs().cbegin(), subgraph_node.InputDefs().cend(), reads_loop_state) ||
+        std::any_of(subgraph_node.ImplicitInputDefs().cbegin(), subgraph_node.ImplicitInputDefs().cend(),
+                    reads_loop_state);
+  }
 }
 
 void ReadDirections(const OpKernelInfo& info, const std::string& attr_name,
@@ -536,6 +562,44 @@ Status OutputIterator::AllocateFinalOutput(const TensorShape& shape) {
   return Status::OK();
 }
 
+OrtValue OutputIterator::GetOutputForIteration(int64_t iteration) {
+  ORT_ENFORCE(!is_v8_ && !is_loop_state_var_, "Only supported for Scan 9 scan outputs.");
+  ORT_ENFORCE(iteration >= 0 && iteration < num_iterations_);
+  ORT_ENFORCE(is_concrete_shape_, "Expected the final output to have been allocated.");
+
+  auto slicer = create_slicer_func_(*final_output_mlvalue_, 0, 0);
+  auto iter = direction_ == ScanDirection::kForward ? slicer.begin() : slicer.rbegin();
+  iter += iteration;
+
+  return *iter;
+}
+
+Status OutputIterator::CreateForBatchEntry(const OutputIterator& source, int64_t batch_index,
+                                           std::unique_ptr<OutputIterator>& iterator) {
+  ORT_ENFORCE(source.is_v8_ && !source.is_loop_state_var_, "Only supported for Scan 8 scan outputs.");
+  ORT_ENFORCE(source.is_concrete_shape_, "Expected the final output to have been allocated.");
+
+  if (batch_index < 0 || batch_index >= source.final_shape_[0]) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Invalid batch index of ", batch_index,
+                           ". Batch size is ", source.final_shape_[0]);
+  }
+
+  // copy the source and replace the slicers with a single one for the requested batch entry.
+  iterator.reset(new OutputIterator(source));
+  OutputIterator& batch_iterator = *iterator;
+
+  batch_iterator.num_iterations_ = source.final_shape_[1];
+  batch_iterator.cur_iteration_ = 0;
+  batch_iterator.slicer_iterators_.clear();
+  batch_iterator.slicer_iterators_.push_back(
+      (source.direction_ == ScanDirection::kForward)
+          ? source.create_slicer_func_(*source.final_output_mlvalue_, 1, batch_index).begin()
+          : source.create_slicer_func_(*source.final_output_mlvalue_, 1, batch_index).rbegin());
+  batch_iterator.cur_slicer_iterator_ = batch_iterator.slicer_iterators_.begin();
+
+  return Status::OK();
+}
+
 OrtValue& OutputIterator::operator*() {
   ORT_ENFORCE(cur_iteration_ < num_iterations_);
   ORT_ENFORCE(is_concrete_shape_,
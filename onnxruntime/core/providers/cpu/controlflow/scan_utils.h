@@ -46,6 +46,10 @@ struct Info {
 
   std::vector<std::string> subgraph_input_names;
   std::vector<std::string> subgraph_output_names;
+
+  // true if a loop state variable is read by the subgraph, making each iteration dependent on the previous one.
+  // if false the iterations can be executed in any order.
+  bool has_loop_state_dependency;
 };
 
 /**
@@ -138,6 +142,15 @@ class OutputIterator {
     return *final_output_mlvalue_;
   }
 
+  // Scan 9: get the slice of a scan output for a specific iteration, independent of the current position of
+  // the iterator. Used when executing iterations in parallel. The final output must have been allocated.
+  OrtValue GetOutputForIteration(int64_t iteration);
+
+  // Scan 8: create an iterator over the sequence for a single batch entry of a scan output, so batch entries can
+  // be processed in parallel. The final output of 'source' must have been allocated.
+  static Status CreateForBatchEntry(const OutputIterator& source, int64_t batch_index,
+                                    std::unique_ptr<OutputIterator>& iterator);
+
  private:
   OutputIterator(OpKernelContextInternal& context,
                  int output_index,
@@ -3,12 +3,17 @@
 
 #include "core/providers/cpu/controlflow/utils.h"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
 #include <vector>
 #include "core/common/common.h"
 #include "core/framework/framework_common.h"
 #include "core/framework/session_state.h"
 #include "core/framework/utils.h"
 #include "core/graph/graph.h"
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 namespace controlflow {
@@ -28,6 +33,77 @@ common::Status FindDevicesForValues(const SessionState& session_state,
   return Status::OK();
 }
 
+namespace {
+// state shared between the calling thread and the thread pool tasks of a ParallelExecute call.
+// held by shared_ptr as a task may not start until after ParallelExecute has returned.
+struct ParallelExecuteState {
+  ParallelExecuteState(int64_t total_in, const std::function<Status(int64_t)>& fn_in)
+      : total{total_in}, fn{fn_in} {}
+
+  const int64_t total;
+  const std::function<Status(int64_t)> fn;
+
+  std::atomic<int64_t> next{0};
+  std::atomic<bool> failed{false};
+
+  std::mutex mutex;
+  std::condition_variable completed;
+  int64_t num_completed{0};  // guarded by mutex
+  Status status;             // first error. guarded by mutex
+};
+
+void RunWorkItems(ParallelExecuteState& state) {
+  for (int64_t i = state.next++; i < state.total; i = state.next++) {
+    Status status;
+
+    if (!state.failed) {
+      try {
+        status = state.fn(i);
+      } catch (const std::exception& ex) {
+        status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+      }
+    }
+
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (!status.IsOK() && state.status.IsOK()) {
+      state.status = status;
+      state.failed = true;
+    }
+
+    if (++state.num_completed == state.total) {
+      state.completed.notify_all();
+    }
+  }
+}
+}  // namespace
+
+common::Status ParallelExecute(concurrency::ThreadPool* thread_pool, int64_t total,
+                               const std::function<common::Status(int64_t)>& fn) {
+  if (thread_pool == nullptr || total <= 1) {
+    for (int64_t i = 0; i < total; ++i) {
+      ORT_RETURN_IF_ERROR(fn(i));
+    }
+
+    return Status::OK();
+  }
+
+  auto state = std::make_shared<ParallelExecuteState>(total, fn);
+
+  // the calling thread processes items as well, so we need at most total - 1 helpers
+  auto num_helpers = std::min<int64_t>(total - 1, thread_pool->NumThreads());
+  for (int64_t i = 0; i < num_helpers; ++i) {
+    thread_pool->Schedule([state]() { RunWorkItems(*state); });
+  }
+
+  RunWorkItems(*state);
+
+  // every item has been claimed by a running thread at this point so waiting can't deadlock
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->completed.wait(lock, [&state]() { return state->num_completed == state->total; });
+
+  return state->status;
+}
+
 }  // namespace detail
 }  // namespace controlflow
 }  // namespace onnxruntime
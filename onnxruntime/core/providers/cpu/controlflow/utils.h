@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <functional>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -12,6 +13,9 @@
 
 namespace onnxruntime {
 class Graph;
+namespace concurrency {
+class ThreadPool;
+}
 
 namespace controlflow {
 
@@ -39,6 +43,15 @@ common::Status FindDevicesForValues(const SessionState& session_state,
                                     std::vector<OrtDevice>& devices,
                                     size_t start_at = 0);
 
+// Calls fn(i) for each i in [0, total) using the calling thread and any idle threads in thread_pool.
+// Work items are claimed dynamically by threads that are already running, so the calling thread never waits on
+// work that has not started. This makes it safe to call from a thread that belongs to thread_pool
+// (e.g. when the control flow node is itself being executed by the parallel executor).
+// Runs sequentially on the calling thread if thread_pool is nullptr.
+// Returns the first error. Items that have not started when an error occurs are skipped.
+common::Status ParallelExecute(concurrency::ThreadPool* thread_pool, int64_t total,
+                               const std::function<common::Status(int64_t)>& fn);
+
 }  // namespace detail
 }  // namespace controlflow
 }  // namespace onnxruntime
@@ -18,6 +18,18 @@ namespace onnxruntime {
       KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>()), \
       KERNEL_CLASS<TYPE>);
 
+// for the binary ops whose inputs BroadcastTwo reads, so Split or Slice outputs can be passed as views
+#define REG_ELEMENTWISE_STRIDED_TYPED_KERNEL(OP_TYPE, VERSION, TYPE, KERNEL_CLASS) \
+  ONNX_CPU_OPERATOR_TYPED_KERNEL(                                                  \
+      OP_TYPE,                                                                     \
+      VERSION,                                                                     \
+      TYPE,                                                                        \
+      KernelDefBuilder()                                                           \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>())                \
+          .MayStridedInput(0)                                                      \
+          .MayStridedInput(1),                                                     \
+      KERNEL_CLASS<TYPE>);
+
 #define REG_ELEMENTWISE_LOGICALOP_TYPED_KERNEL(OP_TYPE, VERSION, TYPE, KERNEL_CLASS) \
   ONNX_CPU_OPERATOR_TYPED_KERNEL(                                                    \
       OP_TYPE,                                                                       \
@@ -46,23 +58,25 @@ namespace onnxruntime {
           .TypeConstraint("T1", DataTypeImpl::GetTensorType<bool>()),                                           \
       KERNEL_CLASS<TYPE>);
 
-REG_ELEMENTWISE_TYPED_KERNEL(Add, 7, float, Add);
-REG_ELEMENTWISE_TYPED_KERNEL(Add, 7, double, Add);
+REG_ELEMENTWISE_STRIDED_TYPED_KERNEL(Add, 7, float, Add);
+REG_ELEMENTWISE_STRIDED_TYPED_KERNEL(Add, 7, double, Add);
 REG_ELEMENTWISE_TYPED_KERNEL(Add, 7, int32_t, Add);
 REG_ELEMENTWISE_TYPED_KERNEL(Add, 7, int64_t, Add);
+REG_ELEMENTWISE_TYPED_KERNEL(Add, 7, MLFloat16, Add);
 
-REG_ELEMENTWISE_TYPED_KERNEL(Sub, 7, float, Sub);
-REG_ELEMENTWISE_TYPED_KERNEL(Sub, 7, double, Sub);
+REG_ELEMENTWISE_STRIDED_TYPED_KERNEL(Sub, 7, float, Sub);
+REG_ELEMENTWISE_STRIDED_TYPED_KERNEL(Sub, 7, double, Sub);
 REG_ELEMENTWISE_TYPED_KERNEL(Sub, 7, int32_t, Sub);
 REG_ELEMENTWISE_TYPED_KERNEL(Sub, 7, int64_t, Sub);
 
-REG_ELEMENTWISE_TYPED_KERNEL(Mul, 7, float, Mul);
-REG_ELEMENTWISE_TYPED_KERNEL(Mul, 7, double, Mul);
+REG_ELEMENTWISE_STRIDED_TYPED_KERNEL(Mul, 7, float, Mul);
+REG_ELEMENTWISE_STRIDED_TYPED_KERNEL(Mul, 7, double, Mul);
 REG_ELEMENTWISE_TYPED_KERNEL(Mul, 7, int32_t, Mul);
 REG_ELEMENTWISE_TYPED_KERNEL(Mul, 7, int64_t, Mul);
+REG_ELEMENTWISE_TYPED_KERNEL(Mul, 7, MLFloat16, Mul);
 
-REG_ELEMENTWISE_TYPED_KERNEL(Div, 7, float, Div);
-REG_ELEMENTWISE_TYPED_KERNEL(Div, 7, double, Div);
+REG_ELEMENTWISE_STRIDED_TYPED_KERNEL(Div, 7, float, Div);
+REG_ELEMENTWISE_STRIDED_TYPED_KERNEL(Div, 7, double, Div);
 REG_ELEMENTWISE_TYPED_KERNEL(Div, 7, int32_t, Div);
 REG_ELEMENTWISE_TYPED_KERNEL(Div, 7, int64_t, Div);
 
@@ -201,6 +215,72 @@ Status Mul<T>::Compute(OpKernelContext* context) const {
       [](EigenVectorMap<T> output, ConstEigenVectorMap<T> input0, ConstEigenVectorMap<T> input1) { output = input0.cwiseProduct(input1); });
 }
 
+namespace {
+
+// Number of elements of a span that the half precision ops convert to float at a time. The chunks live on the
+// stack, so the op needs no temporary tensors and the converted values stay in the L1 cache.
+constexpr size_t kHalfChunkSize = 256;
+
+// Applies op(a, b, count), which computes a[i] = a[i] op b[i] in float, to a span of half precision values.
+// A scalar input is converted once and broadcast to a whole chunk.
+template <typename T, typename Op>
+void HalfSpan(gsl::span<T> output, const T* input0, bool scalar0, const T* input1, bool scalar1, Op op) {
+  float a[kHalfChunkSize];
+  float b[kHalfChunkSize];
+  const size_t size = output.size();
+  for (size_t offset = 0; offset < size; offset += kHalfChunkSize) {
+    const size_t count = std::min(kHalfChunkSize, size - offset);
+    if (scalar0) {
+      math::ConvertToFloat<T>(input0, a, 1);
+      std::fill_n(a + 1, count - 1, a[0]);
+    } else {
+      math::ConvertToFloat<T>(input0 + offset, a, count);
+    }
+    if (scalar1) {
+      math::ConvertToFloat<T>(input1, b, 1);
+      std::fill_n(b + 1, count - 1, b[0]);
+    } else {
+      math::ConvertToFloat<T>(input1 + offset, b, count);
+    }
+    op(a, b, count);
+    math::ConvertFromFloat<T>(a, output.data() + offset, count);
+  }
+}
+
+template <typename T, typename Op>
+Status BroadcastTwoHalf(OpKernelContext& context, Op op) {
+  TBroadcaster<T, T> bc(*context.Input<Tensor>(0), *context.Input<Tensor>(1));
+  TBroadcastOutput<T> output(bc.GetSpanSize(), *context.Output(0, bc.GetOutputShape()));
+  BroadcastLoopSpan(
+      bc, output,
+      [op](gsl::span<T> output, const T& input0, gsl::span<const T> input1) {
+        HalfSpan(output, &input0, true, input1.data(), false, op);
+      },
+      [op](gsl::span<T> output, gsl::span<const T> input0, const T& input1) {
+        HalfSpan(output, input0.data(), false, &input1, true, op);
+      },
+      [op](gsl::span<T> output, gsl::span<const T> input0, gsl::span<const T> input1) {
+        HalfSpan(output, input0.data(), false, input1.data(), false, op);
+      });
+  return Status::OK();
+}
+
+}  // namespace
+
+template <>
+Status Add<MLFloat16>::Compute(OpKernelContext* context) const {
+  return BroadcastTwoHalf<MLFloat16>(*context, [](float* a, const float* b, size_t count) {
+    for (size_t i = 0; i < count; i++) a[i] += b[i];
+  });
+}
+
+template <>
+Status Mul<MLFloat16>::Compute(OpKernelContext* context) const {
+  return BroadcastTwoHalf<MLFloat16>(*context, [](float* a, const float* b, size_t count) {
+    for (size_t i = 0; i < count; i++) a[i] *= b[i];
+  });
+}
+
 template <typename T>
 Status Div<T>::Compute(OpKernelContext* context) const {
   return BroadcastTwo<T, T>(
@@ -902,8 +982,27 @@ Status Expand_8<T>::Compute(OpKernelContext* context) const {
   const auto* p_shape = tensor_shape.template Data<int64_t>();
   std::vector<int64_t> shape{p_shape, p_shape + tensor_shape.Shape().Size()};
 
-  TBroadcasterExpand<T> bc(*context->Input<Tensor>(0), shape);
-  TBroadcastOutput<T> output(bc.GetSpanSize(), *context->Output(0, bc.GetOutputShape()));
+  const auto& input = *context->Input<Tensor>(0);
+  TBroadcasterExpand<T> bc(input, shape);
+  auto& output_tensor = *context->Output(0, bc.GetOutputShape());
+
+  if (context->IsStridedViewOutput(0)) {
+    // the output shares the input buffer: broadcast dims repeat the same elements with a stride of 0
+    ORT_ENFORCE(output_tensor.DataRaw() == input.DataRaw());
+    const auto& input_dims = input.Shape().GetDims();
+    const auto& output_dims = output_tensor.Shape().GetDims();
+    const auto input_strides = input.Strides();
+    const size_t rank_offset = output_dims.size() - input_dims.size();
+    std::vector<int64_t> output_strides(output_dims.size(), 0);
+    for (size_t i = 0; i < input_dims.size(); ++i) {
+      if (input_dims[i] == output_dims[i + rank_offset])
+        output_strides[i + rank_offset] = input_strides[i];
+    }
+    output_tensor.SetStridedView(output_strides, input.ByteOffset());
+    return Status::OK();
+  }
+
+  TBroadcastOutput<T> output(bc.GetSpanSize(), output_tensor);
 
   // This doesn't use BroadcastLoop since there is no second tensor, just duplicating the first
   if (bc.IsInput0Scalar()) {
@@ -923,7 +1022,9 @@ Status Expand_8<T>::Compute(OpKernelContext* context) const {
       Expand,                                                                      \
       8,                                                                           \
       TYPE,                                                                        \
-      KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>()), \
+      KernelDefBuilder()                                                           \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>())                \
+          .MayStridedOutput(0, 0),                                                 \
       Expand_8<TYPE>);
 
 REG_EXPAND_KERNEL(float)
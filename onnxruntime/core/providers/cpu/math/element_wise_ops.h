@@ -6,6 +6,7 @@
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 #include "core/util/math_cpuonly.h"
+#include "core/providers/cpu/tensor/utils.h"
 
 namespace onnxruntime {
 
@@ -612,7 +613,20 @@ void BroadcastLoopSpan(TBroadcaster& bc, Output& output, Input0Scalar input0scal
 
 template <typename TInput, typename TOutput, typename Input0Scalar, typename Input1Scalar, typename General>
 Status BroadcastTwo(OpKernelContext& context, Input0Scalar input0scalar, Input1Scalar input1scalar, General general) {
-  TBroadcaster<TInput, TInput> bc(*context.Input<Tensor>(0), *context.Input<Tensor>(1));
+  const Tensor* input0 = context.Input<Tensor>(0);
+  const Tensor* input1 = context.Input<Tensor>(1);
+
+  // kernels registered with MayStridedInput read contiguous views in place and copy only the others
+  std::unique_ptr<Tensor> contiguous0;
+  std::unique_ptr<Tensor> contiguous1;
+  if (!input0->IsContiguous() || !input1->IsContiguous()) {
+    AllocatorPtr allocator;
+    ORT_RETURN_IF_ERROR(context.GetTempSpaceAllocator(&allocator));
+    input0 = &MakeContiguousCpuTensor(*input0, allocator, contiguous0);
+    input1 = &MakeContiguousCpuTensor(*input1, allocator, contiguous1);
+  }
+
+  TBroadcaster<TInput, TInput> bc(*input0, *input1);
   TBroadcastOutput<TOutput> output(bc.GetSpanSize(), *context.Output(0, bc.GetOutputShape()));
   BroadcastLoop(bc, output, input0scalar, input1scalar, general);
 
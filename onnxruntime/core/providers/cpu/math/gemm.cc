@@ -3,8 +3,76 @@
 
 #include "core/providers/cpu/math/gemm.h"
 
+#include "core/mlas/inc/mlas.h"
+
 namespace onnxruntime {
 
+// Half precision Gemm computes in float: the bias is broadcast into a float scratch output, MLAS converts the
+// panels of A and B to float as it packs them, and the output is rounded to half precision once at the end.
+template <>
+Status Gemm<MLFloat16>::Compute(OpKernelContext* context) const {
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+
+  const auto* X = context->Input<Tensor>(0);
+  const auto* W = context->Input<Tensor>(1);
+  const auto* B = context->Input<Tensor>(2);
+  GemmHelper helper(X->Shape(), trans_A_ != CblasNoTrans, W->Shape(), trans_B_ != CblasNoTrans,
+                    B != nullptr ? B->Shape() : TensorShape({}));
+
+  if (!helper.State().IsOK())
+    return helper.State();
+
+  int64_t M = helper.M();
+  int64_t N = helper.N();
+  int64_t K = helper.K();
+  auto Y = context->Output(0, {M, N});
+  if (M == 0 || N == 0)
+    return Status::OK();
+
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+  auto y_float = IAllocator::MakeUniquePtr<float>(alloc, static_cast<size_t>(M * N));
+  float* y_data = y_float.get();
+
+  const bool use_bias = beta_ != 0 && B != nullptr;
+  if (use_bias) {
+    const auto& b_shape = B->Shape();
+    const auto* b_data = B->template Data<MLFloat16>();
+    auto output_mat = EigenMatrixMapRowMajor<float>(y_data, M, N);
+    if (b_shape.Size() == 1) {
+      // B is (), (1,) or (1, 1), set the scalar
+      output_mat.setConstant(math::halfToFloat(b_data->val));
+    } else if (b_shape.NumDimensions() == 1 || b_shape[0] == 1) {
+      // B is (N,) or (1, N)
+      std::vector<float> bias(static_cast<size_t>(N));
+      math::ConvertToFloat<MLFloat16>(b_data, bias.data(), bias.size());
+      output_mat.rowwise() = ConstEigenVectorMap<float>(bias.data(), N).transpose();
+    } else if (b_shape[1] == 1) {
+      // B is (M, 1)
+      std::vector<float> bias(static_cast<size_t>(M));
+      math::ConvertToFloat<MLFloat16>(b_data, bias.data(), bias.size());
+      output_mat.colwise() = ConstEigenVectorMap<float>(bias.data(), M);
+    } else {
+      // B is (M, N), no broadcast needed.
+      math::ConvertToFloat<MLFloat16>(b_data, y_data, static_cast<size_t>(M * N));
+    }
+  }
+
+  MlasHalfGemm(MlasHalfFloat16, trans_A_, trans_B_, static_cast<size_t>(M), static_cast<size_t>(N),
+               static_cast<size_t>(K), alpha_,
+               reinterpret_cast<const unsigned short*>(X->template Data<MLFloat16>()),
+               static_cast<size_t>(trans_A_ == CblasNoTrans ? K : M),
+               reinterpret_cast<const unsigned short*>(W->template Data<MLFloat16>()),
+               static_cast<size_t>(trans_B_ == CblasNoTrans ? N : K),
+               use_bias ? beta_ : 0.0f, y_data, static_cast<size_t>(N), thread_pool);
+
+  FuseActivation<float>(activation_, y_data, M * N, leaky_relu_alpha_);
+
+  math::ConvertFromFloat<MLFloat16>(y_data, Y->template MutableData<MLFloat16>(), static_cast<size_t>(M * N));
+
+  return Status::OK();
+}
+
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Gemm,
     7,
@@ -26,4 +94,27 @@ ONNX_CPU_OPERATOR_KERNEL(
     11,
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Gemm<float>);
+
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    Gemm,
+    7,
+    8,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Gemm<MLFloat16>);
+
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    Gemm,
+    9,
+    10,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Gemm<MLFloat16>);
+
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    Gemm,
+    11,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Gemm<MLFloat16>);
 }  // namespace onnxruntime
@@ -4,6 +4,8 @@
 #include "core/providers/cpu/math/matmul.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/providers/cpu/tensor/utils.h"
 #include "matmul_helper.h"
 
 namespace onnxruntime {
@@ -12,7 +14,10 @@ ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     MatMul,
     1, 8,
     float,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .MayStridedInput(0)
+        .MayStridedInput(1),
     MatMul<float>);
 
 ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
@@ -22,12 +27,22 @@ ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<double>()),
     MatMul<double>);
 
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    MatMul,
+    1, 8,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    MatMul<MLFloat16>);
+
 // opset 9 supports more types
 ONNX_CPU_OPERATOR_TYPED_KERNEL(
     MatMul,
     9,
     float,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .MayStridedInput(0)
+        .MayStridedInput(1),
     MatMul<float>);
 
 ONNX_CPU_OPERATOR_TYPED_KERNEL(
@@ -37,6 +52,13 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<double>()),
     MatMul<double>);
 
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    MatMul,
+    9,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    MatMul<MLFloat16>);
+
 ONNX_CPU_OPERATOR_TYPED_KERNEL(
     MatMul,
     9,
@@ -65,6 +87,123 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<uint64_t>()),
     MatMul<uint64_t>);
 
+namespace {
+
+// Describes how the rows x cols matrices of a MatMul input that may be a strided view are read by the GEMM:
+// either row-major with a leading dimension, or transposed (column-major) with a leading dimension.
+struct StridedMatrices {
+  CBLAS_TRANSPOSE trans;
+  size_t ld;
+  std::vector<size_t> offsets;
+};
+
+// Returns false if the matrices of the view cannot be described by a leading dimension and an offset per matrix.
+// dense_offsets are the offsets of the matrices if the input was dense, as computed by MatMulComputeHelper.
+bool GetStridedMatrices(const Tensor& X, int64_t rows, int64_t cols, const std::vector<size_t>& dense_offsets,
+                        StridedMatrices& matrices) {
+  const auto& dims = X.Shape().GetDims();
+  const auto strides = X.Strides();
+  const size_t rank = dims.size();
+  if (rank < 2 || dims[rank - 1] != cols || rows == 0 || cols == 0) {
+    return false;
+  }
+  for (auto stride : strides) {
+    if (stride < 0) {
+      return false;
+    }
+  }
+
+  // the rows are dims [row_begin, rank - 1), which is more than one dim if MatMulComputeHelper flattened the
+  // leading dims of the input into the rows. the rows must then be evenly spaced across those dims.
+  size_t row_begin = rank - 2;
+  if (dims[row_begin] != rows) {
+    while (row_begin > 0 && X.Shape().SizeFromDimension(row_begin) / cols < rows) {
+      --row_begin;
+    }
+    if (X.Shape().SizeFromDimension(row_begin) / cols != rows) {
+      return false;
+    }
+  }
+
+  int64_t row_stride = -1;
+  int64_t inner_dim = 1;
+  for (size_t i = rank - 1; i-- > row_begin;) {
+    if (dims[i] == 1) {
+      continue;
+    }
+    if (row_stride >= 0 && strides[i] != row_stride * inner_dim) {
+      return false;
+    }
+    if (row_stride < 0) {
+      row_stride = strides[i];
+    }
+    inner_dim *= dims[i];
+  }
+  const int64_t col_stride = cols == 1 ? 1 : strides[rank - 1];
+
+  if (col_stride == 1 && (rows == 1 || row_stride >= cols)) {
+    matrices.trans = CblasNoTrans;
+    matrices.ld = static_cast<size_t>(rows == 1 ? cols : row_stride);
+  } else if ((rows == 1 || row_stride == 1) && col_stride >= rows) {
+    matrices.trans = CblasTrans;
+    matrices.ld = static_cast<size_t>(col_stride);
+  } else {
+    return false;
+  }
+
+  // map the index of each matrix over the batch dims [0, row_begin) to its offset in the view
+  const size_t matrix_size = static_cast<size_t>(rows * cols);
+  matrices.offsets.resize(dense_offsets.size());
+  for (size_t i = 0; i < dense_offsets.size(); ++i) {
+    size_t index = dense_offsets[i] / matrix_size;
+    size_t offset = 0;
+    for (size_t axis = row_begin; axis-- > 0;) {
+      offset += (index % static_cast<size_t>(dims[axis])) * static_cast<size_t>(strides[axis]);
+      index /= static_cast<size_t>(dims[axis]);
+    }
+    matrices.offsets[i] = offset;
+  }
+  return true;
+}
+
+// Computes a MatMul whose inputs are strided views without copying them, if the GEMM can read them directly.
+template <typename T>
+bool TryMatMulStrided(const MatMulComputeHelper& /*helper*/, const Tensor& /*left_X*/, const Tensor& /*right_X*/,
+                      Tensor& /*Y*/, concurrency::ThreadPool* /*thread_pool*/) {
+  return false;
+}
+
+template <>
+bool TryMatMulStrided<float>(const MatMulComputeHelper& helper, const Tensor& left_X, const Tensor& right_X,
+                             Tensor& Y, concurrency::ThreadPool* thread_pool) {
+  StridedMatrices left;
+  StridedMatrices right;
+  if (!GetStridedMatrices(left_X, helper.M(), helper.K(), helper.LeftOffsets(), left) ||
+      !GetStridedMatrices(right_X, helper.K(), helper.N(), helper.RightOffsets(), right)) {
+    return false;
+  }
+
+  const float* A = left_X.Data<float>();
+  const float* B = right_X.Data<float>();
+  float* C = Y.MutableData<float>();
+  const size_t batch_size = helper.OutputOffsets().size();
+
+  std::vector<MLAS_SGEMM_DATA_PARAMS> data(batch_size);
+  for (size_t i = 0; i < batch_size; i++) {
+    data[i].A = A + left.offsets[i];
+    data[i].lda = left.ld;
+    data[i].B = B + right.offsets[i];
+    data[i].ldb = right.ld;
+    data[i].C = C + helper.OutputOffsets()[i];
+    data[i].ldc = static_cast<size_t>(helper.N());
+  }
+  MlasGemmBatch(left.trans, right.trans, static_cast<size_t>(helper.M()), static_cast<size_t>(helper.N()),
+                static_cast<size_t>(helper.K()), 1.f, data.data(), batch_size, 0.f, thread_pool);
+  return true;
+}
+
+}  // namespace
+
 template <typename T>
 Status MatMul<T>::Compute(OpKernelContext* ctx) const {
   concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
@@ -77,17 +216,34 @@ Status MatMul<T>::Compute(OpKernelContext* ctx) const {
 
   Tensor* Y = ctx->Output(0, helper.OutputShape());
 
-  size_t max_len = helper.OutputOffsets().size();
-  for (size_t i = 0; i < max_len; i++) {
-    math::MatMul<T>(
-        static_cast<int>(helper.M()),
-        static_cast<int>(helper.N()),
-        static_cast<int>(helper.K()),
-        left_X->template Data<T>() + helper.LeftOffsets()[i],
-        right_X->template Data<T>() + helper.RightOffsets()[i],
-        Y->template MutableData<T>() + helper.OutputOffsets()[i], thread_pool);
+  // inputs that are strided views are passed to the GEMM with their leading dimensions if possible,
+  // otherwise they are copied to dense tensors
+  std::unique_ptr<Tensor> contiguous_left;
+  std::unique_ptr<Tensor> contiguous_right;
+  if (!left_X->IsContiguous() || !right_X->IsContiguous()) {
+    if (helper.OutputShape().Size() == 0 || TryMatMulStrided<T>(helper, *left_X, *right_X, *Y, thread_pool)) {
+      return Status::OK();
+    }
+    AllocatorPtr allocator;
+    ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&allocator));
+    left_X = &MakeContiguousCpuTensor(*left_X, allocator, contiguous_left);
+    right_X = &MakeContiguousCpuTensor(*right_X, allocator, contiguous_right);
   }
 
+  // run all the matrices of a broadcasted/batched MatMul as one batch so the thread pool is shared across them
+  math::MatMulBatch<T>(
+      static_cast<int>(helper.M()),
+      static_cast<int>(helper.N()),
+      static_cast<int>(helper.K()),
+      helper.OutputOffsets().size(),
+      left_X->template Data<T>(),
+      helper.LeftOffsets().data(),
+      right_X->template Data<T>(),
+      helper.RightOffsets().data(),
+      Y->template MutableData<T>(),
+      helper.OutputOffsets().data(),
+      thread_pool);
+
   return Status::OK();
 }
 
@@ -6,6 +6,7 @@
 #include <vector>
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/providers/cpu/ml/lookup_table.h"
 
 namespace onnxruntime {
 namespace ml {
@@ -16,24 +17,40 @@ class DictVectorizerOp final : public OpKernel {
     //In some stupid models, the vocabulary could have duplicated elements.
     //We must support that, otherwise some tests will be break.
     ORT_ENFORCE(info.GetAttrs(std::is_same<AttrType, std::string>::value ? "string_vocabulary" : "int64_vocabulary", vocabulary_).IsOK());
+
+    // Each word maps to its first position in the output, and the positions of its duplicates are chained through
+    // next_position_.
+    next_position_.assign(vocabulary_.size(), -1);
+    position_of_word_.Reserve(vocabulary_.size());
+    for (size_t i = vocabulary_.size(); i-- > 0;) {
+      const int64_t* next = position_of_word_.Find(vocabulary_[i]);
+      if (next != nullptr) {
+        next_position_[i] = *next;
+      }
+      position_of_word_.Insert(vocabulary_[i], static_cast<int64_t>(i));
+    }
   }
   common::Status Compute(OpKernelContext* ctx) const override {
     auto map = ctx->Input<std::map<AttrType, TargetType> >(0);
     auto Y = ctx->Output(0, TensorShape({1, static_cast<int64_t>(vocabulary_.size())}));
     auto* y_data = Y->template MutableData<TargetType>();
-    for (size_t i = 0, end = vocabulary_.size(); i < end; ++i) {
-      auto index = map->find(vocabulary_[i]);
-      if (index != map->end()) {
-        *y_data++ = index->second;
-      } else {
-        //Any keys not present in the input dictionary, will be zero in the output array
-        *y_data++ = TargetType();
+    //Any keys not present in the input dictionary, will be zero in the output array
+    std::fill_n(y_data, vocabulary_.size(), TargetType());
+    for (const auto& entry : *map) {
+      const int64_t* position = position_of_word_.Find(entry.first);
+      if (position == nullptr) {
+        continue;
+      }
+      for (int64_t i = *position; i >= 0; i = next_position_[i]) {
+        y_data[i] = entry.second;
       }
     }
     return Status::OK();
   }
 
   std::vector<AttrType> vocabulary_;
+  FlatLookupTable<AttrType, int64_t> position_of_word_;
+  std::vector<int64_t> next_position_;
 };
 
 }  // namespace ml
@@ -3,6 +3,8 @@
 
 #include "core/providers/cpu/ml/linearclassifier.h"
 
+#include <algorithm>
+
 namespace onnxruntime {
 namespace ml {
 
@@ -52,6 +54,18 @@ LinearClassifier<T>::LinearClassifier(const OpKernelInfo& info) : OpKernel(info)
   class_count_ = static_cast<int64_t>(intercepts_.size());
 }
 
+// Returns the N x stride input as float, converting it into buffer when it is not float.
+template <typename T>
+static const float* InputAsFloat(const T* x_data, int64_t count, std::vector<float>& buffer) {
+  buffer.resize(static_cast<size_t>(count));
+  std::transform(x_data, x_data + count, buffer.begin(), [](T value) { return static_cast<float>(value); });
+  return buffer.data();
+}
+
+static const float* InputAsFloat(const float* x_data, int64_t /*count*/, std::vector<float>& /*buffer*/) {
+  return x_data;
+}
+
 template <typename T>
 Status LinearClassifier<T>::Compute(OpKernelContext* ctx) const {
   const auto* X = ctx->Input<Tensor>(0);
@@ -63,6 +77,10 @@ Status LinearClassifier<T>::Compute(OpKernelContext* ctx) const {
 
   int64_t stride = shape.NumDimensions() == 1 ? shape[0] : shape[1];
   int64_t N = shape.NumDimensions() == 1 ? 1 : shape[0];
+  if (static_cast<int64_t>(coefficients_.size()) != class_count_ * stride) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input has ", stride, " features but the model has ",
+                           coefficients_.size(), " coefficients for ", class_count_, " classes.");
+  }
   Tensor* Y = ctx->Output(0, TensorShape({N}));
 
   int64_t output_classes = class_count_;
@@ -73,32 +91,40 @@ Status LinearClassifier<T>::Compute(OpKernelContext* ctx) const {
   }
   Tensor* Z = ctx->Output(1, TensorShape({N, output_classes}));
 
-  int64_t zindex = 0;
-  const auto* x_data = X->template Data<T>();
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+
+  std::vector<float> x_buffer;
+  const float* x = InputAsFloat(X->template Data<T>(), N * stride, x_buffer);
 
-  auto class_count = static_cast<size_t>(class_count_);
-  std::vector<float> scores;
-  scores.reserve(class_count);
-  for (int64_t i = 0; i < N; i++)  //for each point
-  {
-    scores.clear();
-    size_t current_weight_0 = i * stride;
+  // The scores of all the rows are computed by one GEMM, with the intercepts folded in as the initial value of the
+  // output. Rows of two or more scores are computed directly in Z and transformed in place, binary scores go
+  // through a buffer as write_scores expands them.
+  const bool scores_in_output = class_count_ >= 2;
+  std::vector<float> score_buffer;
+  float* scores;
+  if (scores_in_output) {
+    scores = Z->template MutableData<float>();
+  } else {
+    score_buffer.resize(static_cast<size_t>(N * class_count_));
+    scores = score_buffer.data();
+  }
+  for (int64_t i = 0; i < N; i++) {
+    std::copy(intercepts_.begin(), intercepts_.end(), scores + i * class_count_);
+  }
+  MlasGemm(CblasNoTrans, CblasTrans, static_cast<size_t>(N), static_cast<size_t>(class_count_),
+           static_cast<size_t>(stride), 1.f, x, static_cast<size_t>(stride), coefficients_.data(),
+           static_cast<size_t>(stride), 1.f, scores, static_cast<size_t>(class_count_), tp);
+
+  const int64_t written_count = written_score_count(static_cast<size_t>(class_count_), post_transform_,
+                                                    add_second_class ? 0 : -1);
+
+  auto compute_row = [&](int64_t i) {
+    float* row = scores + i * class_count_;
     int maxclass = -1;
     float maxweight = 0.f;
-    for (int j = 0; j < class_count_; j++)  // for each class
-    {
-      size_t current_coeff_0 = j * stride;
-      float weight = 0.f;
-      for (int64_t k = 0; k < stride; k++)  //for each weight
-      {
-        weight += static_cast<float>(x_data[current_weight_0 + k] * coefficients_[current_coeff_0 + k]);
-      }
-      if (intercepts_.size() == class_count) {
-        weight += intercepts_[j];
-      }
-      scores.push_back(weight);
-      if (weight > maxweight || maxclass == -1) {
-        maxweight = weight;
+    for (int j = 0; j < class_count_; j++) {
+      if (row[j] > maxweight || maxclass == -1) {
+        maxweight = row[j];
         maxclass = j;
       }
     }
@@ -136,15 +162,23 @@ Status LinearClassifier<T>::Compute(OpKernelContext* ctx) const {
       }
     }
     //write float values
-    if (add_second_class && maxweight > 0) {
-      ::onnxruntime::ml::write_scores(scores, post_transform_, zindex, Z, 0);
-    } else if (add_second_class) {
-      ::onnxruntime::ml::write_scores(scores, post_transform_, zindex, Z, 1);
+    if (scores_in_output) {
+      update_scores(row, static_cast<size_t>(class_count_), post_transform_);
     } else {
-      ::onnxruntime::ml::write_scores(scores, post_transform_, zindex, Z, -1);
+      std::vector<float> row_scores(row, row + class_count_);
+      if (add_second_class && maxweight > 0) {
+        ::onnxruntime::ml::write_scores(row_scores, post_transform_, i * written_count, Z, 0);
+      } else if (add_second_class) {
+        ::onnxruntime::ml::write_scores(row_scores, post_transform_, i * written_count, Z, 1);
+      } else {
+        ::onnxruntime::ml::write_scores(row_scores, post_transform_, i * written_count, Z, -1);
+      }
     }
-    zindex += scores.size();
-  }  //for each point
+  };
+
+  concurrency::ThreadPool::TryBatchParallelFor(tp, static_cast<int32_t>(N), [&](int32_t i) {
+    compute_row(i);
+  });
   return Status::OK();
 }
 
@@ -0,0 +1,195 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/cpu/tensor/copy.h"
+
+namespace onnxruntime {
+namespace ml {
+
+namespace lookup_detail {
+
+// MurmurHash3 finalization mix, which spreads every bit of the input over the whole hash.
+inline uint64_t MixHash(uint64_t h) {
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h;
+}
+
+inline uint64_t HashKey(int64_t key) {
+  return MixHash(static_cast<uint64_t>(key));
+}
+
+inline uint64_t HashKey(float key) {
+  // 0.0 and -0.0 compare equal so they must hash the same
+  if (key == 0.f) {
+    key = 0.f;
+  }
+  uint32_t bits;
+  memcpy(&bits, &key, sizeof(bits));
+  return MixHash(bits);
+}
+
+// MurmurHash64A, reading the string 8 bytes at a time.
+inline uint64_t HashKey(const std::string& key) {
+  constexpr uint64_t m = 0xc6a4a7935bd1e995ULL;
+  constexpr int r = 47;
+  const size_t len = key.size();
+  const unsigned char* data = reinterpret_cast<const unsigned char*>(key.data());
+  const unsigned char* end = data + (len & ~size_t{7});
+  uint64_t h = 0x8445d61a4e774912ULL ^ (len * m);
+
+  for (; data != end; data += 8) {
+    uint64_t k;
+    memcpy(&k, data, sizeof(k));
+    k *= m;
+    k ^= k >> r;
+    k *= m;
+    h ^= k;
+    h *= m;
+  }
+
+  uint64_t tail = 0;
+  switch (len & 7) {
+    case 7: tail ^= uint64_t{data[6]} << 48;  // fall through
+    case 6: tail ^= uint64_t{data[5]} << 40;  // fall through
+    case 5: tail ^= uint64_t{data[4]} << 32;  // fall through
+    case 4: tail ^= uint64_t{data[3]} << 24;  // fall through
+    case 3: tail ^= uint64_t{data[2]} << 16;  // fall through
+    case 2: tail ^= uint64_t{data[1]} << 8;   // fall through
+    case 1:
+      tail ^= uint64_t{data[0]};
+      h ^= tail;
+      h *= m;
+  }
+
+  h ^= h >> r;
+  h *= m;
+  h ^= h >> r;
+  return h;
+}
+
+}  // namespace lookup_detail
+
+// Hash table for the key sets of the encoder kernels (LabelEncoder, CategoryMapper, DictVectorizer). The table is
+// filled when the kernel is created and only read afterwards, so it uses open addressing with linear probing over
+// an array of slots that are half empty at most. Each slot holds the upper bits of the hash of its key next to the
+// index of its entry, so a probe only reads a key when the hashes agree.
+template <typename TKey, typename TValue>
+class FlatLookupTable {
+ public:
+  FlatLookupTable() = default;
+
+  void Reserve(size_t count) {
+    if (count * 2 > slots_.size()) {
+      Rehash(count * 2);
+    }
+    keys_.reserve(count);
+    values_.reserve(count);
+  }
+
+  // Maps key to value. When the key is already in the table its value is replaced, as assigning through
+  // std::unordered_map::operator[] would.
+  void Insert(const TKey& key, const TValue& value) {
+    if ((keys_.size() + 1) * 2 > slots_.size()) {
+      Rehash(std::max<size_t>(16, slots_.size() * 2));
+    }
+    const uint64_t hash = lookup_detail::HashKey(key);
+    const uint32_t tag = Tag(hash);
+    for (size_t i = hash & mask_;; i = (i + 1) & mask_) {
+      Slot& slot = slots_[i];
+      if (slot.entry == 0) {
+        keys_.push_back(key);
+        values_.push_back(value);
+        slot.tag = tag;
+        slot.entry = static_cast<uint32_t>(keys_.size());
+        return;
+      }
+      if (slot.tag == tag && keys_[slot.entry - 1] == key) {
+        values_[slot.entry - 1] = value;
+        return;
+      }
+    }
+  }
+
+  // Returns the value of key, or nullptr when the key is not in the table.
+  const TValue* Find(const TKey& key) const {
+    if (keys_.empty()) {
+      return nullptr;
+    }
+    const uint64_t hash = lookup_detail::HashKey(key);
+    const uint32_t tag = Tag(hash);
+    for (size_t i = hash & mask_;; i = (i + 1) & mask_) {
+      const Slot& slot = slots_[i];
+      if (slot.entry == 0) {
+        return nullptr;
+      }
+      if (slot.tag == tag && keys_[slot.entry - 1] == key) {
+        return &values_[slot.entry - 1];
+      }
+    }
+  }
+
+  size_t Size() const { return keys_.size(); }
+
+ private:
+  struct Slot {
+    uint32_t tag;    // upper bits of the hash of the key
+    uint32_t entry;  // index of the entry plus one, zero for an empty slot
+  };
+
+  static uint32_t Tag(uint64_t hash) { return static_cast<uint32_t>(hash >> 32); }
+
+  void Rehash(size_t min_slots) {
+    size_t slot_count = 16;
+    while (slot_count < min_slots) {
+      slot_count *= 2;
+    }
+    ORT_ENFORCE(slot_count <= std::numeric_limits<uint32_t>::max(), "Too many keys for the lookup table.");
+    slots_.assign(slot_count, Slot{0, 0});
+    mask_ = slot_count - 1;
+    for (size_t e = 0; e < keys_.size(); ++e) {
+      const uint64_t hash = lookup_detail::HashKey(keys_[e]);
+      size_t i = hash & mask_;
+      while (slots_[i].entry != 0) {
+        i = (i + 1) & mask_;
+      }
+      slots_[i].tag = Tag(hash);
+      slots_[i].entry = static_cast<uint32_t>(e + 1);
+    }
+  }
+
+  std::vector<Slot> slots_;
+  size_t mask_ = 0;
+  std::vector<TKey> keys_;
+  std::vector<TValue> values_;
+};
+
+// Writes fn(input[i]) to output[i] for the count elements of the input, splitting the elements over the thread
+// pool when there are enough of them.
+template <typename TIn, typename TOut, typename F>
+void ParallelLookup(concurrency::ThreadPool* tp, const TIn* input, TOut* output, int64_t count, const F& fn) {
+  // a lookup costs about as much as copying this many bytes, which sets how many lookups each thread gets
+  constexpr size_t kLookupCostBytes = 64;
+  ParallelForBlocks(tp, count, kLookupCostBytes, [&](int64_t first, int64_t last) {
+    for (int64_t i = first; i < last; ++i) {
+      output[i] = fn(input[i]);
+    }
+  });
+}
+
+}  // namespace ml
+}  // namespace onnxruntime
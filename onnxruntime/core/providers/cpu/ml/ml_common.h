@@ -4,6 +4,7 @@
 #pragma once
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/util/math_cpuonly.h"
 
 namespace onnxruntime {
@@ -250,33 +251,40 @@ static inline float sigmoid_probability(float score, float proba, float probb) {
   return 1 - ComputeLogistic(val);  // ref: https://github.com/arnaudsj/libsvm/blob/eaaefac5ebd32d0e07902e1ae740e038eaaf0826/svm.cpp#L1818
 }
 
-static inline void ComputeSoftmax(std::vector<float>& values) {
+static inline void ComputeSoftmax(float* values, size_t count) {
   // compute exp with negative number to be numerically stable
   float v_max = -std::numeric_limits<float>::max();
-  for (float value : values) {
-    if (value > v_max)
-      v_max = value;
+  for (size_t i = 0; i < count; i++) {
+    if (values[i] > v_max)
+      v_max = values[i];
   }
+  for (size_t i = 0; i < count; i++)
+    values[i] -= v_max;
+  MlasComputeExp(values, values, count);
   float this_sum = 0.f;
-  for (float& value : values) {
-    value = std::exp(value - v_max);
-    this_sum += value;
-  }
-  for (float& value : values)
-    value /= this_sum;
+  for (size_t i = 0; i < count; i++)
+    this_sum += values[i];
+  const float scale = 1.f / this_sum;
+  for (size_t i = 0; i < count; i++)
+    values[i] *= scale;
+}
+
+static inline void ComputeSoftmax(std::vector<float>& values) {
+  ComputeSoftmax(values.data(), values.size());
 }
 
 //this function skips zero values (since exp(0) is non zero)
-static inline void ComputeSoftmaxZero(std::vector<float>& values) {
+static inline void ComputeSoftmaxZero(float* values, size_t count) {
   // compute exp with negative number to be numerically stable
   float v_max = -std::numeric_limits<float>::max();
-  for (float value : values) {
-    if (value > v_max)
-      v_max = value;
+  for (size_t i = 0; i < count; i++) {
+    if (values[i] > v_max)
+      v_max = values[i];
   }
   float exp_neg_v_max = std::exp(-v_max);
   float this_sum = 0.f;
-  for (float& value : values) {
+  for (size_t i = 0; i < count; i++) {
+    float& value = values[i];
     if (value > 0.0000001f || value < -0.0000001f) {
       value = std::exp(value - v_max);
       this_sum += value;
@@ -284,33 +292,53 @@ static inline void ComputeSoftmaxZero(std::vector<float>& values) {
       value *= exp_neg_v_max;
     }
   }
-  for (float& value : values)
-    value /= this_sum;
+  for (size_t i = 0; i < count; i++)
+    values[i] /= this_sum;
+}
+
+static inline void ComputeSoftmaxZero(std::vector<float>& values) {
+  ComputeSoftmaxZero(values.data(), values.size());
+}
+
+// Applies the post transform in place to a row of two or more scores. This is the transform write_scores applies
+// to such rows, exposed so that kernels holding their scores in a matrix can transform the rows where they are.
+static inline void update_scores(float* scores, size_t count, POST_EVAL_TRANSFORM post_transform) {
+  switch (post_transform) {
+    case POST_EVAL_TRANSFORM::PROBIT:
+      for (size_t i = 0; i < count; i++)
+        scores[i] = ComputeProbit(scores[i]);
+      break;
+    case POST_EVAL_TRANSFORM::LOGISTIC:
+      MlasComputeLogistic(scores, scores, count);
+      break;
+    case POST_EVAL_TRANSFORM::SOFTMAX:
+      ComputeSoftmax(scores, count);
+      break;
+    case POST_EVAL_TRANSFORM::SOFTMAX_ZERO:
+      ComputeSoftmaxZero(scores, count);
+      break;
+    default:
+    case POST_EVAL_TRANSFORM::NONE:
+      break;
+  }
+}
+
+// Returns the number of values write_scores writes for score_count scores, which lets callers that process rows
+// in parallel find where each row starts.
+static inline int64_t written_score_count(size_t score_count, POST_EVAL_TRANSFORM post_transform,
+                                          int add_second_class) {
+  if (score_count == 1 && post_transform != POST_EVAL_TRANSFORM::PROBIT &&
+      add_second_class >= 0 && add_second_class <= 3) {
+    return 2;
+  }
+  return static_cast<int64_t>(score_count);
 }
 
 template <typename T>
 void write_scores(std::vector<T>& scores, POST_EVAL_TRANSFORM post_transform, int64_t write_index, Tensor* Z,
                   int add_second_class) {
   if (scores.size() >= 2) {
-    switch (post_transform) {
-      case POST_EVAL_TRANSFORM::PROBIT:
-        for (float& score : scores)
-          score = ComputeProbit(score);
-        break;
-      case POST_EVAL_TRANSFORM::LOGISTIC:
-        for (float& score : scores)
-          score = ComputeLogistic(score);
-        break;
-      case POST_EVAL_TRANSFORM::SOFTMAX:
-        ComputeSoftmax(scores);
-        break;
-      case POST_EVAL_TRANSFORM::SOFTMAX_ZERO:
-        ComputeSoftmaxZero(scores);
-        break;
-      default:
-      case POST_EVAL_TRANSFORM::NONE:
-        break;
-    }
+    update_scores(scores.data(), scores.size(), post_transform);
   } else if (scores.size() == 1) {  //binary case
     if (post_transform == POST_EVAL_TRANSFORM::PROBIT) {
       scores[0] = ComputeProbit(scores[0]);
@@ -66,6 +66,9 @@ SVMClassifier<T>::SVMClassifier(const OpKernelInfo& info)
   ORT_ENFORCE(classlabels_strings_.size() > 0 || classlabels_ints_.size() > 0);
   ORT_ENFORCE(proba_.size() == probb_.size());
   ORT_ENFORCE(coefficients_.size() > 0);
+  if (mode_ == SVM_TYPE::SVM_SVC && get_kernel_type() == KERNEL::RBF) {
+    support_vector_norms_ = squared_norms(support_vectors_, vector_count_, feature_count_);
+  }
   weights_are_all_positive_ = true;
   for (int64_t i = 0; i < static_cast<int64_t>(coefficients_.size()); i++) {
     if (coefficients_[i] < 0) {
@@ -108,6 +111,11 @@ Status SVMClassifier<T>::Compute(OpKernelContext* ctx) const {
   int64_t stride = X->Shape().NumDimensions() == 1 ? X->Shape()[0] : X->Shape()[1];
   int64_t N = X->Shape().NumDimensions() == 1 ? 1 : X->Shape()[0];
 
+  if (stride < feature_count_) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input has ", stride, " features but the model expects ",
+                           feature_count_);
+  }
+
   Tensor* Y = ctx->Output(0, TensorShape({N}));
 
   int64_t nb_columns = class_count_;
@@ -121,35 +129,36 @@ Status SVMClassifier<T>::Compute(OpKernelContext* ctx) const {
   std::vector<int64_t> dims{N, nb_columns};
   Tensor* Z = ctx->Output(1, TensorShape(dims));
 
+  if (vector_count_ == 0 && mode_ != SVM_TYPE::SVM_LINEAR)
+    return Status(common::ONNXRUNTIME, common::FAIL, "No support vectors.");
+
   const T* x_data = X->template Data<T>();
-  int64_t zindex = 0;
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+
+  // In SVC mode the kernels of a row against every support vector are combined by the one-vs-one votes, and in
+  // linear mode the scores of a row are its dot products with the coefficients of each class. Either way the
+  // values for a batch of rows come from one GEMM.
+  const bool linear = vector_count_ == 0;
+  const int64_t kernel_count = linear ? class_count_ : vector_count_;
+  const float* vectors = linear ? coefficients_.data() : support_vectors_.data();
+  const int64_t batch_size = kernel_batch_size(N, kernel_count);
+
+  std::vector<float> x_buffer;
+  std::vector<float> kernels(static_cast<size_t>(batch_size * kernel_count));
 
-  for (int64_t n = 0; n < N; n++)  //for each example
-  {
-    int64_t current_weight_0 = n * stride;
+  // votes, probabilities and the outputs of each row only depend on the row's kernels
+  auto compute_row = [&](int64_t n, const float* row_kernels) {
     int64_t maxclass = -1;
-    std::vector<float> decisions;
     std::vector<float> scores;
-    std::vector<float> kernels;
     std::vector<int64_t> votes;
 
-    if (vector_count_ == 0 && mode_ == SVM_TYPE::SVM_LINEAR) {
-      for (int64_t j = 0; j < class_count_; j++) {  //for each class
-        auto val = kernel_dot(x_data, current_weight_0, coefficients_, feature_count_ * j,
-                              feature_count_, get_kernel_type());
-        val += rho_[0];
-        scores.push_back(val);
-      }
+    if (linear) {
+      scores.resize(class_count_);
+      for (int64_t j = 0; j < class_count_; j++)  //for each class
+        scores[j] = row_kernels[j] + rho_[0];
     } else {
-      if (vector_count_ == 0)
-        return Status(common::ONNXRUNTIME, common::FAIL, "No support vectors.");
       int evals = 0;
-
-      for (int64_t j = 0; j < vector_count_; j++) {
-        auto val = kernel_dot(x_data, current_weight_0, support_vectors_, feature_count_ * j,
-                              feature_count_, get_kernel_type());
-        kernels.push_back(val);
-      }
+      scores.reserve(class_count_ * (class_count_ - 1) / 2);
       votes.resize(class_count_, 0);
       for (int64_t i = 0; i < class_count_; i++) {        // for each class
         for (int64_t j = i + 1; j < class_count_; j++) {  // for each class
@@ -163,12 +172,12 @@ Status SVMClassifier<T>::Compute(OpKernelContext* ctx) const {
           int64_t pos1 = (vector_count_) * (j - 1);
           int64_t pos2 = (vector_count_) * (i);
           const float* val1 = &(coefficients_[pos1 + start_index_i]);
-          const float* val2 = &(kernels[start_index_i]);
+          const float* val2 = row_kernels + start_index_i;
           for (int64_t m = 0; m < class_i_support_count; ++m, ++val1, ++val2)
             sum += *val1 * *val2;
 
           val1 = &(coefficients_[pos2 + start_index_j]);
-          val2 = &(kernels[start_index_j]);
+          val2 = row_kernels + start_index_j;
           for (int64_t m = 0; m < class_j_support_count; ++m, ++val1, ++val2)
             sum += *val1 * *val2;
 
@@ -236,8 +245,21 @@ Status SVMClassifier<T>::Compute(OpKernelContext* ctx) const {
       }
     }
 
+    // every row writes the same number of scores
+    int64_t zindex = n * written_score_count(scores.size(), post_transform_, write_additional_scores);
     write_scores(scores, post_transform_, zindex, Z, write_additional_scores);
-    zindex += scores.size();
+  };
+
+  for (int64_t first = 0; first < N; first += batch_size) {
+    const int64_t count = std::min(batch_size, N - first);
+    const float* x = rows_as_float(x_data, first, count, stride, x_buffer);
+
+    batched_kernel_dot(x, count, stride, vectors, support_vector_norms_.data(), kernel_count, feature_count_,
+                       get_kernel_type(), kernels.data(), tp);
+
+    concurrency::ThreadPool::TryBatchParallelFor(tp, static_cast<int32_t>(count), [&](int32_t i) {
+      compute_row(first + i, kernels.data() + i * kernel_count);
+    });
   }
 
   return Status::OK();
@@ -6,6 +6,8 @@
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 #include "core/util/math_cpuonly.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
 #include "ml_common.h"
 
 namespace onnxruntime {
@@ -29,31 +31,104 @@ class SVMCommon {
   void set_kernel_type(KERNEL new_kernel_type) { kernel_type_ = new_kernel_type; }
   KERNEL get_kernel_type() const { return kernel_type_; }
 
-  float kernel_dot(const T* A, int64_t a, const std::vector<float>& B, int64_t b, int64_t len, KERNEL k) const {
-    double sum = 0;
-    const T* pA = A + a;
-    const float* pB = B.data() + b;
+  // Computes the kernel of each of the N rows of X (ldx values apart) against each of the V rows of B into the
+  // N x V matrix out. The dot products of all the pairs are computed by one GEMM and the kernel function is then
+  // applied to the whole matrix. B_norms holds the squared norms of the rows of B and is only used by the RBF kernel.
+  void batched_kernel_dot(const float* X, int64_t N, int64_t ldx, const float* B, const double* B_norms, int64_t V,
+                          int64_t len, KERNEL k, float* out, concurrency::ThreadPool* tp) const {
+    const size_t count = static_cast<size_t>(N * V);
+    if (k == KERNEL::RBF) {
+      // |x - b|^2 = |x|^2 + |b|^2 - 2 x.b
+      MlasGemm(CblasNoTrans, CblasTrans, static_cast<size_t>(N), static_cast<size_t>(V), static_cast<size_t>(len),
+               -2.f, X, static_cast<size_t>(ldx), B, static_cast<size_t>(len), 0.f, out, static_cast<size_t>(V), tp);
+      for (int64_t n = 0; n < N; ++n) {
+        const float* x = X + n * ldx;
+        double x_norm = 0;
+        for (int64_t i = 0; i < len; ++i)
+          x_norm += static_cast<double>(x[i]) * x[i];
+        float* row = out + n * V;
+        for (int64_t j = 0; j < V; ++j) {
+          const double norms = x_norm + B_norms[j];
+          double distance = row[j] + norms;
+          // The float dot product is only accurate relative to the norms, so when x and b are close compared to
+          // their magnitude most of the digits cancel. Such distances are summed directly in double instead.
+          if (distance < norms * kRbfCancellationRatio)
+            distance = squared_distance(x, B + j * len, len);
+          row[j] = static_cast<float>(-gamma_ * std::max(distance, 0.));
+        }
+      }
+      MlasComputeExp(out, out, count);
+      return;
+    }
+
+    const float alpha = k == KERNEL::LINEAR ? 1.f : gamma_;
+    MlasGemm(CblasNoTrans, CblasTrans, static_cast<size_t>(N), static_cast<size_t>(V), static_cast<size_t>(len),
+             alpha, X, static_cast<size_t>(ldx), B, static_cast<size_t>(len), 0.f, out, static_cast<size_t>(V), tp);
     if (k == KERNEL::POLY) {
-      for (int64_t i = len; i > 0; --i, ++pA, ++pB)
-        sum += *pA * *pB;
-      sum = gamma_ * sum + coef0_;
-      sum = std::pow(sum, degree_);
-    } else if (k == KERNEL::SIGMOID) {
-      for (int64_t i = len; i > 0; --i, ++pA, ++pB)
-        sum += *pA * *pB;
-      sum = gamma_ * sum + coef0_;
-      sum = std::tanh(sum);
-    } else if (k == KERNEL::RBF) {
-      for (int64_t i = len; i > 0; --i, ++pA, ++pB) {
-        double val = *pA - *pB;
-        sum += val * val;
+      const int degree = static_cast<int>(degree_);
+      if (degree == degree_ && degree >= 0 && degree <= 16) {
+        // integer degrees are expanded into multiplications
+        for (size_t i = 0; i < count; ++i) {
+          const float base = out[i] + coef0_;
+          float value = 1.f;
+          for (int d = 0; d < degree; ++d)
+            value *= base;
+          out[i] = value;
+        }
+      } else {
+        for (size_t i = 0; i < count; ++i)
+          out[i] = std::pow(out[i] + coef0_, degree_);
       }
-      sum = std::exp(-gamma_ * sum);
-    } else if (k == KERNEL::LINEAR) {
-      for (int64_t i = len; i > 0; --i, ++pA, ++pB)
-        sum += *pA * *pB;
+    } else if (k == KERNEL::SIGMOID) {
+      for (size_t i = 0; i < count; ++i)
+        out[i] += coef0_;
+      MlasComputeTanh(out, out, count);
+    }
+  }
+
+  // Distances below this fraction of |x|^2 + |b|^2 are recomputed by squared_distance. The error of the expansion
+  // grows with the norms, so this bounds the error of the distances that are kept to a small multiple of it.
+  static constexpr double kRbfCancellationRatio = 1. / 64;
+
+  static double squared_distance(const float* x, const float* b, int64_t len) {
+    double sum = 0;
+    for (int64_t i = 0; i < len; ++i) {
+      const double diff = static_cast<double>(x[i]) - b[i];
+      sum += diff * diff;
+    }
+    return sum;
+  }
+
+  // Returns the number of rows whose kernels are computed together, bounded so that the kernels stay in the cache.
+  static int64_t kernel_batch_size(int64_t N, int64_t kernel_count) {
+    return std::max<int64_t>(1, std::min<int64_t>(N, (64 * 1024) / std::max<int64_t>(kernel_count, 1)));
+  }
+
+  // Returns the squared norms of the count rows of len values in B, as needed by batched_kernel_dot.
+  static std::vector<double> squared_norms(const std::vector<float>& B, int64_t count, int64_t len) {
+    std::vector<double> norms(count, 0.);
+    for (int64_t j = 0; j < count; ++j) {
+      const float* b = B.data() + j * len;
+      for (int64_t i = 0; i < len; ++i)
+        norms[j] += static_cast<double>(b[i]) * b[i];
     }
-    return (float)sum;
+    return norms;
+  }
+
+  // Returns the rows [first, first + count) of X (ldx values apart) as float, converting them into buffer when X
+  // is not float.
+  template <typename U>
+  static const float* rows_as_float(const U* X, int64_t first, int64_t count, int64_t ldx,
+                                    std::vector<float>& buffer) {
+    buffer.resize(static_cast<size_t>(count * ldx));
+    std::transform(X + first * ldx, X + (first + count) * ldx, buffer.begin(),
+                   [](U value) { return static_cast<float>(value); });
+    return buffer.data();
+  }
+
+  static const float* rows_as_float(const float* X, int64_t first, int64_t /*count*/, int64_t ldx,
+                                    std::vector<float>& /*buffer*/) {
+    return X + first * ldx;
   }
 
  private:
@@ -65,7 +140,10 @@ class SVMCommon {
 
 template <typename T>
 class SVMClassifier final : public OpKernel, private SVMCommon<T> {
-  using SVMCommon<T>::kernel_dot;
+  using SVMCommon<T>::batched_kernel_dot;
+  using SVMCommon<T>::kernel_batch_size;
+  using SVMCommon<T>::squared_norms;
+  using SVMCommon<T>::rows_as_float;
   using SVMCommon<T>::set_kernel_type;
   using SVMCommon<T>::get_kernel_type;
 
@@ -86,6 +164,7 @@ class SVMClassifier final : public OpKernel, private SVMCommon<T> {
   std::vector<float> probb_;
   std::vector<float> coefficients_;
   std::vector<float> support_vectors_;
+  std::vector<double> support_vector_norms_;  // squared norms of the support vectors for the RBF kernel
   std::vector<int64_t> classlabels_ints_;
   std::vector<std::string> classlabels_strings_;
   POST_EVAL_TRANSFORM post_transform_;
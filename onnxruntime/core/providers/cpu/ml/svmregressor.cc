@@ -29,6 +29,9 @@ SVMRegressor<T>::SVMRegressor(const OpKernelInfo& info)
   if (vector_count_ > 0) {
     feature_count_ = support_vectors_.size() / vector_count_;  //length of each support vector
     mode_ = SVM_TYPE::SVM_SVC;
+    if (get_kernel_type() == KERNEL::RBF) {
+      support_vector_norms_ = squared_norms(support_vectors_, vector_count_, feature_count_);
+    }
   } else {
     feature_count_ = coefficients_.size();
     mode_ = SVM_TYPE::SVM_LINEAR;
@@ -43,32 +46,48 @@ Status SVMRegressor<T>::Compute(OpKernelContext* ctx) const {
   int64_t stride = X->Shape().NumDimensions() == 1 ? X->Shape()[0] : X->Shape()[1];
   int64_t N = X->Shape().NumDimensions() == 1 ? 1 : X->Shape()[0];
 
+  if (stride < feature_count_) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input has ", stride, " features but the model expects ",
+                           feature_count_);
+  }
+
   Tensor* Y = ctx->Output(0, TensorShape({N, 1}));  // this op outputs for one target only
   const auto* x_data = X->template Data<T>();
+  float* y_data = Y->template MutableData<float>();
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
 
-  for (int64_t n = 0; n < N; n++) {  //for each example
-    int64_t current_weight_0 = n * stride;
-    std::vector<float> scores;
-
-    float sum = 0.f;
-    if (mode_ == SVM_TYPE::SVM_SVC) {
-      for (int64_t j = 0; j < vector_count_; j++) {
-        float val1 = kernel_dot(x_data, current_weight_0, support_vectors_, feature_count_ * j, feature_count_, get_kernel_type());
-        float val2 = coefficients_[j];
-        float val3 = val1 * val2;
-        sum += val3;
-      }
-      sum += rho_[0];
-    } else if (mode_ == SVM_TYPE::SVM_LINEAR) {  //liblinear
-      sum = kernel_dot(x_data, current_weight_0, coefficients_, 0, feature_count_, get_kernel_type());
-      sum += rho_[0];
+  std::vector<float> x_buffer;
+
+  if (mode_ == SVM_TYPE::SVM_SVC) {
+    // The kernels of a batch of rows against the support vectors come from one GEMM and are then weighted by the
+    // coefficients with a second one.
+    const int64_t batch_size = kernel_batch_size(N, vector_count_);
+    std::vector<float> kernels(static_cast<size_t>(batch_size * vector_count_));
+
+    for (int64_t first = 0; first < N; first += batch_size) {
+      const int64_t count = std::min(batch_size, N - first);
+      const float* x = rows_as_float(x_data, first, count, stride, x_buffer);
+
+      batched_kernel_dot(x, count, stride, support_vectors_.data(), support_vector_norms_.data(), vector_count_,
+                         feature_count_, get_kernel_type(), kernels.data(), tp);
+
+      MlasGemm(CblasNoTrans, CblasNoTrans, static_cast<size_t>(count), 1, static_cast<size_t>(vector_count_),
+               1.f, kernels.data(), static_cast<size_t>(vector_count_), coefficients_.data(), 1,
+               0.f, y_data + first, 1, tp);
     }
+  } else if (mode_ == SVM_TYPE::SVM_LINEAR) {  //liblinear
+    const float* x = rows_as_float(x_data, 0, N, stride, x_buffer);
+    batched_kernel_dot(x, N, stride, coefficients_.data(), nullptr, 1, feature_count_, get_kernel_type(), y_data, tp);
+  }
+
+  for (int64_t n = 0; n < N; n++) {  //for each example
+    float sum = y_data[n] + rho_[0];
     if (one_class_ && sum > 0) {
-      Y->template MutableData<float>()[n] = 1.f;
+      y_data[n] = 1.f;
     } else if (one_class_) {
-      Y->template MutableData<float>()[n] = -1.f;
+      y_data[n] = -1.f;
     } else {
-      Y->template MutableData<float>()[n] = sum;
+      y_data[n] = sum;
     }
   }
 
@@ -3,6 +3,7 @@
 
 #include "core/providers/cpu/ml/zipmap.h"
 #include "core/util/math_cpuonly.h"
+#include "core/platform/threadpool.h"
 /**
 https://github.com/onnx/onnx/blob/master/onnx/defs/traditionalml/defs.cc
 ONNX_OPERATOR_SCHEMA(ZipMap)
@@ -35,6 +36,34 @@ ONNX_CPU_OPERATOR_ML_KERNEL(
                                             DataTypeImpl::GetType<std::vector<std::map<std::int64_t, float>>>()}),
     ZipMapOp);
 
+// Builds one map per row. Every row has the same keys, so the first map is built with the keys inserted in order
+// at the end of the map, and the other rows copy its nodes and only replace the values, which avoids comparing
+// keys for each value. The rows are filled in parallel.
+template <typename TKey>
+static void ZipRows(const std::vector<TKey>& keys, const std::vector<size_t>& columns, const float* x_data,
+                    int64_t batch_size, int64_t features_per_batch, std::vector<std::map<TKey, float>>& rows,
+                    concurrency::ThreadPool* tp) {
+  rows.resize(static_cast<size_t>(batch_size));
+  if (batch_size == 0) {
+    return;
+  }
+
+  std::map<TKey, float> first_row;
+  for (size_t column : columns) {
+    first_row.emplace_hint(first_row.end(), keys[column], x_data[column]);
+  }
+
+  concurrency::ThreadPool::TryBatchParallelFor(tp, static_cast<int32_t>(batch_size), [&](int32_t n) {
+    std::map<TKey, float>& row = rows[n];
+    row = first_row;
+    const float* x_row = x_data + n * features_per_batch;
+    auto it = row.begin();
+    for (size_t column : columns) {
+      (it++)->second = x_row[column];
+    }
+  });
+}
+
 ZipMapOp::ZipMapOp(const OpKernelInfo& info)
     : OpKernel(info),
       classlabels_int64s_(info.GetAttrsOrDefault<int64_t>("classlabels_int64s")),
@@ -42,6 +71,11 @@ ZipMapOp::ZipMapOp(const OpKernelInfo& info)
   ORT_ENFORCE(classlabels_strings_.empty() ^ classlabels_int64s_.empty(),
               "Must provide classlabels_strings or classlabels_int64s but not both.");
   using_strings_ = !classlabels_strings_.empty();
+  if (using_strings_) {
+    sorted_columns_ = ZipMapSortedColumns(classlabels_strings_);
+  } else {
+    sorted_columns_ = ZipMapSortedColumns(classlabels_int64s_);
+  }
 }
 
 common::Status ZipMapOp::Compute(OpKernelContext* context) const {
@@ -78,17 +112,8 @@ common::Status ZipMapOp::Compute(OpKernelContext* context) const {
     auto* y_data = context->Output<std::vector<std::map<std::string, float>>>(0);
     if (y_data == nullptr) return Status(common::ONNXRUNTIME, common::FAIL, "input count mismatch");
 
-    //auto* y_data = Y->template MutableData<std::vector<std::map<std::string, float>>>();
-    y_data->resize(batch_size);
-    int64_t current_weight_0 = 0;
-    for (int64_t n = 0; n < batch_size; n++) {
-      std::map<std::string, float> map1;
-      for (int64_t j = 0; j < features_per_batch; j++) {
-        map1[classlabels_strings_[j]] = x_data[current_weight_0 + j];
-      }
-      current_weight_0 += features_per_batch;
-      (*y_data)[n] = std::move(map1);
-    }
+    ZipRows(classlabels_strings_, sorted_columns_, x_data, batch_size, features_per_batch, *y_data,
+            context->GetOperatorThreadPool());
   } else {
     if (features_per_batch != static_cast<int64_t>(classlabels_int64s_.size())) {
       return Status(ONNXRUNTIME,
@@ -98,17 +123,8 @@ common::Status ZipMapOp::Compute(OpKernelContext* context) const {
     }
     auto* y_data = context->Output<std::vector<std::map<std::int64_t, float>>>(0);
     if (y_data == nullptr) return Status(common::ONNXRUNTIME, common::FAIL, "input count mismatch");
-    //auto* y_data = Y->template MutableData<std::vector<std::map<int64_t, float>>>();
-    y_data->resize(batch_size);
-    int64_t current_weight_0 = 0;
-    for (int n = 0; n < batch_size; n++) {
-      std::map<int64_t, float> map2;
-      for (int j = 0; j < features_per_batch; j++) {
-        map2[classlabels_int64s_[j]] = x_data[current_weight_0 + j];
-      }
-      current_weight_0 += features_per_batch;
-      (*y_data)[n] = std::move(map2);
-    }
+    ZipRows(classlabels_int64s_, sorted_columns_, x_data, batch_size, features_per_batch, *y_data,
+            context->GetOperatorThreadPool());
   }
   return common::Status::OK();
 }
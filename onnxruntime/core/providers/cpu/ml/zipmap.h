@@ -4,9 +4,29 @@
 #pragma once
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+
+#include <algorithm>
+#include <numeric>
 namespace onnxruntime {
 namespace ml {
 
+// Returns the columns of the distinct keys in map order, keeping the last column of a repeated key as assigning
+// the columns one after the other into a map would.
+template <typename TKey>
+std::vector<size_t> ZipMapSortedColumns(const std::vector<TKey>& keys) {
+  std::vector<size_t> columns(keys.size());
+  std::iota(columns.begin(), columns.end(), size_t{0});
+  std::stable_sort(columns.begin(), columns.end(), [&keys](size_t a, size_t b) { return keys[a] < keys[b]; });
+  std::vector<size_t> distinct;
+  distinct.reserve(columns.size());
+  for (size_t i = 0; i < columns.size(); ++i) {
+    if (i + 1 == columns.size() || keys[columns[i]] < keys[columns[i + 1]]) {
+      distinct.push_back(columns[i]);
+    }
+  }
+  return distinct;
+}
+
 class ZipMapOp final : public OpKernel {
  public:
   explicit ZipMapOp(const OpKernelInfo& info);
@@ -16,6 +36,8 @@ class ZipMapOp final : public OpKernel {
   bool using_strings_;
   std::vector<int64_t> classlabels_int64s_;
   std::vector<std::string> classlabels_strings_;
+  // input column of each distinct key, in map order. When a key is repeated the last column wins.
+  std::vector<size_t> sorted_columns_;
 };
 
 }  // namespace ml
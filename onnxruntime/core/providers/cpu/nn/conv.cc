@@ -275,6 +275,131 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
   return Status::OK();
 }
 
+Status Conv<MLFloat16>::Compute(OpKernelContext* context) const {
+  size_t num_inputs = OpKernel::Node().InputDefs().size();
+  const auto* X = context->Input<Tensor>(0);
+  const auto* W = context->Input<Tensor>(1);
+  const Tensor* B = num_inputs == 3 ? context->Input<Tensor>(2) : nullptr;
+  const int64_t N = X->Shape()[0];
+  const int64_t C = X->Shape()[1];
+  const int64_t M = W->Shape()[0];
+  ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X, W));
+
+  std::vector<int64_t> kernel_shape;
+  ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(W->Shape(), kernel_shape));
+
+  std::vector<int64_t> pads(conv_attrs_.pads);
+  if (pads.empty()) {
+    pads.resize(kernel_shape.size() * 2, 0);
+  }
+  std::vector<int64_t> dilations(conv_attrs_.dilations);
+  if (dilations.empty()) {
+    dilations.resize(kernel_shape.size(), 1);
+  }
+  std::vector<int64_t> strides(conv_attrs_.strides);
+  if (strides.empty()) {
+    strides.resize(kernel_shape.size(), 1);
+  }
+
+  std::vector<int64_t> Y_dims;
+  Y_dims.insert(Y_dims.begin(), {N, M});
+  TensorShape input_shape = X->Shape().Slice(2);
+  ORT_RETURN_IF_ERROR(conv_attrs_.InferOutputShape(input_shape, kernel_shape, strides, dilations, &pads, &Y_dims));
+  Tensor* Y = context->Output(0, TensorShape(Y_dims));
+  // special case when there is a dim value of 0 in the shape.
+  if (Y->Shape().Size() == 0)
+    return Status::OK();
+
+  TensorShape output_shape = Y->Shape().Slice(2);
+
+  const int64_t input_image_size = input_shape.Size();
+  const int64_t output_image_size = output_shape.Size();
+  const int64_t kernel_size = TensorShape(kernel_shape).Size();
+  const int64_t group_output_channels = M / conv_attrs_.group;
+  const int64_t X_offset = C / conv_attrs_.group * input_image_size;
+  const int64_t Y_offset = group_output_channels * output_image_size;
+  const int64_t W_offset = W->Shape().Size() / conv_attrs_.group;
+  const int64_t kernel_dim = C / conv_attrs_.group * kernel_size;
+  const int64_t col_buffer_size = kernel_dim * output_image_size;
+
+  // a pointwise convolution reads the image directly, anything else is unfolded by im2col. im2col only moves
+  // values, so it runs on the half precision bit patterns.
+  bool is_pointwise = kernel_size == 1;
+  for (size_t i = 0; i < kernel_shape.size(); ++i) {
+    is_pointwise = is_pointwise && strides[i] == 1 && pads[i] == 0 && pads[i + kernel_shape.size()] == 0;
+  }
+
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+
+  auto col_data = is_pointwise ? nullptr : alloc->Alloc(sizeof(uint16_t) * col_buffer_size);
+  BufferUniquePtr col_buffer(col_data, BufferDeleter(alloc));
+  auto* col_buffer_data = static_cast<uint16_t*>(col_buffer.get());
+
+  // the products are accumulated in float for one image at a time, then rounded to half precision once
+  auto Y_float_data = alloc->Alloc(sizeof(float) * M * output_image_size);
+  BufferUniquePtr Y_float_buffer(Y_float_data, BufferDeleter(alloc));
+  auto* Y_float = static_cast<float*>(Y_float_buffer.get());
+
+  std::vector<float> bias;
+  if (B != nullptr) {
+    bias.resize(static_cast<size_t>(M));
+    math::ConvertToFloat<MLFloat16>(B->template Data<MLFloat16>(), bias.data(), bias.size());
+  }
+
+  const auto* Xdata = reinterpret_cast<const uint16_t*>(X->template Data<MLFloat16>());
+  const auto* Wdata = reinterpret_cast<const uint16_t*>(W->template Data<MLFloat16>());
+  auto* Ydata = Y->template MutableData<MLFloat16>();
+
+  TensorShape image_shape = X->Shape().Slice(1);
+  std::vector<int64_t> col_buffer_shape{kernel_dim};
+  col_buffer_shape.insert(col_buffer_shape.end(), output_shape.GetDims().begin(),
+                          output_shape.GetDims().end());
+
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+
+  for (int64_t image_id = 0; image_id < N; ++image_id) {
+    for (int64_t group_id = 0; group_id < conv_attrs_.group; ++group_id) {
+      const uint16_t* col = Xdata + group_id * X_offset;
+      if (!is_pointwise) {
+        math::Im2colNd<uint16_t, StorageOrder::NCHW>()(
+            Xdata + group_id * X_offset,
+            image_shape.GetDims().data(),
+            col_buffer_shape.data(),
+            C * input_image_size,
+            col_buffer_size,
+            kernel_shape.data(),
+            strides.data(),
+            dilations.data(),
+            pads.data(),
+            static_cast<int>(kernel_shape.size()),
+            col_buffer_data);
+        col = col_buffer_data;
+      }
+
+      MlasHalfGemm(MlasHalfFloat16, CblasNoTrans, CblasNoTrans,
+                   static_cast<size_t>(group_output_channels),
+                   static_cast<size_t>(output_image_size),
+                   static_cast<size_t>(kernel_dim),
+                   1.0f,
+                   Wdata + group_id * W_offset, static_cast<size_t>(kernel_dim),
+                   col, static_cast<size_t>(output_image_size),
+                   0.0f,
+                   Y_float + group_id * Y_offset, static_cast<size_t>(output_image_size),
+                   thread_pool);
+    }
+
+    MlasActivation(&activation_, Y_float, bias.empty() ? nullptr : bias.data(), static_cast<size_t>(M),
+                   static_cast<size_t>(output_image_size), static_cast<size_t>(output_image_size));
+    math::ConvertFromFloat<MLFloat16>(Y_float, Ydata, static_cast<size_t>(M * output_image_size));
+
+    Xdata += X_offset * conv_attrs_.group;
+    Ydata += Y_offset * conv_attrs_.group;
+  }
+
+  return Status::OK();
+}
+
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Conv,
     1, 10,
@@ -287,4 +412,18 @@ ONNX_CPU_OPERATOR_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Conv<float>);
 
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    Conv,
+    1, 10,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Conv<MLFloat16>);
+
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    Conv,
+    11,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Conv<MLFloat16>);
+
 }  // namespace onnxruntime
@@ -36,4 +36,16 @@ class Conv<float> : public OpKernel {
   ConvAttributes conv_attrs_;
 };
 
+// Half precision Conv unfolds the half precision input with im2col and multiplies it with MlasHalfGemm, which
+// converts panels of the weights and columns to float as it packs them. Neither the weights nor the input are
+// expanded to float copies; only the output of one image is accumulated in float and then rounded once.
+template <>
+class Conv<MLFloat16> : public Conv<float> {
+ public:
+  Conv<MLFloat16>(const OpKernelInfo& info) : Conv<float>(info) {
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+};
+
 }  // namespace onnxruntime
@@ -16,6 +16,7 @@
 #include <iconv.h>
 #endif  // _MSC_VER
 
+#include <algorithm>
 #include <locale>
 #include <functional>
 #include <unordered_set>
@@ -30,9 +31,32 @@ ONNX_CPU_OPERATOR_KERNEL(
     StringNormalizer);
 
 namespace string_normalizer {
+// The converters write into caller provided strings so the buffers can be reused across the
+// elements of a tensor. They return false if the input is not valid.
+#if defined(_MSC_VER) or defined(__APPLE__) or defined(__ANDROID__)
 const std::string conv_error("Conversion Error");
 const std::wstring wconv_error(L"Conversion Error");
 
+class Utf8Converter {
+ public:
+  Utf8Converter() : converter_(conv_error, wconv_error) {}
+
+  bool from_bytes(const char* s, size_t length, std::wstring& result) {
+    result = converter_.from_bytes(s, s + length);
+    return result != wconv_error;
+  }
+
+  bool to_bytes(const std::wstring& wstr, std::string& result) {
+    result = converter_.to_bytes(wstr);
+    return result != conv_error;
+  }
+
+ private:
+  std::wstring_convert<std::codecvt_utf8<wchar_t>> converter_;
+};
+
+#endif
+
 // We need to specialize for MS as there is
 // a std::locale creation bug that affects different
 // environments in a different way
@@ -73,8 +97,6 @@ class Locale {
   _locale_t loc_;
 };
 
-using Utf8Converter = std::wstring_convert<std::codecvt_utf8<wchar_t>>;
-
 const std::string default_locale("en-US");
 
 #else // MS_VER
@@ -105,81 +127,86 @@ class Locale {
   std::locale loc_;
 };
 
-#if defined(__APPLE__) or defined(__ANDROID__)
-using Utf8Converter = std::wstring_convert<std::codecvt_utf8<wchar_t>>;
-#else
+#if !defined(__APPLE__) and !defined(__ANDROID__)
 
 // All others (Linux)
+// The iconv descriptors are opened once per converter instead of once per string.
 class Utf8Converter {
  public:
+  Utf8Converter()
+      // Order of arguments is to, from
+      : from_utf8_(iconv_open("WCHAR_T", "UTF-8")),
+        to_utf8_(iconv_open("UTF-8", "WCHAR_T")) {
+  }
 
-  Utf8Converter(const std::string&, const std::wstring&) {}
-
-  std::wstring from_bytes(const std::string& s) const {
-    std::wstring result;
-    if (s.empty()) {
-      return result;
+  ~Utf8Converter() {
+    if (IsValid(from_utf8_)) {
+      iconv_close(from_utf8_);
     }
-    // Order of arguments is to, from
-    auto icvt = iconv_open("WCHAR_T", "UTF-8");
-    // CentOS is not happy with -1
-    if (std::numeric_limits<iconv_t>::max() == icvt) {
-      return wconv_error;
+    if (IsValid(to_utf8_)) {
+      iconv_close(to_utf8_);
     }
+  }
 
-    char* iconv_in = const_cast<char*>(s.c_str());
-    size_t iconv_in_bytes = s.length();
-    // Temporary buffer assumes 1 byte to 1 wchar_t
-    // to make sure it is enough.
-    const size_t buffer_len = iconv_in_bytes * sizeof(wchar_t);
-    auto buffer = onnxruntime::make_unique<char[]>(buffer_len);
-    char* iconv_out = buffer.get();
-    size_t iconv_out_bytes = buffer_len;
-    auto ret = iconv(icvt, &iconv_in, &iconv_in_bytes, &iconv_out, &iconv_out_bytes);
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(Utf8Converter);
+
+  bool from_bytes(const char* s, size_t length, std::wstring& result) {
+    // One byte converts to at most one wchar_t
+    result.resize(length);
+    if (length == 0) {
+      return true;
+    }
+    if (!IsValid(from_utf8_)) {
+      return false;
+    }
+    char* iconv_in = const_cast<char*>(s);
+    size_t iconv_in_bytes = length;
+    char* iconv_out = reinterpret_cast<char*>(&result[0]);
+    size_t iconv_out_bytes = length * sizeof(wchar_t);
+    // reset the conversion state left by a previous failure
+    iconv(from_utf8_, nullptr, nullptr, nullptr, nullptr);
+    auto ret = iconv(from_utf8_, &iconv_in, &iconv_in_bytes, &iconv_out, &iconv_out_bytes);
     if (static_cast<size_t>(-1) == ret) {
-      result = wconv_error;
-    } else {
-      size_t converted_bytes = buffer_len - iconv_out_bytes;
-      assert((converted_bytes % sizeof(wchar_t)) == 0);
-      result.assign(reinterpret_cast<const wchar_t*>(buffer.get()), converted_bytes / sizeof(wchar_t));
+      return false;
     }
-    iconv_close(icvt);
-    return result;
+    const size_t converted_bytes = length * sizeof(wchar_t) - iconv_out_bytes;
+    assert((converted_bytes % sizeof(wchar_t)) == 0);
+    result.resize(converted_bytes / sizeof(wchar_t));
+    return true;
   }
 
-  std::string to_bytes(const std::wstring& wstr) const {
-    std::string result;
-    if (wstr.empty()) {
-      return result;
+  bool to_bytes(const std::wstring& wstr, std::string& result) {
+    // A code point converts to at most 4 bytes. We do not convert terminating zeros
+    const size_t buffer_len = wstr.length() * 4;
+    result.resize(buffer_len);
+    if (buffer_len == 0) {
+      return true;
     }
-    // Order of arguments is to, from
-    auto icvt = iconv_open("UTF-8", "WCHAR_T");
-    // CentOS is not happy with -1
-    if (std::numeric_limits<iconv_t>::max() == icvt) {
-      return conv_error;
+    if (!IsValid(to_utf8_)) {
+      return false;
     }
-
-    // I hope this does not modify the incoming buffer
-    wchar_t* non_const_in = const_cast<wchar_t*>(wstr.c_str());
-    char* iconv_in = reinterpret_cast<char*>(non_const_in);
+    // iconv does not modify the incoming buffer
+    char* iconv_in = reinterpret_cast<char*>(const_cast<wchar_t*>(wstr.data()));
     size_t iconv_in_bytes = wstr.length() * sizeof(wchar_t);
-    // Temp buffer, assume every code point converts into 3 bytes, this should be enough
-    // We do not convert terminating zeros
-    const size_t buffer_len = wstr.length() * 3;
-    auto buffer = onnxruntime::make_unique<char[]>(buffer_len);
-
-    char* iconv_out = buffer.get();
+    char* iconv_out = &result[0];
     size_t iconv_out_bytes = buffer_len;
-    auto ret = iconv(icvt, &iconv_in, &iconv_in_bytes, &iconv_out, &iconv_out_bytes);
+    iconv(to_utf8_, nullptr, nullptr, nullptr, nullptr);
+    auto ret = iconv(to_utf8_, &iconv_in, &iconv_in_bytes, &iconv_out, &iconv_out_bytes);
     if (static_cast<size_t>(-1) == ret) {
-      result = conv_error;
-    } else {
-      size_t converted_len = buffer_len - iconv_out_bytes;
-      result.assign(buffer.get(), converted_len);
+      return false;
     }
-    iconv_close(icvt);
-    return result;
+    result.resize(buffer_len - iconv_out_bytes);
+    return true;
   }
+
+ private:
+  static bool IsValid(iconv_t icvt) {
+    // CentOS is not happy with -1
+    return std::numeric_limits<iconv_t>::max() != icvt;
+  }
+
+  iconv_t from_utf8_;
+  iconv_t to_utf8_;
 };
 
 #endif // __APPLE__
@@ -188,12 +215,9 @@ const std::string default_locale("en_US.UTF-8"); // All non-MS
 
 #endif // MS_VER
 
-template <class ForwardIter>
-Status CopyCaseAction(ForwardIter first, ForwardIter end, OpKernelContext* ctx,
-                      const Locale& loc,
-                      Utf8Converter& converter,
-                      size_t N, size_t C,
-                      StringNormalizer::CaseAction caseaction) {
+// Returns the output for C strings, or nullptr if C == 0 in which case
+// the output holds a single empty string
+Tensor* CreateOutput(OpKernelContext* ctx, size_t N, size_t C) {
   std::vector<int64_t> output_dims;
   if (N == 1) {
     output_dims.push_back(1);
@@ -205,27 +229,45 @@ Status CopyCaseAction(ForwardIter first, ForwardIter end, OpKernelContext* ctx,
     TensorShape output_shape(output_dims);
     // This will create one empty string
     ctx->Output(0, output_shape);
-    return Status::OK();
+    return nullptr;
   }
 
   output_dims.push_back(C);
 
   TensorShape output_shape(output_dims);
-  auto output_tensor = ctx->Output(0, output_shape);
+  return ctx->Output(0, output_shape);
+}
+
+template <class ForwardIter>
+Status CopyCaseAction(ForwardIter first, ForwardIter end, OpKernelContext* ctx,
+                      const Locale& loc,
+                      Utf8Converter& converter,
+                      size_t N, size_t C,
+                      StringNormalizer::CaseAction caseaction) {
+  auto output_tensor = CreateOutput(ctx, N, C);
+  if (output_tensor == nullptr) {
+    return Status::OK();
+  }
   auto const output_data = output_tensor->template MutableData<std::string>();
 
+  // Reused for every element so that only the output strings are allocated
+  std::wstring wstr;
+  std::string converted;
   size_t output_idx = 0;
   while (first != end) {
     auto& s = *first;
     if (caseaction == StringNormalizer::LOWER || caseaction == StringNormalizer::UPPER) {
-      std::wstring wstr = converter.from_bytes(s);
-      if (wstr == wconv_error) {
+      const std::string& str = s;
+      if (!converter.from_bytes(str.data(), str.size(), wstr)) {
         return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                      "Input contains invalid utf8 chars at: " + static_cast<const std::string&>(s));
+                      "Input contains invalid utf8 chars at: " + str);
       }
       // In place transform
       loc.ChangeCase(caseaction, wstr);
-      *(output_data + output_idx) = converter.to_bytes(wstr);
+      if (!converter.to_bytes(wstr, converted)) {
+        return Status(common::ONNXRUNTIME, common::FAIL, "Failed to convert to utf8: " + str);
+      }
+      output_data[output_idx].assign(converted);
     } else {
       assert(caseaction == StringNormalizer::NONE);
       // Simple copy or move if the iterator points to a non-const string
@@ -269,7 +311,7 @@ StringNormalizer::StringNormalizer(const OpKernelInfo& info) : OpKernel(info),
 
   locale_name_ = info.GetAttrOrDefault("locale", default_locale);
   Locale locale(locale_name_);
-  Utf8Converter converter(conv_error, wconv_error);
+  Utf8Converter converter;
 
   std::vector<std::string> swords = info.GetAttrsOrDefault<std::string>("stopwords");
   for (const auto& sw : swords) {
@@ -278,8 +320,8 @@ StringNormalizer::StringNormalizer(const OpKernelInfo& info) : OpKernel(info),
       auto p = stopwords_.insert(sw);
       ORT_ENFORCE(p.second, "Duplicate stopwords not allowed");
     } else {
-      std::wstring wstr = converter.from_bytes(sw);
-      ORT_ENFORCE(wstr != wconv_error, "Stopword contains invalid utf8 chars");
+      std::wstring wstr;
+      ORT_ENFORCE(converter.from_bytes(sw.data(), sw.size(), wstr), "Stopword contains invalid utf8 chars");
       locale.ChangeCase(compare_caseaction_, wstr);
       auto p = wstopwords_.insert(wstr);
       ORT_ENFORCE(p.second, "Duplicate stopwords not allowed");
@@ -316,7 +358,7 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
 
   Status status;
   Locale locale(locale_name_);
-  Utf8Converter converter(conv_error, wconv_error);
+  Utf8Converter converter;
   auto const input_data = X->template Data<std::string>();
   using StrRef = std::reference_wrapper<const std::string>;
   if (is_case_sensitive_) {
@@ -342,17 +384,21 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
     if (!wstopwords_.empty()) {
       // Filter input. When no case action is required
       // we simply store original string references.
-      // Otherwise, we store converted strings.
+      // Otherwise, each string is converted straight into the string
+      // that is moved to the output once its size is known.
       std::vector<StrRef> filtered_orignal_strings;
       std::vector<std::string> filtered_cased_strings;
-      filtered_orignal_strings.reserve(C);
-      filtered_cased_strings.reserve(C);
+      if (case_change_action_ == NONE) {
+        filtered_orignal_strings.reserve(C);
+      } else {
+        filtered_cased_strings.reserve(C);
+      }
+      std::wstring wstr;
       auto first = input_data;
       auto const last = input_data + C;
       while (first != last) {
         const std::string& s = *first;
-        std::wstring wstr = converter.from_bytes(s);
-        if (wstr == wconv_error) {
+        if (!converter.from_bytes(s.data(), s.size(), wstr)) {
           return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
                         "Input contains invalid utf8 chars at: " + s);
         }
@@ -361,7 +407,10 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
           if (case_change_action_ == NONE) {
             filtered_orignal_strings.push_back(std::cref(s));
           } else {
-            filtered_cased_strings.push_back(converter.to_bytes(wstr));
+            filtered_cased_strings.emplace_back();
+            if (!converter.to_bytes(wstr, filtered_cased_strings.back())) {
+              return Status(common::ONNXRUNTIME, common::FAIL, "Failed to convert to utf8: " + s);
+            }
           }
         }
         ++first;
@@ -370,8 +419,11 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
         status = CopyCaseAction(filtered_orignal_strings.cbegin(), filtered_orignal_strings.cend(), ctx, locale, converter,
                                 N, filtered_orignal_strings.size(), NONE);
       } else {
-        status = CopyCaseAction(filtered_cased_strings.begin(), filtered_cased_strings.end(), ctx, locale, converter,
-                                N, filtered_cased_strings.size(), NONE);
+        auto output_tensor = CreateOutput(ctx, N, filtered_cased_strings.size());
+        if (output_tensor != nullptr) {
+          std::move(filtered_cased_strings.begin(), filtered_cased_strings.end(),
+                    output_tensor->template MutableData<std::string>());
+        }
       }
     } else {
       // Nothing to filter. Copy input to output and change case if needed
@@ -5,11 +5,11 @@
 #include "onnx/defs/schema.h"
 #include "core/common/common.h"
 #include "core/framework/tensor.h"
+#include "core/platform/threadpool.h"
 
-#include <functional>
-#include <unordered_set>
-#include <ostream>
-#include <iterator>
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
 
 namespace onnxruntime {
 
@@ -42,168 +42,117 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
 
 namespace ngram_details {
 
-class NgramEntryBase {
-  size_t id_;  // Id in the pool
- protected:
-  NgramEntryBase(size_t id) : id_(id) {}
-  ~NgramEntryBase() = default;
+// Id of the input items that do not appear in the pool
+constexpr uint32_t kUnknownItem = std::numeric_limits<uint32_t>::max();
+constexpr uint64_t kHashSeed = 0;
 
- public:
-  size_t Id() const { return id_; }
-};
-
-template <class T>
-class NgramEntry;
-
-template <>
-class NgramEntry<int64_t> : public NgramEntryBase {
-  std::vector<int64_t> items_;
-  size_t hash_ = 0;
-
-  void RunningHash(int64_t v) {
-    std::hash<int64_t> hf;
-    hash_ ^= hf(v) + 0x9e3779b9 + (hash_ << 6) + (hash_ >> 2);
-  }
+// Running hash of the items of an n-gram. A search extends it by one item
+// for every n-gram size instead of hashing each n-gram from scratch.
+inline uint64_t HashNext(uint64_t hash, uint32_t item) {
+  hash = (hash ^ item) * 0x9e3779b97f4a7c15ULL;
+  return hash ^ (hash >> 32);
+}
 
+// The pool n-grams as sequences of item ids in a flat open addressing table.
+// Every prefix of a pool n-gram has an entry as well, so a search can stop
+// extending an n-gram as soon as no pool n-gram starts with it.
+class NgramPool {
  public:
-  template <typename ForwardIter>
-  explicit NgramEntry(size_t id, ForwardIter first, ForwardIter last) : NgramEntryBase(id) {
-    while (first != last) {
-      RunningHash(*first);
-      items_.push_back(*first);
-      ++first;
+  struct Entry {
+    uint64_t hash;
+    // position of the items in items_
+    uint32_t offset;
+    // 0 for an empty slot
+    uint32_t size;
+    // -1 if the entry is only a prefix of pool n-grams
+    int64_t ngram_id;
+  };
+
+  NgramPool() : table_(16) {}
+
+  // Returns false if the n-gram is already in the pool
+  bool Add(const uint32_t* items, size_t size, int64_t ngram_id) {
+    assert(size > 0);
+    const auto offset = static_cast<uint32_t>(items_.size());
+    items_.insert(items_.end(), items, items + size);
+    uint64_t hash = kHashSeed;
+    for (size_t i = 0; i < size; ++i) {
+      hash = HashNext(hash, items[i]);
+      Entry& entry = FindOrInsert(hash, offset, static_cast<uint32_t>(i + 1));
+      if (i + 1 == size) {
+        if (entry.ngram_id >= 0) {
+          return false;
+        }
+        entry.ngram_id = ngram_id;
+      }
     }
-    assert(!items_.empty());
-  }
-  // For sampling
-  explicit NgramEntry() : NgramEntryBase(0) {}
-  void AddItem(int64_t v) {
-    items_.push_back(v);
-    RunningHash(v);
-  }
-  void DebugPrint() const {
-    std::copy(items_.cbegin(), items_.cend(), std::ostream_iterator<int64_t>(std::cout, ","));
-    std::cout << std::endl;
-  }
-  void Clear() {
-    items_.clear();
-    hash_ = 0;
+    return true;
   }
-  bool operator==(const NgramEntry& o) const {
-    return items_ == o.items_;
-  }
-  size_t Hash() const {
-    return hash_;
-  }
-};
 
-template <>
-class NgramEntry<int32_t> : public NgramEntry<int64_t> {
- public:
-  template <typename ForwardIter>
-  explicit NgramEntry(size_t id, ForwardIter first, ForwardIter last) : NgramEntry<int64_t>(id, first, last) {}
-  explicit NgramEntry() = default;
-};
+  // Finds the n-gram made of the items first[0], first[skip], first[2 * skip], ...
+  // hash is the running hash of those items.
+  const Entry* Find(uint64_t hash, const uint32_t* first, size_t skip, size_t size) const {
+    for (size_t slot = hash & mask(); ; slot = (slot + 1) & mask()) {
+      const Entry& entry = table_[slot];
+      if (entry.size == 0) {
+        return nullptr;
+      }
+      if (entry.hash == hash && entry.size == size) {
+        const uint32_t* items = items_.data() + entry.offset;
+        size_t i = 0;
+        while (i < size && items[i] == first[i * skip]) {
+          ++i;
+        }
+        if (i == size) {
+          return &entry;
+        }
+      }
+    }
+  }
 
-template <>
-class NgramEntry<std::string> : public NgramEntryBase {
  private:
-  std::vector<std::reference_wrapper<const std::string>> items_;
-  size_t hash_ = 0;
-
-  void RunningHash(const std::string& s) {
-    std::hash<std::string> hf;
-    hash_ ^= hf(s) + 0x9e3779b9 + (hash_ << 6) + (hash_ >> 2);
-  }
+  size_t mask() const { return table_.size() - 1; }
 
- public:
-  template <typename ForwardIter>
-  explicit NgramEntry(size_t id, ForwardIter first, ForwardIter last) : NgramEntryBase(id) {
-    while (first != last) {
-      RunningHash(*first);
-      items_.push_back(std::cref(*first));
-      ++first;
+  Entry& FindOrInsert(uint64_t hash, uint32_t offset, uint32_t size) {
+    auto* found = Find(hash, items_.data() + offset, 1, size);
+    if (found != nullptr) {
+      return const_cast<Entry&>(*found);
     }
-    assert(!items_.empty());
-  }
-  explicit NgramEntry() : NgramEntryBase(0) {}
-  void AddItem(const std::string& s) {
-    items_.push_back(std::cref(s));
-    RunningHash(s);
-  }
-  void DebugPrint() const {
-    std::copy(items_.cbegin(), items_.cend(), std::ostream_iterator<std::string>(std::cout, ","));
-    std::cout << std::endl;
-  }
-  void Clear() {
-    items_.clear();
-    hash_ = 0;
+    // keep the load factor at or below 1/2
+    if ((count_ + 1) * 2 > table_.size()) {
+      Grow();
+    }
+    size_t slot = hash & mask();
+    while (table_[slot].size != 0) {
+      slot = (slot + 1) & mask();
+    }
+    ++count_;
+    table_[slot] = Entry{hash, offset, size, -1};
+    return table_[slot];
   }
 
-  bool operator==(const NgramEntry& o) const {
-    if (items_.size() == o.items_.size()) {
-      std::equal_to<std::string> pred;
-      for (size_t i = 0; i < items_.size(); ++i) {
-        if (!pred(items_[i], o.items_[i])) {
-          return false;
+  void Grow() {
+    std::vector<Entry> old(table_.size() * 2);
+    old.swap(table_);
+    for (const auto& entry : old) {
+      if (entry.size != 0) {
+        size_t slot = entry.hash & mask();
+        while (table_[slot].size != 0) {
+          slot = (slot + 1) & mask();
         }
+        table_[slot] = entry;
       }
-      return true;
     }
-    return false;
-  }
-  size_t Hash() const {
-    return hash_;
   }
-};
-
-template <typename ForwardIter, typename Cont>
-inline void Emplace(ForwardIter first, size_t ngrams, size_t ngram_size, size_t& ngram_id, Cont& c) {
-  for (; ngrams > 0; --ngrams) {
-    c.emplace(ngram_id, first, first + ngram_size);
-    first += ngram_size;
-    ++ngram_id;
-  }
-}
-
-}  // namespace ngram_details
-}  // namespace onnxruntime
-
-using namespace onnxruntime::ngram_details;
-
-namespace std {
-template <typename T>
-struct hash<NgramEntry<T>> {
-  typedef NgramEntry<T> argument_type;
-  typedef size_t result_type;
-  result_type operator()(const argument_type& a) const {
-    return a.Hash();
-  }
-};
-}  // namespace std
-
-namespace onnxruntime {
-
-using IntegerPoolSet = std::unordered_set<NgramEntry<int64_t>>;
-// Does not own strings, contains references to them. This helps
-// to search by string references that point to the current input.
-using StringPoolSet = std::unordered_set<NgramEntry<std::string>>;
-
-template <typename T>
-struct Return;
 
-template <>
-struct Return<int64_t> {
-  using type = IntegerPoolSet::const_iterator;
+  std::vector<Entry> table_;
+  size_t count_ = 0;
+  std::vector<uint32_t> items_;
 };
 
-template <>
-struct Return<int32_t> : Return<int64_t> {};
+}  // namespace ngram_details
 
-template <>
-struct Return<std::string> {
-  using type = StringPoolSet::const_iterator;
-};
+using namespace ngram_details;
 
 // The weighting criteria.
 // "TF"(term frequency),
@@ -238,13 +187,13 @@ struct TfIdfVectorizer::Impl {
   // represents ngram_indexes output
   std::vector<int64_t> ngram_indexes_;
   std::vector<float> weights_;
+  // weights_ by output index, 1 where no weight is given
+  std::vector<float> output_weights_;
 
-  std::vector<std::string> pool_strings_;
-  // This set contains references to pool_string_ entries
-  // of pool_strings attribute
-  StringPoolSet str_set_;
-  // This set contains pool_int64s entries
-  IntegerPoolSet int64_set_;
+  // Ids of the items of the loaded pool n-grams
+  std::unordered_map<std::string, uint32_t> string_ids_;
+  std::unordered_map<int64_t, uint32_t> int64_ids_;
+  NgramPool pool_;
   size_t output_size_ = 0;
 
   Impl() = default;
@@ -252,49 +201,79 @@ struct TfIdfVectorizer::Impl {
   Impl(const Impl&) = delete;
   Impl& operator=(const Impl&) = delete;
 
-  template <typename T>
-  typename Return<T>::type PoolEnd() const;
-
-  template <typename T>
-  typename Return<T>::type PoolFind(const ngram_details::NgramEntry<T>&) const;
-
-  void IncrementCount(size_t ngram_id, size_t row_num,
-                      std::vector<uint32_t>& frequencies) const {
-    assert(ngram_id < ngram_indexes_.size());
-    auto output_idx = row_num * output_size_ + ngram_indexes_[ngram_id];
-    assert(static_cast<size_t>(output_idx) < frequencies.size());
-    ++frequencies[output_idx];
+  template <typename K>
+  static uint32_t AddItem(std::unordered_map<K, uint32_t>& ids, const K& item) {
+    return ids.emplace(item, static_cast<uint32_t>(ids.size())).first->second;
   }
-};
 
-template <>
-inline Return<int64_t>::type TfIdfVectorizer::Impl::PoolEnd<int64_t>() const {
-  return int64_set_.cend();
-}
+  template <typename K>
+  static uint32_t ItemId(const std::unordered_map<K, uint32_t>& ids, const K& item) {
+    auto hit = ids.find(item);
+    return hit != ids.end() ? hit->second : kUnknownItem;
+  }
 
-template <>
-inline Return<int32_t>::type TfIdfVectorizer::Impl::PoolEnd<int32_t>() const {
-  return PoolEnd<int64_t>();
-}
+  uint32_t ItemId(const std::string& item) const { return ItemId(string_ids_, item); }
+  uint32_t ItemId(int64_t item) const { return ItemId(int64_ids_, item); }
 
-template <>
-inline Return<std::string>::type TfIdfVectorizer::Impl::PoolEnd<std::string>() const {
-  return str_set_.cend();
-}
+  // Counts the pool n-grams of one row of C items and weighs the counts.
+  // items is scratch space for C item ids, output the zeroed output row.
+  template <typename T>
+  void ComputeRow(const T* row, size_t C, uint32_t* items, float* output) const;
+};
 
-template <>
-inline Return<int64_t>::type TfIdfVectorizer::Impl::PoolFind<int64_t>(const NgramEntry<int64_t>& i) const {
-  return int64_set_.find(i);
-}
+template <typename T>
+void TfIdfVectorizer::Impl::ComputeRow(const T* row, size_t C, uint32_t* items, float* output) const {
+  for (size_t i = 0; i < C; ++i) {
+    items[i] = ItemId(row[i]);
+  }
 
-template <>
-inline Return<int32_t>::type TfIdfVectorizer::Impl::PoolFind<int32_t>(const NgramEntry<int32_t>& i) const {
-  return int64_set_.find(i);
-}
+  const size_t min_gram_length = min_gram_length_;
+  const size_t max_gram_length = max_gram_length_;
+  // 1-grams do not depend on the skip distance and are counted once
+  const size_t max_skip_distance = (max_gram_length > 1) ? max_skip_count_ + 1 : 1;
+  for (size_t skip_distance = 1; skip_distance <= max_skip_distance; ++skip_distance) {
+    for (size_t ngram_start = 0; ngram_start < C; ++ngram_start) {
+      uint64_t hash = kHashSeed;
+      for (size_t ngram_size = 1, ngram_item = ngram_start;
+           ngram_size <= max_gram_length && ngram_item < C;
+           ++ngram_size, ngram_item += skip_distance) {
+        if (items[ngram_item] == kUnknownItem) {
+          break;
+        }
+        hash = HashNext(hash, items[ngram_item]);
+        auto hit = pool_.Find(hash, items + ngram_start, skip_distance, ngram_size);
+        if (hit == nullptr) {
+          break;
+        }
+        if (hit->ngram_id >= 0 && ngram_size >= min_gram_length && (ngram_size > 1 || skip_distance == 1)) {
+          // record frequency
+          assert(static_cast<size_t>(hit->ngram_id) < ngram_indexes_.size());
+          output[ngram_indexes_[hit->ngram_id]] += 1.0f;
+        }
+      }
+    }
+  }
 
-template <>
-inline Return<std::string>::type TfIdfVectorizer::Impl::PoolFind<std::string>(const NgramEntry<std::string>& i) const {
-  return str_set_.find(i);
+  // Apply weighing criteria
+  switch (weighting_criteria_) {
+    case kTF:
+      break;
+    case kIDF:
+      for (size_t i = 0; i < output_size_; ++i) {
+        output[i] = (output[i] > 0) ? output_weights_[i] : 0;
+      }
+      break;
+    case kTFIDF:
+      if (!weights_.empty()) {
+        for (size_t i = 0; i < output_size_; ++i) {
+          output[i] *= output_weights_[i];
+        }
+      }
+      break;
+    case kNone:  // fall-through
+    default:
+      assert(false);
+  }
 }
 
 TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), impl_(new Impl) {
@@ -352,18 +331,23 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
                 " but ngram_indexes size: ", std::to_string(impl_->ngram_indexes_.size()),
                 " must be of equal size");
   }
+  impl_->output_weights_.assign(impl_->output_size_, 1.0f);
+  for (size_t i = 0; i < impl_->weights_.size(); ++i) {
+    impl_->output_weights_[impl_->ngram_indexes_[i]] = impl_->weights_[i];
+  }
 
   std::vector<int64_t> pool_int64s;
-  status = info.GetAttrs("pool_strings", impl_->pool_strings_);
+  std::vector<std::string> pool_strings;
+  status = info.GetAttrs("pool_strings", pool_strings);
   if (status.IsOK()) {
-    ORT_ENFORCE(!impl_->pool_strings_.empty(), "pool_strings must not be empty if specified");
+    ORT_ENFORCE(!pool_strings.empty(), "pool_strings must not be empty if specified");
   } else {
     status = info.GetAttrs("pool_int64s", pool_int64s);
     ORT_ENFORCE(status.IsOK() && !pool_int64s.empty(), "non-empty pool_int64s is required if pool_strings not provided");
   }
 
   // Iterator via the pool. Insert 1 item for 1-grams, 2 items for 2-grams, etc.
-  const auto total_items = (impl_->pool_strings_.empty()) ? pool_int64s.size() : impl_->pool_strings_.size();
+  const auto total_items = (pool_strings.empty()) ? pool_int64s.size() : pool_strings.size();
   size_t ngram_id = 0;
   // Load into dictionary only required gram sizes
   const size_t min_gram_length = impl_->min_gram_length_;
@@ -381,14 +365,17 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
       auto ngrams = items / ngram_size;
       // Skip loading into hash_set ngrams that are not in the range of [min_gram_length-max_gram_length]
       if (ngram_size >= min_gram_length && ngram_size <= max_gram_length) {
-        if (impl_->pool_strings_.empty()) {
-          auto before_insert = impl_->int64_set_.size();
-          Emplace(pool_int64s.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->int64_set_);
-          ORT_ENFORCE((before_insert + ngrams) == impl_->int64_set_.size(), "pool_int64s duplicate ", std::to_string(ngram_size), "-grams detected");
-        } else {
-          auto before_insert = impl_->str_set_.size();
-          Emplace(impl_->pool_strings_.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->str_set_);
-          ORT_ENFORCE((before_insert + ngrams) == impl_->str_set_.size(), "pool_strings duplicate ", std::to_string(ngram_size), "-grams detected");
+        std::vector<uint32_t> items(ngram_size);
+        for (size_t n = 0; n < ngrams; ++n, ++ngram_id) {
+          const size_t first_idx = start_idx + n * ngram_size;
+          for (size_t k = 0; k < ngram_size; ++k) {
+            items[k] = pool_strings.empty()
+                           ? Impl::AddItem(impl_->int64_ids_, pool_int64s[first_idx + k])
+                           : Impl::AddItem(impl_->string_ids_, pool_strings[first_idx + k]);
+          }
+          ORT_ENFORCE(impl_->pool_.Add(items.data(), ngram_size, ngram_id),
+                      pool_strings.empty() ? "pool_int64s" : "pool_strings",
+                      " duplicate ", std::to_string(ngram_size), "-grams detected");
         }
       } else {
         ngram_id += ngrams;
@@ -400,62 +387,9 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
 
 TfIdfVectorizer::~TfIdfVectorizer() = default;
 
-void TfIdfVectorizer::OutputResult(OpKernelContext* ctx, size_t B, const std::vector<uint32_t>& frequences) const {
-  const Impl& impl = *impl_;
-  std::vector<int64_t> output_dims;
-  if (B == 0) {
-    output_dims.push_back(impl.output_size_);
-  } else {
-    output_dims.push_back(B);
-    output_dims.push_back(impl.output_size_);
-  }
-
-  TensorShape output_shape(output_dims);
-  assert(frequences.size() == static_cast<size_t>(output_shape.Size()));
-
-  auto Y = ctx->Output(0, output_shape);
-  auto output_data = Y->MutableData<float>();
-  const auto& w = impl.weights_;
-  switch (impl.weighting_criteria_) {
-    case kTF: {
-      for (auto f : frequences) {
-        *output_data++ = static_cast<float>(f);
-      }
-    } break;
-    case kIDF: {
-      if (!w.empty()) {
-        assert(frequences.size() == w.size());
-        for (size_t i = 0; i < frequences.size(); ++i) {
-          *output_data++ = (frequences[i] > 0) ? w[i] : 0;
-        }
-      } else {
-        for (auto f : frequences) {
-          *output_data++ = (f > 0) ? 1.0f : 0;
-        }
-      }
-    } break;
-    case kTFIDF: {
-      if (!w.empty()) {
-        assert(frequences.size() == w.size());
-        for (size_t i = 0; i < frequences.size(); ++i) {
-          *output_data++ = frequences[i] * w[i];
-        }
-      } else {
-        for (auto f : frequences) {
-          *output_data++ = static_cast<float>(f);
-        }
-      }
-    } break;
-    case kNone:  // fall-through
-    default:
-      assert(false);
-  }
-}
-
 template <typename T>
 Status TfIdfVectorizer::ComputeImpl(OpKernelContext* ctx) const {
   const auto& impl = *impl_;
-  auto const set_end = impl.PoolEnd<T>();
 
   auto X = ctx->Input<Tensor>(0);
   auto& input_shape = X->Shape();
@@ -485,10 +419,17 @@ Status TfIdfVectorizer::ComputeImpl(OpKernelContext* ctx) const {
                   "Input shape must have either [C] or [B,C] dimensions with B > 0.");
   }
 
-  // Frequency holder allocate [B..output_size_]
-  // and init all to zero
-  std::vector<uint32_t> frequencies;
-  frequencies.resize(b_dim * impl.output_size_, 0);
+  std::vector<int64_t> output_dims;
+  if (B == 0) {
+    output_dims.push_back(impl.output_size_);
+  } else {
+    output_dims.push_back(B);
+    output_dims.push_back(impl.output_size_);
+  }
+  TensorShape output_shape(output_dims);
+  auto Y = ctx->Output(0, output_shape);
+  auto const output_data = Y->MutableData<float>();
+  std::fill_n(output_data, output_shape.Size(), 0.0f);
 
   if (input_shape.Size() == 0) {
     // TfidfVectorizer may receive an empty input when it follows a Tokenizer
@@ -496,88 +437,22 @@ Status TfIdfVectorizer::ComputeImpl(OpKernelContext* ctx) const {
     // TfidfVectorizer returns a zero tensor of shape
     // {b_dim, output_size} when b_dim is the number of received observations
     // and output_size the is the maximum value in ngram_indexes attribute plus 1.
-    OutputResult(ctx, B, frequencies);
     return Status::OK();
   }
 
   assert((b_dim * C) == total_items);
 
-  const auto max_gram_length = impl.max_gram_length_;
-  const auto max_skip_distance = impl.max_skip_count_ + 1;  // Convert to distance
-  auto start_ngram_size = impl.min_gram_length_;
+  // Rows are independent, each block of rows writes its own part of the output
   auto const input_data = X->template Data<T>();
-  auto const end_data = input_data + total_items;
-  NgramEntry<T> sample;
-
-  // Treat 1-grams in a special way
-  if (start_ngram_size == 1) {
-    size_t row_num = 0;
-    auto ngram_start = input_data;
-    while (ngram_start < end_data) {
-      auto const ngram_row_end = ngram_start + C;
-      while (ngram_start < ngram_row_end) {
-        sample.Clear();
-        sample.AddItem(*ngram_start);
-        auto hit = impl.PoolFind<T>(sample);
-        if (hit != set_end) {
-          // record frequency
-          auto ngram_id = hit->Id();
-          impl.IncrementCount(ngram_id, row_num, frequencies);
-        }
-        ++ngram_start;
-      }
-      ++row_num;
-      ngram_start = ngram_row_end;
-    }
-    if (++start_ngram_size > max_gram_length) {
-      OutputResult(ctx, B, frequencies);
-      return Status::OK();
-    }
-  }
-
-  for (auto skip_distance = 1; skip_distance <= max_skip_distance; ++skip_distance) {
-    auto ngram_start = input_data;
-    size_t row_num = 0;
-    while (ngram_start < end_data) {
-      assert((B == 0) || (row_num < B));
-      auto const ngram_row_end = ngram_start + C;
-      assert(ngram_row_end <= end_data);
-      while (ngram_start < ngram_row_end) {
-        // Check if any n-gram size in [start_ngram_size..max_gram_length] range
-        // fit before the end of the row so we do not waste time adding [1..start_ngram_size)
-        // At least items of start_ngram_size should fit
-        // last row should match end_data
-        auto at_least_this = ngram_start + skip_distance * (start_ngram_size - 1);
-        if (at_least_this >= ngram_row_end) {
-          break;
-        }
-        sample.Clear();
-        auto ngram_item = ngram_start;
-        for (auto ngram_size = 1;
-             ngram_size <= max_gram_length &&
-             ngram_item < ngram_row_end;
-             ++ngram_size, ngram_item += skip_distance) {
-          sample.AddItem(*ngram_item);
-
-          // Do not test anything before start_ngram_size
-          if (ngram_size >= start_ngram_size) {
-            auto hit = impl.PoolFind<T>(sample);
-            if (hit != set_end) {
-              // record frequency
-              auto ngram_id = hit->Id();
-              impl.IncrementCount(ngram_id, row_num, frequencies);
-            }
-          }
-        }
-        // Sliding window shift
-        ++ngram_start;
-      }
-      // Next row
-      ngram_start = ngram_row_end;
-      ++row_num;
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+  const size_t num_blocks = std::min(b_dim, tp != nullptr ? static_cast<size_t>(tp->NumThreads() + 1) : size_t{1});
+  concurrency::ThreadPool::TryParallelFor(tp, static_cast<int32_t>(num_blocks), [&](int32_t block) {
+    std::vector<uint32_t> items(C);
+    const size_t row_end = (block + 1) * b_dim / num_blocks;
+    for (size_t row = block * b_dim / num_blocks; row < row_end; ++row) {
+      impl.ComputeRow(input_data + row * C, C, items.data(), output_data + row * impl.output_size_);
     }
-  }
-  OutputResult(ctx, B, frequencies);
+  });
   return Status::OK();
 }
 
@@ -1,165 +1,227 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
-#include <iomanip>
-#include <sstream>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/cpu/tensor/copy.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
-#include "Eigen/src/Core/arch/Default/Half.h"
-#include "core/common/common.h"
-
-#if defined(_M_AMD64)
-#include "core/mlas/inc/mlas.h"
-#endif
 
 using namespace ONNX_NAMESPACE;
 namespace onnxruntime {
 
-template <typename SrcType,
-          typename DstType>
-inline void CastData(const Tensor* in, Tensor* out, const TensorShape& shape) {
-  auto shape_size = shape.Size();
-  auto in_vector = ConstEigenVectorMap<SrcType>(in->template Data<SrcType>(), shape_size);
-  auto output_vector = EigenVectorMap<DstType>(out->template MutableData<DstType>(), shape_size);
+namespace cast_detail {
+
+// a conversion to or from a string costs about as much as copying this many bytes
+constexpr size_t kStringCastCostBytes = 256;
+
+// number of elements converted through the float staging buffer at a time when casting to or from float16
+constexpr int64_t kStagingElements = 512;
+
+// Converts count elements. Eigen vectorizes the conversions between the arithmetic types.
+template <typename SrcType, typename DstType>
+inline void CastSpan(const SrcType* in, DstType* out, int64_t count) {
+  auto in_vector = ConstEigenVectorMap<SrcType>(in, count);
+  auto output_vector = EigenVectorMap<DstType>(out, count);
   output_vector = in_vector.template cast<DstType>();
 }
 
 template <>
-inline void CastData<float, MLFloat16>(const Tensor* in, Tensor* out, const TensorShape& shape) {
-  auto out_data = out->template MutableData<MLFloat16>();
-  auto shape_size = shape.Size();
-  auto in_vector = ConstEigenVectorMap<float>(in->template Data<float>(), shape_size);
-  auto output_vector = EigenVectorMap<Eigen::half>(static_cast<Eigen::half*>(static_cast<void*>(out_data)), shape_size);
-  output_vector = in_vector.template cast<Eigen::half>();
+inline void CastSpan<float, MLFloat16>(const float* in, MLFloat16* out, int64_t count) {
+  MlasConvertFloatToHalf(MlasHalfFloat16, in, &out[0].val, static_cast<size_t>(count));
+}
+
+template <>
+inline void CastSpan<MLFloat16, float>(const MLFloat16* in, float* out, int64_t count) {
+  MlasConvertHalfToFloat(MlasHalfFloat16, &in[0].val, out, static_cast<size_t>(count));
+}
+
+// Parses a string the way the std::sto* function of the destination type does, without throwing. Returns false
+// where that function would throw.
+template <typename T, typename Parse>
+inline bool TryParse(const std::string& str, T& value, Parse parse) {
+  const char* begin = str.c_str();
+  char* end;
+  const int saved_errno = errno;
+  errno = 0;
+  const auto parsed = parse(begin, &end);
+  const bool ok = end != begin && errno != ERANGE;
+  errno = saved_errno;
+  value = static_cast<T>(parsed);
+  return ok;
+}
+
+// std::stoi additionally rejects values outside the range of int.
+template <typename T>
+inline bool TryParseInt(const std::string& str, T& value) {
+  long parsed;
+  if (!TryParse(str, parsed, [](const char* s, char** end) { return strtol(s, end, 10); }) ||
+      parsed < std::numeric_limits<int>::min() || parsed > std::numeric_limits<int>::max()) {
+    return false;
+  }
+  value = static_cast<T>(parsed);
+  return true;
+}
+
+inline bool TryParseString(const std::string& str, float& value) {
+  return TryParse(str, value, [](const char* s, char** end) { return strtof(s, end); });
+}
+inline bool TryParseString(const std::string& str, double& value) {
+  return TryParse(str, value, [](const char* s, char** end) { return strtod(s, end); });
+}
+inline bool TryParseString(const std::string& str, int8_t& value) { return TryParseInt(str, value); }
+inline bool TryParseString(const std::string& str, int16_t& value) { return TryParseInt(str, value); }
+inline bool TryParseString(const std::string& str, int32_t& value) {
+  return TryParse(str, value, [](const char* s, char** end) { return strtol(s, end, 10); });
+}
+inline bool TryParseString(const std::string& str, int64_t& value) {
+  return TryParse(str, value, [](const char* s, char** end) { return strtoll(s, end, 10); });
+}
+inline bool TryParseString(const std::string& str, uint8_t& value) {
+  return TryParse(str, value, [](const char* s, char** end) { return strtoul(s, end, 10); });
+}
+inline bool TryParseString(const std::string& str, uint16_t& value) {
+  return TryParse(str, value, [](const char* s, char** end) { return strtoul(s, end, 10); });
+}
+inline bool TryParseString(const std::string& str, uint32_t& value) {
+  return TryParse(str, value, [](const char* s, char** end) { return strtoul(s, end, 10); });
+}
+inline bool TryParseString(const std::string& str, uint64_t& value) {
+  return TryParse(str, value, [](const char* s, char** end) { return strtoull(s, end, 10); });
+}
+
+// The conversions of Cast from string, which throw on strings that do not hold a number of the type.
+inline void ParseString(const std::string& str, float& value) { value = std::stof(str); }
+inline void ParseString(const std::string& str, double& value) { value = std::stod(str); }
+inline void ParseString(const std::string& str, int8_t& value) { value = static_cast<int8_t>(std::stoi(str)); }
+inline void ParseString(const std::string& str, int16_t& value) { value = static_cast<int16_t>(std::stoi(str)); }
+inline void ParseString(const std::string& str, int32_t& value) { value = std::stol(str); }
+inline void ParseString(const std::string& str, int64_t& value) { value = std::stoll(str); }
+inline void ParseString(const std::string& str, uint8_t& value) { value = static_cast<uint8_t>(std::stoul(str)); }
+inline void ParseString(const std::string& str, uint16_t& value) { value = static_cast<uint16_t>(std::stoul(str)); }
+inline void ParseString(const std::string& str, uint32_t& value) { value = std::stoul(str); }
+inline void ParseString(const std::string& str, uint64_t& value) { value = std::stoull(str); }
+
+// Formats a value the way writing it to a std::ostream does, with a precision of 8 for floating point values to
+// match numpy.
+template <typename SrcType>
+inline std::string FormatValue(SrcType value) {
+  return std::to_string(value);
+}
+
+template <>
+inline std::string FormatValue<int8_t>(int8_t value) {
+  return std::string(1, static_cast<char>(value));
 }
 
 template <>
-inline void CastData<MLFloat16, float>(const Tensor* in, Tensor* out, const TensorShape& shape) {
-  auto out_data = out->template MutableData<float>();
-  auto in_data = in->template Data<MLFloat16>();
-  auto shape_size = shape.Size();
-#if defined(_M_AMD64)
-  MlasConvertHalfToFloatBuffer(&in_data[0].val, out_data, shape_size);
-#else
-  auto in_vector = ConstEigenVectorMap<Eigen::half>(static_cast<const Eigen::half*>(static_cast<const void*>(in_data)), shape_size);
-  auto output_vector = EigenVectorMap<float>(out_data, shape_size);
-  output_vector = in_vector.template cast<float>();
-#endif
+inline std::string FormatValue<uint8_t>(uint8_t value) {
+  return std::string(1, static_cast<char>(value));
 }
 
+template <>
+inline std::string FormatValue<bool>(bool value) {
+  return value ? "1" : "0";
+}
+
+inline std::string FormatFloatingPoint(double value) {
+  if (std::isnan(value)) {
+    return "NaN";
+  }
+  if (std::isinf(value)) {
+    return value < 0 ? "-INF" : "INF";
+  }
+  char buffer[32];
+  const int length = snprintf(buffer, sizeof(buffer), "%.8g", value);
+  return std::string(buffer, static_cast<size_t>(length));
+}
+
+template <>
+inline std::string FormatValue<float>(float value) {
+  return FormatFloatingPoint(value);
+}
+
+template <>
+inline std::string FormatValue<double>(double value) {
+  return FormatFloatingPoint(value);
+}
+
+}  // namespace cast_detail
+
+// Casts the elements of the input, splitting them over the thread pool when there are enough of them.
 template <typename SrcType,
           typename DstType>
-inline void CastFloat16Data(const Tensor* in, Tensor* out, const TensorShape& shape, const AllocatorPtr& allocator) {
-  ORT_ENFORCE(allocator != nullptr);
-  const int64_t len = shape.Size();
-  ORT_ENFORCE(len > 0);
-  void* buffer = allocator->AllocArray(sizeof(float), len);
-  ORT_ENFORCE(buffer);
-  Tensor tmp_tensor(DataTypeImpl::GetType<float>(), shape, buffer, allocator->Info());
-  if (std::is_same<SrcType, MLFloat16>::value) {
-    CastData<MLFloat16, float>(in, &tmp_tensor, shape);  // first cast to float
-    CastData<float, DstType>(&tmp_tensor, out, shape);   // then cast to the destination type.
-  } else if (std::is_same<DstType, MLFloat16>::value) {
-    CastData<SrcType, float>(in, &tmp_tensor, shape);
-    CastData<float, MLFloat16>(&tmp_tensor, out, shape);
-  }
-  allocator->Free(buffer);
+inline void CastData(const Tensor* in, Tensor* out, const TensorShape& shape, concurrency::ThreadPool* tp) {
+  const SrcType* in_data = in->template Data<SrcType>();
+  DstType* out_data = out->template MutableData<DstType>();
+  ParallelForBlocks(tp, shape.Size(), sizeof(SrcType) + sizeof(DstType), [&](int64_t first, int64_t last) {
+    cast_detail::CastSpan(in_data + first, out_data + first, last - first);
+  });
+}
+
+// Casts between float16 and the types other than float by converting through float, a block of elements at a
+// time so that the staged values stay in the cache.
+template <typename SrcType,
+          typename DstType>
+inline void CastFloat16Data(const Tensor* in, Tensor* out, const TensorShape& shape, concurrency::ThreadPool* tp) {
+  const SrcType* in_data = in->template Data<SrcType>();
+  DstType* out_data = out->template MutableData<DstType>();
+  ParallelForBlocks(tp, shape.Size(), sizeof(SrcType) + sizeof(float) + sizeof(DstType),
+                    [&](int64_t first, int64_t last) {
+                      float staging[cast_detail::kStagingElements];
+                      for (int64_t i = first; i < last; i += cast_detail::kStagingElements) {
+                        const int64_t count = std::min(cast_detail::kStagingElements, last - i);
+                        cast_detail::CastSpan(in_data + i, staging, count);
+                        cast_detail::CastSpan(staging, out_data + i, count);
+                      }
+                    });
 }
 
 template <typename SrcType>
-inline void CastToStringData(const Tensor* in, Tensor* out, const TensorShape& shape) {
+inline void CastToStringData(const Tensor* in, Tensor* out, const TensorShape& shape, concurrency::ThreadPool* tp) {
   const int64_t len = shape.Size();
   ORT_ENFORCE(len > 0);
-  auto input_data = in->DataAsSpan<SrcType>();
-  auto output_data = out->MutableDataAsSpan<std::string>();
-
-  for (int i = 0; i < len; ++i) {
-    if (std::is_floating_point<SrcType>::value && std::isnan(input_data[i])) {
-      output_data[i] = "NaN";
-    } else if (std::is_floating_point<SrcType>::value && std::isinf(input_data[i])) {
-      if (input_data[i] < std::numeric_limits<SrcType>::lowest()) {
-        output_data[i] = "-INF";
-      } else {
-        output_data[i] = "INF";
-      }
-    } else {
-      std::ostringstream convert;
-      if (std::is_floating_point<SrcType>::value) {
-        // match numpy default behavior
-        convert << std::setprecision(8);
-      }
-
-      convert << input_data[i];
-      output_data[i] = convert.str();
+  const SrcType* input_data = in->template Data<SrcType>();
+  std::string* output_data = out->template MutableData<std::string>();
+  ParallelForBlocks(tp, len, cast_detail::kStringCastCostBytes, [&](int64_t first, int64_t last) {
+    for (int64_t i = first; i < last; ++i) {
+      output_data[i] = cast_detail::FormatValue(input_data[i]);
     }
-  }
+  });
 }
 
 template <typename DstType>
-inline void CastFromStringData(const Tensor* in, Tensor* out, const TensorShape& shape) {
-  if (std::is_same<DstType, std::string>::value) return;
+inline void CastFromStringData(const Tensor* in, Tensor* out, const TensorShape& shape, concurrency::ThreadPool* tp) {
   const int64_t len = shape.Size();
   ORT_ENFORCE(len > 0);
-  if (std::is_same<DstType, float>::value) {
-    auto* mutable_data = out->MutableData<float>();
-    for (int i = 0; i < len; ++i) {
-      mutable_data[i] = std::stof(in->Data<std::string>()[i]);
-    }
-  } else if (std::is_same<DstType, double>::value) {
-    auto* mutable_data = out->MutableData<double>();
-    for (int i = 0; i < len; ++i) {
-      mutable_data[i] = std::stod(in->Data<std::string>()[i]);
-    }
-  } else if (std::is_same<DstType, int8_t>::value) {
-    auto* mutable_data = out->MutableData<int8_t>();
-    for (int i = 0; i < len; ++i) {
-      int temp_i = std::stoi(in->Data<std::string>()[i]);
-      mutable_data[i] = static_cast<int8_t>(temp_i);
-    }
-  } else if (std::is_same<DstType, uint8_t>::value) {
-    auto* mutable_data = out->MutableData<uint8_t>();
-    for (int i = 0; i < len; ++i) {
-      unsigned long temp_ui = std::stoul(in->Data<std::string>()[i]);
-      mutable_data[i] = static_cast<uint8_t>(temp_ui);
-    }
-  } else if (std::is_same<DstType, int16_t>::value) {
-    auto* mutable_data = out->MutableData<int16_t>();
-    for (int i = 0; i < len; ++i) {
-      int temp_i = std::stoi(in->Data<std::string>()[i]);
-      mutable_data[i] = static_cast<int16_t>(temp_i);
-    }
-  } else if (std::is_same<DstType, uint16_t>::value) {
-    auto* mutable_data = out->MutableData<uint16_t>();
-    for (int i = 0; i < len; ++i) {
-      unsigned long temp_ui = std::stoul(in->Data<std::string>()[i]);
-      mutable_data[i] = static_cast<uint16_t>(temp_ui);
-    }
-  } else if (std::is_same<DstType, int32_t>::value) {
-    auto* mutable_data = out->MutableData<int32_t>();
-    for (int i = 0; i < len; ++i) {
-      mutable_data[i] = std::stol(in->Data<std::string>()[i]);
-    }
-  } else if (std::is_same<DstType, uint32_t>::value) {
-    auto* mutable_data = out->MutableData<uint32_t>();
-    for (int i = 0; i < len; ++i) {
-      mutable_data[i] = std::stoul(in->Data<std::string>()[i]);
-    }
-  } else if (std::is_same<DstType, int64_t>::value) {
-    auto* mutable_data = out->MutableData<int64_t>();
-    for (int i = 0; i < len; ++i) {
-      mutable_data[i] = std::stoll(in->Data<std::string>()[i]);
+  const std::string* input_data = in->template Data<std::string>();
+  DstType* output_data = out->template MutableData<DstType>();
+
+  // the strings are parsed without exceptions on the thread pool, a thread pool task must not throw
+  std::atomic<bool> failed{false};
+  ParallelForBlocks(tp, len, cast_detail::kStringCastCostBytes, [&](int64_t first, int64_t last) {
+    for (int64_t i = first; i < last; ++i) {
+      if (!cast_detail::TryParseString(input_data[i], output_data[i])) {
+        failed = true;
+        return;
+      }
     }
-  } else if (std::is_same<DstType, uint64_t>::value) {
-    auto* mutable_data = out->MutableData<uint64_t>();
-    for (int i = 0; i < len; ++i) {
-      mutable_data[i] = std::stoull(in->Data<std::string>()[i]);
+  });
+
+  // a string could not be parsed, parse again with the throwing conversions to report it
+  if (failed) {
+    for (int64_t i = 0; i < len; ++i) {
+      cast_detail::ParseString(input_data[i], output_data[i]);
     }
-  } else {
-    ORT_THROW("Unsupported type in cast op: from String to ", typeid(DstType).name());
   }
-}  // namespace onnxruntime
+}
 
 template <typename T>
 class Cast final : public OpKernel {
@@ -176,28 +238,26 @@ class Cast final : public OpKernel {
  private:
   template <typename SrcType,
             typename DstType>
-  void CastData(const Tensor* in, Tensor* out, const TensorShape& shape) const {
-    ::onnxruntime::CastData<SrcType, DstType>(in, out, shape);
+  void CastData(const Tensor* in, Tensor* out, const TensorShape& shape, concurrency::ThreadPool* tp) const {
+    ::onnxruntime::CastData<SrcType, DstType>(in, out, shape, tp);
   }
 
   template <typename SrcType,
             typename DstType>
-  Status CastFloat16Data(const Tensor* in, Tensor* out, const TensorShape& shape, OpKernelContext* context) const {
-    AllocatorPtr allocator;
-    ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
-    ::onnxruntime::CastFloat16Data<SrcType, DstType>(in, out, shape, allocator);
+  Status CastFloat16Data(const Tensor* in, Tensor* out, const TensorShape& shape, concurrency::ThreadPool* tp) const {
+    ::onnxruntime::CastFloat16Data<SrcType, DstType>(in, out, shape, tp);
     return Status::OK();
   }
 
   template <typename SrcType>
-  Status CastToStringData(const Tensor* in, Tensor* out, const TensorShape& shape) const {
-    ::onnxruntime::CastToStringData<SrcType>(in, out, shape);
+  Status CastToStringData(const Tensor* in, Tensor* out, const TensorShape& shape, concurrency::ThreadPool* tp) const {
+    ::onnxruntime::CastToStringData<SrcType>(in, out, shape, tp);
     return Status::OK();
   }
 
   template <typename DstType>
-  Status CastFromStringData(const Tensor* in, Tensor* out, const TensorShape& shape) const {
-    ::onnxruntime::CastFromStringData<DstType>(in, out, shape);
+  Status CastFromStringData(const Tensor* in, Tensor* out, const TensorShape& shape, concurrency::ThreadPool* tp) const {
+    ::onnxruntime::CastFromStringData<DstType>(in, out, shape, tp);
     return Status::OK();
   }
 
@@ -233,51 +293,52 @@ const std::vector<MLDataType> castOpTypeConstraints{
     const Tensor* X = context->Input<Tensor>(0);                                                                                   \
     const TensorShape& shape = X->Shape();                                                                                         \
     Tensor* Y = context->Output(0, TensorShape(shape));                                                                            \
+    concurrency::ThreadPool* tp = context->GetOperatorThreadPool();                                                                \
                                                                                                                                    \
     switch (to_) {                                                                                                                 \
       case TensorProto_DataType_BOOL:                                                                                              \
-        CastData<in_type, bool>(X, Y, shape);                                                                                      \
+        CastData<in_type, bool>(X, Y, shape, tp);                                                                                  \
         break;                                                                                                                     \
       case TensorProto_DataType_INT16:                                                                                             \
-        CastData<in_type, int16_t>(X, Y, shape);                                                                                   \
+        CastData<in_type, int16_t>(X, Y, shape, tp);                                                                               \
         break;                                                                                                                     \
       case TensorProto_DataType_INT32:                                                                                             \
-        CastData<in_type, int32_t>(X, Y, shape);                                                                                   \
+        CastData<in_type, int32_t>(X, Y, shape, tp);                                                                               \
         break;                                                                                                                     \
       case TensorProto_DataType_INT64:                                                                                             \
-        CastData<in_type, int64_t>(X, Y, shape);                                                                                   \
+        CastData<in_type, int64_t>(X, Y, shape, tp);                                                                               \
         break;                                                                                                                     \
       case TensorProto_DataType_UINT8:                                                                                             \
-        CastData<in_type, uint8_t>(X, Y, shape);                                                                                   \
+        CastData<in_type, uint8_t>(X, Y, shape, tp);                                                                               \
         break;                                                                                                                     \
       case TensorProto_DataType_UINT16:                                                                                            \
-        CastData<in_type, uint16_t>(X, Y, shape);                                                                                  \
+        CastData<in_type, uint16_t>(X, Y, shape, tp);                                                                              \
         break;                                                                                                                     \
       case TensorProto_DataType_UINT32:                                                                                            \
-        CastData<in_type, uint32_t>(X, Y, shape);                                                                                  \
+        CastData<in_type, uint32_t>(X, Y, shape, tp);                                                                              \
         break;                                                                                                                     \
       case TensorProto_DataType_UINT64:                                                                                            \
-        CastData<in_type, uint64_t>(X, Y, shape);                                                                                  \
+        CastData<in_type, uint64_t>(X, Y, shape, tp);                                                                              \
         break;                                                                                                                     \
       case TensorProto_DataType_FLOAT:                                                                                             \
-        CastData<in_type, float>(X, Y, shape);                                                                                     \
+        CastData<in_type, float>(X, Y, shape, tp);                                                                                 \
         break;                                                                                                                     \
       case TensorProto_DataType_DOUBLE:                                                                                            \
-        CastData<in_type, double>(X, Y, shape);                                                                                    \
+        CastData<in_type, double>(X, Y, shape, tp);                                                                                \
         break;                                                                                                                     \
       case TensorProto_DataType_INT8:                                                                                              \
-        CastData<in_type, int8_t>(X, Y, shape);                                                                                    \
+        CastData<in_type, int8_t>(X, Y, shape, tp);                                                                                \
         break;                                                                                                                     \
       case TensorProto_DataType_FLOAT16:                                                                                           \
         if (std::is_same<in_type, float>::value) {                                                                                 \
-          CastData<float, MLFloat16>(X, Y, shape);                                                                                 \
+          CastData<float, MLFloat16>(X, Y, shape, tp);                                                                             \
         } else {                                                                                                                   \
-          auto st = CastFloat16Data<in_type, MLFloat16>(X, Y, shape, context);                                                     \
+          auto st = CastFloat16Data<in_type, MLFloat16>(X, Y, shape, tp);                                                          \
           if (!st.IsOK()) return st;                                                                                               \
         }                                                                                                                          \
         break;                                                                                                                     \
       case TensorProto_DataType_STRING:                                                                                            \
-        CastToStringData<in_type>(X, Y, shape);                                                                                    \
+        CastToStringData<in_type>(X, Y, shape, tp);                                                                                \
         break;                                                                                                                     \
       case TensorProto_DataType_UNDEFINED:                                                                                         \
         ORT_THROW("Cast op must have 'to' argument of type DataType"); /*break;*/                                                  \
@@ -312,34 +373,35 @@ Status Cast<MLFloat16>::Compute(OpKernelContext* context) const {
   const auto* X = context->Input<Tensor>(0);
   const TensorShape& shape = X->Shape();
   Tensor* Y = context->Output(0, TensorShape(shape));
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
   Status st;
   switch (to_) {
     case TensorProto_DataType_BOOL:
-      st = CastFloat16Data<MLFloat16, bool>(X, Y, shape, context);
+      st = CastFloat16Data<MLFloat16, bool>(X, Y, shape, tp);
       break;
     case TensorProto_DataType_INT16:
-      st = CastFloat16Data<MLFloat16, int16_t>(X, Y, shape, context);
+      st = CastFloat16Data<MLFloat16, int16_t>(X, Y, shape, tp);
       break;
     case TensorProto_DataType_INT32:
-      st = CastFloat16Data<MLFloat16, int32_t>(X, Y, shape, context);
+      st = CastFloat16Data<MLFloat16, int32_t>(X, Y, shape, tp);
       break;
     case TensorProto_DataType_INT64:
-      st = CastFloat16Data<MLFloat16, int64_t>(X, Y, shape, context);
+      st = CastFloat16Data<MLFloat16, int64_t>(X, Y, shape, tp);
       break;
     case TensorProto_DataType_UINT8:
-      st = CastFloat16Data<MLFloat16, uint8_t>(X, Y, shape, context);
+      st = CastFloat16Data<MLFloat16, uint8_t>(X, Y, shape, tp);
       break;
     case TensorProto_DataType_UINT16:
-      st = CastFloat16Data<MLFloat16, uint16_t>(X, Y, shape, context);
+      st = CastFloat16Data<MLFloat16, uint16_t>(X, Y, shape, tp);
       break;
     case TensorProto_DataType_UINT32:
-      st = CastFloat16Data<MLFloat16, uint32_t>(X, Y, shape, context);
+      st = CastFloat16Data<MLFloat16, uint32_t>(X, Y, shape, tp);
       break;
     case TensorProto_DataType_UINT64:
-      st = CastFloat16Data<MLFloat16, uint64_t>(X, Y, shape, context);
+      st = CastFloat16Data<MLFloat16, uint64_t>(X, Y, shape, tp);
       break;
     case TensorProto_DataType_FLOAT:
-      CastData<MLFloat16, float>(X, Y, shape);
+      CastData<MLFloat16, float>(X, Y, shape, tp);
       break;
     case TensorProto_DataType_FLOAT16: {
       auto X_type = X->DataType();
@@ -347,16 +409,17 @@ Status Cast<MLFloat16>::Compute(OpKernelContext* context) const {
       void* target = Y->MutableDataRaw(X_type);
       // if source and target pointers are not equal, we need to copy the data.
       if (target != source) {
-        memcpy(target, source, shape.Size() * X_type->Size());
+        ParallelCopy(tp, static_cast<const uint8_t*>(source), static_cast<uint8_t*>(target),
+                     shape.Size() * X_type->Size());
       }
       st = Status::OK();
       break;
     }
     case TensorProto_DataType_DOUBLE:
-      st = CastFloat16Data<MLFloat16, double>(X, Y, shape, context);
+      st = CastFloat16Data<MLFloat16, double>(X, Y, shape, tp);
       break;
     case TensorProto_DataType_INT8:
-      st = CastFloat16Data<MLFloat16, int8_t>(X, Y, shape, context);
+      st = CastFloat16Data<MLFloat16, int8_t>(X, Y, shape, tp);
       break;
     case TensorProto_DataType_STRING:
       ORT_THROW("Casting from 'float16' to 'string' is not supported yet."); /*break;*/
@@ -382,37 +445,38 @@ Status Cast<std::string>::Compute(OpKernelContext* context) const {
                                   "Input is missing. The operator Cast expects one and only one input");
   const TensorShape& shape = X->Shape();
   Tensor* Y = context->Output(0, TensorShape(shape));
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
   Status st;
   switch (to_) {
     case TensorProto_DataType_INT16:
-      st = CastFromStringData<int16_t>(X, Y, shape);
+      st = CastFromStringData<int16_t>(X, Y, shape, tp);
       break;
     case TensorProto_DataType_INT32:
-      st = CastFromStringData<int32_t>(X, Y, shape);
+      st = CastFromStringData<int32_t>(X, Y, shape, tp);
       break;
     case TensorProto_DataType_INT64:
-      st = CastFromStringData<int64_t>(X, Y, shape);
+      st = CastFromStringData<int64_t>(X, Y, shape, tp);
       break;
     case TensorProto_DataType_UINT8:
-      st = CastFromStringData<uint8_t>(X, Y, shape);
+      st = CastFromStringData<uint8_t>(X, Y, shape, tp);
       break;
     case TensorProto_DataType_UINT16:
-      st = CastFromStringData<uint16_t>(X, Y, shape);
+      st = CastFromStringData<uint16_t>(X, Y, shape, tp);
       break;
     case TensorProto_DataType_UINT32:
-      st = CastFromStringData<uint32_t>(X, Y, shape);
+      st = CastFromStringData<uint32_t>(X, Y, shape, tp);
       break;
     case TensorProto_DataType_UINT64:
-      st = CastFromStringData<uint64_t>(X, Y, shape);
+      st = CastFromStringData<uint64_t>(X, Y, shape, tp);
       break;
     case TensorProto_DataType_FLOAT:
-      st = CastFromStringData<float>(X, Y, shape);
+      st = CastFromStringData<float>(X, Y, shape, tp);
       break;
     case TensorProto_DataType_DOUBLE:
-      st = CastFromStringData<double>(X, Y, shape);
+      st = CastFromStringData<double>(X, Y, shape, tp);
       break;
     case TensorProto_DataType_INT8:
-      st = CastFromStringData<int8_t>(X, Y, shape);
+      st = CastFromStringData<int8_t>(X, Y, shape, tp);
       break;
     case TensorProto_DataType_UNDEFINED:
       ORT_THROW("Cast op must have 'to' argument of type DataType");
@@ -4,6 +4,7 @@
 #include "core/providers/cpu/tensor/concat.h"
 #include "core/providers/common.h"
 #include "core/framework/TensorSeq.h"
+#include "core/providers/cpu/tensor/copy.h"
 
 namespace onnxruntime {
 
@@ -152,51 +153,69 @@ Status ConcatBase::PrepareForCompute(OpKernelContext* ctx,
 }
 
 // This method computes the output tensor for Concat/ConcatFromSequence ops
-Status ConcatBase::ComputeImpl(Prepare& p) const {
+Status ConcatBase::ComputeImpl(Prepare& p, concurrency::ThreadPool* tp) const {
   int input_count = static_cast<int>(p.inputs.size());
-  int64_t initial_output_offset = 0;  // initial offset for each input
   auto element_bytes = p.output_tensor->DataType()->Size();
+  uint8_t* output = static_cast<uint8_t*>(p.output_tensor->MutableDataRaw());
+
+  // Every 'output_axis_pitch' values of the output hold 'input_axis_pitch' values of each input in turn, so the
+  // output is made of rows that are filled with one block from each input.
+  const int64_t row_count = p.output_num_elements / p.output_axis_pitch;
+
+  // offset of the block of each input within a row of the output
+  std::vector<int64_t> row_offsets(input_count);
+  int64_t initial_output_offset = 0;
   for (int input_index = 0; input_index < input_count; input_index++) {
     const auto& prep = p.inputs[input_index];
+    row_offsets[input_index] = initial_output_offset;
 
     // no data in this tensor - so skip it
-    if (prep.num_elements == 0)
-      continue;
-
-    auto input_axis_pitch = prep.axis_pitch;
-    const uint8_t* input = static_cast<const uint8_t*>(prep.tensor->DataRaw());
-
-    auto input_size = prep.num_elements;
-
-    // Copy the data across. For every 'input_axis_pitch' values copied, we move over by the 'output_axis_pitch'
-    // TODO: Optimization possibility: There are cases where we simply need to "merge" raw buffers and this 
-    // could be done without the pointer house-keeping as below. Some scenarios whether this is possible are:
-    // 1) Concatenating on input axis = 0
-    // 2) Stacking on output axis = 0
-    // 3) Stacking scalars
-    uint8_t* output = static_cast<uint8_t*>(p.output_tensor->MutableDataRaw());
-    int64_t cur_out_offset = 0;
-    int64_t cur_in_offset = 0;
-    for (size_t idx_copy = 0, end = input_size / input_axis_pitch; idx_copy < end; ++idx_copy) {
+    if (prep.num_elements != 0)
+      initial_output_offset += prep.axis_pitch;
+  }
+
+  if (row_count == 1 && !p.is_string_type) {
+    // Concatenating on the outermost axis (or stacking on a new outermost axis) merges the raw buffers, so
+    // split each input copy across the thread pool instead.
+    for (int input_index = 0; input_index < input_count; input_index++) {
+      const auto& prep = p.inputs[input_index];
+      if (prep.num_elements == 0)
+        continue;
+      ParallelCopy(tp, static_cast<const uint8_t*>(prep.tensor->DataRaw()),
+                   output + row_offsets[input_index] * element_bytes,
+                   static_cast<size_t>(prep.num_elements) * element_bytes);
+    }
+    return Status::OK();
+  }
+
+  // Copy the data across a range of rows at a time so that each task writes a contiguous part of the output.
+  ParallelForBlocks(tp, row_count, p.output_axis_pitch * element_bytes, [&](int64_t first, int64_t last) {
+    for (int input_index = 0; input_index < input_count; input_index++) {
+      const auto& prep = p.inputs[input_index];
+      if (prep.num_elements == 0)
+        continue;
+
+      const auto input_axis_pitch = prep.axis_pitch;
+      const int64_t output_offset = row_offsets[input_index];
+
       if (p.is_string_type) {
-        size_t out = initial_output_offset + cur_out_offset;
-        for (int idx_item = 0; idx_item < input_axis_pitch; ++idx_item) {
-          reinterpret_cast<std::string*>(output)[out + idx_item] =
-              reinterpret_cast<const std::string*>(input)[cur_in_offset + idx_item];
+        const auto* input = static_cast<const std::string*>(prep.tensor->DataRaw());
+        auto* output_strings = reinterpret_cast<std::string*>(output);
+        for (int64_t row = first; row < last; ++row) {
+          const std::string* block = input + row * input_axis_pitch;
+          std::copy(block, block + input_axis_pitch, output_strings + row * p.output_axis_pitch + output_offset);
         }
       } else {
-        memcpy(
-            output + (initial_output_offset + cur_out_offset) * element_bytes,
-            input + cur_in_offset * element_bytes,
-            input_axis_pitch * element_bytes);
+        const auto* input = static_cast<const uint8_t*>(prep.tensor->DataRaw());
+        const size_t block_bytes = input_axis_pitch * element_bytes;
+        for (int64_t row = first; row < last; ++row) {
+          memcpy(output + (row * p.output_axis_pitch + output_offset) * element_bytes,
+                 input + row * block_bytes,
+                 block_bytes);
+        }
       }
-
-      cur_out_offset += p.output_axis_pitch;
-      cur_in_offset += input_axis_pitch;
     }
-
-    initial_output_offset += input_axis_pitch;
-  }
+  });
 
   return Status::OK();
 }
@@ -224,7 +243,7 @@ Status Concat::Compute(OpKernelContext* ctx) const {
     return Status::OK();
 
   // Compute values to be placed in the output tensor
-  return ComputeImpl(p);
+  return ComputeImpl(p, ctx->GetOperatorThreadPool());
 }
 
 }  // namespace onnxruntime
@@ -7,6 +7,7 @@
 #include "core/framework/op_kernel.h"
 #include "core/util/math_cpuonly.h"
 #include "core/framework/tensor.h"
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 
@@ -44,7 +45,7 @@ class ConcatBase {
   Status PrepareForCompute(OpKernelContext* ctx, const std::vector<const Tensor*>& input_tensors,
                            Prepare& p) const;
 
-  Status ComputeImpl(Prepare& p) const;
+  Status ComputeImpl(Prepare& p, concurrency::ThreadPool* tp) const;
 
   int64_t axis_;
   bool is_stack_ = false;
@@ -0,0 +1,203 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include "core/platform/threadpool.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#define ORT_PREFETCH_READ(p) _mm_prefetch(reinterpret_cast<const char*>(p), _MM_HINT_T0)
+#elif defined(__GNUC__)
+#define ORT_PREFETCH_READ(p) __builtin_prefetch(p)
+#else
+#define ORT_PREFETCH_READ(p)
+#endif
+
+// Block copy engine shared by the data movement kernels (Gather, GatherND, ScatterND, Concat, Split, Transpose).
+// A copy is described as 'count' blocks of equal size whose source and destination offsets are produced by
+// callables, so the kernels only describe their addressing and validate their indices before calling in here.
+namespace onnxruntime {
+
+// Splits [0, count) into ranges of units of 'bytes_per_unit' bytes and runs fn(first, last) for each range on
+// the thread pool. Small copies run inline as the scheduling overhead would dominate.
+template <typename F>
+void ParallelForBlocks(concurrency::ThreadPool* tp, int64_t count, size_t bytes_per_unit, F&& fn) {
+  // keep at least this many bytes in each range so the scheduling overhead stays small
+  constexpr size_t kMinBytesPerRange = 16 * 1024;
+
+  // TryBatchParallelFor falls back to OpenMP when there is no thread pool
+  int64_t num_threads = 1;
+  if (tp != nullptr) {
+    num_threads = tp->NumThreads() + 1;
+  }
+#ifdef _OPENMP
+  else if (omp_get_num_threads() == 1) {
+    num_threads = omp_get_max_threads();
+  }
+#endif
+
+  int64_t num_ranges = 1;
+  if (num_threads > 1 && count > 1) {
+    int64_t max_ranges = static_cast<int64_t>((count * bytes_per_unit) / kMinBytesPerRange);
+    num_ranges = std::max<int64_t>(1, std::min<int64_t>({max_ranges, count, 4 * num_threads}));
+  }
+
+  if (num_ranges == 1) {
+    if (count > 0) {
+      fn(int64_t{0}, count);
+    }
+    return;
+  }
+
+  concurrency::ThreadPool::TryBatchParallelFor(tp, static_cast<int32_t>(num_ranges), [&](int32_t range) {
+    int64_t first = count * range / num_ranges;
+    int64_t last = count * (range + 1) / num_ranges;
+    fn(first, last);
+  });
+}
+
+namespace copy_detail {
+
+// number of blocks ahead of the current block whose source is prefetched by gathers
+constexpr int64_t kPrefetchDistance = 8;
+
+// prefetch at most this many bytes of a gathered block; longer blocks are streamed by the hardware prefetcher
+constexpr size_t kMaxPrefetchBytes = 256;
+
+// Blocks of these sizes are copied with a fixed size memcpy, which the compiler turns into a few vector moves
+// instead of a call into the library routine.
+template <size_t N>
+struct FixedSizeBlock {
+  static void Copy(uint8_t* dst, const uint8_t* src, size_t /*bytes*/) { memcpy(dst, src, N); }
+};
+
+struct VariableSizeBlock {
+  static void Copy(uint8_t* dst, const uint8_t* src, size_t bytes) { memcpy(dst, src, bytes); }
+};
+
+inline void PrefetchBlock(const uint8_t* src, size_t block_bytes) {
+  const size_t prefetch_bytes = std::min(block_bytes, kMaxPrefetchBytes);
+  for (size_t offset = 0; offset < prefetch_bytes; offset += 64) {
+    ORT_PREFETCH_READ(src + offset);
+  }
+}
+
+template <typename Block, bool Prefetch, typename SrcOffset, typename DstOffset>
+void CopyBlockRange(const uint8_t* src, uint8_t* dst, size_t block_bytes, int64_t first, int64_t last,
+                    const SrcOffset& src_offset, const DstOffset& dst_offset) {
+  for (int64_t i = first; i < last; ++i) {
+    if (Prefetch && i + kPrefetchDistance < last) {
+      PrefetchBlock(src + src_offset(i + kPrefetchDistance), block_bytes);
+    }
+    Block::Copy(dst + dst_offset(i), src + src_offset(i), block_bytes);
+  }
+}
+
+template <bool Prefetch, typename SrcOffset, typename DstOffset>
+void DispatchBlockRange(const uint8_t* src, uint8_t* dst, size_t block_bytes, int64_t first, int64_t last,
+                        const SrcOffset& src_offset, const DstOffset& dst_offset) {
+  switch (block_bytes) {
+    case 1:
+      CopyBlockRange<FixedSizeBlock<1>, Prefetch>(src, dst, block_bytes, first, last, src_offset, dst_offset);
+      break;
+    case 2:
+      CopyBlockRange<FixedSizeBlock<2>, Prefetch>(src, dst, block_bytes, first, last, src_offset, dst_offset);
+      break;
+    case 4:
+      CopyBlockRange<FixedSizeBlock<4>, Prefetch>(src, dst, block_bytes, first, last, src_offset, dst_offset);
+      break;
+    case 8:
+      CopyBlockRange<FixedSizeBlock<8>, Prefetch>(src, dst, block_bytes, first, last, src_offset, dst_offset);
+      break;
+    case 16:
+      CopyBlockRange<FixedSizeBlock<16>, Prefetch>(src, dst, block_bytes, first, last, src_offset, dst_offset);
+      break;
+    case 32:
+      CopyBlockRange<FixedSizeBlock<32>, Prefetch>(src, dst, block_bytes, first, last, src_offset, dst_offset);
+      break;
+    case 64:
+      CopyBlockRange<FixedSizeBlock<64>, Prefetch>(src, dst, block_bytes, first, last, src_offset, dst_offset);
+      break;
+    default:
+      CopyBlockRange<VariableSizeBlock, Prefetch>(src, dst, block_bytes, first, last, src_offset, dst_offset);
+      break;
+  }
+}
+
+}  // namespace copy_detail
+
+// Copies 'count' blocks of 'block_bytes' bytes from src + src_offset(i) to dst + dst_offset(i), with the offsets
+// in bytes. The blocks must not overlap in the destination; use CopyBlocksInOrder when they may.
+template <typename SrcOffset, typename DstOffset>
+void CopyBlocks(concurrency::ThreadPool* tp, const uint8_t* src, uint8_t* dst, size_t block_bytes, int64_t count,
+                const SrcOffset& src_offset, const DstOffset& dst_offset) {
+  if (block_bytes == 0) {
+    return;
+  }
+  ParallelForBlocks(tp, count, block_bytes, [&](int64_t first, int64_t last) {
+    copy_detail::DispatchBlockRange<false>(src, dst, block_bytes, first, last, src_offset, dst_offset);
+  });
+}
+
+// Serial version of CopyBlocks for destinations that may overlap. The blocks are copied in order, so the last
+// block written to a location wins.
+template <typename SrcOffset, typename DstOffset>
+void CopyBlocksInOrder(const uint8_t* src, uint8_t* dst, size_t block_bytes, int64_t count,
+                       const SrcOffset& src_offset, const DstOffset& dst_offset) {
+  if (block_bytes == 0) {
+    return;
+  }
+  copy_detail::DispatchBlockRange<false>(src, dst, block_bytes, 0, count, src_offset, dst_offset);
+}
+
+// Copies 'count' blocks of 'block_bytes' bytes from src + src_offset(i) to consecutive blocks of dst. The source
+// offsets usually come from an indices tensor, so the sources of upcoming blocks are prefetched.
+template <typename SrcOffset>
+void GatherBlocks(concurrency::ThreadPool* tp, const uint8_t* src, uint8_t* dst, size_t block_bytes, int64_t count,
+                  const SrcOffset& src_offset) {
+  if (block_bytes == 0) {
+    return;
+  }
+  auto dst_offset = [block_bytes](int64_t i) { return static_cast<size_t>(i) * block_bytes; };
+  ParallelForBlocks(tp, count, block_bytes, [&](int64_t first, int64_t last) {
+    copy_detail::DispatchBlockRange<true>(src, dst, block_bytes, first, last, src_offset, dst_offset);
+  });
+}
+
+// String version of CopyBlocks with the block size and the offsets counted in elements.
+template <typename SrcOffset, typename DstOffset>
+void CopyStringBlocks(concurrency::ThreadPool* tp, const std::string* src, std::string* dst, size_t block_elements,
+                      int64_t count, const SrcOffset& src_offset, const DstOffset& dst_offset) {
+  if (block_elements == 0) {
+    return;
+  }
+  ParallelForBlocks(tp, count, block_elements * sizeof(std::string), [&](int64_t first, int64_t last) {
+    for (int64_t i = first; i < last; ++i) {
+      const std::string* block = src + src_offset(i);
+      std::copy(block, block + block_elements, dst + dst_offset(i));
+    }
+  });
+}
+
+// Copies a contiguous buffer, splitting it across the thread pool when it is large.
+inline void ParallelCopy(concurrency::ThreadPool* tp, const uint8_t* src, uint8_t* dst, size_t bytes) {
+  // copy in whole cache lines so that two threads never write to the same line
+  constexpr size_t kChunkBytes = 4096;
+  const int64_t chunks = static_cast<int64_t>((bytes + kChunkBytes - 1) / kChunkBytes);
+  ParallelForBlocks(tp, chunks, kChunkBytes, [&](int64_t first, int64_t last) {
+    const size_t begin = static_cast<size_t>(first) * kChunkBytes;
+    const size_t end = std::min(bytes, static_cast<size_t>(last) * kChunkBytes);
+    memcpy(dst + begin, src + begin, end - begin);
+  });
+}
+
+}  // namespace onnxruntime
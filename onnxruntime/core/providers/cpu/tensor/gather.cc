@@ -4,6 +4,7 @@
 //https://github.com/onnx/onnx/blob/master/docs/Operators.md#Gather
 #include "core/providers/cpu/tensor/gather.h"
 #include "core/common/common.h"
+#include "core/providers/cpu/tensor/copy.h"
 
 namespace onnxruntime {
 
@@ -56,13 +57,14 @@ Status GatherBase::PrepareForCompute(OpKernelContext* context, Prepare& p) const
 template <typename Tin>
 Status GatherCopyData(const Tensor* indices_tensor, const uint8_t* src_base, uint8_t* dst_base, bool is_string_type,
                       const size_t element_bytes, const int64_t block_size, const int64_t M,
-                      const int64_t N, const int64_t data_batch_bytes, const int64_t gathered_batch_bytes,
-                      const TensorShape& input_data_shape, const int64_t axis) {
+                      const int64_t N, const int64_t data_batch_bytes, const TensorShape& input_data_shape,
+                      const int64_t axis, concurrency::ThreadPool* tp) {
   const Tin* indices_data = indices_tensor->template Data<Tin>();
 
-  // Check the indices first in case there's a out of bound index.
-  // We can't merge this code in the omp loop below as omp does not allow return in the loop
+  // Check the indices once up front and resolve the negative ones, so the copy below is free of
+  // branches and error handling.
   auto axis_dim_limit = input_data_shape[axis];
+  std::vector<int64_t> src_block_offsets(N);
 
   for (int64_t i = 0; i < N; ++i) {
     Tin idx = indices_data[i];
@@ -71,28 +73,23 @@ Status GatherCopyData(const Tensor* indices_tensor, const uint8_t* src_base, uin
                              "indices element out of data bounds, idx=", idx,
                              " must be within the inclusive range [", -axis_dim_limit, ",", axis_dim_limit - 1, "]");
     }
+    src_block_offsets[i] = (idx < 0 ? idx + axis_dim_limit : idx) * block_size;
   }
 
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-  for (int64_t index = 0; index < M * N; ++index) {
-    int64_t batch = index / N;
-    int64_t i = index % N;
-
-    const int64_t src_offset_batch = batch * data_batch_bytes;
-    const int64_t dst_offset_batch = batch * gathered_batch_bytes;
-    Tin idx = indices_data[i];
-    idx = idx < 0 ? idx + static_cast<Tin>(axis_dim_limit) : idx;
-    const int64_t src_offset = src_offset_batch + idx * block_size;
-    const int64_t dst_offset = dst_offset_batch + i * block_size;
-
-    if (is_string_type) {
-      reinterpret_cast<std::string*>(dst_base)[dst_offset / element_bytes] =
-          reinterpret_cast<const std::string*>(src_base)[src_offset / element_bytes];
-    } else {
-      memcpy(dst_base + dst_offset, src_base + src_offset, block_size);
-    }
+  // the gathered blocks of all the batches are written consecutively to the output
+  auto src_offset = [&src_block_offsets, N, data_batch_bytes](int64_t index) {
+    return static_cast<size_t>((index / N) * data_batch_bytes + src_block_offsets[index % N]);
+  };
+
+  if (is_string_type) {
+    const int64_t block = block_size / static_cast<int64_t>(element_bytes);
+    CopyStringBlocks(
+        tp, reinterpret_cast<const std::string*>(src_base), reinterpret_cast<std::string*>(dst_base),
+        static_cast<size_t>(block), M * N,
+        [&src_offset, element_bytes](int64_t index) { return src_offset(index) / element_bytes; },
+        [block](int64_t index) { return static_cast<size_t>(index * block); });
+  } else {
+    GatherBlocks(tp, src_base, dst_base, static_cast<size_t>(block_size), M * N, src_offset);
   }
 
   return Status::OK();
@@ -112,18 +109,19 @@ Status Gather::Compute(OpKernelContext* context) const {
   const int64_t M = input_data_shape.SizeToDimension(p.axis);
   const int64_t N = p.indices_tensor->Shape().Size();
   const int64_t data_batch_bytes = input_data_shape.SizeFromDimension(p.axis) * element_bytes;
-  const int64_t gathered_batch_bytes = N * block * element_bytes;
 
   const auto* src_base = static_cast<const uint8_t*>(p.input_tensor->DataRaw());
   auto* dst_base = static_cast<uint8_t*>(p.output_tensor->MutableDataRaw());
 
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
+
   if (p.indices_tensor->IsDataType<int32_t>()) {
     return GatherCopyData<int32_t>(p.indices_tensor, src_base, dst_base, is_string_type, element_bytes,
-                                   block_size, M, N, data_batch_bytes, gathered_batch_bytes, input_data_shape, p.axis);
+                                   block_size, M, N, data_batch_bytes, input_data_shape, p.axis, tp);
   }
   if (p.indices_tensor->IsDataType<int64_t>()) {
     return GatherCopyData<int64_t>(p.indices_tensor, src_base, dst_base, is_string_type, element_bytes,
-                                   block_size, M, N, data_batch_bytes, gathered_batch_bytes, input_data_shape, p.axis);
+                                   block_size, M, N, data_batch_bytes, input_data_shape, p.axis, tp);
   }
 
   return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "Type for Tind not supported yet in Gather.");
@@ -2,6 +2,8 @@
 // Licensed under the MIT License.
 
 #include "scatter_nd.h"
+#include <algorithm>
+#include "core/providers/cpu/tensor/copy.h"
 
 namespace onnxruntime {
 
@@ -77,20 +79,17 @@ Status ScatterNDBase::PrepareForCompute(OpKernelContext* context, Prepare& p) co
       auto* dst = output_tensor->template MutableData<std::string>();
       std::copy(str_begin, str_end, dst);
     } else {
-      memcpy(dst_base, src_base, input_tensor->SizeInBytes());
+      ParallelCopy(context->GetOperatorThreadPool(), static_cast<const uint8_t*>(src_base),
+                   static_cast<uint8_t*>(dst_base), input_tensor->SizeInBytes());
     }
   }
 
   std::vector<int64_t> element_counts(last_indice_dimension, 0LL); // Number of elements for each input dimension
 
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
   for (int64_t i = 0; i < last_indice_dimension; ++i) {
     element_counts[i] = input_shape.SizeFromDimension(i + 1);
   }
 
-  int64_t err_indice = 0;
   p.element_bytes    = input_tensor->DataType()->Size();
   p.element_to_copy  = input_shape.SizeFromDimension(last_indice_dimension);
   p.bytes_to_copy    = p.element_bytes * p.element_to_copy;
@@ -106,20 +105,26 @@ Status ScatterNDBase::PrepareForCompute(OpKernelContext* context, Prepare& p) co
     p.output_base     = static_cast<uint8_t*>(output_tensor->MutableDataRaw());
   }
 
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
+  // Check all the indices before anything is scattered, so the copy itself cannot fail
   for (int64_t i = 0; i < offset_count; ++i) {
     for (int64_t j = 0; j < last_indice_dimension; ++j) {
       auto indice = *(indice_offset + i * last_indice_dimension + j);
       if (indice < 0 || indice >= input_shape[j]) {
-        err_indice = indice;
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "invalid indice found, indice = ", indice);
       }
       p.element_offsets[i] += indice * element_counts[j];
     }
   }
-  return err_indice == 0 ? Status::OK() :
-    ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "invalid indice found, indice = ", err_indice);
+
+  // Numeric updates that land on the same block have to be applied in order, so find out whether there are any.
+  // Strings are always scattered serially.
+  if (!is_string_type) {
+    std::vector<uint64_t> sorted_offsets(p.element_offsets);
+    std::sort(sorted_offsets.begin(), sorted_offsets.end());
+    p.has_duplicate_offsets =
+        std::adjacent_find(sorted_offsets.begin(), sorted_offsets.end()) != sorted_offsets.end();
+  }
+  return Status::OK();
 }
 
 template Status ScatterNDBase::PrepareForCompute<int64_t>(OpKernelContext*, Prepare&) const;
@@ -127,29 +132,30 @@ template Status ScatterNDBase::PrepareForCompute<int64_t>(OpKernelContext*, Prep
 Status ScatterND::Compute(OpKernelContext* context) const {
   Prepare p;
   ORT_RETURN_IF_ERROR(PrepareForCompute<int64_t>(context, p));
-  return nullptr == p.input_str_base ? ScatterNumber(p) : ScatterString(p);
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
+  return nullptr == p.input_str_base ? ScatterNumber(p, tp) : ScatterString(p);
 }
 
-Status ScatterND::ScatterNumber(const Prepare& p) const {
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-  for (int64_t i = 0; i < static_cast<int64_t>(p.element_offsets.size()); ++i) {
-    memcpy(p.output_base + p.element_offsets[i] * p.element_bytes,
-           p.input_base + i * p.bytes_to_copy,
-           p.bytes_to_copy);
+Status ScatterND::ScatterNumber(const Prepare& p, concurrency::ThreadPool* tp) const {
+  const auto count = static_cast<int64_t>(p.element_offsets.size());
+  auto src_offset = [&p](int64_t i) { return i * p.bytes_to_copy; };
+  auto dst_offset = [&p](int64_t i) { return p.element_offsets[i] * p.element_bytes; };
+  if (p.has_duplicate_offsets) {
+    // Two threads writing the same block could leave it with bytes from both updates, so copy serially in order
+    // and let the last update win, as it does for strings.
+    CopyBlocksInOrder(p.input_base, p.output_base, p.bytes_to_copy, count, src_offset, dst_offset);
+  } else {
+    CopyBlocks(tp, p.input_base, p.output_base, p.bytes_to_copy, count, src_offset, dst_offset);
   }
   return Status::OK();
 }
 
 Status ScatterND::ScatterString(const Prepare& p) const {
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
+  // Kept serial: with duplicate indices two threads would assign the same std::string concurrently, which is a
+  // data race on its heap buffer. Serially the last update for an index wins, as it does for the numeric blocks.
   for (int64_t i = 0; i < static_cast<int64_t>(p.element_offsets.size()); ++i) {
-    for (int64_t j = 0; j < static_cast<int64_t>(p.element_to_copy); ++j) {
-      p.output_str_base[p.element_offsets[i] + j] = p.input_str_base[i * p.element_to_copy + j];
-    }
+    const std::string* block = p.input_str_base + i * p.element_to_copy;
+    std::copy(block, block + p.element_to_copy, p.output_str_base + p.element_offsets[i]);
   }
   return Status::OK();
 }
@@ -5,6 +5,7 @@
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 
@@ -20,6 +21,7 @@ protected:
     uint64_t              element_bytes;
     uint64_t              element_to_copy;
     std::vector<uint64_t> element_offsets;
+    bool                  has_duplicate_offsets;
 
     Prepare(): input_base      (nullptr),
                input_str_base  (nullptr),
@@ -28,7 +30,8 @@ protected:
                bytes_to_copy   (0),
                element_bytes   (0),
                element_to_copy (0),
-               element_offsets (0) {}
+               element_offsets (0),
+               has_duplicate_offsets (false) {}
   }; // struct Prepare
 
   template<typename Tind>
@@ -40,7 +43,7 @@ public:
   explicit ScatterND(const OpKernelInfo& info) : OpKernel(info) {}
   Status Compute(OpKernelContext* context) const override;
 private:
-  Status ScatterNumber(const Prepare& p) const;
+  Status ScatterNumber(const Prepare& p, concurrency::ThreadPool* tp) const;
   Status ScatterString(const Prepare& p) const;
 };
 
@@ -16,7 +16,9 @@ namespace onnxruntime {
       Slice,                                                                            \
       1, 9,                                                                             \
       data_type,                                                                        \
-      KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<data_type>()), \
+      KernelDefBuilder()                                                                \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<data_type>())                \
+          .MayStridedOutput(0, 0),                                                      \
       Slice<data_type, false>);
 
 ADD_TYPED_SLICE_V9_OP(uint8_t);
@@ -39,7 +41,10 @@ ADD_TYPED_SLICE_V9_OP(string);
       10,                                                                                                                                                                                        \
       10,                                                                                                                                                                                        \
       data_type,                                                                                                                                                                                 \
-      KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<data_type>()).TypeConstraint("Tind", {DataTypeImpl::GetTensorType<int32_t>(), DataTypeImpl::GetTensorType<int64_t>()}), \
+      KernelDefBuilder()                                                                                                                                                                         \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<data_type>())                                                                                                                         \
+          .TypeConstraint("Tind", {DataTypeImpl::GetTensorType<int32_t>(), DataTypeImpl::GetTensorType<int64_t>()})                                                                              \
+          .MayStridedOutput(0, 0),                                                                                                                                                               \
       Slice<data_type, true>);
 
 ADD_TYPED_SLICE_V10_OP(uint8_t);
@@ -63,7 +68,8 @@ ADD_TYPED_SLICE_V10_OP(string);
       data_type,                                                                                                     \
       KernelDefBuilder()                                                                                             \
           .TypeConstraint("T", DataTypeImpl::GetTensorType<data_type>())                                             \
-          .TypeConstraint("Tind", {DataTypeImpl::GetTensorType<int32_t>(), DataTypeImpl::GetTensorType<int64_t>()}), \
+          .TypeConstraint("Tind", {DataTypeImpl::GetTensorType<int32_t>(), DataTypeImpl::GetTensorType<int64_t>()})  \
+          .MayStridedOutput(0, 0),                                                                                   \
       Slice<data_type, true>);
 
 ADD_TYPED_SLICE_V11_OP(uint8_t);
@@ -324,6 +330,20 @@ Status SliceImpl(OpKernelContext* ctx,
   TensorShape output_shape(output_dims);
   auto& output_tensor = *ctx->Output(0, output_shape);
 
+  if (ctx->IsStridedViewOutput(0)) {
+    // the output shares the input buffer: it starts at the first sliced element and steps through the input.
+    // any flattened innermost dims have a start of 0 and a step of 1, so they keep the input strides.
+    ORT_ENFORCE(output_tensor.DataRaw() == input_tensor.DataRaw());
+    std::vector<int64_t> output_strides = input_tensor.Strides();
+    int64_t offset = 0;
+    for (size_t i = 0, end = starts.size(); i < end; ++i) {
+      offset += starts[i] * output_strides[i];
+      output_strides[i] *= steps[i];
+    }
+    output_tensor.SetStridedView(output_strides, input_tensor.ByteOffset() + offset * static_cast<int64_t>(sizeof(T)));
+    return Status::OK();
+  }
+
   // output tensor's size is 0, nothing to fill - return
   if (output_shape.Size() == 0)
     return Status::OK();
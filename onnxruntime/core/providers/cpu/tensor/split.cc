@@ -3,8 +3,7 @@
 
 #include "core/providers/cpu/tensor/split.h"
 #include "core/providers/common.h"
-#include "core/util/math.h"
-#include "core/util/math_cpuonly.h"
+#include "core/providers/cpu/tensor/copy.h"
 
 #include "gsl/gsl"
 
@@ -19,7 +18,8 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
                                           DataTypeImpl::GetTensorType<float>(),
                                           DataTypeImpl::GetTensorType<int32_t>(),
                                           DataTypeImpl::GetTensorType<int64_t>(),
-                                          DataTypeImpl::GetTensorType<std::string>()}),
+                                          DataTypeImpl::GetTensorType<std::string>()})
+        .MayStridedOutput(0, -1),
     Split);
 
 // Opset 11 starts to support Neg Axis.
@@ -31,7 +31,8 @@ ONNX_CPU_OPERATOR_KERNEL(
                                           DataTypeImpl::GetTensorType<float>(),
                                           DataTypeImpl::GetTensorType<int32_t>(),
                                           DataTypeImpl::GetTensorType<int64_t>(),
-                                          DataTypeImpl::GetTensorType<std::string>()}),
+                                          DataTypeImpl::GetTensorType<std::string>()})
+        .MayStridedOutput(0, -1),
     Split);
 
 Status SplitBase::PrepareForCompute(const TensorShape& input_shape, int num_outputs, int64_t& axis, int& before_dims,
@@ -91,15 +92,22 @@ Status Split::Compute(OpKernelContext* context) const {
   return status;
 }
 
+// copies the M rows of N values starting every lda values in the input to consecutive rows of the output
 template <typename T>
-inline void copy_data(const T* src, T* dst, size_t count) {
-  memcpy(dst, src, count * sizeof(T));
+static void CopySplitRows(concurrency::ThreadPool* tp, const T* src, T* dst, int64_t M, int64_t N, int64_t lda) {
+  CopyBlocks(
+      tp, reinterpret_cast<const uint8_t*>(src), reinterpret_cast<uint8_t*>(dst), N * sizeof(T), M,
+      [lda](int64_t row) { return static_cast<size_t>(row * lda) * sizeof(T); },
+      [N](int64_t row) { return static_cast<size_t>(row * N) * sizeof(T); });
 }
 
 template <>
-inline void copy_data<std::string>(const std::string* src, std::string* dst, size_t count) {
-  const std::string* end = src + count;
-  std::copy(src, end, dst);
+void CopySplitRows<std::string>(concurrency::ThreadPool* tp, const std::string* src, std::string* dst,
+                                int64_t M, int64_t N, int64_t lda) {
+  CopyStringBlocks(
+      tp, src, dst, static_cast<size_t>(N), M,
+      [lda](int64_t row) { return static_cast<size_t>(row * lda); },
+      [N](int64_t row) { return static_cast<size_t>(row * N); });
 }
 
 template <typename T>
@@ -126,6 +134,7 @@ Status Split::ComputeImpl(OpKernelContext& context, const Tensor& input) const {
 
   int64_t input_offset = 0;
   const T* input_data = input.template Data<T>();
+  concurrency::ThreadPool* tp = context.GetOperatorThreadPool();
 
   for (int i = 0; i < num_outputs; ++i) {
     // update size of dimension for axis we're splitting on
@@ -133,18 +142,23 @@ Status Split::ComputeImpl(OpKernelContext& context, const Tensor& input) const {
     output_dimensions[axis] = split_size;
 
     Tensor* output = context.Output(i, TensorShape{output_dimensions});
+
+    if (context.IsStridedViewOutput(i)) {
+      // the output shares the input buffer, starting at its part of the split axis with the input strides
+      ORT_ENFORCE(output->DataRaw() == input.DataRaw());
+      output->SetStridedView(input.Strides(), input.ByteOffset() + input_offset * static_cast<int64_t>(sizeof(T)));
+      input_offset += split_size * after_dims_excluding_split;
+      continue;
+    }
+
     T* output_data = output->template MutableData<T>();
 
-    ::onnxruntime::math::CopyMatrix<T>(
-        before_dims,                                       // M
-        split_size * after_dims_excluding_split,           // N
-        static_cast<const T*>(input_data + input_offset),  // A
-        after_dims_including_split_axis,                   // lda
-        static_cast<T*>(output_data),                      // B
-        split_size * after_dims_excluding_split,           // ldb
-        [](const T* src, T* dst, size_t count) {
-          copy_data<T>(src, dst, count);
-        });
+    CopySplitRows<T>(tp,
+                     input_data + input_offset,                // A
+                     output_data,                              // B
+                     before_dims,                              // M
+                     split_size * after_dims_excluding_split,  // N
+                     after_dims_including_split_axis);         // lda
 
     input_offset += split_size * after_dims_excluding_split;  // offset by the N data we used in this iteration
   }
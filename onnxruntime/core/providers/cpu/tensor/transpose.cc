@@ -2,7 +2,13 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/tensor/transpose.h"
+#include "core/providers/cpu/tensor/copy.h"
 #include "core/framework/utils.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+
+#include <algorithm>
+
 namespace onnxruntime {
 
 /* A permutation [a,b,c,...] indicates that 
@@ -239,293 +245,278 @@ static Status DoUntypedTranspose(const std::vector<size_t>& permutations, const
 }
 
 /*
-Optimizations for moving a single axis either inwards or outwards.
-
-If moving outwards we can use a single reader and multiple writers. The number of writers is equal to the value of 
-the axis being moved.
+Optimized transpose for tensors of primitive types.
 
-  e.g. if the input is NHWC with shape {N, 300, 300, 3}, we can transpose to NCHW by reading once and having
-       one writer for each of the 3 channels at a different offset in the output, updating the offset for each item
-       in the batch of N.
+The permutation is first normalized: axes of size 1 are dropped and input axes that stay adjacent in the output are
+merged. If the innermost axis does not move and spans 2, 4 or 8 bytes, it is folded into a wider element. For example
+NCHW to NHWC becomes a {N, C, HW} to {N, HW, C} permutation, and [B,S,H,D] to [B,H,S,D] stays a 4-D permutation that
+moves contiguous blocks of D elements.
 
-Similarly if one axis is moving inwards we can use a single writer and multiple readers. The number of readers is equal
-to the value of the axis being moved.
+After normalization one of two cases remains:
 
-  e.g. if the input is NCHW with shape {N, 3, 300, 300}, we can transpose to NHWC by writing once using one reader for
-       each of the 3 channels at a different offset in the input, updating the read offset for each item in the batch
-       of N.
+  - The innermost input axis is also the innermost output axis. The output is a sequence of contiguous blocks that
+    are copied with memcpy.
 
-This can be generalized for any input where only one axis is being moved, with the block size for each read/write
-being dependent on which axis is moving, what direction it's moving in, and where it's moving to.
+  - The innermost input axis moves. For each index of the remaining outer axes, the output innermost axis and the
+    input innermost axis form a 2-D transpose. This is tiled so that a tile of the source and destination stays in
+    the L1 cache, and each tile is transposed with MlasTranspose, which uses vector registers for square blocks of
+    1, 2, 4 or 8 byte elements.
 
-We use simple pointer arithmetic if the size of each read/write is a power of 2 and between 8 and 64 bits. 
-We use memcpy if the block size is larger.
-
-We fall back to the default implementation in all other cases, and if the input is std::string.
+The work is split into contiguous ranges of blocks or tiles that are distributed over the thread pool.
 */
 
-// moving a single axis outwards where the read/write size is a power of 2 and between 8 and 64 bits.
-template <typename T>
-static void SimpleTransposeSingleAxisOutwards(const T* input_data, T* output_data,
-                                              int64_t num_loops, int64_t num_writers,
-                                              int64_t writes_per_loop, int64_t writes_per_writer_per_loop) {
-  std::vector<T*> writers;
-  writers.resize(num_writers);
-
-  for (int64_t l = 0; l < num_loops; ++l) {
-    for (auto w = 0; w < num_writers; ++w) {
-      writers[w] = (output_data + (w * writes_per_writer_per_loop));
+// Permutation after axes of size 1 are dropped and adjacent axes are merged.
+// dims are in input order and perm maps each output axis to an input axis.
+struct NormalizedTranspose {
+  std::vector<int64_t> dims;
+  std::vector<size_t> perm;
+  size_t element_size;
+};
+
+static NormalizedTranspose NormalizeTranspose(const std::vector<size_t>& permutations,
+                                              const std::vector<int64_t>& input_dims, size_t element_size) {
+  const size_t rank = input_dims.size();
+
+  // group the output axes into runs of consecutive input axes, skipping axes of size 1
+  std::vector<std::pair<size_t, size_t>> groups;  // first and last input axis of each run, in output order
+  for (size_t i = 0; i < rank; ++i) {
+    size_t axis = permutations[i];
+    if (input_dims[axis] == 1) {
+      continue;
     }
-
-    for (auto wwpl = 0; wwpl < writes_per_writer_per_loop; ++wwpl) {
-      for (int64_t w = 0; w < num_writers; ++w) {
-        *(writers[w]++) = *input_data++;
+    if (!groups.empty()) {
+      // a run may continue past input axes of size 1
+      size_t next = groups.back().second + 1;
+      while (next < axis && input_dims[next] == 1) {
+        ++next;
+      }
+      if (next == axis) {
+        groups.back().second = axis;
+        continue;
       }
     }
-
-    output_data += writes_per_loop;
+    groups.emplace_back(axis, axis);
   }
-}
-
-static void TranposeSingleAxisOutwards(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
-                                       int64_t from, int64_t to) {
-  ORT_UNUSED_PARAMETER(permutations);
 
-  const auto& input_shape = input.Shape();
-  const auto& input_dims = input_shape.GetDims();
-
-  const auto element_size = input.DataType()->Size();
-
-  const auto* input_data = reinterpret_cast<const uint8_t*>(input.DataRaw());
-  auto* output_data = reinterpret_cast<uint8_t*>(output.MutableDataRaw());
-
-  auto num_loops = input_shape.SizeToDimension(to);
-  auto num_writers = input_dims[from];
-  auto block_size = input_shape.SizeFromDimension(from + 1);
-  auto writes_per_loop = int64_t(input_shape.Size() / num_loops / block_size);
-  auto writes_per_writer_per_loop = int64_t(writes_per_loop / num_writers);
-  const int64_t bytes_per_write = block_size * element_size;
-
-  switch (bytes_per_write) {
-    case (sizeof(uint8_t)): {
-      SimpleTransposeSingleAxisOutwards(input_data, output_data,
-                                        num_loops, num_writers, writes_per_loop, writes_per_writer_per_loop);
-      break;
-    }
-    case (sizeof(uint16_t)): {
-      SimpleTransposeSingleAxisOutwards(reinterpret_cast<const uint16_t*>(input_data),
-                                        reinterpret_cast<uint16_t*>(output_data),
-                                        num_loops, num_writers, writes_per_loop, writes_per_writer_per_loop);
-      break;
-    }
-    case (sizeof(uint32_t)): {
-      SimpleTransposeSingleAxisOutwards(reinterpret_cast<const uint32_t*>(input_data),
-                                        reinterpret_cast<uint32_t*>(output_data),
-                                        num_loops, num_writers, writes_per_loop, writes_per_writer_per_loop);
-      break;
-    }
-    case (sizeof(uint64_t)): {
-      SimpleTransposeSingleAxisOutwards(reinterpret_cast<const uint64_t*>(input_data),
-                                        reinterpret_cast<uint64_t*>(output_data),
-                                        num_loops, num_writers, writes_per_loop, writes_per_writer_per_loop);
-      break;
+  // number the runs in input order
+  std::vector<size_t> order(groups.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(), [&groups](size_t a, size_t b) { return groups[a].first < groups[b].first; });
+
+  NormalizedTranspose normalized;
+  normalized.dims.resize(groups.size());
+  normalized.perm.resize(groups.size());
+  normalized.element_size = element_size;
+
+  for (size_t j = 0; j < order.size(); ++j) {
+    const auto& group = groups[order[j]];
+    int64_t dim = 1;
+    for (size_t axis = group.first; axis <= group.second; ++axis) {
+      dim *= input_dims[axis];
     }
-    default: {
-      // we need to use memcpy for each block
-      std::vector<uint8_t*> writers;
-      writers.resize(num_writers);
-
-      for (int64_t l = 0; l < num_loops; ++l) {
-        for (auto w = 0; w < num_writers; ++w) {
-          writers[w] = (output_data + (w * writes_per_writer_per_loop * bytes_per_write));
-        }
-
-        for (auto wwpl = 0; wwpl < writes_per_writer_per_loop; ++wwpl) {
-          for (int64_t w = 0; w < num_writers; ++w) {
-            memcpy(writers[w], input_data, bytes_per_write);
-            writers[w] += bytes_per_write;
-            input_data += bytes_per_write;
-          }
-        }
-
-        output_data += writes_per_loop * bytes_per_write;
-      }
+    normalized.dims[j] = dim;
+    normalized.perm[order[j]] = j;
+  }
+
+  // fold an innermost axis that does not move into a wider element
+  const size_t normalized_rank = normalized.dims.size();
+  if (normalized_rank >= 2 && normalized.perm[normalized_rank - 1] == normalized_rank - 1) {
+    size_t block_size = static_cast<size_t>(normalized.dims[normalized_rank - 1]) * element_size;
+    if (block_size == 2 || block_size == 4 || block_size == 8) {
+      normalized.element_size = block_size;
+      normalized.dims.pop_back();
+      normalized.perm.pop_back();
     }
   }
+
+  return normalized;
 }
 
-template <typename T>
-static void SimpleTransposeSingleAxisInwards(const T* input_data, T* output_data,
-                                             int64_t num_loops, int64_t num_readers,
-                                             int64_t reads_per_loop, int64_t reads_per_reader_per_loop) {
-  std::vector<const T*> readers;
-  readers.resize(num_readers);
-
-  for (int64_t l = 0; l < num_loops; ++l) {
-    for (auto r = 0; r < num_readers; ++r) {
-      readers[r] = (input_data + (r * reads_per_reader_per_loop));
+// Walks the index space of a set of axes in row-major order and tracks the matching input and output offsets.
+class TransposeIndexIterator {
+ public:
+  TransposeIndexIterator(std::vector<int64_t> dims, std::vector<size_t> input_strides,
+                         std::vector<size_t> output_strides)
+      : dims_(std::move(dims)),
+        input_strides_(std::move(input_strides)),
+        output_strides_(std::move(output_strides)),
+        index_(dims_.size(), 0) {}
+
+  void Seek(int64_t position) {
+    input_offset_ = 0;
+    output_offset_ = 0;
+    for (size_t k = dims_.size(); k-- > 0;) {
+      index_[k] = position % dims_[k];
+      position /= dims_[k];
+      input_offset_ += index_[k] * input_strides_[k];
+      output_offset_ += index_[k] * output_strides_[k];
     }
+  }
 
-    for (auto rrpl = 0; rrpl < reads_per_reader_per_loop; ++rrpl) {
-      for (int64_t r = 0; r < num_readers; ++r) {
-        *output_data++ = *(readers[r]++);
+  void Advance() {
+    for (size_t k = dims_.size(); k-- > 0;) {
+      input_offset_ += input_strides_[k];
+      output_offset_ += output_strides_[k];
+      if (++index_[k] < dims_[k]) {
+        return;
       }
+      input_offset_ -= index_[k] * input_strides_[k];
+      output_offset_ -= index_[k] * output_strides_[k];
+      index_[k] = 0;
     }
-
-    input_data += reads_per_loop;
   }
-}
-
-// moving a single axis inwards where the read/write size is a power of 2 and between 8 and 64 bits.
-static void TranposeSingleAxisInwards(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
-                                      int64_t from, int64_t to) {
-  ORT_UNUSED_PARAMETER(permutations);
-
-  const auto& input_shape = input.Shape();
-  const auto& input_dims = input_shape.GetDims();
 
-  const auto element_size = input.DataType()->Size();
+  int64_t Index(size_t k) const { return index_[k]; }
+  size_t InputOffset() const { return input_offset_; }
+  size_t OutputOffset() const { return output_offset_; }
+
+ private:
+  std::vector<int64_t> dims_;
+  std::vector<size_t> input_strides_;
+  std::vector<size_t> output_strides_;
+  std::vector<int64_t> index_;
+  size_t input_offset_ = 0;
+  size_t output_offset_ = 0;
+};
+
+static void TransposeBlocks(const NormalizedTranspose& t, const uint8_t* input_data, uint8_t* output_data,
+                            concurrency::ThreadPool* tp) {
+  const size_t rank = t.dims.size();
+  const size_t block_size = static_cast<size_t>(t.dims[rank - 1]) * t.element_size;
+
+  // iterate over the output axes other than the innermost one
+  std::vector<size_t> input_axis_strides(rank);
+  input_axis_strides[rank - 1] = t.element_size;
+  for (size_t k = rank - 1; k-- > 0;) {
+    input_axis_strides[k] = input_axis_strides[k + 1] * static_cast<size_t>(t.dims[k + 1]);
+  }
 
-  const auto* input_data = reinterpret_cast<const uint8_t*>(input.DataRaw());
-  auto* output_data = reinterpret_cast<uint8_t*>(output.MutableDataRaw());
+  std::vector<int64_t> dims(rank - 1);
+  std::vector<size_t> input_strides(rank - 1);
+  std::vector<size_t> output_strides(rank - 1);
+  int64_t count = 1;
+  for (size_t k = rank - 1; k-- > 0;) {
+    dims[k] = t.dims[t.perm[k]];
+    input_strides[k] = input_axis_strides[t.perm[k]];
+    output_strides[k] = block_size * static_cast<size_t>(count);
+    count *= dims[k];
+  }
 
-  auto num_loops = input_shape.SizeToDimension(from);
-  auto num_readers = input_dims[from];
-  auto block_size = input_shape.SizeFromDimension(to + 1);
-  auto reads_per_loop = int64_t(input_shape.Size() / num_loops / block_size);
-  auto reads_per_reader_per_loop = int64_t(reads_per_loop / num_readers);
-  const int64_t bytes_per_read = block_size * element_size;
-
-  switch (bytes_per_read) {
-    case (sizeof(uint8_t)): {
-      SimpleTransposeSingleAxisInwards(input_data, output_data,
-                                       num_loops, num_readers, reads_per_loop, reads_per_reader_per_loop);
-      break;
-    }
-    case (sizeof(uint16_t)): {
-      SimpleTransposeSingleAxisInwards(reinterpret_cast<const uint16_t*>(input_data),
-                                       reinterpret_cast<uint16_t*>(output_data),
-                                       num_loops, num_readers, reads_per_loop, reads_per_reader_per_loop);
-      break;
-    }
-    case (sizeof(uint32_t)): {
-      SimpleTransposeSingleAxisInwards(reinterpret_cast<const uint32_t*>(input_data),
-                                       reinterpret_cast<uint32_t*>(output_data),
-                                       num_loops, num_readers, reads_per_loop, reads_per_reader_per_loop);
-      break;
+  ParallelForBlocks(tp, count, block_size, [&](int64_t first, int64_t last) {
+    TransposeIndexIterator it(dims, input_strides, output_strides);
+    it.Seek(first);
+    for (int64_t i = first; i < last; ++i) {
+      memcpy(output_data + it.OutputOffset(), input_data + it.InputOffset(), block_size);
+      it.Advance();
     }
-    case (sizeof(uint64_t)): {
-      SimpleTransposeSingleAxisInwards(reinterpret_cast<const uint64_t*>(input_data),
-                                       reinterpret_cast<uint64_t*>(output_data),
-                                       num_loops, num_readers, reads_per_loop, reads_per_reader_per_loop);
-      break;
-    }
-    default: {
-      // we need to use memcpy for each block
-      std::vector<const uint8_t*> readers;
-      readers.resize(num_readers);
-
-      for (int64_t l = 0; l < num_loops; ++l) {
-        for (auto r = 0; r < num_readers; ++r) {
-          readers[r] = (input_data + (r * reads_per_reader_per_loop * bytes_per_read));
-        }
-
-        for (auto rrpl = 0; rrpl < reads_per_reader_per_loop; ++rrpl) {
-          for (int64_t r = 0; r < num_readers; ++r) {
-            memcpy(output_data, readers[r], bytes_per_read);
-            readers[r] += bytes_per_read;
-            output_data += bytes_per_read;
-          }
-        }
-
-        input_data += reads_per_loop * bytes_per_read;
-      }
-    }
-  }
+  });
 }
 
-static void SingleAxisTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
-                                size_t from, size_t to) {
-  // TODO: We may want to fall back to the default implementation if the size of the axis being moved is large
-  // compared to the other axes.
-  // e.g. transpose {3, 2048} with permutation of {1, 0} would result in 2048 writers being created
-  //   (std::vector<uint8_t*> of size 2048) but only used in 3 loops. however that may still be cheaper than
-  //   calling ComputeOffset and IncrementIndex 6K times.
+template <typename T>
+static void TransposeTiles(const NormalizedTranspose& t, const T* input_data, T* output_data,
+                           concurrency::ThreadPool* tp) {
+  // square tiles that keep the source and destination tiles in the L1 cache
+  constexpr int64_t kTileSize = sizeof(T) <= 2 ? 64 : 32;
 
-  if (from > to) {
-    TranposeSingleAxisOutwards(permutations, input, output, from, to);
-  } else {
-    TranposeSingleAxisInwards(permutations, input, output, from, to);
-  }
-}
+  const size_t rank = t.dims.size();
 
-static bool IsMovingSingleAxis(const std::vector<size_t>& permutations, size_t& from, size_t& to) {
-  // if a single axis moved to an outer dimension, the values should be one lower than the index until the slot the
-  // axis was moved from, and equal to the index after that.
-  // e.g. axis 3 moves out to 1 would be: 0, 3, 1, 2, 4
-  auto check_moved_outwards = [&permutations](size_t cur, size_t moved_from) {
-    // we start processing with the slot after the moved one, so the expected value is one less than the index
-    size_t expected = cur - 1;
-    for (size_t end = permutations.size(); cur < end; ++cur) {
-      if (permutations[cur] != expected) {
-        return false;
-      }
+  std::vector<size_t> input_axis_strides(rank);
+  input_axis_strides[rank - 1] = 1;
+  for (size_t k = rank - 1; k-- > 0;) {
+    input_axis_strides[k] = input_axis_strides[k + 1] * static_cast<size_t>(t.dims[k + 1]);
+  }
 
-      // we are at the slot the axis moved from, so do an additional increment before checking the next value
-      if (cur == moved_from) {
-        ++expected;
-      }
+  std::vector<size_t> output_axis_strides(rank);
+  output_axis_strides[rank - 1] = 1;
+  for (size_t k = rank - 1; k-- > 0;) {
+    output_axis_strides[k] = output_axis_strides[k + 1] * static_cast<size_t>(t.dims[t.perm[k + 1]]);
+  }
 
-      ++expected;
+  // the rows of the 2-D transpose run along the output innermost axis and the columns along the input innermost axis
+  const size_t row_axis = t.perm[rank - 1];
+  const size_t column_position = static_cast<size_t>(
+      std::find(t.perm.begin(), t.perm.end(), rank - 1) - t.perm.begin());
+  const int64_t rows = t.dims[row_axis];
+  const int64_t columns = t.dims[rank - 1];
+  const size_t ld_input = input_axis_strides[row_axis];
+  const size_t ld_output = output_axis_strides[column_position];
+
+  // iterate over the remaining output axes followed by the tiles of rows
+  std::vector<int64_t> dims;
+  std::vector<size_t> input_strides;
+  std::vector<size_t> output_strides;
+  int64_t count = 1;
+  for (size_t k = 0; k < rank - 1; ++k) {
+    if (k != column_position) {
+      dims.push_back(t.dims[t.perm[k]]);
+      input_strides.push_back(input_axis_strides[t.perm[k]]);
+      output_strides.push_back(output_axis_strides[k]);
+      count *= t.dims[t.perm[k]];
     }
-
-    return true;
-  };
-
-  // if a single axis moved to an inner dimension, the values should be one higher than the index until the slot the
-  // axis was moved to, and equal to the index after that.
-  // e.g. axis 1 moves inwards to 3 would be: 0, 2, 3, 1, 4
-  auto check_moved_inwards = [&permutations](size_t cur, size_t& moved_to) {
-    size_t started_at = cur;
-    size_t expected = cur + 1;
-    moved_to = std::numeric_limits<size_t>::max();
-
-    for (size_t end = permutations.size(); cur < end; ++cur) {
-      if (permutations[cur] != expected) {
-        // if a single axis moved it must have come from the location we started at
-        if (started_at != permutations[cur]) {
-          return false;
-        }
-
-        moved_to = cur;
-      } else {
-        ++expected;
+  }
+  const int64_t row_tiles = (rows + kTileSize - 1) / kTileSize;
+  dims.push_back(row_tiles);
+  input_strides.push_back(ld_input * kTileSize);
+  output_strides.push_back(kTileSize);
+  count *= row_tiles;
+
+  const size_t bytes_per_unit = static_cast<size_t>(std::min(rows, kTileSize) * columns) * sizeof(T);
+
+  ParallelForBlocks(tp, count, bytes_per_unit, [&](int64_t first, int64_t last) {
+    TransposeIndexIterator it(dims, input_strides, output_strides);
+    it.Seek(first);
+    for (int64_t i = first; i < last; ++i) {
+      const int64_t row = it.Index(dims.size() - 1) * kTileSize;
+      const size_t tile_rows = static_cast<size_t>(std::min(kTileSize, rows - row));
+      const T* input = input_data + it.InputOffset();
+      T* output = output_data + it.OutputOffset();
+      for (int64_t column = 0; column < columns; column += kTileSize) {
+        const size_t tile_columns = static_cast<size_t>(std::min(kTileSize, columns - column));
+        MlasTranspose(input + column, output + column * ld_output, tile_rows, tile_columns, ld_input, ld_output);
       }
+      it.Advance();
     }
+  });
+}
 
-    return moved_to != std::numeric_limits<size_t>::max();
-  };
+static Status DoTypedTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
+                               concurrency::ThreadPool* tp) {
+  if (input.IsDataTypeString()) {
+    return DoUntypedTranspose(permutations, input, output);
+  }
 
-  bool single_axis_moved = false;
-  // check axis moving outwards (earlier entry in permutations)
-  for (size_t i = 0, end = permutations.size(); i < end; ++i) {
-    size_t axis = permutations[i];
+  const auto* input_data = reinterpret_cast<const uint8_t*>(input.DataRaw());
+  auto* output_data = reinterpret_cast<uint8_t*>(output.MutableDataRaw());
 
-    if (axis != i) {
-      if (check_moved_outwards(i + 1, axis)) {
-        single_axis_moved = true;
-        to = i;
-        from = axis;
-      } else if (check_moved_inwards(i, to)) {
-        single_axis_moved = true;
-        from = i;
-      }
+  const NormalizedTranspose t = NormalizeTranspose(permutations, input.Shape().GetDims(), input.DataType()->Size());
+  const size_t rank = t.dims.size();
 
-      break;
+  if (rank <= 1) {
+    memcpy(output_data, input_data, input.Shape().Size() * input.DataType()->Size());
+  } else if (t.perm[rank - 1] == rank - 1) {
+    TransposeBlocks(t, input_data, output_data, tp);
+  } else {
+    switch (t.element_size) {
+      case sizeof(uint8_t):
+        TransposeTiles(t, input_data, output_data, tp);
+        break;
+      case sizeof(uint16_t):
+        TransposeTiles(t, reinterpret_cast<const uint16_t*>(input_data), reinterpret_cast<uint16_t*>(output_data), tp);
+        break;
+      case sizeof(uint32_t):
+        TransposeTiles(t, reinterpret_cast<const uint32_t*>(input_data), reinterpret_cast<uint32_t*>(output_data), tp);
+        break;
+      case sizeof(uint64_t):
+        TransposeTiles(t, reinterpret_cast<const uint64_t*>(input_data), reinterpret_cast<uint64_t*>(output_data), tp);
+        break;
+      default:
+        return DoUntypedTranspose(permutations, input, output);
     }
   }
 
-  return single_axis_moved;
+  return Status::OK();
 }
 
 Status TransposeBase::DoTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output) {
@@ -537,16 +528,8 @@ Status TransposeBase::DoTranspose(const std::vector<size_t>& permutations, const
   if (input_type != output_type) {
     status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Mismatched data types between input and output Tensors. ",
                              input_type, " != ", output_type);
-  } else {
-    size_t from = 0, to = 0;
-    bool moving_single_axis = IsMovingSingleAxis(permutations, from, to);
-
-    if (moving_single_axis && !input.IsDataTypeString()) {
-      SingleAxisTranspose(permutations, input, output, from, to);
-    } else {
-      // fall back to default implementation
-      status = DoUntypedTranspose(permutations, input, output);
-    }
+  } else if (input.Shape().Size() != 0) {
+    status = DoTypedTranspose(permutations, input, output, nullptr);
   }
 
   return status;
@@ -570,26 +553,28 @@ Status Transpose::Compute(OpKernelContext* ctx) const {
   TensorShape output_shape{output_dims};
   Tensor& Y = *ctx->Output(0, output_shape);
 
-  if (output_shape.Size() == 0)
+  if (ctx->IsStridedViewOutput(0)) {
+    // the output shares the input buffer with the input strides permuted
+    ORT_ENFORCE(Y.DataRaw() == X.DataRaw());
+    const auto input_strides = X.Strides();
+    std::vector<int64_t> output_strides(rank);
+    for (size_t i = 0; i < rank; ++i) {
+      output_strides[i] = input_strides[(*p_perm)[i]];
+    }
+    Y.SetStridedView(output_strides, X.ByteOffset());
     return Status::OK();
-
-  size_t from = 0, to = 0;
-  bool moving_single_axis = IsMovingSingleAxis(*p_perm, from, to);
-
-  if (moving_single_axis && !X.IsDataTypeString()) {
-    SingleAxisTranspose(*p_perm, X, Y, from, to);
-  } else {
-    // fall back to default implementation
-    status = DoUntypedTranspose(*p_perm, X, Y);
   }
 
-  return status;
+  if (output_shape.Size() == 0)
+    return Status::OK();
+
+  return DoTypedTranspose(*p_perm, X, Y, ctx->GetOperatorThreadPool());
 }
 
 ONNX_CPU_OPERATOR_KERNEL(
     Transpose,
     1,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::AllTensorTypes()),
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::AllTensorTypes()).MayStridedOutput(0, 0),
     Transpose);
 
 }  // namespace onnxruntime
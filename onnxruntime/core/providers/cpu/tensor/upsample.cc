@@ -2,7 +2,9 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/tensor/upsample.h"
+#include <algorithm>
 #include <sstream>
+#include "core/providers/cpu/tensor/copy.h"
 
 using namespace onnxruntime::common;
 using namespace std;
@@ -29,31 +31,29 @@ ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<uint8_t>()),
     Upsample<uint8_t>);
 
-
 template <typename T>
 void UpsampleNearest2x(int64_t batch_size,
                        int64_t num_channels,
                        int64_t input_height,
                        int64_t input_width,
                        const T* input,
-                       T* output) {
-  const int64_t output_height = input_height * 2;
+                       T* output,
+                       concurrency::ThreadPool* tp) {
   const int64_t output_width = input_width * 2;
-  for (int64_t n = 0; n < batch_size; ++n) {
-    for (int64_t c = 0; c < num_channels; ++c) {
-      for (int64_t y = 0; y < output_height; ++y) {
-        const int64_t in_y = y / 2;
-        for (int64_t x = 0; x < input_width; ++x) {
-          const T v = input[in_y * input_width + x];
-          const int64_t oidx = output_width * y + x * 2;
-          output[oidx + 0] = v;
-          output[oidx + 1] = v;
-        }
-      }
-      input += input_height * input_width;
-      output += output_height * output_width;
-    }
-  }
+  // each input row is written to two consecutive output rows
+  ParallelForBlocks(tp, batch_size * num_channels * input_height, static_cast<size_t>(2 * output_width) * sizeof(T),
+                    [&](int64_t first, int64_t last) {
+                      for (int64_t row = first; row < last; ++row) {
+                        const T* in = input + row * input_width;
+                        T* out = output + row * 2 * output_width;
+                        for (int64_t x = 0; x < input_width; ++x) {
+                          const T v = in[x];
+                          out[x * 2 + 0] = v;
+                          out[x * 2 + 1] = v;
+                        }
+                        memcpy(out + output_width, out, output_width * sizeof(T));
+                      }
+                    });
 }
 
 template <typename T>
@@ -62,13 +62,11 @@ Status UpsampleNearest(const T* input,
                        const TensorShape& input_shape,
                        const TensorShape& output_shape,
                        const vector<float>& scales,
-                       const vector<float>& roi,
                        bool is_resize,
-                       bool extrapolation_enabled,
                        float extrapolation_value,
                        bool use_nearest2x_optimization,
-                       GetOriginalCoordinateFunc get_original_coordinate,
-                       GetNearestPixelFunc get_nearest_pixel) {
+                       const UpsampleTables& tables,
+                       concurrency::ThreadPool* tp) {
   if (!input || !output)
     return Status(ONNXRUNTIME, FAIL,
                   is_resize ? "Resize: input/output value is nullptr"
@@ -85,125 +83,58 @@ Status UpsampleNearest(const T* input,
 
   int64_t n_dim = static_cast<int64_t>(input_shape.NumDimensions());
 
-  std::vector<int64_t> input_dim_counters(n_dim);
-  std::vector<int64_t> input_dim_factor(n_dim);
-  std::vector<bool> use_extrapolation_value(n_dim);
-  input_dim_factor[n_dim - 1] = 1;  // initialize dimension factor
-  for (int64_t dim_idx = n_dim - 2; dim_idx >= 0; dim_idx--) {
-    input_dim_factor[dim_idx] = input_dim_factor[dim_idx + 1] * input_shape[dim_idx + 1];
-  }
-
-  int64_t output_idx = 0;
-  int64_t input_idx = 0;
-
-#define OneDimensionProcessor(dim_inx)                                                                                                                                                                                                               \
-  use_extrapolation_value[dim_inx] = false;                                                                                                                                                                                                          \
-  float original_##dim_inx##_idx = get_original_coordinate(static_cast<float>(output_dim##dim_inx##_inx), scales[dim_inx], static_cast<float>(output_shape[dim_inx]), static_cast<float>(input_shape[dim_inx]), roi[dim_inx], roi[n_dim + dim_inx]); \
-  if (extrapolation_enabled && (original_##dim_inx##_idx < 0 || original_##dim_inx##_idx > input_shape[dim_inx] - 1)) use_extrapolation_value[dim_inx] = true;                                                                                       \
-  int64_t input_dim##dim_inx##_inx = get_nearest_pixel(original_##dim_inx##_idx, scales[dim_inx] < 1);                                                                                                                                               \
-  if (input_dim##dim_inx##_inx > input_shape[dim_inx] - 1) input_dim##dim_inx##_inx = input_shape[dim_inx] - 1;                                                                                                                                      \
-  if (input_dim##dim_inx##_inx < 0) input_dim##dim_inx##_inx = 0;                                                                                                                                                                                    \
-  if (input_dim##dim_inx##_inx != input_dim_counters[dim_inx]) {                                                                                                                                                                                     \
-    input_idx += (input_dim##dim_inx##_inx - input_dim_counters[dim_inx]) * input_dim_factor[dim_inx];                                                                                                                                               \
-    input_dim_counters[dim_inx] = input_dim##dim_inx##_inx;                                                                                                                                                                                          \
+  if (n_dim == 4 && use_nearest2x_optimization &&
+      scales[0] == 1 && scales[1] == 1 && scales[2] == 2 && scales[3] == 2) {
+    UpsampleNearest2x<T>(input_shape[0], input_shape[1], input_shape[2], input_shape[3], input, output, tp);
+    return Status::OK();
   }
 
-  if (n_dim == 1) {
-    for (int64_t output_dim0_inx = 0; output_dim0_inx < output_shape[0]; output_dim0_inx++) {
-      OneDimensionProcessor(0);
-      output[output_idx++] = use_extrapolation_value[0] ? static_cast<T>(extrapolation_value) : input[input_idx];
-    }
+  if (output_shape.Size() == 0) {
     return Status::OK();
   }
 
-  if (n_dim == 2) {
-    for (int64_t output_dim0_inx = 0; output_dim0_inx < output_shape[0]; output_dim0_inx++) {
-      OneDimensionProcessor(0);
-      for (int64_t output_dim1_inx = 0; output_dim1_inx < output_shape[1]; output_dim1_inx++) {
-        OneDimensionProcessor(1);
-        output[output_idx++] = (use_extrapolation_value[0] || use_extrapolation_value[1])
-                                   ? static_cast<T>(extrapolation_value)
-                                   : input[input_idx];
-      }
+  const int64_t inner_size = output_shape[n_dim - 1];
+  const int64_t row_count = output_shape.Size() / inner_size;
+  const std::vector<int64_t>& inner_offsets = tables.nearest_offsets[n_dim - 1];
+  const T extrapolation = static_cast<T>(extrapolation_value);
+
+  // Each output row along the innermost axis reads from a single input row, which is found by adding up the offsets
+  // of the outer indices of the output row.
+  ParallelForBlocks(tp, row_count, static_cast<size_t>(inner_size) * sizeof(T), [&](int64_t first, int64_t last) {
+    std::vector<int64_t> counters(n_dim - 1);
+    for (int64_t dim_idx = n_dim - 2, rest = first; dim_idx >= 0; dim_idx--) {
+      counters[dim_idx] = rest % output_shape[dim_idx];
+      rest /= output_shape[dim_idx];
     }
-    return Status::OK();
-  }
 
-  if (n_dim == 3) {
-    for (int64_t output_dim0_inx = 0; output_dim0_inx < output_shape[0]; output_dim0_inx++) {
-      OneDimensionProcessor(0);
-      for (int64_t output_dim1_inx = 0; output_dim1_inx < output_shape[1]; output_dim1_inx++) {
-        OneDimensionProcessor(1);
-        for (int64_t output_dim2_inx = 0; output_dim2_inx < output_shape[2]; output_dim2_inx++) {
-          OneDimensionProcessor(2);
-          bool use_extrapolation = std::any_of(use_extrapolation_value.begin(), use_extrapolation_value.end(),
-                                               [](bool use_extrapolation) {
-                                                 return use_extrapolation == true;
-                                               });
-
-          output[output_idx++] = use_extrapolation ? static_cast<T>(extrapolation_value) : input[input_idx];
+    for (int64_t row = first; row < last; ++row) {
+      int64_t input_offset = 0;
+      bool use_extrapolation = false;
+      for (int64_t dim_idx = 0; dim_idx < n_dim - 1; dim_idx++) {
+        const int64_t offset = tables.nearest_offsets[dim_idx][counters[dim_idx]];
+        if (offset < 0) {
+          use_extrapolation = true;
+        } else {
+          input_offset += offset;
         }
       }
-    }
-    return Status::OK();
-  }
 
-  if (n_dim == 4) {
-    if (use_nearest2x_optimization && scales[0] == 1 && scales[1] == 1 && scales[2] == 2 && scales[3] == 2) {
-      UpsampleNearest2x<T>(input_shape[0], input_shape[1], input_shape[2], input_shape[3], input, output);
-      return Status::OK();
-    }
-    for (int64_t output_dim0_inx = 0; output_dim0_inx < output_shape[0]; output_dim0_inx++) {
-      OneDimensionProcessor(0);
-      for (int64_t output_dim1_inx = 0; output_dim1_inx < output_shape[1]; output_dim1_inx++) {
-        OneDimensionProcessor(1);
-        for (int64_t output_dim2_inx = 0; output_dim2_inx < output_shape[2]; output_dim2_inx++) {
-          OneDimensionProcessor(2);
-          for (int64_t output_dim3_inx = 0; output_dim3_inx < output_shape[3]; output_dim3_inx++) {
-            OneDimensionProcessor(3);
-            bool use_extrapolation = std::any_of(use_extrapolation_value.begin(), use_extrapolation_value.end(),
-                                                 [](bool use_extrapolation) {
-                                                   return use_extrapolation == true;
-                                                 });
-
-            output[output_idx++] = use_extrapolation ? static_cast<T>(extrapolation_value) : input[input_idx];
-          }
+      T* out = output + row * inner_size;
+      if (use_extrapolation) {
+        std::fill_n(out, inner_size, extrapolation);
+      } else {
+        const T* in = input + input_offset;
+        for (int64_t i = 0; i < inner_size; i++) {
+          const int64_t offset = inner_offsets[i];
+          out[i] = offset < 0 ? extrapolation : in[offset];
         }
       }
-    }
-    return Status::OK();
-  }
-
-#undef OneDimensionProcessor
 
-  std::vector<int64_t> output_dim_counter(n_dim);
-  output_dim_counter[n_dim - 1] = -1;  // initialize dimension counter
-
-  for (; output_idx < output_shape.Size(); output_idx++) {
-    for (int64_t dim_idx = n_dim - 1; dim_idx >= 0; dim_idx--) {
-      if (++output_dim_counter[dim_idx] < output_shape[dim_idx]) {
-        int64_t current_input_dim_counter = 0;
-        auto original_idx = get_original_coordinate(static_cast<float>(output_dim_counter[dim_idx]), scales[dim_idx],
-                                                    static_cast<float>(output_shape[dim_idx]), static_cast<float>(input_shape[dim_idx]),
-                                                    roi[dim_idx], roi[n_dim + dim_idx]);
-        current_input_dim_counter = get_nearest_pixel(original_idx, scales[dim_idx] < 1);
-        current_input_dim_counter = std::max((int64_t)0,
-                                             std::min(current_input_dim_counter, (input_shape[dim_idx] - 1)));
-
-        if (current_input_dim_counter != input_dim_counters[dim_idx]) {
-          input_idx += (current_input_dim_counter - input_dim_counters[dim_idx]) * input_dim_factor[dim_idx];
-          input_dim_counters[dim_idx] = current_input_dim_counter;
-        }
-        break;
-      } else {
-        output_dim_counter[dim_idx] = 0;
-        input_idx += (0 - input_dim_counters[dim_idx]) * input_dim_factor[dim_idx];
-        input_dim_counters[dim_idx] = 0;
+      for (int64_t dim_idx = n_dim - 2; dim_idx >= 0 && ++counters[dim_idx] == output_shape[dim_idx]; dim_idx--) {
+        counters[dim_idx] = 0;
       }
     }
-
-    output[output_idx] = input[input_idx];
-  }
+  });
 
   return Status::OK();
 }
@@ -283,112 +214,172 @@ Status UpsampleLinear(const T* input,
 // the scale values for the outermost 2 dimensions are 1.
 // This is the common use-case where the 4-D input (batched multi-channel images)
 // is usually of shape [N, C, H, W] and the scales are [1.0, 1.0, height_scale, width_scale]
+// The output rows of all the images are computed in parallel. Floating point inputs are interpolated along the
+// width first, keeping the two interpolated input rows while consecutive output rows read them, and then along the
+// height. Integer inputs keep weighting the four pixels of each output pixel at once, so that the truncation to
+// the integer type sees the same values, except for the uint8 images that UpsampleBilinearFixedPoint handles.
 template <typename T>
-void UpsampleBilinear(int64_t batch_size,
-                      int64_t num_channels,
+void UpsampleBilinear(int64_t num_images,
                       int64_t input_height,
                       int64_t input_width,
                       int64_t output_height,
                       int64_t output_width,
-                      float height_scale,
-                      float width_scale,
-                      const std::vector<float>& roi,
                       bool use_extrapolation,
                       float extrapolation_value,
+                      const UpsampleTables& tables,
                       const T* Xdata,
                       T* Ydata,
-                      AllocatorPtr& alloc,
-                      GetOriginalCoordinateFunc get_original_coordinate) {
-  std::vector<float> y_original;
-  std::vector<float> x_original;
-
-  size_t idx_buffer_size = 2 * sizeof(int64_t) * (output_height + output_width);
-  size_t scale_buffer_size = 2 * sizeof(float_t) * (output_height + output_width);
-  auto inx_scale_data_buffer = alloc->Alloc(idx_buffer_size + scale_buffer_size);
-  BufferUniquePtr idx_scale_data_buffer_holder(inx_scale_data_buffer, BufferDeleter(alloc));
-  auto* idx_data = static_cast<int64_t*>(idx_scale_data_buffer_holder.get());
-  int64_t* input_width_mul_y1 = idx_data;
-  int64_t* input_width_mul_y2 = idx_data + output_height;
-  int64_t* in_x1 = idx_data + 2 * output_height;
-  int64_t* in_x2 = idx_data + 2 * output_height + output_width;
-
-  auto* scale_data = reinterpret_cast<float*>(in_x2 + output_width);
-  float* dy1 = scale_data;
-  float* dy2 = scale_data + output_height;
-  float* dx1 = scale_data + 2 * output_height;
-  float* dx2 = scale_data + 2 * output_height + output_width;
-
-  auto roi_y_start = roi.size() / 2 - 2;
-  auto roi_y_end = roi.size() - 2;
-  for (int64_t y = 0; y < output_height; ++y) {
-    float in_y = get_original_coordinate(static_cast<float>(y), height_scale,
-                                         static_cast<float>(output_height), static_cast<float>(input_height),
-                                         roi[roi_y_start], roi[roi_y_end]);
-    y_original.emplace_back(in_y);
-    in_y = std::max(0.0f, std::min(in_y, static_cast<float>(input_height - 1)));
-
-    const int64_t in_y1 = std::min(static_cast<int64_t>(in_y), input_height - 1);
-    const int64_t in_y2 = std::min(in_y1 + 1, input_height - 1);
-    dy1[y] = std::fabs(in_y - in_y1);
-    dy2[y] = std::fabs(in_y - in_y2);
-
-    if (in_y1 == in_y2) {
-      dy1[y] = 0.5f;
-      dy2[y] = 0.5f;
-    }
+                      concurrency::ThreadPool* tp) {
+  const int64_t* y_index = tables.y.index.data();
+  const float* y_weight = tables.y.weight.data();
+  const int64_t* x_index = tables.x.index.data();
+  const float* x_weight = tables.x.weight.data();
+  const T extrapolation = static_cast<T>(extrapolation_value);
+  const bool separable = std::is_floating_point<T>::value;
+
+  ParallelForBlocks(tp, num_images * output_height, static_cast<size_t>(output_width) * 4 * sizeof(T),
+                    [&](int64_t first, int64_t last) {
+    std::vector<float> row_buffer(separable ? 2 * output_width : 0);
+    int64_t cached_rows[2] = {-1, -1};
+    int64_t cached_image = -1;
+
+    for (int64_t r = first; r < last; ++r) {
+      const int64_t image = r / output_height;
+      const int64_t y = r % output_height;
+      const T* X = Xdata + image * input_height * input_width;
+      T* Y = Ydata + r * output_width;
+
+      // when use_extrapolation is set and original index of y is out of the dim range
+      // then use extrapolation_value as the output value.
+      if (use_extrapolation && tables.y.outside[y]) {
+        std::fill_n(Y, output_width, extrapolation);
+        continue;
+      }
 
-    input_width_mul_y1[y] = input_width * in_y1;
-    input_width_mul_y2[y] = input_width * in_y2;
-  }
+      const float wy1 = y_weight[2 * y];
+      const float wy2 = y_weight[2 * y + 1];
 
-  auto roi_x_start = roi.size() / 2 - 1;
-  auto roi_x_end = roi.size() - 1;
-  for (int64_t x = 0; x < output_width; ++x) {
-    float in_x = get_original_coordinate(static_cast<float>(x), width_scale,
-                                         static_cast<float>(output_width), static_cast<float>(input_width),
-                                         roi[roi_x_start], roi[roi_x_end]);
-    x_original.emplace_back(in_x);
-    in_x = std::max(0.0f, std::min(in_x, static_cast<float>(input_width - 1)));
-
-    in_x1[x] = std::min(static_cast<int64_t>(in_x), input_width - 1);
-    in_x2[x] = std::min(in_x1[x] + 1, input_width - 1);
-
-    dx1[x] = std::abs(in_x - in_x1[x]);
-    dx2[x] = std::abs(in_x - in_x2[x]);
-    if (in_x1[x] == in_x2[x]) {
-      dx1[x] = 0.5f;
-      dx2[x] = 0.5f;
-    }
-  }
+      if (separable) {
+        if (image != cached_image) {
+          cached_rows[0] = cached_rows[1] = -1;
+          cached_image = image;
+        }
+        const float* h[2];
+        for (int tap = 0; tap < 2; ++tap) {
+          const int64_t row = y_index[2 * y + tap];
+          float* h_row = row_buffer.data() + (row & 1) * output_width;
+          if (cached_rows[row & 1] != row) {
+            const T* in = X + row * input_width;
+            for (int64_t x = 0; x < output_width; ++x) {
+              h_row[x] = x_weight[2 * x] * in[x_index[2 * x]] + x_weight[2 * x + 1] * in[x_index[2 * x + 1]];
+            }
+            cached_rows[row & 1] = row;
+          }
+          h[tap] = h_row;
+        }
+        for (int64_t x = 0; x < output_width; ++x) {
+          Y[x] = static_cast<T>(wy1 * h[0][x] + wy2 * h[1][x]);
+        }
+      } else {
+        const T* in1 = X + y_index[2 * y] * input_width;
+        const T* in2 = X + y_index[2 * y + 1] * input_width;
+        for (int64_t x = 0; x < output_width; ++x) {
+          const int64_t x1 = x_index[2 * x];
+          const int64_t x2 = x_index[2 * x + 1];
+          const float wx1 = x_weight[2 * x];
+          const float wx2 = x_weight[2 * x + 1];
+          Y[x] = static_cast<T>(wx1 * wy1 * in1[x1] + wx2 * wy1 * in1[x2] + wx1 * wy2 * in2[x1] + wx2 * wy2 * in2[x2]);
+        }
+      }
 
-  for (int64_t n = 0; n < batch_size; ++n) {
-    for (int64_t c = 0; c < num_channels; ++c) {
-      for (int64_t y = 0; y < output_height; ++y) {
+      if (use_extrapolation) {
         for (int64_t x = 0; x < output_width; ++x) {
-          // when use_extrapolation is set and original index of x or y is out of the dim range
-          // then use extrapolation_value as the output value.
-          if (use_extrapolation &&
-              ((y_original[y] < 0 || y_original[y] > static_cast<float>(input_height - 1)) ||
-               (x_original[x] < 0 || x_original[x] > static_cast<float>(input_width - 1)))) {
-            Ydata[output_width * y + x] = static_cast<T>(extrapolation_value);
-            continue;
+          if (tables.x.outside[x]) {
+            Y[x] = extrapolation;
           }
+        }
+      }
+    }
+  });
+}
 
-          T X11 = Xdata[input_width_mul_y1[y] + in_x1[x]];
-          T X21 = Xdata[input_width_mul_y1[y] + in_x2[x]];
-          T X12 = Xdata[input_width_mul_y2[y] + in_x1[x]];
-          T X22 = Xdata[input_width_mul_y2[y] + in_x2[x]];
+// uint8 images whose interpolation weights are all multiples of 2^-BilinearWeightBits, as for integer upsampling
+// scales, are interpolated in fixed point: along the width into rows of uint16 values with BilinearWeightBits
+// fractional bits, which are cached like the float rows, and then along the height. The float formula of the other
+// integer types is exact for those weights, as none of its products and sums needs more than 24 bits, so truncating
+// the fixed point value gives the same pixels.
+static void UpsampleBilinearFixedPoint(int64_t num_images,
+                                       int64_t input_height,
+                                       int64_t input_width,
+                                       int64_t output_height,
+                                       int64_t output_width,
+                                       bool use_extrapolation,
+                                       float extrapolation_value,
+                                       const UpsampleTables& tables,
+                                       const uint8_t* Xdata,
+                                       uint8_t* Ydata,
+                                       concurrency::ThreadPool* tp) {
+  const int64_t* y_index = tables.y.index.data();
+  const uint16_t* y_weight = tables.y.fixed_weight.data();
+  const int64_t* x_index = tables.x.index.data();
+  const uint16_t* x_weight = tables.x.fixed_weight.data();
+  const auto extrapolation = static_cast<uint8_t>(extrapolation_value);
+
+  ParallelForBlocks(tp, num_images * output_height, static_cast<size_t>(output_width) * 4,
+                    [&](int64_t first, int64_t last) {
+    // a local copy, as the uint8 stores could otherwise alias the captured width and keep the loops scalar
+    const int64_t width = output_width;
+    std::vector<uint16_t> row_buffer(2 * width);
+    int64_t cached_rows[2] = {-1, -1};
+    int64_t cached_image = -1;
+
+    for (int64_t r = first; r < last; ++r) {
+      const int64_t image = r / output_height;
+      const int64_t y = r % output_height;
+      const uint8_t* X = Xdata + image * input_height * input_width;
+      uint8_t* Y = Ydata + r * width;
+
+      if (use_extrapolation && tables.y.outside[y]) {
+        std::fill_n(Y, width, extrapolation);
+        continue;
+      }
 
-          Ydata[output_width * y + x] = static_cast<T>(dx2[x] * dy2[y] * X11 +
-                                                       dx1[x] * dy2[y] * X21 +
-                                                       dx2[x] * dy1[y] * X12 +
-                                                       dx1[x] * dy1[y] * X22);
+      if (image != cached_image) {
+        cached_rows[0] = cached_rows[1] = -1;
+        cached_image = image;
+      }
+      const uint16_t* h[2];
+      for (int tap = 0; tap < 2; ++tap) {
+        const int64_t row = y_index[2 * y + tap];
+        uint16_t* h_row = row_buffer.data() + (row & 1) * width;
+        if (cached_rows[row & 1] != row) {
+          const uint8_t* in = X + row * input_width;
+          for (int64_t x = 0; x < width; ++x) {
+            h_row[x] = static_cast<uint16_t>(x_weight[2 * x] * in[x_index[2 * x]] +
+                                             x_weight[2 * x + 1] * in[x_index[2 * x + 1]]);
+          }
+          cached_rows[row & 1] = row;
+        }
+        h[tap] = h_row;
+      }
+
+      const uint32_t wy1 = y_weight[2 * y];
+      const uint32_t wy2 = y_weight[2 * y + 1];
+      const uint16_t* h1 = h[0];
+      const uint16_t* h2 = h[1];
+      for (int64_t x = 0; x < width; ++x) {
+        Y[x] = static_cast<uint8_t>((wy1 * h1[x] + wy2 * h2[x]) >> (2 * BilinearWeightBits));
+      }
+
+      if (use_extrapolation) {
+        for (int64_t x = 0; x < width; ++x) {
+          if (tables.x.outside[x]) {
+            Y[x] = extrapolation;
+          }
         }
       }
-      Xdata += input_height * input_width;
-      Ydata += output_width * output_height;
     }
-  }
+  });
 }
 
 // Calculates cubic coeff based on Robert Keys approach
@@ -403,182 +394,237 @@ std::array<float, CubicModeGridLength> GetCubicCoeffs(float s, float cubic_coeff
   return coeffs;
 }
 
-// Get the tensor data at the requested coordinate
-template <typename T>
-T GetDataForCoordinate(const T* Xdata,
-                       int64_t x, int64_t y,
-                       int64_t input_height, int64_t input_width) {
-  x = std::max(static_cast<int64_t>(0), std::min(x, input_width - 1));
-  y = std::max(static_cast<int64_t>(0), std::min(y, input_height - 1));
-  return Xdata[y * input_width + x];
-}
-
-// Computes cubic convolution interpolation in 1D
+// Computes the bicubic interpolation of the output rows of all the images in parallel. The input rows are first
+// interpolated along the width, keeping the four rows read by an output row while consecutive output rows read
+// them, and the output row is then interpolated along the height from them.
 template <typename T>
-float CubicInterpolation1D(const T* Xdata,
-                           int64_t x,
-                           int64_t y,
-                           int64_t input_height,
-                           int64_t input_width,
-                           std::array<float, CubicModeGridLength>& coeff_array,
-                           float coeff_sum,
-                           std::unordered_map<int64_t, float>& cache) {
-  // When calculating cubic interpolation we move the 4*4 grid across the original data and therefore there is
-  // opportunity to cache the results for previously seen combinations.
-  // Check if the result is already available in the cache
-  auto grid_start_pos = (y)*input_width + (x - 1);
-  if (cache.find(grid_start_pos) != cache.end()) {
-    return cache[grid_start_pos];
-  }
-
-  // get the neighbors in 1D and find interpolation for this dimension
-  // for 1D cubic interpolation 4 samples are used. 2 on the left and 2 on the right of x
-  float result = 0;
-  for (int i = 0, j = -1; i < static_cast<int>(CubicModeGridLength); i++, j++) {
-    auto orig_data = GetDataForCoordinate(Xdata, x + j, y, input_height, input_width);
-    result += coeff_array[i] / coeff_sum * orig_data;
-  }
-  cache[grid_start_pos] = result;
-
-  return result;
-}
-
-template <typename T>
-void ResizeBiCubic(
-    int64_t batch_size,
-    int64_t num_channels,
-    int64_t input_height,
-    int64_t input_width,
-    int64_t output_height,
-    int64_t output_width,
-    float height_scale,
-    float width_scale,
-    float cubic_coeff_a,
-    bool use_extrapolation,
-    float extrapolation_value,
-    bool exclude_outside,
-    const std::vector<float>& roi,
-    const T* Xdata,
-    T* Ydata,
-    GetOriginalCoordinateFunc get_original_coordinate) {
-  std::vector<float> y_original;
-  std::vector<float> x_original;
-  std::unordered_map<float, std::array<float, CubicModeGridLength>> cubic_coeffs;
-  std::unordered_map<float, std::unordered_map<int64_t, float>> coeff_to_1Dinterpolation_map;
-  auto roi_y_start = roi.size() / 2 - 2;
-  auto roi_y_end = roi.size() - 2;
-  auto roi_x_start = roi.size() / 2 - 1;
-  auto roi_x_end = roi.size() - 1;
-
-  // generate coefficients in y direction
-  for (int64_t y = 0; y < output_height; ++y) {
-    float in_y = get_original_coordinate(static_cast<float>(y), height_scale,
-                                         static_cast<float>(output_height), static_cast<float>(input_height),
-                                         roi[roi_y_start], roi[roi_y_end]);
-    y_original.emplace_back(in_y);
-    auto s = y_original[y] - std::floor(y_original[y]);
-    if (cubic_coeffs.find(s) == cubic_coeffs.end()) {
-      cubic_coeffs[s] = GetCubicCoeffs(s, cubic_coeff_a);
-      coeff_to_1Dinterpolation_map[s] = {};
-    }
-  }
-
-  // generate coefficients in x direction
-  for (int64_t x = 0; x < output_width; ++x) {
-    float in_x = get_original_coordinate(static_cast<float>(x), width_scale,
-                                         static_cast<float>(output_width), static_cast<float>(input_width),
-                                         roi[roi_x_start], roi[roi_x_end]);
-    x_original.emplace_back(in_x);
-    auto s = x_original[x] - std::floor(x_original[x]);
-    if (cubic_coeffs.find(s) == cubic_coeffs.end()) {
-      cubic_coeffs[s] = GetCubicCoeffs(s, cubic_coeff_a);
-      coeff_to_1Dinterpolation_map[s] = {};
-    }
-  }
-
-  // setup up temp arrays to hold coefficients when exclude_outside is set to true
-  std::array<float, CubicModeGridLength> y_coeff_holder;
-  std::array<float, CubicModeGridLength> x_coeff_holder;
-  float y_coeff_sum = 1;
-  float x_coeff_sum = 1;
+void ResizeBiCubic(int64_t num_images,
+                   int64_t input_height,
+                   int64_t input_width,
+                   int64_t output_height,
+                   int64_t output_width,
+                   bool use_extrapolation,
+                   float extrapolation_value,
+                   const UpsampleTables& tables,
+                   const T* Xdata,
+                   T* Ydata,
+                   concurrency::ThreadPool* tp) {
+  constexpr int64_t taps = CubicModeGridLength;
+  const int64_t* y_index = tables.y.index.data();
+  const float* y_weight = tables.y.weight.data();
+  const int64_t* x_index = tables.x.index.data();
+  const float* x_weight = tables.x.weight.data();
+  const T extrapolation = static_cast<T>(extrapolation_value);
+
+  ParallelForBlocks(tp, num_images * output_height, static_cast<size_t>(output_width) * 16 * sizeof(T),
+                    [&](int64_t first, int64_t last) {
+    std::vector<float> row_buffer(taps * output_width);
+    std::vector<float> result(output_width);
+    int64_t cached_rows[taps] = {-1, -1, -1, -1};
+    int64_t cached_image = -1;
+
+    for (int64_t r = first; r < last; ++r) {
+      const int64_t image = r / output_height;
+      const int64_t y = r % output_height;
+      const T* X = Xdata + image * input_height * input_width;
+      T* Y = Ydata + r * output_width;
+
+      // when use_extrapolation is set and original index is out of the dim range
+      // then use extrapolation_value as the output value.
+      if (use_extrapolation && tables.y.outside[y]) {
+        std::fill_n(Y, output_width, extrapolation);
+        continue;
+      }
 
-  for (int64_t n = 0; n < batch_size; n++) {
-    for (int64_t c = 0; c < num_channels; c++) {
-      for (int64_t y = 0; y < output_height; ++y) {
-        auto in_y = y_original[y];
+      if (image != cached_image) {
+        std::fill_n(cached_rows, taps, -1);
+        cached_image = image;
+      }
 
-        // when use_extrapolation is set and original index is out of the dim range
-        // then use extrapolation_value as the output value.
-        if (use_extrapolation && (in_y < 0 || in_y > static_cast<float>(input_height - 1))) {
+      // the rows of the taps are consecutive up to clamping, so they never share a slot
+      const float* h[taps];
+      for (int64_t i = 0; i < taps; ++i) {
+        const int64_t row = y_index[taps * y + i];
+        const int64_t slot = row % taps;
+        float* h_row = row_buffer.data() + slot * output_width;
+        if (cached_rows[slot] != row) {
+          const T* in = X + row * input_width;
           for (int64_t x = 0; x < output_width; ++x) {
-            Ydata[y * output_width + x] = extrapolation_value;
+            float result = 0;
+            for (int64_t k = 0; k < taps; ++k) {
+              result += x_weight[taps * x + k] * in[x_index[taps * x + k]];
+            }
+            h_row[x] = result;
           }
-          continue;
+          cached_rows[slot] = row;
         }
+        h[i] = h_row;
+      }
 
-        auto y_int = static_cast<int64_t>(std::floor(in_y));
-        auto& coeff_y = exclude_outside ? y_coeff_holder : cubic_coeffs[in_y - y_int];
-        y_coeff_sum = 1;
-
-        if (exclude_outside) {
-          // When true, the weight of sampling locations outside the grid will be set to 0
-          // and the weight will be renormalized so that their sum is 1.0
-          y_coeff_sum = 0;
-          auto& orig_y_coeffs = cubic_coeffs[in_y - y_int];
-          for (int64_t i = 0, y_val = y_int - 1; y_val <= y_int + 2; y_val++, i++) {
-            y_coeff_holder[i] = (y_val < 0 || y_val >= static_cast<float>(input_height)) ? 0.0f : orig_y_coeffs[i];
-            y_coeff_sum += y_coeff_holder[i];
-          }
+      // accumulate one tap over the whole row at a time, which keeps the order of the sum of each pixel and lets
+      // the loops vectorize
+      const float y_coeff_sum = tables.y.weight_sum[y];
+      std::fill(result.begin(), result.end(), 0.0f);
+      for (int64_t i = 0; i < taps; ++i) {
+        const float* h_row = h[i];
+        const float weight = y_weight[taps * y + i];
+        for (int64_t x = 0; x < output_width; ++x) {
+          result[x] += h_row[x] * weight / y_coeff_sum;
         }
+      }
+      for (int64_t x = 0; x < output_width; ++x) {
+        Y[x] = static_cast<T>(result[x]);
+      }
 
+      if (use_extrapolation) {
         for (int64_t x = 0; x < output_width; ++x) {
-          auto in_x = x_original[x];
-
-          // when use_extrapolation is set and original index is out of the dim range
-          // then use extrapolation_value as the output value.
-          if (use_extrapolation && (in_x < 0 || in_x > static_cast<float>(input_width - 1))) {
-            Ydata[y * output_width + x] = extrapolation_value;
-            continue;
+          if (tables.x.outside[x]) {
+            Y[x] = extrapolation;
           }
+        }
+      }
+    }
+  });
+}
 
-          auto x_int = static_cast<int64_t>(std::floor(in_x));
-          auto s_x = static_cast<float>(in_x - x_int);
-          auto& coeff_x = exclude_outside ? x_coeff_holder : cubic_coeffs[s_x];
-          x_coeff_sum = 1;
-
-          if (exclude_outside) {
-            // When true, the weight of sampling locations outside the grid will be set to 0
-            // and the weight will be renormalized so that their sum is 1.0
-            x_coeff_sum = 0;
-            auto& orig_x_coeff = cubic_coeffs[s_x];
-            for (int64_t i = 0, x_val = x_int - 1; x_val <= x_int + 2; x_val++, i++) {
-              x_coeff_holder[i] = (x_val < 0 || x_val >= static_cast<float>(input_width)) ? 0.0f : orig_x_coeff[i];
-              x_coeff_sum += x_coeff_holder[i];
-            }
-          }
+// Fills the taps of one axis in LINEAR mode: the two input indices around the original coordinate of each output
+// index, each weighted by its distance to the other one. The weights are also kept in fixed point for uint8 inputs,
+// which use them when none of them is rounded.
+static void ComputeLinearAxis(UpsampleTables::Axis& axis, int64_t input_length, int64_t output_length, float scale,
+                              float roi_start, float roi_end, const GetOriginalCoordinateFunc& get_original_coordinate) {
+  axis.index.resize(2 * output_length);
+  axis.weight.resize(2 * output_length);
+  axis.fixed_weight.resize(2 * output_length);
+  axis.outside.resize(output_length);
+  axis.exact_fixed_weight = true;
+  for (int64_t i = 0; i < output_length; ++i) {
+    float original = get_original_coordinate(static_cast<float>(i), scale, static_cast<float>(output_length),
+                                             static_cast<float>(input_length), roi_start, roi_end);
+    axis.outside[i] = original < 0 || original > static_cast<float>(input_length - 1);
+    original = std::max(0.0f, std::min(original, static_cast<float>(input_length - 1)));
+
+    const int64_t in1 = std::min(static_cast<int64_t>(original), input_length - 1);
+    const int64_t in2 = std::min(in1 + 1, input_length - 1);
+    float d1 = std::fabs(original - in1);
+    float d2 = std::fabs(original - in2);
+    if (in1 == in2) {
+      d1 = 0.5f;
+      d2 = 0.5f;
+    }
 
-          // Compute cubic interpolation in x dimension using the x coefficients.
-          // From the result of cubic interpolation in x dim, compute cubic interpolation in y dimension
-          auto& interpolation_result_cache = coeff_to_1Dinterpolation_map[s_x];
-          float result = 0;
-          for (int64_t y_val = y_int - 1, i = 0; y_val <= y_int + 2; y_val++, i++) {
-            auto x_interpolation_result = CubicInterpolation1D(Xdata, x_int, y_val,
-                                                               input_height, input_width, coeff_x, x_coeff_sum,
-                                                               interpolation_result_cache);
-            result += x_interpolation_result * coeff_y[i] / y_coeff_sum;
-          }
+    axis.index[2 * i] = in1;
+    axis.index[2 * i + 1] = in2;
+    axis.weight[2 * i] = d2;
+    axis.weight[2 * i + 1] = d1;
+    const float fixed_d1 = d1 * (1 << BilinearWeightBits);
+    const float fixed_d2 = d2 * (1 << BilinearWeightBits);
+    axis.fixed_weight[2 * i] = static_cast<uint16_t>(fixed_d2);
+    axis.fixed_weight[2 * i + 1] = static_cast<uint16_t>(fixed_d1);
+    axis.exact_fixed_weight = axis.exact_fixed_weight && fixed_d1 == std::floor(fixed_d1) &&
+                              fixed_d2 == std::floor(fixed_d2);
+  }
+}
 
-          Ydata[y * output_width + x] = static_cast<T>(result);
+// Fills the taps of one axis in CUBIC mode: the four input indices around the original coordinate of each output
+// index, clamped to the input, with their cubic coefficients. When 'normalize' is set the coefficients are divided
+// by their sum, otherwise the sum is kept in weight_sum.
+static void ComputeCubicAxis(UpsampleTables::Axis& axis, int64_t input_length, int64_t output_length, float scale,
+                             float roi_start, float roi_end, float cubic_coeff_a, bool exclude_outside, bool normalize,
+                             const GetOriginalCoordinateFunc& get_original_coordinate) {
+  constexpr int64_t taps = CubicModeGridLength;
+  axis.index.resize(taps * output_length);
+  axis.weight.resize(taps * output_length);
+  axis.weight_sum.resize(output_length);
+  axis.outside.resize(output_length);
+  for (int64_t i = 0; i < output_length; ++i) {
+    const float original = get_original_coordinate(static_cast<float>(i), scale, static_cast<float>(output_length),
+                                                   static_cast<float>(input_length), roi_start, roi_end);
+    axis.outside[i] = original < 0 || original > static_cast<float>(input_length - 1);
+
+    const auto base = static_cast<int64_t>(std::floor(original));
+    auto coeffs = GetCubicCoeffs(original - base, cubic_coeff_a);
+    float coeff_sum = 1;
+
+    if (exclude_outside) {
+      // When true, the weight of sampling locations outside the grid will be set to 0
+      // and the weight will be renormalized so that their sum is 1.0
+      coeff_sum = 0;
+      for (int64_t k = 0; k < taps; ++k) {
+        const int64_t in = base - 1 + k;
+        if (in < 0 || in >= input_length) {
+          coeffs[k] = 0.0f;
         }
+        coeff_sum += coeffs[k];
       }
+    }
+
+    for (int64_t k = 0; k < taps; ++k) {
+      axis.index[taps * i + k] = std::max<int64_t>(0, std::min(base - 1 + k, input_length - 1));
+      axis.weight[taps * i + k] = normalize ? coeffs[k] / coeff_sum : coeffs[k];
+    }
+    axis.weight_sum[i] = coeff_sum;
+  }
+}
+
+template <typename T>
+std::shared_ptr<const UpsampleTables> Upsample<T>::GetTables(const std::vector<int64_t>& input_dims,
+                                                             const std::vector<int64_t>& output_dims,
+                                                             const std::vector<float>& scales,
+                                                             const std::vector<float>& roi) const {
+  std::lock_guard<OrtMutex> lock(tables_mutex_);
+  if (tables_ && tables_->Matches(input_dims, output_dims, scales, roi)) {
+    return tables_;
+  }
 
-      Xdata += input_height * input_width;
-      Ydata += output_height * output_width;
+  auto tables = std::make_shared<UpsampleTables>();
+  tables->input_dims = input_dims;
+  tables->output_dims = output_dims;
+  tables->scales = scales;
+  tables->roi = roi;
 
-      // clear the cache when moving to the next channel
-      coeff_to_1Dinterpolation_map.clear();
+  const auto n_dim = static_cast<int64_t>(input_dims.size());
+  if (mode_ == UpsampleMode::NN) {
+    tables->nearest_offsets.resize(n_dim);
+    int64_t input_dim_factor = 1;
+    for (int64_t dim_idx = n_dim - 1; dim_idx >= 0; dim_idx--) {
+      auto& offsets = tables->nearest_offsets[dim_idx];
+      offsets.resize(output_dims[dim_idx]);
+      for (int64_t i = 0; i < output_dims[dim_idx]; i++) {
+        const float original = get_original_coordinate_(static_cast<float>(i), scales[dim_idx],
+                                                        static_cast<float>(output_dims[dim_idx]),
+                                                        static_cast<float>(input_dims[dim_idx]),
+                                                        roi[dim_idx], roi[n_dim + dim_idx]);
+        if (use_extrapolation_ && (original < 0 || original > input_dims[dim_idx] - 1)) {
+          offsets[i] = -1;
+          continue;
+        }
+        int64_t input_idx = get_nearest_pixel_(original, scales[dim_idx] < 1);
+        input_idx = std::max<int64_t>(0, std::min(input_idx, input_dims[dim_idx] - 1));
+        offsets[i] = input_idx * input_dim_factor;
+      }
+      input_dim_factor *= input_dims[dim_idx];
+    }
+  } else if (n_dim >= 2) {
+    // the height and the width are the two innermost axes
+    const int64_t y_dim = n_dim - 2;
+    const int64_t x_dim = n_dim - 1;
+    if (mode_ == UpsampleMode::LINEAR) {
+      tables->taps = 2;
+      ComputeLinearAxis(tables->y, input_dims[y_dim], output_dims[y_dim], scales[y_dim], roi[y_dim],
+                        roi[n_dim + y_dim], get_original_coordinate_);
+      ComputeLinearAxis(tables->x, input_dims[x_dim], output_dims[x_dim], scales[x_dim], roi[x_dim],
+                        roi[n_dim + x_dim], get_original_coordinate_);
+    } else if (mode_ == UpsampleMode::CUBIC) {
+      tables->taps = CubicModeGridLength;
+      ComputeCubicAxis(tables->y, input_dims[y_dim], output_dims[y_dim], scales[y_dim], roi[y_dim],
+                       roi[n_dim + y_dim], cubic_coeff_a_, exclude_outside_, false, get_original_coordinate_);
+      ComputeCubicAxis(tables->x, input_dims[x_dim], output_dims[x_dim], scales[x_dim], roi[x_dim],
+                       roi[n_dim + x_dim], cubic_coeff_a_, exclude_outside_, true, get_original_coordinate_);
     }
   }
+
+  tables_ = std::move(tables);
+  return tables_;
 }
 
 template <typename T>
@@ -592,7 +638,7 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
   ORT_ENFORCE(output_dims.size() == dims.size(), "Rank of input and output tensor should be same.");
 
   Tensor* Y = context->Output(0, output_dims);
-    
+
   if (dims.size() != scales.size())
     return Status(ONNXRUNTIME, INVALID_ARGUMENT,
                   is_resize_ ? "Resize: input tensor's dimension does not match the scales."
@@ -612,11 +658,13 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
     return Status::OK();
   }
 
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
+
   switch (mode_) {
     case UpsampleMode::NN:
-      return UpsampleNearest<T>(X->template Data<T>(), Y->template MutableData<T>(), X->Shape(), Y->Shape(), scales, roi,
-                                is_resize_, use_extrapolation_, extrapolation_value_, use_nearest2x_optimization_,
-                                get_original_coordinate_, get_nearest_pixel_);
+      return UpsampleNearest<T>(X->template Data<T>(), Y->template MutableData<T>(), X->Shape(), Y->Shape(), scales,
+                                is_resize_, extrapolation_value_, use_nearest2x_optimization_,
+                                *GetTables(dims, output_dims, scales, roi), tp);
     case UpsampleMode::LINEAR: {
       //The correct behavior of 'linear' mode for an N-D input is not clear right now,
       //so only support 'bilinear' with 2-D or 4-D input tensor with outermost 2 scales as 1 in the 4-D case
@@ -636,12 +684,18 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
       const int64_t output_height = is_2D ? output_dims[0] : output_dims[2];
       const int64_t output_width = is_2D ? output_dims[1] : output_dims[3];
 
-      AllocatorPtr alloc;
-      ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
-      UpsampleBilinear(batch_size, num_channels, input_height, input_width, output_height, output_width,
-                       is_2D ? scales[0] : scales[2], is_2D ? scales[1] : scales[3], roi,
-                       use_extrapolation_, extrapolation_value_, X->template Data<T>(),
-                       Y->template MutableData<T>(), alloc, get_original_coordinate_);
+      const auto tables = GetTables(dims, output_dims, scales, roi);
+      if (std::is_same<T, uint8_t>::value && tables->x.exact_fixed_weight && tables->y.exact_fixed_weight) {
+        UpsampleBilinearFixedPoint(batch_size * num_channels, input_height, input_width, output_height, output_width,
+                                   use_extrapolation_, extrapolation_value_, *tables,
+                                   static_cast<const uint8_t*>(X->DataRaw()), static_cast<uint8_t*>(Y->MutableDataRaw()),
+                                   tp);
+        return Status::OK();
+      }
+
+      UpsampleBilinear(batch_size * num_channels, input_height, input_width, output_height, output_width,
+                       use_extrapolation_, extrapolation_value_, *tables,
+                       X->template Data<T>(), Y->template MutableData<T>(), tp);
       return Status::OK();
     }
     case UpsampleMode::CUBIC: {
@@ -653,10 +707,9 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
       const int64_t output_height = is_2D ? output_dims[0] : output_dims[2];
       const int64_t output_width = is_2D ? output_dims[1] : output_dims[3];
 
-      ResizeBiCubic(batch_size, num_channels, input_height, input_width, output_height, output_width,
-                    is_2D ? scales[0] : scales[2], is_2D ? scales[1] : scales[3], cubic_coeff_a_, use_extrapolation_,
-                    extrapolation_value_, exclude_outside_, roi, X->template Data<float>(), Y->template MutableData<float>(),
-                    get_original_coordinate_);
+      ResizeBiCubic(batch_size * num_channels, input_height, input_width, output_height, output_width,
+                    use_extrapolation_, extrapolation_value_, *GetTables(dims, output_dims, scales, roi),
+                    X->template Data<T>(), Y->template MutableData<T>(), tp);
       return Status::OK();
     }
     default:
@@ -4,7 +4,9 @@
 #pragma once
 
 #include "core/framework/op_kernel.h"
+#include "core/platform/ort_mutex.h"
 #include <cmath>
+#include <memory>
 
 namespace onnxruntime {
 
@@ -319,6 +321,42 @@ class UpsampleBase {
   }
 };  // UpsampleBase 
 
+// Number of fractional bits of the fixed point weights of the uint8 bilinear kernel
+const int BilinearWeightBits = 8;
+
+// Interpolation tables of a resize. They only depend on the shapes, the scales and the roi of a run, so they are
+// computed once and reused by the following runs for as long as those stay the same.
+struct UpsampleTables {
+  std::vector<int64_t> input_dims;
+  std::vector<int64_t> output_dims;
+  std::vector<float> scales;
+  std::vector<float> roi;
+
+  // NN mode: for each axis, the offset in the input of each output index, or -1 when the output index takes the
+  // extrapolation value.
+  std::vector<std::vector<int64_t>> nearest_offsets;
+
+  // LINEAR and CUBIC modes: the taps of the height (y) and the width (x) axis. Each output index reads 'taps'
+  // consecutive entries of index and weight.
+  struct Axis {
+    std::vector<int64_t> index;          // input index of each tap, clamped to the input
+    std::vector<float> weight;           // weight of each tap
+    std::vector<uint16_t> fixed_weight;  // LINEAR: weight of each tap in fixed point, see BilinearWeightBits
+    std::vector<float> weight_sum;       // CUBIC: the sum the weights are divided by
+    std::vector<uint8_t> outside;        // whether the output index takes the extrapolation value
+    bool exact_fixed_weight = false;     // LINEAR: whether fixed_weight holds all the weights without rounding
+  };
+  int64_t taps = 0;
+  Axis y;
+  Axis x;
+
+  bool Matches(const std::vector<int64_t>& other_input_dims, const std::vector<int64_t>& other_output_dims,
+               const std::vector<float>& other_scales, const std::vector<float>& other_roi) const {
+    return input_dims == other_input_dims && output_dims == other_output_dims && scales == other_scales &&
+           roi == other_roi;
+  }
+};
+
 template <typename T>
 class Upsample : public UpsampleBase, public OpKernel {
  public:
@@ -329,6 +367,16 @@ class Upsample : public UpsampleBase, public OpKernel {
 
   Status BaseCompute(OpKernelContext* context, const std::vector<float>& roi, const std::vector<float>& scales,
                      const std::vector<int64_t>& output_dims) const;
+
+ private:
+  // Returns the interpolation tables of a run, reusing the tables of the previous run when they match.
+  std::shared_ptr<const UpsampleTables> GetTables(const std::vector<int64_t>& input_dims,
+                                                  const std::vector<int64_t>& output_dims,
+                                                  const std::vector<float>& scales,
+                                                  const std::vector<float>& roi) const;
+
+  mutable OrtMutex tables_mutex_;
+  mutable std::shared_ptr<const UpsampleTables> tables_;
 };
 
 }  // namespace onnxruntime
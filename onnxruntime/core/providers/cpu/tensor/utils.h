@@ -280,6 +280,81 @@ inline void CopyCpuTensor(const Tensor* src, Tensor* tgt) {
   }
 }
 
+namespace detail {
+template <typename T>
+inline void CopyStridedRow(const char* source, int64_t stride, int64_t count, char* target) {
+  const T* input = reinterpret_cast<const T*>(source);
+  T* output = reinterpret_cast<T*>(target);
+  for (int64_t i = 0; i < count; ++i) {
+    output[i] = input[i * stride];
+  }
+}
+}  // namespace detail
+
+// Copies a tensor that may be a strided view (see Tensor::SetStridedView) to the dense row-major buffer 'target'.
+inline void CopyStridedCpuTensor(const Tensor& src, void* target) {
+  const int64_t count = src.Shape().Size();
+  if (count == 0)
+    return;
+
+  const auto& dims = src.Shape().GetDims();
+  const auto strides = src.Strides();
+  const size_t rank = dims.size();
+  const size_t element_size = src.DataType()->Size();
+  const bool is_string_type = src.IsDataTypeString();
+  const char* source = static_cast<const char*>(src.DataRaw()) + src.ByteOffset();
+  char* output = static_cast<char*>(target);
+
+  // copy a row of the innermost axis at a time, walking the outer axes with a counter per axis
+  const int64_t inner_count = rank == 0 ? 1 : dims[rank - 1];
+  const int64_t inner_stride = rank == 0 ? 1 : strides[rank - 1];
+  std::vector<int64_t> counters(rank == 0 ? 0 : rank - 1, 0);
+  int64_t offset = 0;
+
+  for (int64_t copied = 0; copied < count; copied += inner_count) {
+    const char* row = source + offset * static_cast<int64_t>(element_size);
+    if (is_string_type) {
+      detail::CopyStridedRow<std::string>(row, inner_stride, inner_count, output);
+    } else if (inner_stride == 1) {
+      memcpy(output, row, static_cast<size_t>(inner_count) * element_size);
+    } else if (element_size == sizeof(uint8_t)) {
+      detail::CopyStridedRow<uint8_t>(row, inner_stride, inner_count, output);
+    } else if (element_size == sizeof(uint16_t)) {
+      detail::CopyStridedRow<uint16_t>(row, inner_stride, inner_count, output);
+    } else if (element_size == sizeof(uint32_t)) {
+      detail::CopyStridedRow<uint32_t>(row, inner_stride, inner_count, output);
+    } else if (element_size == sizeof(uint64_t)) {
+      detail::CopyStridedRow<uint64_t>(row, inner_stride, inner_count, output);
+    } else {
+      for (int64_t i = 0; i < inner_count; ++i) {
+        memcpy(output + i * element_size, row + i * inner_stride * static_cast<int64_t>(element_size), element_size);
+      }
+    }
+    output += static_cast<size_t>(inner_count) * element_size;
+
+    for (size_t axis = counters.size(); axis-- > 0;) {
+      offset += strides[axis];
+      if (++counters[axis] < dims[axis])
+        break;
+      offset -= strides[axis] * dims[axis];
+      counters[axis] = 0;
+    }
+  }
+}
+
+// Returns the tensor if it is contiguous. Otherwise copies the strided view to a dense tensor allocated from
+// 'allocator', which 'contiguous' owns, and returns that. Used by kernels that declare
+// KernelDefBuilder::MayStridedInput but only handle some views directly.
+inline const Tensor& MakeContiguousCpuTensor(const Tensor& tensor, const AllocatorPtr& allocator,
+                                             std::unique_ptr<Tensor>& contiguous) {
+  if (tensor.IsContiguous())
+    return tensor;
+
+  contiguous = onnxruntime::make_unique<Tensor>(tensor.DataType(), tensor.Shape(), allocator);
+  CopyStridedCpuTensor(tensor, contiguous->MutableDataRaw());
+  return *contiguous;
+}
+
 // This provides easy sequential iteration over a subset of a tensor given a span of starts, extents & optionally steps
 template <typename T>
 struct WritableSliceIterator {
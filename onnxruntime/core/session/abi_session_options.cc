@@ -70,6 +70,40 @@ ORT_API_STATUS_IMPL(OrtApis::DisableProfiling, _In_ OrtSessionOptions* options)
   return nullptr;
 }
 
+// enable aggregated per node execution statistics for this session.
+ORT_API_STATUS_IMPL(OrtApis::EnableOpStatistics, _In_ OrtSessionOptions* options, int trace_sample_rate) {
+  if (trace_sample_rate < 0)
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "trace_sample_rate must be non-negative");
+  options->value.enable_op_statistics = true;
+  options->value.op_statistics_trace_sample_rate = trace_sample_rate;
+  return nullptr;
+}
+ORT_API_STATUS_IMPL(OrtApis::DisableOpStatistics, _In_ OrtSessionOptions* options) {
+  options->value.enable_op_statistics = false;
+  options->value.op_statistics_trace_sample_rate = 0;
+  return nullptr;
+}
+
+// attribute the memory allocated during runs to nodes.
+ORT_API_STATUS_IMPL(OrtApis::EnableMemoryStatistics, _In_ OrtSessionOptions* options) {
+  options->value.enable_memory_statistics = true;
+  return nullptr;
+}
+ORT_API_STATUS_IMPL(OrtApis::DisableMemoryStatistics, _In_ OrtSessionOptions* options) {
+  options->value.enable_memory_statistics = false;
+  return nullptr;
+}
+
+// return the sequences of maps built by ZipMap as columnar map sequences.
+ORT_API_STATUS_IMPL(OrtApis::EnableColumnarZipMapOutput, _In_ OrtSessionOptions* options) {
+  options->value.use_columnar_zipmap_output = true;
+  return nullptr;
+}
+ORT_API_STATUS_IMPL(OrtApis::DisableColumnarZipMapOutput, _In_ OrtSessionOptions* options) {
+  options->value.use_columnar_zipmap_output = false;
+  return nullptr;
+}
+
 // enable the memory pattern optimization.
 // The idea is if the input shapes are the same, we could trace the internal memory allocation
 // and generate a memory pattern for future request. So next time we could just do one allocation
@@ -26,6 +26,7 @@
 #include "core/framework/graph_partitioner.h"
 #include "core/framework/kernel_def_builder.h"
 #include "core/framework/kernel_registry.h"
+#include "core/framework/memory_statistics.h"
 #include "core/framework/ort_value_pattern_planner.h"
 #include "core/framework/mldata_type_utils.h"
 #include "core/framework/ort_value_name_idx_map.h"
@@ -96,6 +97,90 @@ inline std::basic_string<T> GetCurrentTimeString() {
 
 std::atomic<uint32_t> InferenceSession::global_session_id_{1};
 
+// Replaces the ZipMap nodes whose output is only read as a graph output with ColumnarZipMap, and gives those graph
+// outputs the matching columnar map sequence type. Returns false if the graph has no such node.
+static bool ReplaceZipMapOutputs(ONNX_NAMESPACE::ModelProto& model_proto) {
+  auto& graph = *model_proto.mutable_graph();
+  std::unordered_map<std::string, ONNX_NAMESPACE::ValueInfoProto*> graph_outputs;
+  for (auto& output : *graph.mutable_output()) {
+    graph_outputs[output.name()] = &output;
+  }
+  std::unordered_set<std::string> node_inputs;
+  for (const auto& node : graph.node()) {
+    node_inputs.insert(node.input().begin(), node.input().end());
+  }
+
+  std::unordered_set<std::string> replaced;
+  for (auto& node : *graph.mutable_node()) {
+    if (node.op_type() != "ZipMap" || node.domain() != kMLDomain || node.output_size() != 1) {
+      continue;
+    }
+    const std::string& output_name = node.output(0);
+    auto output = graph_outputs.find(output_name);
+    if (output == graph_outputs.end() || node_inputs.count(output_name) != 0) {
+      continue;
+    }
+
+    bool using_strings = false;
+    for (const auto& attr : node.attribute()) {
+      if (attr.name() == "classlabels_strings" && attr.strings_size() > 0) {
+        using_strings = true;
+      }
+    }
+
+    node.set_op_type("ColumnarZipMap");
+    node.set_domain(kMSDomain);
+    auto* opaque_type = output->second->mutable_type()->mutable_opaque_type();
+    opaque_type->set_domain(kMSDomain);
+    opaque_type->set_name(using_strings ? "ColumnarMapSequenceStringToFloat" : "ColumnarMapSequenceInt64ToFloat");
+    replaced.insert(output_name);
+  }
+
+  if (replaced.empty()) {
+    return false;
+  }
+
+  // drop any stale seq(map) type recorded for the replaced outputs
+  auto* value_info = graph.mutable_value_info();
+  for (int i = value_info->size() - 1; i >= 0; --i) {
+    if (replaced.count(value_info->Get(i).name()) != 0) {
+      value_info->DeleteSubrange(i, 1);
+    }
+  }
+
+  bool has_ms_domain = false;
+  for (const auto& opset : model_proto.opset_import()) {
+    has_ms_domain = has_ms_domain || opset.domain() == kMSDomain;
+  }
+  if (!has_ms_domain) {
+    auto* opset = model_proto.add_opset_import();
+    opset->set_domain(kMSDomain);
+    opset->set_version(1);
+  }
+
+  return true;
+}
+
+// Reloads the model with ColumnarZipMap in place of the ZipMap nodes that produce graph outputs.
+// See SessionOptions::use_columnar_zipmap_output.
+static Status UseColumnarZipMapOutputs(std::shared_ptr<Model>& model,
+                                       const IOnnxRuntimeOpSchemaRegistryList* local_registries,
+                                       const logging::Logger& logger) {
+#ifdef DISABLE_CONTRIB_OPS
+  ORT_UNUSED_PARAMETER(model);
+  ORT_UNUSED_PARAMETER(local_registries);
+  ORT_UNUSED_PARAMETER(logger);
+  return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED,
+                         "use_columnar_zipmap_output requires a build with the contrib ops enabled.");
+#else
+  ONNX_NAMESPACE::ModelProto model_proto = model->ToProto();
+  if (!ReplaceZipMapOutputs(model_proto)) {
+    return Status::OK();
+  }
+  return Model::Load(model_proto, model, local_registries, logger);
+#endif
+}
+
 static Status FinalizeSessionOptions(const SessionOptions& user_provided_session_options,
                                      const ONNX_NAMESPACE::ModelProto* model_proto,
                                      /*out*/ SessionOptions& finalized_session_options) {
@@ -191,6 +276,13 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
   if (session_options_.enable_profiling) {
     StartProfiling(session_options_.profile_file_prefix);
   }
+  if (session_options_.enable_op_statistics) {
+    session_profiler_.StartOpStatistics(session_options_.op_statistics_trace_sample_rate);
+  }
+  if (session_options_.enable_memory_statistics) {
+    memory_statistics_ = std::make_shared<MemoryStatistics>();
+    session_state_->SetMemoryStatistics(memory_statistics_.get());
+  }
 
   telemetry_ = {};
   // a monotonically increasing session id for use in telemetry
@@ -364,6 +456,12 @@ common::Status InferenceSession::Load(std::function<common::Status(std::shared_p
     status = loader(p_tmp_model);
     ORT_RETURN_IF_ERROR_SESSIONID_(status);
 
+    if (session_options_.use_columnar_zipmap_output) {
+      status = UseColumnarZipMapOutputs(p_tmp_model, HasLocalSchema() ? &custom_schema_registries_ : nullptr,
+                                        *session_logger_);
+      ORT_RETURN_IF_ERROR_SESSIONID_(status);
+    }
+
     model_ = p_tmp_model;
 
     status = DoPostLoadProcessing(*model_);
@@ -670,6 +768,7 @@ common::Status InferenceSession::CreateSubgraphSessionState(Graph& graph, Sessio
                                                                            session_state.GetThreadPool(),
                                                                            session_state.GetInterOpThreadPool());
       subgraph_session_state->SetProfiler(session_profiler_);
+      subgraph_session_state->SetMemoryStatistics(memory_statistics_.get());
       subgraph_session_state->SetLogger(*session_logger_);
       // Pass data transfer manager to subgraph.
       subgraph_session_state->SetDataTransferMgr(&session_state.GetDataTransferMgr());
@@ -868,6 +967,11 @@ common::Status InferenceSession::Initialize() {
 
     // handle any subgraphs
     ORT_RETURN_IF_ERROR_SESSIONID_(InitializeSubgraphSessions(graph, *session_state_));
+
+    if (session_profiler_.GetOpStatistics() != nullptr) {
+      session_state_->RegisterOpStatistics(*session_profiler_.GetOpStatistics());
+    }
+
     is_inited_ = true;
 
     // and log telemetry
@@ -1084,6 +1188,10 @@ Status InferenceSession::Run(const RunOptions& run_options, const std::vector<st
 
     ++current_num_runs_;
 
+    if (memory_statistics_ != nullptr) {
+      memory_statistics_->StartRun();
+    }
+
     // TODO should we add this exec to the list of executors? i guess its not needed now?
 
     // scope of owned_run_logger is just the call to Execute.
@@ -1288,6 +1396,41 @@ std::string InferenceSession::EndProfiling() {
   return std::string();
 }
 
+common::Status InferenceSession::GetOpStatistics(std::string& json, bool reset) {
+  if (!is_inited_) {
+    return Status(common::ONNXRUNTIME, common::FAIL, "Session not initialized.");
+  }
+
+  profiling::OpStatistics* op_statistics = session_profiler_.GetOpStatistics();
+  if (op_statistics == nullptr) {
+    return Status(common::ONNXRUNTIME, common::FAIL,
+                  "Op statistics are not enabled. Set enable_op_statistics in the session options.");
+  }
+
+  json = op_statistics->ToJson();
+  if (reset) {
+    op_statistics->Reset();
+  }
+  return Status::OK();
+}
+
+common::Status InferenceSession::GetMemoryStatistics(std::string& json, bool reset) {
+  if (!is_inited_) {
+    return Status(common::ONNXRUNTIME, common::FAIL, "Session not initialized.");
+  }
+
+  if (memory_statistics_ == nullptr) {
+    return Status(common::ONNXRUNTIME, common::FAIL,
+                  "Memory statistics are not enabled. Set enable_memory_statistics in the session options.");
+  }
+
+  json = memory_statistics_->ToJson();
+  if (reset) {
+    memory_statistics_->Reset();
+  }
+  return Status::OK();
+}
+
 // assumes model has already been loaded before
 common::Status InferenceSession::DoPostLoadProcessing(onnxruntime::Model& model) {
   // TODO add other post load processing here
@@ -351,6 +351,25 @@ class InferenceSession {
     */
   std::string EndProfiling();
 
+  /**
+    * Get the aggregated per node and per op type statistics collected since the session was initialized
+    * or last reset. Requires SessionOptions::enable_op_statistics.
+    * @param json receives the statistics as a JSON document. See profiling::OpStatistics::ToJson.
+    * @param reset clears the statistics after they are read.
+    * @return OK if success.
+    */
+  common::Status GetOpStatistics(std::string& json, bool reset = false);
+
+  /**
+    * Get the memory allocated by each node, the live memory timeline of the last run, and the allocations
+    * live at the highest memory use since the session was initialized or last reset.
+    * Requires SessionOptions::enable_memory_statistics.
+    * @param json receives the statistics as a JSON document. See MemoryStatistics::ToJson.
+    * @param reset clears the statistics after they are read.
+    * @return OK if success.
+    */
+  common::Status GetMemoryStatistics(std::string& json, bool reset = false);
+
  protected:
   /**
     * Load an ONNX model.
@@ -457,6 +476,10 @@ class InferenceSession {
   // Profiler for this session.
   profiling::Profiler session_profiler_;
 
+  // Memory attribution for this session if enabled. Shared with the allocators it tracks, as tensors
+  // allocated by a run can outlive the session.
+  std::shared_ptr<MemoryStatistics> memory_statistics_;
+
   // The list of execution providers.
   ExecutionProviders execution_providers_;
 
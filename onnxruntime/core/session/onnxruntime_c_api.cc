@@ -15,6 +15,7 @@
 #include "core/common/status.h"
 #include "core/graph/graph.h"
 #include "core/framework/allocator.h"
+#include "core/framework/columnar_map_sequence.h"
 #include "core/framework/tensor.h"
 #include "core/framework/ml_value.h"
 #include "core/session/environment.h"
@@ -671,6 +672,32 @@ ORT_API_STATUS_IMPL(OrtApis::SessionEndProfiling, _In_ OrtSession* sess, _Inout_
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::SessionGetOpStatistics, _In_ OrtSession* sess, int reset, _Inout_ OrtAllocator* allocator,
+                    _Outptr_ char** out) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  std::string json;
+  auto status = session->GetOpStatistics(json, reset != 0);
+  if (!status.IsOK())
+    return ToOrtStatus(status);
+  *out = StrDup(json, allocator);
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SessionGetMemoryStatistics, _In_ OrtSession* sess, int reset,
+                    _Inout_ OrtAllocator* allocator, _Outptr_ char** out) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  std::string json;
+  auto status = session->GetMemoryStatistics(json, reset != 0);
+  if (!status.IsOK())
+    return ToOrtStatus(status);
+  *out = StrDup(json, allocator);
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtApis::SessionGetModelMetadata, _In_ const OrtSession* sess,
                     _Outptr_ OrtModelMetadata** out) {
   API_IMPL_BEGIN
@@ -812,6 +839,21 @@ OrtStatus* OrtGetNumSequenceElements<TensorSeq>(const OrtValue* p_ml_value, size
   return nullptr;
 }
 
+static OrtStatus* OrtGetValueCountImplColumnar(const OrtValue* value, size_t* out) {
+  auto type = value->Type();
+  if (type == DataTypeImpl::GetType<ColumnarMapSequenceStringToFloat>()) {
+    *out = value->Get<ColumnarMapSequenceStringToFloat>().Size();
+  } else if (type == DataTypeImpl::GetType<ColumnarMapSequenceInt64ToFloat>()) {
+    *out = value->Get<ColumnarMapSequenceInt64ToFloat>().Size();
+  } else if (type == DataTypeImpl::GetType<ColumnarMapRowStringToFloat>() ||
+             type == DataTypeImpl::GetType<ColumnarMapRowInt64ToFloat>()) {
+    *out = NUM_MAP_INDICES;
+  } else {
+    return OrtApis::CreateStatus(ORT_FAIL, "Input is not of one of the supported opaque types.");
+  }
+  return nullptr;
+}
+
 static OrtStatus* OrtGetValueCountImpl(const OrtValue* value, size_t* out) {
   ONNXType value_type;
   if (auto status = OrtApis::GetValueType(value, &value_type))
@@ -820,6 +862,9 @@ static OrtStatus* OrtGetValueCountImpl(const OrtValue* value, size_t* out) {
     *out = NUM_MAP_INDICES;
     return nullptr;
   }
+  if (value_type == ONNX_TYPE_OPAQUE) {
+    return OrtGetValueCountImplColumnar(value, out);
+  }
   if (value_type == ONNX_TYPE_SEQUENCE) {
     auto v = reinterpret_cast<const OrtValue*>(value);
     auto type = v->Type();
@@ -856,12 +901,9 @@ static OrtStatus* OrtGetValueImplSeqOfMap(const OrtValue* p_ml_value, int index,
   using MapType = std::map<TKey, TVal>;
   auto& data_vec = p_ml_value->Get<T>();
   auto& data_elem = data_vec.at(index);
-  auto copy_data_elem = onnxruntime::make_unique<MapType>(data_elem);
+  // the element is returned as a view that shares ownership of the sequence instead of a copy of the map
   auto value = onnxruntime::make_unique<OrtValue>();
-  auto ml_type = DataTypeImpl::GetType<MapType>();
-  value->Init(copy_data_elem.release(),
-              ml_type,
-              ml_type->GetDeleteFunc());
+  value->InitAsView(const_cast<MapType*>(&data_elem), DataTypeImpl::GetType<MapType>(), *p_ml_value);
   *out = value.release();
   return nullptr;
 }
@@ -1012,6 +1054,56 @@ static OrtStatus* OrtGetValueImplMap(const OrtValue* value, int index, OrtAlloca
   return OrtApis::CreateStatus(ORT_FAIL, "Input is not of one of the supported map types.");
 }
 
+// Returns a lazy view of one map of a columnar map sequence. The view shares ownership of the sequence.
+template <typename TKey>
+static OrtStatus* OrtGetValueImplColumnarRow(const OrtValue* p_ml_value, int index, OrtValue** out) {
+  const auto& seq = p_ml_value->Get<ColumnarMapSequence<TKey>>();
+  if (index < 0 || static_cast<size_t>(index) >= seq.Size()) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "Index is out of range of the sequence.");
+  }
+  auto row = onnxruntime::make_unique<ColumnarMapRow<TKey>>(*p_ml_value, static_cast<size_t>(index));
+  const auto* row_type = DataTypeImpl::GetType<ColumnarMapRow<TKey>>();
+  auto value = onnxruntime::make_unique<OrtValue>();
+  value->Init(row.release(), row_type, row_type->GetDeleteFunc());
+  *out = value.release();
+  return nullptr;
+}
+
+// Returns the keys (index 0) or the values (index 1) of a map view as tensors that share ownership of the view.
+template <typename TKey>
+static OrtStatus* OrtGetValueImplColumnarMap(const OrtValue* p_ml_value, int index, OrtValue** out) {
+  const auto& row = p_ml_value->Get<ColumnarMapRow<TKey>>();
+  const Tensor* tensor;
+  switch (index) {
+    case 0:
+      tensor = &row.Keys();
+      break;
+    case 1:
+      tensor = &row.Values();
+      break;
+    default:
+      return OrtApis::CreateStatus(ORT_FAIL, "Invalid index requested for map type.");
+  }
+  auto value = onnxruntime::make_unique<OrtValue>();
+  value->InitAsView(const_cast<Tensor*>(tensor), DataTypeImpl::GetType<Tensor>(), *p_ml_value);
+  *out = value.release();
+  return nullptr;
+}
+
+static OrtStatus* OrtGetValueImplColumnar(const OrtValue* value, int index, OrtValue** out) {
+  auto type = value->Type();
+  if (type == DataTypeImpl::GetType<ColumnarMapSequenceStringToFloat>()) {
+    return OrtGetValueImplColumnarRow<std::string>(value, index, out);
+  } else if (type == DataTypeImpl::GetType<ColumnarMapSequenceInt64ToFloat>()) {
+    return OrtGetValueImplColumnarRow<int64_t>(value, index, out);
+  } else if (type == DataTypeImpl::GetType<ColumnarMapRowStringToFloat>()) {
+    return OrtGetValueImplColumnarMap<std::string>(value, index, out);
+  } else if (type == DataTypeImpl::GetType<ColumnarMapRowInt64ToFloat>()) {
+    return OrtGetValueImplColumnarMap<int64_t>(value, index, out);
+  }
+  return OrtApis::CreateStatus(ORT_FAIL, "Input is not of one of the supported opaque types.");
+}
+
 static OrtStatus* OrtGetValueImpl(const OrtValue* value, int index, OrtAllocator* allocator,
                                   OrtValue** out) {
   ONNXType value_type;
@@ -1020,6 +1112,9 @@ static OrtStatus* OrtGetValueImpl(const OrtValue* value, int index, OrtAllocator
   if (value_type == ONNX_TYPE_MAP) {
     return OrtGetValueImplMap(value, index, allocator, out);
   }
+  if (value_type == ONNX_TYPE_OPAQUE) {
+    return OrtGetValueImplColumnar(value, index, out);
+  }
   if (value_type == ONNX_TYPE_SEQUENCE) {
     return OrtGetValueImplSeq(value, index, allocator, out);
   } else {
@@ -1500,6 +1595,14 @@ static constexpr OrtApi ort_api_1_to_2 = {
     &OrtApis::ModelMetadataLookupCustomMetadataMap,
     &OrtApis::ModelMetadataGetVersion,
     &OrtApis::ReleaseModelMetadata,
+    &OrtApis::EnableOpStatistics,
+    &OrtApis::DisableOpStatistics,
+    &OrtApis::SessionGetOpStatistics,
+    &OrtApis::EnableMemoryStatistics,
+    &OrtApis::DisableMemoryStatistics,
+    &OrtApis::SessionGetMemoryStatistics,
+    &OrtApis::EnableColumnarZipMapOutput,
+    &OrtApis::DisableColumnarZipMapOutput,
 };
 
 // Assert to do a limited check to ensure Version 1 of OrtApi never changes (will detect an addition or deletion but not if they cancel out each other)
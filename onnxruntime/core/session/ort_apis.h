@@ -47,6 +47,12 @@ ORT_API_STATUS_IMPL(SetSessionExecutionMode, _In_ OrtSessionOptions* options, Ex
 ORT_API_STATUS_IMPL(SetOptimizedModelFilePath, _In_ OrtSessionOptions* options, _In_ const ORTCHAR_T* optimized_model_filepath);
 ORT_API_STATUS_IMPL(EnableProfiling, _In_ OrtSessionOptions* options, _In_ const ORTCHAR_T* profile_file_prefix);
 ORT_API_STATUS_IMPL(DisableProfiling, _In_ OrtSessionOptions* options);
+ORT_API_STATUS_IMPL(EnableOpStatistics, _In_ OrtSessionOptions* options, int trace_sample_rate);
+ORT_API_STATUS_IMPL(DisableOpStatistics, _In_ OrtSessionOptions* options);
+ORT_API_STATUS_IMPL(EnableMemoryStatistics, _In_ OrtSessionOptions* options);
+ORT_API_STATUS_IMPL(DisableMemoryStatistics, _In_ OrtSessionOptions* options);
+ORT_API_STATUS_IMPL(EnableColumnarZipMapOutput, _In_ OrtSessionOptions* options);
+ORT_API_STATUS_IMPL(DisableColumnarZipMapOutput, _In_ OrtSessionOptions* options);
 ORT_API_STATUS_IMPL(EnableMemPattern, _In_ OrtSessionOptions* options);
 ORT_API_STATUS_IMPL(DisableMemPattern, _In_ OrtSessionOptions* options);
 ORT_API_STATUS_IMPL(EnableCpuMemArena, _In_ OrtSessionOptions* options);
@@ -76,6 +82,10 @@ ORT_API_STATUS_IMPL(SessionGetOverridableInitializerName, _In_ const OrtSession*
                     _Inout_ OrtAllocator* allocator, _Outptr_ char** value);
 ORT_API_STATUS_IMPL(SessionEndProfiling, _In_ OrtSession* sess, _Inout_ OrtAllocator* allocator,
                     _Outptr_ char** out);
+ORT_API_STATUS_IMPL(SessionGetOpStatistics, _In_ OrtSession* sess, int reset, _Inout_ OrtAllocator* allocator,
+                    _Outptr_ char** out);
+ORT_API_STATUS_IMPL(SessionGetMemoryStatistics, _In_ OrtSession* sess, int reset, _Inout_ OrtAllocator* allocator,
+                    _Outptr_ char** out);
 ORT_API_STATUS_IMPL(SessionGetModelMetadata, _In_ const OrtSession* sess,
                     _Outptr_ OrtModelMetadata** out);
 
@@ -79,6 +79,23 @@ void MatMul(
     const T* B,
     T* C, concurrency::ThreadPool* threadpool);
 
+// Batched MatMul: for each i in [0, batch_size), computes the M x N matrix at C + C_offsets[i] from the M x K matrix
+// at A + A_offsets[i] and the K x N matrix at B + B_offsets[i]. The work of all the matrices is spread over the thread
+// pool together, so many small matrices use the threads as well as one large matrix does.
+template <typename T>
+void MatMulBatch(
+    int M,
+    int N,
+    int K,
+    size_t batch_size,
+    const T* A,
+    const size_t* A_offsets,
+    const T* B,
+    const size_t* B_offsets,
+    T* C,
+    const size_t* C_offsets,
+    concurrency::ThreadPool* threadpool);
+
 // Decaf gemm provides a simpler interface to the gemm functions, with the
 // limitation that the data has to be contiguous in memory.
 template <typename T, class Provider>
@@ -410,5 +427,13 @@ uint16_t floatToHalf(float f);
 
 float halfToFloat(uint16_t h);
 
+// Converts count values between a half precision storage type (MLFloat16 or BFloat16) and float, rounding to
+// nearest even. The kernels that store half precision tensors use these to compute in float.
+template <typename T>
+void ConvertToFloat(const T* input, float* output, size_t count);
+
+template <typename T>
+void ConvertFromFloat(const float* input, T* output, size_t count);
+
 }  // namespace math
 }  // namespace onnxruntime
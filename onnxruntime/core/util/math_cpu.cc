@@ -16,6 +16,7 @@
 // Modifications Copyright (c) Microsoft.
 
 #include <algorithm>
+#include <vector>
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 #include "core/mlas/inc/mlas.h"
@@ -46,10 +47,143 @@ namespace math {
     C_mat.noalias() = ConstEigenMatrixMap<T>(B, N, K) * ConstEigenMatrixMap<T>(A, K, M);        \
   }
 
-EIGEN_MATMUL_FUNCTION(int32_t)
-EIGEN_MATMUL_FUNCTION(uint32_t)
-EIGEN_MATMUL_FUNCTION(int64_t)
-EIGEN_MATMUL_FUNCTION(uint64_t)
+namespace {
+
+// Number of multiply-adds below which a MatMul isn't worth splitting across threads.
+constexpr double kMatMulThreadComplexity = 64 * 1024;
+
+// Returns the number of threads worth using for batch_size matrix multiplies of the given dimensions.
+int32_t MatMulThreadCount(int M, int N, int K, size_t batch_size, ThreadPool* threadpool) {
+  if (threadpool == nullptr) {
+    return 1;
+  }
+  const double complexity = static_cast<double>(M) * N * K * batch_size;
+  const int32_t max_threads = threadpool->NumThreads() + 1;
+  if (complexity >= kMatMulThreadComplexity * max_threads) {
+    return max_threads;
+  }
+  return static_cast<int32_t>(complexity / kMatMulThreadComplexity) + 1;
+}
+
+// Cache blocking for the integer MatMul kernel. A panel of kMatMulBlockK rows by kMatMulBlockN columns of B
+// stays in cache while it is applied to every row of A.
+constexpr int kMatMulBlockK = 128;
+constexpr int kMatMulBlockN = 256;
+
+// Computes rows [row_begin, row_end) of C = A * B. Used for the types that have no MLAS kernel.
+template <typename T>
+void MatMulRows(int row_begin, int row_end, int N, int K, const T* A, const T* B, T* C) {
+  for (int m = row_begin; m < row_end; m++) {
+    std::fill_n(C + static_cast<ptrdiff_t>(m) * N, N, T{0});
+  }
+
+  for (int k0 = 0; k0 < K; k0 += kMatMulBlockK) {
+    const int k1 = std::min(K, k0 + kMatMulBlockK);
+    for (int n0 = 0; n0 < N; n0 += kMatMulBlockN) {
+      const int count_n = std::min(N - n0, kMatMulBlockN);
+      for (int m = row_begin; m < row_end; m++) {
+        const T* a = A + static_cast<ptrdiff_t>(m) * K;
+        T* c = C + static_cast<ptrdiff_t>(m) * N + n0;
+        int k = k0;
+        // two rows of B per pass halves the loads and stores of the C row
+        for (; k + 1 < k1; k += 2) {
+          const T a0 = a[k];
+          const T a1 = a[k + 1];
+          const T* b0 = B + static_cast<ptrdiff_t>(k) * N + n0;
+          const T* b1 = b0 + N;
+          for (int n = 0; n < count_n; n++) {
+            c[n] += a0 * b0[n] + a1 * b1[n];
+          }
+        }
+        if (k < k1) {
+          const T a0 = a[k];
+          const T* b0 = B + static_cast<ptrdiff_t>(k) * N + n0;
+          for (int n = 0; n < count_n; n++) {
+            c[n] += a0 * b0[n];
+          }
+        }
+      }
+    }
+  }
+}
+
+// Batched blocked MatMul. Each matrix is split into blocks of rows when there are fewer matrices than threads,
+// and the (matrix, row block) pairs are distributed over the thread pool.
+template <typename T>
+void MatMulBatchBlocked(int M, int N, int K, size_t batch_size,
+                        const T* A, const size_t* A_offsets, const T* B, const size_t* B_offsets,
+                        T* C, const size_t* C_offsets, ThreadPool* threadpool) {
+  if (M <= 0 || N <= 0 || batch_size == 0) {
+    return;
+  }
+
+  const int32_t thread_count = MatMulThreadCount(M, N, K, batch_size, threadpool);
+
+  int row_blocks = 1;
+  if (static_cast<size_t>(thread_count) > batch_size) {
+    row_blocks = std::min(M, static_cast<int>((thread_count + batch_size - 1) / batch_size));
+  }
+  const int rows_per_block = (M + row_blocks - 1) / row_blocks;
+  row_blocks = (M + rows_per_block - 1) / rows_per_block;
+
+  auto compute_block = [&](size_t index) {
+    const size_t batch = index / row_blocks;
+    const int row_begin = static_cast<int>(index % row_blocks) * rows_per_block;
+    const int row_end = std::min(M, row_begin + rows_per_block);
+    MatMulRows(row_begin, row_end, N, K, A + A_offsets[batch], B + B_offsets[batch], C + C_offsets[batch]);
+  };
+
+  const size_t total = batch_size * row_blocks;
+  if (thread_count == 1 || total == 1) {
+    for (size_t i = 0; i < total; i++) {
+      compute_block(i);
+    }
+  } else {
+    ThreadPool::TryBatchParallelFor(
+        threadpool, static_cast<int32_t>(total), [&](int32_t i) { compute_block(static_cast<size_t>(i)); },
+        std::min(thread_count, static_cast<int32_t>(total)));
+  }
+}
+
+// Batched MatMul for types whose MatMul is already threaded internally: the matrices are run concurrently
+// on a single thread each if there are enough of them to occupy the pool, otherwise one at a time.
+template <typename T>
+void MatMulBatchEntries(int M, int N, int K, size_t batch_size,
+                        const T* A, const size_t* A_offsets, const T* B, const size_t* B_offsets,
+                        T* C, const size_t* C_offsets, ThreadPool* threadpool) {
+  const int32_t thread_count = MatMulThreadCount(M, N, K, batch_size, threadpool);
+  if (batch_size > 1 && static_cast<size_t>(thread_count) <= batch_size && thread_count > 1) {
+    ThreadPool::TryBatchParallelFor(
+        threadpool, static_cast<int32_t>(batch_size),
+        [&](int32_t i) { MatMul<T>(M, N, K, A + A_offsets[i], B + B_offsets[i], C + C_offsets[i], nullptr); },
+        thread_count);
+  } else {
+    for (size_t i = 0; i < batch_size; i++) {
+      MatMul<T>(M, N, K, A + A_offsets[i], B + B_offsets[i], C + C_offsets[i], threadpool);
+    }
+  }
+}
+
+}  // namespace
+
+#define BLOCKED_MATMUL_FUNCTION(T)                                                                           \
+  template <>                                                                                                \
+  void MatMul<T>(int M, int N, int K, const T* A, const T* B, T* C, ThreadPool* threadpool) {                \
+    const size_t zero_offset = 0;                                                                            \
+    MatMulBatchBlocked<T>(M, N, K, 1, A, &zero_offset, B, &zero_offset, C, &zero_offset, threadpool);         \
+  }                                                                                                          \
+  template <>                                                                                                \
+  void MatMulBatch<T>(int M, int N, int K, size_t batch_size, const T* A, const size_t* A_offsets,           \
+                      const T* B, const size_t* B_offsets, T* C, const size_t* C_offsets,                    \
+                      ThreadPool* threadpool) {                                                              \
+    MatMulBatchBlocked<T>(M, N, K, batch_size, A, A_offsets, B, B_offsets, C, C_offsets, threadpool);        \
+  }
+
+BLOCKED_MATMUL_FUNCTION(int32_t)
+BLOCKED_MATMUL_FUNCTION(uint32_t)
+BLOCKED_MATMUL_FUNCTION(int64_t)
+BLOCKED_MATMUL_FUNCTION(uint64_t)
+#undef BLOCKED_MATMUL_FUNCTION
 
 ////////////////////////////////////////////////////////////////////////////////
 // BLAS alternatives.
@@ -89,6 +223,22 @@ void MatMul<float>(int M, int N, int K, const float* A, const float* B, float* C
   MlasGemm(CblasNoTrans, CblasNoTrans, M, N, K, 1.f, A, K, B, N, 0.f, C, N, threadpool);
 }
 
+template <>
+void MatMulBatch<float>(int M, int N, int K, size_t batch_size, const float* A, const size_t* A_offsets,
+                        const float* B, const size_t* B_offsets, float* C, const size_t* C_offsets,
+                        ThreadPool* threadpool) {
+  std::vector<MLAS_SGEMM_DATA_PARAMS> data(batch_size);
+  for (size_t i = 0; i < batch_size; i++) {
+    data[i].A = A + A_offsets[i];
+    data[i].lda = K;
+    data[i].B = B + B_offsets[i];
+    data[i].ldb = N;
+    data[i].C = C + C_offsets[i];
+    data[i].ldc = N;
+  }
+  MlasGemmBatch(CblasNoTrans, CblasNoTrans, M, N, K, 1.f, data.data(), batch_size, 0.f, threadpool);
+}
+
 #if defined(_M_AMD64) || defined(__x86_64__)
 template <>
 void MatMul<double>(int M, int N, int K, const double* A, const double* B, double* C, ThreadPool* threadpool) {
@@ -98,6 +248,13 @@ void MatMul<double>(int M, int N, int K, const double* A, const double* B, doubl
 EIGEN_MATMUL_FUNCTION(double)
 #endif
 
+template <>
+void MatMulBatch<double>(int M, int N, int K, size_t batch_size, const double* A, const size_t* A_offsets,
+                         const double* B, const size_t* B_offsets, double* C, const size_t* C_offsets,
+                         ThreadPool* threadpool) {
+  MatMulBatchEntries<double>(M, N, K, batch_size, A, A_offsets, B, B_offsets, C, C_offsets, threadpool);
+}
+
 template <>
 void GemmEx<float, ThreadPool>(const CBLAS_TRANSPOSE TransA, const CBLAS_TRANSPOSE TransB, int M, int N, int K,
                                float alpha, const float* A, int lda, const float* B, int ldb, float beta, float* C,
@@ -170,6 +327,20 @@ void MatMul<double>(int M, int N, int K, const double* A, const double* B, doubl
   cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, M, N, K, 1, A, K, B, N, 0, C, N);
 }
 
+template <>
+void MatMulBatch<float>(int M, int N, int K, size_t batch_size, const float* A, const size_t* A_offsets,
+                        const float* B, const size_t* B_offsets, float* C, const size_t* C_offsets,
+                        ThreadPool* threadpool) {
+  MatMulBatchEntries<float>(M, N, K, batch_size, A, A_offsets, B, B_offsets, C, C_offsets, threadpool);
+}
+
+template <>
+void MatMulBatch<double>(int M, int N, int K, size_t batch_size, const double* A, const size_t* A_offsets,
+                         const double* B, const size_t* B_offsets, double* C, const size_t* C_offsets,
+                         ThreadPool* threadpool) {
+  MatMulBatchEntries<double>(M, N, K, batch_size, A, A_offsets, B, B_offsets, C, C_offsets, threadpool);
+}
+
 template <>
 void GemmEx<float, ThreadPool>(const CBLAS_TRANSPOSE TransA, const CBLAS_TRANSPOSE TransB, int M, int N, int K,
                                float alpha, const float* A, int lda, const float* B, int ldb, float beta, float* C,
@@ -198,6 +369,48 @@ CAFFE2_SPECIALIZED_AXPY(float, s)
 
 #endif
 
+// Half precision conversions and matrix multiplies. The matrices stay in their 16-bit storage type and MLAS
+// converts them to float as it packs them, so the products are accumulated in float and the result is rounded
+// to the storage type once.
+#define HALF_PRECISION_FUNCTIONS(T, type)                                                                        \
+  template <>                                                                                                  \
+  void ConvertToFloat<T>(const T* input, float* output, size_t count) {                                        \
+    MlasConvertHalfToFloat(type, reinterpret_cast<const unsigned short*>(input), output, count);               \
+  }                                                                                                            \
+  template <>                                                                                                  \
+  void ConvertFromFloat<T>(const float* input, T* output, size_t count) {                                      \
+    MlasConvertFloatToHalf(type, input, reinterpret_cast<unsigned short*>(output), count);                     \
+  }                                                                                                            \
+  template <>                                                                                                  \
+  void Gemm<T, ThreadPool>(const CBLAS_TRANSPOSE TransA, const CBLAS_TRANSPOSE TransB, const int64_t M,         \
+                           const int64_t N, const int64_t K, float alpha, const T* A, const T* B, float beta,   \
+                           T* C, ThreadPool* threadpool) {                                                     \
+    const size_t lda = static_cast<size_t>((TransA == CblasNoTrans) ? K : M);                                  \
+    const size_t ldb = static_cast<size_t>((TransB == CblasNoTrans) ? N : K);                                  \
+    const size_t size = static_cast<size_t>(M * N);                                                            \
+    std::vector<float> C_float(size);                                                                          \
+    if (beta != 0) {                                                                                           \
+      ConvertToFloat<T>(C, C_float.data(), size);                                                              \
+    }                                                                                                          \
+    MlasHalfGemm(type, TransA, TransB, M, N, K, alpha, reinterpret_cast<const unsigned short*>(A), lda,        \
+                 reinterpret_cast<const unsigned short*>(B), ldb, beta, C_float.data(), N, threadpool);        \
+    ConvertFromFloat<T>(C_float.data(), C, size);                                                              \
+  }                                                                                                            \
+  template <>                                                                                                  \
+  void MatMul<T>(int M, int N, int K, const T* A, const T* B, T* C, ThreadPool* threadpool) {                  \
+    Gemm<T, ThreadPool>(CblasNoTrans, CblasNoTrans, M, N, K, 1.f, A, B, 0.f, C, threadpool);                   \
+  }                                                                                                            \
+  template <>                                                                                                  \
+  void MatMulBatch<T>(int M, int N, int K, size_t batch_size, const T* A, const size_t* A_offsets,             \
+                      const T* B, const size_t* B_offsets, T* C, const size_t* C_offsets,                      \
+                      ThreadPool* threadpool) {                                                                \
+    MatMulBatchEntries<T>(M, N, K, batch_size, A, A_offsets, B, B_offsets, C, C_offsets, threadpool);          \
+  }
+
+HALF_PRECISION_FUNCTIONS(MLFloat16, MlasHalfFloat16)
+HALF_PRECISION_FUNCTIONS(BFloat16, MlasHalfBFloat16)
+#undef HALF_PRECISION_FUNCTIONS
+
 #define DELEGATE_SIMPLE_UNARY_FUNCTION(T, Funcname, expr)                  \
   template <>                                                              \
   void Funcname<T, CPUMathUtil>(int N, const T* x, T* y, CPUMathUtil*) {   \
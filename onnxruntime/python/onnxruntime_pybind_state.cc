@@ -8,6 +8,7 @@
 #define PY_ARRAY_UNIQUE_SYMBOL onnxruntime_python_ARRAY_API
 #include <numpy/arrayobject.h>
 
+#include "core/framework/columnar_map_sequence.h"
 #include "core/framework/data_types_internal.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/graph/graph_viewer.h"
@@ -151,7 +152,43 @@ void AddNonTensor(OrtValue& val, std::vector<py::object>& pyobjs) {
   pyobjs.push_back(py::cast(val.Get<T>()));
 }
 
-void GetPyObjFromTensor(const Tensor& rtensor, py::object& obj) {
+static const char* const kOrtValueCapsuleName = "onnxruntime.OrtValue";
+
+static void DeleteOrtValueCapsule(PyObject* capsule) {
+  delete static_cast<OrtValue*>(PyCapsule_GetPointer(capsule, kOrtValueCapsuleName));
+}
+
+// Create a numpy array that borrows 'data', which must be owned by the data of 'owner'. A capsule holding a copy of
+// 'owner' is set as the base object of the array so that the buffer remains valid for the lifetime of the array.
+static py::object GetPyObjAsView(void* data, std::vector<npy_intp>& npy_dims, int numpy_type, const OrtValue& owner) {
+  auto obj = py::reinterpret_steal<py::object>(PyArray_SimpleNewFromData(
+      static_cast<int>(npy_dims.size()), npy_dims.data(), numpy_type, data));
+  if (!obj) {
+    throw py::error_already_set();
+  }
+
+  auto value = onnxruntime::make_unique<OrtValue>(owner);
+  PyObject* capsule = PyCapsule_New(value.get(), kOrtValueCapsuleName, DeleteOrtValueCapsule);
+  if (capsule == nullptr) {
+    throw py::error_already_set();
+  }
+
+  value.release();  // now owned by the capsule
+
+  // steals the reference to the capsule
+  if (PyArray_SetBaseObject(reinterpret_cast<PyArrayObject*>(obj.ptr()), capsule) != 0) {
+    throw py::error_already_set();
+  }
+
+  return obj;
+}
+
+// Create a numpy array from a tensor.
+// If 'owner' is provided and the tensor holds numeric data in a CPU buffer that it owns, the array borrows the
+// tensor's buffer (see GetPyObjAsView). Otherwise the data is copied into a new array: a tensor that does not
+// own its buffer wraps memory such as an initializer or the caller's input array, which the capsule can not keep
+// alive and which must not be written through the returned array.
+void GetPyObjFromTensor(const Tensor& rtensor, py::object& obj, const OrtValue* owner = nullptr) {
   std::vector<npy_intp> npy_dims;
   const TensorShape& shape = rtensor.Shape();
 
@@ -161,6 +198,13 @@ void GetPyObjFromTensor(const Tensor& rtensor, py::object& obj) {
 
   MLDataType dtype = rtensor.DataType();
   const int numpy_type = OnnxRuntimeTensorToNumpyType(dtype);
+
+  if (owner != nullptr && numpy_type != NPY_OBJECT && shape.Size() > 0 && rtensor.OwnsBuffer() &&
+      rtensor.Location().device.Type() == OrtDevice::CPU) {
+    obj = GetPyObjAsView(const_cast<void*>(rtensor.DataRaw(dtype)), npy_dims, numpy_type, *owner);
+    return;
+  }
+
   obj = py::reinterpret_steal<py::object>(PyArray_SimpleNew(
       shape.NumDimensions(), npy_dims.data(), numpy_type));
 
@@ -185,17 +229,186 @@ void AddNonTensor<TensorSeq>(OrtValue& val, std::vector<py::object>& pyobjs) {
   py::list py_list;
   for (const auto& rtensor : seq_tensors) {
     py::object obj;
-    GetPyObjFromTensor(rtensor, obj);
+    GetPyObjFromTensor(rtensor, obj, &val);
     py_list.append(obj);
   }
   pyobjs.push_back(py_list);
 }
 
+// Converts a sequence of maps into a list of dicts. The maps produced by ZipMap all have the same keys, so the key
+// objects of the previous map are reused for as long as the keys match instead of converting the keys of each map.
+template <typename T>
+void AddSequenceOfMaps(OrtValue& val, std::vector<py::object>& pyobjs) {
+  using TKey = typename T::value_type::key_type;
+  const auto& maps = val.Get<T>();
+  std::vector<TKey> keys;
+  std::vector<py::object> py_keys;
+  py::list py_list;
+  for (const auto& row : maps) {
+    bool same_keys = row.size() == keys.size() &&
+                     std::equal(row.begin(), row.end(), keys.begin(),
+                                [](const typename T::value_type::value_type& kv, const TKey& key) {
+                                  return kv.first == key;
+                                });
+    if (!same_keys) {
+      keys.clear();
+      py_keys.clear();
+      for (const auto& kv : row) {
+        keys.push_back(kv.first);
+        py_keys.push_back(py::cast(kv.first));
+      }
+    }
+    py::dict py_dict;
+    size_t k = 0;
+    for (const auto& kv : row) {
+      py_dict[py_keys[k++]] = py::float_(kv.second);
+    }
+    py_list.append(py_dict);
+  }
+  pyobjs.push_back(py_list);
+}
+
+template <>
+void AddNonTensor<VectorMapStringToFloat>(OrtValue& val, std::vector<py::object>& pyobjs) {
+  AddSequenceOfMaps<VectorMapStringToFloat>(val, pyobjs);
+}
+
+template <>
+void AddNonTensor<VectorMapInt64ToFloat>(OrtValue& val, std::vector<py::object>& pyobjs) {
+  AddSequenceOfMaps<VectorMapInt64ToFloat>(val, pyobjs);
+}
+
+// Python object returned for a columnar map sequence (see SessionOptions::use_columnar_zipmap_output). Indexing it
+// returns a ColumnarMapRow, a lazy view of one map that reads the shared keys and its row of the [N, C] values in
+// place, so no dict is built unless the caller asks for one.
+template <typename TKey>
+class PyColumnarMapSequence {
+ public:
+  explicit PyColumnarMapSequence(const OrtValue& value) : value_(value) {}
+
+  const ColumnarMapSequence<TKey>& Get() const { return value_.Get<ColumnarMapSequence<TKey>>(); }
+  const OrtValue& Value() const { return value_; }
+
+ private:
+  OrtValue value_;
+};
+
+template <typename TKey>
+static py::list GetColumnarKeys(const ColumnarMapSequence<TKey>& seq) {
+  py::list keys;
+  const TKey* key_data = seq.KeyData();
+  for (size_t i = 0, num_keys = seq.NumKeys(); i < num_keys; ++i) {
+    keys.append(py::cast(key_data[i]));
+  }
+  return keys;
+}
+
+static py::dict GetColumnarRowAsDict(const py::list& keys, const float* values) {
+  py::dict dict;
+  size_t column = 0;
+  for (const auto& key : keys) {
+    dict[key] = py::float_(values[column++]);
+  }
+  return dict;
+}
+
+template <typename TKey>
+void AddColumnarMapTypes(py::module& m, const char* sequence_name, const char* row_name) {
+  using Row = ColumnarMapRow<TKey>;
+  using Sequence = PyColumnarMapSequence<TKey>;
+
+  py::class_<Row>(m, row_name, R"pbdoc(Lazy view of one map of a columnar map sequence.
+The keys and the values are read in place from the sequence.)pbdoc")
+      .def("__len__", [](const Row& row) { return row.Sequence().NumKeys(); })
+      .def("__getitem__", [](const Row& row, const TKey& key) {
+        int64_t column = row.Sequence().FindColumn(key);
+        if (column < 0) {
+          throw py::key_error(py::repr(py::cast(key)).cast<std::string>());
+        }
+        return row.Values().template Data<float>()[column];
+      })
+      .def(
+          "get", [](const Row& row, const TKey& key, py::object default_value) -> py::object {
+            int64_t column = row.Sequence().FindColumn(key);
+            if (column < 0) {
+              return default_value;
+            }
+            return py::float_(row.Values().template Data<float>()[column]);
+          },
+          py::arg("key"), py::arg("default") = py::none())
+      .def("__contains__", [](const Row& row, const TKey& key) { return row.Sequence().FindColumn(key) >= 0; })
+      .def("__iter__", [](const Row& row) { return py::iter(GetColumnarKeys(row.Sequence())); })
+      .def("keys", [](const Row& row) { return GetColumnarKeys(row.Sequence()); }, "The keys, in map order.")
+      .def(
+          "values", [](const Row& row) {
+            std::vector<npy_intp> npy_dims{static_cast<npy_intp>(row.Sequence().NumKeys())};
+            return GetPyObjAsView(const_cast<float*>(row.Values().template Data<float>()), npy_dims, NPY_FLOAT,
+                                  row.SequenceValue());
+          },
+          "The values in key order, as a numpy array that views the sequence.")
+      .def(
+          "items", [](const Row& row) {
+            py::list items;
+            const float* values = row.Values().template Data<float>();
+            size_t column = 0;
+            for (const auto& key : GetColumnarKeys(row.Sequence())) {
+              items.append(py::make_tuple(key, py::float_(values[column++])));
+            }
+            return items;
+          },
+          "The (key, value) pairs, in map order.")
+      .def(
+          "to_dict", [](const Row& row) {
+            return GetColumnarRowAsDict(GetColumnarKeys(row.Sequence()), row.Values().template Data<float>());
+          },
+          "Copy the map into a dict.");
+
+  py::class_<Sequence>(m, sequence_name, R"pbdoc(Sequence of maps that all have the same keys, stored by column.
+The keys are shared by every map and the values are a dense [N, C] float array. Indexing returns a lazy view of
+one map.)pbdoc")
+      .def("__len__", [](const Sequence& seq) { return seq.Get().Size(); })
+      .def("__getitem__", [](const Sequence& seq, int64_t index) {
+        const auto size = static_cast<int64_t>(seq.Get().Size());
+        if (index < 0) {
+          index += size;
+        }
+        if (index < 0 || index >= size) {
+          throw py::index_error("sequence index out of range");
+        }
+        return Row(seq.Value(), static_cast<size_t>(index));
+      })
+      .def_property_readonly(
+          "keys", [](const Sequence& seq) { return GetColumnarKeys(seq.Get()); },
+          "The keys shared by every map, in map order.")
+      .def_property_readonly(
+          "values", [](const Sequence& seq) {
+            py::object obj;
+            GetPyObjFromTensor(seq.Get().Values(), obj, &seq.Value());
+            return obj;
+          },
+          "The [N, C] values as a numpy array that views the sequence. Row n holds the values of map n in key order.")
+      .def(
+          "to_list", [](const Sequence& seq) {
+            const auto& maps = seq.Get();
+            py::list keys = GetColumnarKeys(maps);
+            py::list list;
+            for (size_t n = 0, size = maps.Size(); n < size; ++n) {
+              list.append(GetColumnarRowAsDict(keys, maps.Row(n)));
+            }
+            return list;
+          },
+          "Copy the maps into a list of dicts, the output of ZipMap without the columnar option.");
+}
+
 void AddNonTensorAsPyObj(OrtValue& val, std::vector<py::object>& pyobjs) {
   // Should be in sync with core/framework/datatypes.h
   auto val_type = val.Type();
   if (val_type->IsTensorSequenceType()) {
     AddNonTensor<TensorSeq>(val, pyobjs);
+  } else if (val_type == DataTypeImpl::GetType<ColumnarMapSequenceStringToFloat>()) {
+    pyobjs.push_back(py::cast(PyColumnarMapSequence<std::string>(val)));
+  } else if (val_type == DataTypeImpl::GetType<ColumnarMapSequenceInt64ToFloat>()) {
+    pyobjs.push_back(py::cast(PyColumnarMapSequence<int64_t>(val)));
   } else {
     utils::ContainerChecker c_checker(val_type);
     if (c_checker.IsMap()) {
@@ -231,7 +444,7 @@ void AddNonTensorAsPyObj(OrtValue& val, std::vector<py::object>& pyobjs) {
 void AddTensorAsPyObj(OrtValue& val, std::vector<py::object>& pyobjs) {
   const Tensor& rtensor = val.Get<Tensor>();
   py::object obj;
-  GetPyObjFromTensor(rtensor, obj);
+  GetPyObjFromTensor(rtensor, obj, &val);
   pyobjs.push_back(obj);
 }
 
@@ -566,6 +779,20 @@ void addObjectMethods(py::module& m) {
 Set this option to false if you don't want it. Default is True.)pbdoc")
       .def_readwrite("enable_profiling", &SessionOptions::enable_profiling,
                      R"pbdoc(Enable profiling for this session. Default is false.)pbdoc")
+      .def_readwrite("enable_op_statistics", &SessionOptions::enable_op_statistics,
+                     R"pbdoc(Enable aggregated per node execution statistics for this session. Cheap enough to leave on
+in production. Read them with :meth:`InferenceSession.get_op_statistics`. Default is false.)pbdoc")
+      .def_readwrite("op_statistics_trace_sample_rate", &SessionOptions::op_statistics_trace_sample_rate,
+                     R"pbdoc(When op statistics are enabled, also keep every Nth run of each node in a bounded trace.
+Default is 0 (no trace).)pbdoc")
+      .def_readwrite("enable_memory_statistics", &SessionOptions::enable_memory_statistics,
+                     R"pbdoc(Attribute the memory allocated during runs to the nodes that requested it, and record the live
+memory timeline and the allocations live at the peak. Diagnostic mode that slows down allocations. Read them with
+:meth:`InferenceSession.get_memory_statistics`. Default is false.)pbdoc")
+      .def_readwrite("use_columnar_zipmap_output", &SessionOptions::use_columnar_zipmap_output,
+                     R"pbdoc(Return the sequences of maps built by ZipMap for the model outputs as
+:class:`ColumnarMapSequenceStringToFloat` or :class:`ColumnarMapSequenceInt64ToFloat` objects, which share one list of
+keys and hold the values in a dense [N, C] array, instead of lists of dicts. Default is false.)pbdoc")
       .def_readwrite("optimized_model_filepath", &SessionOptions::optimized_model_filepath,
                      R"pbdoc(File path to serialize optimized model. By default, optimized model is not serialized if optimized_model_filepath is not provided.)pbdoc")
       .def_readwrite("enable_mem_pattern", &SessionOptions::enable_mem_pattern,
@@ -627,6 +854,9 @@ Applies to session load, initialization, etc. Default is 0.)pbdoc")
           },
           R"pbdoc(Graph optimization level for this session.)pbdoc");
 
+  AddColumnarMapTypes<std::string>(m, "ColumnarMapSequenceStringToFloat", "ColumnarMapRowStringToFloat");
+  AddColumnarMapTypes<int64_t>(m, "ColumnarMapSequenceInt64ToFloat", "ColumnarMapRowInt64ToFloat");
+
   py::class_<RunOptions>(m, "RunOptions", R"pbdoc(Configuration information for a single Run.)pbdoc")
       .def(py::init())
       .def_readwrite("log_severity_level", &RunOptions::run_log_severity_level,
@@ -783,6 +1013,18 @@ including arg name, arg type (contains both type and shape).)pbdoc")
       .def("end_profiling", [](InferenceSession* sess) -> std::string {
         return sess->EndProfiling();
       })
+      .def("get_op_statistics", [](InferenceSession* sess, bool reset) -> std::string {
+        std::string json;
+        OrtPybindThrowIfError(sess->GetOpStatistics(json, reset));
+        return json;
+      },
+           py::arg("reset") = false)
+      .def("get_memory_statistics", [](InferenceSession* sess, bool reset) -> std::string {
+        std::string json;
+        OrtPybindThrowIfError(sess->GetMemoryStatistics(json, reset));
+        return json;
+      },
+           py::arg("reset") = false)
       .def("get_providers", [](InferenceSession* sess) -> const std::vector<std::string>& {
         return sess->GetRegisteredProviderTypes();
       })
@@ -160,3 +160,24 @@ class InferenceSession:
         :meth:`onnxruntime.SessionOptions.enable_profiling`.
         """
         return self._sess.end_profiling()
+
+    def get_op_statistics(self, reset=False):
+        """
+        Return the aggregated per node and per op type execution statistics as a JSON string.
+
+        Requires :meth:`onnxruntime.SessionOptions.enable_op_statistics`.
+
+        :param reset: clear the statistics after reading them
+        """
+        return self._sess.get_op_statistics(reset)
+
+    def get_memory_statistics(self, reset=False):
+        """
+        Return the memory allocated by each node, the live memory timeline of the last run,
+        and the allocations live at the peak as a JSON string.
+
+        Requires :meth:`onnxruntime.SessionOptions.enable_memory_statistics`.
+
+        :param reset: clear the statistics after reading them
+        """
+        return self._sess.get_memory_statistics(reset)
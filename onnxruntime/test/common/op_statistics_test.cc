@@ -0,0 +1,162 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/op_statistics.h"
+
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+using profiling::OpStatistics;
+
+static size_t CountOccurrences(const std::string& text, const std::string& pattern) {
+  size_t count = 0;
+  for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) {
+    count++;
+  }
+  return count;
+}
+
+TEST(OpStatisticsTest, RegisterNodesAssignsConsecutiveSlots) {
+  OpStatistics stats;
+  EXPECT_EQ(stats.RegisterNodes({"a", "b"}, {"Add", "Mul"}), 0u);
+  EXPECT_EQ(stats.RegisterNodes({"c", "", "d"}, {"Relu", "", "Relu"}), 2u);
+}
+
+TEST(OpStatisticsTest, AggregatesPerNodeAndPerOpType) {
+  OpStatistics stats;
+  stats.RegisterNodes({"add_1", "relu_1", "relu_2", "unused"}, {"Add", "Relu", "Relu", "Mul"});
+
+  const auto start = OpStatistics::Clock::now() - std::chrono::microseconds(100);
+  for (int i = 0; i < 3; i++) {
+    stats.Record(0, start, 16);
+  }
+  stats.Record(1, start, 8);
+  stats.Record(2, start, 8);
+
+  const std::string json = stats.ToJson();
+  EXPECT_NE(json.find("{\"name\":\"add_1\",\"op_type\":\"Add\",\"count\":3,"), std::string::npos) << json;
+  EXPECT_NE(json.find("\"output_bytes\":48}"), std::string::npos) << json;
+  EXPECT_NE(json.find("{\"op_type\":\"Relu\",\"node_count\":2,\"count\":2,"), std::string::npos) << json;
+  // nodes that never ran are omitted
+  EXPECT_EQ(json.find("unused"), std::string::npos) << json;
+  EXPECT_NE(json.find("\"trace\":[]"), std::string::npos) << json;
+}
+
+TEST(OpStatisticsTest, PercentilesAreWithinBucketPrecision) {
+  OpStatistics stats;
+  stats.RegisterNodes({"n"}, {"Op"});
+
+  // 98 fast runs and 2 slow ones: p50 and p90 must report the fast duration and p99 the slow one.
+  const auto now = OpStatistics::Clock::now();
+  for (int i = 0; i < 98; i++) {
+    stats.Record(0, now - std::chrono::milliseconds(1), 0);
+  }
+  stats.Record(0, now - std::chrono::milliseconds(100), 0);
+  stats.Record(0, now - std::chrono::milliseconds(100), 0);
+
+  const std::string json = stats.ToJson();
+  auto value_of = [&json](const std::string& key) {
+    const size_t pos = json.find("\"" + key + "\":");
+    EXPECT_NE(pos, std::string::npos) << key;
+    return std::stod(json.substr(pos + key.size() + 3));
+  };
+  // a bucket reports its midpoint, which is within an eighth of the recorded value, and Record measures
+  // from start_time to now, so also allow for the time spent in this test.
+  EXPECT_GE(value_of("p50_us"), 1000 * 0.875);
+  EXPECT_LT(value_of("p50_us"), 1000 * 1.25 + 50000);
+  EXPECT_LT(value_of("p90_us"), 100000 * 0.875);
+  EXPECT_GE(value_of("p99_us"), 100000 * 0.875);
+  EXPECT_GE(value_of("max_us"), 100000);
+}
+
+TEST(OpStatisticsTest, TraceSamplesEveryNthRun) {
+  OpStatistics stats(4);
+  stats.RegisterNodes({"a", "b"}, {"Add", "Mul"});
+
+  for (int i = 0; i < 8; i++) {
+    stats.Record(0, OpStatistics::Clock::now(), 0);
+  }
+  stats.Record(1, OpStatistics::Clock::now(), 0);
+
+  const std::string json = stats.ToJson();
+  const std::string trace = json.substr(json.find("\"trace\":"));
+  EXPECT_EQ(CountOccurrences(trace, "\"name\":\"a\""), 2u) << json;
+  EXPECT_EQ(CountOccurrences(trace, "\"name\":\"b\""), 1u) << json;
+}
+
+TEST(OpStatisticsTest, TraceKeepsMostRecentRecords) {
+  OpStatistics stats(1);
+  stats.RegisterNodes({"a"}, {"Add"});
+
+  for (size_t i = 0; i < OpStatistics::kTraceCapacity + 10; i++) {
+    stats.Record(0, OpStatistics::Clock::now(), 0);
+  }
+
+  const std::string json = stats.ToJson();
+  const std::string trace = json.substr(json.find("\"trace\":"));
+  EXPECT_EQ(CountOccurrences(trace, "\"dur_us\""), OpStatistics::kTraceCapacity);
+}
+
+TEST(OpStatisticsTest, RecordsFromManyThreads) {
+  OpStatistics stats(0);
+  stats.RegisterNodes({"a", "b"}, {"Add", "Add"});
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; t++) {
+    threads.emplace_back([&stats, t]() {
+      for (int i = 0; i < 1000; i++) {
+        stats.Record(t % 2, OpStatistics::Clock::now(), 1);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  const std::string json = stats.ToJson();
+  EXPECT_NE(json.find("{\"op_type\":\"Add\",\"node_count\":2,\"count\":8000,"), std::string::npos) << json;
+  EXPECT_EQ(CountOccurrences(json, "\"output_bytes\":4000}"), 2u) << json;
+}
+
+TEST(OpStatisticsTest, TraceSampleRateIsPerNodeAcrossThreads) {
+  OpStatistics stats(100);
+  stats.RegisterNodes({"a"}, {"Add"});
+
+  // each thread records fewer executions than the sample rate, so only the node total triggers sampling
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 16; t++) {
+    threads.emplace_back([&stats]() {
+      for (int i = 0; i < 50; i++) {
+        stats.Record(0, OpStatistics::Clock::now(), 0);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  const std::string json = stats.ToJson();
+  const std::string trace = json.substr(json.find("\"trace\":"));
+  EXPECT_EQ(CountOccurrences(trace, "\"dur_us\""), 8u) << json;
+}
+
+TEST(OpStatisticsTest, ResetClearsCountersAndTrace) {
+  OpStatistics stats(1);
+  stats.RegisterNodes({"a", "b\"quoted\""}, {"Add", "Mul"});
+
+  stats.Record(0, OpStatistics::Clock::now(), 4);
+  stats.Reset();
+  EXPECT_EQ(stats.ToJson(), "{\"nodes\":[],\"op_types\":[],\"trace\":[]}");
+
+  stats.Record(1, OpStatistics::Clock::now(), 4);
+  const std::string json = stats.ToJson();
+  EXPECT_NE(json.find("\"name\":\"b\\\"quoted\\\"\",\"op_type\":\"Mul\",\"count\":1,"), std::string::npos) << json;
+  EXPECT_EQ(json.find("\"Add\""), std::string::npos) << json;
+}
+
+}  // namespace test
+}  // namespace onnxruntime
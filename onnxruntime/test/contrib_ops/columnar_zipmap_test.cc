@@ -0,0 +1,137 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/logging/logging.h"
+#include "core/framework/data_types.h"
+#include "core/graph/model.h"
+#include "core/session/onnxruntime_cxx_api.h"
+#include "gtest/gtest.h"
+#include "test/framework/test_utils.h"
+
+extern std::unique_ptr<Ort::Env> ort_env;
+
+namespace onnxruntime {
+namespace test {
+
+// Serializes a model with a single ZipMap node from X [N, C] to the graph output Z. The model imports only the
+// onnx and ai.onnx.ml domains, so the columnar rewrite has to add com.microsoft itself.
+template <typename TKey>
+static std::string CreateZipMapModel(const std::string& attr_name, const std::vector<TKey>& labels) {
+  std::unordered_map<std::string, int> domain_to_version{{kOnnxDomain, 11}, {kMLDomain, 1}};
+  Model model("ZipMap", false, ModelMetaData(), IOnnxRuntimeOpSchemaRegistryList(), domain_to_version, {},
+              logging::LoggingManager::DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  ONNX_NAMESPACE::TypeProto maps_type(*DataTypeImpl::GetType<std::vector<std::map<TKey, float>>>()->GetTypeProto());
+
+  auto& x = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& z = graph.GetOrCreateNodeArg("Z", &maps_type);
+  auto& node = graph.AddNode("zipmap", "ZipMap", "ZipMap", {&x}, {&z}, nullptr, kMLDomain);
+  node.AddAttribute(attr_name, labels);
+  EXPECT_TRUE(graph.Resolve().IsOK());
+
+  std::string serialized_model;
+  EXPECT_TRUE(model.ToProto().SerializeToString(&serialized_model));
+  return serialized_model;
+}
+
+static Ort::Value RunZipMap(const std::string& model, bool columnar, std::vector<float>& x, int64_t rows) {
+  Ort::SessionOptions session_options;
+  if (columnar) {
+    session_options.EnableColumnarZipMapOutput();
+  }
+  Ort::Session session(*ort_env, model.data(), model.size(), session_options);
+
+  auto memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+  std::vector<int64_t> x_dims{rows, static_cast<int64_t>(x.size()) / rows};
+  Ort::Value input = Ort::Value::CreateTensor<float>(memory_info, x.data(), x.size(), x_dims.data(), x_dims.size());
+
+  const char* const input_names[] = {"X"};
+  const char* const output_names[] = {"Z"};
+  auto outputs = session.Run(Ort::RunOptions{nullptr}, input_names, &input, 1, output_names, 1);
+  return std::move(outputs[0]);
+}
+
+static std::vector<std::string> GetStrings(const Ort::Value& value) {
+  const size_t count = value.GetTensorTypeAndShapeInfo().GetElementCount();
+  const size_t length = value.GetStringTensorDataLength();
+  std::string buffer(length, '\0');
+  std::vector<size_t> offsets(count);
+  value.GetStringTensorContent(&buffer[0], length, offsets.data(), count);
+  std::vector<std::string> strings;
+  for (size_t i = 0; i < count; ++i) {
+    size_t end = i + 1 < count ? offsets[i + 1] : length;
+    strings.push_back(buffer.substr(offsets[i], end - offsets[i]));
+  }
+  return strings;
+}
+
+template <typename T>
+static std::vector<T> GetData(Ort::Value& value) {
+  const size_t count = value.GetTensorTypeAndShapeInfo().GetElementCount();
+  const T* data = value.GetTensorMutableData<T>();
+  return std::vector<T>(data, data + count);
+}
+
+TEST(ColumnarZipMapTest, StringKeys) {
+  // 'a' is repeated. The last column wins, as in ZipMap.
+  std::string model = CreateZipMapModel<std::string>("classlabels_strings", {"c", "a", "b", "a"});
+  std::vector<float> x{1.f, 2.f, 3.f, 4.f,
+                       5.f, 6.f, 7.f, 8.f,
+                       9.f, 10.f, 11.f, 12.f};
+  const std::vector<std::string> expected_keys{"a", "b", "c"};
+  const std::vector<float> expected_values{4.f, 3.f, 1.f,
+                                           8.f, 7.f, 5.f,
+                                           12.f, 11.f, 9.f};
+  Ort::AllocatorWithDefaultOptions allocator;
+
+  // the default output is unchanged
+  Ort::Value maps = RunZipMap(model, false, x, 3);
+  ASSERT_EQ(maps.GetTypeInfo().GetONNXType(), ONNX_TYPE_SEQUENCE);
+  ASSERT_EQ(maps.GetCount(), 3u);
+
+  Ort::Value columnar = RunZipMap(model, true, x, 3);
+  ASSERT_EQ(columnar.GetTypeInfo().GetONNXType(), ONNX_TYPE_OPAQUE);
+  ASSERT_EQ(columnar.GetCount(), 3u);
+
+  OrtColumnarMapSequence container;
+  columnar.GetOpaqueData(kMSDomain, "ColumnarMapSequenceStringToFloat", container);
+  Ort::Value keys(container.keys);
+  Ort::Value values(container.values);
+  EXPECT_EQ(GetStrings(keys), expected_keys);
+  EXPECT_EQ(values.GetTensorTypeAndShapeInfo().GetShape(), std::vector<int64_t>({3, 3}));
+  EXPECT_EQ(GetData<float>(values), expected_values);
+
+  for (int n = 0; n < 3; ++n) {
+    Ort::Value row = columnar.GetValue(n, allocator);
+    Ort::Value map = maps.GetValue(n, allocator);
+    ASSERT_EQ(row.GetCount(), 2u);
+    Ort::Value row_keys = row.GetValue(0, allocator);
+    Ort::Value row_values = row.GetValue(1, allocator);
+    Ort::Value map_values = map.GetValue(1, allocator);
+    EXPECT_EQ(GetStrings(row_keys), expected_keys);
+    EXPECT_EQ(GetData<float>(row_values), GetData<float>(map_values));
+  }
+}
+
+TEST(ColumnarZipMapTest, Int64Keys) {
+  std::string model = CreateZipMapModel<int64_t>("classlabels_int64s", {30, 10, 20});
+  std::vector<float> x{1.f, 2.f, 3.f};
+  Ort::AllocatorWithDefaultOptions allocator;
+
+  Ort::Value columnar = RunZipMap(model, true, x, 1);
+  ASSERT_EQ(columnar.GetCount(), 1u);
+
+  // the row outlives the sequence it views
+  Ort::Value row = columnar.GetValue(0, allocator);
+  columnar = Ort::Value(nullptr);
+  Ort::Value row_keys = row.GetValue(0, allocator);
+  Ort::Value row_values = row.GetValue(1, allocator);
+  EXPECT_EQ(GetData<int64_t>(row_keys), std::vector<int64_t>({10, 20, 30}));
+  EXPECT_EQ(GetData<float>(row_values), std::vector<float>({2.f, 3.f, 1.f}));
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -114,5 +114,58 @@ TEST(BiasGeluTest, Two_One_Dim) {
   RunBiasGeluTest(input_a_data, input_b_data, {2, 4}, {4});
 }
 
+TEST(FusedElementwiseTest, BiasSwish) {
+  OpTester tester("FusedElementwise", 1, onnxruntime::kMSDomain);
+
+  // slot 2 = X + B, slot 3 = Sigmoid(slot 2), slot 4 = slot 2 * slot 3
+  tester.AddAttribute("ops", std::vector<std::string>{"Add", "Sigmoid", "Mul"});
+  tester.AddAttribute("operands", std::vector<int64_t>{0, 1, 2, 2, 3});
+  tester.AddAttribute("output_slots", std::vector<int64_t>{4, 2});
+
+  std::vector<float> x = {0.8f, -0.5f, 0.0f, 1.f, 0.5f, 0.2f, 0.3f, -0.6f};
+  std::vector<float> b = {-0.5f, 0.6f, 1.2f, 2.1f};
+  std::vector<float> sum = Add_Simple(x, b);
+  std::vector<float> swish(sum.size());
+  for (size_t i = 0; i < sum.size(); i++) {
+    swish[i] = sum[i] / (1.0f + std::exp(-sum[i]));
+  }
+
+  tester.AddInput<float>("X", {2, 4}, x);
+  tester.AddInput<float>("B", {4}, b);
+  tester.AddOutput<float>("Y", {2, 4}, swish);
+  tester.AddOutput<float>("S", {2, 4}, sum);
+  tester.Run();
+}
+
+TEST(FusedElementwiseTest, BroadcastManyTiles) {
+  OpTester tester("FusedElementwise", 1, onnxruntime::kMSDomain);
+
+  // Tanh(Abs((X - M) * S)) with a per channel M and a scalar S, over enough elements to need many tiles
+  tester.AddAttribute("ops", std::vector<std::string>{"Sub", "Mul", "Abs", "Tanh"});
+  tester.AddAttribute("operands", std::vector<int64_t>{0, 1, 3, 2, 4, 5});
+  tester.AddAttribute("output_slots", std::vector<int64_t>{6});
+
+  const std::vector<int64_t> x_dims = {2, 3, 40, 50};
+  const int64_t spatial = 40 * 50;
+  std::vector<float> x(2 * 3 * spatial);
+  for (size_t i = 0; i < x.size(); i++) {
+    x[i] = static_cast<float>(static_cast<int64_t>(i % 97) - 48) * 0.05f;
+  }
+  std::vector<float> m = {-1.0f, 0.25f, 2.0f};
+  std::vector<float> s = {0.75f};
+
+  std::vector<float> y(x.size());
+  for (size_t i = 0; i < x.size(); i++) {
+    const float mean = m[(i / spatial) % 3];
+    y[i] = std::tanh(std::abs((x[i] - mean) * s[0]));
+  }
+
+  tester.AddInput<float>("X", x_dims, x);
+  tester.AddInput<float>("M", {3, 1, 1}, m);
+  tester.AddInput<float>("S", {}, s);
+  tester.AddOutput<float>("Y", x_dims, y);
+  tester.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
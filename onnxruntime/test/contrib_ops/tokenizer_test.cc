@@ -864,5 +864,43 @@ TEST(ContribOpTest, Tokenizer_EmptyInput) {
     test.Run(OpTester::ExpectResult::kExpectSuccess);
   }
 }
+
+TEST(ContribOpTest, TokenizerWithSeparators_NonOverlappingLiteralsNC) {
+  // Literal separators that can not overlap are searched for together.
+  // The result must be the same as applying them one after another
+  // [N][C] dimensions
+  // Output [N][C][D]
+  std::vector<std::string> separators = {
+      u8" ",
+      u8"，",
+      u8"--"};
+
+  OpTester test("Tokenizer", opset_ver, domain);
+  InitTestAttr(test, false, separators, 2);
+
+  std::vector<int64_t> dims{2, 2};
+  std::vector<std::string> input{u8"ab cd，ef", u8"a--bc", u8"中文-- x yz", u8""};
+  test.AddInput<std::string>("T", dims, input);
+
+  std::vector<int64_t> output_dims(dims);
+  output_dims.push_back(int64_t(3));
+  std::vector<std::string> output{
+      u8"ab",
+      u8"cd",
+      u8"ef",
+      u8"bc",
+      padval,
+      padval,
+      u8"中文",
+      u8"yz",
+      padval,
+      padval,
+      padval,
+      padval};
+
+  test.AddOutput<std::string>("Y", output_dims, output);
+  test.Run(OpTester::ExpectResult::kExpectSuccess);
+}
+}
 }  // namespace test
 }  // namespace onnxruntime
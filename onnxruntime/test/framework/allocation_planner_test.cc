@@ -150,6 +150,8 @@ class PlannerTest : public ::testing::Test {
 
   std::unique_ptr<::onnxruntime::KernelDef> std_kernel_;       // a unary kernel with no-aliasing and no-in-place
   std::unique_ptr<::onnxruntime::KernelDef> in_place_kernel_;  // a unary kernel with in-place
+  std::unique_ptr<::onnxruntime::KernelDef> strided_output_kernel_;  // a unary kernel that may produce a strided view
+  std::unique_ptr<::onnxruntime::KernelDef> strided_input_kernel_;   // a unary kernel that may read a strided view
 
   std::unordered_map<std::string, onnxruntime::NodeArg*> name_to_arg_;
   std::vector<std::unique_ptr<UnaryNode>> nodes_;
@@ -170,6 +172,10 @@ class PlannerTest : public ::testing::Test {
     std_kernel_ = KernelDefBuilder().SetName("Transpose").Provider(kCpuExecutionProvider).SinceVersion(1, 10).Build();
     in_place_kernel_ =
         KernelDefBuilder().SetName("Relu").Provider(kCpuExecutionProvider).SinceVersion(1, 10).MayInplace(0, 0).Build();
+    strided_output_kernel_ =
+        KernelDefBuilder().SetName("Abs").Provider(kCpuExecutionProvider).SinceVersion(1, 10).MayStridedOutput(0, 0).Build();
+    strided_input_kernel_ =
+        KernelDefBuilder().SetName("Neg").Provider(kCpuExecutionProvider).SinceVersion(1, 10).MayStridedInput(0).Build();
     CPUExecutionProviderInfo epi;
     auto execution_provider = onnxruntime::make_unique<CPUExecutionProvider>(epi);
     execution_providers_.Add("CPUExecutionProvider", std::move(execution_provider));
@@ -198,6 +204,14 @@ class PlannerTest : public ::testing::Test {
     return AddNode(*in_place_kernel_, input, output);
   }
 
+  onnxruntime::Node* AddStridedOutputNode(std::string& input, std::string& output) {
+    return AddNode(*strided_output_kernel_, input, output);
+  }
+
+  onnxruntime::Node* AddStridedInputNode(std::string& input, std::string& output) {
+    return AddNode(*strided_input_kernel_, input, output);
+  }
+
   void BindKernel(onnxruntime::Node* p_node, ::onnxruntime::KernelDef& kernel_def, KernelRegistry* reg) {
     auto info = onnxruntime::make_unique<OpKernelInfo>(*p_node, kernel_def, *execution_providers_.Get(*p_node),
                                                state_.GetInitializedTensors(), state_.GetOrtValueNameIdxMap(),
@@ -253,6 +267,12 @@ class PlannerTest : public ::testing::Test {
     EXPECT_EQ(plan_->allocation_plan[id].alloc_kind, kind) << "Error in allocation kind for " << name;
   }
 
+  void CheckStridedView(const std::string& name, bool is_strided_view) {
+    int id;
+    index(name, id);
+    EXPECT_EQ(plan_->allocation_plan[id].is_strided_view, is_strided_view) << "Error in strided view for " << name;
+  }
+
   void CheckFreed(int step_number, std::initializer_list<std::string> freed_items) {
     // create set and check equality
     std::unordered_set<int> expected;
@@ -415,6 +435,40 @@ TEST_F(PlannerTest, InPlaceSizeMismatchTest) {
   CheckFreed(3, {X2});
 }
 
+// StridedViewTest: Check that an output is planned as a strided view of the input buffer only if every consumer
+// can read strided views, and that the input buffer is not freed while the view is used.
+TEST_F(PlannerTest, StridedViewTest) {
+  // tensor variables:
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4"), X5("X5"), X6("X6");
+
+  // graph structure:
+  AddNormalNode(X1, X2);         // X2: temporary
+  AddStridedOutputNode(X2, X3);  // X3: view of X2, as its only consumer reads strided views
+  AddStridedInputNode(X3, X4);   // X4: temporary
+  AddStridedOutputNode(X4, X5);  // X5: dense, as its consumer does not read strided views
+  AddNormalNode(X5, X6);         // X6: output
+
+  // simulate shape-inference results:
+  Shape shape1{"M", "N"};
+  auto shape = &shape1.value;
+  SetShape({{X1, shape}, {X2, shape}, {X3, shape}, {X4, shape}, {X5, shape}, {X6, shape}});
+
+  CreatePlan();
+
+  // check allocation kind:
+  CheckAllocKind(X2, AllocKind::kAllocate);
+  CheckAllocKind(X3, AllocKind::kReuse);
+  CheckStridedView(X3, true);
+  CheckAllocKind(X4, AllocKind::kAllocate);
+  CheckStridedView(X5, false);
+  CheckAllocKind(X6, AllocKind::kAllocateOutput);
+
+  // X2 is freed once the view is no longer used
+  CheckFreed(0, {});
+  CheckFreed(1, {});
+  CheckFreed(2, {X2});
+}
+
 // Test operator<< to output details of an allocation & execution plan.
 TEST_F(PlannerTest, PlanOutputTest) {
   // tensor variables:
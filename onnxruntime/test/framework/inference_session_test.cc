@@ -9,6 +9,7 @@
 #include <iterator>
 #include <thread>
 #include <fstream>
+#include <sstream>
 
 #include <google/protobuf/io/zero_copy_stream_impl.h>
 #include "core/common/logging/logging.h"
@@ -588,6 +589,86 @@ TEST(InferenceSessionTests, CheckRunProfilerWithSessionOptions) {
   }
 }
 
+TEST(InferenceSessionTests, CheckRunOpStatistics) {
+  SessionOptions so;
+
+  so.session_logid = "CheckRunOpStatistics";
+  so.enable_op_statistics = true;
+  so.op_statistics_trace_sample_rate = 1;
+
+  InferenceSession session_object(so);
+  ASSERT_TRUE(session_object.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  RunOptions run_options;
+  run_options.run_tag = "RunTag";
+
+  RunModel(session_object, run_options);
+  RunModel(session_object, run_options);
+
+  std::string json;
+  ASSERT_STATUS_OK(session_object.GetOpStatistics(json, true));
+  EXPECT_NE(json.find("{\"op_type\":\"Mul\",\"node_count\":1,\"count\":2,"), string::npos) << json;
+  EXPECT_NE(json.find("\"dur_us\""), string::npos) << json;
+
+  // the statistics were reset by the previous call
+  ASSERT_STATUS_OK(session_object.GetOpStatistics(json));
+  EXPECT_EQ(json, "{\"nodes\":[],\"op_types\":[],\"trace\":[]}");
+}
+
+TEST(InferenceSessionTests, CheckOpStatisticsDisabledByDefault) {
+  SessionOptions so;
+
+  InferenceSession session_object(so);
+  ASSERT_TRUE(session_object.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  std::string json;
+  EXPECT_FALSE(session_object.GetOpStatistics(json).IsOK());
+}
+
+TEST(InferenceSessionTests, CheckRunMemoryStatistics) {
+  SessionOptions so;
+
+  so.session_logid = "CheckRunMemoryStatistics";
+  so.enable_memory_statistics = true;
+  so.enable_profiling = true;
+  so.profile_file_prefix = ORT_TSTR("onnxprofile_memory_test");
+
+  InferenceSession session_object(so);
+  ASSERT_TRUE(session_object.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  RunOptions run_options;
+  run_options.run_tag = "RunTag";
+
+  RunModel(session_object, run_options);
+  RunModel(session_object, run_options);
+
+  std::string json;
+  ASSERT_STATUS_OK(session_object.GetMemoryStatistics(json));
+  // the fetched output was released by RunModel
+  EXPECT_NE(json.find("{\"live_bytes\":0,\"peak_bytes\":64,"), string::npos) << json;
+  EXPECT_NE(json.find("\"peak_allocations\":[{\"name\":\"Y\","), string::npos) << json;
+  // Y is a 3x2 float tensor
+  EXPECT_NE(json.find("\"op_type\":\"Mul\",\"count\":2,\"output_bytes\":48,\"scratch_bytes\":0,"), string::npos)
+      << json;
+  // the timeline only covers the last run
+  EXPECT_NE(json.find("\"timeline\":[{\"name\":"), string::npos) << json;
+  EXPECT_EQ(json.find("\"live_before\"", json.find("\"live_before\"") + 1), string::npos) << json;
+
+  std::string profile_file = session_object.EndProfiling();
+  std::ifstream profile(profile_file);
+  ASSERT_TRUE(profile);
+  std::stringstream profile_contents;
+  profile_contents << profile.rdbuf();
+  EXPECT_NE(profile_contents.str().find("\"output_size\" : \"24\""), string::npos) << profile_contents.str();
+
+  ASSERT_STATUS_OK(session_object.GetMemoryStatistics(json, true));
+  ASSERT_STATUS_OK(session_object.GetMemoryStatistics(json));
+  EXPECT_EQ(json, "{\"live_bytes\":0,\"peak_bytes\":0,\"peak_node\":\"\",\"peak_allocations\":[],\"nodes\":[],\"timeline\":[]}");
+}
+
 TEST(InferenceSessionTests, CheckRunProfilerWithStartProfile) {
   SessionOptions so;
 
@@ -0,0 +1,281 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/graph/onnx_protobuf.h"
+
+#include "core/framework/sequential_execution_plan.h"
+#include "core/framework/session_state.h"
+#include "core/session/inference_session.h"
+#include "core/graph/model.h"
+#include "test/test_environment.h"
+#include "test/framework/test_utils.h"
+#include "test/compare_ortvalue.h"
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+// InferenceSession wrapper in order to gain access to the allocation plan.
+class StridedViewInferenceSession : public InferenceSession {
+ public:
+  explicit StridedViewInferenceSession(const SessionOptions& session_options,
+                                       logging::LoggingManager* logging_manager)
+      : InferenceSession(session_options, logging_manager) {
+  }
+
+  bool IsStridedView(const std::string& name) const {
+    int index;
+    if (!session_state_->GetOrtValueNameIdxMap().GetIdx(name, index).IsOK()) {
+      return false;
+    }
+    return session_state_->GetExecutionPlan()->allocation_plan[index].is_strided_view;
+  }
+};
+
+struct StridedViewTestHelper {
+  StridedViewTestHelper(Graph& graph) : graph_(graph), fill_value_(0) {
+  }
+
+  NodeArg* MakeInput(const std::vector<int64_t>& shape) {
+    ONNX_NAMESPACE::TypeProto type_proto;
+    type_proto.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+    for (auto& dim : shape) {
+      type_proto.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+    }
+
+    int64_t num_elements = std::accumulate(shape.begin(), shape.end(), int64_t(1), std::multiplies<int64_t>{});
+    OrtValue input_value;
+    CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), shape,
+                         FillData(static_cast<size_t>(num_elements)), &input_value);
+    std::string name = graph_.GenerateNodeArgName("input");
+    feeds_.insert(std::make_pair(name, input_value));
+
+    auto* arg = &graph_.GetOrCreateNodeArg(name, &type_proto);
+    inputs_.push_back(arg);
+    return arg;
+  }
+
+  NodeArg* MakeOutput() {
+    std::string name = graph_.GenerateNodeArgName("output");
+    output_names_.push_back(name);
+    auto* arg = &graph_.GetOrCreateNodeArg(name, nullptr);
+    outputs_.push_back(arg);
+    return arg;
+  }
+
+  // Makes a value passed between two nodes, which the planner is expected to produce as a strided view.
+  NodeArg* MakeView() {
+    std::string name = graph_.GenerateNodeArgName("view");
+    auto* arg = &graph_.GetOrCreateNodeArg(name, nullptr);
+    views_.push_back(arg);
+    return arg;
+  }
+
+  NodeArg* MakeInitializer(const std::vector<int64_t>& shape) {
+    std::string name = graph_.GenerateNodeArgName("constant");
+    ONNX_NAMESPACE::TensorProto tensor_proto;
+    tensor_proto.set_name(name);
+    tensor_proto.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+    for (auto& dim : shape) {
+      tensor_proto.add_dims(dim);
+    }
+
+    int64_t num_elements = std::accumulate(shape.begin(), shape.end(), int64_t(1), std::multiplies<int64_t>{});
+    for (float value : FillData(static_cast<size_t>(num_elements))) {
+      tensor_proto.add_float_data(value);
+    }
+    graph_.AddInitializedTensor(tensor_proto);
+
+    return &graph_.GetOrCreateNodeArg(name, nullptr);
+  }
+
+  NodeArg* MakeInt64Initializer(const std::vector<int64_t>& values) {
+    std::string name = graph_.GenerateNodeArgName("constant");
+    ONNX_NAMESPACE::TensorProto tensor_proto;
+    tensor_proto.set_name(name);
+    tensor_proto.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_INT64);
+    tensor_proto.add_dims(static_cast<int64_t>(values.size()));
+    for (auto value : values) {
+      tensor_proto.add_int64_data(value);
+    }
+    graph_.AddInitializedTensor(tensor_proto);
+
+    return &graph_.GetOrCreateNodeArg(name, nullptr);
+  }
+
+  Node& AddNode(const std::string& op_type,
+                const std::vector<NodeArg*>& input_args,
+                const std::vector<NodeArg*>& output_args) {
+    return graph_.AddNode(graph_.GenerateNodeName("node"),
+                          op_type,
+                          "description",
+                          input_args,
+                          output_args);
+  }
+
+  Node& AddSliceNode(NodeArg* input_arg, NodeArg* output_arg, const std::vector<int64_t>& starts,
+                     const std::vector<int64_t>& ends, const std::vector<int64_t>& axes,
+                     const std::vector<int64_t>& steps) {
+    return AddNode("Slice",
+                   {input_arg, MakeInt64Initializer(starts), MakeInt64Initializer(ends), MakeInt64Initializer(axes),
+                    MakeInt64Initializer(steps)},
+                   {output_arg});
+  }
+
+  // Small integers keep every sum exact, so the view and dense runs must match exactly whatever the order of
+  // the accumulation is.
+  std::vector<float> FillData(size_t count) {
+    constexpr int min_fill_value = -7;
+    constexpr int max_fill_value = 7;
+
+    std::vector<float> data(count);
+    for (size_t n = 0; n < count; n++) {
+      data[n] = static_cast<float>(fill_value_);
+      fill_value_++;
+      if (fill_value_ == max_fill_value) {
+        fill_value_ = min_fill_value;
+      }
+    }
+    return data;
+  }
+
+  Graph& graph_;
+  NameMLValMap feeds_;
+  std::vector<std::string> output_names_;
+  std::vector<const NodeArg*> inputs_;
+  std::vector<const NodeArg*> outputs_;
+  std::vector<const NodeArg*> views_;
+  int fill_value_;
+};
+
+// Runs the graph built by build_test_case twice: once as is, where the values made by MakeView must be planned
+// as strided views, and once with those values also made graph outputs, which forces them to be dense. The outputs
+// of the two runs must be identical.
+void StridedViewTester(const std::function<void(StridedViewTestHelper& helper)>& build_test_case) {
+  auto run_model = [&](bool dense, std::vector<OrtValue>& fetches) {
+    std::unordered_map<std::string, int> domain_to_version;
+    domain_to_version[kOnnxDomain] = 11;
+    Model model("strided_view", false, ModelMetaData(), IOnnxRuntimeOpSchemaRegistryList(), domain_to_version,
+                {}, DefaultLoggingManager().DefaultLogger());
+    StridedViewTestHelper helper(model.MainGraph());
+    build_test_case(helper);
+
+    std::vector<const NodeArg*> outputs = helper.outputs_;
+    if (dense) {
+      outputs.insert(outputs.end(), helper.views_.begin(), helper.views_.end());
+    }
+    model.MainGraph().SetInputs(helper.inputs_);
+    model.MainGraph().SetOutputs(outputs);
+    ASSERT_TRUE(model.MainGraph().Resolve().IsOK());
+
+    std::string model_data;
+    model.ToProto().SerializeToString(&model_data);
+
+    SessionOptions session_options;
+    session_options.graph_optimization_level = TransformerLevel::Default;
+    session_options.session_logid = "StridedViewTests";
+    StridedViewInferenceSession session{session_options, &DefaultLoggingManager()};
+    ASSERT_TRUE(session.Load(model_data.data(), static_cast<int>(model_data.size())).IsOK());
+    ASSERT_TRUE(session.Initialize().IsOK());
+
+    for (auto* view : helper.views_) {
+      EXPECT_EQ(session.IsStridedView(view->Name()), !dense) << view->Name();
+    }
+
+    RunOptions run_options;
+    auto status = session.Run(run_options, helper.feeds_, helper.output_names_, &fetches);
+    ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+  };
+
+  std::vector<OrtValue> view_fetches;
+  run_model(false, view_fetches);
+
+  std::vector<OrtValue> dense_fetches;
+  run_model(true, dense_fetches);
+
+  ASSERT_EQ(view_fetches.size(), dense_fetches.size());
+  for (size_t i = 0; i < view_fetches.size(); i++) {
+    std::pair<COMPARE_RESULT, std::string> ret = CompareOrtValue(view_fetches[i], dense_fetches[i], 0.0, 0.0, false);
+    EXPECT_EQ(ret.first, COMPARE_RESULT::SUCCESS) << ret.second;
+  }
+}
+
+// Rows and columns sliced from a batch of matrices are read by the GEMM in place through lda.
+TEST(StridedViewTests, SliceMatMul) {
+  auto build_test_case = [](StridedViewTestHelper& helper) {
+    auto* input_arg = helper.MakeInput({2, 10, 8});
+    auto* rows_arg = helper.MakeView();
+    auto* cols_arg = helper.MakeView();
+    helper.AddSliceNode(input_arg, rows_arg, {2}, {8}, {1}, {1});
+    helper.AddSliceNode(input_arg, cols_arg, {1}, {7}, {2}, {1});
+    helper.AddNode("MatMul", {rows_arg, helper.MakeInitializer({8, 5})}, {helper.MakeOutput()});
+    helper.AddNode("MatMul", {cols_arg, helper.MakeInitializer({6, 3})}, {helper.MakeOutput()});
+  };
+
+  StridedViewTester(build_test_case);
+}
+
+// Negative steps give negative strides, which the GEMM cannot read, so MatMul copies the view to a dense buffer.
+TEST(StridedViewTests, SliceNegativeStepMatMul) {
+  auto build_test_case = [](StridedViewTestHelper& helper) {
+    auto* input_arg = helper.MakeInput({3, 9, 4});
+    auto* slice_arg = helper.MakeView();
+    helper.AddSliceNode(input_arg, slice_arg, {8, 3}, {0, -10}, {1, 2}, {-2, -1});
+    helper.AddNode("MatMul", {slice_arg, helper.MakeInitializer({4, 6})}, {helper.MakeOutput()});
+  };
+
+  StridedViewTester(build_test_case);
+}
+
+// The attention layout change [B, S, H, D] -> [B, H, S, D] followed by Q x K^T: both operands of the MatMul are
+// transposed views, the left one read row-major and the right one read as transposed.
+TEST(StridedViewTests, TransposeMatMul) {
+  auto build_test_case = [](StridedViewTestHelper& helper) {
+    auto* query_arg = helper.MakeInput({2, 5, 3, 4});
+    auto* key_arg = helper.MakeInput({2, 5, 3, 4});
+    auto* query_view_arg = helper.MakeView();
+    auto* key_view_arg = helper.MakeView();
+    helper.AddNode("Transpose", {query_arg}, {query_view_arg})
+        .AddAttribute("perm", std::vector<int64_t>{0, 2, 1, 3});
+    helper.AddNode("Transpose", {key_arg}, {key_view_arg})
+        .AddAttribute("perm", std::vector<int64_t>{0, 2, 3, 1});
+    helper.AddNode("MatMul", {query_view_arg, key_view_arg}, {helper.MakeOutput()});
+  };
+
+  StridedViewTester(build_test_case);
+}
+
+// Splitting the leading axis gives contiguous views that Add reads in place. Splitting an inner axis gives views
+// that Add copies to dense buffers.
+TEST(StridedViewTests, SplitAdd) {
+  auto build_test_case = [](StridedViewTestHelper& helper) {
+    auto* outer_arg = helper.MakeInput({4, 3, 5});
+    auto* outer0_arg = helper.MakeView();
+    auto* outer1_arg = helper.MakeView();
+    helper.AddNode("Split", {outer_arg}, {outer0_arg, outer1_arg}).AddAttribute("axis", int64_t{0});
+    helper.AddNode("Add", {outer0_arg, outer1_arg}, {helper.MakeOutput()});
+
+    auto* inner_arg = helper.MakeInput({2, 6, 5});
+    auto* inner0_arg = helper.MakeView();
+    auto* inner1_arg = helper.MakeView();
+    helper.AddNode("Split", {inner_arg}, {inner0_arg, inner1_arg}).AddAttribute("axis", int64_t{1});
+    helper.AddNode("Add", {inner0_arg, inner1_arg}, {helper.MakeOutput()});
+  };
+
+  StridedViewTester(build_test_case);
+}
+
+// Expand repeats its input with zero strides on the broadcast dims.
+TEST(StridedViewTests, ExpandAdd) {
+  auto build_test_case = [](StridedViewTestHelper& helper) {
+    auto* input_arg = helper.MakeInput({3, 1});
+    auto* expand_arg = helper.MakeView();
+    helper.AddNode("Expand", {input_arg, helper.MakeInt64Initializer({2, 3, 4})}, {expand_arg});
+    helper.AddNode("Add", {expand_arg, helper.MakeInput({2, 3, 4})}, {helper.MakeOutput()});
+  };
+
+  StridedViewTester(build_test_case);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
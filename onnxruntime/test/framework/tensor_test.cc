@@ -3,6 +3,7 @@
 
 #include "core/framework/tensor.h"
 #include "core/framework/allocatormgr.h"
+#include "core/providers/cpu/tensor/utils.h"
 #include "test_utils.h"
 
 #include "gmock/gmock.h"
@@ -195,5 +196,45 @@ TEST(TensorTest, Int64PtrConstructor) {
   EXPECT_THAT(shape.GetDims(), testing::ElementsAre(2, 3));
 }
 
+TEST(TensorTest, StridedViewTest) {
+  std::vector<float> data(24);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<float>(i);
+  }
+  auto alloc = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+
+  Tensor dense(DataTypeImpl::GetType<float>(), TensorShape({2, 3, 4}), data.data(), alloc->Info());
+  EXPECT_TRUE(dense.IsContiguous());
+  EXPECT_THAT(dense.Strides(), testing::ElementsAre(12, 4, 1));
+
+  // view of [:, 1:3, ::2] transposed to {2, 2, 2} with the last two axes swapped
+  Tensor view(DataTypeImpl::GetType<float>(), TensorShape({2, 2, 2}), data.data(), alloc->Info());
+  std::vector<int64_t> strides{12, 2, 4};
+  view.SetStridedView(strides, 4 * sizeof(float));
+  EXPECT_FALSE(view.IsContiguous());
+  EXPECT_THAT(view.Strides(), testing::ElementsAre(12, 2, 4));
+  EXPECT_EQ(*view.Data<float>(), 4.f);
+
+  std::vector<float> copy(8);
+  CopyStridedCpuTensor(view, copy.data());
+  EXPECT_THAT(copy, testing::ElementsAre(4.f, 8.f, 6.f, 10.f, 16.f, 20.f, 18.f, 22.f));
+
+  // broadcast of the second row to {3, 4}
+  Tensor broadcast(DataTypeImpl::GetType<float>(), TensorShape({3, 4}), data.data(), alloc->Info());
+  std::vector<int64_t> broadcast_strides{0, 1};
+  broadcast.SetStridedView(broadcast_strides, 4 * sizeof(float));
+  EXPECT_FALSE(broadcast.IsContiguous());
+  std::vector<float> broadcast_copy(12);
+  CopyStridedCpuTensor(broadcast, broadcast_copy.data());
+  EXPECT_THAT(broadcast_copy, testing::ElementsAre(4.f, 5.f, 6.f, 7.f, 4.f, 5.f, 6.f, 7.f, 4.f, 5.f, 6.f, 7.f));
+
+  // a view of whole rows is contiguous, so kernels can read it in place
+  Tensor rows(DataTypeImpl::GetType<float>(), TensorShape({1, 3, 4}), data.data(), alloc->Info());
+  std::vector<int64_t> rows_strides{12, 4, 1};
+  rows.SetStridedView(rows_strides, 12 * sizeof(float));
+  EXPECT_TRUE(rows.IsContiguous());
+  EXPECT_EQ(*rows.Data<float>(), 12.f);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
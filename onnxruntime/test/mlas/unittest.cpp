@@ -17,8 +17,10 @@ Abstract:
 #include <stdio.h>
 #include <memory.h>
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <memory>
+#include <vector>
 #include <mlas.h>
 
 #if defined(_WIN32)
@@ -460,6 +462,330 @@ public:
     }
 };
 
+class MlasSgemmBatchTest : public MlasTestBase
+{
+private:
+    void
+    Test(
+        CBLAS_TRANSPOSE TransA,
+        CBLAS_TRANSPOSE TransB,
+        size_t BatchSize,
+        size_t M,
+        size_t N,
+        size_t K,
+        float alpha,
+        float beta,
+        bool BroadcastB
+        )
+    {
+        const size_t lda = (TransA == CblasNoTrans) ? K : M;
+        const size_t ldb = (TransB == CblasNoTrans) ? N : K;
+        const size_t StrideB = BroadcastB ? 0 : K * N;
+
+        const float* A = BufferA.GetBuffer(BatchSize * M * K);
+        const float* B = BufferB.GetBuffer(BroadcastB ? K * N : BatchSize * K * N);
+        float* C = BufferC.GetBuffer(BatchSize * M * N);
+        float* CReference = BufferCReference.GetBuffer(BatchSize * M * N);
+
+        std::fill_n(C, BatchSize * M * N, -0.5f);
+        std::fill_n(CReference, BatchSize * M * N, -0.5f);
+
+        for (size_t i = 0; i < BatchSize; i++) {
+            MlasGemm(TransA, TransB, M, N, K, alpha, A + i * M * K, lda, B + i * StrideB, ldb, beta,
+                CReference + i * M * N, N, nullptr);
+        }
+
+        //
+        // Test the strided variant.
+        //
+
+        MlasGemmBatch(TransA, TransB, M, N, K, alpha, A, lda, M * K, B, ldb, StrideB, beta,
+            C, N, M * N, BatchSize, threadpool);
+
+        Compare("strided", TransA, TransB, BatchSize, M, N, K, C, CReference);
+
+        //
+        // Test the pointer array variant. The batch entries are written in
+        // reverse order to verify that the output addresses are independent.
+        //
+
+        std::fill_n(C, BatchSize * M * N, -0.5f);
+
+        std::vector<MLAS_SGEMM_DATA_PARAMS> Data(BatchSize);
+
+        for (size_t i = 0; i < BatchSize; i++) {
+            const size_t j = BatchSize - i - 1;
+            Data[i].A = A + j * M * K;
+            Data[i].lda = lda;
+            Data[i].B = B + j * StrideB;
+            Data[i].ldb = ldb;
+            Data[i].C = C + j * M * N;
+            Data[i].ldc = N;
+        }
+
+        MlasGemmBatch(TransA, TransB, M, N, K, alpha, Data.data(), BatchSize, beta, threadpool);
+
+        Compare("array", TransA, TransB, BatchSize, M, N, K, C, CReference);
+    }
+
+    void
+    Compare(
+        const char* Variant,
+        CBLAS_TRANSPOSE TransA,
+        CBLAS_TRANSPOSE TransB,
+        size_t BatchSize,
+        size_t M,
+        size_t N,
+        size_t K,
+        const float* C,
+        const float* CReference
+        )
+    {
+        for (size_t f = 0; f < BatchSize * M * N; f++) {
+            if (C[f] != CReference[f]) {
+                printf("mismatch %s TransA=%d, TransB=%d, BatchSize=%zd, M=%zd, N=%zd, K=%zd  %f %f!\n", Variant, TransA, TransB, BatchSize, M, N, K, C[f], CReference[f]);
+                break;
+            }
+        }
+    }
+
+    void
+    Test(
+        size_t BatchSize,
+        size_t M,
+        size_t N,
+        size_t K,
+        float alpha,
+        float beta
+        )
+    {
+        for (int b = 0; b < 2; b++) {
+            Test(CblasNoTrans, CblasNoTrans, BatchSize, M, N, K, alpha, beta, b != 0);
+            Test(CblasNoTrans, CblasTrans, BatchSize, M, N, K, alpha, beta, b != 0);
+            Test(CblasTrans, CblasNoTrans, BatchSize, M, N, K, alpha, beta, b != 0);
+            Test(CblasTrans, CblasTrans, BatchSize, M, N, K, alpha, beta, b != 0);
+        }
+    }
+
+    MatrixGuardBuffer<float> BufferA;
+    MatrixGuardBuffer<float> BufferB;
+    MatrixGuardBuffer<float> BufferC;
+    MatrixGuardBuffer<float> BufferCReference;
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        static const size_t BatchSizes[] = { 1, 2, 3, 12, 96 };
+
+        for (size_t i = 0; i < _countof(BatchSizes); i++) {
+            Test(BatchSizes[i], 1, 1, 1, 1.0f, 0.0f);
+            Test(BatchSizes[i], 7, 9, 5, 1.0f, 0.0f);
+            Test(BatchSizes[i], 64, 64, 64, 1.0f, 0.0f);
+            Test(BatchSizes[i], 13, 130, 17, 0.5f, 1.0f);
+            Test(BatchSizes[i], 130, 13, 17, -1.0f, 0.25f);
+        }
+
+        Test(2, 256, 256, 256, 1.0f, 0.0f);
+    }
+
+    void
+    ExecuteLong(
+        void
+        ) override
+    {
+        static const float multipliers[] = { 0.0f, -0.0f, 0.25f, -0.5f, 1.0f, -1.0f };
+
+        for (size_t BatchSize = 1; BatchSize <= 33; BatchSize += 4) {
+            for (size_t M = 1; M < 80; M += 13) {
+                for (size_t N = 1; N < 80; N += 11) {
+                    for (size_t K = 1; K < 80; K += 17) {
+                        for (size_t a = 0; a < _countof(multipliers); a++) {
+                            Test(BatchSize, M, N, K, multipliers[a], multipliers[_countof(multipliers) - a - 1]);
+                        }
+                    }
+                }
+            }
+            printf("BatchSize %zd\n", BatchSize);
+        }
+    }
+};
+
+class MlasHalfGemmTest : public MlasTestBase
+{
+private:
+    void
+    Test(
+        MLAS_HALF_TYPE Type,
+        CBLAS_TRANSPOSE TransA,
+        CBLAS_TRANSPOSE TransB,
+        size_t M,
+        size_t N,
+        size_t K,
+        float alpha,
+        float beta
+        )
+    {
+        const size_t lda = (TransA == CblasNoTrans) ? K : M;
+        const size_t ldb = (TransB == CblasNoTrans) ? N : K;
+
+        //
+        // The fill values are small integers that are exact in both half
+        // precision formats, so the results must match the SGEMM results.
+        //
+
+        const float* A = BufferA.GetBuffer(M * K);
+        const float* B = BufferB.GetBuffer(K * N);
+        unsigned short* AHalf = BufferAHalf.GetBuffer(M * K);
+        unsigned short* BHalf = BufferBHalf.GetBuffer(K * N);
+        float* C = BufferC.GetBuffer(M * N);
+        float* CReference = BufferCReference.GetBuffer(M * N);
+
+        MlasConvertFloatToHalf(Type, A, AHalf, M * K);
+        MlasConvertFloatToHalf(Type, B, BHalf, K * N);
+
+        std::fill_n(C, M * N, -0.5f);
+        std::fill_n(CReference, M * N, -0.5f);
+
+        MlasGemm(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, CReference, N, nullptr);
+        MlasHalfGemm(Type, TransA, TransB, M, N, K, alpha, AHalf, lda, BHalf, ldb, beta, C, N, threadpool);
+
+        for (size_t f = 0; f < M * N; f++) {
+            if (C[f] != CReference[f]) {
+                printf("mismatch Type=%d, TransA=%d, TransB=%d, M=%zd, N=%zd, K=%zd  %f %f!\n", Type, TransA, TransB, M, N, K, C[f], CReference[f]);
+                break;
+            }
+        }
+    }
+
+    void
+    Test(
+        size_t M,
+        size_t N,
+        size_t K,
+        float alpha,
+        float beta
+        )
+    {
+        for (MLAS_HALF_TYPE Type : { MlasHalfFloat16, MlasHalfBFloat16 }) {
+            Test(Type, CblasNoTrans, CblasNoTrans, M, N, K, alpha, beta);
+            Test(Type, CblasNoTrans, CblasTrans, M, N, K, alpha, beta);
+            Test(Type, CblasTrans, CblasNoTrans, M, N, K, alpha, beta);
+            Test(Type, CblasTrans, CblasTrans, M, N, K, alpha, beta);
+        }
+    }
+
+    void
+    TestConversion(
+        void
+        )
+    {
+        //
+        // Every half precision value that is not a NaN must survive a round
+        // trip through single precision.
+        //
+
+        std::vector<unsigned short> Source(65536);
+        std::vector<unsigned short> Destination(65536);
+        std::vector<float> Values(65536);
+
+        for (size_t i = 0; i < Source.size(); i++) {
+            Source[i] = static_cast<unsigned short>(i);
+        }
+
+        for (MLAS_HALF_TYPE Type : { MlasHalfFloat16, MlasHalfBFloat16 }) {
+
+            const unsigned short ExponentMask = (Type == MlasHalfFloat16) ? 0x7C00 : 0x7F80;
+
+            MlasConvertHalfToFloat(Type, Source.data(), Values.data(), Values.size());
+            MlasConvertFloatToHalf(Type, Values.data(), Destination.data(), Values.size());
+
+            for (size_t i = 0; i < Source.size(); i++) {
+                bool IsNaN = (Source[i] & ExponentMask) == ExponentMask && (Source[i] & ~(ExponentMask | 0x8000)) != 0;
+                if (IsNaN ? (Destination[i] & ExponentMask) != ExponentMask : Destination[i] != Source[i]) {
+                    printf("mismatch Type=%d round trip %04zx %04x!\n", Type, i, Destination[i]);
+                    break;
+                }
+            }
+        }
+
+        //
+        // Values between two representable values round to nearest even.
+        //
+
+        const float Ties[] = { 1.0f + 1.0f / 2048.0f, 1.0f + 3.0f / 2048.0f, 65520.0f };
+        const unsigned short ExpectedFloat16[] = { 0x3C00, 0x3C02, 0x7C00 };
+        unsigned short Rounded[_countof(Ties)];
+
+        MlasConvertFloatToHalf(MlasHalfFloat16, Ties, Rounded, _countof(Ties));
+
+        for (size_t i = 0; i < _countof(Ties); i++) {
+            if (Rounded[i] != ExpectedFloat16[i]) {
+                printf("mismatch float16 rounding %f %04x %04x!\n", Ties[i], Rounded[i], ExpectedFloat16[i]);
+            }
+        }
+
+        const float BFloat16Ties[] = { 1.0f + 1.0f / 256.0f, 1.0f + 3.0f / 256.0f };
+        const unsigned short ExpectedBFloat16[] = { 0x3F80, 0x3F82 };
+
+        MlasConvertFloatToHalf(MlasHalfBFloat16, BFloat16Ties, Rounded, _countof(BFloat16Ties));
+
+        for (size_t i = 0; i < _countof(BFloat16Ties); i++) {
+            if (Rounded[i] != ExpectedBFloat16[i]) {
+                printf("mismatch bfloat16 rounding %f %04x %04x!\n", BFloat16Ties[i], Rounded[i], ExpectedBFloat16[i]);
+            }
+        }
+    }
+
+    MatrixGuardBuffer<float> BufferA;
+    MatrixGuardBuffer<float> BufferB;
+    MatrixGuardBuffer<unsigned short> BufferAHalf;
+    MatrixGuardBuffer<unsigned short> BufferBHalf;
+    MatrixGuardBuffer<float> BufferC;
+    MatrixGuardBuffer<float> BufferCReference;
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        TestConversion();
+
+        for (size_t b = 1; b < 16; b++) {
+            Test(b, b, b, 1.0f, 0.0f);
+        }
+
+        Test(1, 1024, 300, 1.0f, 0.0f);
+        Test(1, 7, 1031, 1.0f, 1.0f);
+        Test(13, 130, 17, 0.5f, 1.0f);
+        Test(130, 13, 17, -1.0f, 0.25f);
+        Test(64, 200, 257, 1.0f, 0.0f);
+        Test(256, 256, 256, 1.0f, 0.0f);
+    }
+
+    void
+    ExecuteLong(
+        void
+        ) override
+    {
+        static const float multipliers[] = { 0.0f, -0.0f, 0.25f, -0.5f, 1.0f, -1.0f };
+
+        for (size_t M = 1; M < 160; M += 13) {
+            for (size_t N = 1; N < 160; N += 11) {
+                for (size_t K = 1; K < 300; K += 29) {
+                    for (size_t a = 0; a < _countof(multipliers); a++) {
+                        Test(M, N, K, multipliers[a], multipliers[_countof(multipliers) - a - 1]);
+                    }
+                }
+            }
+            printf("M %zd\n", M);
+        }
+    }
+};
+
 #ifdef MLAS_HAS_QGEMM_U8X8
 
 template <typename xint8_t>
@@ -1972,6 +2298,303 @@ public:
     }
 };
 
+class MlasLayerNormTest : public MlasTestBase
+{
+private:
+    MatrixGuardBuffer<float> BufferInput;
+    MatrixGuardBuffer<float> BufferSkip;
+    MatrixGuardBuffer<float> BufferBias;
+    MatrixGuardBuffer<float> BufferGamma;
+    MatrixGuardBuffer<float> BufferBeta;
+    MatrixGuardBuffer<float> BufferOutput;
+    MatrixGuardBuffer<float> BufferOutputReference;
+
+    void
+    ReferenceLayerNorm(
+        const float* Input,
+        const float* Skip,
+        const float* Bias,
+        const float* Gamma,
+        const float* Beta,
+        float* Output,
+        size_t N,
+        float Epsilon
+        )
+    {
+        std::vector<double> Row(N);
+
+        double Mean = 0.0;
+
+        for (size_t n = 0; n < N; n++) {
+            Row[n] = double(Input[n]);
+            if (Skip != nullptr) {
+                Row[n] += double(Skip[n]);
+                if (Bias != nullptr) {
+                    Row[n] += double(Bias[n]);
+                }
+            }
+            Mean += Row[n];
+        }
+
+        Mean /= double(N);
+
+        double Variance = 0.0;
+
+        for (size_t n = 0; n < N; n++) {
+            Variance += (Row[n] - Mean) * (Row[n] - Mean);
+        }
+
+        Variance /= double(N);
+
+        double InvStdDev = 1.0 / std::sqrt(Variance + double(Epsilon));
+
+        for (size_t n = 0; n < N; n++) {
+            Output[n] = float((Row[n] - Mean) * InvStdDev * double(Gamma[n]) + double(Beta[n]));
+        }
+    }
+
+    void
+    Test(
+        size_t N
+        )
+    {
+        const float* Input = BufferInput.GetBuffer(N);
+        const float* Skip = BufferSkip.GetBuffer(N);
+        const float* Bias = BufferBias.GetBuffer(N);
+        float* Gamma = BufferGamma.GetBuffer(N);
+        float* Beta = BufferBeta.GetBuffer(N);
+        float* Output = BufferOutput.GetBuffer(N);
+        float* OutputReference = BufferOutputReference.GetBuffer(N);
+
+        for (size_t n = 0; n < N; n++) {
+            Gamma[n] = 0.5f + float(n % 7) * 0.25f;
+            Beta[n] = float(int(n % 5) - 2) * 0.125f;
+        }
+
+        for (unsigned mode = 0; mode < 3; mode++) {
+
+            const float* ModeSkip = (mode >= 1) ? Skip : nullptr;
+            const float* ModeBias = (mode == 2) ? Bias : nullptr;
+
+            MlasComputeLayerNorm(Input, ModeSkip, ModeBias, Gamma, Beta, Output, N, 1e-5f, nullptr, nullptr);
+            ReferenceLayerNorm(Input, ModeSkip, ModeBias, Gamma, Beta, OutputReference, N, 1e-5f);
+
+            for (size_t n = 0; n < N; n++) {
+                if (std::fabs(Output[n] - OutputReference[n]) > 1e-4f * (1.0f + std::fabs(OutputReference[n]))) {
+                    printf("mismatch layernorm mode=%u N=%zd n=%zd value=%f expected=%f\n", mode, N, n, Output[n], OutputReference[n]);
+                    break;
+                }
+            }
+        }
+    }
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        for (size_t n = 1; n < 128; n++) {
+            Test(n);
+        }
+
+        Test(768);
+        Test(1024);
+        Test(4099);
+    }
+
+    void
+    ExecuteLong(
+        void
+        ) override
+    {
+    }
+};
+
+class MlasBiasGeluTest : public MlasTestBase
+{
+private:
+    MatrixGuardBuffer<float> BufferInput;
+    MatrixGuardBuffer<float> BufferBias;
+    MatrixGuardBuffer<float> BufferOutput;
+
+    void
+    Test(
+        MLAS_GELU_ALGORITHM Algorithm,
+        size_t N,
+        bool HasBias
+        )
+    {
+        float* Input = BufferInput.GetBuffer(N);
+        float* Bias = HasBias ? BufferBias.GetBuffer(N) : nullptr;
+        float* Output = BufferOutput.GetBuffer(N);
+
+        for (size_t n = 0; n < N; n++) {
+            Input[n] = float(int(n % 97) - 48) * 0.0625f;
+            if (HasBias) {
+                Bias[n] = float(int(n % 13) - 6) * 0.03125f;
+            }
+        }
+
+        MlasComputeBiasGelu(Algorithm, Input, Bias, Output, N);
+
+        for (size_t n = 0; n < N; n++) {
+
+            double x = double(Input[n]) + (HasBias ? double(Bias[n]) : 0.0);
+            double Expected;
+
+            if (Algorithm == MlasGeluErf) {
+                Expected = 0.5 * x * (1.0 + std::erf(x * 0.70710678118654752));
+            } else {
+                Expected = 0.5 * x * (1.0 + std::tanh(0.79788456080286536 * (x + 0.044715 * x * x * x)));
+            }
+
+            if (std::fabs(Output[n] - Expected) > 1e-5 * (1.0 + std::fabs(Expected))) {
+                printf("mismatch gelu algorithm=%d N=%zd n=%zd value=%f expected=%f\n", int(Algorithm), N, n, Output[n], Expected);
+                break;
+            }
+        }
+    }
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        for (size_t n = 1; n < 64; n++) {
+            Test(MlasGeluErf, n, false);
+            Test(MlasGeluErf, n, true);
+            Test(MlasGeluTanh, n, true);
+        }
+
+        Test(MlasGeluErf, 3072, true);
+        Test(MlasGeluTanh, 3073, false);
+    }
+
+    void
+    ExecuteLong(
+        void
+        ) override
+    {
+    }
+};
+
+class MlasExpTest : public MlasTestBase
+{
+private:
+    MatrixGuardBuffer<float> BufferInput;
+    MatrixGuardBuffer<float> BufferOutput;
+
+    void
+    Test(
+        size_t N,
+        float MinimumValue,
+        float MaximumValue
+        )
+    {
+        float* Input = BufferInput.GetBuffer(N);
+        float* Output = BufferOutput.GetBuffer(N);
+
+        for (size_t n = 0; n < N; n++) {
+            Input[n] = MinimumValue + (MaximumValue - MinimumValue) * float(n) / float(N);
+        }
+
+        MlasComputeExp(Input, Output, N);
+
+        for (size_t n = 0; n < N; n++) {
+
+            double Expected = std::exp(double(Input[n]));
+
+            if (std::fabs(Output[n] - Expected) > 1e-6 * Expected + 1e-37) {
+                printf("mismatch exp N=%zd n=%zd input=%f value=%g expected=%g\n", N, n, Input[n], Output[n], Expected);
+                break;
+            }
+        }
+    }
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        for (size_t n = 1; n < 32; n++) {
+            Test(n, -10.0f, 10.0f);
+        }
+
+        Test(10007, -100.0f, 88.0f);
+    }
+
+    void
+    ExecuteLong(
+        void
+        ) override
+    {
+    }
+};
+
+template<typename ElementType>
+class MlasTransposeTest : public MlasTestBase
+{
+private:
+    MatrixGuardBuffer<ElementType> BufferInput;
+    MatrixGuardBuffer<ElementType> BufferOutput;
+
+    void
+    Test(
+        size_t M,
+        size_t N,
+        size_t ldInput,
+        size_t ldOutput
+        )
+    {
+        ElementType* Input = BufferInput.GetBuffer((M - 1) * ldInput + N);
+        ElementType* Output = BufferOutput.GetBuffer((N - 1) * ldOutput + M);
+
+        for (size_t i = 0; i < (M - 1) * ldInput + N; i++) {
+            Input[i] = ElementType(i * 2654435761u);
+        }
+
+        std::fill_n(Output, (N - 1) * ldOutput + M, ElementType(0));
+
+        MlasTranspose(Input, Output, M, N, ldInput, ldOutput);
+
+        for (size_t m = 0; m < M; m++) {
+            for (size_t n = 0; n < N; n++) {
+                if (Output[n * ldOutput + m] != Input[m * ldInput + n]) {
+                    printf("mismatch transpose size=%zd M=%zd N=%zd m=%zd n=%zd!\n", sizeof(ElementType), M, N, m, n);
+                    return;
+                }
+            }
+        }
+    }
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        for (size_t m = 1; m <= 19; m++) {
+            for (size_t n = 1; n <= 19; n++) {
+                Test(m, n, n, m);
+                Test(m, n, n + 5, m + 3);
+            }
+        }
+
+        Test(64, 64, 64, 64);
+        Test(61, 67, 129, 77);
+    }
+
+    void
+    ExecuteLong(
+        void
+        ) override
+    {
+    }
+};
+
 int
 #if defined(_WIN32)
 __cdecl
@@ -1984,6 +2607,10 @@ main(
 
         printf("SGEMM tests.\n");
         onnxruntime::make_unique<MlasFgemmTest<float>>()->ExecuteShort();
+        printf("SGEMM batch tests.\n");
+        onnxruntime::make_unique<MlasSgemmBatchTest>()->ExecuteShort();
+        printf("Half precision GEMM tests.\n");
+        onnxruntime::make_unique<MlasHalfGemmTest>()->ExecuteShort();
 #ifdef MLAS_HAS_DGEMM
         printf("DGEMM tests.\n");
         onnxruntime::make_unique<MlasFgemmTest<double>>()->ExecuteShort();
@@ -2013,6 +2640,21 @@ main(
         printf("Activation tests.\n");
         onnxruntime::make_unique<MlasActivationTest>()->ExecuteShort();
 
+        printf("LayerNorm tests.\n");
+        onnxruntime::make_unique<MlasLayerNormTest>()->ExecuteShort();
+
+        printf("BiasGelu tests.\n");
+        onnxruntime::make_unique<MlasBiasGeluTest>()->ExecuteShort();
+
+        printf("Exp tests.\n");
+        onnxruntime::make_unique<MlasExpTest>()->ExecuteShort();
+
+        printf("Transpose tests.\n");
+        onnxruntime::make_unique<MlasTransposeTest<uint8_t>>()->ExecuteShort();
+        onnxruntime::make_unique<MlasTransposeTest<uint16_t>>()->ExecuteShort();
+        onnxruntime::make_unique<MlasTransposeTest<uint32_t>>()->ExecuteShort();
+        onnxruntime::make_unique<MlasTransposeTest<uint64_t>>()->ExecuteShort();
+
         printf("Done.\n");
 #if !defined(MLAS_NO_ONNXRUNTIME_THREADPOOL)
         if(threadpool != nullptr) threadpool = new onnxruntime::concurrency::ThreadPool("test", 2);
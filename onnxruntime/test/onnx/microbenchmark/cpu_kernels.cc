@@ -0,0 +1,518 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// Per-kernel benchmarks for the CPU execution provider. Each benchmark builds a model containing a single node,
+// loads it into a session with graph optimizations disabled so the node runs exactly as declared, and times
+// Session::Run. The shapes are taken from BERT-base (sequence length 128), ResNet-50, MobileNet-v2 and a typical
+// gradient boosted tree model.
+
+#include <benchmark/benchmark.h>
+#include <core/graph/onnx_protobuf.h>
+#include <core/session/onnxruntime_cxx_api.h>
+#include <random>
+#include <string>
+#include <vector>
+
+extern OrtEnv* env;
+
+namespace {
+
+class KernelBenchmark {
+ public:
+  explicit KernelBenchmark(const char* op_type, const char* domain = "") {
+    model_.set_ir_version(ONNX_NAMESPACE::IR_VERSION);
+    AddOpset("", 11);
+    AddOpset("com.microsoft", 1);
+    AddOpset("ai.onnx.ml", 1);
+    node_ = model_.mutable_graph()->add_node();
+    node_->set_op_type(op_type);
+    node_->set_domain(domain);
+  }
+
+  // Adds a graph input that is fed on every run. Integer inputs are filled with values in [0, max_value).
+  KernelBenchmark& Input(const std::vector<int64_t>& shape,
+                         ONNXTensorElementDataType type = ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT,
+                         int64_t max_value = 0) {
+    const std::string name = NextInputName();
+    auto* value_info = model_.mutable_graph()->add_input();
+    value_info->set_name(name);
+    auto* tensor_type = value_info->mutable_type()->mutable_tensor_type();
+    tensor_type->set_elem_type(type);
+    for (int64_t dim : shape) {
+      tensor_type->mutable_shape()->add_dim()->set_dim_value(dim);
+    }
+    inputs_.push_back({name, shape, type, max_value});
+    return *this;
+  }
+
+  // Adds a constant input such as a weight or bias.
+  KernelBenchmark& Initializer(const std::vector<int64_t>& shape) {
+    auto* tensor = model_.mutable_graph()->add_initializer();
+    tensor->set_name(NextInputName());
+    tensor->set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+    size_t size = 1;
+    for (int64_t dim : shape) {
+      tensor->add_dims(dim);
+      size *= static_cast<size_t>(dim);
+    }
+    std::vector<float> data(size);
+    FillRandom(data.data(), size, 0);
+    tensor->set_raw_data(data.data(), size * sizeof(float));
+    return *this;
+  }
+
+  KernelBenchmark& Attribute(const char* name, int64_t value) {
+    auto* attribute = AddAttribute(name, ONNX_NAMESPACE::AttributeProto_AttributeType_INT);
+    attribute->set_i(value);
+    return *this;
+  }
+
+  KernelBenchmark& Attribute(const char* name, float value) {
+    auto* attribute = AddAttribute(name, ONNX_NAMESPACE::AttributeProto_AttributeType_FLOAT);
+    attribute->set_f(value);
+    return *this;
+  }
+
+  KernelBenchmark& Attribute(const char* name, const std::string& value) {
+    auto* attribute = AddAttribute(name, ONNX_NAMESPACE::AttributeProto_AttributeType_STRING);
+    attribute->set_s(value);
+    return *this;
+  }
+
+  KernelBenchmark& Attribute(const char* name, const std::vector<int64_t>& values) {
+    auto* attribute = AddAttribute(name, ONNX_NAMESPACE::AttributeProto_AttributeType_INTS);
+    for (int64_t value : values) {
+      attribute->add_ints(value);
+    }
+    return *this;
+  }
+
+  KernelBenchmark& Attribute(const char* name, const std::vector<float>& values) {
+    auto* attribute = AddAttribute(name, ONNX_NAMESPACE::AttributeProto_AttributeType_FLOATS);
+    for (float value : values) {
+      attribute->add_floats(value);
+    }
+    return *this;
+  }
+
+  KernelBenchmark& Attribute(const char* name, const std::vector<std::string>& values) {
+    auto* attribute = AddAttribute(name, ONNX_NAMESPACE::AttributeProto_AttributeType_STRINGS);
+    for (const auto& value : values) {
+      attribute->add_strings(value);
+    }
+    return *this;
+  }
+
+  // Creates the session and times the node with the given number of intra op threads.
+  void Run(benchmark::State& state, int threads) {
+    const std::string output_name = "Y";
+    node_->add_output(output_name);
+    auto* output = model_.mutable_graph()->add_output();
+    output->set_name(output_name);
+    output->mutable_type()->mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+
+    std::string model_data;
+    model_.SerializeToString(&model_data);
+
+    Ort::SessionOptions session_options;
+    session_options.SetIntraOpNumThreads(threads);
+    session_options.SetGraphOptimizationLevel(ORT_DISABLE_ALL);
+    Ort::Unowned<Ort::Env> ort_env{env};
+    Ort::Session session(ort_env, model_data.data(), model_data.size(), session_options);
+
+    Ort::AllocatorWithDefaultOptions allocator;
+    std::vector<Ort::Value> input_values;
+    std::vector<const char*> input_names;
+    for (const auto& input : inputs_) {
+      input_values.push_back(Ort::Value::CreateTensor(allocator, input.shape.data(), input.shape.size(), input.type));
+      size_t size = 1;
+      for (int64_t dim : input.shape) {
+        size *= static_cast<size_t>(dim);
+      }
+      switch (input.type) {
+        case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
+          FillRandom(input_values.back().GetTensorMutableData<float>(), size, input.max_value);
+          break;
+        case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
+          FillRandom(input_values.back().GetTensorMutableData<int32_t>(), size, input.max_value);
+          break;
+        case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
+          FillRandom(input_values.back().GetTensorMutableData<int64_t>(), size, input.max_value);
+          break;
+        default:
+          state.SkipWithError("unsupported input type");
+          return;
+      }
+      input_names.push_back(input.name.c_str());
+    }
+
+    const char* output_names[] = {output_name.c_str()};
+    Ort::RunOptions run_options;
+    for (auto _ : state) {
+      auto outputs = session.Run(run_options, input_names.data(), input_values.data(), input_values.size(),
+                                 output_names, 1);
+      benchmark::DoNotOptimize(outputs);
+    }
+  }
+
+ private:
+  struct InputInfo {
+    std::string name;
+    std::vector<int64_t> shape;
+    ONNXTensorElementDataType type;
+    int64_t max_value;
+  };
+
+  void AddOpset(const char* domain, int64_t version) {
+    auto* opset = model_.add_opset_import();
+    opset->set_domain(domain);
+    opset->set_version(version);
+  }
+
+  std::string NextInputName() {
+    std::string name = "X" + std::to_string(node_->input_size());
+    node_->add_input(name);
+    return name;
+  }
+
+  ONNX_NAMESPACE::AttributeProto* AddAttribute(const char* name, ONNX_NAMESPACE::AttributeProto_AttributeType type) {
+    auto* attribute = node_->add_attribute();
+    attribute->set_name(name);
+    attribute->set_type(type);
+    return attribute;
+  }
+
+  template <typename T>
+  void FillRandom(T* data, size_t size, int64_t max_value) {
+    std::uniform_real_distribution<double> distribution(max_value > 0 ? 0.0 : -1.0,
+                                                        max_value > 0 ? static_cast<double>(max_value) : 1.0);
+    for (size_t i = 0; i < size; i++) {
+      data[i] = static_cast<T>(distribution(generator_));
+    }
+  }
+
+  ONNX_NAMESPACE::ModelProto model_;
+  ONNX_NAMESPACE::NodeProto* node_;
+  std::vector<InputInfo> inputs_;
+  std::mt19937 generator_{1234};
+};
+
+void ThreadCounts(benchmark::internal::Benchmark* b, const std::vector<std::vector<int64_t>>& shapes) {
+  for (int64_t threads : {1, 4}) {
+    for (auto args : shapes) {
+      args.push_back(threads);
+      b->Args(args);
+    }
+  }
+  b->UseRealTime();
+}
+
+}  // namespace
+
+// input channels, height, width, filters, kernel, stride, groups, threads
+static void BM_Conv(benchmark::State& state) {
+  const int64_t channels = state.range(0);
+  const int64_t filters = state.range(3);
+  const int64_t kernel = state.range(4);
+  const int64_t group = state.range(6);
+  const int64_t pad = kernel / 2;
+  KernelBenchmark("Conv")
+      .Input({1, channels, state.range(1), state.range(2)})
+      .Initializer({filters, channels / group, kernel, kernel})
+      .Initializer({filters})
+      .Attribute("kernel_shape", std::vector<int64_t>{kernel, kernel})
+      .Attribute("pads", std::vector<int64_t>{pad, pad, pad, pad})
+      .Attribute("strides", std::vector<int64_t>{state.range(5), state.range(5)})
+      .Attribute("group", group)
+      .Run(state, static_cast<int>(state.range(7)));
+}
+
+BENCHMARK(BM_Conv)
+    ->ArgNames({"C", "H", "W", "F", "kernel", "stride", "groups", "threads"})
+    ->Apply([](benchmark::internal::Benchmark* b) {
+      ThreadCounts(b, {
+                          // ResNet-50
+                          {3, 224, 224, 64, 7, 2, 1},
+                          {64, 56, 56, 64, 3, 1, 1},
+                          {64, 56, 56, 256, 1, 1, 1},
+                          {256, 14, 14, 256, 3, 1, 1},
+                          {512, 7, 7, 2048, 1, 1, 1},
+                          // MobileNet-v2 depthwise
+                          {144, 56, 56, 144, 3, 1, 144},
+                          {384, 14, 14, 384, 3, 1, 384},
+                      });
+    });
+
+// BERT-base projections with a constant weight: [1, S, K] x [K, N].
+static void BM_MatMul(benchmark::State& state) {
+  KernelBenchmark("MatMul")
+      .Input({1, state.range(0), state.range(2)})
+      .Initializer({state.range(2), state.range(1)})
+      .Run(state, static_cast<int>(state.range(3)));
+}
+
+BENCHMARK(BM_MatMul)
+    ->ArgNames({"M", "N", "K", "threads"})
+    ->Apply([](benchmark::internal::Benchmark* b) {
+      ThreadCounts(b, {{128, 768, 768}, {128, 3072, 768}, {128, 768, 3072}});
+    });
+
+// BERT-base attention scores: [1, heads, S, head_size] x [1, heads, head_size, S].
+static void BM_MatMul_Batch(benchmark::State& state) {
+  const int64_t heads = state.range(0);
+  const int64_t sequence = state.range(1);
+  const int64_t head_size = state.range(2);
+  KernelBenchmark("MatMul")
+      .Input({1, heads, sequence, head_size})
+      .Input({1, heads, head_size, sequence})
+      .Run(state, static_cast<int>(state.range(3)));
+}
+
+BENCHMARK(BM_MatMul_Batch)
+    ->ArgNames({"heads", "S", "head_size", "threads"})
+    ->Apply([](benchmark::internal::Benchmark* b) {
+      ThreadCounts(b, {{12, 128, 64}, {12, 384, 64}});
+    });
+
+// Fully connected classifier: [batch, K] x [N, K]^T + bias.
+static void BM_Gemm(benchmark::State& state) {
+  KernelBenchmark("Gemm")
+      .Input({state.range(0), state.range(2)})
+      .Initializer({state.range(1), state.range(2)})
+      .Initializer({state.range(1)})
+      .Attribute("transB", int64_t{1})
+      .Run(state, static_cast<int>(state.range(3)));
+}
+
+BENCHMARK(BM_Gemm)
+    ->ArgNames({"M", "N", "K", "threads"})
+    ->Apply([](benchmark::internal::Benchmark* b) {
+      ThreadCounts(b, {{1, 1000, 2048}, {32, 1000, 2048}, {128, 768, 768}});
+    });
+
+// Attention probabilities [1, heads, S, S] when batch is 0, otherwise classifier outputs [batch, N].
+static void BM_Softmax(benchmark::State& state) {
+  const std::vector<int64_t> shape = state.range(0) == 0
+                                         ? std::vector<int64_t>{1, 12, state.range(1), state.range(1)}
+                                         : std::vector<int64_t>{state.range(0), state.range(1)};
+  KernelBenchmark("Softmax")
+      .Input(shape)
+      .Attribute("axis", static_cast<int64_t>(shape.size() - 1))
+      .Run(state, static_cast<int>(state.range(2)));
+}
+
+BENCHMARK(BM_Softmax)
+    ->ArgNames({"batch", "N", "threads"})
+    ->Apply([](benchmark::internal::Benchmark* b) {
+      ThreadCounts(b, {{0, 128}, {0, 384}, {32, 1000}});
+    });
+
+static void BM_LayerNormalization(benchmark::State& state) {
+  const int64_t hidden_size = state.range(1);
+  KernelBenchmark("LayerNormalization")
+      .Input({1, state.range(0), hidden_size})
+      .Initializer({hidden_size})
+      .Initializer({hidden_size})
+      .Attribute("axis", int64_t{-1})
+      .Attribute("epsilon", 1e-12f)
+      .Run(state, static_cast<int>(state.range(2)));
+}
+
+BENCHMARK(BM_LayerNormalization)
+    ->ArgNames({"S", "hidden", "threads"})
+    ->Apply([](benchmark::internal::Benchmark* b) {
+      ThreadCounts(b, {{128, 768}, {384, 1024}});
+    });
+
+static void BM_Attention(benchmark::State& state) {
+  const int64_t batch = state.range(0);
+  const int64_t sequence = state.range(1);
+  const int64_t hidden_size = state.range(2);
+  KernelBenchmark("Attention", "com.microsoft")
+      .Input({batch, sequence, hidden_size})
+      .Initializer({hidden_size, 3 * hidden_size})
+      .Initializer({3 * hidden_size})
+      .Input({batch}, ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32, sequence)
+      .Attribute("num_heads", hidden_size / 64)
+      .Run(state, static_cast<int>(state.range(3)));
+}
+
+BENCHMARK(BM_Attention)
+    ->ArgNames({"batch", "S", "hidden", "threads"})
+    ->Apply([](benchmark::internal::Benchmark* b) {
+      ThreadCounts(b, {{1, 128, 768}, {8, 128, 768}, {1, 384, 1024}});
+    });
+
+// Reductions over the hidden dimension, global pooling over the image and over the rows of a matrix.
+template <const char* OpType>
+static void BM_Reduce(benchmark::State& state) {
+  std::vector<int64_t> shape;
+  std::vector<int64_t> axes;
+  switch (state.range(0)) {
+    case 0:
+      shape = {1, 128, 768};
+      axes = {2};
+      break;
+    case 1:
+      shape = {1, 2048, 7, 7};
+      axes = {2, 3};
+      break;
+    default:
+      shape = {1024, 1024};
+      axes = {0};
+      break;
+  }
+  KernelBenchmark(OpType)
+      .Input(shape)
+      .Attribute("axes", axes)
+      .Attribute("keepdims", int64_t{1})
+      .Run(state, static_cast<int>(state.range(1)));
+}
+
+constexpr char kReduceSum[] = "ReduceSum";
+constexpr char kReduceMean[] = "ReduceMean";
+constexpr char kReduceMax[] = "ReduceMax";
+
+BENCHMARK_TEMPLATE(BM_Reduce, kReduceSum)
+    ->ArgNames({"case", "threads"})
+    ->Apply([](benchmark::internal::Benchmark* b) {
+      ThreadCounts(b, {{0}, {1}, {2}});
+    });
+BENCHMARK_TEMPLATE(BM_Reduce, kReduceMean)
+    ->ArgNames({"case", "threads"})
+    ->Apply([](benchmark::internal::Benchmark* b) {
+      ThreadCounts(b, {{0}, {1}, {2}});
+    });
+BENCHMARK_TEMPLATE(BM_Reduce, kReduceMax)
+    ->ArgNames({"case", "threads"})
+    ->Apply([](benchmark::internal::Benchmark* b) {
+      ThreadCounts(b, {{0}, {1}, {2}});
+    });
+
+// Splitting BERT heads and converting a ResNet activation from NCHW to NHWC.
+static void BM_Transpose(benchmark::State& state) {
+  if (state.range(0) == 0) {
+    KernelBenchmark("Transpose")
+        .Input({1, 128, 12, 64})
+        .Attribute("perm", std::vector<int64_t>{0, 2, 1, 3})
+        .Run(state, static_cast<int>(state.range(1)));
+  } else {
+    KernelBenchmark("Transpose")
+        .Input({1, 64, 56, 56})
+        .Attribute("perm", std::vector<int64_t>{0, 2, 3, 1})
+        .Run(state, static_cast<int>(state.range(1)));
+  }
+}
+
+BENCHMARK(BM_Transpose)
+    ->ArgNames({"case", "threads"})
+    ->Apply([](benchmark::internal::Benchmark* b) {
+      ThreadCounts(b, {{0}, {1}});
+    });
+
+// BERT-base word embedding lookup.
+static void BM_Gather(benchmark::State& state) {
+  const int64_t vocabulary = state.range(0);
+  KernelBenchmark("Gather")
+      .Initializer({vocabulary, 768})
+      .Input({1, state.range(1)}, ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64, vocabulary)
+      .Attribute("axis", int64_t{0})
+      .Run(state, static_cast<int>(state.range(2)));
+}
+
+BENCHMARK(BM_Gather)
+    ->ArgNames({"vocabulary", "S", "threads"})
+    ->Apply([](benchmark::internal::Benchmark* b) {
+      ThreadCounts(b, {{30522, 128}, {30522, 512}});
+    });
+
+// Merging BERT heads and joining the branches of an Inception style block.
+static void BM_Concat(benchmark::State& state) {
+  if (state.range(0) == 0) {
+    KernelBenchmark("Concat")
+        .Input({1, 128, 384})
+        .Input({1, 128, 384})
+        .Attribute("axis", int64_t{2})
+        .Run(state, static_cast<int>(state.range(1)));
+  } else {
+    KernelBenchmark("Concat")
+        .Input({1, 64, 56, 56})
+        .Input({1, 96, 56, 56})
+        .Input({1, 32, 56, 56})
+        .Attribute("axis", int64_t{1})
+        .Run(state, static_cast<int>(state.range(1)));
+  }
+}
+
+BENCHMARK(BM_Concat)
+    ->ArgNames({"case", "threads"})
+    ->Apply([](benchmark::internal::Benchmark* b) {
+      ThreadCounts(b, {{0}, {1}});
+    });
+
+// A forest of complete binary trees over dense features, as exported from gradient boosting libraries.
+static void BM_TreeEnsembleRegressor(benchmark::State& state) {
+  const int64_t batch = state.range(0);
+  const int64_t trees = state.range(1);
+  const int64_t depth = state.range(2);
+  const int64_t features = 32;
+
+  std::vector<int64_t> nodes_treeids, nodes_nodeids, nodes_featureids, nodes_truenodeids, nodes_falsenodeids;
+  std::vector<float> nodes_values;
+  std::vector<std::string> nodes_modes;
+  std::vector<int64_t> target_treeids, target_nodeids, target_ids;
+  std::vector<float> target_weights;
+
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<int64_t> feature_distribution(0, features - 1);
+  std::uniform_real_distribution<float> value_distribution(-1.0f, 1.0f);
+
+  const int64_t node_count = (int64_t{1} << (depth + 1)) - 1;
+  const int64_t leaf_start = (int64_t{1} << depth) - 1;
+  for (int64_t tree = 0; tree < trees; tree++) {
+    for (int64_t node = 0; node < node_count; node++) {
+      nodes_treeids.push_back(tree);
+      nodes_nodeids.push_back(node);
+      if (node < leaf_start) {
+        nodes_featureids.push_back(feature_distribution(generator));
+        nodes_values.push_back(value_distribution(generator));
+        nodes_modes.push_back("BRANCH_LEQ");
+        nodes_truenodeids.push_back(2 * node + 1);
+        nodes_falsenodeids.push_back(2 * node + 2);
+      } else {
+        nodes_featureids.push_back(0);
+        nodes_values.push_back(0.0f);
+        nodes_modes.push_back("LEAF");
+        nodes_truenodeids.push_back(0);
+        nodes_falsenodeids.push_back(0);
+        target_treeids.push_back(tree);
+        target_nodeids.push_back(node);
+        target_ids.push_back(0);
+        target_weights.push_back(value_distribution(generator));
+      }
+    }
+  }
+
+  KernelBenchmark("TreeEnsembleRegressor", "ai.onnx.ml")
+      .Input({batch, features})
+      .Attribute("n_targets", int64_t{1})
+      .Attribute("aggregate_function", std::string("SUM"))
+      .Attribute("nodes_treeids", nodes_treeids)
+      .Attribute("nodes_nodeids", nodes_nodeids)
+      .Attribute("nodes_featureids", nodes_featureids)
+      .Attribute("nodes_values", nodes_values)
+      .Attribute("nodes_modes", nodes_modes)
+      .Attribute("nodes_truenodeids", nodes_truenodeids)
+      .Attribute("nodes_falsenodeids", nodes_falsenodeids)
+      .Attribute("target_treeids", target_treeids)
+      .Attribute("target_nodeids", target_nodeids)
+      .Attribute("target_ids", target_ids)
+      .Attribute("target_weights", target_weights)
+      .Run(state, static_cast<int>(state.range(3)));
+}
+
+BENCHMARK(BM_TreeEnsembleRegressor)
+    ->ArgNames({"batch", "trees", "depth", "threads"})
+    ->Apply([](benchmark::internal::Benchmark* b) {
+      ThreadCounts(b, {{1, 100, 6}, {1000, 100, 6}, {1000, 500, 8}});
+    });
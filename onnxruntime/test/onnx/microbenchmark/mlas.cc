@@ -0,0 +1,384 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// Benchmarks for the MLAS entry points used by the CPU kernels. The shapes are taken from BERT-base (sequence
+// length 128), ResNet-50 and MobileNet-v2 so that regressions show up at the sizes that matter for real models.
+//
+// MLAS selects its kernels from the instruction sets supported by the processor. Set MLAS_MAXIMUM_ISA to one of
+// sse2, avx, avx2, avx512f, avx512bw or avx512vnni to cap the selection and benchmark the older code paths; the
+// active setting is reported as the label of every benchmark.
+
+#include <benchmark/benchmark.h>
+#include <core/mlas/inc/mlas.h>
+#include <core/platform/threadpool.h>
+#include <cstdlib>
+#include <limits>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Returns a thread pool with the given number of threads, or nullptr for a single threaded run.
+onnxruntime::concurrency::ThreadPool* GetThreadPool(int64_t threads) {
+  static std::map<int64_t, std::unique_ptr<onnxruntime::concurrency::ThreadPool>> thread_pools;
+  if (threads <= 1) {
+    return nullptr;
+  }
+  auto& tp = thread_pools[threads];
+  if (tp == nullptr) {
+    tp.reset(new onnxruntime::concurrency::ThreadPool("mlas_benchmark", static_cast<int>(threads)));
+  }
+  return tp.get();
+}
+
+const char* IsaLabel() {
+  const char* isa = std::getenv("MLAS_MAXIMUM_ISA");
+  return isa != nullptr ? isa : "native";
+}
+
+template <typename T>
+std::vector<T> RandomVector(size_t count, T min_value, T max_value) {
+  std::vector<T> result(count);
+  std::mt19937 generator(static_cast<unsigned>(count));
+  std::uniform_real_distribution<double> distribution(static_cast<double>(min_value), static_cast<double>(max_value));
+  for (auto& value : result) {
+    value = static_cast<T>(distribution(generator));
+  }
+  return result;
+}
+
+void SetFlops(benchmark::State& state, double flops) {
+  state.counters["FLOPS"] = benchmark::Counter(flops, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// M, N, K, threads
+void SgemmShapes(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"M", "N", "K", "threads"});
+  for (int64_t threads : {1, 4}) {
+    // BERT-base: QKV/output projections and the feed forward layers.
+    b->Args({128, 768, 768, threads});
+    b->Args({128, 3072, 768, threads});
+    b->Args({128, 768, 3072, threads});
+    // ResNet-50: 3x3 and 1x1 convolutions expressed as filter x (output image) x (input channels x kernel).
+    b->Args({64, 3136, 576, threads});
+    b->Args({256, 3136, 64, threads});
+    b->Args({512, 196, 2304, threads});
+    // Classifier heads and single vector products.
+    b->Args({1, 1000, 2048, threads});
+    b->Args({64, 64, 64, threads});
+  }
+}
+
+}  // namespace
+
+static void BM_SGEMM(benchmark::State& state) {
+  const size_t M = static_cast<size_t>(state.range(0));
+  const size_t N = static_cast<size_t>(state.range(1));
+  const size_t K = static_cast<size_t>(state.range(2));
+  auto* tp = GetThreadPool(state.range(3));
+
+  auto A = RandomVector<float>(M * K, -1.0f, 1.0f);
+  auto B = RandomVector<float>(K * N, -1.0f, 1.0f);
+  std::vector<float> C(M * N);
+
+  for (auto _ : state) {
+    MlasGemm(CblasNoTrans, CblasNoTrans, M, N, K, 1.0f, A.data(), K, B.data(), N, 0.0f, C.data(), N, tp);
+  }
+  SetFlops(state, 2.0 * M * N * K);
+  state.SetLabel(IsaLabel());
+}
+
+BENCHMARK(BM_SGEMM)->Apply(SgemmShapes)->UseRealTime();
+
+static void BM_SGEMM_TransB(benchmark::State& state) {
+  const size_t M = static_cast<size_t>(state.range(0));
+  const size_t N = static_cast<size_t>(state.range(1));
+  const size_t K = static_cast<size_t>(state.range(2));
+  auto* tp = GetThreadPool(state.range(3));
+
+  auto A = RandomVector<float>(M * K, -1.0f, 1.0f);
+  auto B = RandomVector<float>(N * K, -1.0f, 1.0f);
+  std::vector<float> C(M * N);
+
+  for (auto _ : state) {
+    MlasGemm(CblasNoTrans, CblasTrans, M, N, K, 1.0f, A.data(), K, B.data(), K, 0.0f, C.data(), N, tp);
+  }
+  SetFlops(state, 2.0 * M * N * K);
+  state.SetLabel(IsaLabel());
+}
+
+BENCHMARK(BM_SGEMM_TransB)->Apply(SgemmShapes)->UseRealTime();
+
+// Batched products of the BERT-base self attention: batch x heads of Q*K^T and of the probabilities times V.
+static void BM_SGEMM_Batch(benchmark::State& state) {
+  const size_t batch = static_cast<size_t>(state.range(0));
+  const size_t M = static_cast<size_t>(state.range(1));
+  const size_t N = static_cast<size_t>(state.range(2));
+  const size_t K = static_cast<size_t>(state.range(3));
+  auto* tp = GetThreadPool(state.range(4));
+
+  auto A = RandomVector<float>(batch * M * K, -1.0f, 1.0f);
+  auto B = RandomVector<float>(batch * K * N, -1.0f, 1.0f);
+  std::vector<float> C(batch * M * N);
+
+  for (auto _ : state) {
+    MlasGemmBatch(CblasNoTrans, CblasNoTrans, M, N, K, 1.0f,
+                  A.data(), K, M * K, B.data(), N, K * N, 0.0f, C.data(), N, M * N, batch, tp);
+  }
+  SetFlops(state, 2.0 * batch * M * N * K);
+  state.SetLabel(IsaLabel());
+}
+
+BENCHMARK(BM_SGEMM_Batch)
+    ->ArgNames({"batch", "M", "N", "K", "threads"})
+    ->Args({12, 128, 128, 64, 1})
+    ->Args({12, 128, 64, 128, 1})
+    ->Args({96, 128, 128, 64, 1})
+    ->Args({12, 128, 128, 64, 4})
+    ->Args({12, 128, 64, 128, 4})
+    ->Args({96, 128, 128, 64, 4})
+    ->UseRealTime();
+
+template <typename BType>
+static void BM_QGEMM(benchmark::State& state) {
+  const size_t M = static_cast<size_t>(state.range(0));
+  const size_t N = static_cast<size_t>(state.range(1));
+  const size_t K = static_cast<size_t>(state.range(2));
+  auto* tp = GetThreadPool(state.range(3));
+
+  auto A = RandomVector<uint8_t>(M * K, 0, 255);
+  auto B = RandomVector<BType>(K * N, std::numeric_limits<BType>::min(), std::numeric_limits<BType>::max());
+  std::vector<int32_t> C(M * N);
+
+  for (auto _ : state) {
+    MlasGemm(M, N, K, A.data(), K, uint8_t{128}, B.data(), N, BType{1}, C.data(), N, tp);
+  }
+  SetFlops(state, 2.0 * M * N * K);
+  state.SetLabel(IsaLabel());
+}
+
+BENCHMARK_TEMPLATE(BM_QGEMM, int8_t)->Apply(SgemmShapes)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_QGEMM, uint8_t)->Apply(SgemmShapes)->UseRealTime();
+
+namespace {
+
+// input channels, height, width, filters, kernel, stride, groups, threads
+void ConvShapes(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"C", "H", "W", "F", "kernel", "stride", "groups", "threads"});
+  for (int64_t threads : {1, 4}) {
+    // ResNet-50
+    b->Args({3, 224, 224, 64, 7, 2, 1, threads});
+    b->Args({64, 56, 56, 64, 3, 1, 1, threads});
+    b->Args({64, 56, 56, 256, 1, 1, 1, threads});
+    b->Args({256, 14, 14, 256, 3, 1, 1, threads});
+    b->Args({512, 7, 7, 2048, 1, 1, 1, threads});
+    // MobileNet-v2 depthwise convolutions
+    b->Args({144, 56, 56, 144, 3, 1, 144, threads});
+    b->Args({384, 14, 14, 384, 3, 1, 384, threads});
+  }
+}
+
+struct ConvShape {
+  explicit ConvShape(const benchmark::State& state)
+      : input_channels(state.range(0)),
+        filter_count(state.range(3)),
+        group_count(state.range(6)),
+        input_shape{1, input_channels, state.range(1), state.range(2)},
+        kernel_shape{state.range(4), state.range(4)},
+        dilation_shape{1, 1},
+        padding{state.range(4) / 2, state.range(4) / 2, state.range(4) / 2, state.range(4) / 2},
+        stride_shape{state.range(5), state.range(5)},
+        output_shape{1, filter_count,
+                     (input_shape[2] + padding[0] + padding[2] - kernel_shape[0]) / stride_shape[0] + 1,
+                     (input_shape[3] + padding[1] + padding[3] - kernel_shape[1]) / stride_shape[1] + 1} {}
+
+  double Flops() const {
+    return 2.0 * output_shape[1] * output_shape[2] * output_shape[3] * (input_channels / group_count) *
+           kernel_shape[0] * kernel_shape[1];
+  }
+
+  int64_t input_channels;
+  int64_t filter_count;
+  int64_t group_count;
+  int64_t input_shape[4];
+  int64_t kernel_shape[2];
+  int64_t dilation_shape[2];
+  int64_t padding[4];
+  int64_t stride_shape[2];
+  int64_t output_shape[4];
+};
+
+}  // namespace
+
+static void BM_Conv(benchmark::State& state) {
+  const ConvShape shape(state);
+  auto* tp = GetThreadPool(state.range(7));
+
+  MLAS_ACTIVATION activation;
+  activation.ActivationKind = MlasIdentityActivation;
+
+  MLAS_CONV_PARAMETERS parameters;
+  size_t working_buffer_size;
+  MlasConvPrepare(&parameters, 2, 1, static_cast<size_t>(shape.group_count),
+                  static_cast<size_t>(shape.input_channels / shape.group_count),
+                  shape.input_shape + 2, shape.kernel_shape, shape.dilation_shape, shape.padding, shape.stride_shape,
+                  shape.output_shape + 2, static_cast<size_t>(shape.filter_count / shape.group_count), &activation,
+                  &working_buffer_size, tp);
+
+  const size_t input_size = static_cast<size_t>(shape.input_shape[1] * shape.input_shape[2] * shape.input_shape[3]);
+  const size_t filter_size = static_cast<size_t>(shape.filter_count * (shape.input_channels / shape.group_count) *
+                                                 shape.kernel_shape[0] * shape.kernel_shape[1]);
+  const size_t output_size =
+      static_cast<size_t>(shape.output_shape[1] * shape.output_shape[2] * shape.output_shape[3]);
+
+  auto input = RandomVector<float>(input_size, -1.0f, 1.0f);
+  auto filter = RandomVector<float>(filter_size, -1.0f, 1.0f);
+  auto bias = RandomVector<float>(static_cast<size_t>(shape.filter_count), -1.0f, 1.0f);
+  std::vector<float> working_buffer(working_buffer_size);
+  std::vector<float> output(output_size);
+
+  for (auto _ : state) {
+    MlasConv(&parameters, input.data(), filter.data(), bias.data(), working_buffer.data(), output.data(), tp);
+  }
+  SetFlops(state, shape.Flops());
+  state.SetLabel(IsaLabel());
+}
+
+BENCHMARK(BM_Conv)->Apply(ConvShapes)->UseRealTime();
+
+// The NCHWc layout is what the graph optimizer rewrites convolutions to at level 3. Only the convolution itself is
+// timed; the buffers are sized for the blocked layout but the reorder kernels are not run.
+static void BM_NchwcConv(benchmark::State& state) {
+  ConvShape shape(state);
+  auto* tp = GetThreadPool(state.range(7));
+
+  const int64_t block_size = static_cast<int64_t>(MlasNchwcGetBlockSize());
+  const bool depthwise = shape.group_count > 1;
+  const bool nchw_input = !depthwise && shape.input_channels < block_size;
+  const int64_t nchwc_input_channels = (shape.input_channels + block_size - 1) / block_size * block_size;
+  const int64_t nchwc_output_channels = (shape.filter_count + block_size - 1) / block_size * block_size;
+
+  size_t filter_size;
+  if (depthwise || nchw_input) {
+    filter_size = static_cast<size_t>(nchwc_output_channels * (shape.input_channels / shape.group_count) *
+                                      shape.kernel_shape[0] * shape.kernel_shape[1]);
+  } else {
+    filter_size = static_cast<size_t>(nchwc_output_channels * nchwc_input_channels * shape.kernel_shape[0] *
+                                      shape.kernel_shape[1]);
+  }
+  if (!nchw_input) {
+    shape.input_shape[1] = nchwc_input_channels;
+  }
+  shape.output_shape[1] = nchwc_output_channels;
+
+  const size_t input_size = static_cast<size_t>(shape.input_shape[1] * shape.input_shape[2] * shape.input_shape[3]);
+  const size_t output_size =
+      static_cast<size_t>(shape.output_shape[1] * shape.output_shape[2] * shape.output_shape[3]);
+
+  auto input = RandomVector<float>(input_size, -1.0f, 1.0f);
+  auto filter = RandomVector<float>(filter_size, -1.0f, 1.0f);
+  auto bias = RandomVector<float>(static_cast<size_t>(nchwc_output_channels), -1.0f, 1.0f);
+  std::vector<float> output(output_size);
+
+  MLAS_ACTIVATION activation;
+  activation.ActivationKind = MlasReluActivation;
+
+  for (auto _ : state) {
+    MlasNchwcConv(2, shape.input_shape, shape.kernel_shape, shape.dilation_shape, shape.padding, shape.stride_shape,
+                  shape.output_shape, static_cast<size_t>(shape.group_count), input.data(), filter.data(),
+                  bias.data(), output.data(), &activation, true, tp);
+  }
+  SetFlops(state, shape.Flops());
+  state.SetLabel(IsaLabel());
+}
+
+BENCHMARK(BM_NchwcConv)->Apply(ConvShapes)->UseRealTime();
+
+static void BM_Pool(benchmark::State& state) {
+  const auto kind = static_cast<MLAS_POOLING_KIND>(state.range(0));
+  const int64_t channels = state.range(1);
+  const int64_t size = state.range(2);
+  const int64_t kernel = state.range(3);
+  const int64_t stride = state.range(4);
+  auto* tp = GetThreadPool(state.range(5));
+
+  // A kernel covering the whole image is a global pooling; otherwise pad to keep the ResNet stem geometry.
+  const int64_t pad = kernel == size ? 0 : kernel / 2;
+  const int64_t output_size = (size + 2 * pad - kernel) / stride + 1;
+  const int64_t input_shape[] = {1, channels, size, size};
+  const int64_t kernel_shape[] = {kernel, kernel};
+  const int64_t padding[] = {pad, pad, pad, pad};
+  const int64_t stride_shape[] = {stride, stride};
+  const int64_t output_shape[] = {1, channels, output_size, output_size};
+
+  auto input = RandomVector<float>(static_cast<size_t>(channels * size * size), -1.0f, 1.0f);
+  std::vector<float> output(static_cast<size_t>(channels * output_size * output_size));
+
+  for (auto _ : state) {
+    MlasPool(kind, 2, input_shape, kernel_shape, padding, stride_shape, output_shape, input.data(), output.data(), tp);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * channels * size * size *
+                          static_cast<int64_t>(sizeof(float)));
+  state.SetLabel(IsaLabel());
+}
+
+BENCHMARK(BM_Pool)
+    ->ArgNames({"kind", "C", "HW", "kernel", "stride", "threads"})
+    ->Args({MlasMaximumPooling, 64, 112, 3, 2, 1})
+    ->Args({MlasAveragePoolingExcludePad, 2048, 7, 7, 1, 1})
+    ->Args({MlasMaximumPooling, 64, 112, 3, 2, 4})
+    ->Args({MlasAveragePoolingExcludePad, 2048, 7, 7, 1, 4})
+    ->UseRealTime();
+
+namespace {
+
+// BERT-base intermediate activations, a ResNet-50 stage and a small vector.
+void ActivationSizes(benchmark::internal::Benchmark* b) {
+  b->ArgName("N")->Arg(1024)->Arg(64 * 56 * 56)->Arg(128 * 3072);
+}
+
+template <void (MLASCALL* Routine)(const float*, float*, size_t)>
+void ActivationBenchmark(benchmark::State& state) {
+  const size_t N = static_cast<size_t>(state.range(0));
+  auto input = RandomVector<float>(N, -5.0f, 5.0f);
+  std::vector<float> output(N);
+
+  for (auto _ : state) {
+    Routine(input.data(), output.data(), N);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * N * sizeof(float)));
+  state.SetLabel(IsaLabel());
+}
+
+}  // namespace
+
+static void BM_Logistic(benchmark::State& state) { ActivationBenchmark<MlasComputeLogistic>(state); }
+BENCHMARK(BM_Logistic)->Apply(ActivationSizes);
+
+static void BM_Tanh(benchmark::State& state) { ActivationBenchmark<MlasComputeTanh>(state); }
+BENCHMARK(BM_Tanh)->Apply(ActivationSizes);
+
+static void BM_Erf(benchmark::State& state) { ActivationBenchmark<MlasComputeErf>(state); }
+BENCHMARK(BM_Erf)->Apply(ActivationSizes);
+
+static void BM_BiasRelu(benchmark::State& state) {
+  const size_t N = static_cast<size_t>(state.range(0));
+  // Apply the activation as the convolution epilogue does: rows of 64 channels with a per-row bias.
+  const size_t M = N / 64;
+  auto input = RandomVector<float>(N, -5.0f, 5.0f);
+  auto bias = RandomVector<float>(M, -1.0f, 1.0f);
+
+  MLAS_ACTIVATION activation;
+  activation.ActivationKind = MlasReluActivation;
+
+  for (auto _ : state) {
+    MlasActivation(&activation, input.data(), bias.data(), M, 64, 64);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * N * sizeof(float)));
+  state.SetLabel(IsaLabel());
+}
+
+BENCHMARK(BM_BiasRelu)->Apply(ActivationSizes);
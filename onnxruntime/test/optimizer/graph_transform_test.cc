@@ -33,6 +33,7 @@
 #include "core/optimizer/unsqueeze_elimination.h"
 #include "core/optimizer/reshape_fusion.h"
 #include "core/optimizer/attention_fusion.h"
+#include "core/optimizer/elementwise_fusion.h"
 #include "core/optimizer/utils.h"
 #include "core/platform/env.h"
 #include "core/util/math.h"
@@ -1447,6 +1448,77 @@ TEST(GraphTransformationTests, EmbedLayerNormFusionFormat5) {
   }
 }
 
+TEST(GraphTransformationTests, ElementwiseFusion) {
+  Model model("ElementwiseFusion", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto input_tensor_type;
+  input_tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  input_tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("batch");
+  input_tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+
+  TypeProto bias_tensor_type;
+  bias_tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  bias_tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+
+  // Add -> Sigmoid -> Mul is fused, with the output of Add also read by the Softmax outside of the fused node.
+  // The Add -> Relu on the second path reads the Softmax output, which is produced after the Add of the first
+  // path, so it forms a separate fused node.
+  auto& input = graph.GetOrCreateNodeArg("input", &input_tensor_type);
+  auto& bias = graph.GetOrCreateNodeArg("bias", &bias_tensor_type);
+  auto& add_output = graph.GetOrCreateNodeArg("add_output", nullptr);
+  auto& sigmoid_output = graph.GetOrCreateNodeArg("sigmoid_output", nullptr);
+  auto& mul_output = graph.GetOrCreateNodeArg("mul_output", nullptr);
+  auto& softmax_output = graph.GetOrCreateNodeArg("softmax_output", nullptr);
+  auto& add2_output = graph.GetOrCreateNodeArg("add2_output", nullptr);
+  auto& relu_output = graph.GetOrCreateNodeArg("relu_output", nullptr);
+
+  graph.AddNode("add", "Add", "bias add", {&input, &bias}, {&add_output});
+  graph.AddNode("sigmoid", "Sigmoid", "sigmoid", {&add_output}, {&sigmoid_output});
+  graph.AddNode("mul", "Mul", "swish", {&add_output, &sigmoid_output}, {&mul_output});
+  graph.AddNode("softmax", "Softmax", "not element-wise", {&add_output}, {&softmax_output});
+  graph.AddNode("add2", "Add", "add of the softmax", {&mul_output, &softmax_output}, {&add2_output});
+  graph.AddNode("relu", "Relu", "relu", {&add2_output}, {&relu_output});
+
+  auto status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(onnxruntime::make_unique<ElementwiseFusion>(), TransformerLevel::Level2);
+  ASSERT_TRUE(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2, DefaultLoggingManager().DefaultLogger()).IsOK());
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_TRUE(op_to_count["Add"] == 0);
+  ASSERT_TRUE(op_to_count["Sigmoid"] == 0);
+  ASSERT_TRUE(op_to_count["Mul"] == 0);
+  ASSERT_TRUE(op_to_count["Relu"] == 0);
+  ASSERT_TRUE(op_to_count["Softmax"] == 1);
+  ASSERT_TRUE(op_to_count["FusedElementwise"] == 2);
+
+  for (auto& node : graph.Nodes()) {
+    if (node.OpType() != "FusedElementwise") {
+      continue;
+    }
+    const auto* ops = graph_utils::GetNodeAttribute(node, "ops");
+    ASSERT_TRUE(ops != nullptr);
+    if (ops->strings_size() == 3) {
+      EXPECT_EQ(ops->strings(0), "Add");
+      EXPECT_EQ(ops->strings(1), "Sigmoid");
+      EXPECT_EQ(ops->strings(2), "Mul");
+      // the Add output goes to the Softmax and the Mul output to the second fused node
+      EXPECT_EQ(node.OutputDefs().size(), 2u);
+      EXPECT_EQ(node.OutputDefs()[0]->Name(), "add_output");
+      EXPECT_EQ(node.OutputDefs()[1]->Name(), "mul_output");
+    } else {
+      ASSERT_EQ(ops->strings_size(), 2);
+      EXPECT_EQ(ops->strings(0), "Add");
+      EXPECT_EQ(ops->strings(1), "Relu");
+      EXPECT_EQ(node.OutputDefs().size(), 1u);
+      EXPECT_EQ(node.OutputDefs()[0]->Name(), "relu_output");
+    }
+  }
+}
+
 #endif
 
 }  // namespace test
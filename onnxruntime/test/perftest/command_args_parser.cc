@@ -3,8 +3,10 @@
 
 #include "command_args_parser.h"
 
+#include <stdlib.h>
 #include <string.h>
 #include <iostream>
+#include <string>
 
 // Windows Specific
 #ifdef _WIN32
@@ -14,6 +16,7 @@
 #include <unistd.h>
 #endif
 
+#include <core/common/common.h>
 #include <core/graph/constants.h>
 #include <core/framework/path_lib.h>
 #include <core/optimizer/graph_transformer_level.h>
@@ -27,17 +30,28 @@ namespace perftest {
   printf(
       "perf_test [options...] model_path result_file\n"
       "Options:\n"
-      "\t-m [test_mode]: Specifies the test mode. Value could be 'duration' or 'times'.\n"
+      "\t-m [test_mode]: Specifies the test mode. Value could be 'duration', 'times' or 'openloop'.\n"
       "\t\tProvide 'duration' to run the test for a fix duration, and 'times' to repeated for a certain times. \n"
+      "\t\tProvide 'openloop' to issue requests at the rate given by -q for the duration given by -t and report the\n"
+      "\t\tlatency of each request measured from its scheduled arrival time.\n"
       "\t-M: Disable memory pattern.\n"
       "\t-A: Disable memory arena\n"
       "\t-c [parallel runs]: Specifies the (max) number of runs to invoke simultaneously. Default:1.\n"
+      "\t\tIn 'openloop' mode requests that arrive while this many runs are in flight wait in a queue.\n"
       "\t-e [cpu|cuda|dnnl|tensorrt|ngraph|openvino|nuphar|dml|acl]: Specifies the provider 'cpu','cuda','dnnl','tensorrt', "
       "'ngraph', 'openvino', 'nuphar', 'dml' or 'acl'. "
       "Default:'cpu'.\n"
       "\t-b [tf|ort]: backend to use. Default:ort\n"
       "\t-r [repeated_times]: Specifies the repeated times if running in 'times' test mode.Default:1000.\n"
-      "\t-t [seconds_to_run]: Specifies the seconds to run for 'duration' mode. Default:600.\n"
+      "\t-t [seconds_to_run]: Specifies the seconds to run for 'duration' and 'openloop' mode. Default:600.\n"
+      "\t-q [requests_per_second]: Specifies the target request rate and selects 'openloop' mode.\n"
+      "\t-a [poisson|constant]: Specifies the request arrival process for 'openloop' mode. Default:poisson.\n"
+      "\t-w [warmup_seconds]: Specifies the seconds at the start of 'openloop' mode whose requests are not measured. "
+      "Default:0.\n"
+      "\t-I: Generate random model inputs from the model's input metadata instead of loading test_data_set_* "
+      "directories. This is the default if the model directory has no test data.\n"
+      "\t-f [free_dimension_name:value]: Sets the value of a named free dimension of the generated inputs. "
+      "Can be repeated. Free dimensions default to 1.\n"
       "\t-p [profile_file]: Specifies the profile name to enable profiling and dump the profile data to the file.\n"
       "\t-s: Show statistics result, like P75, P90.\n"
       "\t-v: Show verbose information.\n"
@@ -52,13 +66,15 @@ namespace perftest {
 
 /*static*/ bool CommandLineParser::ParseArguments(PerformanceTestConfig& test_config, int argc, ORTCHAR_T* argv[]) {
   int ch;
-  while ((ch = getopt(argc, argv, ORT_TSTR("b:m:e:r:t:p:x:y:c:o:u:AMPvhs"))) != -1) {
+  while ((ch = getopt(argc, argv, ORT_TSTR("b:m:e:r:t:p:x:y:c:o:u:q:a:w:f:AMPIvhs"))) != -1) {
     switch (ch) {
       case 'm':
         if (!CompareCString(optarg, ORT_TSTR("duration"))) {
           test_config.run_config.test_mode = TestMode::kFixDurationMode;
         } else if (!CompareCString(optarg, ORT_TSTR("times"))) {
           test_config.run_config.test_mode = TestMode::KFixRepeatedTimesMode;
+        } else if (!CompareCString(optarg, ORT_TSTR("openloop"))) {
+          test_config.run_config.test_mode = TestMode::kOpenLoopMode;
         } else {
           return false;
         }
@@ -172,6 +188,50 @@ namespace perftest {
       case 'u':
         test_config.run_config.optimized_model_path = optarg;
         break;
+      case 'q': {
+        std::string qps = ToMBString(std::basic_string<ORTCHAR_T>(optarg));
+        char* end = nullptr;
+        test_config.run_config.target_qps = strtod(qps.c_str(), &end);
+        if (end == qps.c_str() || *end != '\0' || !(test_config.run_config.target_qps > 0)) {
+          return false;
+        }
+        test_config.run_config.test_mode = TestMode::kOpenLoopMode;
+        break;
+      }
+      case 'a':
+        if (!CompareCString(optarg, ORT_TSTR("poisson"))) {
+          test_config.run_config.arrival_process = ArrivalProcess::kPoisson;
+        } else if (!CompareCString(optarg, ORT_TSTR("constant"))) {
+          test_config.run_config.arrival_process = ArrivalProcess::kConstant;
+        } else {
+          return false;
+        }
+        break;
+      case 'w': {
+        long warmup = OrtStrtol<PATH_CHAR_TYPE>(optarg, nullptr);
+        if (warmup < 0) {
+          return false;
+        }
+        test_config.run_config.warmup_in_seconds = static_cast<size_t>(warmup);
+        break;
+      }
+      case 'I':
+        test_config.run_config.generate_model_input = true;
+        break;
+      case 'f': {
+        std::string dim = ToMBString(std::basic_string<ORTCHAR_T>(optarg));
+        size_t colon = dim.rfind(':');
+        if (colon == std::string::npos || colon == 0 || colon + 1 == dim.size()) {
+          return false;
+        }
+        char* end = nullptr;
+        long long value = strtoll(dim.c_str() + colon + 1, &end, 10);
+        if (*end != '\0' || value <= 0) {
+          return false;
+        }
+        test_config.run_config.free_dimension_overrides.emplace_back(dim.substr(0, colon), static_cast<int64_t>(value));
+        break;
+      }
       case '?':
       case 'h':
       default:
@@ -184,6 +244,10 @@ namespace perftest {
   argv += optind;
   if (argc != 2) return false;
 
+  if (test_config.run_config.test_mode == TestMode::kOpenLoopMode && test_config.run_config.target_qps <= 0) {
+    return false;
+  }
+
   test_config.model_info.model_file_path = argv[0];
   test_config.model_info.result_file_path = argv[1];
 
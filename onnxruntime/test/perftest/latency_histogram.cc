@@ -0,0 +1,93 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "latency_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace onnxruntime {
+namespace perftest {
+
+static int Log2Floor(uint64_t value) {
+  int result = -1;
+  while (value != 0) {
+    value >>= 1;
+    result++;
+  }
+  return result;
+}
+
+LatencyHistogram::LatencyHistogram(int64_t max_value, int significant_digits) : max_value_(max_value) {
+  // Each power of two range is split into enough linear sub-buckets to resolve 10^significant_digits distinct
+  // values, so a bucket is never wider than value / 10^significant_digits.
+  const uint64_t largest_single_unit_value = 2 * static_cast<uint64_t>(std::pow(10, significant_digits));
+  const int sub_bucket_count_magnitude = Log2Floor(largest_single_unit_value - 1) + 1;
+  sub_bucket_half_count_magnitude_ = sub_bucket_count_magnitude - 1;
+  sub_bucket_half_count_ = int64_t{1} << sub_bucket_half_count_magnitude_;
+  const int64_t sub_bucket_count = int64_t{1} << sub_bucket_count_magnitude;
+  sub_bucket_mask_ = sub_bucket_count - 1;
+
+  int64_t bucket_count = 1;
+  for (int64_t smallest_untrackable = sub_bucket_count; smallest_untrackable <= max_value_;
+       smallest_untrackable <<= 1) {
+    bucket_count++;
+  }
+  counts_.resize(static_cast<size_t>((bucket_count + 1) * sub_bucket_half_count_));
+}
+
+size_t LatencyHistogram::CountsIndex(int64_t value) const {
+  const int bucket_index = Log2Floor(static_cast<uint64_t>(value | sub_bucket_mask_)) - sub_bucket_half_count_magnitude_;
+  const int64_t sub_bucket_index = value >> bucket_index;
+  return static_cast<size_t>((static_cast<int64_t>(bucket_index + 1) << sub_bucket_half_count_magnitude_) +
+                             (sub_bucket_index - sub_bucket_half_count_));
+}
+
+int64_t LatencyHistogram::HighestEquivalentValue(size_t index) const {
+  int bucket_index = static_cast<int>(index >> sub_bucket_half_count_magnitude_) - 1;
+  int64_t sub_bucket_index = static_cast<int64_t>(index & (sub_bucket_half_count_ - 1)) + sub_bucket_half_count_;
+  if (bucket_index < 0) {
+    sub_bucket_index -= sub_bucket_half_count_;
+    bucket_index = 0;
+  }
+  return (sub_bucket_index << bucket_index) + (int64_t{1} << bucket_index) - 1;
+}
+
+void LatencyHistogram::Record(int64_t value) {
+  value = std::min(std::max(value, int64_t{0}), max_value_);
+  counts_[CountsIndex(value)]++;
+  min_ = total_count_ == 0 ? value : std::min(min_, value);
+  max_ = std::max(max_, value);
+  total_ += value;
+  total_count_++;
+}
+
+int64_t LatencyHistogram::ValueAtPercentile(double percentile) const {
+  if (total_count_ == 0) {
+    return 0;
+  }
+  const double fraction = std::min(std::max(percentile, 0.0), 100.0) / 100.0;
+  const uint64_t target = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(fraction * total_count_)));
+  uint64_t cumulative = 0;
+  for (size_t i = 0; i < counts_.size(); i++) {
+    cumulative += counts_[i];
+    if (cumulative >= target) {
+      return std::min(HighestEquivalentValue(i), max_);
+    }
+  }
+  return max_;
+}
+
+void LatencyHistogram::Print(std::ostream& os) const {
+  auto ms = [](int64_t us) { return us / 1000.0; };
+  os << "Latency samples:" << Count() << std::endl
+     << "Mean latency:" << Mean() / 1000.0 << " ms" << std::endl
+     << "P50 latency:" << ms(ValueAtPercentile(50)) << " ms" << std::endl
+     << "P90 latency:" << ms(ValueAtPercentile(90)) << " ms" << std::endl
+     << "P99 latency:" << ms(ValueAtPercentile(99)) << " ms" << std::endl
+     << "P99.9 latency:" << ms(ValueAtPercentile(99.9)) << " ms" << std::endl
+     << "Max latency:" << ms(Max()) << " ms" << std::endl;
+}
+
+}  // namespace perftest
+}  // namespace onnxruntime
@@ -0,0 +1,52 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace onnxruntime {
+namespace perftest {
+
+// Latency histogram with log-linear buckets in the style of HdrHistogram.
+// Values are recorded in microseconds in [0, max_value] and every recorded value is reproduced with a relative
+// error of at most 10^-significant_digits, independent of magnitude, using a fixed amount of memory.
+class LatencyHistogram {
+ public:
+  explicit LatencyHistogram(int64_t max_value = 3600LL * 1000 * 1000, int significant_digits = 3);
+
+  // Values above max_value are recorded as max_value.
+  void Record(int64_t value);
+
+  // Returns the largest value such that the given percentage (0-100) of the recorded values are less than or
+  // equal to it, reported as the highest value equivalent to its bucket.
+  int64_t ValueAtPercentile(double percentile) const;
+
+  uint64_t Count() const { return total_count_; }
+  int64_t Min() const { return total_count_ == 0 ? 0 : min_; }
+  int64_t Max() const { return max_; }
+  double Mean() const { return total_count_ == 0 ? 0.0 : static_cast<double>(total_) / total_count_; }
+
+  // Writes count, mean, and the p50/p90/p99/p99.9/max latencies in milliseconds.
+  void Print(std::ostream& os) const;
+
+ private:
+  size_t CountsIndex(int64_t value) const;
+  int64_t HighestEquivalentValue(size_t index) const;
+
+  int64_t max_value_;
+  int sub_bucket_half_count_magnitude_;
+  int64_t sub_bucket_half_count_;
+  int64_t sub_bucket_mask_;
+  std::vector<uint64_t> counts_;
+
+  uint64_t total_count_{0};
+  int64_t total_{0};
+  int64_t min_{0};
+  int64_t max_{0};
+};
+
+}  // namespace perftest
+}  // namespace onnxruntime
@@ -1,6 +1,7 @@
 #include "ort_test_session.h"
 #include <core/session/onnxruntime_cxx_api.h>
 #include <assert.h>
+#include <string.h>
 #include "providers.h"
 #include "TestCase.h"
 
@@ -12,9 +13,13 @@ namespace onnxruntime {
 namespace perftest {
 
 std::chrono::duration<double> OnnxRuntimeTestSession::Run() {
-  //Randomly pick one OrtValueArray from test_inputs_. (NOT ThreadSafe)
+  //Randomly pick one OrtValueArray from test_inputs_.
   const std::uniform_int_distribution<int>::param_type p(0, static_cast<int>(test_inputs_.size() - 1));
-  const size_t id = static_cast<size_t>(dist_(rand_engine_, p));
+  size_t id;
+  {
+    std::lock_guard<std::mutex> lock(rand_mutex_);
+    id = static_cast<size_t>(dist_(rand_engine_, p));
+  }
   auto& input = test_inputs_.at(id);
   auto start = std::chrono::high_resolution_clock::now();
   auto output_values = session_.Run(Ort::RunOptions{nullptr}, input_names_.data(), input.data(), input_names_.size(),
@@ -27,7 +32,10 @@ std::chrono::duration<double> OnnxRuntimeTestSession::Run() {
 OnnxRuntimeTestSession::OnnxRuntimeTestSession(Ort::Env& env, std::random_device& rd,
                                                const PerformanceTestConfig& performance_test_config,
                                                const TestModelInfo* m)
-    : rand_engine_(rd()), input_names_(m->GetInputCount()), input_length_(m->GetInputCount()) {
+    : rand_engine_(rd()),
+      free_dimension_overrides_(performance_test_config.run_config.free_dimension_overrides),
+      input_names_(m->GetInputCount()),
+      input_length_(m->GetInputCount()) {
   Ort::SessionOptions session_options;
   const std::string& provider_name = performance_test_config.machine_config.provider_type_name;
   if (provider_name == onnxruntime::kDnnlExecutionProvider) {
@@ -136,5 +144,92 @@ OnnxRuntimeTestSession::OnnxRuntimeTestSession(Ort::Env& env, std::random_device
   }
 }
 
+static size_t GetElementSize(ONNXTensorElementDataType type) {
+  switch (type) {
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT32:
+      return 4;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT64:
+      return 8;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_BFLOAT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT16:
+      return 2;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT8:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL:
+      return 1;
+    default:
+      return 0;
+  }
+}
+
+bool OnnxRuntimeTestSession::PopulateGeneratedInputTestData() {
+  Ort::AllocatorWithDefaultOptions allocator;
+  std::uniform_real_distribution<float> float_dist(0.0f, 1.0f);
+  std::vector<Ort::Value> inputs;
+
+  for (int i = 0; i < input_length_; i++) {
+    Ort::TypeInfo type_info = session_.GetInputTypeInfo(static_cast<size_t>(i));
+    if (type_info.GetONNXType() != ONNX_TYPE_TENSOR) {
+      fprintf(stderr, "Can't generate data for input '%s' as it is not a tensor\n", input_names_[i]);
+      return false;
+    }
+
+    auto tensor_info = type_info.GetTensorTypeAndShapeInfo();
+    ONNXTensorElementDataType type = tensor_info.GetElementType();
+    std::vector<int64_t> shape = tensor_info.GetShape();
+    std::vector<const char*> dim_names(shape.size());
+    tensor_info.GetSymbolicDimensions(dim_names.data(), dim_names.size());
+
+    std::string shape_string;
+    for (size_t d = 0; d < shape.size(); d++) {
+      if (shape[d] < 0) {
+        shape[d] = 1;
+        for (const auto& dim_override : free_dimension_overrides_) {
+          if (dim_names[d] != nullptr && dim_override.first == dim_names[d]) {
+            shape[d] = dim_override.second;
+          }
+        }
+      }
+      shape_string += (d == 0 ? "" : ",") + std::to_string(shape[d]);
+    }
+
+    // strings are created empty and everything other than float/double is zero filled,
+    // which is always a valid index or id
+    Ort::Value value = Ort::Value::CreateTensor(allocator, shape.data(), shape.size(), type);
+    const size_t count = value.GetTensorTypeAndShapeInfo().GetElementCount();
+    if (type == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT) {
+      float* data = value.GetTensorMutableData<float>();
+      for (size_t j = 0; j < count; j++) {
+        data[j] = float_dist(rand_engine_);
+      }
+    } else if (type == ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE) {
+      double* data = value.GetTensorMutableData<double>();
+      for (size_t j = 0; j < count; j++) {
+        data[j] = float_dist(rand_engine_);
+      }
+    } else if (type != ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING) {
+      const size_t element_size = GetElementSize(type);
+      if (element_size == 0) {
+        fprintf(stderr, "Can't generate data for input '%s' of element type %d\n", input_names_[i], static_cast<int>(type));
+        return false;
+      }
+      memset(value.GetTensorMutableData<void>(), 0, count * element_size);
+    }
+
+    fprintf(stdout, "Generated input '%s' with shape [%s]\n", input_names_[i], shape_string.c_str());
+    inputs.push_back(std::move(value));
+  }
+
+  test_inputs_.clear();
+  test_inputs_.push_back(std::move(inputs));
+  return true;
+}
+
 }  // namespace perftest
 }  // namespace onnxruntime
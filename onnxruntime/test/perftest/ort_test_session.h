@@ -3,7 +3,11 @@
 
 #pragma once
 #include <core/session/onnxruntime_cxx_api.h>
+#include <mutex>
 #include <random>
+#include <string>
+#include <utility>
+#include <vector>
 #include "test_configuration.h"
 #include "test_session.h"
 class TestModelInfo;
@@ -30,14 +34,19 @@ class OnnxRuntimeTestSession : public TestSession {
       free(p);
     }
   }
+  // Thread safe, so concurrent runs can share the session.
   std::chrono::duration<double> Run() override;
 
+  bool PopulateGeneratedInputTestData() override;
+
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(OnnxRuntimeTestSession);
 
  private:
   Ort::Session session_{nullptr};
+  std::mutex rand_mutex_;  // guards rand_engine_ and dist_
   std::mt19937 rand_engine_;
   std::uniform_int_distribution<int> dist_;
+  std::vector<std::pair<std::string, int64_t>> free_dimension_overrides_;
   std::vector<std::vector<Ort::Value>> test_inputs_;
   std::vector<std::string> output_names_;
   // The same size with output_names_.
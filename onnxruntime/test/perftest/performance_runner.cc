@@ -7,7 +7,9 @@
 #endif
 
 #include "performance_runner.h"
+#include <deque>
 #include <iostream>
+#include <thread>
 
 #include "TestCase.h"
 #include "TFModelInfo.h"
@@ -61,6 +63,9 @@ Status PerformanceRunner::Run() {
     case TestMode::KFixRepeatedTimesMode:
       ORT_RETURN_IF_ERROR(RepeatedTimesTest());
       break;
+    case TestMode::kOpenLoopMode:
+      ORT_RETURN_IF_ERROR(RunOpenLoop());
+      break;
     default:
       return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "unknown test mode.");
   }
@@ -79,7 +84,22 @@ Status PerformanceRunner::Run() {
             << "Total inference requests:" << performance_result_.time_costs.size() << std::endl
             << "Average inference time cost:" << performance_result_.total_time_cost / performance_result_.time_costs.size() * 1000 << " ms" << std::endl
             // Time between start and end of run. Less than Total time cost when running requests in parallel.
-            << "Total inference run time:" << inference_duration.count() << " s" << std::endl;
+            << "Total inference run time:" << inference_duration.count() << " s" << std::endl
+            << "Avg CPU usage:" << performance_result_.average_CPU_usage << " %" << std::endl
+            << "Peak working set size:" << performance_result_.peak_workingset_size << " bytes" << std::endl;
+
+  if (performance_test_config_.run_config.test_mode == TestMode::kOpenLoopMode) {
+    const auto& run_config = performance_test_config_.run_config;
+    std::cout << "Target request rate:" << run_config.target_qps << " requests/s ("
+              << (run_config.arrival_process == ArrivalProcess::kPoisson ? "poisson" : "constant") << " arrivals)"
+              << std::endl
+              << "Achieved request rate:"
+              << performance_result_.time_costs.size() / static_cast<double>(run_config.duration_in_seconds)
+              << " requests/s" << std::endl
+              << "Max queued requests:" << max_queued_requests_ << std::endl;
+    // latencies include the time spent waiting for a free runner after the scheduled arrival
+    latency_histogram_.Print(std::cout);
+  }
   return Status::OK();
 }
 
@@ -117,7 +137,9 @@ Status PerformanceRunner::RunParallelDuration() {
       count++;
       counter++;
       tpool->Schedule([this, &counter, &m, &cv]() {
-        session_->ThreadSafeRun();
+        auto status = RunOneIteration<false>();
+        if (!status.IsOK())
+          std::cerr << status.ErrorMessage();
         // Simplified version of Eigen::Barrier
         std::lock_guard<std::mutex> lg(m);
         counter--;
@@ -168,6 +190,95 @@ Status PerformanceRunner::ForkJoinRepeat() {
   return Status::OK();
 }
 
+Status PerformanceRunner::RunOpenLoop() {
+  using Clock = std::chrono::steady_clock;
+  const auto& run_config = performance_test_config_.run_config;
+
+  std::mutex m;
+  std::condition_variable cv;
+  std::deque<Clock::time_point> arrivals;  // scheduled start times of the requests waiting for a runner
+  bool done = false;
+  std::string error_message;
+
+  const auto start = Clock::now();
+  const auto measure_start = start + std::chrono::seconds(run_config.warmup_in_seconds);
+  const auto end = measure_start + std::chrono::seconds(run_config.duration_in_seconds);
+
+  // Latency is measured from the scheduled arrival time rather than from when a runner picks the request up,
+  // so time spent queued behind slow requests is included (no coordinated omission).
+  auto runner = [&]() {
+    for (;;) {
+      Clock::time_point arrival;
+      {
+        std::unique_lock<std::mutex> lock(m);
+        cv.wait(lock, [&]() { return done || !arrivals.empty(); });
+        if (arrivals.empty()) {
+          return;
+        }
+        arrival = arrivals.front();
+        arrivals.pop_front();
+      }
+
+      std::chrono::duration<double> duration_seconds;
+      try {
+        duration_seconds = session_->Run();
+      } catch (const std::exception& ex) {
+        std::lock_guard<std::mutex> lock(m);
+        if (error_message.empty()) {
+          error_message = ex.what();
+        }
+        continue;
+      }
+      const auto completion = Clock::now();
+
+      if (arrival >= measure_start) {
+        const std::chrono::duration<double> latency = completion - arrival;
+        std::lock_guard<std::mutex> guard(results_mutex_);
+        latency_histogram_.Record(std::chrono::duration_cast<std::chrono::microseconds>(latency).count());
+        performance_result_.time_costs.emplace_back(latency.count());
+        performance_result_.total_time_cost += duration_seconds.count();
+      }
+    }
+  };
+
+  std::vector<std::thread> runners;
+  for (size_t i = 0; i != run_config.concurrent_session_runs; ++i) {
+    runners.emplace_back(runner);
+  }
+
+  std::mt19937 rand_engine{std::random_device{}()};
+  std::exponential_distribution<double> poisson_interval(run_config.target_qps);
+  const double constant_interval = 1.0 / run_config.target_qps;
+
+  for (auto arrival = start; arrival < end;) {
+    std::this_thread::sleep_until(arrival);
+    {
+      std::lock_guard<std::mutex> lock(m);
+      arrivals.push_back(arrival);
+      max_queued_requests_ = std::max(max_queued_requests_, arrivals.size());
+    }
+    cv.notify_one();
+
+    const double interval = run_config.arrival_process == ArrivalProcess::kPoisson ? poisson_interval(rand_engine)
+                                                                                    : constant_interval;
+    arrival += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(interval));
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m);
+    done = true;
+  }
+  cv.notify_all();
+  for (auto& t : runners) {
+    t.join();
+  }
+
+  if (!error_message.empty()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "PerformanceRunner::RunOpenLoop caught exception: ", error_message);
+  }
+  return Status::OK();
+}
+
 static TestModelInfo* CreateModelInfo(const PerformanceTestConfig& performance_test_config_) {
   if (CompareCString(performance_test_config_.backend.c_str(), ORT_TSTR("ort")) == 0) {
     return TestModelInfo::LoadOnnxModel(performance_test_config_.model_info.model_file_path.c_str());
@@ -220,9 +331,13 @@ bool PerformanceRunner::Initialize() {
 
   // TODO: Place input tensor on cpu memory if dnnl provider type to avoid CopyTensor logic in CopyInputAcrossDevices
   size_t test_data_count = test_case_->GetDataCount();
-  if (test_data_count == 0) {
-    std::cout << "there is no test data for model " << test_case_->GetTestCaseName() << std::endl;
-    return false;
+  if (performance_test_config_.run_config.generate_model_input || test_data_count == 0) {
+    if (!session_->PopulateGeneratedInputTestData()) {
+      std::cout << "there is no test data for model " << test_case_->GetTestCaseName()
+                << " and inputs could not be generated" << std::endl;
+      return false;
+    }
+    test_data_count = 0;
   }
   for (size_t test_data_id = 0; test_data_id != test_data_count; ++test_data_id) {
     std::unordered_map<std::string, OrtValue*> feeds;
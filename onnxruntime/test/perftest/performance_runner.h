@@ -17,6 +17,7 @@
 #include <core/platform/env.h>
 #include <core/session/onnxruntime_cxx_api.h>
 #include "test_configuration.h"
+#include "latency_histogram.h"
 #include "heap_buffer.h"
 #include "test_session.h"
 #include "OrtValueList.h"
@@ -123,6 +124,7 @@ class PerformanceRunner {
   Status RepeatedTimesTest();
   Status ForkJoinRepeat();
   Status RunParallelDuration();
+  Status RunOpenLoop();
 
   inline Status RunFixDuration() {
     while (performance_result_.total_time_cost < performance_test_config_.run_config.duration_in_seconds) {
@@ -150,6 +152,9 @@ class PerformanceRunner {
 
   // TODO: Convert to OrtMutex
   std::mutex results_mutex_;
+  // open loop mode only
+  LatencyHistogram latency_histogram_;
+  size_t max_queued_requests_{0};
 };
 }  // namespace perftest
 }  // namespace onnxruntime
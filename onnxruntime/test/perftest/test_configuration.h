@@ -5,6 +5,8 @@
 
 #include <cstdint>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "core/graph/constants.h"
 #include "core/framework/session_options.h"
@@ -14,7 +16,14 @@ namespace perftest {
 
 enum class TestMode : std::uint8_t {
   kFixDurationMode = 0,
-  KFixRepeatedTimesMode
+  KFixRepeatedTimesMode,
+  kOpenLoopMode
+};
+
+// Distribution of the request arrival times in open loop mode.
+enum class ArrivalProcess : std::uint8_t {
+  kPoisson = 0,
+  kConstant
 };
 
 enum class Platform : std::uint8_t {
@@ -49,6 +58,14 @@ struct RunConfig {
   int inter_op_num_threads{0};
   GraphOptimizationLevel optimization_level{ORT_ENABLE_ALL};
   std::basic_string<ORTCHAR_T> optimized_model_path;
+  // open loop mode: requests are issued at target_qps regardless of how fast they complete
+  double target_qps{0};
+  ArrivalProcess arrival_process{ArrivalProcess::kPoisson};
+  size_t warmup_in_seconds{0};
+  // generate random inputs from the model's input metadata instead of loading test_data_set_* directories
+  bool generate_model_input{false};
+  // values for named free (symbolic) input dimensions of generated inputs. unnamed or unlisted ones default to 1.
+  std::vector<std::pair<std::string, int64_t>> free_dimension_overrides;
 };
 
 struct PerformanceTestConfig {
@@ -11,11 +11,10 @@ namespace perftest {
 class TestSession {
  public:
   virtual std::chrono::duration<double> Run() = 0;
-  // TODO: implement it
-  // This function won't return duration, because it may vary largely.
-  // Please measure the perf at a higher level.
-  void ThreadSafeRun() { abort(); }
   virtual void PreLoadTestData(size_t test_data_id, size_t input_id, OrtValue* value) = 0;
+  // Fill the inputs with random data generated from the model's input metadata instead of preloaded test data.
+  // Returns false if the backend doesn't support it or an input isn't a tensor.
+  virtual bool PopulateGeneratedInputTestData() { return false; }
 
   virtual ~TestSession() = default;
 };
@@ -24,6 +24,7 @@ struct RunOptions {
   bool scalar_loop_state_value = false;
   bool add_bad_shape = false;
   bool mixed_execution_providers = false;
+  ExecutionMode execution_mode = ExecutionMode::ORT_SEQUENTIAL;
   // Disable TensorRT because its parser fails, and it can't handle unknown dimensions
   std::unordered_set<std::string> excluded_provider_types{kTensorrtExecutionProvider};
 };
@@ -312,7 +313,8 @@ static void RunTest_v8(const std::string test_name, int64_t batch_size, int64_t
   test.AddOutput<float>("scan_output_2", output_shape, output_2);
   test.AddOutput<float>("scan_output_3", output_shape, output_3);
 
-  test.Run(expect_result, failure_message, options.excluded_provider_types);
+  test.Run(expect_result, failure_message, options.excluded_provider_types, nullptr, nullptr,
+           options.execution_mode);
 }
 
 static void RunTest_v9(const std::string test_name, int64_t sequence_len, int64_t input_size,
@@ -407,7 +409,8 @@ static void RunTest_v9(const std::string test_name, int64_t sequence_len, int64_
 
     test.Run(expect_result, failure_message, options.excluded_provider_types, nullptr, &execution_providers);
   } else {
-    test.Run(expect_result, failure_message, options.excluded_provider_types);
+    test.Run(expect_result, failure_message, options.excluded_provider_types, nullptr, nullptr,
+             options.execution_mode);
   }
 }
 
@@ -604,7 +607,7 @@ TEST(Scan8, ShortSequenceTwoInBatchOneLoopStateVar) {
              iteration_count_out, output_0, output_1, output_2, output_3);
 }
 
-TEST(Scan8, MixedSequenceLens) {
+static void MixedSequenceLens(const RunOptions& options) {
   const int64_t batch_size = 3;
   const int64_t max_sequence_len = 2;
   const int64_t input_size = 2;
@@ -648,7 +651,18 @@ TEST(Scan8, MixedSequenceLens) {
   RunTest_v8("MixedSequenceLens", batch_size, max_sequence_len, input_size,
              nullptr, &sequence_lens,
              iteration_count_in, input_0, input_1,
-             iteration_count_out, output_0, output_1, output_2, output_3);
+             iteration_count_out, output_0, output_1, output_2, output_3, options);
+}
+
+TEST(Scan8, MixedSequenceLens) {
+  MixedSequenceLens({});
+}
+
+// batch entries are executed concurrently on the inter-op thread pool
+TEST(Scan8, MixedSequenceLensParallelExecution) {
+  RunOptions options{};
+  options.execution_mode = ExecutionMode::ORT_PARALLEL;
+  MixedSequenceLens(options);
 }
 
 TEST(Scan8, MixedSequenceLensReverse) {
@@ -791,6 +805,87 @@ TEST(Scan9, ReversedOutput) {
              iteration_count_out, output_0, output_1, output_2, output_3);
 }
 
+// the subgraph doesn't read the loop state variable so the iterations can be executed concurrently
+static void IndependentIterations(bool reverse_output, ExecutionMode execution_mode) {
+  Model model("IndependentIterations", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  /* Subgraph looks like this. loop_state_in is an input but is not used.
+
+    loop_state_in        scan_in
+                        /       \
+                [ReduceMax]     [Neg]
+                     |            |
+              loop_state_out   scan_out
+  */
+  TypeProto float_1;
+  float_1.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_1.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+  TypeProto float_2;
+  float_2.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_2.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+  auto& loop_state_in = graph.GetOrCreateNodeArg("loop_state_in", &float_1);
+  auto& scan_in = graph.GetOrCreateNodeArg("scan_in", &float_2);
+  auto& loop_state_out = graph.GetOrCreateNodeArg("loop_state_out", &float_1);
+  auto& scan_out = graph.GetOrCreateNodeArg("scan_out", &float_2);
+
+  auto& reduce_max = graph.AddNode("reduce_max", "ReduceMax", "Max of scan input", {&scan_in}, {&loop_state_out});
+  reduce_max.AddAttribute("keepdims", int64_t{1});
+  graph.AddNode("neg", "Neg", "Negate scan input", {&scan_in}, {&scan_out});
+
+  graph.SetInputs({&loop_state_in, &scan_in});
+  graph.SetOutputs({&loop_state_out, &scan_out});
+
+  auto status = graph.Resolve();
+  ASSERT_EQ(status, Status::OK());
+
+  auto& proto = graph.ToGraphProto();
+
+  ScanOpTester test{11};
+  test.AddAttribute("body", proto);
+  test.AddAttribute<int64_t>("num_scan_inputs", 1);
+
+  if (reverse_output) {
+    test.AddAttribute<std::vector<int64_t>>("scan_output_directions", {1});
+  }
+
+  test.AddInput<float>("scan_loop_state_in", {1}, {100.f});
+  test.AddInput<float>("scan_input", {4, 2}, {1.f, 2.f,
+                                              4.f, 3.f,
+                                              5.f, 6.f,
+                                              8.f, 7.f});
+
+  // final loop state is from the last iteration
+  test.AddOutput<float>("scan_loop_state_out", {1}, {8.f});
+
+  if (reverse_output) {
+    test.AddOutput<float>("scan_output", {4, 2}, {-8.f, -7.f,
+                                                  -5.f, -6.f,
+                                                  -4.f, -3.f,
+                                                  -1.f, -2.f});
+  } else {
+    test.AddOutput<float>("scan_output", {4, 2}, {-1.f, -2.f,
+                                                  -4.f, -3.f,
+                                                  -5.f, -6.f,
+                                                  -8.f, -7.f});
+  }
+
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", RunOptions().excluded_provider_types, nullptr, nullptr,
+           execution_mode);
+}
+
+TEST(Scan9, IndependentIterations) {
+  IndependentIterations(false, ExecutionMode::ORT_SEQUENTIAL);
+  IndependentIterations(true, ExecutionMode::ORT_SEQUENTIAL);
+}
+
+TEST(Scan9, IndependentIterationsParallelExecution) {
+  IndependentIterations(false, ExecutionMode::ORT_PARALLEL);
+  IndependentIterations(true, ExecutionMode::ORT_PARALLEL);
+}
+
 TEST(Scan9, TransposeInput) {
   const int64_t sequence_len = 2;
   const int64_t input_size = 2;
@@ -27,14 +27,14 @@ TEST(GemmOpTest, GemmNoTrans) {
   test.Run();
 }
 
-// Only CUDA kernel has float 16 support
-#ifdef USE_CUDA
 TEST(GemmOpTest, GemmNoTrans_f16) {
+#ifdef USE_CUDA
   int min_cuda_architecture = 530;
   if (!HasCudaEnvironment(min_cuda_architecture)) {
     LOGS_DEFAULT(WARNING) << "Hardware NOT support FP16";
     return;
   }
+#endif
   OpTester test("Gemm");
 
   test.AddAttribute("transA", (int64_t)0);
@@ -64,7 +64,6 @@ TEST(GemmOpTest, GemmNoTrans_f16) {
   test.AddOutput<MLFloat16>("Y", {2, 3}, f_Y);
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider}); //TensorRT: fp16 is not supported
 }
-#endif
 
 TEST(GemmOpTest, GemmBroadcast) {
   OpTester test("Gemm");
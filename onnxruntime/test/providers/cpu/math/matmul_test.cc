@@ -101,6 +101,62 @@ void RunMatMulTest(int32_t opset_version = 7)
   }
 }
 
+// Batched MatMul with enough matrices, rows and K/N to span several threads and cache blocks.
+template <typename T>
+void RunMatMulBatchTest(int32_t opset_version, bool broadcast_b) {
+  const int64_t batch = 6, M = 5, K = 131, N = 262;
+
+  std::vector<T> input0_vals(batch * M * K);
+  for (size_t i = 0; i < input0_vals.size(); i++) {
+    input0_vals[i] = static_cast<T>(i % 7);
+  }
+  const int64_t batch_b = broadcast_b ? 1 : batch;
+  std::vector<T> input1_vals(batch_b * K * N);
+  for (size_t i = 0; i < input1_vals.size(); i++) {
+    input1_vals[i] = static_cast<T>(i % 5);
+  }
+
+  std::vector<T> expected_vals(batch * M * N);
+  for (int64_t b = 0; b < batch; b++) {
+    const T* a = input0_vals.data() + b * M * K;
+    const T* bm = input1_vals.data() + (broadcast_b ? 0 : b * K * N);
+    for (int64_t m = 0; m < M; m++) {
+      for (int64_t n = 0; n < N; n++) {
+        T sum = 0;
+        for (int64_t k = 0; k < K; k++) {
+          sum += a[m * K + k] * bm[k * N + n];
+        }
+        expected_vals[(b * M + m) * N + n] = sum;
+      }
+    }
+  }
+
+  OpTester test("MatMul", opset_version);
+  test.AddInput<T>("A", {2, 3, M, K}, input0_vals);
+  if (broadcast_b) {
+    test.AddInput<T>("B", {K, N}, input1_vals);
+  } else {
+    test.AddInput<T>("B", {2, 3, K, N}, input1_vals);
+  }
+  test.AddOutput<T>("Y", {2, 3, M, N}, expected_vals);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
+TEST(MathOpTest, MatMulBatchFloatType) {
+  RunMatMulBatchTest<float>(7, false);
+  RunMatMulBatchTest<float>(7, true);
+}
+
+TEST(MathOpTest, MatMulBatchInt32Type) {
+  RunMatMulBatchTest<int32_t>(9, false);
+  RunMatMulBatchTest<int32_t>(9, true);
+}
+
+TEST(MathOpTest, MatMulBatchUint64Type) {
+  RunMatMulBatchTest<uint64_t>(9, false);
+  RunMatMulBatchTest<uint64_t>(9, true);
+}
+
 TEST(MathOpTest, MatMulFloatType) {
   RunMatMulTest<float>(7);
 }
@@ -109,6 +165,31 @@ TEST(MathOpTest, MatMulDoubleType) {
   RunMatMulTest<double>(7);
 }
 
+TEST(MathOpTest, MatMulFloat16Type) {
+  std::vector<float> common_input_vals{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+  for (auto t : GenerateTestCases<float>()) {
+    for (int32_t opset_version : {7, 9}) {
+      OpTester test("MatMul", opset_version);
+
+      int64_t size0 = TensorShape::ReinterpretBaseType(t.input0_dims).SizeHelper(0, t.input0_dims.size());
+      std::vector<MLFloat16> input0_vals(size0);
+      ConvertFloatToMLFloat16(common_input_vals.data(), input0_vals.data(), static_cast<int>(size0));
+      test.AddInput<MLFloat16>("A", t.input0_dims, input0_vals);
+
+      int64_t size1 = TensorShape::ReinterpretBaseType(t.input1_dims).SizeHelper(0, t.input1_dims.size());
+      std::vector<MLFloat16> input1_vals(size1);
+      ConvertFloatToMLFloat16(common_input_vals.data(), input1_vals.data(), static_cast<int>(size1));
+      test.AddInput<MLFloat16>("B", t.input1_dims, input1_vals);
+
+      std::vector<MLFloat16> expected_vals(t.expected_vals.size());
+      ConvertFloatToMLFloat16(t.expected_vals.data(), expected_vals.data(), static_cast<int>(expected_vals.size()));
+      test.AddOutput<MLFloat16>("Y", t.expected_dims, expected_vals);
+
+      test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+    }
+  }
+}
+
 TEST(MathOpTest, MatMulInt32Type) {
   RunMatMulTest<int32_t>(9);
 }
@@ -25,6 +25,24 @@ TEST(MLOpTest, DictVectorizerStringInput) {
   test.Run();
 }
 
+TEST(MLOpTest, DictVectorizerStringInputDuplicatedVocabulary) {
+  OpTester test("DictVectorizer", 1, onnxruntime::kMLDomain);
+
+  test.AddAttribute("string_vocabulary", std::vector<std::string>{"a", "b", "a", "c"});
+
+  std::map<std::string, int64_t> map;
+  map["a"] = 1;
+  map["c"] = 2;
+  map["z"] = 5;
+
+  test.AddInput<std::string, int64_t>("X", map);
+
+  std::vector<int64_t> dims{1, 4};
+  test.AddOutput<int64_t>("Y", dims,
+                          {1, 0, 1, 2});
+  test.Run();
+}
+
 TEST(MLOpTest, DictVectorizerInt64Input) {
   OpTester test("DictVectorizer", 1, onnxruntime::kMLDomain);
 
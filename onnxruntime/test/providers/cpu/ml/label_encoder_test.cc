@@ -63,6 +63,42 @@ TEST(LabelEncoder, StringToIntOpset2) {
   test.Run();
 }
 
+TEST(LabelEncoder, StringToIntOpset2ManyKeys) {
+  const int64_t key_count = 1000;
+  std::vector<std::string> keys;
+  std::vector<std::int64_t> values;
+  for (int64_t i = 0; i < key_count; ++i) {
+    keys.push_back("key" + std::to_string(i));
+    values.push_back(i * 3);
+  }
+
+  // every other input is a key, the others are missing from the keys
+  std::vector<std::int64_t> dims{64, 64};
+  std::vector<std::string> input;
+  std::vector<std::int64_t> output;
+  for (int64_t i = 0; i < 64 * 64; ++i) {
+    const int64_t k = (i * 7) % (2 * key_count);
+    if (k % 2 == 0) {
+      input.push_back("key" + std::to_string(k / 2));
+      output.push_back((k / 2) * 3);
+    } else {
+      input.push_back("missing" + std::to_string(k));
+      output.push_back(-1);
+    }
+  }
+
+  OpTester test("LabelEncoder", 2, onnxruntime::kMLDomain);
+
+  test.AddAttribute("keys_strings", keys);
+  test.AddAttribute("values_int64s", values);
+  test.AddAttribute("default_int64", (std::int64_t)-1);
+
+  test.AddInput<std::string>("X", dims, input);
+  test.AddOutput<std::int64_t>("Y", dims, output);
+
+  test.Run();
+}
+
 TEST(LabelEncoder, IntToStringOpset2) {
   std::vector<std::int64_t> dims{1, 5};
 
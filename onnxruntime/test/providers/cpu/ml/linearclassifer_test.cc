@@ -80,6 +80,31 @@ TEST(MLOpTest, LinearClassifierMulticlassProbSigmoid) {
   test.Run();
 }
 
+TEST(MLOpTest, LinearClassifierMulticlassProbSoftmax) {
+  OpTester test("LinearClassifier", 1, onnxruntime::kMLDomain);
+
+  std::vector<float> coefficients = {-0.22562418f, 0.34188559f, 0.68346153f, -0.68051993f, -0.1975279f, 0.03748541f};
+  std::vector<int64_t> classes = {1, 2, 3};
+  std::vector<float> X = {1.f, 0.f, 3.f, 44.f, 23.f, 11.3f};
+
+  //three estimates, for 3 points each, so 9 predictions
+  std::vector<float> predictions = {0.00398469397f, 0.760002182f, 0.236013124f, 0.999904471f, 3.41111824e-17f, 9.55286521e-05f, 1.12517818e-06f, 0.999994909f, 3.96602525e-06f};
+  std::vector<float> intercepts = {-3.91601811f, 0.42575697f, 0.13731251f};
+  std::vector<int64_t> predicted_class = {2, 1, 2};
+
+  std::string trans("SOFTMAX");
+  test.AddAttribute("coefficients", coefficients);
+  test.AddAttribute("intercepts", intercepts);
+  test.AddAttribute("classlabels_ints", classes);
+  test.AddAttribute("post_transform", trans);
+
+  test.AddInput<float>("X", {3, 2}, X);
+  test.AddOutput<int64_t>("Y", {3}, predicted_class);
+  test.AddOutput<float>("Z", {3, 3}, predictions);
+  test.SetOutputAbsErr("Z", 0.0001f);
+  test.Run();
+}
+
 TEST(MLOpTest, LinearClassifierBinary) {
   OpTester test("LinearClassifier", 1, onnxruntime::kMLDomain);
 
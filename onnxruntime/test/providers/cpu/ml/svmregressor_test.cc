@@ -32,6 +32,32 @@ TEST(MLOpTest, SVMRegressorSVC) {
   test.Run();
 }
 
+TEST(MLOpTest, SVMRegressorSVCNearbyLargeSupportVectors) {
+  OpTester test("SVMRegressor", 1, onnxruntime::kMLDomain);
+
+  // the points are a fraction apart but thousands away from the origin, so |x|^2 + |b|^2 - 2 x.b cancels to
+  // nothing in float and the distances have to be computed directly
+  std::vector<float> dual_coefficients = {1.f, -0.5f, 2.f};
+  std::vector<float> support_vectors = {3000.f, -2000.f, 1000.f, 3000.5f, -2000.f, 1000.f, 3000.f, -1999.25f, 1000.5f};
+  std::vector<float> rho = {0.25f};
+  std::vector<float> kernel_params = {0.5f, 0.f, 3.f};  //gamma, coef0, degree
+
+  std::vector<float> X = {3000.25f, -2000.f, 1000.f, 3000.f, -1999.5f, 1000.25f, 3001.f, -2000.f, 999.5f};
+  std::vector<float> predictions = {2.02591372f, 2.60675168f, 0.95124096f};
+
+  test.AddAttribute("kernel_type", std::string("RBF"));
+  test.AddAttribute("coefficients", dual_coefficients);
+  test.AddAttribute("support_vectors", support_vectors);
+  test.AddAttribute("rho", rho);
+  test.AddAttribute("kernel_params", kernel_params);
+  test.AddAttribute("n_supports", static_cast<int64_t>(3));
+
+  test.AddInput<float>("X", {3, 3}, X);
+  test.AddOutput<float>("Y", {3, 1}, predictions);
+
+  test.Run();
+}
+
 TEST(MLOpTest, SVMRegressorNuSVC) {
   OpTester test("SVMRegressor", 1, onnxruntime::kMLDomain);
 
@@ -82,6 +108,30 @@ TEST(MLOpTest, SVMRegressorNuSVCPolyKernel) {
   test.Run();
 }
 
+TEST(MLOpTest, SVMRegressorNuSVCSigmoidKernel) {
+  OpTester test("SVMRegressor", 1, onnxruntime::kMLDomain);
+
+  std::vector<float> dual_coefficients = {-1.7902966f, 1.05962596f, -1.54324389f, -0.43658884f, 0.79025169f, 1.92025169f};
+  std::vector<float> support_vectors = {0.f, 0.5f, 32.f, 1.f, 1.5f, 1.f, 2.f, 2.9f, -32.f, 3.f, 13.3f, -11.f, 12.f, 12.9f, -312.f, 43.f, 413.3f, -114.f};
+  std::vector<float> rho = {1.96923464f};
+  std::vector<float> kernel_params = {0.001f, 0.5f, 3.f};  //gamma, coef0, degree
+
+  std::vector<float> X = {1.f, 0.0f, 0.4f, 3.0f, 44.0f, -3.f, 12.0f, 12.9f, -312.f, 23.0f, 11.3f, -222.f, 23.0f, 3311.3f, -222.f, 43.0f, 413.3f, -114.f};
+  std::vector<float> predictions = {1.88857790f, 3.16193057f, 4.71919499f, 4.81775689f, 5.54959131f, 5.30829835f};
+
+  test.AddAttribute("kernel_type", std::string("SIGMOID"));
+  test.AddAttribute("coefficients", dual_coefficients);
+  test.AddAttribute("support_vectors", support_vectors);
+  test.AddAttribute("rho", rho);
+  test.AddAttribute("kernel_params", kernel_params);
+  test.AddAttribute("n_supports", static_cast<int64_t>(6));
+
+  test.AddInput<float>("X", {6, 3}, X);
+  test.AddOutput<float>("Y", {6, 1}, predictions);
+
+  test.Run();
+}
+
 TEST(MLOpTest, SVMRegressorLinear) {
   OpTester test("SVMRegressor", 1, onnxruntime::kMLDomain);
   std::vector<float> coefficients = {0.28290501f, -0.0266512f, 0.01674867f};
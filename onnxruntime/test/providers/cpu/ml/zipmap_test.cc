@@ -55,6 +55,15 @@ TEST(MLOpTest, ZipMapOpInt64Float1D) {
   TestHelper<int64_t>({10, 20, 30, 40, 50, 60}, "int64_t", {6});
 }
 
+// labels that are not in map order
+TEST(MLOpTest, ZipMapOpStringFloatUnsortedLabels) {
+  TestHelper<string>({"class3", "class1", "class2"}, "string", {2, 3});
+}
+
+TEST(MLOpTest, ZipMapOpInt64FloatUnsortedLabels) {
+  TestHelper<int64_t>({30, -10, 20}, "int64_t", {2, 3});
+}
+
 // Negative test cases
 TEST(MLOpTest, ZipMapOpStringFloatStrideMoreThanNumLabels) {
   TestHelper<string>({"class1", "class2", "class3"}, "string", {1, 6}, OpTester::ExpectResult::kExpectFailure);
@@ -58,6 +58,34 @@ void TestConvOp(const ConvOpAndTestAttributes& attributes,
   test.Run(expect_result, err_str, excluded_providers);
 }
 
+// Runs Conv on MLFloat16 tensors. The values should be small integers so that they, the products and the sums
+// are exact in half precision.
+void TestConvFp16Op(const ConvOpAndTestAttributes& attributes,
+                    const vector<vector<float>>& inputs,
+                    const vector<vector<int64_t>>& input_shapes,
+                    const vector<float>& expected_output,
+                    const vector<int64_t>& expected_output_shape,
+                    bool weight_is_initializer = false) {
+  OpTester test("Conv", 11);
+  test.AddAttribute("group", attributes.group);
+  test.AddAttribute("kernel_shape", attributes.kernel_shape);
+  test.AddAttribute("pads", attributes.pads);
+  test.AddAttribute("strides", attributes.strides);
+
+  const char* szNames[] = {"X", "W", "B"};
+  for (size_t i = 0; i < inputs.size(); i++) {
+    vector<MLFloat16> values(inputs[i].size());
+    ConvertFloatToMLFloat16(inputs[i].data(), values.data(), static_cast<int>(values.size()));
+    test.AddInput<MLFloat16>(szNames[i], input_shapes[i], values, i == 1 && weight_is_initializer);
+  }
+
+  vector<MLFloat16> expected(expected_output.size());
+  ConvertFloatToMLFloat16(expected_output.data(), expected.data(), static_cast<int>(expected.size()));
+  test.AddOutput<MLFloat16>("Y", expected_output_shape, expected);
+
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
 }  // namespace
 
 // Conv
@@ -632,5 +660,95 @@ TEST(ConvTest, ConvDimWithZero) {
   TestConvOp(attrs, {X, W}, {X_shape, W_shape}, {}, out_shape, OpTester::ExpectResult::kExpectSuccess, "", 10);
 }
 
+TEST(ConvTest, Conv2D_Float16_Bias) {
+  ConvOpAndTestAttributes attrs = {
+      "",                           // auto_pad
+      vector<int64_t>{1, 1},        // dilations
+      1,                            // group
+      vector<int64_t>{3, 3},        // kernel_shape
+      vector<int64_t>{1, 1, 1, 1},  // pads
+      vector<int64_t>{2, 2},        // strides
+      {}                            // excluded EPs
+  };
+
+  vector<float> X = {
+      -5.0f, 2.0f, -2.0f, 5.0f, 1.0f, -3.0f, 4.0f, 0.0f, -4.0f, 3.0f, -1.0f, -5.0f, 2.0f, -2.0f, 5.0f, 1.0f, -3.0f,
+      4.0f, 0.0f, -4.0f, 3.0f, -1.0f, -5.0f, 2.0f, -2.0f, 5.0f, 1.0f, -3.0f, 4.0f, 0.0f, -4.0f, 3.0f, -1.0f, -5.0f,
+      2.0f, -2.0f, 5.0f, 1.0f, -3.0f, 4.0f, 0.0f, -4.0f, 3.0f, -1.0f, -5.0f, 2.0f, -2.0f, 5.0f, 1.0f, -3.0f};
+  vector<int64_t> X_shape = {1, 2, 5, 5};
+  vector<float> W = {
+      -3.0f, 2.0f, 0.0f, -2.0f, 3.0f, 1.0f, -1.0f, -3.0f, 2.0f, 0.0f, -2.0f, 3.0f, 1.0f, -1.0f, -3.0f, 2.0f, 0.0f,
+      -2.0f, 3.0f, 1.0f, -1.0f, -3.0f, 2.0f, 0.0f, -2.0f, 3.0f, 1.0f, -1.0f, -3.0f, 2.0f, 0.0f, -2.0f, 3.0f, 1.0f,
+      -1.0f, -3.0f, 2.0f, 0.0f, -2.0f, 3.0f, 1.0f, -1.0f, -3.0f, 2.0f, 0.0f, -2.0f, 3.0f, 1.0f, -1.0f, -3.0f, 2.0f,
+      0.0f, -2.0f, 3.0f};
+  vector<int64_t> W_shape = {3, 2, 3, 3};
+  vector<float> B = {1.0f, -2.0f, 3.0f};
+  vector<int64_t> B_shape = {3};
+  vector<int64_t> Y_shape = {1, 3, 3, 3};
+  vector<float> expected_vals = {
+      -9.0f, -8.0f, -17.0f, -10.0f, -12.0f, 37.0f, 3.0f, -12.0f, -3.0f, -29.0f, 13.0f, -5.0f, 38.0f, 26.0f, -12.0f,
+      -10.0f, -28.0f, 6.0f, -6.0f, -7.0f, 29.0f, -4.0f, -12.0f, 3.0f, -1.0f, -8.0f, 2.0f};
+
+  TestConvFp16Op(attrs, {X, W, B}, {X_shape, W_shape, B_shape}, expected_vals, Y_shape);
+  TestConvFp16Op(attrs, {X, W, B}, {X_shape, W_shape, B_shape}, expected_vals, Y_shape, true);
+}
+
+TEST(ConvTest, Conv2D_Float16_Group) {
+  ConvOpAndTestAttributes attrs = {
+      "",                           // auto_pad
+      vector<int64_t>{1, 1},        // dilations
+      2,                            // group
+      vector<int64_t>{2, 2},        // kernel_shape
+      vector<int64_t>{0, 0, 0, 0},  // pads
+      vector<int64_t>{1, 1},        // strides
+      {}                            // excluded EPs
+  };
+
+  vector<float> X = {
+      -6.0f, 1.0f, -5.0f, 2.0f, -4.0f, 3.0f, -3.0f, 4.0f, -2.0f, 5.0f, -1.0f, 6.0f, 0.0f, -6.0f, 1.0f, -5.0f, 2.0f,
+      -4.0f, 3.0f, -3.0f, 4.0f, -2.0f, 5.0f, -1.0f, 6.0f, 0.0f, -6.0f, 1.0f, -5.0f, 2.0f, -4.0f, 3.0f, -3.0f, 4.0f,
+      -2.0f, 5.0f, -1.0f, 6.0f, 0.0f, -6.0f, 1.0f, -5.0f, 2.0f, -4.0f, 3.0f, -3.0f, 4.0f, -2.0f, 5.0f, -1.0f, 6.0f,
+      0.0f, -6.0f, 1.0f, -5.0f, 2.0f, -4.0f, 3.0f, -3.0f, 4.0f, -2.0f, 5.0f, -1.0f, 6.0f, 0.0f, -6.0f, 1.0f, -5.0f,
+      2.0f, -4.0f, 3.0f, -3.0f};
+  vector<int64_t> X_shape = {2, 4, 3, 3};
+  vector<float> W = {
+      -2.0f, 0.0f, 2.0f, -1.0f, 1.0f, -2.0f, 0.0f, 2.0f, -1.0f, 1.0f, -2.0f, 0.0f, 2.0f, -1.0f, 1.0f, -2.0f, 0.0f,
+      2.0f, -1.0f, 1.0f, -2.0f, 0.0f, 2.0f, -1.0f, 1.0f, -2.0f, 0.0f, 2.0f, -1.0f, 1.0f, -2.0f, 0.0f};
+  vector<int64_t> W_shape = {4, 2, 2, 2};
+  vector<int64_t> Y_shape = {2, 4, 2, 2};
+  vector<float> expected_vals = {
+      15.0f, -24.0f, 2.0f, 2.0f, 26.0f, -14.0f, -3.0f, -4.0f, -12.0f, 21.0f, 22.0f, -23.0f, 21.0f, -12.0f, -13.0f,
+      -7.0f, -24.0f, 15.0f, 15.0f, -24.0f, 16.0f, -11.0f, 26.0f, -14.0f, -7.0f, -13.0f, -12.0f, 21.0f, -23.0f, 22.0f,
+      21.0f, -12.0f};
+
+  TestConvFp16Op(attrs, {X, W}, {X_shape, W_shape}, expected_vals, Y_shape, true);
+}
+
+TEST(ConvTest, Conv1D_Float16_Pointwise) {
+  ConvOpAndTestAttributes attrs = {
+      "",                     // auto_pad
+      vector<int64_t>{1},     // dilations
+      1,                      // group
+      vector<int64_t>{1},     // kernel_shape
+      vector<int64_t>{0, 0},  // pads
+      vector<int64_t>{1},     // strides
+      {}                      // excluded EPs
+  };
+
+  vector<float> X = {
+      -3.0f, 2.0f, 0.0f, -2.0f, 3.0f, 1.0f, -1.0f, -3.0f, 2.0f, 0.0f, -2.0f, 3.0f};
+  vector<int64_t> X_shape = {1, 3, 4};
+  vector<float> W = {
+      -2.0f, 1.0f, -1.0f, 2.0f, 0.0f, -2.0f};
+  vector<int64_t> W_shape = {2, 3, 1};
+  vector<float> B = {2.0f, -1.0f};
+  vector<int64_t> B_shape = {2};
+  vector<int64_t> Y_shape = {1, 2, 4};
+  vector<float> expected_vals = {
+      9.0f, -1.0f, 3.0f, 0.0f, -11.0f, 3.0f, 3.0f, -11.0f};
+
+  TestConvFp16Op(attrs, {X, W, B}, {X_shape, W_shape, B_shape}, expected_vals, Y_shape);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
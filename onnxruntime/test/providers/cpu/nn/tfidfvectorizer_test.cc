@@ -669,5 +669,30 @@ TEST(TfIdfVectorizerTest, String_TFIDFWeights_onlyBigrams_Skip5) {
   test.Run(OpTester::ExpectResult::kExpectSuccess);
 }
 
+TEST(TfIdfVectorizerTest, Int32_TFIDFWeights_BatchUniAndBigrams_Skip5) {
+  OpTester test("TfIdfVectorizer", opset_ver);
+  // s=5, Min=1, Max=2, weights specified, int32
+  // Every row is scaled by the same weights
+  InitTestAttr(test, "TFIDF", 1, 2, 5,
+               {0, 4},
+               {0, 1, 2, 3, 4, 5, 6},                //7 output indexes
+               {1.0, 2.0, 1.0, 1.0, 1.0, 3.0, 0.5},  // weights
+               {2, 3, 5, 4,                          //1-grams
+                5, 6, 7, 8, 6, 7},                   //bi-grams
+               {});
+
+  std::vector<int64_t> dims{2, 6};
+  std::vector<int32_t> input = {1, 1, 3, 3, 3, 7,
+                                8, 6, 7, 5, 6, 8};
+  test.AddInput<int32_t>("T", dims, input);
+
+  std::vector<int64_t> out_dims{2, 7};
+  std::vector<float> output = {0, 6, 0, 0, 0, 0, 0,
+                               0, 0, 1, 0, 1, 3, 0.5};
+  test.AddOutput<float>("Y", out_dims, output);
+
+  test.Run(OpTester::ExpectResult::kExpectSuccess);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -107,6 +107,42 @@ TEST(ConcatOpTest, Concat2D_3) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider}); //TensorRT: no support for dynamic shape tensor
 }
 
+TEST(ConcatOpTest, Concat2D_large) {
+  OpTester test("Concat");
+  test.AddAttribute("axis", int64_t{1});
+
+  // large enough for the rows to be split across the thread pool
+  const int64_t rows = 1000;
+  const std::vector<int64_t> widths{3, 16, 5};
+  std::vector<std::vector<float>> inputs(widths.size());
+  std::vector<float> output;
+  for (int64_t row = 0; row < rows; ++row) {
+    for (size_t i = 0; i < widths.size(); ++i) {
+      for (int64_t col = 0; col < widths[i]; ++col) {
+        float value = static_cast<float>(row * 100 + i * 20 + col);
+        inputs[i].push_back(value);
+        output.push_back(value);
+      }
+    }
+  }
+
+  test.AddInput<float>("input1", {rows, widths[0]}, inputs[0]);
+  test.AddInput<float>("input2", {rows, widths[1]}, inputs[1]);
+  test.AddInput<float>("input3", {rows, widths[2]}, inputs[2]);
+  test.AddOutput<float>("concat_result", {rows, 24}, output);
+  test.Run();
+}
+
+TEST(ConcatOpTest, Concat2D_string) {
+  OpTester test("Concat");
+  test.AddAttribute("axis", int64_t{1});
+
+  test.AddInput<std::string>("input1", {2, 1}, {"a", "b"});
+  test.AddInput<std::string>("input2", {2, 2}, {"c", "d", "e", "f"});
+  test.AddOutput<std::string>("concat_result", {2, 3}, {"a", "c", "d", "b", "e", "f"});
+  test.Run();
+}
+
 TEST(ConcatOpTest, Concat3D_1) {
   OpTester test("Concat");
   test.AddAttribute("axis", int64_t{0});
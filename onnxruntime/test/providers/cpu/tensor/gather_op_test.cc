@@ -274,6 +274,22 @@ TEST(GatherOpTest, Gather_axis1_indices2d_string) {
   test.Run();
 }
 
+TEST(GatherOpTest, Gather_axis0_string_rows) {
+  OpTester test("Gather");
+  test.AddAttribute<int64_t>("axis", 0LL);
+  test.AddInput<std::string>("data", {3, 2},
+                             {"0", "1",
+                              "10", "11",
+                              "20", "21"});
+  test.AddInput<int64_t>("indices", {3},
+                         {2, 0, -1});
+  test.AddOutput<std::string>("output", {3, 2},
+                              {"20", "21",
+                               "0", "1",
+                               "20", "21"});
+  test.Run();
+}
+
 TEST(GatherOpTest, Gather_axis1_indices2d_bool) {
   OpTester test("Gather");
   test.AddAttribute<int64_t>("axis", 1LL);
@@ -306,6 +322,30 @@ TEST(GatherOpTest, Gather_perf) {
   test.Run();
 }
 
+TEST(GatherOpTest, Gather_embedding_rows) {
+  OpTester test("Gather");
+  test.AddAttribute<int64_t>("axis", 0LL);
+
+  // large enough for the copy to be split across the thread pool
+  const int64_t rows = 1000, width = 16, count = 2000;
+  std::vector<float> input(rows * width);
+  for (size_t i = 0; i < input.size(); ++i)
+    input[i] = static_cast<float>(i);
+
+  std::vector<int64_t> indices(count);
+  std::vector<float> output;
+  output.reserve(count * width);
+  for (int64_t i = 0; i < count; ++i) {
+    indices[i] = (i * 7919) % rows;
+    output.insert(output.end(), input.begin() + indices[i] * width, input.begin() + (indices[i] + 1) * width);
+  }
+
+  test.AddInput<float>("data", {rows, width}, input);
+  test.AddInput<int64_t>("indices", {count}, indices);
+  test.AddOutput<float>("output", {count, width}, output);
+  test.Run();
+}
+
 TEST(GatherOpTest, Gather_axis1_neg_indices2d_int8) {
   OpTester test("Gather", 11);
   test.AddAttribute<int64_t>("axis", 1LL);
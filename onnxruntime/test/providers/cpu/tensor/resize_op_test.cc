@@ -198,6 +198,72 @@ TEST(ResizeOpTest, ResizeOpLineartUpSampleTest_2DBilinear_align_corners) {
   test.Run();
 }
 
+TEST(ResizeOpTest, ResizeOpLineartUpSampleTest_4DBilinear_uint8) {
+  // the weights of a 2x half_pixel upsampling are exact in fixed point
+  OpTester test("Resize", 11);
+  std::vector<float> roi{};
+  std::vector<float> scales{1.0f, 1.0f, 2.0f, 2.0f};
+
+  test.AddAttribute("mode", "linear");
+
+  const int64_t N = 1, C = 2, H = 3, W = 3;
+  std::vector<uint8_t> X = {0, 10, 255,
+                            31, 7, 128,
+                            200, 65, 3,
+
+                            9, 250, 17,
+                            100, 33, 254,
+                            1, 80, 161};
+
+  test.AddInput<uint8_t>("X", {N, C, H, W}, X);
+  test.AddInput<float>("roi", {0}, roi);
+  test.AddInput<float>("scales", {4}, scales);
+
+  std::vector<uint8_t> Y = {
+      0, 2, 7, 71, 193, 255,
+      7, 8, 8, 62, 169, 223,
+      23, 19, 11, 45, 121, 159,
+      73, 60, 34, 40, 77, 96,
+      157, 130, 77, 46, 38, 34,
+      200, 166, 98, 49, 18, 3,
+
+      9, 69, 189, 191, 75, 17,
+      31, 72, 154, 165, 106, 76,
+      77, 79, 84, 114, 167, 194,
+      75, 67, 52, 91, 184, 230,
+      25, 36, 57, 97, 155, 184,
+      1, 20, 60, 100, 140, 161};
+
+  test.AddOutput<uint8_t>("Y", {N, C, static_cast<int64_t>(H * scales[2]), static_cast<int64_t>(W * scales[3])}, Y);
+  test.Run();
+}
+
+TEST(ResizeOpTest, ResizeOpLineartUpSampleTest_2DBilinear_align_corners_uint8) {
+  // the weights are not exact in fixed point, so the pixels are computed in float
+  OpTester test("Resize", 11);
+  std::vector<float> roi{};
+  std::vector<float> scales{2.0f, 4.0f};
+  test.AddAttribute("mode", "linear");
+  test.AddAttribute("coordinate_transformation_mode", "align_corners");
+
+  const int64_t H = 2, W = 2;
+  std::vector<uint8_t> X = {1, 3,
+                            4, 8};
+
+  test.AddInput<uint8_t>("X", {H, W}, X);
+  test.AddInput<float>("roi", {0}, roi);
+  test.AddInput<float>("scales", {2}, scales);
+
+  std::vector<uint8_t> Y = {
+      1, 1, 1, 1, 2, 2, 2, 3,
+      2, 2, 2, 3, 3, 3, 4, 4,
+      3, 3, 3, 4, 4, 5, 5, 6,
+      4, 4, 5, 5, 6, 6, 7, 8};
+
+  test.AddOutput<uint8_t>("Y", {static_cast<int64_t>(H * scales[0]), static_cast<int64_t>(W * scales[1])}, Y);
+  test.Run();
+}
+
 TEST(ResizeOpTest, ResizeOpLineartScalesNoOpTest) {
   OpTester test("Resize", 11);
   std::vector<float> roi{};
@@ -584,6 +650,38 @@ TEST(ResizeOpTest, ResizeOpCubicUpSampleTest) {
   test.Run();
 }
 
+TEST(ResizeOpTest, ResizeOpCubicUpSampleTest_uint8) {
+  OpTester test("Resize", 11);
+  std::vector<float> scales{1.0f, 1.0f, 2.0f, 2.0f};
+  std::vector<float> roi{};
+
+  test.AddAttribute("mode", "cubic");
+  test.AddAttribute("coordinate_transformation_mode", "asymmetric");
+
+  const int64_t N = 1, C = 1, H = 4, W = 4;
+  std::vector<uint8_t> X = {
+      1, 2, 3, 4,
+      5, 6, 7, 8,
+      9, 10, 11, 12,
+      13, 14, 15, 16};
+
+  test.AddInput<uint8_t>("X", {N, C, H, W}, X);
+  test.AddInput<float>("roi", {0}, roi);
+  test.AddInput<float>("scales", {4}, scales);
+
+  std::vector<uint8_t> Y = {1, 1, 2, 2, 3, 3, 4, 4,
+                            2, 3, 3, 4, 4, 5, 5, 5,
+                            5, 5, 6, 6, 7, 7, 8, 8,
+                            7, 7, 8, 8, 9, 9, 10, 10,
+                            9, 9, 10, 10, 11, 11, 12, 12,
+                            11, 11, 12, 12, 13, 13, 14, 14,
+                            13, 13, 14, 14, 15, 15, 16, 16,
+                            13, 13, 14, 14, 15, 15, 16, 16};
+
+  test.AddOutput<uint8_t>("Y", {N, C, static_cast<int64_t>(H * scales[2]), static_cast<int64_t>(W * scales[3])}, Y);
+  test.Run();
+}
+
 TEST(ResizeOpTest, ResizeOpCubicUpSampleTest_MultiChannel) {
   OpTester test("Resize", 11);
   std::vector<float> scales{};
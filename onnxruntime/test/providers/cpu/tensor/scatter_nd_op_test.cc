@@ -55,6 +55,58 @@ TEST(ScatterNDOpTest, ScatterND_matrice_string_int64) {
   test2.Run();
 }
 
+TEST(ScatterNDOpTest, ScatterND_duplicate_indices_string_int64) {
+  // enough updates to be worth splitting across threads, all landing on the same few strings
+  constexpr int64_t num_updates = 2048;
+  std::vector<int64_t> indices(num_updates);
+  std::vector<std::string> updates(num_updates);
+  for (int64_t i = 0; i < num_updates; ++i) {
+    indices[i] = i % 4;
+    updates[i] = "a string too long for the small buffer " + std::to_string(i);
+  }
+
+  // the updates are applied in order, so the last one for each index is kept
+  std::vector<std::string> output(4);
+  for (int64_t i = 0; i < 4; ++i) {
+    output[i] = updates[num_updates - 4 + i];
+  }
+
+  OpTester test("ScatterND", 11);
+  test.AddInput<std::string>("data", {4}, {"a", "b", "c", "d"});
+  test.AddInput<int64_t>("indices", {num_updates, 1}, indices);
+  test.AddInput<std::string>("updates", {num_updates}, updates);
+  test.AddOutput<std::string>("output", {4}, output);
+  test.Run();
+}
+
+TEST(ScatterNDOpTest, ScatterND_duplicate_indices_float_int64) {
+  // enough updates to be worth splitting across threads, each row written many times
+  constexpr int64_t num_updates = 4096;
+  constexpr int64_t row_size = 4;
+  std::vector<int64_t> indices(num_updates);
+  std::vector<float> updates(num_updates * row_size);
+  for (int64_t i = 0; i < num_updates; ++i) {
+    indices[i] = i % 3;
+    for (int64_t j = 0; j < row_size; ++j) {
+      updates[i * row_size + j] = static_cast<float>(i * row_size + j);
+    }
+  }
+
+  // the updates are applied in order, so the last one for each row is kept whole
+  std::vector<float> output(3 * row_size);
+  for (int64_t i = num_updates - 3; i < num_updates; ++i) {
+    std::copy(updates.begin() + i * row_size, updates.begin() + (i + 1) * row_size,
+              output.begin() + indices[i] * row_size);
+  }
+
+  OpTester test("ScatterND", 11);
+  test.AddInput<float>("data", {3, row_size}, std::vector<float>(3 * row_size, -1.0f));
+  test.AddInput<int64_t>("indices", {num_updates, 1}, indices);
+  test.AddInput<float>("updates", {num_updates, row_size}, updates);
+  test.AddOutput<float>("output", {3, row_size}, output);
+  test.Run();
+}
+
 TEST(ScatterNDOpTest, ScatterND_slice_float_int64_t) {
   OpTester test("ScatterND", 11);
   test.AddInput<float>("data", {2,2}, {0.0f,0.1f,0.1f,0.1f});
@@ -297,6 +297,58 @@ TEST(TensorOpTest, CastToString) {
   TestCastOp(int_16_input, int_string_data, shape, TensorProto::STRING);
 }
 
+TEST(TensorOpTest, CastLargeTensor) {
+  // large enough for the elements to be split over the thread pool
+  const int64_t size = 50000;
+  std::vector<float> float_data(size);
+  std::vector<MLFloat16> float16_data(size);
+  std::vector<int32_t> int32_data(size);
+  std::vector<std::string> string_data(size);
+  for (int64_t i = 0; i < size; ++i) {
+    const float value = static_cast<float>(i % 2048 - 1024);
+    float_data[i] = value;
+    float16_data[i] = MLFloat16(math::floatToHalf(value));
+    int32_data[i] = static_cast<int32_t>(value);
+    string_data[i] = std::to_string(static_cast<int32_t>(value));
+  }
+
+  {
+    OpTester test("Cast", 9);
+    test.AddAttribute("to", static_cast<int64_t>(TensorProto::FLOAT16));
+    test.AddInput<float>("input", {size}, float_data);
+    test.AddOutput<MLFloat16>("output", {size}, float16_data);
+    test.Run(ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+  }
+  {
+    OpTester test("Cast", 9);
+    test.AddAttribute("to", static_cast<int64_t>(TensorProto::INT32));
+    test.AddInput<MLFloat16>("input", {size}, float16_data);
+    test.AddOutput<int32_t>("output", {size}, int32_data);
+    test.Run(ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+  }
+  {
+    OpTester test("Cast", 9);
+    test.AddAttribute("to", static_cast<int64_t>(TensorProto::STRING));
+    test.AddInput<int32_t>("input", {size}, int32_data);
+    test.AddOutput<std::string>("output", {size}, string_data);
+    test.Run(ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+  }
+  {
+    OpTester test("Cast", 9);
+    test.AddAttribute("to", static_cast<int64_t>(TensorProto::FLOAT));
+    test.AddInput<std::string>("input", {size}, string_data);
+    test.AddOutput<float>("output", {size}, float_data);
+    test.Run(ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+  }
+}
+
+TEST(TensorOpTest, CastFromStringInvalid) {
+  const std::vector<int64_t> shape{2, 2};
+  std::initializer_list<std::string> string_data = {"1", "2", "not a number", "4"};
+  const std::initializer_list<int32_t> int_output = {1, 2, 0, 4};
+  TestCastOp(string_data, int_output, shape, TensorProto::INT32, ExpectResult::kExpectFailure, "stol");
+}
+
 void MeanVarianceNormalizationFunctionDefaultPerChannel() {
   const int64_t N = 2, C = 2, H = 2, W = 3;
 
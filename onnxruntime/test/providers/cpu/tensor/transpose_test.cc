@@ -414,5 +414,65 @@ TEST(TransposeOpTest, SingleAxisMovingInwardsBlockCopy) {
 
   TransposeTest(input_shape, input_vals, &perm, expected_shape, expected_vals, false, false);
 }
+// Transposes a tensor with a reference implementation to produce the expected output of larger tests.
+template <class T>
+void TransposeReferenceTest(const std::vector<int64_t>& input_shape, const std::vector<int64_t>& perm) {
+  const size_t rank = input_shape.size();
+
+  std::vector<int64_t> input_strides(rank, 1);
+  for (size_t k = rank - 1; k-- > 0;) {
+    input_strides[k] = input_strides[k + 1] * input_shape[k + 1];
+  }
+
+  std::vector<int64_t> expected_shape(rank);
+  for (size_t k = 0; k < rank; ++k) {
+    expected_shape[k] = input_shape[perm[k]];
+  }
+
+  const int64_t size = input_strides[0] * input_shape[0];
+  std::vector<T> input_vals(size);
+  for (int64_t i = 0; i < size; ++i) {
+    input_vals[i] = static_cast<T>(i % 251);
+  }
+
+  std::vector<T> expected_vals(size);
+  std::vector<int64_t> index(rank, 0);
+  for (int64_t i = 0; i < size; ++i) {
+    int64_t offset = 0;
+    for (size_t k = 0; k < rank; ++k) {
+      offset += index[k] * input_strides[perm[k]];
+    }
+    expected_vals[i] = input_vals[offset];
+    for (size_t k = rank; k-- > 0;) {
+      if (++index[k] < expected_shape[k]) break;
+      index[k] = 0;
+    }
+  }
+
+  OpTester test("Transpose");
+  test.AddAttribute("perm", perm);
+  test.AddInput<T>("X", input_shape, input_vals);
+  test.AddOutput<T>("Y", expected_shape, expected_vals);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});
+}
+
+// test the tiled 2-D transpose with partial tiles after adjacent axes are merged
+TEST(TransposeOpTest, TiledWithMergedAxes) {
+  TransposeReferenceTest<float>({2, 3, 37, 20}, {0, 3, 1, 2});
+  TransposeReferenceTest<int16_t>({5, 1, 67, 9}, {2, 1, 0, 3});
+  TransposeReferenceTest<uint8_t>({3, 70, 41}, {2, 0, 1});
+  TransposeReferenceTest<int64_t>({33, 2, 17}, {1, 2, 0});
+}
+
+// test the innermost axis of 2 elements folding into a wider element
+TEST(TransposeOpTest, InnermostAxisFolded) {
+  TransposeReferenceTest<float>({4, 9, 11, 2}, {2, 0, 1, 3});
+  TransposeReferenceTest<uint8_t>({13, 7, 4}, {1, 0, 2});
+}
+
+// test the block copy path used by [B,S,H,D] to [B,H,S,D]
+TEST(TransposeOpTest, BlockCopy) {
+  TransposeReferenceTest<float>({2, 16, 4, 24}, {0, 2, 1, 3});
+}
 }  // namespace test
 }  // namespace onnxruntime
@@ -145,6 +145,45 @@ class TestInferenceSession(unittest.TestCase):
         np.testing.assert_allclose(
             output_expected, rescontiguous[0], rtol=1e-05, atol=1e-08)
 
+    def testRunModelOutputZeroCopy(self):
+        sess = onnxrt.InferenceSession(self.get_name("mul_1.onnx"))
+        x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        res = sess.run([], {"X": x})
+        # the output borrows the buffer from onnxruntime rather than owning a copy
+        self.assertFalse(res[0].flags['OWNDATA'])
+        self.assertIsNotNone(res[0].base)
+        # and the buffer must remain valid after the session is released
+        del sess
+        output_expected = np.array(
+            [[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
+        np.testing.assert_allclose(
+            output_expected, res[0], rtol=1e-05, atol=1e-08)
+
+    def testRunModelInitializerOutputIsCopied(self):
+        sess = onnxrt.InferenceSession(self.get_name("output_aliases.onnx"))
+        x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        res = sess.run(["W"], {"X": x})
+        w_expected = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        # the initializer belongs to the session, so the output must be a copy
+        self.assertTrue(res[0].flags['OWNDATA'])
+        # writing to the output must not change the weights used by later runs
+        res[0][:] = 0
+        res = sess.run(["Y", "W"], {"X": x})
+        np.testing.assert_allclose(x * w_expected, res[0], rtol=1e-05, atol=1e-08)
+        del sess
+        np.testing.assert_allclose(w_expected, res[1], rtol=1e-05, atol=1e-08)
+
+    def testRunModelInputPassthroughOutputIsCopied(self):
+        sess = onnxrt.InferenceSession(self.get_name("output_aliases.onnx"))
+        x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        x_expected = x.copy()
+        res = sess.run(["X"], {"X": x})
+        # the output wraps the caller's input array, so it must be a copy
+        self.assertTrue(res[0].flags['OWNDATA'])
+        del x
+        del sess
+        np.testing.assert_allclose(x_expected, res[0], rtol=1e-05, atol=1e-08)
+
     def testRunModelMultipleThreads(self):
         so = onnxrt.SessionOptions()
         so.log_verbosity_level = 1
@@ -387,6 +426,49 @@ class TestInferenceSession(unittest.TestCase):
         res = sess.run([output_name], {x_name: x})
         self.assertEqual(output_expected, res[0])
 
+    def testZipMapStringFloatColumnar(self):
+        so = onnxrt.SessionOptions()
+        so.use_columnar_zipmap_output = True
+        sess = onnxrt.InferenceSession(self.get_name("zipmap_stringfloat.onnx"), sess_options=so)
+        x = np.array([1.0, 0.0, 3.0, 44.0, 23.0, 11.0],
+                     dtype=np.float32).reshape((2, 3))
+
+        res = sess.run(["Z"], {"X": x})
+        maps = res[0]
+        self.assertEqual(len(maps), 2)
+        self.assertEqual(maps.keys, ['class1', 'class2', 'class3'])
+        np.testing.assert_equal(maps.values, x)
+
+        row = maps[1]
+        self.assertEqual(len(row), 3)
+        self.assertEqual(row['class2'], 23.0)
+        self.assertTrue('class3' in row)
+        self.assertFalse('class4' in row)
+        self.assertEqual(row.get('class4'), None)
+        with self.assertRaises(KeyError):
+            row['class4']
+        np.testing.assert_equal(row.values(), x[1])
+        self.assertEqual(dict(maps[-2]), {'class2': 0.0, 'class1': 1.0, 'class3': 3.0})
+        with self.assertRaises(IndexError):
+            maps[2]
+
+        output_expected = [{'class2': 0.0, 'class1': 1.0, 'class3': 3.0},
+                           {'class2': 23.0, 'class1': 44.0, 'class3': 11.0}]
+        self.assertEqual(output_expected, maps.to_list())
+
+    def testZipMapInt64FloatColumnar(self):
+        so = onnxrt.SessionOptions()
+        so.use_columnar_zipmap_output = True
+        sess = onnxrt.InferenceSession(self.get_name("zipmap_int64float.onnx"), sess_options=so)
+        x = np.array([1.0, 0.0, 3.0, 44.0, 23.0, 11.0],
+                     dtype=np.float32).reshape((2, 3))
+
+        res = sess.run(["Z"], {"X": x})
+        maps = res[0]
+        self.assertEqual(maps.keys, [10, 20, 30])
+        self.assertEqual(maps[0].to_dict(), {10: 1.0, 20: 0.0, 30: 3.0})
+        self.assertEqual(maps[1].items(), [(10, 44.0), (20, 23.0), (30, 11.0)])
+
     def testRaiseWrongNumInputs(self):
         with self.assertRaises(ValueError) as context:
             sess = onnxrt.InferenceSession(self.get_name("logicaland.onnx"))
@@ -0,0 +1,28 @@
+import onnx
+from onnx import helper
+from onnx import TensorProto
+
+# Y = X * W, with the initializer W and the input X also returned directly as graph outputs
+graph_def = helper.make_graph(
+    nodes = [
+        helper.make_node(op_type = "Mul", inputs = ['X', 'W'], outputs = ['Y'], name = 'mul'),
+    ],
+    name = 'output_aliases',
+    inputs = [
+        helper.make_tensor_value_info("X", TensorProto.FLOAT, [3, 2]),
+    ],
+    outputs = [
+        helper.make_tensor_value_info("Y", TensorProto.FLOAT, [3, 2]),
+        helper.make_tensor_value_info("W", TensorProto.FLOAT, [3, 2]),
+        helper.make_tensor_value_info("X", TensorProto.FLOAT, [3, 2]),
+    ],
+    initializer = [
+        helper.make_tensor("W", TensorProto.FLOAT, [3, 2], [1.0, 2.0, 3.0, 4.0, 5.0, 6.0]),
+    ]
+)
+
+model = helper.make_model(graph_def, producer_name = 'onnxruntime-test', opset_imports=[helper.make_operatorsetid("", 11)])
+model.ir_version = 6
+onnx.checker.check_model(model)
+
+onnx.save_model(model, "output_aliases.onnx")
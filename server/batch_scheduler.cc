@@ -0,0 +1,487 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <string>
+
+#include "batch_scheduler.h"
+#include "core/framework/run_options.h"
+
+namespace onnxruntime {
+namespace server {
+
+// how often the batching statistics are written to the log
+static constexpr uint64_t kStatisticsLogInterval = 1000;
+
+static size_t GetElementSize(ONNXTensorElementDataType type) {
+  switch (type) {
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT8:
+      return 1;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_BFLOAT16:
+      return 2;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT32:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
+      return 4;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT64:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_COMPLEX64:
+      return 8;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_COMPLEX128:
+      return 16;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UNDEFINED:
+    default:
+      return 0;
+  }
+}
+
+static const char* const kTerminatedMessage = "Exiting due to terminate flag being set to true.";
+
+static std::vector<Ort::Value> RunSession(Ort::Session& session, const Ort::RunOptions& run_options,
+                                          const std::vector<const char*>& input_names,
+                                          const Ort::Value* input_values,
+                                          const std::vector<std::string>& output_names) {
+  std::vector<const char*> output_ptrs;
+  output_ptrs.reserve(output_names.size());
+  for (const auto& name : output_names) {
+    output_ptrs.push_back(name.c_str());
+  }
+
+  return session.Run(run_options, input_names.data(), input_values, input_names.size(),
+                     output_ptrs.data(), output_ptrs.size());
+}
+
+BatchScheduler::BatchScheduler(const Ort::Session& session, size_t max_batch_size,
+                               std::chrono::microseconds max_queue_delay, std::shared_ptr<spdlog::logger> logger)
+    : session_(const_cast<Ort::Session&>(session)),
+      max_batch_size_(max_batch_size),
+      max_queue_delay_(max_queue_delay),
+      logger_(std::move(logger)) {
+  // every input must have a free first dimension for requests to be concatenated along it
+  for (size_t i = 0, end = session_.GetInputCount(); i < end && batching_supported_; ++i) {
+    auto type_info = session_.GetInputTypeInfo(i);
+    if (type_info.GetONNXType() != ONNX_TYPE_TENSOR) {
+      batching_supported_ = false;
+      break;
+    }
+
+    auto shape = type_info.GetTensorTypeAndShapeInfo().GetShape();
+    batching_supported_ = !shape.empty() && shape[0] < 0;
+  }
+
+  if (!batching_supported_) {
+    logger_->info("Request batching is disabled as the model inputs do not have a free batch dimension.");
+    return;
+  }
+
+  // and every output must have one too so the batched outputs can be split back into the requests
+  for (size_t i = 0, end = session_.GetOutputCount(); i < end && batching_supported_; ++i) {
+    auto type_info = session_.GetOutputTypeInfo(i);
+    if (type_info.GetONNXType() != ONNX_TYPE_TENSOR) {
+      batching_supported_ = false;
+      break;
+    }
+
+    auto shape = type_info.GetTensorTypeAndShapeInfo().GetShape();
+    batching_supported_ = !shape.empty() && shape[0] < 0;
+  }
+
+  if (!batching_supported_) {
+    logger_->info("Request batching is disabled as the model outputs do not have a free batch dimension.");
+    return;
+  }
+
+  statistics_.batch_size_histogram.resize(max_batch_size_ + 1);
+  worker_ = std::thread([this]() { ProcessRequests(); });
+}
+
+BatchScheduler::~BatchScheduler() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shutdown_ = true;
+  }
+
+  queue_changed_.notify_all();
+
+  if (worker_.joinable()) {
+    worker_.join();
+    LogStatistics();
+  }
+}
+
+bool BatchScheduler::Describe(PendingRequest& request) const {
+  const auto& values = *request.input_values;
+  const auto& names = *request.input_names;
+
+  request.input_order.resize(values.size());
+  std::iota(request.input_order.begin(), request.input_order.end(), size_t{0});
+  std::sort(request.input_order.begin(), request.input_order.end(),
+            [&names](size_t a, size_t b) { return names[a] < names[b]; });
+
+  request.rows = -1;
+  request.types.clear();
+  request.shapes.clear();
+
+  for (auto index : request.input_order) {
+    const auto& value = values[index];
+    if (!value.IsTensor()) {
+      return false;
+    }
+
+    auto info = value.GetTensorTypeAndShapeInfo();
+    auto type = info.GetElementType();
+    auto shape = info.GetShape();
+
+    // strings can't be copied as raw bytes, and every input must agree on the number of rows
+    if (GetElementSize(type) == 0 || shape.empty() || (request.rows >= 0 && shape[0] != request.rows)) {
+      return false;
+    }
+
+    request.rows = shape[0];
+    request.types.push_back(type);
+    request.shapes.push_back(std::move(shape));
+  }
+
+  return request.rows > 0 && static_cast<size_t>(request.rows) <= max_batch_size_;
+}
+
+bool BatchScheduler::IsCompatible(const PendingRequest& a, const PendingRequest& b) {
+  if (a.types != b.types || *a.output_names != *b.output_names) {
+    return false;
+  }
+
+  if (a.log_severity_level != b.log_severity_level || a.log_verbosity_level != b.log_verbosity_level) {
+    return false;
+  }
+
+  for (size_t i = 0, end = a.input_order.size(); i < end; ++i) {
+    if ((*a.input_names)[a.input_order[i]] != (*b.input_names)[b.input_order[i]]) {
+      return false;
+    }
+
+    const auto& shape_a = a.shapes[i];
+    const auto& shape_b = b.shapes[i];
+    if (shape_a.size() != shape_b.size() || !std::equal(shape_a.cbegin() + 1, shape_a.cend(), shape_b.cbegin() + 1)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool BatchScheduler::IsTerminated(const PendingRequest& request) {
+  // the C API has no getter for the flag, so read it the same way the executors do
+  const OrtRunOptions* options = *request.run_options;
+  return options->terminate;
+}
+
+std::vector<Ort::Value> BatchScheduler::Run(const Ort::RunOptions& run_options,
+                                            const std::vector<std::string>& input_names,
+                                            const std::vector<Ort::Value>& input_values,
+                                            const std::vector<std::string>& output_names) {
+  PendingRequest request;
+  request.input_names = &input_names;
+  request.input_values = &input_values;
+  request.output_names = &output_names;
+  request.run_options = &run_options;
+  request.log_severity_level = run_options.GetRunLogSeverityLevel();
+  request.log_verbosity_level = run_options.GetRunLogVerbosityLevel();
+
+  if (!batching_supported_ || !Describe(request)) {
+    std::vector<const char*> input_ptrs;
+    input_ptrs.reserve(input_names.size());
+    for (const auto& name : input_names) {
+      input_ptrs.push_back(name.c_str());
+    }
+
+    return RunSession(session_, run_options, input_ptrs, input_values.data(), output_names);
+  }
+
+  auto result = request.result.get_future();
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    request.enqueue_time = Clock::now();
+    queue_.push_back(&request);
+    queued_rows_ += request.rows;
+  }
+
+  queue_changed_.notify_one();
+
+  // rethrows any exception from the batch execution
+  return result.get();
+}
+
+void BatchScheduler::ProcessRequests() {
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  while (true) {
+    queue_changed_.wait(lock, [this]() { return shutdown_ || !queue_.empty(); });
+
+    if (queue_.empty()) {
+      // shutdown requested and nothing left to process
+      return;
+    }
+
+    // wait for more requests until there's enough to fill a batch, or the oldest request has waited long enough
+    auto deadline = queue_.front()->enqueue_time + max_queue_delay_;
+    while (!shutdown_ && static_cast<size_t>(queued_rows_) < max_batch_size_ && Clock::now() < deadline) {
+      queue_changed_.wait_until(lock, deadline);
+    }
+
+    auto batch = TakeBatch();
+
+    lock.unlock();
+    ExecuteBatch(batch);
+    lock.lock();
+  }
+}
+
+std::vector<BatchScheduler::PendingRequest*> BatchScheduler::TakeBatch() {
+  // the oldest request always goes in the batch. add any compatible requests in arrival order while they fit.
+  std::vector<PendingRequest*> batch{queue_.front()};
+  queue_.pop_front();
+
+  int64_t rows = batch.front()->rows;
+  for (auto iter = queue_.begin(); iter != queue_.end() && static_cast<size_t>(rows) < max_batch_size_;) {
+    auto* request = *iter;
+    if (static_cast<size_t>(rows + request->rows) <= max_batch_size_ && IsCompatible(*batch.front(), *request)) {
+      rows += request->rows;
+      batch.push_back(request);
+      iter = queue_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+
+  queued_rows_ -= rows;
+  return batch;
+}
+
+void BatchScheduler::ExecuteBatch(std::vector<PendingRequest*>& batch) {
+  // drop the requests that were terminated while queued
+  auto terminated = std::stable_partition(batch.begin(), batch.end(),
+                                          [](const PendingRequest* request) { return !IsTerminated(*request); });
+  for (auto iter = terminated; iter != batch.end(); ++iter) {
+    (*iter)->result.set_exception(std::make_exception_ptr(Ort::Exception(kTerminatedMessage, ORT_FAIL)));
+  }
+
+  batch.erase(terminated, batch.end());
+  if (batch.empty()) {
+    return;
+  }
+
+  auto start = Clock::now();
+  RecordBatch(batch, start);
+
+  int64_t total_rows = 0;
+  for (const auto* request : batch) {
+    total_rows += request->rows;
+  }
+
+  std::vector<Ort::Value> outputs;
+  try {
+    outputs = RunBatch(batch, total_rows);
+  } catch (...) {
+    for (auto* request : batch) {
+      request->result.set_exception(std::current_exception());
+    }
+
+    return;
+  }
+
+  if (batch.size() == 1) {
+    batch.front()->result.set_value(std::move(outputs));
+    return;
+  }
+
+  std::vector<std::vector<Ort::Value>> results(batch.size());
+  bool split = false;
+  try {
+    split = SplitOutputs(batch, outputs, total_rows, results);
+  } catch (...) {
+    for (auto* request : batch) {
+      request->result.set_exception(std::current_exception());
+    }
+
+    return;
+  }
+
+  if (!split) {
+    // The model declares a free batch dimension for every output, but an output of this batch doesn't have one
+    // row per input row. Its rows can't be attributed to the requests, so run each request on its own.
+    logger_->debug("Batch outputs could not be split by rows. Running the {} requests individually.", batch.size());
+    for (auto* request : batch) {
+      std::vector<PendingRequest*> single{request};
+      try {
+        request->result.set_value(RunBatch(single, request->rows));
+      } catch (...) {
+        request->result.set_exception(std::current_exception());
+      }
+    }
+
+    return;
+  }
+
+  for (size_t r = 0; r < batch.size(); ++r) {
+    if (IsTerminated(*batch[r])) {
+      batch[r]->result.set_exception(std::make_exception_ptr(Ort::Exception(kTerminatedMessage, ORT_FAIL)));
+    } else {
+      batch[r]->result.set_value(std::move(results[r]));
+    }
+  }
+
+  logger_->debug("Executed batch of {} requests with {} rows in {} us.", batch.size(), total_rows,
+                 std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count());
+}
+
+bool BatchScheduler::SplitOutputs(const std::vector<PendingRequest*>& batch, std::vector<Ort::Value>& outputs,
+                                  int64_t total_rows, std::vector<std::vector<Ort::Value>>& results) {
+  // check every output before splitting any of them
+  for (auto& output : outputs) {
+    if (!output.IsTensor()) {
+      return false;
+    }
+
+    auto info = output.GetTensorTypeAndShapeInfo();
+    auto shape = info.GetShape();
+    if (GetElementSize(info.GetElementType()) == 0 || shape.empty() || shape[0] != total_rows) {
+      return false;
+    }
+  }
+
+  // scatter the rows of each output back to the requests
+  Ort::AllocatorWithDefaultOptions allocator;
+
+  for (auto& output : outputs) {
+    auto info = output.GetTensorTypeAndShapeInfo();
+    auto type = info.GetElementType();
+    auto shape = info.GetShape();
+
+    size_t row_bytes = GetElementSize(type) * (info.GetElementCount() / static_cast<size_t>(total_rows));
+    const auto* src = output.GetTensorMutableData<uint8_t>();
+
+    for (size_t r = 0; r < batch.size(); ++r) {
+      shape[0] = batch[r]->rows;
+      auto value = Ort::Value::CreateTensor(allocator, shape.data(), shape.size(), type);
+      size_t num_bytes = row_bytes * static_cast<size_t>(batch[r]->rows);
+      memcpy(value.GetTensorMutableData<uint8_t>(), src, num_bytes);
+      src += num_bytes;
+
+      results[r].push_back(std::move(value));
+    }
+  }
+
+  return true;
+}
+
+std::vector<Ort::Value> BatchScheduler::RunBatch(std::vector<PendingRequest*>& batch, int64_t total_rows) {
+  const auto& first = *batch.front();
+
+  if (batch.size() == 1) {
+    // no need to concatenate. use the request's own options and its inputs in their original order.
+    std::vector<const char*> names;
+    names.reserve(first.input_names->size());
+    for (const auto& name : *first.input_names) {
+      names.push_back(name.c_str());
+    }
+
+    return RunSession(session_, *first.run_options, names, first.input_values->data(), *first.output_names);
+  }
+
+  // the requests share their log levels. tag the run with all of their tags so its log lines can be traced back.
+  std::string run_tag;
+  for (const auto* request : batch) {
+    const char* tag = request->run_options->GetRunTag();
+    if (tag != nullptr && *tag != '\0') {
+      if (!run_tag.empty()) {
+        run_tag += ',';
+      }
+      run_tag += tag;
+    }
+  }
+
+  Ort::RunOptions run_options{};
+  run_options.SetRunLogSeverityLevel(first.log_severity_level);
+  run_options.SetRunLogVerbosityLevel(first.log_verbosity_level);
+  run_options.SetRunTag(run_tag.c_str());
+
+  std::vector<const char*> input_ptrs;
+  input_ptrs.reserve(first.input_order.size());
+  for (auto index : first.input_order) {
+    input_ptrs.push_back((*first.input_names)[index].c_str());
+  }
+
+  // concatenate each input along dimension 0
+  Ort::AllocatorWithDefaultOptions allocator;
+  std::vector<Ort::Value> batched_inputs;
+  batched_inputs.reserve(first.input_order.size());
+
+  for (size_t i = 0, end = first.input_order.size(); i < end; ++i) {
+    auto shape = first.shapes[i];
+    shape[0] = total_rows;
+
+    auto value = Ort::Value::CreateTensor(allocator, shape.data(), shape.size(), first.types[i]);
+    auto* dst = value.GetTensorMutableData<uint8_t>();
+
+    for (auto* request : batch) {
+      auto& input = const_cast<Ort::Value&>((*request->input_values)[request->input_order[i]]);
+      auto num_bytes = input.GetTensorTypeAndShapeInfo().GetElementCount() * GetElementSize(first.types[i]);
+      memcpy(dst, input.GetTensorMutableData<uint8_t>(), num_bytes);
+      dst += num_bytes;
+    }
+
+    batched_inputs.push_back(std::move(value));
+  }
+
+  return RunSession(session_, run_options, input_ptrs, batched_inputs.data(), *first.output_names);
+}
+
+void BatchScheduler::RecordBatch(const std::vector<PendingRequest*>& batch, Clock::time_point start) {
+  ++statistics_.num_batches;
+  ++num_batches_;
+  statistics_.num_requests += batch.size();
+  ++statistics_.batch_size_histogram[std::min(batch.size(), max_batch_size_)];
+
+  for (const auto* request : batch) {
+    auto latency = std::chrono::duration_cast<std::chrono::microseconds>(start - request->enqueue_time);
+    statistics_.total_queue_latency += latency;
+    statistics_.max_queue_latency = std::max(statistics_.max_queue_latency, latency);
+  }
+
+  if (statistics_.num_batches % kStatisticsLogInterval == 0) {
+    LogStatistics();
+  }
+}
+
+void BatchScheduler::LogStatistics() const {
+  if (statistics_.num_batches == 0) {
+    return;
+  }
+
+  std::string histogram;
+  for (size_t size = 1; size < statistics_.batch_size_histogram.size(); ++size) {
+    if (statistics_.batch_size_histogram[size] != 0) {
+      histogram += fmt::format(" {}:{}", size, statistics_.batch_size_histogram[size]);
+    }
+  }
+
+  logger_->info(
+      "Batching statistics: batches={} requests={} mean_queue_latency_us={} max_queue_latency_us={} "
+      "batch_size_histogram=[{} ]",
+      statistics_.num_batches, statistics_.num_requests,
+      statistics_.total_queue_latency.count() / static_cast<int64_t>(statistics_.num_requests),
+      statistics_.max_queue_latency.count(), histogram);
+}
+
+}  // namespace server
+}  // namespace onnxruntime
@@ -0,0 +1,123 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "onnxruntime_cxx_api.h"
+
+namespace onnxruntime {
+namespace server {
+
+// Coalesces concurrent requests for a single model along the batch dimension (dimension 0 of every input),
+// runs the model once for the batch, and scatters the outputs back to the waiting requests.
+//
+// A request is only added to a batch with other requests that have the same input names, element types
+// and per-row shapes, and the same requested outputs. Batching is disabled for a model unless dimension 0
+// of every input and output is a free dimension. Requests that can't be batched (e.g. string inputs) are run
+// directly on the calling thread.
+//
+// The terminate flag of a request's run options is honored while it waits in the queue. A request that runs alone
+// uses its own options, so it can be terminated mid-run as usual. In a batch of several requests the run can't be
+// stopped for one of them, so a request terminated during the run gets the terminate error instead of its outputs.
+class BatchScheduler {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  BatchScheduler(const Ort::Session& session, size_t max_batch_size, std::chrono::microseconds max_queue_delay,
+                 std::shared_ptr<spdlog::logger> logger);
+  ~BatchScheduler();
+
+  BatchScheduler(const BatchScheduler&) = delete;
+  BatchScheduler& operator=(const BatchScheduler&) = delete;
+
+  // true if the model inputs and outputs allow requests to be combined into a batch
+  bool IsBatchingSupported() const { return batching_supported_; }
+
+  // Number of batches the worker thread has executed, including batches of a single request. Requests run
+  // directly on the calling thread are not counted. Up to date for every request that has returned from Run.
+  uint64_t GetNumBatches() const { return num_batches_.load(); }
+
+  // Run a request, blocking until it has been executed either as part of a batch or on its own.
+  // Throws Ort::Exception on failure.
+  std::vector<Ort::Value> Run(const Ort::RunOptions& run_options,
+                              const std::vector<std::string>& input_names,
+                              const std::vector<Ort::Value>& input_values,
+                              const std::vector<std::string>& output_names);
+
+ private:
+  struct PendingRequest {
+    const std::vector<std::string>* input_names;
+    const std::vector<Ort::Value>* input_values;
+    const std::vector<std::string>* output_names;
+
+    // the caller's options. requests are only batched with others using the same log levels, and a batch of
+    // several requests runs with those levels and the run tags of all of its requests.
+    const Ort::RunOptions* run_options;
+    int log_severity_level;
+    int log_verbosity_level;
+
+    // sorted order of the inputs so that requests listing the inputs in a different order can be batched
+    std::vector<size_t> input_order;
+    // element type and shape of each input in input_order
+    std::vector<ONNXTensorElementDataType> types;
+    std::vector<std::vector<int64_t>> shapes;
+    int64_t rows;
+
+    Clock::time_point enqueue_time;
+    std::promise<std::vector<Ort::Value>> result;
+  };
+
+  // Per-batch statistics written to the log periodically and when the scheduler is destroyed.
+  struct Statistics {
+    std::vector<uint64_t> batch_size_histogram;  // index is the number of requests in the batch
+    uint64_t num_batches{0};
+    uint64_t num_requests{0};
+    std::chrono::microseconds total_queue_latency{0};
+    std::chrono::microseconds max_queue_latency{0};
+  };
+
+  bool Describe(PendingRequest& request) const;
+  static bool IsCompatible(const PendingRequest& a, const PendingRequest& b);
+  static bool IsTerminated(const PendingRequest& request);
+
+  void ProcessRequests();
+  std::vector<PendingRequest*> TakeBatch();
+  void ExecuteBatch(std::vector<PendingRequest*>& batch);
+  static bool SplitOutputs(const std::vector<PendingRequest*>& batch, std::vector<Ort::Value>& outputs,
+                           int64_t total_rows, std::vector<std::vector<Ort::Value>>& results);
+  std::vector<Ort::Value> RunBatch(std::vector<PendingRequest*>& batch, int64_t total_rows);
+  void RecordBatch(const std::vector<PendingRequest*>& batch, Clock::time_point start);
+  void LogStatistics() const;
+
+  Ort::Session& session_;
+  const size_t max_batch_size_;
+  const std::chrono::microseconds max_queue_delay_;
+  std::shared_ptr<spdlog::logger> logger_;
+  bool batching_supported_{true};
+
+  std::mutex mutex_;
+  std::condition_variable queue_changed_;
+  std::deque<PendingRequest*> queue_;  // guarded by mutex_
+  int64_t queued_rows_{0};             // guarded by mutex_
+  bool shutdown_{false};               // guarded by mutex_
+
+  Statistics statistics_;  // only used by the worker thread
+  std::atomic<uint64_t> num_batches_{0};
+  std::thread worker_;
+};
+
+}  // namespace server
+}  // namespace onnxruntime
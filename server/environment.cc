@@ -103,6 +103,33 @@ void ServerEnvironment::InitializeModel(const std::string& model_path, const std
     (iterator->second).output_names.push_back(name);
     allocator.Free(name);
   }
+
+  if (max_batch_size_ > 1) {
+    auto scheduler = std::make_unique<BatchScheduler>(iterator->second.session, max_batch_size_, max_queue_delay_,
+                                                      GetLogger(model_name + ":" + model_version + ":batch"));
+    if (scheduler->IsBatchingSupported()) {
+      iterator->second.batch_scheduler = std::move(scheduler);
+    }
+  }
+}
+
+void ServerEnvironment::SetIntraOpNumThreads(int num_threads) {
+  options_.SetIntraOpNumThreads(num_threads);
+}
+
+void ServerEnvironment::EnableBatching(size_t max_batch_size, std::chrono::microseconds max_queue_delay) {
+  max_batch_size_ = max_batch_size;
+  max_queue_delay_ = max_queue_delay;
+}
+
+BatchScheduler* ServerEnvironment::GetBatchScheduler(const std::string& model_name, const std::string& model_version) const {
+  auto identifier = std::make_pair(model_name, model_version);
+  auto it = sessions_.find(identifier);
+  if (it == sessions_.end()) {
+    throw Ort::Exception("No model loaded of that name.", ORT_NO_MODEL);
+  }
+
+  return it->second.batch_scheduler.get();
 }
 
 const std::vector<std::string>& ServerEnvironment::GetModelOutputNames(const std::string& model_name, const std::string& model_version) const {
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <memory>
 #include <vector>
 
@@ -11,6 +12,8 @@
 #include <unordered_map>
 #include <boost/functional/hash.hpp>
 
+#include "batch_scheduler.h"
+
 namespace onnxruntime {
 namespace server {
 
@@ -24,6 +27,12 @@ class ServerEnvironment {
 
   const Ort::Session& GetSession(const std::string& model_name, const std::string& model_version) const;
   void InitializeModel(const std::string& model_path, const std::string& model_name, const std::string& model_version);
+  // Number of threads used within an operator by models loaded after this call. 0 uses the ONNX Runtime default.
+  void SetIntraOpNumThreads(int num_threads);
+  // Combine concurrent requests into batches of up to max_batch_size rows for models loaded after this call.
+  void EnableBatching(size_t max_batch_size, std::chrono::microseconds max_queue_delay);
+  // Returns nullptr if batching is disabled or the model does not support it
+  BatchScheduler* GetBatchScheduler(const std::string& model_name, const std::string& model_version) const;
   const std::vector<std::string>& GetModelOutputNames(const std::string& model_name, const std::string& model_version) const;
   std::shared_ptr<spdlog::logger> GetLogger(const std::string& request_id) const;
   std::shared_ptr<spdlog::logger> GetAppLogger() const;
@@ -38,14 +47,20 @@ class ServerEnvironment {
 
   Ort::Env runtime_environment_;
   Ort::SessionOptions options_;
+  size_t max_batch_size_{0};
+  std::chrono::microseconds max_queue_delay_{0};
 
   struct SessionHolder {
     Ort::Session session;
     std::vector<std::string> output_names;
+    std::unique_ptr<BatchScheduler> batch_scheduler;
     explicit SessionHolder(Ort::Env& env, std::string path, const Ort::SessionOptions& options) : session(nullptr) {
       session = Ort::Session(env, path.c_str(), options);
     };
-    ~SessionHolder() = default;
+    ~SessionHolder() {
+      // the scheduler uses the session so must be stopped first
+      batch_scheduler.reset();
+    }
     SessionHolder(const SessionHolder&) = delete;
     SessionHolder(const SessionHolder&&) = delete;
     SessionHolder& operator=(const SessionHolder&) = delete;
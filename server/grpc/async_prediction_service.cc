@@ -0,0 +1,147 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "async_prediction_service.h"
+
+namespace onnxruntime {
+namespace server {
+namespace grpc {
+
+// State for a single Predict call. The object is the tag for all of its completion queue operations
+// and deletes itself once the response has been sent.
+class AsyncPredictionService::PredictCall {
+ public:
+  // Start waiting for the next call. Must be called with the owner's mutex held while it is running.
+  static void Accept(AsyncPredictionService& owner) {
+    auto* call = new PredictCall(owner);
+    owner.service_.RequestPredict(&call->context_, &call->request_, &call->responder_, owner.completion_queue_.get(),
+                                  owner.completion_queue_.get(), call);
+  }
+
+  // Called by the poller when the pending operation for this call completes
+  void Proceed(bool ok) {
+    if (state_ == State::kFinishing || !ok) {
+      // response sent, or the server is shutting down
+      delete this;
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(owner_.mutex_);
+      if (!owner_.running_) {
+        delete this;
+        return;
+      }
+
+      // accept the next call before this one is processed
+      Accept(owner_);
+    }
+
+    state_ = State::kFinishing;
+    if (!owner_.workers_.TrySchedule([this]() { Execute(); })) {
+      owner_.logger_->warn("Rejecting request as all {} workers are busy and {} requests are pending.",
+                           owner_.workers_.NumThreads(), owner_.workers_.MaxPendingTasks());
+      Finish(::grpc::Status(::grpc::StatusCode::RESOURCE_EXHAUSTED, "Server is busy. Retry the request later."));
+    }
+  }
+
+ private:
+  enum class State {
+    kWaitingForRequest,
+    kFinishing
+  };
+
+  explicit PredictCall(AsyncPredictionService& owner) : owner_(owner), responder_(&context_) {}
+
+  void Execute() {
+    ::grpc::Status status;
+    if (context_.IsCancelled()) {
+      status = ::grpc::Status::CANCELLED;
+    } else {
+      status = owner_.implementation_.Predict(&context_, &request_, &response_);
+    }
+
+    Finish(status);
+  }
+
+  void Finish(const ::grpc::Status& status) {
+    {
+      std::lock_guard<std::mutex> lock(owner_.mutex_);
+      if (owner_.running_) {
+        if (status.ok()) {
+          responder_.Finish(response_, status, this);
+        } else {
+          responder_.FinishWithError(status, this);
+        }
+
+        return;
+      }
+    }
+
+    // the completion queue has been shut down so there's nothing more to do for the call
+    delete this;
+  }
+
+  AsyncPredictionService& owner_;
+  State state_{State::kWaitingForRequest};
+
+  ::grpc::ServerContext context_;
+  onnxruntime::server::PredictRequest request_;
+  onnxruntime::server::PredictResponse response_;
+  ::grpc::ServerAsyncResponseWriter<onnxruntime::server::PredictResponse> responder_;
+};
+
+AsyncPredictionService::AsyncPredictionService(const std::shared_ptr<onnxruntime::server::ServerEnvironment>& env,
+                                               size_t num_workers, size_t max_pending_requests)
+    : implementation_(env),
+      logger_(env->GetAppLogger()),
+      workers_(num_workers, max_pending_requests) {}
+
+AsyncPredictionService::~AsyncPredictionService() {
+  Shutdown();
+}
+
+void AsyncPredictionService::Start(std::unique_ptr<::grpc::ServerCompletionQueue> completion_queue) {
+  completion_queue_ = std::move(completion_queue);
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_ = true;
+    PredictCall::Accept(*this);
+  }
+
+  poller_ = std::thread([this]() { PollCompletionQueue(); });
+}
+
+void AsyncPredictionService::Shutdown() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_) {
+      return;
+    }
+
+    running_ = false;
+    completion_queue_->Shutdown();
+  }
+
+  if (poller_.joinable()) {
+    poller_.join();
+  }
+
+  // requests still running on the workers clean up after themselves as they complete
+  workers_.WaitForIdle();
+}
+
+void AsyncPredictionService::PollCompletionQueue() {
+  void* tag = nullptr;
+  bool ok = false;
+
+  // Next returns false once the queue has been shut down and drained
+  while (completion_queue_->Next(&tag, &ok)) {
+    static_cast<PredictCall*>(tag)->Proceed(ok);
+  }
+}
+
+}  // namespace grpc
+}  // namespace server
+}  // namespace onnxruntime
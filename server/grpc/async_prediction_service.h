@@ -0,0 +1,67 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <grpcpp/grpcpp.h>
+#include <spdlog/spdlog.h>
+
+#include "prediction_service.grpc.pb.h"
+#include "prediction_service_impl.h"
+#include "environment.h"
+#include "worker_pool.h"
+
+namespace onnxruntime {
+namespace server {
+namespace grpc {
+
+// Completion queue based implementation of the prediction service.
+//
+// A single thread polls the completion queue to accept calls and send responses. Inference runs on a bounded
+// WorkerPool so gRPC threads are never blocked by a model run. When every worker is busy and the pending
+// queue is full, new calls are failed immediately with RESOURCE_EXHAUSTED so clients can back off or retry
+// elsewhere rather than waiting in an unbounded queue.
+class AsyncPredictionService {
+ public:
+  AsyncPredictionService(const std::shared_ptr<onnxruntime::server::ServerEnvironment>& env,
+                         size_t num_workers, size_t max_pending_requests);
+  ~AsyncPredictionService();
+
+  AsyncPredictionService(const AsyncPredictionService&) = delete;
+  AsyncPredictionService& operator=(const AsyncPredictionService&) = delete;
+
+  // The service to register with the ServerBuilder
+  ::grpc::Service* GetService() { return &service_; }
+
+  // Start accepting calls once the server has been built
+  void Start(std::unique_ptr<::grpc::ServerCompletionQueue> completion_queue);
+
+  // Complete outstanding calls and stop polling. Must be called after the server has been shut down.
+  void Shutdown();
+
+ private:
+  class PredictCall;
+
+  void PollCompletionQueue();
+
+  onnxruntime::server::PredictionService::AsyncService service_;
+  // executes the request for an accepted call
+  PredictionServiceImpl implementation_;
+  std::shared_ptr<spdlog::logger> logger_;
+
+  // no new operations can be started on the completion queue once it is shut down
+  std::mutex mutex_;
+  bool running_{false};  // guarded by mutex_
+
+  WorkerPool workers_;
+  std::unique_ptr<::grpc::ServerCompletionQueue> completion_queue_;
+  std::thread poller_;
+};
+
+}  // namespace grpc
+}  // namespace server
+}  // namespace onnxruntime
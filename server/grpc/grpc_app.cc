@@ -9,18 +9,27 @@ namespace onnx_grpc = onnxruntime::server::grpc;
 
 namespace onnxruntime {
 namespace server {
-GRPCApp::GRPCApp(const std::shared_ptr<onnxruntime::server::ServerEnvironment>& env, const std::string& host, const unsigned short port) : prediction_service_implementation_(env) {
+GRPCApp::GRPCApp(const std::shared_ptr<onnxruntime::server::ServerEnvironment>& env, const std::string& host, const unsigned short port,
+                 size_t num_workers, size_t max_pending_requests) : prediction_service_implementation_(env, num_workers, max_pending_requests) {
   ::grpc::EnableDefaultHealthCheckService(true);
   ::grpc::channelz::experimental::InitChannelzService();
   ::grpc::reflection::InitProtoReflectionServerBuilderPlugin();
   ::grpc::ServerBuilder builder;
-  builder.RegisterService(&prediction_service_implementation_);
+  builder.RegisterService(prediction_service_implementation_.GetService());
   builder.AddListeningPort(host + ":" + std::to_string(port), ::grpc::InsecureServerCredentials());
+  auto completion_queue = builder.AddCompletionQueue();
 
   server_ = builder.BuildAndStart();
+  prediction_service_implementation_.Start(std::move(completion_queue));
   server_->GetHealthCheckService()->SetServingStatus(PredictionService::service_full_name(), true);
 }
 
+GRPCApp::~GRPCApp() {
+  // the server must be shut down before its completion queue
+  server_->Shutdown();
+  prediction_service_implementation_.Shutdown();
+}
+
 void GRPCApp::Run() {
   server_->Wait();
 }
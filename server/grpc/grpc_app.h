@@ -3,15 +3,18 @@
 
 #pragma once
 #include <grpcpp/grpcpp.h>
-#include "prediction_service_impl.h"
+#include "async_prediction_service.h"
 #include "environment.h"
 
 namespace onnxruntime {
 namespace server {
 class GRPCApp {
  public:
-  GRPCApp(const std::shared_ptr<onnxruntime::server::ServerEnvironment>& env, const std::string& host, const unsigned short port);
-  ~GRPCApp() = default;
+  // num_workers is the number of requests that can be executed concurrently and max_pending_requests the number
+  // that can wait for a worker before new requests are rejected.
+  GRPCApp(const std::shared_ptr<onnxruntime::server::ServerEnvironment>& env, const std::string& host, const unsigned short port,
+          size_t num_workers, size_t max_pending_requests);
+  ~GRPCApp();
   GRPCApp(const GRPCApp& other) = delete;
   GRPCApp(GRPCApp&& other) = delete;
 
@@ -21,8 +24,8 @@ class GRPCApp {
   void Run();
 
  private:
-  grpc::PredictionServiceImpl prediction_service_implementation_;
+  grpc::AsyncPredictionService prediction_service_implementation_;
   std::unique_ptr<::grpc::Server> server_;
 };
 }  // namespace server
-}  // namespace onnxruntime
\ No newline at end of file
+}  // namespace onnxruntime
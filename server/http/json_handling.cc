@@ -9,6 +9,7 @@
 
 #include "predict.pb.h"
 #include "json_handling.h"
+#include "json_tensor_codec.h"
 
 namespace protobufutil = google::protobuf::util;
 
@@ -16,6 +17,12 @@ namespace onnxruntime {
 namespace server {
 
 protobufutil::Status GetRequestFromJson(const std::string& json_string, /* out */ onnxruntime::server::PredictRequest& request) {
+  if (TryParsePredictRequestJson(json_string, request)) {
+    return protobufutil::Status::OK;
+  }
+
+  // fall back to the protobuf converter for anything the streaming parser doesn't handle, and for its error messages
+  request.Clear();
   protobufutil::JsonParseOptions options;
   options.ignore_unknown_fields = true;
 
@@ -24,6 +31,11 @@ protobufutil::Status GetRequestFromJson(const std::string& json_string, /* out *
 }
 
 protobufutil::Status GenerateResponseInJson(const onnxruntime::server::PredictResponse& response, /* out */ std::string& json_string) {
+  if (TrySerializePredictResponseJson(response, json_string)) {
+    return protobufutil::Status::OK;
+  }
+
+  json_string.clear();
   protobufutil::JsonPrintOptions options;
   options.add_whitespace = false;
   options.always_print_primitive_fields = false;
@@ -0,0 +1,756 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cerrno>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <type_traits>
+
+#include "onnx-ml.pb.h"
+#include "predict.pb.h"
+#include "json_tensor_codec.h"
+
+namespace onnxruntime {
+namespace server {
+
+namespace {
+
+// protobuf's JSON parser has the same limit
+constexpr int kMaxNestingDepth = 100;
+
+constexpr char kBase64Chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// Accepts both the standard and web-safe alphabets like the protobuf JSON parser
+inline int Base64Value(char c) {
+  if (c >= 'A' && c <= 'Z') return c - 'A';
+  if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+  if (c >= '0' && c <= '9') return c - '0' + 52;
+  if (c == '+' || c == '-') return 62;
+  if (c == '/' || c == '_') return 63;
+  return -1;
+}
+
+// Decode base64 with or without padding directly into out
+bool Base64Decode(const std::string& encoded, std::string& out) {
+  size_t len = encoded.size();
+  if (len % 4 == 0 && len >= 2 && encoded[len - 1] == '=') {
+    len -= encoded[len - 2] == '=' ? 2 : 1;
+  }
+
+  if (len % 4 == 1) {
+    return false;
+  }
+
+  out.resize(len / 4 * 3 + (len % 4 == 0 ? 0 : len % 4 - 1));
+  const char* src = encoded.data();
+  char* dst = &out[0];
+
+  size_t i = 0;
+  for (; i + 4 <= len; i += 4) {
+    int a = Base64Value(src[i]), b = Base64Value(src[i + 1]), c = Base64Value(src[i + 2]), d = Base64Value(src[i + 3]);
+    if ((a | b | c | d) < 0) {
+      return false;
+    }
+
+    uint32_t triple = (static_cast<uint32_t>(a) << 18) | (b << 12) | (c << 6) | d;
+    *dst++ = static_cast<char>(triple >> 16);
+    *dst++ = static_cast<char>((triple >> 8) & 0xff);
+    *dst++ = static_cast<char>(triple & 0xff);
+  }
+
+  if (i < len) {
+    int a = Base64Value(src[i]), b = Base64Value(src[i + 1]);
+    int c = len - i == 3 ? Base64Value(src[i + 2]) : 0;
+    if ((a | b | c) < 0) {
+      return false;
+    }
+
+    *dst++ = static_cast<char>((a << 2) | (b >> 4));
+    if (len - i == 3) {
+      *dst++ = static_cast<char>(((b & 0xf) << 4) | (c >> 2));
+    }
+  }
+
+  return true;
+}
+
+// Append standard base64 with padding
+void AppendBase64(const std::string& data, std::string& out) {
+  const auto* src = reinterpret_cast<const unsigned char*>(data.data());
+  size_t len = data.size();
+
+  size_t offset = out.size();
+  out.resize(offset + (len + 2) / 3 * 4);
+  char* dst = &out[offset];
+
+  size_t i = 0;
+  for (; i + 3 <= len; i += 3) {
+    uint32_t triple = (src[i] << 16) | (src[i + 1] << 8) | src[i + 2];
+    *dst++ = kBase64Chars[triple >> 18];
+    *dst++ = kBase64Chars[(triple >> 12) & 0x3f];
+    *dst++ = kBase64Chars[(triple >> 6) & 0x3f];
+    *dst++ = kBase64Chars[triple & 0x3f];
+  }
+
+  if (i < len) {
+    uint32_t triple = (src[i] << 16) | (i + 1 < len ? src[i + 1] << 8 : 0);
+    *dst++ = kBase64Chars[triple >> 18];
+    *dst++ = kBase64Chars[(triple >> 12) & 0x3f];
+    *dst++ = i + 1 < len ? kBase64Chars[(triple >> 6) & 0x3f] : '=';
+    *dst++ = '=';
+  }
+}
+
+// Validate a number against the JSON grammar
+bool IsJsonNumber(const char* begin, const char* end) {
+  const char* p = begin;
+  if (p != end && *p == '-') ++p;
+
+  const char* digits = p;
+  while (p != end && *p >= '0' && *p <= '9') ++p;
+  if (p == digits || (*digits == '0' && p - digits > 1)) return false;
+
+  if (p != end && *p == '.') {
+    const char* fraction = ++p;
+    while (p != end && *p >= '0' && *p <= '9') ++p;
+    if (p == fraction) return false;
+  }
+
+  if (p != end && (*p == 'e' || *p == 'E')) {
+    ++p;
+    if (p != end && (*p == '+' || *p == '-')) ++p;
+    const char* exponent = p;
+    while (p != end && *p >= '0' && *p <= '9') ++p;
+    if (p == exponent) return false;
+  }
+
+  return p == end;
+}
+
+template <typename T>
+bool ParseInteger(const char* begin, const char* end, T& value) {
+  using UnsignedT = typename std::make_unsigned<T>::type;
+
+  bool negative = begin != end && *begin == '-';
+  if (negative) {
+    if (!std::is_signed<T>::value) return false;
+    ++begin;
+  }
+
+  if (begin == end || end - begin > std::numeric_limits<UnsignedT>::digits10 + 1) return false;
+
+  UnsignedT limit = negative ? static_cast<UnsignedT>(std::numeric_limits<T>::max()) + 1
+                             : static_cast<UnsignedT>(std::numeric_limits<T>::max());
+  UnsignedT result = 0;
+  for (const char* p = begin; p != end; ++p) {
+    if (*p < '0' || *p > '9') return false;
+    UnsignedT digit = static_cast<UnsignedT>(*p - '0');
+    if (result > (limit - digit) / 10) return false;
+    result = result * 10 + digit;
+  }
+
+  value = negative ? static_cast<T>(0 - result) : static_cast<T>(result);
+  return true;
+}
+
+// Parse a floating point value. quoted values can also be one of the special values in the protobuf JSON mapping.
+// begin must point into a null terminated string.
+template <typename T>
+bool ParseFloatingPoint(const char* begin, const char* end, bool quoted, T& value) {
+  if (quoted) {
+    std::string token(begin, end);
+    if (token == "NaN") {
+      value = std::numeric_limits<T>::quiet_NaN();
+      return true;
+    } else if (token == "Infinity") {
+      value = std::numeric_limits<T>::infinity();
+      return true;
+    } else if (token == "-Infinity") {
+      value = -std::numeric_limits<T>::infinity();
+      return true;
+    }
+  }
+
+  if (!IsJsonNumber(begin, end)) return false;
+
+  errno = 0;
+  char* parsed_end = nullptr;
+  double result = std::strtod(begin, &parsed_end);
+  if (parsed_end != end || errno == ERANGE || std::fabs(result) > std::numeric_limits<T>::max()) return false;
+
+  value = static_cast<T>(result);
+  return true;
+}
+
+class JsonReader {
+ public:
+  explicit JsonReader(const std::string& json) : cur_(json.data()), end_(json.data() + json.size()) {}
+
+  bool AtEnd() {
+    SkipWhitespace();
+    return cur_ == end_;
+  }
+
+  // Consume c if it is the next non-whitespace character
+  bool Consume(char c) {
+    SkipWhitespace();
+    if (cur_ != end_ && *cur_ == c) {
+      ++cur_;
+      return true;
+    }
+
+    return false;
+  }
+
+  bool Peek(char c) {
+    SkipWhitespace();
+    return cur_ != end_ && *cur_ == c;
+  }
+
+  bool ReadString(std::string& out);
+
+  // Read a number token. The bounds point into the JSON string.
+  bool ReadNumber(const char*& begin, const char*& end) {
+    SkipWhitespace();
+    begin = cur_;
+    while (cur_ != end_ && ((*cur_ >= '0' && *cur_ <= '9') || *cur_ == '-' || *cur_ == '+' || *cur_ == '.' ||
+                            *cur_ == 'e' || *cur_ == 'E')) {
+      ++cur_;
+    }
+
+    end = cur_;
+    return IsJsonNumber(begin, end);
+  }
+
+  // Read a number or a string. protobuf allows numeric fields to be quoted.
+  bool ReadScalar(std::string& scratch, const char*& begin, const char*& end, bool& quoted) {
+    quoted = Peek('"');
+    if (quoted) {
+      if (!ReadString(scratch)) return false;
+      begin = scratch.data();
+      end = begin + scratch.size();
+      return true;
+    }
+
+    return ReadNumber(begin, end);
+  }
+
+  bool SkipValue(int depth = 0);
+
+  // Read an array calling fn for each element
+  template <typename Fn>
+  bool ReadArray(Fn fn) {
+    if (!Consume('[')) return false;
+    if (Consume(']')) return true;
+
+    do {
+      if (!fn()) return false;
+    } while (Consume(','));
+
+    return Consume(']');
+  }
+
+  // Read an object calling fn with each key. fn must consume the value.
+  template <typename Fn>
+  bool ReadObject(Fn fn) {
+    if (!Consume('{')) return false;
+    if (Consume('}')) return true;
+
+    std::string key;
+    do {
+      if (!ReadString(key) || !Consume(':') || !fn(key)) return false;
+    } while (Consume(','));
+
+    return Consume('}');
+  }
+
+ private:
+  void SkipWhitespace() {
+    while (cur_ != end_ && (*cur_ == ' ' || *cur_ == '\n' || *cur_ == '\r' || *cur_ == '\t')) ++cur_;
+  }
+
+  bool ReadHex4(uint32_t& code) {
+    if (end_ - cur_ < 4) return false;
+
+    code = 0;
+    for (int i = 0; i < 4; ++i) {
+      char c = *cur_++;
+      code <<= 4;
+      if (c >= '0' && c <= '9') {
+        code |= c - '0';
+      } else if (c >= 'a' && c <= 'f') {
+        code |= c - 'a' + 10;
+      } else if (c >= 'A' && c <= 'F') {
+        code |= c - 'A' + 10;
+      } else {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  bool ReadLiteral(const char* literal) {
+    for (; *literal != '\0'; ++literal, ++cur_) {
+      if (cur_ == end_ || *cur_ != *literal) return false;
+    }
+
+    return true;
+  }
+
+  const char* cur_;
+  const char* const end_;
+};
+
+void AppendUtf8(uint32_t code, std::string& out) {
+  if (code < 0x80) {
+    out += static_cast<char>(code);
+  } else if (code < 0x800) {
+    out += static_cast<char>(0xc0 | (code >> 6));
+    out += static_cast<char>(0x80 | (code & 0x3f));
+  } else if (code < 0x10000) {
+    out += static_cast<char>(0xe0 | (code >> 12));
+    out += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+    out += static_cast<char>(0x80 | (code & 0x3f));
+  } else {
+    out += static_cast<char>(0xf0 | (code >> 18));
+    out += static_cast<char>(0x80 | ((code >> 12) & 0x3f));
+    out += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+    out += static_cast<char>(0x80 | (code & 0x3f));
+  }
+}
+
+bool JsonReader::ReadString(std::string& out) {
+  if (!Consume('"')) return false;
+
+  out.clear();
+  while (true) {
+    // copy runs of unescaped characters in one go
+    const char* run = cur_;
+    while (cur_ != end_ && *cur_ != '"' && *cur_ != '\\' && static_cast<unsigned char>(*cur_) >= 0x20) ++cur_;
+    out.append(run, cur_);
+
+    if (cur_ == end_) return false;
+
+    char c = *cur_++;
+    if (c == '"') return true;
+    if (c != '\\' || cur_ == end_) return false;
+
+    switch (*cur_++) {
+      case '"':
+        out += '"';
+        break;
+      case '\\':
+        out += '\\';
+        break;
+      case '/':
+        out += '/';
+        break;
+      case 'b':
+        out += '\b';
+        break;
+      case 'f':
+        out += '\f';
+        break;
+      case 'n':
+        out += '\n';
+        break;
+      case 'r':
+        out += '\r';
+        break;
+      case 't':
+        out += '\t';
+        break;
+      case 'u': {
+        uint32_t code;
+        if (!ReadHex4(code)) return false;
+
+        if (code >= 0xd800 && code <= 0xdbff) {
+          uint32_t low;
+          if (end_ - cur_ < 2 || cur_[0] != '\\' || cur_[1] != 'u') return false;
+          cur_ += 2;
+          if (!ReadHex4(low) || low < 0xdc00 || low > 0xdfff) return false;
+          code = 0x10000 + ((code - 0xd800) << 10) + (low - 0xdc00);
+        } else if (code >= 0xdc00 && code <= 0xdfff) {
+          return false;
+        }
+
+        AppendUtf8(code, out);
+        break;
+      }
+      default:
+        return false;
+    }
+  }
+}
+
+bool JsonReader::SkipValue(int depth) {
+  if (depth > kMaxNestingDepth) return false;
+
+  SkipWhitespace();
+  if (cur_ == end_) return false;
+
+  switch (*cur_) {
+    case '"': {
+      std::string ignored;
+      return ReadString(ignored);
+    }
+    case '{':
+      return ReadObject([this, depth](const std::string&) { return SkipValue(depth + 1); });
+    case '[':
+      return ReadArray([this, depth]() { return SkipValue(depth + 1); });
+    case 't':
+      return ReadLiteral("true");
+    case 'f':
+      return ReadLiteral("false");
+    case 'n':
+      return ReadLiteral("null");
+    default: {
+      const char* begin;
+      const char* end;
+      return ReadNumber(begin, end);
+    }
+  }
+}
+
+template <typename Field>
+bool ReadIntegerArray(JsonReader& reader, std::string& scratch, Field& field) {
+  using T = typename Field::value_type;
+  return reader.ReadArray([&]() {
+    const char* begin;
+    const char* end;
+    bool quoted;
+    T value;
+    if (!reader.ReadScalar(scratch, begin, end, quoted) || !ParseInteger(begin, end, value)) return false;
+
+    field.Add(value);
+    return true;
+  });
+}
+
+template <typename Field>
+bool ReadFloatingPointArray(JsonReader& reader, std::string& scratch, Field& field) {
+  using T = typename Field::value_type;
+  return reader.ReadArray([&]() {
+    const char* begin;
+    const char* end;
+    bool quoted;
+    T value;
+    if (!reader.ReadScalar(scratch, begin, end, quoted) || !ParseFloatingPoint(begin, end, quoted, value)) {
+      return false;
+    }
+
+    field.Add(value);
+    return true;
+  });
+}
+
+template <typename T>
+bool ReadInteger(JsonReader& reader, std::string& scratch, T& value) {
+  const char* begin;
+  const char* end;
+  bool quoted;
+  return reader.ReadScalar(scratch, begin, end, quoted) && ParseInteger(begin, end, value);
+}
+
+bool ReadBytes(JsonReader& reader, std::string& scratch, std::string& value) {
+  return reader.ReadString(scratch) && Base64Decode(scratch, value);
+}
+
+bool ReadTensor(JsonReader& reader, onnx::TensorProto& tensor) {
+  std::string scratch;
+
+  return reader.ReadObject([&](const std::string& key) {
+    // explicit nulls and the less common fields are left to the protobuf converter
+    if (reader.Peek('n')) {
+      return false;
+    }
+
+    if (key == "dims") {
+      return ReadIntegerArray(reader, scratch, *tensor.mutable_dims());
+    } else if (key == "dataType" || key == "data_type") {
+      int32_t data_type;
+      if (!ReadInteger(reader, scratch, data_type)) return false;
+      tensor.set_data_type(data_type);
+      return true;
+    } else if (key == "floatData" || key == "float_data") {
+      return ReadFloatingPointArray(reader, scratch, *tensor.mutable_float_data());
+    } else if (key == "int32Data" || key == "int32_data") {
+      return ReadIntegerArray(reader, scratch, *tensor.mutable_int32_data());
+    } else if (key == "stringData" || key == "string_data") {
+      return reader.ReadArray([&]() { return ReadBytes(reader, scratch, *tensor.add_string_data()); });
+    } else if (key == "int64Data" || key == "int64_data") {
+      return ReadIntegerArray(reader, scratch, *tensor.mutable_int64_data());
+    } else if (key == "name") {
+      return reader.ReadString(*tensor.mutable_name());
+    } else if (key == "docString" || key == "doc_string") {
+      return reader.ReadString(*tensor.mutable_doc_string());
+    } else if (key == "rawData" || key == "raw_data") {
+      return ReadBytes(reader, scratch, *tensor.mutable_raw_data());
+    } else if (key == "doubleData" || key == "double_data") {
+      return ReadFloatingPointArray(reader, scratch, *tensor.mutable_double_data());
+    } else if (key == "uint64Data" || key == "uint64_data") {
+      return ReadIntegerArray(reader, scratch, *tensor.mutable_uint64_data());
+    } else if (key == "dataLocation" || key == "data_location") {
+      int32_t location;
+      if (reader.Peek('"')) {
+        onnx::TensorProto_DataLocation value;
+        if (!reader.ReadString(scratch) || !onnx::TensorProto_DataLocation_Parse(scratch, &value)) return false;
+        location = value;
+      } else if (!ReadInteger(reader, scratch, location) || !onnx::TensorProto_DataLocation_IsValid(location)) {
+        return false;
+      }
+
+      tensor.set_data_location(static_cast<onnx::TensorProto_DataLocation>(location));
+      return true;
+    } else if (key == "segment" || key == "externalData" || key == "external_data") {
+      return false;
+    }
+
+    return reader.SkipValue();
+  });
+}
+
+template <typename T>
+bool IsNegative(T value, std::true_type /* is_signed */) { return value < 0; }
+
+template <typename T>
+bool IsNegative(T, std::false_type /* is_signed */) { return false; }
+
+template <typename T>
+void AppendInteger(T value, std::string& out) {
+  using UnsignedT = typename std::make_unsigned<T>::type;
+
+  char buffer[24];
+  char* end = buffer + sizeof(buffer);
+  char* p = end;
+
+  bool negative = IsNegative(value, std::is_signed<T>{});
+  UnsignedT magnitude = negative ? 0 - static_cast<UnsignedT>(value) : static_cast<UnsignedT>(value);
+  do {
+    *--p = static_cast<char>('0' + magnitude % 10);
+    magnitude /= 10;
+  } while (magnitude != 0);
+
+  if (negative) {
+    *--p = '-';
+  }
+
+  out.append(p, end);
+}
+
+// Format like protobuf's SimpleFtoa/SimpleDtoa: the shortest of the two precisions that round trips.
+// Integral values are common in model outputs (class ids, counts) and are formatted without printf.
+void AppendFloat(float value, std::string& out) {
+  if (std::isnan(value)) {
+    out += "\"NaN\"";
+  } else if (std::isinf(value)) {
+    out += value > 0 ? "\"Infinity\"" : "\"-Infinity\"";
+  } else if (std::fabs(value) < 1e6f && value == std::floor(value) && !(value == 0 && std::signbit(value))) {
+    AppendInteger(static_cast<int32_t>(value), out);
+  } else {
+    char buffer[32];
+    int len = snprintf(buffer, sizeof(buffer), "%.*g", FLT_DIG, value);
+    // like protobuf, values that don't parse back cleanly (e.g. denormals) get the longer form
+    errno = 0;
+    if (std::strtof(buffer, nullptr) != value || errno == ERANGE) {
+      len = snprintf(buffer, sizeof(buffer), "%.*g", FLT_DIG + 3, value);
+    }
+
+    out.append(buffer, len);
+  }
+}
+
+void AppendDouble(double value, std::string& out) {
+  if (std::isnan(value)) {
+    out += "\"NaN\"";
+  } else if (std::isinf(value)) {
+    out += value > 0 ? "\"Infinity\"" : "\"-Infinity\"";
+  } else if (std::fabs(value) < 1e15 && value == std::floor(value) && !(value == 0 && std::signbit(value))) {
+    AppendInteger(static_cast<int64_t>(value), out);
+  } else {
+    char buffer[32];
+    int len = snprintf(buffer, sizeof(buffer), "%.*g", DBL_DIG, value);
+    errno = 0;
+    if (std::strtod(buffer, nullptr) != value || errno == ERANGE) {
+      len = snprintf(buffer, sizeof(buffer), "%.*g", DBL_DIG + 2, value);
+    }
+
+    out.append(buffer, len);
+  }
+}
+
+template <typename Field, typename AppendFn>
+void AppendArray(const Field& field, std::string& out, AppendFn append) {
+  out += '[';
+  for (int i = 0, end = field.size(); i < end; ++i) {
+    if (i != 0) {
+      out += ',';
+    }
+
+    append(field.Get(i), out);
+  }
+  out += ']';
+}
+
+// 64-bit integers are quoted in the protobuf JSON mapping
+template <typename T>
+void AppendQuotedInteger(T value, std::string& out) {
+  out += '"';
+  AppendInteger(value, out);
+  out += '"';
+}
+
+void AppendQuotedBase64(const std::string& value, std::string& out) {
+  out += '"';
+  AppendBase64(value, out);
+  out += '"';
+}
+
+// Keys that don't need escaping. Anything else is left to the protobuf converter.
+bool IsPlainKey(const std::string& key) {
+  for (char c : key) {
+    if (c < 0x20 || c > 0x7e || c == '"' || c == '\\' || c == '<' || c == '>' || c == '&' || c == '\'' || c == '=') {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool IsSupportedTensor(const onnx::TensorProto& tensor) {
+  return !tensor.has_segment() && !tensor.has_name() && !tensor.has_doc_string() && tensor.external_data_size() == 0;
+}
+
+size_t EstimateJsonSize(const onnx::TensorProto& tensor) {
+  return 64 + tensor.raw_data().size() / 3 * 4 +
+         16 * static_cast<size_t>(tensor.float_data_size() + tensor.double_data_size() + tensor.int32_data_size() +
+                                  tensor.int64_data_size() + tensor.uint64_data_size());
+}
+
+// Fields are written in field number order, which is the order the protobuf converter uses
+void AppendTensor(const onnx::TensorProto& tensor, std::string& out) {
+  bool first = true;
+  auto append_key = [&out, &first](const char* key) {
+    out += first ? "\"" : ",\"";
+    out += key;
+    out += "\":";
+    first = false;
+  };
+
+  out += '{';
+
+  if (tensor.dims_size() > 0) {
+    append_key("dims");
+    AppendArray(tensor.dims(), out, AppendQuotedInteger<google::protobuf::int64>);
+  }
+
+  if (tensor.has_data_type()) {
+    append_key("dataType");
+    AppendInteger(tensor.data_type(), out);
+  }
+
+  if (tensor.float_data_size() > 0) {
+    append_key("floatData");
+    AppendArray(tensor.float_data(), out, AppendFloat);
+  }
+
+  if (tensor.int32_data_size() > 0) {
+    append_key("int32Data");
+    AppendArray(tensor.int32_data(), out, AppendInteger<google::protobuf::int32>);
+  }
+
+  if (tensor.string_data_size() > 0) {
+    append_key("stringData");
+    AppendArray(tensor.string_data(), out, AppendQuotedBase64);
+  }
+
+  if (tensor.int64_data_size() > 0) {
+    append_key("int64Data");
+    AppendArray(tensor.int64_data(), out, AppendQuotedInteger<google::protobuf::int64>);
+  }
+
+  if (tensor.has_raw_data()) {
+    append_key("rawData");
+    AppendQuotedBase64(tensor.raw_data(), out);
+  }
+
+  if (tensor.double_data_size() > 0) {
+    append_key("doubleData");
+    AppendArray(tensor.double_data(), out, AppendDouble);
+  }
+
+  if (tensor.uint64_data_size() > 0) {
+    append_key("uint64Data");
+    AppendArray(tensor.uint64_data(), out, AppendQuotedInteger<google::protobuf::uint64>);
+  }
+
+  if (tensor.has_data_location()) {
+    append_key("dataLocation");
+    out += '"';
+    out += onnx::TensorProto_DataLocation_Name(tensor.data_location());
+    out += '"';
+  }
+
+  out += '}';
+}
+
+}  // namespace
+
+bool TryParsePredictRequestJson(const std::string& json_string, /* out */ onnxruntime::server::PredictRequest& request) {
+  JsonReader reader(json_string);
+
+  bool succeeded = reader.ReadObject([&](const std::string& key) {
+    if (key == "inputs") {
+      return reader.ReadObject([&](const std::string& name) {
+        auto& inputs = *request.mutable_inputs();
+        return inputs.count(name) == 0 && ReadTensor(reader, inputs[name]);
+      });
+    } else if (key == "outputFilter" || key == "output_filter") {
+      return reader.ReadArray([&]() { return reader.ReadString(*request.add_output_filter()); });
+    }
+
+    // unknown fields are ignored
+    return reader.SkipValue();
+  });
+
+  return succeeded && reader.AtEnd();
+}
+
+bool TrySerializePredictResponseJson(const onnxruntime::server::PredictResponse& response, /* out */ std::string& json_string) {
+  size_t estimated_size = 16;
+  for (const auto& output : response.outputs()) {
+    if (!IsPlainKey(output.first) || !IsSupportedTensor(output.second)) {
+      return false;
+    }
+
+    estimated_size += output.first.size() + EstimateJsonSize(output.second);
+  }
+
+  json_string.clear();
+  if (response.outputs().empty()) {
+    json_string = "{}";
+    return true;
+  }
+
+  json_string.reserve(estimated_size);
+  json_string += "{\"outputs\":{";
+
+  bool first = true;
+  for (const auto& output : response.outputs()) {
+    json_string += first ? "\"" : ",\"";
+    json_string += output.first;
+    json_string += "\":";
+    AppendTensor(output.second, json_string);
+    first = false;
+  }
+
+  json_string += "}}";
+  return true;
+}
+
+}  // namespace server
+}  // namespace onnxruntime
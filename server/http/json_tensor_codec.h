@@ -0,0 +1,30 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+
+#include "predict.pb.h"
+
+namespace onnxruntime {
+namespace server {
+
+// Streaming JSON codec for PredictRequest/PredictResponse.
+//
+// The tensor data is parsed directly into, and formatted directly out of, the TensorProto fields without
+// building an intermediate document or going through the reflection based protobuf JSON converter.
+// The output matches the protobuf JSON mapping used by google::protobuf::util.
+//
+// Both functions return false if the input is invalid or uses a construct the codec doesn't handle
+// (e.g. segments or external data). The caller should then fall back to the protobuf converter, which
+// also produces the detailed error message for invalid input.
+
+// Parse a JSON PredictRequest. Unknown fields are ignored.
+bool TryParsePredictRequestJson(const std::string& json_string, /* out */ onnxruntime::server::PredictRequest& request);
+
+// Serialize a PredictResponse to compact JSON.
+bool TrySerializePredictResponseJson(const onnxruntime::server::PredictResponse& response, /* out */ std::string& json_string);
+
+}  // namespace server
+}  // namespace onnxruntime
@@ -1,6 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <thread>
+
 #include "environment.h"
 #include "http_server.h"
 #include "predict_request_handler.h"
@@ -64,6 +67,13 @@ int main(int argc, char* argv[]) {
   logger->info("Model name: {}", config.model_name);
   logger->info("Model version: {}", config.model_version);
 
+  env->SetIntraOpNumThreads(config.num_intra_op_threads);
+
+  if (config.max_batch_size > 1) {
+    logger->info("Max batch size: {}, max batch delay: {} us", config.max_batch_size, config.max_batch_delay_us);
+    env->EnableBatching(static_cast<size_t>(config.max_batch_size), std::chrono::microseconds(config.max_batch_delay_us));
+  }
+
   try {
     env->InitializeModel(config.model_path, config.model_name, config.model_version);
     logger->debug("Initialize Model Successfully!");
@@ -76,9 +86,27 @@ int main(int argc, char* argv[]) {
   auto const grpc_address = config.address;
   auto const grpc_port = config.grpc_port;
 
-  server::GRPCApp grpc_app{env, grpc_address, grpc_port};
+  // run GRPC requests on the cores the intra-op threads leave free. the default intra-op pool is shared by all
+  // requests, so it doesn't reserve any cores. batching needs enough concurrent requests to fill a batch.
+  size_t num_cores = std::max(std::thread::hardware_concurrency(), 1u);
+  size_t num_grpc_workers = config.num_grpc_workers;
+  if (num_grpc_workers == 0) {
+    size_t intra_op_threads = static_cast<size_t>(config.num_intra_op_threads);
+    if (intra_op_threads == 0) {
+      num_grpc_workers = num_cores;
+    } else {
+      num_grpc_workers = num_cores > intra_op_threads ? num_cores - intra_op_threads : size_t{1};
+    }
+    num_grpc_workers = std::max({num_grpc_workers, static_cast<size_t>(config.max_batch_size), size_t{1}});
+  }
+
+  size_t max_pending_grpc_requests = config.max_pending_grpc_requests > 0 ? static_cast<size_t>(config.max_pending_grpc_requests)
+                                                                          : 4 * num_grpc_workers;
+
+  server::GRPCApp grpc_app{env, grpc_address, grpc_port, num_grpc_workers, max_pending_grpc_requests};
 
   logger->info("GRPC Listening at: {}:{}", grpc_address, grpc_port);
+  logger->info("GRPC workers: {}, max pending requests: {}", num_grpc_workers, max_pending_grpc_requests);
 
   //Setup HTTP Server
   auto const boost_address = boost::asio::ip::make_address(config.address);
@@ -27,6 +27,13 @@ void GetSizeInBytesFromTensorProto(const onnx::TensorProto& tensor_proto, size_t
  */
 void TensorProtoToMLValue(const onnx::TensorProto& input, const server::MemBuffer& m, /* out */ Ort::Value& value);
 
+/**
+ * Wrap the raw_data of a TensorProto in a value without copying it. The TensorProto must outlive the value.
+ * Returns false if the data can't be used in place (no raw_data, string or empty tensor, big endian host,
+ * or raw_data that isn't aligned for the element type), in which case TensorProtoToMLValue should be used.
+ */
+bool TryWrapTensorProtoRawData(const onnx::TensorProto& input, const OrtMemoryInfo& memory_info, /* out */ Ort::Value& value);
+
 template <typename T>
 void UnpackTensor(const onnx::TensorProto& tensor, const void* raw_data, size_t raw_data_len,
                   /*out*/ T* p_data, int64_t expected_size);
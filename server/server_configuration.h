@@ -45,6 +45,11 @@ class ServerConfiguration {
   unsigned short http_port = 8001;
   unsigned short grpc_port = 50051;
   int num_http_threads = std::thread::hardware_concurrency();
+  int max_batch_size = 0;
+  int max_batch_delay_us = 1000;
+  int num_intra_op_threads = 0;
+  int num_grpc_workers = 0;
+  int max_pending_grpc_requests = 0;
   OrtLoggingLevel logging_level{};
 
   ServerConfiguration() {
@@ -57,6 +62,11 @@ class ServerConfiguration {
     desc.add_options()("http_port", po::value(&http_port)->default_value(http_port), "HTTP port to listen to requests");
     desc.add_options()("num_http_threads", po::value(&num_http_threads)->default_value(num_http_threads), "Number of http threads");
     desc.add_options()("grpc_port", po::value(&grpc_port)->default_value(grpc_port), "GRPC port to listen to requests");
+    desc.add_options()("max_batch_size", po::value(&max_batch_size)->default_value(max_batch_size), "Maximum number of rows to combine from concurrent requests into a single batch. 0 or 1 disables batching");
+    desc.add_options()("num_intra_op_threads", po::value(&num_intra_op_threads)->default_value(num_intra_op_threads), "Number of threads ONNX Runtime uses within an operator. 0 uses the ONNX Runtime default");
+    desc.add_options()("num_grpc_workers", po::value(&num_grpc_workers)->default_value(num_grpc_workers), "Number of GRPC requests executed concurrently. 0 uses one per core, minus num_intra_op_threads when it is set (at least max_batch_size)");
+    desc.add_options()("max_pending_grpc_requests", po::value(&max_pending_grpc_requests)->default_value(max_pending_grpc_requests), "Number of GRPC requests that can wait for a worker before new requests are rejected. 0 allows 4 per worker");
+    desc.add_options()("max_batch_delay_us", po::value(&max_batch_delay_us)->default_value(max_batch_delay_us), "Maximum time in microseconds a request waits for other requests to batch with");
   }
 
   // Parses argc and argv and sets the values for the class
@@ -103,6 +113,15 @@ class ServerConfiguration {
     } else if (num_http_threads <= 0) {
       PrintHelp(std::cerr, "num_http_threads must be greater than 0");
       return Result::ExitFailure;
+    } else if (max_batch_size < 0) {
+      PrintHelp(std::cerr, "max_batch_size must not be negative");
+      return Result::ExitFailure;
+    } else if (max_batch_delay_us < 0) {
+      PrintHelp(std::cerr, "max_batch_delay_us must not be negative");
+      return Result::ExitFailure;
+    } else if (num_intra_op_threads < 0 || num_grpc_workers < 0 || max_pending_grpc_requests < 0) {
+      PrintHelp(std::cerr, "num_intra_op_threads, num_grpc_workers and max_pending_grpc_requests must not be negative");
+      return Result::ExitFailure;
     } else if (!file_exists(model_path)) {
       PrintHelp(std::cerr, "model_path must be the location of a valid file");
       return Result::ExitFailure;
@@ -0,0 +1,90 @@
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT License.
+
+# Open loop GRPC load generator for a running onnxruntime_server.
+# Requests are sent at a fixed rate regardless of how quickly the server responds, so latency under
+# overload and the number of requests rejected by the server (RESOURCE_EXHAUSTED) can be measured.
+#
+# Usage:
+#   python3 grpc_load_benchmark.py <server_address:port> <request_pb_file> [--rate N] [--duration S]
+
+import argparse
+import threading
+import time
+
+import grpc
+import numpy
+
+import predict_pb2
+import prediction_service_pb2_grpc
+
+
+def run(address, request, rate, duration, timeout):
+    latencies = []
+    status_counts = {}
+    lock = threading.Lock()
+    pending = []
+
+    def on_done(future, start):
+        elapsed = time.perf_counter() - start
+        code = future.code()
+        with lock:
+            status_counts[code] = status_counts.get(code, 0) + 1
+            if code == grpc.StatusCode.OK:
+                latencies.append(elapsed)
+
+    with grpc.insecure_channel(address) as channel:
+        stub = prediction_service_pb2_grpc.PredictionServiceStub(channel)
+
+        # warm up
+        stub.Predict(request, timeout=timeout)
+
+        interval = 1.0 / rate
+        begin = time.perf_counter()
+        next_send = begin
+        while next_send - begin < duration:
+            now = time.perf_counter()
+            if now < next_send:
+                time.sleep(next_send - now)
+
+            start = time.perf_counter()
+            future = stub.Predict.future(request, timeout=timeout)
+            future.add_done_callback(lambda f, start=start: on_done(f, start))
+            pending.append(future)
+            next_send += interval
+
+        for future in pending:
+            try:
+                future.result()
+            except grpc.RpcError:
+                pass
+
+        elapsed = time.perf_counter() - begin
+
+    sent = len(pending)
+    ok = len(latencies)
+    print('Sent {} requests in {:.2f}s ({:.1f}/s), {} succeeded ({:.1f}/s)'.format(sent, elapsed, sent / elapsed, ok, ok / elapsed))
+    for code, count in sorted(status_counts.items(), key=lambda item: item[0].name):
+        print('  {}: {}'.format(code.name, count))
+
+    if latencies:
+        values = numpy.array(latencies) * 1000
+        print('Latency (ms): p50={:.2f} p90={:.2f} p99={:.2f} p99.9={:.2f} max={:.2f}'.format(
+            numpy.percentile(values, 50), numpy.percentile(values, 90), numpy.percentile(values, 99),
+            numpy.percentile(values, 99.9), values.max()))
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='Open loop GRPC load generator for onnxruntime_server')
+    parser.add_argument('address', help='server address, e.g. 127.0.0.1:50051')
+    parser.add_argument('request', help='serialized PredictRequest protobuf file')
+    parser.add_argument('--rate', type=float, default=100, help='requests per second')
+    parser.add_argument('--duration', type=float, default=10, help='seconds to send requests for')
+    parser.add_argument('--timeout', type=float, default=30, help='per request timeout in seconds')
+    args = parser.parse_args()
+
+    request = predict_pb2.PredictRequest()
+    with open(args.request, 'rb') as f:
+        request.ParseFromString(f.read())
+
+    run(args.address, request, args.rate, args.duration, args.timeout)
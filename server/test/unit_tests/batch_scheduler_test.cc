@@ -0,0 +1,318 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "batch_scheduler.h"
+#include "test_server_environment.h"
+
+namespace onnxruntime {
+namespace server {
+namespace test {
+
+class BatchSchedulerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    const static auto model_file = "testdata/mul_1.onnx";
+
+    onnxruntime::server::ServerEnvironment* env = ServerEnv();
+    env->InitializeModel(model_file, "Name", "version");
+  }
+
+  void TearDown() override {
+    onnxruntime::server::ServerEnvironment* env = ServerEnv();
+    env->UnloadModel("Name", "version");
+  }
+};
+
+// mul_1 has a fixed input shape of {3, 2} so requests must be run individually
+TEST_F(BatchSchedulerTest, FixedBatchDimensionRunsRequestsIndividually) {
+  onnxruntime::server::ServerEnvironment* env = ServerEnv();
+
+  BatchScheduler scheduler(env->GetSession("Name", "version"), 8, std::chrono::microseconds(1000),
+                           env->GetLogger("BatchSchedulerTest"));
+  EXPECT_FALSE(scheduler.IsBatchingSupported());
+  EXPECT_EQ(env->GetBatchScheduler("Name", "version"), nullptr);
+
+  auto memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+  const std::vector<std::string> input_names{"X"};
+  const std::vector<std::string> output_names{"Y"};
+  const std::vector<int64_t> shape{3, 2};
+
+  constexpr int num_requests = 4;
+  std::vector<std::vector<float>> inputs(num_requests);
+  std::vector<std::vector<float>> results(num_requests);
+  std::vector<std::thread> threads;
+
+  for (int r = 0; r < num_requests; ++r) {
+    inputs[r] = {1.f * r, 2.f * r, 3.f * r, 4.f * r, 5.f * r, 6.f * r};
+    threads.emplace_back([&, r]() {
+      std::vector<Ort::Value> input_values;
+      input_values.push_back(Ort::Value::CreateTensor<float>(memory_info, inputs[r].data(), inputs[r].size(),
+                                                             shape.data(), shape.size()));
+
+      Ort::RunOptions run_options{};
+      auto outputs = scheduler.Run(run_options, input_names, input_values, output_names);
+      ASSERT_EQ(outputs.size(), 1u);
+
+      auto* data = outputs[0].GetTensorMutableData<float>();
+      results[r].assign(data, data + outputs[0].GetTensorTypeAndShapeInfo().GetElementCount());
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (int r = 0; r < num_requests; ++r) {
+    ASSERT_EQ(results[r].size(), inputs[r].size());
+    for (size_t i = 0; i < inputs[r].size(); ++i) {
+      EXPECT_FLOAT_EQ(results[r][i], inputs[r][i] * inputs[r][i]);
+    }
+  }
+}
+
+// batching.onnx has an input X of shape {N, M} and outputs Y = X * X and Z = X + X of shape {N, M},
+// and T = Transpose(X) of shape {M, N}
+class BatchingModelTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    const static auto model_file = "testdata/batching.onnx";
+
+    onnxruntime::server::ServerEnvironment* env = ServerEnv();
+    env->InitializeModel(model_file, "Batching", "version");
+  }
+
+  void TearDown() override {
+    onnxruntime::server::ServerEnvironment* env = ServerEnv();
+    env->UnloadModel("Batching", "version");
+  }
+
+  // a long delay so that concurrent requests reliably end up in the same batch
+  std::unique_ptr<BatchScheduler> CreateScheduler() {
+    onnxruntime::server::ServerEnvironment* env = ServerEnv();
+    return std::make_unique<BatchScheduler>(env->GetSession("Batching", "version"), 16,
+                                            std::chrono::microseconds(200000),
+                                            env->GetLogger("BatchSchedulerTest"));
+  }
+
+  struct Request {
+    std::vector<std::string> input_names{"X"};
+    std::vector<int64_t> shape;
+    std::vector<float> input;
+    std::vector<std::string> output_names;
+    int log_severity_level = -1;
+    bool terminate = false;
+
+    std::vector<int64_t> result_shape;
+    std::vector<float> result;
+    bool failed = false;
+  };
+
+  // runs the requests concurrently, each on its own thread
+  static void RunConcurrently(BatchScheduler& scheduler, std::vector<Request>& requests) {
+    auto memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+    std::vector<std::thread> threads;
+
+    for (auto& request : requests) {
+      threads.emplace_back([&]() {
+        std::vector<Ort::Value> input_values;
+        input_values.push_back(Ort::Value::CreateTensor<float>(memory_info, request.input.data(),
+                                                               request.input.size(), request.shape.data(),
+                                                               request.shape.size()));
+
+        try {
+          Ort::RunOptions run_options{};
+          run_options.SetRunLogSeverityLevel(request.log_severity_level);
+          if (request.terminate) {
+            run_options.SetTerminate();
+          }
+
+          auto outputs = scheduler.Run(run_options, request.input_names, input_values, request.output_names);
+          ASSERT_EQ(outputs.size(), 1u);
+
+          auto info = outputs[0].GetTensorTypeAndShapeInfo();
+          auto* data = outputs[0].GetTensorMutableData<float>();
+          request.result_shape = info.GetShape();
+          request.result.assign(data, data + info.GetElementCount());
+        } catch (const Ort::Exception&) {
+          request.failed = true;
+        }
+      });
+    }
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  static Request MakeRequest(std::vector<int64_t> shape, const std::string& output_name, float offset) {
+    Request request;
+    request.shape = std::move(shape);
+    request.output_names = {output_name};
+    request.input.resize(static_cast<size_t>(request.shape[0] * request.shape[1]));
+    for (size_t i = 0; i < request.input.size(); ++i) {
+      request.input[i] = offset + static_cast<float>(i);
+    }
+
+    return request;
+  }
+};
+
+TEST_F(BatchingModelTest, ConcurrentRequestsAreBatched) {
+  auto scheduler = CreateScheduler();
+  ASSERT_TRUE(scheduler->IsBatchingSupported());
+
+  // requests with a different number of rows can share a batch
+  std::vector<Request> requests;
+  for (int r = 0; r < 6; ++r) {
+    requests.push_back(MakeRequest({r % 3 + 1, 2}, "Y", 10.f * r));
+  }
+
+  RunConcurrently(*scheduler, requests);
+
+  for (const auto& request : requests) {
+    ASSERT_FALSE(request.failed);
+    EXPECT_EQ(request.result_shape, request.shape);
+    ASSERT_EQ(request.result.size(), request.input.size());
+    for (size_t i = 0; i < request.input.size(); ++i) {
+      EXPECT_FLOAT_EQ(request.result[i], request.input[i] * request.input[i]);
+    }
+  }
+
+  EXPECT_EQ(scheduler->GetNumBatches(), 1u);
+}
+
+TEST_F(BatchingModelTest, IncompatibleRequestsAreNotBatchedTogether) {
+  auto scheduler = CreateScheduler();
+
+  // a different row shape and a different output each need a batch of their own
+  std::vector<Request> requests;
+  requests.push_back(MakeRequest({1, 2}, "Y", 0.f));
+  requests.push_back(MakeRequest({2, 3}, "Y", 10.f));
+  requests.push_back(MakeRequest({1, 2}, "Z", 20.f));
+
+  RunConcurrently(*scheduler, requests);
+
+  for (size_t r = 0; r < requests.size(); ++r) {
+    const auto& request = requests[r];
+    ASSERT_FALSE(request.failed);
+    EXPECT_EQ(request.result_shape, request.shape);
+    ASSERT_EQ(request.result.size(), request.input.size());
+    for (size_t i = 0; i < request.input.size(); ++i) {
+      auto expected = r == 2 ? request.input[i] + request.input[i] : request.input[i] * request.input[i];
+      EXPECT_FLOAT_EQ(request.result[i], expected);
+    }
+  }
+
+  EXPECT_EQ(scheduler->GetNumBatches(), 3u);
+}
+
+TEST_F(BatchingModelTest, RequestsWithDifferentLogLevelsAreNotBatchedTogether) {
+  auto scheduler = CreateScheduler();
+
+  std::vector<Request> requests;
+  requests.push_back(MakeRequest({1, 2}, "Y", 0.f));
+  requests.push_back(MakeRequest({1, 2}, "Y", 10.f));
+  requests.push_back(MakeRequest({1, 2}, "Y", 20.f));
+  requests[2].log_severity_level = 3;
+
+  RunConcurrently(*scheduler, requests);
+
+  for (const auto& request : requests) {
+    ASSERT_FALSE(request.failed);
+    ASSERT_EQ(request.result.size(), request.input.size());
+    for (size_t i = 0; i < request.input.size(); ++i) {
+      EXPECT_FLOAT_EQ(request.result[i], request.input[i] * request.input[i]);
+    }
+  }
+
+  EXPECT_EQ(scheduler->GetNumBatches(), 2u);
+}
+
+TEST_F(BatchingModelTest, TerminatedRequestIsNotRun) {
+  auto scheduler = CreateScheduler();
+
+  // the terminated request fails, the requests batched with it still succeed
+  std::vector<Request> requests;
+  for (int r = 0; r < 3; ++r) {
+    requests.push_back(MakeRequest({1, 2}, "Y", 10.f * r));
+  }
+  requests[1].terminate = true;
+
+  RunConcurrently(*scheduler, requests);
+
+  EXPECT_TRUE(requests[1].failed);
+  for (int r : {0, 2}) {
+    const auto& request = requests[r];
+    ASSERT_FALSE(request.failed);
+    ASSERT_EQ(request.result.size(), request.input.size());
+    for (size_t i = 0; i < request.input.size(); ++i) {
+      EXPECT_FLOAT_EQ(request.result[i], request.input[i] * request.input[i]);
+    }
+  }
+
+  EXPECT_EQ(scheduler->GetNumBatches(), 1u);
+}
+
+TEST_F(BatchingModelTest, FailureIsReportedToEveryRequestInBatch) {
+  auto scheduler = CreateScheduler();
+
+  // the model has no input named W so the batch fails
+  std::vector<Request> requests;
+  for (int r = 0; r < 4; ++r) {
+    requests.push_back(MakeRequest({1, 2}, "Y", 0.f));
+    requests.back().input_names = {"W"};
+  }
+
+  RunConcurrently(*scheduler, requests);
+
+  for (const auto& request : requests) {
+    EXPECT_TRUE(request.failed);
+  }
+
+  EXPECT_EQ(scheduler->GetNumBatches(), 1u);
+}
+
+TEST_F(BatchingModelTest, OutputsWithoutMatchingRowsAreRunIndividually) {
+  auto scheduler = CreateScheduler();
+
+  // T has a free dimension 0 but it doesn't follow the rows of X, so the batch is rerun one request at a time
+  std::vector<Request> requests;
+  requests.push_back(MakeRequest({2, 2}, "T", 0.f));
+  requests.push_back(MakeRequest({2, 2}, "T", 10.f));
+
+  RunConcurrently(*scheduler, requests);
+
+  for (const auto& request : requests) {
+    ASSERT_FALSE(request.failed);
+    EXPECT_EQ(request.result_shape, request.shape);
+    ASSERT_EQ(request.result.size(), 4u);
+    EXPECT_FLOAT_EQ(request.result[0], request.input[0]);
+    EXPECT_FLOAT_EQ(request.result[1], request.input[2]);
+    EXPECT_FLOAT_EQ(request.result[2], request.input[1]);
+    EXPECT_FLOAT_EQ(request.result[3], request.input[3]);
+  }
+}
+
+// batching_scalar_output.onnx reduces an input of shape {N, 2} to a scalar
+TEST(BatchSchedulerOutputTest, OutputWithoutBatchDimensionDisablesBatching) {
+  onnxruntime::server::ServerEnvironment* env = ServerEnv();
+  env->InitializeModel("testdata/batching_scalar_output.onnx", "ScalarOutput", "version");
+
+  {
+    BatchScheduler scheduler(env->GetSession("ScalarOutput", "version"), 8, std::chrono::microseconds(1000),
+                             env->GetLogger("BatchSchedulerTest"));
+    EXPECT_FALSE(scheduler.IsBatchingSupported());
+  }
+
+  env->UnloadModel("ScalarOutput", "version");
+}
+
+}  // namespace test
+}  // namespace server
+}  // namespace onnxruntime
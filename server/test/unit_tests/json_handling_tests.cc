@@ -1,13 +1,17 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cmath>
 #include <fstream>
+#include <limits>
 #include <google/protobuf/stubs/status.h>
+#include <google/protobuf/util/json_util.h>
 
 #include "gtest/gtest.h"
 
 #include "predict.pb.h"
 #include "http/json_handling.h"
+#include "http/json_tensor_codec.h"
 
 namespace onnxruntime {
 namespace server {
@@ -68,6 +72,89 @@ TEST(JsonSerializationTests, HappyPath) {
   EXPECT_EQ(expected_json_string, json_string);
 }
 
+TEST(JsonDeserializationTests, StreamingParserTensorFields) {
+  std::string input_json = R"({ "inputs" : { "X" : {"dims":[3, "2"], "dataType":1, "floatData":[1.5, -2, "3", "NaN", "-Infinity", 1e-3]},
+                                 "Y" : {"dims":["2"], "data_type":7, "int64_data":["-9223372036854775808", 5]},
+                                 "Z" : {"dims":["1"], "dataType":8, "stringData":["aGVsbG8="], "unknown":{"a":[true, null]}}},
+                               "outputFilter":["A", "Bé"]})";
+  onnxruntime::server::PredictRequest request;
+  ASSERT_TRUE(TryParsePredictRequestJson(input_json, request));
+
+  const auto& x = request.inputs().at("X");
+  ASSERT_EQ(x.dims_size(), 2);
+  EXPECT_EQ(x.dims(0), 3);
+  EXPECT_EQ(x.dims(1), 2);
+  EXPECT_EQ(x.data_type(), 1);
+  ASSERT_EQ(x.float_data_size(), 6);
+  EXPECT_EQ(x.float_data(0), 1.5f);
+  EXPECT_EQ(x.float_data(1), -2.f);
+  EXPECT_EQ(x.float_data(2), 3.f);
+  EXPECT_TRUE(std::isnan(x.float_data(3)));
+  EXPECT_EQ(x.float_data(4), -std::numeric_limits<float>::infinity());
+  EXPECT_EQ(x.float_data(5), 1e-3f);
+
+  const auto& y = request.inputs().at("Y");
+  ASSERT_EQ(y.int64_data_size(), 2);
+  EXPECT_EQ(y.int64_data(0), std::numeric_limits<int64_t>::min());
+  EXPECT_EQ(y.int64_data(1), 5);
+
+  const auto& z = request.inputs().at("Z");
+  ASSERT_EQ(z.string_data_size(), 1);
+  EXPECT_EQ(z.string_data(0), "hello");
+
+  ASSERT_EQ(request.output_filter_size(), 2);
+  EXPECT_EQ(request.output_filter(1), "B\xc3\xa9");
+}
+
+TEST(JsonDeserializationTests, StreamingParserMatchesProtobuf) {
+  std::string input_json = R"({"inputs":{"Input3":{"dims":["1","3"],"dataType":1,"rawData":"AACAPwAAAEAAAEBA"}},"outputFilter":["Plus214_Output_0"]})";
+  onnxruntime::server::PredictRequest streaming_request;
+  ASSERT_TRUE(TryParsePredictRequestJson(input_json, streaming_request));
+
+  onnxruntime::server::PredictRequest protobuf_request;
+  protobufutil::JsonParseOptions options;
+  options.ignore_unknown_fields = true;
+  ASSERT_TRUE(JsonStringToMessage(input_json, &protobuf_request, options).ok());
+
+  EXPECT_EQ(streaming_request.SerializeAsString(), protobuf_request.SerializeAsString());
+}
+
+TEST(JsonDeserializationTests, StreamingParserRejectsUnsupportedInput) {
+  onnxruntime::server::PredictRequest request;
+  EXPECT_FALSE(TryParsePredictRequestJson(R"({"inputs":{"X":{"dims":[1],"segment":{"begin":"0"}}}})", request));
+  request.Clear();
+  EXPECT_FALSE(TryParsePredictRequestJson(R"({"inputs":{"X":{"dims":[01]}}})", request));
+  request.Clear();
+  EXPECT_FALSE(TryParsePredictRequestJson(R"({"inputs":{"X":{"int32Data":[2147483648]}}})", request));
+  request.Clear();
+  EXPECT_FALSE(TryParsePredictRequestJson(R"({"inputs":{}} trailing)", request));
+}
+
+TEST(JsonSerializationTests, StreamingSerializerMatchesProtobuf) {
+  onnxruntime::server::PredictResponse response;
+  auto& tensor = (*response.mutable_outputs())["Y"];
+  tensor.add_dims(2);
+  tensor.add_dims(4);
+  tensor.set_data_type(1);
+  for (float value : {1.f, -0.f, 0.1f, 1e6f, 3.14159274f, 1e-10f, std::numeric_limits<float>::infinity(), 123456.5f}) {
+    tensor.add_float_data(value);
+  }
+  tensor.add_int64_data(-42);
+  tensor.add_double_data(0.1);
+  tensor.set_raw_data("abcd");
+  tensor.set_data_location(onnx::TensorProto_DataLocation_DEFAULT);
+
+  std::string streaming_json;
+  ASSERT_TRUE(TrySerializePredictResponseJson(response, streaming_json));
+
+  std::string protobuf_json;
+  protobufutil::JsonPrintOptions options;
+  options.add_whitespace = false;
+  ASSERT_TRUE(MessageToJsonString(response, &protobuf_json, options).ok());
+
+  EXPECT_EQ(protobuf_json, streaming_json);
+}
+
 TEST(StringEscapingTests, SimpleString) {
   std::string unescaped = "This is an error message \" \n ";
   EXPECT_EQ("This is an error message \\\" \\n ", escape_string(unescaped));
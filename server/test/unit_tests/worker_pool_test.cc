@@ -0,0 +1,59 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <atomic>
+#include <future>
+
+#include "gtest/gtest.h"
+
+#include "worker_pool.h"
+
+namespace onnxruntime {
+namespace server {
+namespace test {
+
+TEST(WorkerPoolTests, RunsAllTasks) {
+  std::atomic<int> count{0};
+
+  {
+    WorkerPool pool(4, 100);
+    for (int i = 0; i < 100; ++i) {
+      EXPECT_TRUE(pool.TrySchedule([&count]() { ++count; }));
+    }
+
+    pool.WaitForIdle();
+    EXPECT_EQ(count, 100);
+  }
+}
+
+TEST(WorkerPoolTests, RejectsTasksWhenQueueIsFull) {
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  std::promise<void> started;
+
+  WorkerPool pool(1, 2);
+
+  // block the only worker so further tasks stay queued
+  ASSERT_TRUE(pool.TrySchedule([&started, released]() {
+    started.set_value();
+    released.wait();
+  }));
+  started.get_future().wait();
+
+  std::atomic<int> count{0};
+  EXPECT_TRUE(pool.TrySchedule([&count]() { ++count; }));
+  EXPECT_TRUE(pool.TrySchedule([&count]() { ++count; }));
+  EXPECT_FALSE(pool.TrySchedule([&count]() { ++count; }));
+
+  release.set_value();
+  pool.WaitForIdle();
+  EXPECT_EQ(count, 2);
+
+  EXPECT_TRUE(pool.TrySchedule([&count]() { ++count; }));
+  pool.WaitForIdle();
+  EXPECT_EQ(count, 3);
+}
+
+}  // namespace test
+}  // namespace server
+}  // namespace onnxruntime
@@ -0,0 +1,75 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "worker_pool.h"
+
+namespace onnxruntime {
+namespace server {
+
+WorkerPool::WorkerPool(size_t num_threads, size_t max_pending_tasks) : max_pending_tasks_(max_pending_tasks) {
+  threads_.reserve(num_threads);
+  for (size_t i = 0; i < num_threads; ++i) {
+    threads_.emplace_back([this]() { WorkerLoop(); });
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shutdown_ = true;
+  }
+
+  task_available_.notify_all();
+
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+bool WorkerPool::TrySchedule(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (shutdown_ || tasks_.size() >= max_pending_tasks_) {
+      return false;
+    }
+
+    tasks_.push_back(std::move(task));
+  }
+
+  task_available_.notify_one();
+  return true;
+}
+
+void WorkerPool::WaitForIdle() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  idle_.wait(lock, [this]() { return tasks_.empty() && num_running_ == 0; });
+}
+
+void WorkerPool::WorkerLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  while (true) {
+    task_available_.wait(lock, [this]() { return shutdown_ || !tasks_.empty(); });
+
+    if (tasks_.empty()) {
+      // shutdown requested and no work left
+      return;
+    }
+
+    auto task = std::move(tasks_.front());
+    tasks_.pop_front();
+    ++num_running_;
+
+    lock.unlock();
+    task();
+    lock.lock();
+
+    --num_running_;
+    if (tasks_.empty() && num_running_ == 0) {
+      idle_.notify_all();
+    }
+  }
+}
+
+}  // namespace server
+}  // namespace onnxruntime
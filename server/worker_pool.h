@@ -0,0 +1,54 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace onnxruntime {
+namespace server {
+
+// Fixed size pool of threads with a bounded queue of pending tasks.
+// TrySchedule rejects new work once the queue is full so callers can shed load instead of queueing
+// without bound when requests arrive faster than they can be executed.
+class WorkerPool {
+ public:
+  WorkerPool(size_t num_threads, size_t max_pending_tasks);
+
+  // Runs any tasks that are already queued and then stops the threads
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  // Queue task to be run by a worker thread. Returns false if max_pending_tasks are already waiting.
+  bool TrySchedule(std::function<void()> task);
+
+  // Block until all queued and running tasks have completed
+  void WaitForIdle();
+
+  size_t NumThreads() const { return threads_.size(); }
+  size_t MaxPendingTasks() const { return max_pending_tasks_; }
+
+ private:
+  void WorkerLoop();
+
+  const size_t max_pending_tasks_;
+
+  std::mutex mutex_;
+  std::condition_variable task_available_;
+  std::condition_variable idle_;
+  std::deque<std::function<void()>> tasks_;  // guarded by mutex_
+  size_t num_running_{0};                    // guarded by mutex_
+  bool shutdown_{false};                     // guarded by mutex_
+
+  std::vector<std::thread> threads_;
+};
+
+}  // namespace server
+}  // namespace onnxruntime